@@ -34,13 +34,51 @@ using Map = std::map<S, std::shared_ptr<T>>; //!< Type alias for maps
 template<typename T>
 using Shared = std::shared_ptr<T>; //!< Shared pointer type alias
 
-#define ENGINE_ERROR(...) Engine::Log::error(__VA_ARGS__) //!< Print error message
-#define ENGINE_INFO(...)  Engine::Log::info(__VA_ARGS__) //!< Print info message
-#define ENGINE_WARN(...)  Engine::Log::warn(__VA_ARGS__) //!< Print warn message
-#define ENGINE_TRACE(...)  Engine::Log::trace(__VA_ARGS__) //!< Print trace message
-#define ENGINE_DEBUG(...)  Engine::Log::debug(__VA_ARGS__) //!< Print debug message
-#define ENGINE_RELEASE(...)  Engine::Log::release(__VA_ARGS__) //!< Print release mode message
-#define ENGINE_FILE(...)  Engine::Log::file(__VA_ARGS__) //!< File message
+#define NG_LOG_LEVEL_TRACE 0 //!< Log everything
+#define NG_LOG_LEVEL_DEBUG 1 //!< Log debug messages and above
+#define NG_LOG_LEVEL_INFO 2 //!< Log info messages and above
+#define NG_LOG_LEVEL_WARN 3 //!< Log warnings and errors
+#define NG_LOG_LEVEL_ERROR 4 //!< Log errors only
+#define NG_LOG_LEVEL_OFF 5 //!< Log nothing but release and file messages
+
+// Messages below this level are removed at compile time, arguments included
+#ifndef NG_LOG_LEVEL
+#ifdef NG_DEBUG
+#define NG_LOG_LEVEL NG_LOG_LEVEL_TRACE
+#else
+#define NG_LOG_LEVEL NG_LOG_LEVEL_OFF
+#endif
+#endif
+
+#define ENGINE_LOG(level, ...) do { static Engine::LogSite logSite; Engine::Log::write(logSite, level, __VA_ARGS__); } while (0) //!< Queue a message, rate limited per call site
+
+#if NG_LOG_LEVEL <= NG_LOG_LEVEL_ERROR
+#define ENGINE_ERROR(...) ENGINE_LOG(spdlog::level::err, __VA_ARGS__) //!< Print error message
+#else
+#define ENGINE_ERROR(...) ((void)0)
+#endif
+#if NG_LOG_LEVEL <= NG_LOG_LEVEL_INFO
+#define ENGINE_INFO(...) ENGINE_LOG(spdlog::level::info, __VA_ARGS__) //!< Print info message
+#else
+#define ENGINE_INFO(...) ((void)0)
+#endif
+#if NG_LOG_LEVEL <= NG_LOG_LEVEL_WARN
+#define ENGINE_WARN(...) ENGINE_LOG(spdlog::level::warn, __VA_ARGS__) //!< Print warn message
+#else
+#define ENGINE_WARN(...) ((void)0)
+#endif
+#if NG_LOG_LEVEL <= NG_LOG_LEVEL_TRACE
+#define ENGINE_TRACE(...) ENGINE_LOG(spdlog::level::trace, __VA_ARGS__) //!< Print trace message
+#else
+#define ENGINE_TRACE(...) ((void)0)
+#endif
+#if NG_LOG_LEVEL <= NG_LOG_LEVEL_DEBUG
+#define ENGINE_DEBUG(...) ENGINE_LOG(spdlog::level::debug, __VA_ARGS__) //!< Print debug message
+#else
+#define ENGINE_DEBUG(...) ((void)0)
+#endif
+#define ENGINE_RELEASE(...) ENGINE_LOG(spdlog::level::trace, __VA_ARGS__) //!< Print release mode message
+#define ENGINE_FILE(...) Engine::Log::file(__VA_ARGS__) //!< File message
 
 #define TIME_FUNCTION(x, y) Engine::TimerSystem::startTimer(x); y; Engine::TimerSystem::stopTimer(x, false, true); //!< Macro to time a function
 #define GET_TIME(x, y, z)  Engine::TimerSystem::getTime(x, y, z) //!< Macro to get a time from the timer system
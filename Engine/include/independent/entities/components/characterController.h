@@ -10,6 +10,7 @@
 
 #include "independent/entities/entityComponent.h"
 #include "independent/entities/components/camera.h"
+#include "independent/systems/components/collisionWorld.h"
 
 namespace Engine
 {
@@ -35,6 +36,7 @@ namespace Engine
 		float m_movementSpeed; //!< The movement speed
 		float m_mouseSensitivity; //!< The mouse sensitivity
 		bool m_freeze; //!< Freeze the controller
+		BodyID m_body; //!< The capsule which collides for this controller, invalid if it moves freely
 	public:
 		CharacterController(const float speed, const float sensitivity, const bool freeze); //!< Default constructor
 		~CharacterController(); //!< Destructor
@@ -52,6 +54,10 @@ namespace Engine
 		void setFrozen(bool frozen); //!< Freeze the controller
 		bool getFrozen() const; //!< Get whether the controller is frozen
 
+		void enableCollision(const float radius, const float height, const bool followGround); //!< Give the controller a capsule in the scene's collision world
+		void disableCollision(); //!< Let the controller move freely
+		const bool hasCollision() const; //!< Does the controller collide
+
 		void move(const Movement direction, const float deltaTime); //!< Move the entity
 		void rotate(float xoffset, float yoffset, bool constrainPitch = true); //!< Rotate the entity
 		void zoom(float yoffset); //!< Zoom in/out
@@ -9,6 +9,7 @@
 #define SKYBOX_H
 
 #include "independent/entities/entityComponent.h"
+#include "independent/rendering/materials/materialInstance.h"
 
 namespace Engine
 {
@@ -18,7 +19,7 @@ namespace Engine
 	class Skybox
 	{
 	private:
-		Material* m_material; //!< The material containing the cubemap texture, shader and tint
+		MaterialInstance m_instance; //!< The material containing the cubemap texture, shader and tint, and the sky's own parameters
 		Model3D* m_model; //!< The cube model
 	public:
 		Skybox(Model3D* model, Material* material); //!< Constructor
@@ -29,6 +30,7 @@ namespace Engine
 
 		void setMaterial(Material* material); //!< Set the material
 		Material* getMaterial(); //!< Get the material
+		MaterialInstance& getInstance(); //!< Get the material instance
 
 		void onRender(); //!< Render the skybox
 	};
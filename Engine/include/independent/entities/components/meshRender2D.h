@@ -9,7 +9,7 @@
 #define MESHRENDER2D_H
 
 #include "independent/entities/entityComponent.h"
-#include "independent/rendering/materials/material.h"
+#include "independent/rendering/materials/materialInstance.h"
 
 namespace Engine
 {
@@ -19,7 +19,7 @@ namespace Engine
 	class MeshRender2D : public EntityComponent
 	{
 	private:
-		Material* m_material; //!< A pointer to the material
+		MaterialInstance m_instance; //!< The material and the entity's own parameters
 	public:
 		MeshRender2D(Material* material); //!< Constructor
 		~MeshRender2D(); //!< Destructor
@@ -31,6 +31,7 @@ namespace Engine
 
 		void setMaterial(Material* material); //!< Set the material
 		Material* getMaterial(); //!< Get the material
+		MaterialInstance& getInstance(); //!< Get the material instance
 
 		void onRender(); //!< A render submission command
 
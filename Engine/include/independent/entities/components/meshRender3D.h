@@ -10,7 +10,7 @@
 
 #include "independent/entities/entityComponent.h"
 #include "independent/rendering/geometry/model3D.h"
-#include "independent/rendering/materials/material.h"
+#include "independent/rendering/materials/materialInstance.h"
 
 namespace Engine
 {
@@ -21,7 +21,7 @@ namespace Engine
 	{
 	private:
 		Model3D* m_model; //!< A pointer to the 3D geometry
-		Material* m_material; //!< A pointer to the material
+		MaterialInstance m_instance; //!< The material used instead of the model's and the entity's own parameters
 	public:
 		MeshRender3D(Model3D* model, Material* material); //!< Constructor
 		~MeshRender3D(); //!< Destructor
@@ -36,6 +36,7 @@ namespace Engine
 
 		void setMaterial(Material* material); //!< Set the material
 		Material* getMaterial(); //!< Get the material
+		MaterialInstance& getInstance(); //!< Get the material instance
 
 		void onRender(); //!< A render submission command
 	};
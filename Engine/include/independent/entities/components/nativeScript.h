@@ -18,10 +18,16 @@ namespace Engine
 	*/
 	class NativeScript : public EntityComponent
 	{
+	private:
+		uint32_t m_subscriptions; //!< A bit for each event type this script is subscribed to
 	public:
 		NativeScript(); //!< Constructor
 		virtual ~NativeScript(); //!< Destructor
 
+		void subscribe(const EventType type); //!< Receive events of this type
+		void unsubscribe(const EventType type); //!< Stop receiving events of this type
+		const bool isSubscribed(const EventType type) const; //!< Is this script receiving events of this type
+
 		virtual void onAttach() {} //!< Occurs when component is attached to an entity
 		virtual void onDetach() {} //!< Occurs when component is detached from an entity
 		virtual void onUpdate(const float timestep, const float totalTime) {} //!< Update function for components
@@ -9,6 +9,7 @@
 #define TEXT_H
 
 #include "independent/entities/entityComponent.h"
+#include "independent/systems/components/glyphRun.h"
 
 namespace Engine
 {
@@ -21,6 +22,7 @@ namespace Engine
 		std::string m_text; //!< The text to render
 		std::string m_font; //!< The name of the font to use
 		glm::vec4 m_tint; //!< The colour of the text
+		GlyphRun m_glyphRun; //!< The text laid out in the font, only built again when the text or font changes
 	public:
 		Text(const std::string& text, const glm::vec4& tint, const std::string& fontName); //!< Constructor
 		~Text(); //!< Destructor
@@ -39,6 +41,8 @@ namespace Engine
 		void setFont(const std::string& fontName); //!< Set the font name
 		const std::string& getFont() const; //!< Get the font name
 
+		GlyphRun& getGlyphRun(); //!< Get the text laid out in its font
+
 		void onRender(); //!< A render submission command
 	};
 }
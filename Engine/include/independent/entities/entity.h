@@ -28,14 +28,22 @@ namespace Engine
 {
 	class Scene; //!< Forward declare scene
 	class Layer; //!< Forward declare layer
+	class Prefab; //!< Forward declare prefab
+
+	using EntityHandle = uint32_t; //!< Identifies a root entity in its scene without a name
+	const EntityHandle InvalidEntityHandle = 0; //!< A handle which refers to no entity
 
 	/*! \class Entity
 	* \brief An entity class which represents an individual existance in the game world
 	*/
 	class Entity : public Destroyable
 	{
+		friend class Prefab; //!< Prefabs attach their components without the per component checks
+		friend class Scene; //!< The scene keeps the entity's place in its entity list
 	private:
 		std::string m_entityName; //!< The name of the entity
+		EntityHandle m_handle; //!< The handle of the entity in its scene, only root entities have one
+		uint32_t m_listIndex; //!< The index of the entity in its scene's entity list
 		Entity* m_parentEntity; //!< The parent entity
 		Scene* m_parentScene; //!< The scene this entity belongs to
 		Layer* m_layer; //!< The layer this entity is attached to
@@ -47,8 +55,17 @@ namespace Engine
 		Entity(); //!< Constructor
 		virtual ~Entity(); //!< Destructor
 
+		static void* operator new(size_t size) { return PoolAllocator::allocate(size); } //!< Entities come from the pool allocator
+			/*!< \param size a size_t - The size of the entity
+				 \return a void* - The memory */
+		static void operator delete(void* memory, size_t size) { PoolAllocator::deallocate(memory, size); } //!< Return an entity to the pool allocator
+			/*!< \param memory a void* - The memory
+				 \param size a size_t - The size of the entity */
+
 		const std::string& getName(); //!< Get the name of the entity
 		void setName(const std::string& entityName); //!< Set the name of the entity
+		const EntityHandle getHandle() const; //!< Get the handle of the entity
+		void setHandle(const EntityHandle handle); //!< Set the handle of the entity
 
 		void onUpdate(const float timestep, const float totalTime); //!< Update the entity
 
@@ -10,6 +10,8 @@
 
 #include "independent/core/common.h"
 #include "independent/systems/systems/resourceManager.h"
+#include "independent/utils/poolAllocator.h"
+#include "independent/entities/tickScheduler.h"
 
 namespace Engine
 {
@@ -42,6 +44,7 @@ namespace Engine
 	private:
 		EntityComponent(const EntityComponent& other) {} //!< The copy constructor disabled
 		void operator=(const EntityComponent& other) {} //!< The assignment operator disabled
+		uint32_t m_tickGroups; //!< A bit for each tick group this component is registered in
 	protected:
 		std::string m_name; //!< The name of the component
 		ComponentType m_componentType; //!< The component type
@@ -50,6 +53,13 @@ namespace Engine
 		EntityComponent(const ComponentType type); //!< Constructor requiring component type
 		virtual ~EntityComponent(); //!< Destructor
 
+		static void* operator new(size_t size) { return PoolAllocator::allocate(size); } //!< Components come from the pool allocator
+			/*!< \param size a size_t - The size of the component
+				 \return a void* - The memory */
+		static void operator delete(void* memory, size_t size) { PoolAllocator::deallocate(memory, size); } //!< Return a component to the pool allocator
+			/*!< \param memory a void* - The memory
+				 \param size a size_t - The size of the component */
+
 		void detach(); //!< Detach this component from its parent
 
 		void setParent(Entity* parent); //!< Set the component's parent
@@ -60,6 +70,11 @@ namespace Engine
 
 		const ComponentType& getComponentType() const; //!< Get the component type
 
+		void tick(const TickGroup group, const float interval = TickRate::EveryFrame, const bool threadSafe = false); //!< Be updated in a tick group
+		void untick(const TickGroup group); //!< Stop being updated in a tick group
+		void requestTick(const TickGroup group); //!< Be updated in a tick group on the next frame regardless of the rate
+		const bool isTicking(const TickGroup group) const; //!< Is this component updated in a tick group
+
 		virtual void onAttach() = 0; //!< Occurs when component is attached to an entity
 		virtual void onDetach() = 0; //!< Occurs when component is detached from an entity
 		virtual void onUpdate(const float timestep, const float totalTime) = 0; //!< Update function for components
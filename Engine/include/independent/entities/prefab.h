@@ -0,0 +1,75 @@
+/*! \file prefab.h
+*
+* \brief A prefab is an entity template which is built once and instantiated many times
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <functional>
+#include <typeindex>
+#include "independent/entities/entity.h"
+
+namespace Engine
+{
+	class Scene; //!< Forward declare scene
+
+	/*! \class Prefab
+	* \brief An entity template, each instance is an unnamed root entity with its own copy of every component
+	*/
+	class Prefab
+	{
+	private:
+		/*! \struct ComponentTemplate
+		* \brief How to build one component of an instance
+		*/
+		struct ComponentTemplate
+		{
+			std::string name; //!< The name of the component
+			std::type_index type; //!< The class of the component
+			size_t size; //!< The size of the component, used to reserve pooled memory for a batch
+			std::function<EntityComponent*()> create; //!< Creates the component from the arguments given to the template
+		};
+
+		std::string m_layerName; //!< The layer every instance is put on
+		bool m_display; //!< Should instances be displayed
+		std::vector<ComponentTemplate> m_components; //!< The components of every instance
+
+		void attachComponents(Entity* entity, const glm::vec3* position) const; //!< Attach a new copy of every component to an entity
+		std::vector<EntityHandle> createInstances(Scene* scene, const uint32_t count, const glm::vec3* positions) const; //!< Create instances in a single batch
+	public:
+		Prefab(const std::string& layerName, const bool display = true); //!< Constructor
+
+		template<typename T, typename ...Args> void add(const std::string& componentName, Args&&... args); //!< Add a component to the template
+
+		EntityHandle instantiate(Scene* scene, const glm::vec3& position) const; //!< Create one instance
+		std::vector<EntityHandle> instantiate(Scene* scene, const std::vector<glm::vec3>& positions) const; //!< Create one instance per position in a single batch
+		std::vector<EntityHandle> instantiate(Scene* scene, const uint32_t count) const; //!< Create a number of instances in a single batch
+
+		const uint32_t getComponentCount() const; //!< Get the number of components each instance has
+	};
+
+	template<typename T, typename ...Args>
+	//! add()
+	/*!
+	\param componentName a const std::string& - The name of the component
+	\param args a Args&& - Parameter pack, copied into the template
+	*/
+	void Prefab::add(const std::string& componentName, Args&&... args)
+	{
+		for (auto& component : m_components)
+		{
+			if (component.type == std::type_index(typeid(T)))
+			{
+				ENGINE_ERROR("[Prefab::add] Cannot add component as the prefab already has this component. Component: {0}", componentName);
+				return;
+			}
+		}
+
+		// Each instance builds its component from the same arguments
+		m_components.push_back({ componentName, std::type_index(typeid(T)), sizeof(T), [=]() -> EntityComponent* { return new T(args...); } });
+	}
+}
+#endif
@@ -0,0 +1,72 @@
+/*! \file tickScheduler.h
+*
+* \brief Keeps the components which asked to be updated, so a frame only visits the ones with work to do
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef TICKSCHEDULER_H
+#define TICKSCHEDULER_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	class EntityComponent; //!< Forward declare entity component
+	class Scene; //!< Forward declare scene
+
+	/*! \enum TickGroup
+	* \brief The points in a frame a component can be updated at
+	*/
+	enum class TickGroup
+	{
+		PreUpdate = 0, //!< Before events are sent and the scene is updated, scripts only
+		Update = 1, //!< While the scene is updated
+		PostUpdate = 2 //!< After the scene and windows are updated, scripts only
+	};
+
+	const uint32_t TickGroupCount = 3; //!< The number of tick groups
+
+	namespace TickRate
+	{
+		const float EveryFrame = 0.f; //!< Tick every frame
+		const float TenHertz = 0.1f; //!< Tick ten times a second
+		const float OnDemand = -1.f; //!< Tick only on the frame after a tick is requested
+	}
+
+	/*! \struct TickEntry
+	* \brief A component registered in a tick group
+	*/
+	struct TickEntry
+	{
+		EntityComponent* Component; //!< The component, null once it has been removed
+		float Interval; //!< The seconds between ticks, 0 for every frame or negative for on demand
+		float Elapsed; //!< The seconds since the last tick
+		bool ThreadSafe; //!< Can the component tick on another thread at the same time as other thread safe components
+		bool Requested; //!< Has a tick been requested
+	};
+
+	/*! \class TickScheduler
+	* \brief Ticks the components registered in each group, skipping ones on inactive layers and ones which are not due yet
+	*/
+	class TickScheduler
+	{
+	private:
+		static const uint32_t ParallelTickCount = 16; //!< The number of due thread safe ticks before they are spread across threads
+
+		static std::array<std::vector<TickEntry>, TickGroupCount> s_ticks; //!< The components registered in each group
+		static std::array<bool, TickGroupCount> s_dirty; //!< Does a group have removed entries to clear out
+		static uint32_t s_runDepth; //!< The number of groups being run, entries cannot be erased while above 0
+
+		static void tickComponent(EntityComponent* component, const TickGroup group, const float timestep, const float totalTime); //!< Call the update function of a group on a component
+		static void compact(const TickGroup group); //!< Remove cleared entries from a group
+	public:
+		static void add(EntityComponent* component, const TickGroup group, const float interval, const bool threadSafe); //!< Register a component in a group
+		static void remove(EntityComponent* component, const TickGroup group); //!< Remove a component from a group
+		static void request(EntityComponent* component, const TickGroup group); //!< Tick a component in a group on the next run regardless of its rate
+
+		static void run(const TickGroup group, Scene* scene, const float timestep, const float totalTime); //!< Tick every due component of a scene in a group
+		static const uint32_t getTickCount(const TickGroup group); //!< Get the number of components registered in a group
+	};
+}
+#endif
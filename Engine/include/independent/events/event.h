@@ -23,6 +23,8 @@ namespace Engine
 		MousePressed, MouseReleased, MouseMoved, MouseScrolled
 	};
 
+	static const uint32_t EventTypeCount = static_cast<uint32_t>(EventType::MouseScrolled) + 1; //!< The number of event types
+
 	/*! \enum EventCategory
 	* \brief Enum for event category flags
 	*/
@@ -10,6 +10,7 @@
 
 #include "independent/core/common.h"
 #include "independent/entities/entity.h"
+#include "independent/utils/frameAllocator.h"
 
 namespace Engine
 {
@@ -25,10 +26,15 @@ namespace Engine
 		bool m_display; //!< Should this layer be rendered
 		bool m_active; //!< Should this layer be receiving updates
 		LayerManager* m_layerManager; //!< The layer manager this scene is attached to
+		uint32_t m_subscriptions; //!< A bit for each event type this layer is subscribed to
 	public:
 		Layer(const char* layerName); //!< Constructor
 		virtual ~Layer(); //!< Destructor
 
+		void subscribe(const EventType type); //!< Receive events of this type
+		void unsubscribe(const EventType type); //!< Stop receiving events of this type
+		const bool isSubscribed(const EventType type) const; //!< Is this layer receiving events of this type
+
 		virtual void onAttach() {} //!< Called when attaching to layer manager
 		virtual void onDetach() {} //!< Called when detaching from layer manager
 		virtual void onUpdate(const float timestep, const float totalTime) {} //!< Called one per frame
@@ -86,8 +92,8 @@ namespace Engine
 		void setLayerManager(LayerManager* manager); //!< Set the layer manager
 		LayerManager* getLayerManager() const; //!< Get the layer manager
 
-		std::vector<Entity*> getEntities(); //!< Get all entities that are on this layer
-		std::vector<Entity*> getRenderableEntities(); //!< Get all entities that contain some rendering component on this layer
+		FrameVector<Entity*> getEntities(); //!< Get all entities that are on this layer
+		FrameVector<Entity*> getRenderableEntities(); //!< Get all entities that contain some rendering component on this layer
 	};
 }
 #endif
\ No newline at end of file
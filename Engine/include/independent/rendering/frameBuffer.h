@@ -52,6 +52,7 @@ namespace Engine
 		FrameBufferLayout m_layout; //!< The layout of the framebuffer
 		bool m_default; //!< Is this framebuffer the default framebuffer
 		bool m_useSceneSize; //!< Is this framebuffer to be the size of the scene
+		float m_sceneScale; //!< The fraction of the scene size used when sized to the scene
 
 		std::map<std::string, Texture2D*> m_sampledTargets; //!< A list of sampled targets
 		std::map<std::string, RenderBuffer*> m_nonSampledTargets; //!< A list of non-sampled targets
@@ -70,6 +71,11 @@ namespace Engine
 			/*!< \return a bool - Whether this framebuffer is the default framebuffer */
 		inline bool useSceneSize() const { return m_useSceneSize; } //!< Get whether this framebuffer is the size of the scene view
 			/*!< \return a bool - Whether this framebuffer is the size of the scene view */
+		inline float getSceneScale() const { return m_sceneScale; } //!< Get the fraction of the scene size used when sized to the scene
+			/*!< \return a float - The fraction of the scene size */
+		inline void setSceneScale(const float scale) { m_sceneScale = scale; } //!< Set the fraction of the scene size used when sized to the scene
+			/*!< \param scale a const float - The fraction of the scene size, applied on the next resize */
+		glm::ivec2 getScaledSize(const glm::ivec2& sceneSize) const; //!< Get the size of the framebuffer for a scene size
 		inline FrameBufferLayout& getLayout() { return m_layout; } //!< Get the framebuffer layout
 			/*!< \return a FrameBufferLayout& - The layout of the framebuffer */
 
@@ -15,6 +15,8 @@
 
 namespace Engine
 {
+	class MappedFile; //!< Forward declare the mapped file
+
 	/*! \struct Geometry3D
 	* \brief A piece of 3D geometry and its position in the buffer
 	*/
@@ -38,6 +40,12 @@ namespace Engine
 		std::vector<uint32_t> m_indices; //!< The indices of the mesh
 		Geometry3D m_geometry; //!< The geometry of this 3D mesh
 		Material* m_material; //!< The material to apply to this mesh
+
+		Shared<MappedFile> m_mappedFile; //!< The cooked file the mapped vertices and indices are in, shared by every mesh of the model
+		const Vertex3D* m_mappedVertices; //!< The vertices in the cooked file, used in place of the vertex list when set
+		const uint32_t* m_mappedIndices; //!< The indices in the cooked file, used in place of the index list when set
+		uint32_t m_mappedVertexCount; //!< The number of mapped vertices
+		uint32_t m_mappedIndexCount; //!< The number of mapped indices
 	public:
 		Mesh3D(const Geometry3D& geometry); //!< Constructor
 		Mesh3D(std::vector<Vertex3D>& vertices, std::vector<uint32_t> indices); //!< Constructor
@@ -50,6 +58,13 @@ namespace Engine
 
 		std::vector<Vertex3D>& getVertices(); //!< Get the vertex list
 		std::vector<uint32_t>& getIndices(); //!< Get the indices list
+
+		void setMappedData(const Shared<MappedFile>& file, const Vertex3D* vertices, const uint32_t vertexCount, const uint32_t* indices, const uint32_t indexCount); //!< Use vertices and indices in a mapped file
+		const Vertex3D* getVertexData() const; //!< Get the vertices to upload
+		const uint32_t getVertexCount() const; //!< Get the number of vertices to upload
+		const uint32_t* getIndexData() const; //!< Get the indices to upload
+		const uint32_t getIndexCount() const; //!< Get the number of indices to upload
+		void releaseData(); //!< Drop the vertices and indices once they are uploaded
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*! \file meshCooker.h
+*
+* \brief Cooks models read by assimp into a binary file of ready to upload vertices and indices
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include "independent/rendering/geometry/mesh3D.h"
+#include "independent/utils/batchTransforms.h"
+
+namespace Engine
+{
+	namespace CookedMeshFormat
+	{
+		const uint32_t Magic = 0x48534D43; //!< The first four bytes of every cooked mesh, 'CMSH'
+		const uint32_t Version = 3; //!< Increase whenever the layout or the cooking changes
+		const uint32_t Quantised = 1; //!< The vertices are stored as QuantisedVertex3D rather than Vertex3D
+		// Every 3D mesh shares one 32 bit index buffer drawn by a single multi draw indirect call, so short indices are widened on
+		// load. Only quantised files, which are expanded on load anyway, use them. Unquantised files keep 32 bit indices at twice
+		// the disk space so they can be mapped and uploaded without a copy
+		const uint32_t ShortIndices = 2; //!< The indices are stored in 16 bits, every submesh has few enough vertices and the file is quantised
+	}
+
+	/*! \struct QuantisedVertex3D
+	* \brief A Vertex3D with its position and texture coordinate stored as 16 bit fractions of its submesh's bounds
+	*/
+	struct QuantisedVertex3D
+	{
+		std::array<uint16_t, 3> Position; //!< The position within the submesh bounds
+		std::array<uint16_t, 2> TexCoords; //!< The texture coordinate within the submesh texture coordinate bounds
+		std::array<int16_t, 3> Normal; //!< The normal of the vertex
+		std::array<int16_t, 3> Tangent; //!< The tangent of the vertex
+		std::array<int16_t, 3> Bitangent; //!< The bitangent of the vertex
+	};
+
+	/*! \struct CookedSubmesh
+	* \brief Where a mesh of the model is in the cooked vertices and indices
+	*/
+	struct CookedSubmesh
+	{
+		uint32_t FirstVertex; //!< The index of the submesh's first vertex
+		uint32_t VertexCount; //!< The number of vertices
+		uint32_t FirstIndex; //!< The index of the submesh's first index
+		uint32_t IndexCount; //!< The number of indices, each relative to the submesh's first vertex
+		uint32_t MaterialIndex; //!< The index of the submesh's material in the material table
+		uint32_t Padding; //!< Unused, keeps the bounds aligned
+		AABB Bounds; //!< The bounds of the submesh's positions
+		glm::vec2 UVMin; //!< The smallest texture coordinate
+		glm::vec2 UVMax; //!< The largest texture coordinate
+	};
+
+	/*! \struct CookedMeshHeader
+	* \brief The start of every cooked mesh, followed by the submesh table, the material table, the material names, the vertices
+	* and then the indices
+	*/
+	struct CookedMeshHeader
+	{
+		uint32_t magic = CookedMeshFormat::Magic; //!< Identifies the file as a cooked mesh
+		uint32_t version = CookedMeshFormat::Version; //!< The format version
+		uint64_t sourceSize = 0; //!< The size of the model file the mesh was cooked from
+		int64_t sourceTime = 0; //!< The write time of the model file
+		uint32_t flags = 0; //!< The CookedMeshFormat flags
+		uint32_t vertexSize = 0; //!< The size of one stored vertex, checks the layout has not changed
+		uint32_t submeshCount = 0; //!< The number of submeshes
+		uint32_t materialCount = 0; //!< The number of materials
+		uint32_t vertexCount = 0; //!< The number of vertices in every submesh
+		uint32_t indexCount = 0; //!< The number of indices in every submesh
+		uint64_t namesOffset = 0; //!< The offset of the material names from the start of the file
+		uint64_t vertexOffset = 0; //!< The offset of the vertices from the start of the file
+		uint64_t indexOffset = 0; //!< The offset of the indices from the start of the file
+		AABB bounds; //!< The bounds of the whole model
+		uint64_t padding = 0; //!< Unused, keeps the header a multiple of eight bytes
+	};
+
+	/*! \struct CookedMaterial
+	* \brief The name of a material used by the model, as it is named in the model file
+	*/
+	struct CookedMaterial
+	{
+		uint32_t NameOffset; //!< The offset of the name from the start of the material names
+		uint32_t NameLength; //!< The length of the name
+	};
+
+	/*! \struct CookedMesh
+	* \brief A model's meshes in the layout they are cooked in
+	*/
+	struct CookedMesh
+	{
+		std::vector<CookedSubmesh> Submeshes; //!< The submeshes
+		std::vector<std::string> Materials; //!< The material of each submesh is an index into this list
+		std::vector<Vertex3D> Vertices; //!< The vertices of every submesh
+		std::vector<uint32_t> Indices; //!< The indices of every submesh
+		AABB Bounds; //!< The bounds of the whole model
+	};
+
+	/*! \class MeshCooker
+	* \brief Running assimp's triangulation, normal and tangent generation on every model at every start is slow. A model is
+	* read by assimp once, then cooked to a file holding its vertices in the layout they are uploaded in. Later starts map the
+	* file and hand the vertices straight to the renderer. Nothing here touches the graphics API, so cooking and verifying
+	* can run without a window
+	*/
+	class MeshCooker
+	{
+	private:
+		static bool s_initialised; //!< Has the config been read
+		static bool s_enabled; //!< Are cooked meshes read and written
+		static bool s_quantise; //!< Are positions and texture coordinates quantised
+		static bool s_verify; //!< Is every newly cooked mesh checked against assimp
+		static std::string s_directory; //!< The directory the cooked meshes are kept in
+
+		static void initialise(); //!< Read the cook settings from the config
+		static std::string getCookedPath(const std::string& sourcePath); //!< Get the cooked file of a model
+	public:
+		static const bool isEnabled(); //!< Are cooked meshes used
+
+		static const bool build(const std::string& sourcePath, CookedMesh& mesh); //!< Read a model with assimp into the cooked layout
+		static const bool read(const std::string& cookedPath, CookedMesh& mesh, const uint64_t sourceSize = 0, const int64_t sourceTime = 0); //!< Read a cooked mesh
+		static const bool map(const std::string& cookedPath, std::vector<Mesh3D>& meshes, const uint64_t sourceSize = 0, const int64_t sourceTime = 0); //!< Map a cooked mesh for uploading
+		static const bool write(const std::string& cookedPath, const CookedMesh& mesh, const bool quantise, const uint64_t sourceSize = 0, const int64_t sourceTime = 0); //!< Write a cooked mesh
+
+		static const bool cook(const std::string& sourcePath, const std::string& cookedPath, const bool quantise); //!< Cook a model to a file
+		static const bool verify(const std::string& sourcePath, const std::string& cookedPath); //!< Check a cooked mesh against assimp's output
+
+		static const bool load(const std::string& filePath, std::vector<Mesh3D>& meshes); //!< Load a model's meshes, from its cooked file when it is up to date
+	};
+}
+#endif
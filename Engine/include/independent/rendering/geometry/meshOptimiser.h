@@ -0,0 +1,49 @@
+/*! \file meshOptimiser.h
+*
+* \brief Welds duplicate vertices and reorders triangles and vertices so meshes draw with fewer vertex shader runs
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef MESHOPTIMISER_H
+#define MESHOPTIMISER_H
+
+#include "independent/rendering/geometry/vertex.h"
+
+namespace Engine
+{
+	/*! \class MeshOptimiser
+	* \brief Optimises the vertices and indices of a mesh before it is uploaded. Identical vertices are welded, triangles are
+	* ordered for the post transform vertex cache with Forsyth's algorithm, clusters of triangles can then be ordered so the
+	* outside of a mesh is drawn first, and vertices are finally stored in the order they are first used
+	*/
+	class MeshOptimiser
+	{
+	private:
+		static bool s_initialised; //!< Has the config been read
+		static bool s_enabled; //!< Are meshes optimised
+		static bool s_overdraw; //!< Are triangle clusters ordered to reduce overdraw
+
+		static void initialise(); //!< Read the optimiser settings from the config
+	public:
+		static const uint32_t CacheSize = 16; //!< The size of the FIFO vertex cache the ACMR is measured against
+
+		static const bool isEnabled(); //!< Are meshes optimised
+		static void setEnabled(const bool enabled, const bool overdraw); //!< Turn the passes on or off in place of the config
+
+		static void weld(std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices); //!< Merge identical vertices
+		static void weld(std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices); //!< Merge identical vertices
+		static void optimiseVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount); //!< Order the triangles for the vertex cache
+		static void optimiseOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex3D>& vertices); //!< Order the clusters of cache ordered triangles outside first
+		static void optimiseVertexFetch(std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices); //!< Store the vertices in the order they are first used
+		static void optimiseVertexFetch(std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices); //!< Store the vertices in the order they are first used
+
+		static const float getACMR(const std::vector<uint32_t>& indices, const uint32_t vertexCount, const uint32_t cacheSize = CacheSize); //!< Get the average cache miss ratio
+		static const bool canUseShortIndices(const uint32_t vertexCount); //!< Can every index of a mesh be stored in 16 bits
+		static void toShortIndices(const std::vector<uint32_t>& indices, std::vector<uint16_t>& shortIndices); //!< Narrow the indices to 16 bits
+
+		static void optimise(const std::string& meshName, std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices); //!< Run every enabled pass on a mesh
+		static void optimise(const std::string& meshName, std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices); //!< Run every enabled pass on a terrain mesh
+	};
+}
+#endif
@@ -17,21 +17,6 @@ namespace Engine
 {
 	namespace Quad
 	{
-		//! getLocalVertices()
-		/*!
-		\return a std::vector<Vertex2D> - The list of local vertices for a quad
-		*/
-		static std::vector<Vertex2D> getLocalVertices()
-		{
-			std::vector<Vertex2D> localVertices;
-			localVertices.resize(4);
-			localVertices[0] = Vertex2D({  0.5f,  0.5f, 0.f, 1.f }, { 1.f, 1.f }, 0, { 1.f, 1.f, 1.f, 1.f });
-			localVertices[1] = Vertex2D({  0.5f, -0.5f, 0.f, 1.f }, { 1.f, 0.f }, 0, { 1.f, 1.f, 1.f, 1.f });
-			localVertices[2] = Vertex2D({ -0.5f, -0.5f, 0.f, 1.f }, { 0.f, 0.f }, 0, { 1.f, 1.f, 1.f, 1.f });
-			localVertices[3] = Vertex2D({ -0.5f,  0.5f, 0.f, 1.f }, { 0.f, 1.f }, 0, { 1.f, 1.f, 1.f, 1.f });
-			return localVertices;
-		}
-
 		//! getIndices()
 		/*!
 		\param capacity a const uint32_t - The batch capacity
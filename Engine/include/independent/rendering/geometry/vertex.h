@@ -47,42 +47,26 @@ namespace Engine
 				 \param texCoord a const glm::vec2& - The vertex texture coordinate */
 	};
 
-	/*! \struct Vertex2D
-	* \brief A 2D vertex containing all the information about a 2D vertex
+	/*! \struct QuadInstance2D
+	* \brief One quad drawn by the 2D renderer, the vertex shader expands it into its four corners
 	*/
-	struct Vertex2D
+	struct QuadInstance2D
 	{
-		glm::vec4 Position; //!< Position of the vertex
-		glm::vec2 TexCoords; //!< The texture coordinate of the vertex
-		int32_t TexUnit; //!< The texture unit for the vertex
-		uint32_t Tint; //!< The tint of the vertex
-		Vertex2D() {}; //!< Default constructor
-		Vertex2D(const glm::vec4& pos, const glm::vec2& texCoord, const int32_t texUnit, const glm::vec4& tint) 
-			: Position(pos), TexCoords(texCoord), TexUnit(texUnit), Tint(MemoryUtils::pack(tint)) {} //!< Constructor
-			/*!< \param pos a const glm::vec4& - The vertex position
-				 \param texCoord a const glm::vec2& - The vertex texture coordinate
-				 \param texUnit a const int32_t - The vertex texture unit
-				 \param tint a const glm::vec4& - The vertex tint */
-	};
-
-	/*! \struct Vertex2DMultiTextured
-	* \brief A 2D vertex containing all the information about a 2D vertex
-	*/
-	struct Vertex2DMultiTextured
-	{
-		glm::vec4 Position; //!< Position of the vertex
-		glm::vec2 TexCoords; //!< The texture coordinate of the vertex
-		int32_t TexUnit1; //!< A texture unit for the vertex
-		int32_t TexUnit2; //!< A texture unit for the vertex
-		uint32_t Tint; //!< The tint of the vertex
-		Vertex2DMultiTextured() {}; //!< Default constructor
-		Vertex2DMultiTextured(const glm::vec4& pos, const glm::vec2& texCoord, const int32_t texUnit1, const int32_t texUnit2, const glm::vec4& tint) 
-			: Position(pos), TexCoords(texCoord), TexUnit1(texUnit1), TexUnit2(texUnit2), Tint(MemoryUtils::pack(tint)) {} //!< Constructor
-			/*!< \param pos a const glm::vec4& - The vertex position
-				 \param texCoord a const glm::vec2& - The vertex texture coordinate
-				 \param texUnit1 a const int32_t - The first vertex texture unit
-				 \param texUnit2 a const int32_t - The second vertex texture unit
-				 \param tint a const glm::vec4& - The vertex tint */
+		glm::vec4 Transform; //!< The centre of the quad in x and y, its depth in z and its rotation in radians in w
+		glm::vec2 Size; //!< The width and height of the quad, a negative height mirrors it
+		glm::vec4 UVRect; //!< The UV start in x and y and the UV end in z and w
+		uint32_t Tint; //!< The tint of the quad
+		int32_t TexUnit1; //!< The texture unit of the quad's first subtexture
+		int32_t TexUnit2; //!< The texture unit of the quad's second subtexture, only read by multitextured shaders
+		QuadInstance2D() {}; //!< Default constructor
+		QuadInstance2D(const glm::vec4& transform, const glm::vec2& size, const glm::vec4& uvRect, const glm::vec4& tint, const int32_t texUnit1, const int32_t texUnit2)
+			: Transform(transform), Size(size), UVRect(uvRect), Tint(MemoryUtils::pack(tint)), TexUnit1(texUnit1), TexUnit2(texUnit2) {} //!< Constructor
+			/*!< \param transform a const glm::vec4& - The centre, depth and rotation
+				 \param size a const glm::vec2& - The width and height
+				 \param uvRect a const glm::vec4& - The UV start and end
+				 \param tint a const glm::vec4& - The tint
+				 \param texUnit1 a const int32_t - The first texture unit
+				 \param texUnit2 a const int32_t - The second texture unit */
 	};
 }
 #endif
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace Engine
 	*/
 	enum class VertexBufferUsage
 	{
-		None = 0, StaticDraw = 1, DynamicDraw = 2
+		None = 0, StaticDraw = 1, DynamicDraw = 2, StreamDraw = 3
 	};
 
 	/*! \class VertexBuffer
@@ -13,6 +13,7 @@
 #include "independent/systems/components/resource.h"
 #include "independent/rendering/shaders/shaderProgram.h"
 #include "independent/rendering/textures/subTexture.h"
+#include "independent/rendering/materials/materialParameters.h"
 
 namespace Engine
 {
@@ -50,6 +51,8 @@ namespace Engine
 		void setShininess(const float shininess); //!< Set the material's shininess
 		float getShininess() const; //!< Get the material's shininess
 
+		MaterialParameters getParameters() const; //!< Get the material's parameters for a submission
+
 		void printDetails() override; //!< Print the resource details
 	};
 }
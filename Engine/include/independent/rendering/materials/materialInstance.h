@@ -0,0 +1,51 @@
+/*! \file materialInstance.h
+*
+* \brief An instance of a shared material, which can change its own parameters without changing the material
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef MATERIALINSTANCE_H
+#define MATERIALINSTANCE_H
+
+#include "independent/rendering/materials/material.h"
+
+namespace Engine
+{
+	/*! \class MaterialInstance
+	* \brief A shared material with parameters of its own. Only the parameters set on the instance override the material's,
+	* so the material can be swapped while an instance keeps its tint
+	*/
+	class MaterialInstance
+	{
+	private:
+		/*! \enum Override
+		* \brief The parameters set on the instance
+		*/
+		enum Override : uint32_t
+		{
+			None = 0, Tint = 1, UVRect = 2, Scalars = 4
+		};
+
+		Material* m_material; //!< The shared material, never changed by the instance
+		MaterialParameters m_parameters; //!< The parameters set on the instance
+		uint32_t m_overrides; //!< Which of the parameters are set on the instance
+	public:
+		MaterialInstance(Material* material = nullptr); //!< Constructor
+
+		inline void setMaterial(Material* material) { m_material = material; } //!< Set the shared material
+			/*!< \param material a Material* - A pointer to the shared material */
+		inline Material* getMaterial() const { return m_material; } //!< Get the shared material
+			/*!< \return a Material* - A pointer to the shared material */
+
+		void setTint(const glm::vec4& tint); //!< Set the tint of the instance
+		const glm::vec4& getTint() const; //!< Get the tint of the instance
+		void setUVRect(const glm::vec4& uvRect); //!< Set the UV rectangle of the instance
+		void setScalars(const glm::vec4& scalars); //!< Set the scalar parameters of the instance
+		void reset(); //!< Go back to the material's parameters
+
+		MaterialParameters getParameters() const; //!< Get the parameters of the instance
+		MaterialParameters getParameters(Material* material) const; //!< Get the parameters of another material with the instance's applied
+	};
+}
+#endif
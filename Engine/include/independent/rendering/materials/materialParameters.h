@@ -0,0 +1,42 @@
+/*! \file materialParameters.h
+*
+* \brief The per-instance parameters of a material, packed into a buffer each frame and indexed by instance ID
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef MATERIALPARAMETERS_H
+#define MATERIALPARAMETERS_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \struct MaterialParameters
+	* \brief Everything which can differ between two submissions sharing a shader and textures
+	*/
+	struct MaterialParameters
+	{
+		glm::vec4 Tint = glm::vec4(1.f); //!< The tint
+		glm::vec4 UVRect = { 0.f, 0.f, 1.f, 1.f }; //!< The start UV in xy and the end UV in zw of the first subtexture
+		glm::vec4 Scalars = glm::vec4(0.f); //!< The shininess in x, the rest are free for shaders to use
+	};
+
+	/*! \class MaterialParameterBuffer
+	* \brief The parameter blocks of every submission this frame, packed together so a submission only holds its instance ID
+	*/
+	class MaterialParameterBuffer
+	{
+	private:
+		static std::vector<MaterialParameters> s_parameters; //!< The blocks added this frame, the memory is kept between frames
+	public:
+		static const uint32_t add(const MaterialParameters& parameters); //!< Add a block for this frame
+		static inline const MaterialParameters& get(const uint32_t instanceID) { return s_parameters[instanceID]; } //!< Get a block added this frame
+			/*!< \param instanceID a const uint32_t - The instance ID given when the block was added
+				 \return a const MaterialParameters& - The block */
+		static inline const uint32_t getCount() { return static_cast<uint32_t>(s_parameters.size()); } //!< Get the number of blocks added this frame
+			/*!< \return a const uint32_t - The number of blocks */
+		static void onFrameEnd(); //!< Drop the blocks once the frame has been drawn
+	};
+}
+#endif
@@ -31,7 +31,7 @@ namespace Engine
 		FirstPass(); //!< Constructor
 		~FirstPass(); //!< Destructor
 
-		void onRender(std::vector<Entity*>& entities) override; //!< The rendering to perform for this pass
+		void onRender(FrameVector<Entity*>& entities) override; //!< The rendering to perform for this pass
 		FrameBuffer* getFrameBuffer() override; //!< Get the framebuffer of this render pass
 	};
 }
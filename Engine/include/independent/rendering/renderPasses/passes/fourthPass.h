@@ -34,7 +34,7 @@ namespace Engine
 		~FourthPass(); //!< Destructor
 
 		void onAttach() override; //!< Called when the pass is attached to a scene
-		void onRender(std::vector<Entity*>& entities) override; //!< The rendering to perform for this pass
+		void onRender(FrameVector<Entity*>& entities) override; //!< The rendering to perform for this pass
 		FrameBuffer* getFrameBuffer() override; //!< Get the framebuffer of this render pass
 	};
 }
@@ -34,7 +34,7 @@ namespace Engine
 		~SecondPass(); //!< Destructor
 
 		void onAttach(); //!< Called when the pass is attached to the scene
-		void onRender(std::vector<Entity*>& entities) override; //!< The rendering to perform for this pass
+		void onRender(FrameVector<Entity*>& entities) override; //!< The rendering to perform for this pass
 		FrameBuffer* getFrameBuffer() override; //!< Get the framebuffer of this render pass
 	};
 }
@@ -23,13 +23,18 @@ namespace Engine
 		FrameBuffer* m_refractionFrameBuffer; //!< A framebuffer
 		UniformBuffer* m_cameraUBO; //!< The camera UBO
 		UniformBuffer* m_clipUBO; //!< The clip UBO
+		uint32_t m_reflectionInterval; //!< The reflection is drawn once every this many frames
+		uint32_t m_frameCount; //!< The number of frames rendered by the pass
 		void setupPass(); //!< Set up the pass by setting the settings
 		void setupPass1(); //!< Set up the pass by setting the settings
+		void renderScene(FrameVector<Entity*>& entities); //!< Render the terrain, the objects and the skybox into the bound framebuffer
+		void renderReflection(FrameVector<Entity*>& entities); //!< Render the view from below the water
+		void renderRefraction(FrameVector<Entity*>& entities); //!< Render the view through the water
 	public:
 		WaterPass(); //!< Constructor
 		~WaterPass(); //!< Destructor
 
-		void onRender(std::vector<Entity*>& entities) override; //!< The rendering to perform for this pass
+		void onRender(FrameVector<Entity*>& entities) override; //!< The rendering to perform for this pass
 		FrameBuffer* getFrameBuffer() override; //!< Get the framebuffer of this render pass
 	};
 }
@@ -11,6 +11,7 @@
 #include <vector>
 #include "independent/rendering/frameBuffer.h"
 #include "independent/entities/entity.h"
+#include "independent/utils/frameAllocator.h"
 
 namespace Engine
 {
@@ -33,7 +34,7 @@ namespace Engine
 		virtual void onAttach() {} //!< Called when the pass is attached to a scene
 		virtual void onDetach() {} //!< Called when the pass is detached from a scene
 
-		virtual void onRender(std::vector<Entity*>& entities) = 0; //!< The rendering to perform for this pass
+		virtual void onRender(FrameVector<Entity*>& entities) = 0; //!< The rendering to perform for this pass
 		virtual FrameBuffer* getFrameBuffer() = 0; //!< Get a framebuffer from the render pass
 
 		void attachScene(Scene* scene); //!< Attach the scene to this pass
@@ -59,6 +59,7 @@ namespace Engine
 		static void setViewport(const int x, const int y, const int width, const int height); //!< Resize the viewport
 
 		static void draw(const uint32_t drawCount); //!< Draw the geometry
+		static void drawInstanced(const uint32_t drawCount, const uint32_t instanceCount); //!< Draw the geometry several times
 		static void drawMultiIndirect(const uint32_t commandsSize); //!< Draw the geometry
 	};
 }
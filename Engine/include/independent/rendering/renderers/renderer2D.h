@@ -14,6 +14,7 @@
 #include "independent/entities/components/text.h"
 #include "independent/entities/components/meshRender2D.h"
 #include "independent/rendering/geometry/quad.h"
+#include "independent/utils/frameAllocator.h"
 
 namespace Engine
 {
@@ -22,12 +23,14 @@ namespace Engine
 	*/
 	struct BatchEntry2D
 	{
-		std::string submissionName; //!< The name of the submission
+		const char* submissionName; //!< The name of the submission, owned by the first subtexture
 		ShaderProgram* shader; //!< The shader program
-		std::vector<SubTexture*> subTextures; //!< The list of subtextures in this entry
-		std::vector<int32_t> textureUnits; //!< The list of texture units used
+		FrameVector<SubTexture*> subTextures; //!< The list of subtextures in this entry
+		FrameVector<int32_t> textureUnits; //!< The list of texture units used
 		glm::mat4 modelMatrix; //!< The model matrix
-		glm::vec4 tint; //!< The tint
+		uint32_t parameters; //!< The instance ID of the submission's parameter block
+		QuadInstance2D* instances; //!< The quads of a glyph run, nullptr when the entry is one quad built from its model matrix
+		uint32_t instanceCount; //!< The number of quads the entry draws
 	};
 
 	/*! \class Renderer2D
@@ -36,23 +39,29 @@ namespace Engine
 	class Renderer2D
 	{
 	private:
-		static uint32_t s_batchCapacity; //!< Batch capacity for 2D rendering (Number of Quads)
+		static uint32_t s_batchCapacity; //!< Batch capacity for 2D rendering (Number of Quads which fit in the instance buffer)
 		static TextureUnitManager* s_unitManager; //!< The texture unit manager
 		static std::array<int32_t, 16> s_unit; //!< The texture unit
 		static std::vector<BatchEntry2D> s_batchQueue; //!< The queue of 2D submissions
+		static std::vector<BatchEntry2D> s_drawQueue; //!< The submissions of the shader being drawn, kept so its memory is reused every flush
+		static uint32_t s_queuedInstances; //!< The number of quads in the queue, a glyph run is one entry but many quads
 
-		static bool submissionChecks(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures); //!< Check the submission
+		static bool submissionChecks(ShaderProgram* shaderProgram, SubTexture* const* subTextures, const uint32_t subTextureCount); //!< Check the submission
+		static void submitEntry(ShaderProgram* shaderProgram, SubTexture* const* subTextures, const uint32_t subTextureCount, const glm::mat4& modelMatrix, const MaterialParameters& parameters); //!< Add a submission to the queue
+		static void submitGlyphs(const GlyphRun& glyphRun, QuadInstance2D* instances, const glm::vec4& tint, const glm::mat4& modelMatrix); //!< Add the quads of a glyph run to the queue
 		static void sortSubmissions(std::vector<BatchEntry2D>& submissions); //!< Sort the submissions
 
 		static void flush(); //!< Flush the scene
-		static void draw(std::vector<BatchEntry2D>& submissionList); //!< Draw the scene
+		static void draw(std::vector<BatchEntry2D>& submissionList, const uint32_t instanceCount); //!< Draw the scene
 	public:
 		static void initialise(const uint32_t batchCapacity); //!< Initialise the renderer
 
 		static void begin(); //!< Begin a new 2D scene
 		static void submit(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures, const glm::mat4& modelMatrix, const glm::vec4& tint); //!< Submit a 2D entity
+		static void submit(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures, const glm::mat4& modelMatrix, const MaterialParameters& parameters); //!< Submit a 2D entity with its own parameters
 		static void submitText(Text* text, const glm::mat4& modelMatrix); //!< Submit text to renderer
 		static void submitText(const std::string& text, const std::string& fontName, const glm::vec4& tint, const glm::mat4& modelMatrix); //!< Submit text to renderer
+		static void submitGlyphRun(GlyphRun& glyphRun, const glm::vec4& tint, const glm::mat4& modelMatrix); //!< Submit text already laid out
 
 		static void end(); //!< End the 2D scene
 
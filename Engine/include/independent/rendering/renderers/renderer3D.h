@@ -18,6 +18,8 @@
 #include "independent/rendering/geometry/mesh3D.h"
 #include "independent/rendering/materials/material.h"
 #include "independent/entities/components/meshRender3D.h"
+#include "independent/utils/frameAllocator.h"
+#include "independent/utils/batchTransforms.h"
 
 namespace Engine
 {
@@ -26,16 +28,19 @@ namespace Engine
 	*/
 	struct BatchEntry3D
 	{
-		std::string submissionName; //!< The submission name
+		const char* submissionName; //!< The submission name, copied into frame memory
 		Geometry3D geometry; //!< The geometry
 		ShaderProgram* shader; //!< The shader program
-		std::vector<SubTexture*> subTextures; //!< The list of subtextures in this entry
-		std::vector<CubeMapTexture*> cubeTextures; //!< The list of cubemap textures in this entry
-		std::vector<int32_t> textureUnits; //!< The list of texture units used subtextures
-		std::vector<int32_t> cubeTextureUnits; //!< The list of texture units used for cubemaps
-		float shininess; //!< The shininess of the material
-		glm::mat4 modelMatrix; //!< The model matrix
-		glm::vec4 tint; //!< The tint
+		FrameVector<SubTexture*> subTextures; //!< The list of subtextures in this entry
+		FrameVector<CubeMapTexture*> cubeTextures; //!< The list of cubemap textures in this entry
+		FrameVector<int32_t> textureUnits; //!< The list of texture units used subtextures
+		FrameVector<int32_t> cubeTextureUnits; //!< The list of texture units used for cubemaps
+		glm::mat4 modelMatrix; //!< The model matrix, unused when the matrix is composed
+		glm::vec3 position; //!< The position, used when the matrix is composed
+		glm::vec3 orientation; //!< The rotation around x, y and z in degrees, used when the matrix is composed
+		glm::vec3 scale; //!< The scale, used when the matrix is composed
+		bool composeMatrix; //!< Is the model matrix composed with the rest of the batch when the instance data is filled
+		uint32_t parameters; //!< The instance ID of the submission's parameter block
 	};
 
 	/*! \class Renderer3D
@@ -51,12 +56,17 @@ namespace Engine
 		static uint32_t s_indexCapacity; //!< The limit of the number indices in the index buffer
 
 		static std::vector<BatchEntry3D> s_batchQueue; //!< The list of submitted geometry in a queue
+		static std::vector<BatchEntry3D> s_drawQueue; //!< The submissions of the shader being drawn, kept so its memory is reused every flush
 		static std::map<VertexBuffer*, std::vector<DrawElementsIndirectCommand>> s_batchCommandsQueue; //!< The list of batch commands
 		static std::map<VertexBuffer*, uint32_t> s_nextVertex; //!< The next vertex (index) in the vertex buffer where we can add new vertices
 		static uint32_t s_nextIndex; //!< The next index (index) in the index buffer where we can add new indices
 		static IndirectBuffer* s_indirectBuffer; //!< The indirect buffer containing all batch commands
+		static std::map<VertexBuffer*, std::vector<AABB>> s_localBounds; //!< The local bounds of each piece of model geometry by ID, terrain geometry has none as it is displaced when drawn
+		static bool s_cullPlaneEnabled; //!< Are submissions being tested against a clip plane
+		static glm::vec4 s_cullPlane; //!< The clip plane, anything below it is clipped by the shaders
 
 		static bool submissionChecks(Material* material, Geometry3D& geom); //!< Check the submission
+		static BatchEntry3D* queueSubmission(const std::string& submissionName, Geometry3D& geometry, Material* material, const MaterialParameters& parameters); //!< Add a submission to the queue
 		static void sortSubmissions(std::vector<BatchEntry3D>& submissions); //!< Sort the submissions
 
 		static bool drawCheck(ShaderProgram* program, std::unordered_map<std::string, UniformBuffer*>& buffers, VertexArray* vArray, IndirectBuffer* indirectBuffer);
@@ -67,11 +77,21 @@ namespace Engine
 		static void initialise(const uint32_t batchCapacity, const uint32_t vertexCapacity, const uint32_t indexCapacity); //!< Initialise the renderer
 		static void begin(); //!< Begin a new 3D scene
 		static void submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::mat4& modelMatrix); //!< Submit a piece of geometry to render
+		static void submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::mat4& modelMatrix, const MaterialParameters& parameters); //!< Submit a piece of geometry to render with its own parameters
+		static void submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::vec3& position, const glm::vec3& orientation, const glm::vec3& scale, const MaterialParameters& parameters); //!< Submit a piece of geometry whose model matrix is composed with the rest of the batch
 		static void end(); //!< End the current 3D scene
 		static void destroy(); //!< Destroy all internal data
 		static void setTextureUnitManager(TextureUnitManager*& unitManager, const std::array<int32_t, 16>& unit); //!< Set the texture unit manager and units to use
 
-		static void addGeometry(std::vector<Vertex3D>& vertices, std::vector<uint32_t> indices, Geometry3D& geometry); //!< Add a piece of 3D geometry to the renderer's vertex buffer
+		static void setCullPlane(const glm::vec4& plane); //!< Set the clip plane submissions are tested against
+		static void clearCullPlane(); //!< Stop testing submissions against a clip plane
+		static inline const bool hasCullPlane() { return s_cullPlaneEnabled; } //!< Are submissions being tested against a clip plane
+			/*!< \return a const bool - Are submissions being tested against a clip plane */
+		static const bool isClipped(const AABB& worldBounds); //!< Is a box completely below the clip plane
+		static const bool isClipped(const Geometry3D& geometry, const glm::mat4& modelMatrix); //!< Is a piece of model geometry completely below the clip plane
+
+		static void addGeometry(const std::vector<Vertex3D>& vertices, const std::vector<uint32_t>& indices, Geometry3D& geometry); //!< Add a piece of 3D geometry to the renderer's vertex buffer
+		static void addGeometry(const Vertex3D* vertices, const uint32_t vertexCount, const uint32_t* indices, const uint32_t indexCount, Geometry3D& geometry); //!< Add a piece of 3D geometry to the renderer's vertex buffer
 		static void addGeometry(std::vector<TerrainVertex>& vertices, std::vector<uint32_t> indices, Geometry3D& geometry); //!< Add a piece of 3D geometry to the renderer's vertex buffer
 	};
 }
@@ -13,10 +13,9 @@
 
 namespace Engine
 {
-	void generateVertexList(std::vector<BatchEntry2D>& batchEntries); //!< Generate vertex list
-	void generateListOfVertex2D(std::vector<BatchEntry2D>& batchEntries); //!< Generate a list of vertices and edit the VBO
-	void generateListOfVertex2DMutlitextured(std::vector<BatchEntry2D>& batchEntries); //!< Generate a list of vertices and edit the VBO
+	const uint32_t generateQuadInstances(std::vector<BatchEntry2D>& batchEntries); //!< Generate one instance per quad and edit the VBO
 
+	void fillModelMatrices(std::vector<BatchEntry3D>& batchEntries, ArenaVector<glm::mat4>& matrices, ScratchArena& scratch); //!< Fill the model matrices, composing the ones given as transforms in one batch
 	void generateInstanceData(std::vector<BatchEntry3D>& batchEntries); //!< Generate the instance data
 	void generateBasic3D(std::vector<BatchEntry3D>& batchEntries); //!< Generate the instance data
 	void generateSkybox(std::vector<BatchEntry3D>& batchEntries); //!< Generate the instance data
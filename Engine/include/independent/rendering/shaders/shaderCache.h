@@ -0,0 +1,53 @@
+/*! \file shaderCache.h
+*
+* \brief A disk cache of linked program binaries keyed by the hash of their preprocessed sources
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	namespace ShaderCacheFormat
+	{
+		const uint32_t Magic = 0x42505347; //!< The first four bytes of every cached binary, 'GSPB'
+		const uint32_t Version = 1; //!< Increase whenever the header changes
+	}
+
+	/*! \struct ShaderCacheHeader
+	* \brief The start of every cached binary, followed by the binary itself
+	*/
+	struct ShaderCacheHeader
+	{
+		uint32_t magic = ShaderCacheFormat::Magic; //!< Identifies the file as a cached binary
+		uint32_t version = ShaderCacheFormat::Version; //!< The format version
+		uint64_t key = 0; //!< The key the binary was stored under, guards against a renamed file
+		uint32_t format = 0; //!< The graphics API's format of the binary
+		uint32_t size = 0; //!< The size of the binary in bytes
+	};
+
+	/*! \class ShaderCache
+	* \brief Stores program binaries so a warm start can skip compiling and linking. A key covers every preprocessed stage,
+	* the permutation and the driver, so any change to them simply misses the cache
+	*/
+	class ShaderCache
+	{
+	private:
+		static bool s_initialised; //!< Has the config been read
+		static bool s_enabled; //!< Is the cache used
+		static std::string s_directory; //!< The directory the binaries are kept in
+
+		static void initialise(); //!< Read the cache settings from the config
+		static std::string getFilePath(const uint64_t key); //!< Get the file a key is stored in
+	public:
+		static const bool isEnabled(); //!< Is the cache used
+		static const bool load(const uint64_t key, uint32_t& format, std::vector<uint8_t>& binary); //!< Load a binary
+		static const bool save(const uint64_t key, const uint32_t format, const std::vector<uint8_t>& binary); //!< Save a binary
+		static void remove(const uint64_t key); //!< Remove a binary the driver would not accept
+	};
+}
+#endif
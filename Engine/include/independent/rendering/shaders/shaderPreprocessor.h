@@ -0,0 +1,35 @@
+/*! \file shaderPreprocessor.h
+*
+* \brief Expands #include directives and inserts permutation defines into shader source before it is compiled
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef SHADERPREPROCESSOR_H
+#define SHADERPREPROCESSOR_H
+
+#include <functional>
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	using ShaderDefines = std::vector<std::pair<std::string, std::string>>; //!< Defines by name and value, kept in order so the same permutation always hashes the same
+	using ShaderFileReader = std::function<std::string(const std::string&)>; //!< Reads the contents of a shader file, an empty string if it cannot be read
+
+	/*! \class ShaderPreprocessor
+	* \brief Handles #include "file" relative to the including file, each file is only included once per stage.
+	* The defines are inserted after the #version line. The reader can be swapped so sources can be processed without a GL context or the disk
+	*/
+	class ShaderPreprocessor
+	{
+	public:
+		static const bool process(const std::string& filePath, const ShaderDefines& defines, std::string& output, const ShaderFileReader& reader = ShaderFileReader()); //!< Preprocess a shader file
+		static const bool processSource(const std::string& filePath, const std::string& source, const ShaderDefines& defines, std::string& output, const ShaderFileReader& reader); //!< Preprocess source already read from a file
+
+		static ShaderDefines getDefines(); //!< Get the defines of the permutation selected by the config
+		static std::string getPermutationKey(const ShaderDefines& defines); //!< Get a readable key of a permutation
+		static const uint64_t hash(const std::string& data, const uint64_t seed = 14695981039346656037ull); //!< Hash data, the same on every run and platform
+		static std::string resolvePath(const std::string& includingFile, const std::string& includePath); //!< Get the path of an included file
+	};
+}
+#endif
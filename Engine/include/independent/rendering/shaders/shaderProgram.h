@@ -12,6 +12,7 @@
 #include "independent/systems/components/resource.h"
 #include "independent/rendering/geometry/vertexArray.h"
 #include "independent/rendering/uniformBuffer.h"
+#include "independent/rendering/shaders/shaderReflection.h"
 
 namespace Engine
 {
@@ -28,7 +29,7 @@ namespace Engine
 		std::string m_geometryPath; //!< The file path of the geometry shader
 		std::string m_tessellationControlPath; //!< The file path of the tessellation control shader
 		std::string m_tessellationEvalPath; //!< The file path of the tessellation evaluation shader
-		std::map<std::string, int> m_uniforms; //!< All the uniforms for the shader program
+		ShaderReflection m_reflection; //!< The active uniforms and uniform blocks, read when the program is linked
 		VertexArray* m_vertexArray; //!< The vertex data format which complies with the data format in the shader
 		std::unordered_map<std::string, UniformBuffer*> m_uniformBuffers; //!< The uniform buffers used by this shader program
 	public:
@@ -45,10 +46,7 @@ namespace Engine
 				 \param tessControlPath a const std::string& - The tessellation control shader file path
 				 \param tessEvalPath a const std::string& - The tessellation evaluation shader file path */
 
-		virtual void setUniforms(const std::vector<std::string>& uniformNames) = 0; //!< Set all uniform locations
-			/*!< \param uniformNames a const std::vector<std::string>& - All uniform names */
-
-		virtual void setUniformBuffers(const std::unordered_map<std::string, UniformBuffer*>& uniformBuffers) = 0; //!< Set the uniform buffers used by this shader
+		virtual void setUniformBuffers(const std::unordered_map<std::string, UniformBuffer*>& uniformBuffers) = 0; //!< Set the uniform buffers used by this shader and bind their blocks
 			/*!< \param uniformBuffers a const std::unordered_map<std::string, UniformBuffer*>& - All uniform buffers associated by the block name */
 
 		virtual void start() = 0; //!< Start the shader
@@ -60,8 +58,11 @@ namespace Engine
 			/*!< \return a const uint32_t - The program ID */
 		inline VertexArray* getVertexArray() const { return m_vertexArray; } //!< Get the vertex array associated with this shader
 			/*!< \return a VertexArray* - The vertex array associated with this shader */
-		inline std::map<std::string, int>& getUniforms() { return m_uniforms; } //!< Get the uniforms
-			/*!< \return a std::map<std::string, int>& - The uniforms */
+		inline const ShaderReflection& getReflection() const { return m_reflection; } //!< Get the active uniforms and uniform blocks
+			/*!< \return a const ShaderReflection& - The reflection */
+		inline const int32_t getUniformHandle(const std::string& uniformName) const { return m_reflection.getHandle(uniformName); } //!< Get the handle of a uniform, look it up once and send with it every frame
+			/*!< \param uniformName a const std::string& - The uniform name
+				 \return a const int32_t - The handle, -1 if the uniform is not active */
 		inline std::unordered_map<std::string, UniformBuffer*>& getUniformBuffers() { return m_uniformBuffers; } //!< Get the uniform buffers
 			/*!< \return a std::unordered_map<std::string, UniformBuffer*>& - The uniform buffers */
 		inline void setOrderImportance(const uint32_t value) { m_order = value; }; //!< Set the shader's order priority
@@ -69,34 +70,63 @@ namespace Engine
 		inline const uint32_t getOrderImportance() const { return m_order; } //!< Get the shader's order priority
 			/*!< \return a const uint32_t - The shader's order priority */
 
-		virtual void sendInt(const std::string& uniformName, const int value) = 0; //!< Upload integer to shader
+		void sendInt(const std::string& uniformName, const int value); //!< Upload integer to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const int - The uniform value */
-		virtual void sendIntArray(const std::string& uniformName, int32_t* values, const uint32_t count) = 0; //!< Upload an array of integers to shader
+		void sendIntArray(const std::string& uniformName, int32_t* values, const uint32_t count); //!< Upload an array of integers to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param values a int32_t* - The uniform values
 				 \param count a const uint32_t - The number of elements */
-		virtual void sendBool(const std::string& uniformName, const bool value) = 0; //!< Upload bool to shader
+		void sendBool(const std::string& uniformName, const bool value); //!< Upload bool to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const bool - The uniform value */
-		virtual void sendFloat(const std::string& uniformName, const float value) = 0; //!< Upload float to shader
+		void sendFloat(const std::string& uniformName, const float value); //!< Upload float to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const float - The uniform value */
-		virtual void sendVec2(const std::string& uniformName, const glm::vec2& value) = 0; //!< Upload vec2 to shader
+		void sendVec2(const std::string& uniformName, const glm::vec2& value); //!< Upload vec2 to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const glm::vec2& - The uniform value */
-		virtual void sendVec3(const std::string& uniformName, const glm::vec3& value) = 0; //!< Upload vec3 to shader
+		void sendVec3(const std::string& uniformName, const glm::vec3& value); //!< Upload vec3 to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const glm::vec3& - The uniform value */
-		virtual void sendVec4(const std::string& uniformName, const glm::vec4& value) = 0; //!< Upload vec4 to shader
+		void sendVec4(const std::string& uniformName, const glm::vec4& value); //!< Upload vec4 to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param value a const glm::vec4& - The uniform value */
-		virtual void sendMat3(const std::string& uniformName, const glm::mat3& mat) = 0; //!< Upload mat3 to shader
+		void sendMat3(const std::string& uniformName, const glm::mat3& mat); //!< Upload mat3 to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param mat a const glm::mat3& - The uniform value */
-		virtual void sendMat4(const std::string& uniformName, const glm::mat4& mat) = 0; //!< Upload mat4 to shader
+		void sendMat4(const std::string& uniformName, const glm::mat4& mat); //!< Upload mat4 to shader by name
 			/*!< \param uniformName a const std::string& - The uniform name
 				 \param mat a const glm::mat4& - The uniform value */
+
+		virtual void sendInt(const int32_t handle, const int value) = 0; //!< Upload integer to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const int - The uniform value */
+		virtual void sendIntArray(const int32_t handle, int32_t* values, const uint32_t count) = 0; //!< Upload an array of integers to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param values a int32_t* - The uniform values
+				 \param count a const uint32_t - The number of elements */
+		virtual void sendBool(const int32_t handle, const bool value) = 0; //!< Upload bool to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const bool - The uniform value */
+		virtual void sendFloat(const int32_t handle, const float value) = 0; //!< Upload float to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const float - The uniform value */
+		virtual void sendVec2(const int32_t handle, const glm::vec2& value) = 0; //!< Upload vec2 to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const glm::vec2& - The uniform value */
+		virtual void sendVec3(const int32_t handle, const glm::vec3& value) = 0; //!< Upload vec3 to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const glm::vec3& - The uniform value */
+		virtual void sendVec4(const int32_t handle, const glm::vec4& value) = 0; //!< Upload vec4 to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param value a const glm::vec4& - The uniform value */
+		virtual void sendMat3(const int32_t handle, const glm::mat3& mat) = 0; //!< Upload mat3 to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param mat a const glm::mat3& - The uniform value */
+		virtual void sendMat4(const int32_t handle, const glm::mat4& mat) = 0; //!< Upload mat4 to shader
+			/*!< \param handle a const int32_t - The uniform handle
+				 \param mat a const glm::mat4& - The uniform value */
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*! \file shaderReflection.h
+*
+* \brief The active uniforms, samplers and uniform blocks of a linked shader program, read once at link time
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef SHADERREFLECTION_H
+#define SHADERREFLECTION_H
+
+#include <json.hpp>
+#include "independent/core/common.h"
+#include "independent/rendering/shaders/shaderDataType.h"
+
+namespace Engine
+{
+	/*! \struct ShaderUniform
+	* \brief An active uniform outside of a uniform block
+	*/
+	struct ShaderUniform
+	{
+		std::string Name; //!< The name, without any array suffix
+		ShaderDataType Type = ShaderDataType::None; //!< The data type, samplers are Int
+		int32_t Location = -1; //!< The location, used as the handle when sending the uniform
+		uint32_t Count = 1; //!< The number of array elements
+		bool Sampler = false; //!< Is the uniform a sampler, its elements are given texture units 0 to Count - 1 when linked
+	};
+
+	/*! \struct ShaderBlock
+	* \brief An active uniform block
+	*/
+	struct ShaderBlock
+	{
+		std::string Name; //!< The block name
+		uint32_t Index = 0; //!< The block index in the program
+		int32_t Binding = -1; //!< The binding point of the uniform buffer providing the data, -1 until one is attached
+		uint32_t Size = 0; //!< The size of the block in bytes
+	};
+
+	/*! \class ShaderReflection
+	* \brief Everything a shader program exposes, so nothing has to be queried by name while rendering
+	*/
+	class ShaderReflection
+	{
+	private:
+		std::vector<ShaderUniform> m_uniforms; //!< The active uniforms
+		std::vector<ShaderBlock> m_blocks; //!< The active uniform blocks
+	public:
+		void clear(); //!< Clear the reflection
+		void addUniform(const ShaderUniform& uniform); //!< Add an active uniform
+		void addBlock(const ShaderBlock& block); //!< Add an active uniform block
+
+		const ShaderUniform* getUniform(const std::string& name) const; //!< Get a uniform by name
+		ShaderBlock* getBlock(const std::string& name); //!< Get a uniform block by name
+		const int32_t getHandle(const std::string& name) const; //!< Get the handle of a uniform, -1 if it is not active
+
+		inline const std::vector<ShaderUniform>& getUniforms() const { return m_uniforms; } //!< Get the active uniforms
+			/*!< \return a const std::vector<ShaderUniform>& - The active uniforms */
+		inline const std::vector<ShaderBlock>& getBlocks() const { return m_blocks; } //!< Get the active uniform blocks
+			/*!< \return a const std::vector<ShaderBlock>& - The active uniform blocks */
+
+		nlohmann::json toJSON() const; //!< Write the reflection to a JSON object
+		static ShaderReflection fromJSON(const nlohmann::json& data); //!< Read a reflection from a JSON object
+		const bool validate(const nlohmann::json& program, const std::string& programName) const; //!< Check a program's entry in shaders.json against the reflection
+	};
+}
+#endif
@@ -0,0 +1,25 @@
+/*! \file distanceField.h
+*
+* \brief Turns a coverage bitmap into a signed distance field, so one rasterised size can be drawn sharply at any size
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \class DistanceField
+	* \brief Builds signed distance fields with an exact Euclidean distance transform. The edge is stored as 0.5,
+	* inside is above it and the field reaches 0 and 1 a spread away from the edge
+	*/
+	class DistanceField
+	{
+	public:
+		static void generate(const unsigned char* coverage, const uint32_t width, const uint32_t height, const uint32_t spread, unsigned char* output); //!< Generate a distance field from coverage
+	};
+}
+#endif
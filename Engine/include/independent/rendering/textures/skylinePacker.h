@@ -0,0 +1,50 @@
+/*! \file skylinePacker.h
+*
+* \brief Packs rectangles into a fixed area by keeping the outline of the tops of everything placed so far
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef SKYLINEPACKER_H
+#define SKYLINEPACKER_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \class SkylinePacker
+	* \brief Places each rectangle at the lowest point on the skyline it fits, ties going to the narrowest segment.
+	* Only the skyline is stored, so a placement never sorts or splits a list of free spaces
+	*/
+	class SkylinePacker
+	{
+	private:
+		/*! \struct Segment
+		* \brief A horizontal piece of the skyline
+		*/
+		struct Segment
+		{
+			int32_t x; //!< The left of the segment
+			int32_t y; //!< The height of the skyline along the segment
+			int32_t width; //!< The width of the segment
+		};
+
+		glm::ivec2 m_size; //!< The size of the area being packed
+		std::vector<Segment> m_skyline; //!< The skyline from left to right
+		int32_t m_usedHeight; //!< The highest point of any rectangle placed
+
+		const int32_t fit(const size_t index, const int32_t width, const int32_t height) const; //!< Get the height a rectangle would sit at if placed at a segment
+		void place(const size_t index, const int32_t x, const int32_t y, const int32_t width, const int32_t height); //!< Raise the skyline under a placed rectangle
+	public:
+		SkylinePacker(const glm::ivec2& size = { 0, 0 }, const uint32_t reservedSegments = 32); //!< Constructor
+
+		void reset(const glm::ivec2& size); //!< Remove every rectangle and start again with a new size
+		const bool pack(const int32_t width, const int32_t height, glm::ivec2& position); //!< Find a place for a rectangle
+
+		inline const glm::ivec2& getSize() const { return m_size; } //!< Get the size of the area being packed
+			/*!< \return a const glm::ivec2& - The size */
+		inline const int32_t getUsedHeight() const { return m_usedHeight; } //!< Get the highest point of any rectangle placed
+			/*!< \return a const int32_t - The used height */
+	};
+}
+#endif
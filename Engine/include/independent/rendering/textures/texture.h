@@ -13,6 +13,8 @@
 
 namespace Engine
 {
+	struct TextureImage;
+
 	/*! \enum TextureParameter
 	* \brief The parameters associated with textures
 	*/
@@ -144,6 +146,7 @@ namespace Engine
 	public:
 		static Texture2D* create(const std::string& textureName, const TextureProperties& properties, const uint32_t channels, unsigned char* data); //!< Create a texture providing the pixel data
 		static Texture2D* create(const std::string& textureName, const char* filePath, TextureProperties properties = TextureProperties()); //!< Create a texture from file
+		static Texture2D* create(const std::string& textureName, TextureProperties properties, const TextureImage& image); //!< Create a texture from every mip level of an image
 
 		Texture2D(const std::string& textureName, const TextureProperties& properties = TextureProperties()); //!< Constructor
 		virtual ~Texture2D(); //!< Destructor
@@ -174,6 +177,7 @@ namespace Engine
 		std::string m_folderPath; //!< The folder path containing the textures
 	public:
 		static CubeMapTexture* create(const std::string& textureName, const std::string& folderPath, const std::string& fileType); //!< Create a cubemap texture from file
+		static CubeMapTexture* create(const std::string& textureName, const std::string& folderPath, const std::vector<TextureImage>& faces); //!< Create a cubemap texture from six loaded faces
 
 		CubeMapTexture(const std::string& textureName); //!< Constructor
 		virtual ~CubeMapTexture(); //!< Destructor
@@ -0,0 +1,61 @@
+/*! \file textureAtlasBuilder.h
+*
+* \brief Packs the small 2D textures marked for atlasing into a few atlas pages when the resources are loaded
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef TEXTUREATLASBUILDER_H
+#define TEXTUREATLASBUILDER_H
+
+#include "independent/rendering/textures/texture.h"
+#include "independent/rendering/textures/textureCooker.h"
+
+namespace Engine
+{
+	/*! \struct AtlasRegion
+	* \brief Where a texture was placed in the atlas pages
+	*/
+	struct AtlasRegion
+	{
+		Texture2D* Page; //!< The page the texture is in
+		glm::vec2 UVStart; //!< The UV of the texture's first pixel in the page
+		glm::vec2 UVEnd; //!< The UV of the end of the texture's last pixel in the page
+	};
+
+	/*! \class TextureAtlasBuilder
+	* \brief Textures in textures.json with "atlas" set are not created on their own, their pixels are kept until every texture
+	* file has been loaded and are then packed into as few pages as possible. Subtextures of an atlased texture are moved into its
+	* page region when they are loaded, so the rest of the engine never sees the difference and 2D draws share texture units
+	*/
+	class TextureAtlasBuilder
+	{
+	private:
+		/*! \struct PendingTexture
+		* \brief A loaded texture which is waiting to be packed
+		*/
+		struct PendingTexture
+		{
+			std::string Name; //!< The name of the texture
+			glm::ivec2 Size; //!< The size of the texture
+			std::vector<unsigned char> Pixels; //!< The RGBA pixels
+		};
+
+		static bool s_initialised; //!< Has the config been read
+		static bool s_enabled; //!< Are textures atlased
+		static uint32_t s_maxTextureSize; //!< The largest width or height of a texture which is atlased
+		static uint32_t s_pageSize; //!< The width and height of a full page
+		static std::vector<PendingTexture> s_pending; //!< The textures waiting to be packed
+		static std::unordered_map<std::string, AtlasRegion> s_regions; //!< The region of every atlased texture
+
+		static void initialise(); //!< Read the atlas settings from the config
+		static const uint32_t createPage(std::vector<PendingTexture*>& textures, const uint32_t pageIndex); //!< Pack as many textures as fit into a new page
+	public:
+		static const bool accepts(const std::string& textureName, const glm::ivec2& size, const TextureProperties& properties); //!< Can a texture be packed
+		static void add(const std::string& textureName, TextureImage& image); //!< Keep a loaded texture to be packed later
+		static void build(); //!< Pack every waiting texture into pages
+		static const bool getRegion(const std::string& textureName, AtlasRegion& region); //!< Get where a texture was packed
+		static void clear(); //!< Forget every region, the resource manager deletes the pages
+	};
+}
+#endif
@@ -0,0 +1,137 @@
+/*! \file textureCooker.h
+*
+* \brief Decodes texture images off the main thread and cooks them into a container of ready to upload mip levels
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	namespace CookedTextureFormat
+	{
+		const uint32_t Magic = 0x58455443; //!< The first four bytes of every cooked texture, 'CTEX'
+		const uint32_t Version = 2; //!< Increase whenever the layout or the cooking changes
+	}
+
+	/*! \enum TextureImageFormat
+	* \brief The layout of the pixels of every mip level in a texture image
+	*/
+	enum class TextureImageFormat : uint32_t
+	{
+		R8 = 0, //!< One byte per pixel
+		RGB8 = 1, //!< Three bytes per pixel
+		RGBA8 = 2, //!< Four bytes per pixel
+		BC1 = 3, //!< 8 byte blocks of 4x4 RGB pixels
+		BC3 = 4 //!< 16 byte blocks of 4x4 RGBA pixels
+	};
+
+	/*! \struct TextureMipLevel
+	* \brief Where a mip level is in a texture image's data
+	*/
+	struct TextureMipLevel
+	{
+		uint32_t Width; //!< The width in pixels
+		uint32_t Height; //!< The height in pixels
+		uint64_t Offset; //!< The offset of the level from the start of the data
+		uint64_t Size; //!< The size of the level in bytes
+	};
+
+	/*! \struct TextureImage
+	* \brief Every mip level of a texture in one block of memory, as it is uploaded
+	*/
+	struct TextureImage
+	{
+		TextureImageFormat Format = TextureImageFormat::RGBA8; //!< The format of every level
+		std::vector<TextureMipLevel> Mips; //!< The levels, the first is the full size image
+		std::vector<uint8_t> Data; //!< The pixels or blocks of every level
+
+		inline const uint32_t getWidth() const { return Mips.empty() ? 0 : Mips[0].Width; } //!< Get the width of the first level
+			/*!< \return a const uint32_t - The width */
+		inline const uint32_t getHeight() const { return Mips.empty() ? 0 : Mips[0].Height; } //!< Get the height of the first level
+			/*!< \return a const uint32_t - The height */
+		inline const uint8_t* getMipData(const uint32_t mip) const { return Data.data() + Mips[mip].Offset; } //!< Get the data of a level
+			/*!< \param mip a const uint32_t - The level
+				 \return a const uint8_t* - The first byte of the level */
+		inline const bool isCompressed() const { return Format == TextureImageFormat::BC1 || Format == TextureImageFormat::BC3; } //!< Is the data in blocks
+			/*!< \return a const bool - Is the image block compressed */
+		const uint32_t getChannels() const; //!< Get the number of channels of the pixels
+	};
+
+	/*! \struct TextureCookSettings
+	* \brief How a source image is turned into a texture image, a cooked file is only used with the settings it was cooked with
+	*/
+	struct TextureCookSettings
+	{
+		bool FlipUVs = false; //!< Flip the image vertically
+		bool GenerateMips = true; //!< Generate the full mip chain
+		bool Compress = false; //!< Compress RGB to BC1 and RGBA to BC3
+		bool ForceRGBA = false; //!< Expand every source to four channels
+	};
+
+	/*! \struct CookedTextureHeader
+	* \brief The start of every cooked texture, followed by the mip level table and then the data
+	*/
+	struct CookedTextureHeader
+	{
+		uint32_t magic = CookedTextureFormat::Magic; //!< Identifies the file as a cooked texture
+		uint32_t version = CookedTextureFormat::Version; //!< The format version
+		uint64_t sourceSize = 0; //!< The size of the source image the texture was cooked from
+		int64_t sourceTime = 0; //!< The write time of the source image
+		uint32_t format = 0; //!< The TextureImageFormat of the levels
+		uint32_t mipCount = 0; //!< The number of levels
+		uint64_t dataSize = 0; //!< The size of the data after the level table
+	};
+
+	/*! \struct TextureLoadJob
+	* \brief A texture image to be loaded by the workers
+	*/
+	struct TextureLoadJob
+	{
+		std::string FilePath; //!< The source image
+		TextureCookSettings Settings; //!< How to cook the source
+		TextureImage Image; //!< The loaded image
+		bool Loaded = false; //!< Was the image loaded
+	};
+
+	/*! \class TextureCooker
+	* \brief Loads texture images on worker threads. A source image is decoded, its mips are built and it is optionally block
+	* compressed, then it is written to the cooked texture directory so later starts only read the levels back. Nothing here
+	* touches the graphics API, so cooking and verifying can run without a window
+	*/
+	class TextureCooker
+	{
+	private:
+		static bool s_initialised; //!< Has the config been read
+		static bool s_enabled; //!< Are cooked textures read and written
+		static bool s_compress; //!< Are textures compressed unless they opt out
+		static bool s_verify; //!< Is every newly cooked texture checked against its source
+		static std::string s_directory; //!< The directory the cooked textures are kept in
+
+		static void initialise(); //!< Read the cook settings from the config
+		static std::string getCookedPath(const std::string& sourcePath, const TextureCookSettings& settings); //!< Get the cooked file of a source and settings
+	public:
+		static const bool isEnabled(); //!< Are cooked textures used
+		static const bool shouldCompress(); //!< Are textures compressed by default
+
+		static const bool getSize(const std::string& filePath, glm::ivec2& size); //!< Read the size of a source image without decoding it
+		static const bool decode(const std::string& filePath, const TextureCookSettings& settings, TextureImage& image); //!< Decode a source image into its first level
+		static void generateMips(TextureImage& image); //!< Build every level below the first
+		static const bool compress(TextureImage& image); //!< Compress every level into blocks
+		static const bool decompress(const TextureImage& image, const uint32_t mip, std::vector<uint8_t>& pixels); //!< Expand a compressed level into pixels
+
+		static const bool read(const std::string& cookedPath, TextureImage& image, const uint64_t sourceSize = 0, const int64_t sourceTime = 0); //!< Read a cooked texture
+		static const bool write(const std::string& cookedPath, const TextureImage& image, const uint64_t sourceSize = 0, const int64_t sourceTime = 0); //!< Write a cooked texture
+
+		static const bool cook(const std::string& sourcePath, const std::string& cookedPath, const TextureCookSettings& settings); //!< Cook a source image to a file
+		static const bool verify(const std::string& sourcePath, const std::string& cookedPath, const TextureCookSettings& settings, const float maxError = 8.f); //!< Check a cooked texture against its source
+
+		static const bool load(const std::string& filePath, const TextureCookSettings& settings, TextureImage& image); //!< Load a texture image, from its cooked file when it is up to date
+		static void loadAll(std::vector<TextureLoadJob>& jobs); //!< Load every job's image across the worker threads
+	};
+}
+#endif
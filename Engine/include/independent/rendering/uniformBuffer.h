@@ -36,6 +36,8 @@ namespace Engine
 			/*!< \return a const uint32_t - The uniform buffer ID */
 		inline UniformBufferLayout& getUniformLayout() { return m_layout; } //!< Get the uniform buffer layout
 			/*!< \return a UniformBufferLayout& - The uniform buffer layout */
+		inline const uint32_t getBlockNumber() const { return m_blockNumber; } //!< Get the binding point the buffer is bound to
+			/*!< \return a const uint32_t - The binding point */
 
 		virtual void attachShaderBlock(ShaderProgram* shader, const char* blockName) = 0; //!< Attach the shader block
 			/*!< \param shader a ShaderProgram* - A pointer to the shader program
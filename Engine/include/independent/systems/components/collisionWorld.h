@@ -0,0 +1,117 @@
+/*! \file collisionWorld.h
+*
+* \brief The colliders of a scene, capsules moved by characters are pushed out of static shapes, each other and the terrain at a fixed rate
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef COLLISIONWORLD_H
+#define COLLISIONWORLD_H
+
+#include <functional>
+#include "independent/core/common.h"
+#include "independent/utils/batchTransforms.h"
+
+namespace Engine
+{
+	class Transform; //!< Forward declare transform
+
+	using ColliderID = uint32_t; //!< Identifies a static collider in its world
+	using BodyID = uint32_t; //!< Identifies a capsule body in its world
+	const ColliderID InvalidCollider = 0xFFFFFFFF; //!< An ID which refers to no collider
+	const BodyID InvalidBody = 0xFFFFFFFF; //!< An ID which refers to no body
+
+	/*! \enum ColliderShape
+	* \brief The shapes a static collider can have
+	*/
+	enum class ColliderShape
+	{
+		Box, Sphere
+	};
+
+	/*! \struct StaticCollider
+	* \brief A shape which never moves, only added and removed
+	*/
+	struct StaticCollider
+	{
+		ColliderShape Shape; //!< The shape
+		AABB Bounds; //!< The box, or the box around the sphere
+		glm::vec3 Centre; //!< The centre of the sphere
+		float Radius; //!< The radius of the sphere
+		bool Active; //!< Is this slot in use
+	};
+
+	/*! \struct CapsuleBody
+	* \brief An upright capsule moved by a character, its position is the bottom of the capsule
+	*/
+	struct CapsuleBody
+	{
+		glm::vec3 Position; //!< The bottom of the capsule
+		glm::vec3 Displacement; //!< Movement asked for since the last fixed step
+		float Radius; //!< The radius
+		float Height; //!< The height from bottom to top, at least twice the radius
+		bool FollowGround; //!< Is the body kept on the terrain instead of only above it
+		bool Active; //!< Is this slot in use
+		Transform* Owner; //!< The transform the position is written back to, can be null
+	};
+
+	/*! \class CollisionWorld
+	* \brief Static colliders are kept in a uniform grid over x and z so a query only visits nearby cells, however many there are.
+	* Bodies are sorted and swept along x to find the ones touching, touching bodies form islands which are solved independently
+	*/
+	class CollisionWorld
+	{
+	private:
+		static const uint32_t MaxStepsPerFrame = 4; //!< Steps past this are dropped so a slow frame cannot make the next one slower
+		static const uint32_t SolverIterations = 4; //!< The number of times each island is pushed apart per step
+		static const uint32_t ParallelBodyCount = 64; //!< The number of bodies before islands are solved on more than one thread
+
+		float m_fixedTimestep; //!< The time between steps in seconds
+		float m_accumulator; //!< Time not yet stepped
+		float m_cellSize; //!< The width of a grid cell
+
+		std::vector<StaticCollider> m_statics; //!< Every static collider slot
+		std::vector<ColliderID> m_freeStatics; //!< Static slots which can be reused
+		std::unordered_map<uint64_t, std::vector<ColliderID>> m_grid; //!< The static colliders overlapping each cell
+
+		std::vector<CapsuleBody> m_bodies; //!< Every body slot
+		std::vector<BodyID> m_freeBodies; //!< Body slots which can be reused
+		std::vector<std::vector<BodyID>> m_islands; //!< The bodies of each island, kept between steps to reuse their memory
+		uint32_t m_islandCount; //!< The number of islands found in the last step
+
+		std::function<float(float, float)> m_heightfield; //!< Gives the height of the terrain at an x and z
+
+		uint64_t getCellKey(const int32_t x, const int32_t z) const; //!< Get the key of a grid cell
+		void insertIntoGrid(const ColliderID id); //!< Add a static collider to every cell it overlaps
+		void removeFromGrid(const ColliderID id); //!< Remove a static collider from every cell it overlaps
+
+		template<typename Vector> void gatherStatics(const AABB& bounds, Vector& ids) const; //!< Collect the static colliders in the cells a box overlaps
+		void step(const float fraction); //!< Move every body and resolve its collisions
+		void buildIslands(); //!< Group bodies which could touch
+		void solveIsland(const std::vector<BodyID>& island); //!< Push the bodies of an island out of everything they overlap
+		void resolveStatics(CapsuleBody& body); //!< Push a body out of the static colliders
+		void resolveTerrain(CapsuleBody& body); //!< Keep a body on or above the terrain
+	public:
+		CollisionWorld(const float fixedTimestep = 1.f / 60.f, const float cellSize = 16.f); //!< Constructor
+		~CollisionWorld(); //!< Destructor
+
+		void onUpdate(const float timestep); //!< Run as many fixed steps as the time since the last frame needs
+
+		ColliderID addBox(const AABB& bounds); //!< Add a static box
+		ColliderID addSphere(const glm::vec3& centre, const float radius); //!< Add a static sphere
+		void addBoxes(const AABB* bounds, const uint32_t count, ColliderID* ids); //!< Add many static boxes at once
+		void removeCollider(const ColliderID id); //!< Remove a static collider
+		void queryStatics(const AABB& bounds, std::vector<ColliderID>& ids) const; //!< Get the static colliders whose boxes overlap a box
+		const uint32_t getStaticCount() const; //!< Get the number of static colliders
+
+		BodyID addCapsule(const glm::vec3& position, const float radius, const float height, const bool followGround, Transform* owner = nullptr); //!< Add a capsule body
+		void removeBody(const BodyID id); //!< Remove a capsule body
+		void moveBody(const BodyID id, const glm::vec3& displacement); //!< Ask for a body to move, the move happens over the next steps
+		void setBodyPosition(const BodyID id, const glm::vec3& position); //!< Place a body without resolving collisions
+		glm::vec3 getBodyPosition(const BodyID id) const; //!< Get the position of a body
+
+		void setHeightfield(const std::function<float(float, float)>& heightfield); //!< Set the function which gives the terrain height
+		const bool hasHeightfield() const; //!< Does the world have a terrain
+	};
+}
+#endif
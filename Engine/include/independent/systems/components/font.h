@@ -8,10 +8,10 @@
 #ifndef FONT_H
 #define FONT_H
 
-#include "ft2build.h"
-#include "freetype/freetype.h"
+#include <unordered_map>
 #include "independent/core/common.h"
-#include "independent/rendering/textures/textureAtlas.h"
+#include "independent/rendering/textures/subTexture.h"
+#include "independent/systems/components/fontBaker.h"
 
 namespace Engine
 {
@@ -28,33 +28,36 @@ namespace Engine
 	};
 
 	/*! \class Font
-	* \brief A class which stores all the data about a font
+	* \brief A class which stores all the data about a font, its glyphs live in the font atlas shared by every font
 	*/
 	class Font
 	{
 	private:
 		std::string m_fontName; //!< The name of the font
 		std::string m_fontFilePath; //!< The filepath of the font
-		FT_Face m_fontFace; //!< A font face
+		uint32_t m_pixelSize; //!< The size of the font
+		bool m_sdf; //!< Are the glyphs signed distance fields
 		std::vector<GlyphData> m_glyphData; //!< All the loaded glyph data
-		std::shared_ptr<TextureAtlas> m_glyphAtlas; //!< Texture atlas for the glyphs
+		std::unordered_map<uint32_t, float> m_kerning; //!< The kerning of each kerned pair, keyed by the left character in the high byte and the right in the low byte
+		Texture2D* m_glyphAtlas; //!< The atlas texture the glyphs are in
 		unsigned char m_firstGlyph; //!< The first glyph
 		unsigned char m_lastGlyph; //!< The last glyph
 	public:
-		Font(FT_Library& ft, const std::string& fontName, const std::string& fontFilePath, const uint32_t pixelSize, unsigned char firstGlyph, unsigned char lastGlyph); //!< Constructor
+		Font(const BakedFont& bakedFont, Texture2D* glyphAtlas, const unsigned char firstGlyph, const unsigned char lastGlyph); //!< Constructor
 		~Font(); //!< Destructor
 
 		const std::string& getName() const; //!< Get the name of the font
 		const std::string& getFilePath() const; //!< Get the filepath of the font
+		const uint32_t getPixelSize() const; //!< Get the size of the font
+		const bool isSDF() const; //!< Are the glyphs signed distance fields
 		const unsigned char getFirstGlyph() const; //!< Get the first glyph
 		const unsigned char getLastGlyph() const; //!< Get the last glyph
 		std::vector<GlyphData>& getGlyphData(); //!< Get the glyph data
+		const float getKerning(const unsigned char left, const unsigned char right) const; //!< Get the kerning between two characters
 
 		void printFontDetails(); //!< Print font details
 		void printCharacterDetails(unsigned char character); //!< Print a character's glyph details
 		void printCharactersDetails(); //!< Print all character glyph details
-
-		void RtoRGBA(unsigned char* DSTBuffer, unsigned char* SRCBuffer, uint32_t width, uint32_t height); //!< Convert single channel data to 4 channels
 	};
 }
 #endif
\ No newline at end of file
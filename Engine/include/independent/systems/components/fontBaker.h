@@ -0,0 +1,94 @@
+/*! \file fontBaker.h
+*
+* \brief Rasterises the glyphs of every configured font into one atlas, opening each font file once
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef FONTBAKER_H
+#define FONTBAKER_H
+
+#include "ft2build.h"
+#include "freetype/freetype.h"
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \struct FontDescription
+	* \brief A font to bake, as given in the config
+	*/
+	struct FontDescription
+	{
+		std::string Name; //!< The name of the font
+		std::string FilePath; //!< The font file
+		uint32_t PixelSize; //!< The size the font is drawn at
+	};
+
+	/*! \struct FontAtlasSettings
+	* \brief How the glyphs are rasterised and how large the atlas may grow
+	*/
+	struct FontAtlasSettings
+	{
+		bool SDF = false; //!< Are the glyphs stored as signed distance fields, so one rasterised size serves every font of a file
+		uint32_t SDFPixelSize = 48; //!< The size distance field glyphs are rasterised at
+		uint32_t SDFSpread = 6; //!< The distance in pixels the field covers either side of a glyph's edge
+		uint32_t MaxSize = 4096; //!< The largest width and height of the atlas
+	};
+
+	/*! \struct BakedGlyph
+	* \brief A glyph's metrics at its font's size and its place in the atlas, stored as is in the font cache
+	*/
+	struct BakedGlyph
+	{
+		uint32_t Character; //!< The character
+		glm::vec2 Size; //!< The size of the glyph's quad in pixels
+		glm::vec2 Bearing; //!< The offset of the quad's top left from the pen
+		float Advance; //!< The distance to move the pen after the glyph
+		glm::vec2 UVStart; //!< The UV of the quad's top left in the atlas
+		glm::vec2 UVEnd; //!< The UV of the quad's bottom right in the atlas
+	};
+
+	/*! \struct BakedKerning
+	* \brief The kerning between a pair of characters, only pairs which are kerned are stored
+	*/
+	struct BakedKerning
+	{
+		uint32_t Pair; //!< The left character in the high byte and the right character in the low byte
+		float Amount; //!< The pixels to move the pen between the pair
+	};
+
+	/*! \struct BakedFont
+	* \brief Everything needed to draw a font with the baked atlas
+	*/
+	struct BakedFont
+	{
+		std::string Name; //!< The name of the font
+		std::string FilePath; //!< The font file
+		uint32_t PixelSize; //!< The size the font is drawn at
+		bool SDF; //!< Are the font's glyphs signed distance fields
+		std::vector<BakedGlyph> Glyphs; //!< The glyphs in character order
+		std::vector<BakedKerning> Kerning; //!< The kerned pairs
+	};
+
+	/*! \struct BakedFontAtlas
+	* \brief The pixels of the atlas and the fonts placed in it
+	*/
+	struct BakedFontAtlas
+	{
+		uint32_t Width = 0; //!< The width of the atlas
+		uint32_t Height = 0; //!< The height of the atlas
+		std::vector<unsigned char> Pixels; //!< The RGBA pixels, white with the glyph in the alpha
+		std::vector<BakedFont> Fonts; //!< The fonts
+	};
+
+	/*! \class FontBaker
+	* \brief Rasterises fonts into one atlas. Fonts sharing a file share a face, and with distance fields they share glyphs too
+	*/
+	class FontBaker
+	{
+	public:
+		static const bool bake(FT_Library& freetype, const std::vector<FontDescription>& fonts, const FontAtlasSettings& settings,
+			const unsigned char firstGlyph, const unsigned char lastGlyph, BakedFontAtlas& atlas); //!< Bake fonts into an atlas
+	};
+}
+#endif
@@ -0,0 +1,53 @@
+/*! \file fontCache.h
+*
+* \brief A disk cache of the baked font atlas and glyph metrics, so a warm start does not rasterise any glyphs
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef FONTCACHE_H
+#define FONTCACHE_H
+
+#include "independent/systems/components/fontBaker.h"
+
+namespace Engine
+{
+	namespace FontCacheFormat
+	{
+		const uint32_t Magic = 0x43544E46; //!< The first four bytes of the cache file, 'FNTC'
+		const uint32_t Version = 1; //!< Increase whenever the layout of the file or the baking changes
+	}
+
+	/*! \struct FontCacheHeader
+	* \brief The start of the cache file. It is followed by each font's name, file, size, glyphs and kerning, then the atlas pixels
+	*/
+	struct FontCacheHeader
+	{
+		uint32_t magic = FontCacheFormat::Magic; //!< Identifies the file as a font cache
+		uint32_t version = FontCacheFormat::Version; //!< The format version
+		uint64_t key = 0; //!< The key of the fonts and settings the atlas was baked from
+		uint32_t width = 0; //!< The width of the atlas
+		uint32_t height = 0; //!< The height of the atlas
+		uint32_t fontCount = 0; //!< The number of fonts
+		uint32_t reserved = 0; //!< Keeps the header a multiple of 8 bytes
+	};
+
+	/*! \class FontCache
+	* \brief Stores the baked atlas in a single file read back with one mapping. The key covers the fonts, the settings
+	* and the size and time of each font file, so changing any of them simply misses the cache
+	*/
+	class FontCache
+	{
+	private:
+		static bool s_initialised; //!< Has the config been read
+		static std::string s_filePath; //!< The cache file, empty when the cache is not used
+
+		static void initialise(); //!< Read the cache settings from the config
+	public:
+		static const bool isEnabled(); //!< Is the cache used
+		static const uint64_t getKey(const std::vector<FontDescription>& fonts, const FontAtlasSettings& settings, const unsigned char firstGlyph, const unsigned char lastGlyph); //!< Get the key of a bake
+		static const bool load(const uint64_t key, BakedFontAtlas& atlas); //!< Load the baked atlas
+		static const bool save(const uint64_t key, const BakedFontAtlas& atlas); //!< Save the baked atlas
+	};
+}
+#endif
@@ -0,0 +1,67 @@
+/*! \file glyphRun.h
+*
+* \brief A string laid out in a font once, so text which does not change is not laid out again every frame
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef GLYPHRUN_H
+#define GLYPHRUN_H
+
+#include "independent/systems/components/font.h"
+#include "independent/rendering/geometry/vertex.h"
+
+namespace Engine
+{
+	/*! \struct PositionedGlyph
+	* \brief A glyph placed relative to the start of the text
+	*/
+	struct PositionedGlyph
+	{
+		glm::vec2 Centre; //!< The centre of the glyph's quad relative to the text origin
+		glm::vec2 Size; //!< The size of the glyph's quad in pixels
+		glm::vec4 UVRect; //!< The glyph's UV start and end in the font atlas
+		SubTexture* Texture; //!< The glyph's subtexture in the font atlas
+	};
+
+	/*! \class GlyphRun
+	* \brief The glyphs of a string with their positions, UVs, advances and kerning applied. The quads of the glyphs are kept
+	* for the last origin and tint, so they are only rebuilt when the text moves or changes colour
+	*/
+	class GlyphRun
+	{
+	private:
+		bool m_valid; //!< Does the layout match the text and font
+		bool m_sdf; //!< Are the glyphs signed distance fields
+		std::vector<PositionedGlyph> m_glyphs; //!< The glyphs in order
+		glm::vec2 m_boundsMin; //!< The top left of the glyphs relative to the origin
+		glm::vec2 m_boundsMax; //!< The bottom right of the glyphs relative to the origin
+		float m_advance; //!< The distance from the origin to the pen after the last glyph
+
+		glm::vec3 m_origin; //!< The origin the quads were built for
+		glm::vec4 m_tint; //!< The tint the quads were built for
+		bool m_instancesValid; //!< Do the quads match the glyphs, origin and tint
+		std::vector<QuadInstance2D> m_instances; //!< The quad of each glyph, in the layout the 2D renderer uploads
+	public:
+		GlyphRun(); //!< Constructor
+
+		void build(const std::string& text, Font* font); //!< Lay out a string in a font
+		void invalidate(); //!< Mark the layout as needing to be built again
+		inline const bool isValid() const { return m_valid; } //!< Does the layout match its text and font
+			/*!< \return a const bool - Is the layout valid */
+		inline const bool isSDF() const { return m_sdf; } //!< Are the glyphs signed distance fields
+			/*!< \return a const bool - Do the glyphs need the distance field text material */
+
+		std::vector<QuadInstance2D>& getInstances(const glm::vec3& origin, const glm::vec4& tint); //!< Get the quad of each glyph, rebuilding them only if the origin or tint changed
+
+		inline const std::vector<PositionedGlyph>& getGlyphs() const { return m_glyphs; } //!< Get the glyphs
+			/*!< \return a const std::vector<PositionedGlyph>& - The glyphs */
+		inline const glm::vec2& getBoundsMin() const { return m_boundsMin; } //!< Get the top left of the glyphs relative to the origin
+			/*!< \return a const glm::vec2& - The top left */
+		inline const glm::vec2& getBoundsMax() const { return m_boundsMax; } //!< Get the bottom right of the glyphs relative to the origin
+			/*!< \return a const glm::vec2& - The bottom right */
+		inline const float getAdvance() const { return m_advance; } //!< Get the width of the text from the origin to the pen after the last glyph
+			/*!< \return a const float - The advance */
+	};
+}
+#endif
@@ -12,7 +12,9 @@
 #include "independent/core/destroyable.h"
 #include "independent/entities/entity.h"
 #include "independent/layers/layerManager.h"
+#include "independent/systems/components/collisionWorld.h"
 #include "independent/rendering/renderPasses/renderPass.h"
+#include "independent/utils/frameAllocator.h"
 
 namespace Engine
 {
@@ -25,12 +27,18 @@ namespace Engine
 		std::string m_sceneName; //!< The name of the scene
 		std::string m_sceneFolderPath; //!< The filepath to the scene folder
 		LayerManager* m_layerManager; //!< A layer manager for the scene
+		CollisionWorld* m_collisionWorld; //!< The colliders of the scene
 		std::vector<RenderPass*> m_renderPasses; //!< A list of all render passes for the scene
 		std::map<std::string, Entity*> m_rootEntities; //!< List of all root entities in the scene
 		Camera* m_mainCamera; //!< The current main camera
+		EntityHandle m_nextHandle; //!< The handle given to the next root entity
+		std::unordered_map<EntityHandle, Entity*> m_handles; //!< Root entities by handle
 
 		bool m_entityListUpdated; //!< Has the entity list been updated
 		std::vector<Entity*> m_entitiesList; //!< The list of entities in vector format
+		std::vector<Entity*> m_destroyQueue; //!< Entities destroyed this frame, deleted together at the end of it
+
+		void registerRootEntity(const std::string& name, Entity* entity); //!< Make an entity a root entity of this scene
 	public:
 		Scene(const std::string& name, const std::string& sceneFolderPath); //!< Constructor
 		~Scene(); //!< Destructor
@@ -41,13 +49,21 @@ namespace Engine
 		void onUpdate(const float timestep, const float totalTime); //!< Update the scene
 
 		void addEntity(const std::string& name, Entity* entity); //!< Add an entity to the scene
+		EntityHandle addEntity(Entity* entity); //!< Add an unnamed entity to the scene
+		void addEntities(const std::vector<Entity*>& entities); //!< Add many unnamed entities to the scene at once
 		Entity* getEntity(const std::string& name); //!< Get an entity in the scene
+		Entity* getEntity(const EntityHandle handle); //!< Get a root entity in the scene by handle
 		std::map<std::string, Entity*> getRootEntities() const; //!< Get only the root entities of the scene
-		std::vector<Entity*> getEntities(); //!< Get a list of all entities in the scene
+		FrameVector<Entity*> getEntities(); //!< Get a list of all entities in the scene
+		void addToEntityList(Entity* entity); //!< Add an entity and its children to the entity list
+		void removeFromEntityList(Entity* entity); //!< Remove an entity from the entity list
+
+		void queueDestroyedEntity(Entity* entity); //!< Queue a destroyed entity to be deleted at the end of the frame
+		void deleteDestroyedEntities(); //!< Delete every queued entity
 
-		std::vector<PointLight*> getClosestPointLights(); //!< Get a list of the closest point lights
-		std::vector<SpotLight*> getClosestSpotLights(); //!< Get a list of the closest spot lights
-		std::vector<DirectionalLight*> getClosestDirectionalLights(); //!< Get a list of the closest directional lights
+		FrameVector<PointLight*> getClosestPointLights(); //!< Get a list of the closest point lights
+		FrameVector<SpotLight*> getClosestSpotLights(); //!< Get a list of the closest spot lights
+		FrameVector<DirectionalLight*> getClosestDirectionalLights(); //!< Get a list of the closest directional lights
 
 		bool checkRootEntityNameTaken(const std::string& name); //!< Returns whether the entity name has been taken
 
@@ -55,6 +71,7 @@ namespace Engine
 		Camera* getMainCamera() const; //!< Get the main camera
 
 		LayerManager* getLayerManager(); //!< Get the layer manager
+		CollisionWorld* getCollisionWorld(); //!< Get the collision world
 
 		void addRenderPass(RenderPass* pass); //!< Add a render pass to the list of passes
 		std::vector<RenderPass*>& getRenderPasses(); //!< Get the list of render passes
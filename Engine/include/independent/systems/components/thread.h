@@ -10,6 +10,7 @@
 
 #include <thread>
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -52,6 +53,7 @@ namespace Engine
 
 		m_thread = std::thread([&]()
 		{
+			Profiler::setThreadName(m_threadName);
 			func(std::forward<Args>(args)...);
 			m_isFinished = true;
 			ENGINE_INFO("[Thread::action] Finished executing thread: {0}.", m_threadName);
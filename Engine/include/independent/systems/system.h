@@ -17,7 +17,7 @@ namespace Engine
 	*/
 	enum class SystemType
 	{
-		Logger, Randomiser, TimerSystem, WindowAPISystem, WindowManager, EventManager, ResourceManager, SceneManager, FontManager, RenderSystem, ThreadManager
+		Logger, Randomiser, TimerSystem, WindowAPISystem, WindowManager, EventManager, ResourceManager, SceneManager, FontManager, RenderSystem, ThreadManager, InputManager, Profiler, CounterSystem
 	};
 
 	/*! \class System
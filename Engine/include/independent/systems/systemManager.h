@@ -18,6 +18,9 @@
 #include "independent/systems/systems/fontManager.h"
 #include "independent/systems/systems/renderSystem.h"
 #include "independent/systems/systems/threadManager.h"
+#include "independent/systems/systems/inputManager.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
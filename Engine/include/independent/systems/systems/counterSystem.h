@@ -0,0 +1,107 @@
+/*! \file counterSystem.h
+*
+* \brief A counter system which keeps per-frame engine counters and gauges
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef COUNTERSYSTEM_H
+#define COUNTERSYSTEM_H
+
+#include <atomic>
+#include "independent/systems/system.h"
+
+namespace Engine
+{
+	namespace Counter
+	{
+		/*! \enum Counter
+		* \brief Values which are added to during a frame and reset at the end of it
+		*/
+		enum Counter
+		{
+			DrawCalls, DrawCommands, BatchFlushes3D, BatchFlushes2D, TextureBinds, VertexBytesUploaded, IndexBytesUploaded, UniformBytesUploaded,
+			EntitiesTraversed, Allocations, AllocatedBytes, ResourcesLoaded, SubmissionsClipped, GlyphRunsBuilt, Count
+		};
+	}
+
+	namespace Gauge
+	{
+		/*! \enum Gauge
+		* \brief Values which are set and keep their value between frames
+		*/
+		enum Gauge
+		{
+			SceneEntities, FrameTimeMicroseconds, FrameArenaBytes, Count
+		};
+	}
+
+	/*! \enum DumpFormat
+	* \brief The file formats the per-frame dump can be written in
+	*/
+	enum class DumpFormat
+	{
+		CSV, JSON
+	};
+
+	/*! \struct FrameCounters
+	* \brief The counters and gauges of a single frame
+	*/
+	struct FrameCounters
+	{
+		uint64_t frame = 0; //!< The frame number
+		std::array<uint64_t, Counter::Count> counters = {}; //!< The counter values
+		std::array<int64_t, Gauge::Count> gauges = {}; //!< The gauge values
+	};
+
+	/*! \class CounterSystem
+	* \brief A system which keeps counters and gauges, a rolling history and an optional per-frame dump
+	*/
+	class CounterSystem : public System
+	{
+	public:
+		static const uint32_t HistorySize = 120; //!< The number of frames kept in the rolling window
+	private:
+		static bool s_enabled; //!< Is this system enabled
+		static std::array<std::atomic<uint64_t>, Counter::Count> s_counters; //!< The counters of the current frame
+		static std::array<std::atomic<int64_t>, Gauge::Count> s_gauges; //!< The gauges
+		static std::array<FrameCounters, HistorySize> s_history; //!< The last frames, used as a ring
+		static uint32_t s_historyCount; //!< The number of frames in the history
+		static uint64_t s_frameNumber; //!< The number of frames since the system started
+		static std::ofstream s_dumpFile; //!< The file the frames are dumped to
+		static DumpFormat s_dumpFormat; //!< The format of the dump
+		static uint64_t s_dumpedFrames; //!< The number of frames written to the dump
+
+		static const FrameCounters& getHistory(const uint32_t framesAgo); //!< Get a frame from the history
+		static void writeDumpRow(const FrameCounters& frame); //!< Write a frame to the dump
+	public:
+		CounterSystem(); //!< Constructor
+		~CounterSystem(); //!< Destructor
+		void start() override; //!< Start the system
+		void stop() override; //!< Stop the system
+
+		static inline void increment(const Counter::Counter counter, const uint64_t amount = 1) { s_counters[counter].fetch_add(amount, std::memory_order_relaxed); } //!< Add to a counter
+			/*!< \param counter a const Counter::Counter - The counter
+				 \param amount a const uint64_t - The amount to add */
+		static inline void setGauge(const Gauge::Gauge gauge, const int64_t value) { s_gauges[gauge].store(value, std::memory_order_relaxed); } //!< Set a gauge
+			/*!< \param gauge a const Gauge::Gauge - The gauge
+				 \param value a const int64_t - The value */
+
+		static void onFrameEnd(const float timestep); //!< Record the frame and reset the counters
+
+		static const uint64_t getCounter(const Counter::Counter counter); //!< Get the value of a counter so far this frame
+		static const int64_t getGauge(const Gauge::Gauge gauge); //!< Get the value of a gauge
+		static const uint64_t getLastFrame(const Counter::Counter counter); //!< Get the value of a counter in the last complete frame
+		static const float getAverage(const Counter::Counter counter); //!< Get the average of a counter over the rolling window
+		static const uint64_t getMax(const Counter::Counter counter); //!< Get the largest value of a counter over the rolling window
+		static const float getAverage(const Gauge::Gauge gauge); //!< Get the average of a gauge over the rolling window
+
+		static void startDump(const std::string& filePath, const DumpFormat format); //!< Start writing every frame to file
+		static void stopDump(); //!< Stop writing frames to file
+		static const bool isDumping(); //!< Are frames being written to file
+
+		static const char* toString(const Counter::Counter counter); //!< Get the name of a counter
+		static const char* toString(const Gauge::Gauge gauge); //!< Get the name of a gauge
+	};
+}
+#endif
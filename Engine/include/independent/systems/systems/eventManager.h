@@ -16,6 +16,8 @@
 namespace Engine
 {
 	class Scene; //!< Forward declare scene
+	class Layer; //!< Forward declare layer
+	class NativeScript; //!< Forward declare native script
 
 	/*! \struct EventData
 	* \brief Struct containing event related data such as mouse position last frame, etc
@@ -30,6 +32,16 @@ namespace Engine
 		float lastFrame = 0.0f; //!< Time to render last frame
 	};
 
+	/*! \struct QueuedEvent
+	* \brief A window event recorded by a window callback, dispatched later in the frame
+	*/
+	struct QueuedEvent
+	{
+		EventType type; //!< The type of event
+		Window* window; //!< The window which triggered the event
+		glm::vec2 data; //!< The event data (size, position, offset, key code or button)
+	};
+
 	/*! \class EventManager
 	* \brief An event manager which manages events
 	*/
@@ -39,8 +51,15 @@ namespace Engine
 		static bool s_enabled; //!< Is the event manager enabled
 		static EventData s_eventData; //!< Event related variables
 		static Scene* s_currentScene; //!< The scene to be sent updates
+		static std::array<std::vector<Layer*>, EventTypeCount> s_layerListeners; //!< The layers subscribed to each event type
+		static std::array<std::vector<NativeScript*>, EventTypeCount> s_scriptListeners; //!< The scripts subscribed to each event type
+		static std::array<bool, EventTypeCount> s_listenersDirty; //!< Does the listener list contain removed listeners
+		static uint32_t s_dispatchDepth; //!< The number of dispatches currently in progress
+		static std::vector<QueuedEvent> s_eventQueue; //!< The window events waiting to be dispatched
 		static void calculateMouseOffset(MouseMovedEvent& e); //!< Calculate change in mouse position when moved
 		static void updateTime(); //!< Update FPS and TotalTime
+		template<typename T> static void dispatch(T& e, void(Layer::*layerHandler)(T&, const float, const float), void(NativeScript::*scriptHandler)(T&, const float, const float)); //!< Send an event to all its listeners
+		static void compactListeners(const EventType type); //!< Remove unsubscribed listeners from a listener list
 	public:
 		EventManager(); //!< Constructor
 		~EventManager(); //!< Destructor
@@ -62,6 +81,15 @@ namespace Engine
 
 		static void onUpdate(Scene* scene, const float timestep, const float totalTime); //!< Called once every frame
 
+		static void queueEvent(Window* window, const EventType type, const glm::vec2& data = glm::vec2(0.f)); //!< Queue a window event to be dispatched this frame
+		static void dispatchQueuedEvents(); //!< Dispatch all queued window events
+		static void discardQueuedEvents(Window* window); //!< Discard all queued events belonging to a window
+
+		static void subscribe(const EventType type, Layer* layer); //!< Subscribe a layer to an event type
+		static void subscribe(const EventType type, NativeScript* script); //!< Subscribe a script to an event type
+		static void unsubscribe(const EventType type, Layer* layer); //!< Unsubscribe a layer from an event type
+		static void unsubscribe(const EventType type, NativeScript* script); //!< Unsubscribe a script from an event type
+
 		static void enable(); //!< Enable the event manager
 		static void disable(); //!< Disable the event manager
 		static const bool getEnabled(); //!< Get whether the event manager is enabled
@@ -10,6 +10,7 @@
 
 #include "independent/systems/system.h"
 #include "independent/systems/components/font.h"
+#include "independent/systems/components/fontBaker.h"
 
 namespace Engine
 {
@@ -24,6 +25,9 @@ namespace Engine
 		static FT_Library s_freetype; //!< The freetype library
 		static unsigned char s_firstGlyph; //!< The first char (ASCII)
 		static unsigned char s_lastGlyph; //!< The last char (ASCII)
+		static FontAtlasSettings s_atlasSettings; //!< The settings the fonts are baked with
+
+		static void createFonts(const BakedFontAtlas& atlas, const std::string& textureName); //!< Create the atlas texture and a font for each baked font
 	public:
 		FontManager(); //!< Constructor
 		~FontManager(); //!< Destructor
@@ -0,0 +1,75 @@
+/*! \file inputManager.h
+*
+* \brief An input manager system which tracks key and mouse button state from window callbacks
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef INPUTMANAGER_H
+#define INPUTMANAGER_H
+
+#include <bitset>
+#include "independent/systems/system.h"
+
+namespace Engine
+{
+	static const uint32_t KeyCount = 349; //!< The number of key codes tracked (GLFW_KEY_LAST + 1)
+	static const uint32_t MouseButtonCount = 8; //!< The number of mouse buttons tracked (GLFW_MOUSE_BUTTON_LAST + 1)
+
+	/*! \struct ActionBinding
+	* \brief The keys bound to a named action
+	*/
+	struct ActionBinding
+	{
+		int32_t key1 = -1; //!< The first key bound to the action
+		int32_t key2 = -1; //!< The second key bound to the action
+	};
+
+	/*! \class InputManager
+	* \brief A system which keeps the state of every key and mouse button, updated by window callbacks
+	*/
+	class InputManager : public System
+	{
+	private:
+		static bool s_enabled; //!< Is this system enabled
+		static std::bitset<KeyCount> s_keysDown; //!< The keys currently held down
+		static std::bitset<KeyCount> s_keysPressed; //!< The keys which went down this frame
+		static std::bitset<KeyCount> s_keysReleased; //!< The keys which went up this frame
+		static std::bitset<MouseButtonCount> s_buttonsDown; //!< The mouse buttons currently held down
+		static std::bitset<MouseButtonCount> s_buttonsPressed; //!< The mouse buttons which went down this frame
+		static std::bitset<MouseButtonCount> s_buttonsReleased; //!< The mouse buttons which went up this frame
+		static std::vector<int32_t> s_changedKeys; //!< The keys which changed state this frame
+		static std::vector<int32_t> s_heldKeys; //!< The keys currently held down
+		static std::vector<ActionBinding> s_actions; //!< The key bindings of each action, indexed by action
+
+		static const bool validKey(const int32_t keyCode); //!< Is the key code in range
+		static const bool validButton(const int32_t button); //!< Is the mouse button in range
+	public:
+		InputManager(); //!< Constructor
+		~InputManager(); //!< Destructor
+		void start() override; //!< Start the system
+		void stop() override; //!< Stop the system
+
+		static void onUpdate(); //!< Clear the edges recorded during the last frame
+		static void clear(); //!< Release every key and mouse button
+
+		static void setKeyState(const int32_t keyCode, const bool down); //!< Set the state of a key
+		static void setMouseButtonState(const int32_t button, const bool down); //!< Set the state of a mouse button
+
+		static const bool isKeyDown(const int32_t keyCode); //!< Is the key held down
+		static const bool wasKeyPressed(const int32_t keyCode); //!< Did the key go down this frame
+		static const bool wasKeyReleased(const int32_t keyCode); //!< Did the key go up this frame
+		static const bool isMouseButtonDown(const int32_t button); //!< Is the mouse button held down
+		static const bool wasMouseButtonPressed(const int32_t button); //!< Did the mouse button go down this frame
+		static const bool wasMouseButtonReleased(const int32_t button); //!< Did the mouse button go up this frame
+		static const std::vector<int32_t>& getHeldKeys(); //!< Get all the keys currently held down
+
+		static void bindAction(const uint32_t action, const int32_t key1, const int32_t key2 = -1); //!< Bind keys to an action
+		static void unbindAction(const uint32_t action); //!< Remove the keys bound to an action
+		static const ActionBinding getActionBinding(const uint32_t action); //!< Get the keys bound to an action
+		static const bool isActionDown(const uint32_t action); //!< Is either key of the action held down
+		static const bool wasActionPressed(const uint32_t action); //!< Did the action start this frame
+		static const bool wasActionReleased(const uint32_t action); //!< Did the action end this frame
+	};
+}
+#endif
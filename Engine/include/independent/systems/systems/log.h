@@ -8,12 +8,35 @@
 #ifndef LOG_H
 #define LOG_H
 
+#include <atomic>
+#include <thread>
+#include <string_view>
 #include <spdlog/spdlog.h>
 #include "independent/core/common.h"
 #include "independent/systems/system.h"
 
 namespace Engine
 {
+	/*! \class LogSite
+	* \brief The rate limiting state of a single logging call site
+	*/
+	class LogSite
+	{
+	private:
+		std::atomic<uint64_t> m_windowStart; //!< The time in milliseconds the current window started
+		std::atomic<uint32_t> m_windowCount; //!< The number of messages seen in the current window
+		std::atomic<uint32_t> m_suppressed; //!< The number of messages not printed since the last printed message
+		std::atomic<size_t> m_lastHash; //!< The hash of the last printed message
+	public:
+		static const uint64_t Window = 1000; //!< The length of a rate limiting window in milliseconds
+		static const uint32_t Burst = 10; //!< The number of messages a call site can print in one window
+
+		LogSite(); //!< Constructor
+		const bool allow(const uint64_t now); //!< Is the call site under its limit for this window
+		const bool isRepeat(const size_t hash); //!< Is the message the same as the last one printed in this window
+		const uint32_t takeSuppressed(); //!< Get and reset the number of suppressed messages
+	};
+
 	/*! \class Log
 	* \brief A log class using spdlog which prints information to various outputs (Console, file, etc)
 	*/
@@ -22,6 +45,15 @@ namespace Engine
 		static bool s_enabled; //!< Is this logger system enabled
 		static Shared<spdlog::logger> s_consoleLogger; //!< Console logger
 		static Shared<spdlog::logger> s_fileLogger; //!< File logger
+		static std::thread s_flusher; //!< The thread which writes queued messages to the console
+		static std::atomic<bool> s_flusherRunning; //!< Should the flusher keep running
+
+		static void flush(); //!< Write every queued message to the console
+		static void submit(const spdlog::level::level_enum level, const char* text, const size_t length, const uint32_t suppressed); //!< Queue a formatted message
+		static const uint64_t getMilliseconds(); //!< Get the current time in milliseconds
+
+		template<class T> static void format(fmt::MemoryWriter& writer, T&& message); //!< Write a message with no arguments
+		template<class ...Args> static void format(fmt::MemoryWriter& writer, const char* formatString, Args&&... args); //!< Write a formatted message
 	public:
 		Log(); //!< Constructor
 		~Log(); //!< Destructor
@@ -30,89 +62,60 @@ namespace Engine
 
 		void enableFileLogging(const bool enable); //!< Enable/Disable the file logging
 
-		template<class ...Args> static void info(Args&&... args); //!< Print info to the console
-		template<class ...Args> static void trace(Args&&... args); //!< Print a trace message to the console
-		template<class ...Args> static void warn(Args&&... args); //!< Print a warn message to the console
-		template<class ...Args> static void debug(Args&&... args); //!< Print a debug message to the console
-		template<class ...Args> static void error(Args&&... args); //!< Print an error message to the console
-		template<class ...Args> static void release(Args&&... args); //!< Print a trace message in release mode to the console
+		template<class ...Args> static void write(LogSite& site, const spdlog::level::level_enum level, Args&&... args); //!< Queue a message from a call site
 		template<class ...Args> static void file(Args&&... args); //!< Print information to the log files
 	};
 
-	template<class ...Args>
-	//! debug()
+	template<class T>
+	//! format()
 	/*!
-	\param args a Args&& - Parameter pack
+	\param writer a fmt::MemoryWriter& - The writer
+	\param message a T&& - The message, written as is
 	*/
-	static void Log::debug(Args&&... args)
+	void Log::format(fmt::MemoryWriter& writer, T&& message)
 	{
-#ifdef NG_DEBUG
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->debug(std::forward<Args>(args) ...);
-#endif
+		writer << message;
 	}
 
 	template<class ...Args>
-	//! error()
+	//! format()
 	/*!
+	\param writer a fmt::MemoryWriter& - The writer
+	\param formatString a const char* - The format string
 	\param args a Args&& - Parameter pack
 	*/
-	static void Log::error(Args&&... args)
+	void Log::format(fmt::MemoryWriter& writer, const char* formatString, Args&&... args)
 	{
-#ifdef NG_DEBUG
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->error(std::forward<Args>(args) ...);
-#endif
+		writer.write(formatString, std::forward<Args>(args) ...);
 	}
 
 	template<class ...Args>
-	//! info()
+	//! write()
 	/*!
+	\param site a LogSite& - The call site the message came from
+	\param level a const spdlog::level::level_enum - The level of the message
 	\param args a Args&& - Parameter pack
 	*/
-	static void Log::info(Args&&... args)
+	void Log::write(LogSite& site, const spdlog::level::level_enum level, Args&&... args)
 	{
-#ifdef NG_DEBUG
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->info(std::forward<Args>(args) ...);
-#endif
-	}
+		if (!s_enabled || !site.allow(getMilliseconds())) return;
 
-	template<class ...Args>
-	//! trace()
-	/*!
-	\param args a Args&& - Parameter pack
-	*/
-	static void Log::trace(Args&&... args)
-	{
-#ifdef NG_DEBUG
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->trace(std::forward<Args>(args) ...);
-#endif
-	}
+		// Format on the calling thread, the flusher only copies text
+		fmt::MemoryWriter writer;
+		try
+		{
+			format(writer, std::forward<Args>(args) ...);
+		}
+		catch (const fmt::FormatError& e)
+		{
+			writer.clear();
+			writer << "[Log::write] Invalid format string. Reason: " << e.what();
+		}
 
-	template<class ...Args>
-	//! warn()
-	/*!
-	\param args a Args&& - Parameter pack
-	*/
-	static void Log::warn(Args&&... args)
-	{
-#ifdef NG_DEBUG
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->warn(std::forward<Args>(args) ...);
-#endif
-	}
+		// The same message repeated from one call site is counted rather than printed
+		if (site.isRepeat(std::hash<std::string_view>()(std::string_view(writer.data(), writer.size())))) return;
 
-	template<class ...Args>
-	//! release()
-	/*!
-	\param args a Args&& - Parameter pack
-	*/
-	static void Log::release(Args&&... args)
-	{
-		if (s_enabled && s_consoleLogger)
-			s_consoleLogger->trace(std::forward<Args>(args) ...);
+		submit(level, writer.data(), writer.size(), site.takeSuppressed());
 	}
 
 	template<class ...Args>
@@ -120,7 +123,7 @@ namespace Engine
 	/*!
 	\param args a Args&& - Parameter pack
 	*/
-	static void Log::file(Args&&... args)
+	void Log::file(Args&&... args)
 	{
 		// Check if file logger has a valid pointer
 		if (s_enabled && s_fileLogger)
@@ -129,4 +132,4 @@ namespace Engine
 			ENGINE_ERROR("[Log::file] File logging is disabled.");
 	}
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,115 @@
+/*! \file profiler.h
+*
+* \brief A profiler system which records nested timing zones from any thread and exports them as a Chrome trace
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "independent/systems/system.h"
+
+#define ENGINE_PROFILE_CONCAT_INNER(x, y) x##y //!< Join two tokens
+#define ENGINE_PROFILE_CONCAT(x, y) ENGINE_PROFILE_CONCAT_INNER(x, y) //!< Join two tokens after expanding them
+
+#ifndef NG_DISABLE_PROFILER
+#define ENGINE_PROFILE_SCOPE(x) Engine::ProfileZone ENGINE_PROFILE_CONCAT(profileZone, __LINE__)(x) //!< Profile the enclosing scope, x must be a string literal
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__FUNCTION__) //!< Profile the enclosing function
+#else
+#define ENGINE_PROFILE_SCOPE(x)
+#define ENGINE_PROFILE_FUNCTION()
+#endif
+
+namespace Engine
+{
+	/*! \struct ProfileEvent
+	* \brief A single completed zone
+	*/
+	struct ProfileEvent
+	{
+		const char* name; //!< The name of the zone, must outlive the capture
+		uint64_t start; //!< The start time in nanoseconds since the profiler started
+		uint64_t end; //!< The end time in nanoseconds since the profiler started
+		uint32_t depth; //!< How many zones this zone is nested in
+	};
+
+	/*! \class ProfileBuffer
+	* \brief A single producer, single consumer ring of events owned by one thread
+	*/
+	class ProfileBuffer
+	{
+	public:
+		static const uint32_t Capacity = 1 << 14; //!< The number of events the buffer can hold, must be a power of two
+	private:
+		std::array<ProfileEvent, Capacity> m_events; //!< The event ring
+		std::atomic<uint32_t> m_head; //!< The next slot to write, only written by the owning thread
+		std::atomic<uint32_t> m_tail; //!< The next slot to read, only written by the consumer
+		std::atomic<uint32_t> m_dropped; //!< The number of events dropped because the ring was full
+	public:
+		ProfileBuffer(const uint32_t threadID); //!< Constructor
+
+		const uint32_t m_threadID; //!< The id of the owning thread in the trace
+		std::string m_threadName; //!< The name of the owning thread, guarded by the profiler's buffer mutex
+		uint32_t m_depth; //!< The current zone depth of the owning thread
+
+		void push(const ProfileEvent& event); //!< Add an event, called by the owning thread
+		void drain(std::vector<std::pair<uint32_t, ProfileEvent>>& events); //!< Move all events out, called by the consumer
+		const uint32_t takeDropped(); //!< Get and reset the number of dropped events
+	};
+
+	/*! \class ProfileZone
+	* \brief Records the time between its construction and destruction
+	*/
+	class ProfileZone
+	{
+	private:
+		const char* m_name; //!< The name of the zone
+		uint64_t m_start; //!< The start time
+		ProfileBuffer* m_buffer; //!< The buffer of the recording thread, null if not recording
+	public:
+		ProfileZone(const char* name); //!< Constructor
+		~ProfileZone(); //!< Destructor
+	};
+
+	/*! \class Profiler
+	* \brief A system which collects zones from every thread's buffer and writes captures to file
+	*/
+	class Profiler : public System
+	{
+	private:
+		static bool s_enabled; //!< Is this system enabled
+		static std::atomic<bool> s_capturing; //!< Are zones being recorded
+		static std::chrono::steady_clock::time_point s_epoch; //!< The time the profiler started
+		static std::mutex s_bufferMutex; //!< Guards the buffer list and thread names
+		static std::vector<ProfileBuffer*> s_buffers; //!< The buffer of every thread that has recorded a zone, kept until the process exits
+		static std::vector<std::pair<uint32_t, ProfileEvent>> s_capturedEvents; //!< All events collected in the current capture, paired with their thread id
+		static std::vector<std::pair<uint64_t, uint64_t>> s_frameMarkers; //!< The end time and number of each frame in the current capture
+		static uint64_t s_frameNumber; //!< The number of frames since the profiler started
+		static uint32_t s_framesRemaining; //!< The number of frames left to capture
+		static uint32_t s_droppedEvents; //!< The number of events dropped during the current capture
+		static std::string s_capturePath; //!< The file the current capture will be written to
+
+		static void collect(); //!< Move the events out of every thread buffer
+		static void exportChromeTrace(const std::string& filePath); //!< Write the captured events to file
+	public:
+		Profiler(); //!< Constructor
+		~Profiler(); //!< Destructor
+		void start() override; //!< Start the system
+		void stop() override; //!< Stop the system
+
+		static void beginCapture(const uint32_t frameCount, const std::string& filePath); //!< Start recording zones for a number of frames
+		static void endCapture(); //!< Stop recording and write the capture to file
+		static inline const bool isCapturing() { return s_capturing.load(std::memory_order_relaxed); } //!< Are zones being recorded
+			/*!< \return a const bool - Are zones being recorded */
+
+		static void onFrameEnd(); //!< Mark the end of a frame
+		static void setThreadName(const std::string& threadName); //!< Set the name of the calling thread in the trace
+		static ProfileBuffer* getThreadBuffer(); //!< Get the calling thread's buffer, creating it if needed
+		static const uint64_t getTime(); //!< Get the time in nanoseconds since the profiler started
+	};
+}
+#endif
@@ -20,7 +20,7 @@ namespace Engine
 	class TimerSystem : public System {
 	private:
 		static bool s_enabled; //!< Is this system enabled
-		static std::map<const char*, std::pair<Timer*, float>> s_timers; //!< All running timers
+		static std::map<std::string, std::pair<Timer*, float>, std::less<>> s_timers; //!< All running timers, keyed by the name's contents rather than its address
 	public:
 		TimerSystem(); //!< Constructor
 		~TimerSystem(); //!< Destructor
@@ -40,7 +40,7 @@ namespace Engine
 		static void removeTimers(); //!< Remove all timers
 
 		static const bool timerExistsByName(const char* timerName); //!< Check if a timer exists by name
-		static const std::map<const char*, std::pair<Timer*, float>>& getAllTimers(); //!< Get a list of all the recorded times
+		static const std::map<std::string, std::pair<Timer*, float>, std::less<>>& getAllTimers(); //!< Get a list of all the recorded times
 
 		static void printTimers(); //!< Print all timers
 	};
@@ -0,0 +1,100 @@
+/*! \file allocationTracker.h
+*
+* \brief Counts every heap allocation in the process by thread and by subsystem tag, with optional per-frame budgets. The global
+* new and delete are only replaced in builds which define NG_TRACK_ALLOCATIONS, Debug does and Release does not
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+#include <atomic>
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	namespace AllocationTag
+	{
+		/*! \enum AllocationTag
+		* \brief The subsystem an allocation is charged to
+		*/
+		enum AllocationTag
+		{
+			Untagged, Render, Scene, Scripts, Resources, Count
+		};
+	}
+
+	/*! \struct AllocationStats
+	* \brief The heap allocations charged to a tag in one frame
+	*/
+	struct AllocationStats
+	{
+		uint64_t allocations = 0; //!< The number of allocations
+		uint64_t bytes = 0; //!< The number of bytes allocated
+	};
+
+	/*! \class AllocationTracker
+	* \brief Keeps running totals per thread which only that thread writes, the totals are turned into per-frame values at the end of each frame
+	*/
+	class AllocationTracker
+	{
+	public:
+		static const uint32_t MaxThreads = 64; //!< Threads past this share one set of totals
+		static const uint64_t NoBudget = UINT64_MAX; //!< The budget of a tag which is not checked
+	private:
+		/*! \struct ThreadTotals
+		* \brief The running totals of one thread, each on its own cache line
+		*/
+		struct alignas(64) ThreadTotals
+		{
+			std::atomic<uint64_t> allocations[AllocationTag::Count]; //!< The number of allocations per tag
+			std::atomic<uint64_t> bytes[AllocationTag::Count]; //!< The number of bytes per tag
+		};
+
+		static ThreadTotals s_threads[MaxThreads]; //!< The totals of every thread which has allocated
+		static thread_local ThreadTotals* s_threadTotals; //!< The totals of the calling thread, set on its first allocation
+		static thread_local AllocationTag::AllocationTag s_currentTag; //!< The tag of the calling thread
+		static std::atomic<uint32_t> s_threadCount; //!< The number of threads which have allocated
+		static std::array<AllocationStats, AllocationTag::Count> s_lastTotals; //!< The totals at the end of the last frame
+		static std::array<AllocationStats, AllocationTag::Count> s_lastFrame; //!< The values of the last complete frame
+		static std::array<uint64_t, AllocationTag::Count> s_budgets; //!< The most allocations each tag may make in a frame
+		static std::atomic<bool> s_enabled; //!< Are allocations counted, tags reported and budgets checked
+		static bool s_breakOnBudget; //!< Should a broken budget stop a debug build
+		static uint32_t s_logInterval; //!< The number of frames between summaries in the log, 0 for none
+		static uint32_t s_warmupFrames; //!< The number of frames before budgets are checked, loading is expected to allocate
+		static uint64_t s_frameNumber; //!< The number of frames recorded
+
+		static ThreadTotals* registerThread(); //!< Give the calling thread its totals
+	public:
+		static void configure(); //!< Read the settings from the config file
+		static void onAllocate(const size_t size); //!< Record an allocation on the calling thread
+		static void onFrameEnd(); //!< Turn the running totals into per-frame values and check the budgets
+
+		static void setEnabled(const bool enabled); //!< Turn counting, reporting and budget checks on or off
+		static const bool isEnabled(); //!< Are allocations counted, tags reported and budgets checked
+		static void setBudget(const AllocationTag::AllocationTag tag, const uint64_t allocations); //!< Set the most allocations a tag may make in a frame
+		static const uint64_t getBudget(const AllocationTag::AllocationTag tag); //!< Get the budget of a tag
+
+		static const AllocationStats& getLastFrame(const AllocationTag::AllocationTag tag); //!< Get the allocations of a tag in the last complete frame
+		static AllocationStats getLastFrameTotal(); //!< Get the allocations of every tag in the last complete frame
+
+		static AllocationTag::AllocationTag getCurrentTag(); //!< Get the tag of the calling thread
+		static void setCurrentTag(const AllocationTag::AllocationTag tag); //!< Set the tag of the calling thread
+		static const char* toString(const AllocationTag::AllocationTag tag); //!< Get the name of a tag
+	};
+
+	/*! \class AllocationScope
+	* \brief Charges every allocation the calling thread makes to a tag until the scope ends
+	*/
+	class AllocationScope
+	{
+	private:
+		AllocationTag::AllocationTag m_previousTag; //!< The tag before the scope started
+	public:
+		AllocationScope(const AllocationTag::AllocationTag tag) : m_previousTag(AllocationTracker::getCurrentTag()) { AllocationTracker::setCurrentTag(tag); } //!< Constructor
+			/*!< \param tag a const AllocationTag::AllocationTag - The tag */
+		~AllocationScope() { AllocationTracker::setCurrentTag(m_previousTag); } //!< Destructor
+	};
+}
+#endif
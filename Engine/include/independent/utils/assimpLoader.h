@@ -22,10 +22,10 @@ namespace Engine
 	class AssimpLoader
 	{
 	private:
-		static void processNode(aiNode* node, const aiScene* scene, std::vector<Mesh3D>& meshes); //!< Process a node from Assimps' scene data structure
+		static void processNode(aiNode* node, const aiScene* scene, std::vector<Mesh3D>& meshes, std::vector<std::string>* materialNames); //!< Process a node from Assimps' scene data structure
 		static Mesh3D processMesh(aiMesh* mesh, const aiScene* scene); //!< Process mesh from Assimps' node's data structure
 	public:
-		static void loadModel(const std::string& filePath, std::vector<Mesh3D>& meshes); //!< Load a model's data into the meshes reference passed
+		static void loadModel(const std::string& filePath, std::vector<Mesh3D>& meshes, std::vector<std::string>* materialNames = nullptr); //!< Load a model's data into the meshes reference passed
 	};
 }
 #endif
\ No newline at end of file
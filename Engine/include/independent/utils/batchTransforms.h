@@ -0,0 +1,38 @@
+/*! \file batchTransforms.h
+*
+* \brief Math kernels which build and apply transforms for many objects at once, using SSE where it is available
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef BATCHTRANSFORMS_H
+#define BATCHTRANSFORMS_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \struct AABB
+	* \brief An axis aligned bounding box
+	*/
+	struct AABB
+	{
+		glm::vec3 Min; //!< The smallest corner
+		glm::vec3 Max; //!< The largest corner
+	};
+
+	/*! \class BatchTransforms
+	* \brief Composes model matrices, decomposes quads and transforms bounding boxes in bulk
+	*/
+	class BatchTransforms
+	{
+	public:
+		static glm::mat4 composeModelMatrix(const glm::vec3& position, const glm::vec3& orientation, const glm::vec3& scale); //!< Compose one model matrix
+		static void composeModelMatrices(const glm::vec3* positions, const glm::vec3* orientations, const glm::vec3* scales, glm::mat4* matrices, const uint32_t count); //!< Compose many model matrices
+		static void composeModelMatrices(const glm::vec3* positions, const glm::vec3& scale, glm::mat4* matrices, const uint32_t count); //!< Compose many model matrices without rotation and with a shared scale
+
+		static void decomposeQuad(const glm::mat4& matrix, glm::vec4& transform, glm::vec2& size); //!< Get the centre, depth, rotation and size of a unit quad
+		static void transformBounds(const glm::mat4* matrices, const AABB* localBounds, AABB* worldBounds, const uint32_t count); //!< Transform many bounding boxes
+	};
+}
+#endif
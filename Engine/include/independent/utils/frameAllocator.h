@@ -0,0 +1,148 @@
+/*! \file frameAllocator.h
+*
+* \brief Linear arenas for memory which only lives for a frame or a function, freed all at once instead of one allocation at a time
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef FRAMEALLOCATOR_H
+#define FRAMEALLOCATOR_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \class LinearArena
+	* \brief Hands out memory by moving a pointer forward, everything is freed at once when the arena is reset
+	*/
+	class LinearArena
+	{
+	private:
+		/*! \struct Block
+		* \brief A piece of heap memory the arena allocates from
+		*/
+		struct Block
+		{
+			char* memory; //!< The start of the block
+			size_t size; //!< The size of the block in bytes
+		};
+
+		std::vector<Block> m_blocks; //!< The blocks, kept until the arena is destroyed
+		size_t m_current; //!< The index of the block allocations are made from
+		size_t m_offset; //!< The number of bytes used in the current block
+		size_t m_used; //!< The number of bytes used in every block before the current one
+		size_t m_highWater; //!< The most bytes used since the arena was created
+
+		void nextBlock(const size_t minimumSize); //!< Move on to a block large enough for an allocation
+	public:
+		/*! \struct Marker
+		* \brief A position in the arena which it can be rewound to
+		*/
+		struct Marker
+		{
+			size_t block; //!< The index of the current block
+			size_t offset; //!< The offset in the current block
+			size_t used; //!< The bytes used in earlier blocks
+		};
+
+		static const size_t DefaultBlockSize = 64 * 1024; //!< The size of the first block
+
+		LinearArena(const size_t initialSize = DefaultBlockSize); //!< Constructor
+		~LinearArena(); //!< Destructor
+		LinearArena(const LinearArena&) = delete; //!< Arenas own their memory and cannot be copied
+		LinearArena& operator=(const LinearArena&) = delete; //!< Arenas own their memory and cannot be copied
+
+		void* allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)); //!< Allocate memory from the arena
+		void reset(); //!< Free everything allocated from the arena
+
+		Marker getMarker() const; //!< Get the current position
+		void rewind(const Marker& marker); //!< Free everything allocated since a position was taken
+
+		inline const size_t getUsed() const { return m_used + m_offset; } //!< Get the number of bytes in use
+			/*!< \return a const size_t - The number of bytes in use */
+		inline const size_t getHighWater() const { return m_highWater; } //!< Get the most bytes ever used at once
+			/*!< \return a const size_t - The most bytes used */
+	};
+
+	/*! \class ArenaAllocator
+	* \brief An STL allocator which allocates from a linear arena, freeing does nothing
+	*/
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T; //!< The type allocated
+		using propagate_on_container_move_assignment = std::true_type; //!< Moving a container moves its arena with it
+		using propagate_on_container_swap = std::true_type; //!< Swapping containers swaps their arenas
+
+		LinearArena* m_arena; //!< The arena memory comes from
+
+		ArenaAllocator(LinearArena& arena) : m_arena(&arena) {} //!< Constructor
+			/*!< \param arena a LinearArena& - The arena */
+		template<typename U> ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.m_arena) {} //!< Copy an allocator of another type
+			/*!< \param other a const ArenaAllocator<U>& - The other allocator */
+
+		inline T* allocate(const size_t count) { return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T))); } //!< Allocate memory for a number of elements
+			/*!< \param count a const size_t - The number of elements
+				 \return a T* - The memory */
+		inline void deallocate(T* memory, const size_t count) {} //!< Memory is only freed when the arena is reset
+			/*!< \param memory a T* - The memory
+				 \param count a const size_t - The number of elements */
+
+		template<typename U> inline bool operator==(const ArenaAllocator<U>& other) const { return m_arena == other.m_arena; } //!< Do both allocators use the same arena
+			/*!< \param other a const ArenaAllocator<U>& - The other allocator
+				 \return a bool - Do both allocators use the same arena */
+		template<typename U> inline bool operator!=(const ArenaAllocator<U>& other) const { return m_arena != other.m_arena; } //!< Do the allocators use different arenas
+			/*!< \param other a const ArenaAllocator<U>& - The other allocator
+				 \return a bool - Do the allocators use different arenas */
+	};
+
+	template<typename T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>; //!< A vector whose elements live in an arena
+
+	/*! \class FrameAllocator
+	* \brief Two arenas used on alternate frames, memory stays valid until the end of the frame after the one it was allocated in
+	*/
+	class FrameAllocator
+	{
+	private:
+		static std::array<LinearArena, 2>& getArenas(); //!< Get both arenas
+		static uint32_t s_current; //!< The index of the arena used this frame
+	public:
+		static LinearArena& getArena(); //!< Get this frame's arena
+		static void onFrameEnd(); //!< Swap arenas and reset the one which will be used next
+		static const char* copyString(const std::string& string); //!< Copy a string into this frame's arena
+
+		template<typename T> static inline ArenaVector<T> createVector() { return ArenaVector<T>(ArenaAllocator<T>(getArena())); } //!< Create an empty vector in this frame's arena
+			/*!< \return an ArenaVector<T> - The vector */
+	};
+
+	template<typename T>
+	using FrameVector = ArenaVector<T>; //!< A vector which lives until the end of the next frame
+
+	/*! \class ScratchArena
+	* \brief One arena per thread for temporary memory inside a function, rewound when the scope which used it ends
+	*/
+	class ScratchArena
+	{
+	private:
+		LinearArena::Marker m_marker; //!< Where the arena was when the scope started
+	public:
+		ScratchArena(); //!< Constructor
+		~ScratchArena(); //!< Destructor
+		ScratchArena(const ScratchArena&) = delete; //!< Scopes cannot be copied
+		ScratchArena& operator=(const ScratchArena&) = delete; //!< Scopes cannot be copied
+
+		static LinearArena& getArena(); //!< Get this thread's arena
+
+		template<typename T> inline ArenaVector<T> createVector(const size_t capacity = 0) //!< Create a vector in this thread's arena
+			/*!< \param capacity a const size_t - The number of elements to reserve
+				 \return an ArenaVector<T> - The vector */
+		{
+			ArenaVector<T> vector{ ArenaAllocator<T>(getArena()) };
+			vector.reserve(capacity);
+			return vector;
+		}
+	};
+}
+#endif
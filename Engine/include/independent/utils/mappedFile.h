@@ -0,0 +1,44 @@
+/*! \file mappedFile.h
+*
+* \brief A read only view of a whole file mapped into memory, pages are only read from disk when first touched
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \class MappedFile
+	* \brief Maps a file into memory for reading, the view stays valid until the file is closed
+	*/
+	class MappedFile
+	{
+	private:
+		const uint8_t* m_data; //!< The first byte of the file, null when nothing is mapped
+		uint64_t m_size; //!< The size of the file in bytes
+		void* m_fileHandle; //!< The operating system handle of the file
+		void* m_mappingHandle; //!< The operating system handle of the mapping
+	public:
+		MappedFile(); //!< Constructor
+		MappedFile(const std::string& filePath); //!< Constructor mapping a file
+		~MappedFile(); //!< Destructor
+
+		MappedFile(const MappedFile&) = delete; //!< Cannot copy a mapping
+		MappedFile& operator=(const MappedFile&) = delete; //!< Cannot copy a mapping
+
+		const bool open(const std::string& filePath); //!< Map a file, closing any file already mapped
+		void close(); //!< Unmap the file
+
+		inline const bool isOpen() const { return m_data != nullptr; } //!< Is a file mapped
+			/*!< \return a const bool - Is a file mapped */
+		inline const uint8_t* getData() const { return m_data; } //!< Get the mapped bytes
+			/*!< \return a const uint8_t* - The first byte of the file */
+		inline const uint64_t getSize() const { return m_size; } //!< Get the size of the mapped file
+			/*!< \return a const uint64_t - The size in bytes */
+	};
+}
+#endif
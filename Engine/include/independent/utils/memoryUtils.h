@@ -22,6 +22,7 @@ namespace Engine
 		static std::array<int16_t, 2> normalise(const glm::vec2& data); //!< Normalise a glm::vec2 to short
 		static uint32_t pack(const glm::vec4& data); //!< Pack a glm::vec4 into an uint_32t
 		static uint32_t pack(const glm::vec3& data); //!< Pack a glm::vec3 into an uint_32t
+		static uint64_t hash(const void* data, const size_t size, const uint64_t seed = 14695981039346656037ull); //!< Hash bytes, the same on every run and platform
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*! \file poolAllocator.h
+*
+* \brief A pool allocator which hands out fixed size blocks from large chunks, used for small objects which are created and deleted often
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+#include <mutex>
+#include "independent/core/common.h"
+
+namespace Engine
+{
+	/*! \class PoolAllocator
+	* \brief Keeps a free list per size class, blocks are carved from chunks and reused once freed
+	*/
+	class PoolAllocator
+	{
+	public:
+		static const uint32_t Granularity = 16; //!< The difference in bytes between size classes, also the alignment of every block
+		static const uint32_t MaxBlockSize = 512; //!< The largest block pooled, larger requests go to the heap
+		static const uint32_t BlocksPerChunk = 64; //!< The number of blocks allocated at once when a size class is empty
+		static const uint32_t ClassCount = MaxBlockSize / Granularity; //!< The number of size classes
+	private:
+		/*! \struct SizeClass
+		* \brief The free list and chunks of one block size
+		*/
+		struct SizeClass
+		{
+			std::mutex mutex; //!< Guards the free list
+			void* freeList = nullptr; //!< The first free block, each free block stores the next
+			std::vector<void*> chunks; //!< Every chunk allocated for this size class
+			uint32_t blocksInUse = 0; //!< The number of blocks handed out and not yet freed
+
+			~SizeClass(); //!< Destructor
+		};
+
+		static std::array<SizeClass, ClassCount>& getClasses(); //!< Get the size classes
+		static void addChunk(SizeClass& sizeClass, const uint32_t blockSize, const uint32_t blockCount); //!< Add a chunk of free blocks to a size class
+		static inline const uint32_t getClassIndex(const size_t size) { return static_cast<uint32_t>((size + Granularity - 1) / Granularity) - 1; } //!< Get the size class of a size
+			/*!< \param size a const size_t - The size in bytes, must be between 1 and MaxBlockSize
+				 \return a const uint32_t - The index of the size class */
+	public:
+		static void* allocate(const size_t size); //!< Allocate a block
+		static void deallocate(void* memory, const size_t size); //!< Free a block
+		static void reserve(const size_t size, const uint32_t count); //!< Make sure a number of blocks of a size can be handed out without growing
+		static const uint32_t getBlocksInUse(const size_t size); //!< Get the number of blocks of a size in use
+	};
+}
+#endif
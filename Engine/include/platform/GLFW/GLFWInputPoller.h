@@ -18,8 +18,6 @@ namespace Engine
 	class GLFWInputPoller 
 	{
 	public:
-		static std::vector<uint32_t> isAnyKeyPressed(); //!< Is any key pressed, returns list of all keys currently pressed
-		static std::vector<uint32_t> isAnyMouseButtonPressed(); //!< Is any mouse button pressed, returns list of all mouse buttons currently pressed
 		static bool isKeyPressed(const int32_t keyCode); //!< Is the key pressed
 		static bool isMousePressed(const int32_t mouseButton); //!< Is the mouse button pressed
 		static glm::vec2 getMousePosition(); //!< Get the current mouse position
@@ -18,26 +18,40 @@ namespace Engine
 	class OpenGLShaderProgram : public ShaderProgram
 	{
 	private:
-		uint32_t constructShaders(const int shaderType, const char* filePath); //!< Construct individual shader objects for the program
+		uint32_t constructShaders(const int shaderType, const std::string& source, const std::string& filePath); //!< Construct individual shader objects for the program
+		const bool loadBinary(const uint64_t key); //!< Load the linked program from the shader cache
+		void saveBinary(const uint64_t key); //!< Save the linked program to the shader cache
+		void reflect(); //!< Read the active uniforms and uniform blocks of the linked program and give samplers their texture units
 	public:
 		OpenGLShaderProgram(const std::string& shaderName); //!< Constructor
 		~OpenGLShaderProgram(); //!< Destructor
 
 		void build(VertexArray* vertexArray, const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath, const std::string& tessControlPath, const std::string& tessEvalPath) override; //!< Create a shader program based on the files passed
-		void setUniforms(const std::vector<std::string>& uniformNames) override; //!< Set all uniform locations
 		void setUniformBuffers(const std::unordered_map<std::string, UniformBuffer*>& uniformBuffers) override; //!< Set the uniform buffers used by this shader
 		void start() override; //!< Start the shader
 		void stop() override; //!< Stop using the shader
 		void destroy() override; //!< Destroy the shader
-		void sendInt(const std::string& uniformName, const int value) override; //!< Upload integer to shader
-		void sendIntArray(const std::string& uniformName, int32_t* values, const uint32_t count) override; //!< Upload an array of integers to shader
-		void sendBool(const std::string& uniformName, const bool value) override; //!< Upload bool to shader
-		void sendFloat(const std::string& uniformName, const float value) override; //!< Upload float to shader
-		void sendVec2(const std::string& uniformName, const glm::vec2& value) override; //!< Upload vec2 to shader
-		void sendVec3(const std::string& uniformName, const glm::vec3& value) override; //!< Upload vec3 to shader
-		void sendVec4(const std::string& uniformName, const glm::vec4& value) override; //!< Upload vec4 to shader
-		void sendMat3(const std::string& uniformName, const glm::mat3& mat) override; //!< Upload mat3 to shader
-		void sendMat4(const std::string& uniformName, const glm::mat4& mat) override; //!< Upload mat4 to shader
+
+		// The overloads by name are defined once in ShaderProgram and send through the handle overloads below
+		using ShaderProgram::sendInt;
+		using ShaderProgram::sendIntArray;
+		using ShaderProgram::sendBool;
+		using ShaderProgram::sendFloat;
+		using ShaderProgram::sendVec2;
+		using ShaderProgram::sendVec3;
+		using ShaderProgram::sendVec4;
+		using ShaderProgram::sendMat3;
+		using ShaderProgram::sendMat4;
+
+		void sendInt(const int32_t handle, const int value) override; //!< Upload integer to shader
+		void sendIntArray(const int32_t handle, int32_t* values, const uint32_t count) override; //!< Upload an array of integers to shader
+		void sendBool(const int32_t handle, const bool value) override; //!< Upload bool to shader
+		void sendFloat(const int32_t handle, const float value) override; //!< Upload float to shader
+		void sendVec2(const int32_t handle, const glm::vec2& value) override; //!< Upload vec2 to shader
+		void sendVec3(const int32_t handle, const glm::vec3& value) override; //!< Upload vec3 to shader
+		void sendVec4(const int32_t handle, const glm::vec4& value) override; //!< Upload vec4 to shader
+		void sendMat3(const int32_t handle, const glm::mat3& mat) override; //!< Upload mat3 to shader
+		void sendMat4(const int32_t handle, const glm::mat4& mat) override; //!< Upload mat4 to shader
 		void printDetails() override; //!< Print the resource details
 	};
 }
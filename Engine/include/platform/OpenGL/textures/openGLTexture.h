@@ -22,6 +22,7 @@ namespace Engine
 	public:
 		OpenGLTexture2D(const std::string& textureName, const char* filePath, TextureProperties& properties); //!< Constructor
 		OpenGLTexture2D(const std::string& textureName, const TextureProperties& properties, const uint32_t channels, unsigned char* data); //!< Constructor
+		OpenGLTexture2D(const std::string& textureName, const TextureProperties& properties, const TextureImage& image); //!< Constructor
 		~OpenGLTexture2D(); //!< Destructor
 		void edit(const uint32_t offsetX, const uint32_t offsetY, const uint32_t width, const uint32_t height, const unsigned char* data) override; //!< Edit the texture data
 		void bind(const uint32_t slot = 0) override; //!< Bind the texture to a texture unit
@@ -35,6 +36,7 @@ namespace Engine
 	{
 	public:
 		OpenGLCubeMapTexture(const std::string& textureName, const std::string& folderPath, const std::string& fileType); //!< Constructor
+		OpenGLCubeMapTexture(const std::string& textureName, const std::string& folderPath, const std::vector<TextureImage>& faces); //!< Constructor
 		~OpenGLCubeMapTexture(); //!< Destructor
 
 		void bind(const uint32_t slot = 0) override; //!< Bind the texture to a texture unit
@@ -7,6 +7,9 @@
 */
 #include "independent/core/application.h"
 #include "independent/systems/systemManager.h"
+#include "independent/utils/frameAllocator.h"
+#include "independent/utils/allocationTracker.h"
+#include "independent/rendering/materials/materialParameters.h"
 
 namespace Engine
 {
@@ -25,9 +28,12 @@ namespace Engine
 		SystemManager::addSystem(SystemType::Logger);
 		SystemManager::addSystem(SystemType::Randomiser);
 		SystemManager::addSystem(SystemType::TimerSystem);
+		SystemManager::addSystem(SystemType::Profiler);
+		SystemManager::addSystem(SystemType::CounterSystem);
 		SystemManager::addSystem(SystemType::WindowAPISystem);
 		SystemManager::addSystem(SystemType::WindowManager);
 		SystemManager::addSystem(SystemType::EventManager);
+		SystemManager::addSystem(SystemType::InputManager);
 		SystemManager::addSystem(SystemType::ResourceManager);
 		SystemManager::addSystem(SystemType::FontManager);
 		SystemManager::addSystem(SystemType::SceneManager);
@@ -74,6 +80,9 @@ namespace Engine
 			if (WindowManager::getFocusedWindow())
 				RenderSystem::onRender(scene);
 
+			// Delete every entity destroyed this frame in one batch
+			if (scene) scene->deleteDestroyedEntities();
+
 			// Destroy all scheduled scenes
 			SceneManager::destroyScheduledScenes();
 
@@ -81,6 +90,19 @@ namespace Engine
 			// This must be done at the end of the frame
 			WindowManager::deregisterScheduledWindows();
 
+			// Swap the frame arenas, memory from the frame before last is reused from here on
+			FrameAllocator::onFrameEnd();
+
+			// Every submission has been drawn, so their parameter blocks can go
+			MaterialParameterBuffer::onFrameEnd();
+
+			// Turn this frame's allocations into the allocation counters before the counters close the frame
+			AllocationTracker::onFrameEnd();
+
+			// Close the profiler's frame, this must come after all other work in the frame
+			Profiler::onFrameEnd();
+			CounterSystem::onFrameEnd(timestep);
+
 			// Check exit conditions
 			if (checkExitConditions())
 				Application::stop();
@@ -18,6 +18,9 @@ namespace Engine
 		m_offset = offset;
 		m_scaleSize = scale;
 		m_useAbsoluteSize = absolute;
+
+		// Follows the window size every frame
+		tick(TickGroup::Update);
 	}
 
 	UIElement::~UIElement()
@@ -23,6 +23,7 @@ namespace Engine
 		m_mouseSensitivity = 0.f;
 		m_movementSpeed = 0.f;
 		m_freeze = freeze;
+		m_body = InvalidBody;
 		setSpeed(speed);
 		setSensitivity(sensitivity);
 	}
@@ -40,6 +41,7 @@ namespace Engine
 	//! onDetach()
 	void CharacterController::onDetach()
 	{
+		disableCollision();
 	}
 
 	//! onUpdate()
@@ -123,6 +125,55 @@ namespace Engine
 		return m_mouseSensitivity;
 	}
 
+	//! enableCollision()
+	/*!
+	\param radius a const float - The radius of the capsule
+	\param height a const float - The height of the capsule from the entity's position upwards
+	\param followGround a const bool - Keep the entity on the terrain instead of only above it
+	*/
+	void CharacterController::enableCollision(const float radius, const float height, const bool followGround)
+	{
+		Entity* parent = getParent();
+
+		if (!parent || !parent->getParentScene())
+		{
+			ENGINE_ERROR("[CharacterController::enableCollision] This component does not have a valid parent entity in a scene. Component Name: {0}.", m_name);
+			return;
+		}
+
+		Transform* trans = parent->getComponent<Transform>();
+
+		if (!trans)
+		{
+			ENGINE_ERROR("[CharacterController::enableCollision] This character controller cannot detect a valid transform. Entity Name: {0}.", parent->getName());
+			return;
+		}
+
+		disableCollision();
+		m_body = parent->getParentScene()->getCollisionWorld()->addCapsule(trans->getWorldPosition(), radius, height, followGround, trans);
+	}
+
+	//! disableCollision()
+	void CharacterController::disableCollision()
+	{
+		if (m_body == InvalidBody) return;
+
+		Entity* parent = getParent();
+		if (parent && parent->getParentScene())
+			parent->getParentScene()->getCollisionWorld()->removeBody(m_body);
+
+		m_body = InvalidBody;
+	}
+
+	//! hasCollision()
+	/*!
+	\return a const bool - Does the controller collide
+	*/
+	const bool CharacterController::hasCollision() const
+	{
+		return m_body != InvalidBody;
+	}
+
 	//! move()
 	/*!
 	\param direction a const Movement - The direction to move
@@ -147,6 +198,20 @@ namespace Engine
 			{
 				float velocity = m_movementSpeed * deltaTime;
 
+				// A colliding controller asks its body to move, the scene moves the transform once collisions are resolved
+				if (m_body != InvalidBody)
+				{
+					const CameraData& camera = parent->getParentScene()->getMainCamera()->getCameraData();
+					glm::vec3 displacement(0.f);
+					if (direction == Movement::FORWARD) displacement = camera.Front * velocity;
+					if (direction == Movement::BACKWARD) displacement = -camera.Front * velocity;
+					if (direction == Movement::LEFT) displacement = -camera.Right * velocity;
+					if (direction == Movement::RIGHT) displacement = camera.Right * velocity;
+
+					parent->getParentScene()->getCollisionWorld()->moveBody(m_body, displacement);
+					return;
+				}
+
 				if (direction == Movement::FORWARD)
 					trans->setLocalPosition(trans->getWorldPosition() += getParent()->getParentScene()->getMainCamera()->getCameraData().Front * velocity);
 				if (direction == Movement::BACKWARD)
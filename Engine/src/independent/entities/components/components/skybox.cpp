@@ -18,7 +18,6 @@ namespace Engine
 	*/
 	Skybox::Skybox(Model3D* model, Material* material)
 	{
-		m_material = nullptr;
 		m_model = nullptr;
 		setModel(model);
 		setMaterial(material);
@@ -28,18 +27,18 @@ namespace Engine
 	Skybox::~Skybox()
 	{
 		ENGINE_TRACE("[Skybox::~Skybox] Deleting skybox.");
-		m_material = nullptr;
+		m_instance.setMaterial(nullptr);
 		m_model = nullptr;
 	}
 
 	//! onRender()
 	void Skybox::onRender()
 	{
-		if (m_material)
+		if (m_instance.getMaterial())
 		{
 			if (m_model)
 			{
-				Renderer3D::submit("Skybox", m_model->getMeshes().at(0).getGeometry(), m_material, glm::mat4(1.f));
+				Renderer3D::submit("Skybox", m_model->getMeshes().at(0).getGeometry(), m_instance.getMaterial(), glm::mat4(1.f), m_instance.getParameters());
 			}
 			else
 				ENGINE_ERROR("[Skybox::onRender] Cannot render as the model is invalid.");
@@ -67,7 +66,7 @@ namespace Engine
 	void Skybox::setMaterial(Material* material)
 	{
 		if (material)
-			m_material = material;
+			m_instance.setMaterial(material);
 		else
 			ENGINE_ERROR("[Skybox::setMaterial] Cannot set the material as it is invalid.");
 	}
@@ -87,6 +86,15 @@ namespace Engine
 	*/
 	Material* Skybox::getMaterial()
 	{
-		return m_material;
+		return m_instance.getMaterial();
+	}
+
+	//! getInstance()
+	/*
+	\return a MaterialInstance& - A reference to the material instance, its parameters are the sky's own
+	*/
+	MaterialInstance& Skybox::getInstance()
+	{
+		return m_instance;
 	}
 }
\ No newline at end of file
@@ -24,7 +24,7 @@ namespace Engine
 	//! ~MeshRender2D()
 	MeshRender2D::~MeshRender2D()
 	{
-		m_material = nullptr;
+		m_instance.setMaterial(nullptr);
 	}
 
 	//! onAttach()
@@ -60,7 +60,7 @@ namespace Engine
 		ENGINE_TRACE("==========================================");
 		ENGINE_TRACE("MeshRender2D Details for Entity: {0}", parent->getName());
 		ENGINE_TRACE("==========================================");
-		if(m_material) ENGINE_TRACE("Material Name: {0}.", m_material->getName());
+		if(m_instance.getMaterial()) ENGINE_TRACE("Material Name: {0}.", m_instance.getMaterial()->getName());
 		ENGINE_TRACE("==========================================");
 	}
 
@@ -71,7 +71,7 @@ namespace Engine
 	void MeshRender2D::setMaterial(Material* material)
 	{
 		if (material)
-			m_material = material;
+			m_instance.setMaterial(material);
 		else
 			ENGINE_ERROR("[MeshRender2D::setMaterial] An invalid material was provided.");
 	}
@@ -82,13 +82,23 @@ namespace Engine
 	*/
 	Material* MeshRender2D::getMaterial()
 	{
-		return m_material;
+		return m_instance.getMaterial();
+	}
+
+	//!	getInstance()
+	/*!
+	\return a MaterialInstance& - A reference to the material instance, its parameters are the entity's own
+	*/
+	MaterialInstance& MeshRender2D::getInstance()
+	{
+		return m_instance;
 	}
 
 	//! onRender()
 	void MeshRender2D::onRender()
 	{
-		if (m_material)
+		Material* material = m_instance.getMaterial();
+		if (material)
 		{
 			if (getParent()->containsComponent<Transform>())
 			{
@@ -97,7 +107,7 @@ namespace Engine
 					getParent()->getComponent<NativeScript>()->onSubmit(Renderers::Renderer2D, "Default");
 				}
 
-				Renderer2D::submit(m_material->getShader(), m_material->getSubTextures(), getParent()->getComponent<Transform>()->getModelMatrix(), m_material->getTint());
+				Renderer2D::submit(material->getShader(), material->getSubTextures(), getParent()->getComponent<Transform>()->getModelMatrix(), m_instance.getParameters());
 			}
 			else
 				ENGINE_ERROR("[MeshRender2D::onRender] The entity this mesh render is attached to does not have a valid transform.");
@@ -18,14 +18,14 @@ namespace Engine
 	\param material a Material* - A pointer to the material
 	*/
 	MeshRender3D::MeshRender3D(Model3D* model, Material* material) 
-		: EntityComponent(ComponentType::MeshRender3D), m_model(model), m_material(material)
+		: EntityComponent(ComponentType::MeshRender3D), m_model(model), m_instance(material)
 	{
 	}
 
 	//! ~MeshRender3D()
 	MeshRender3D::~MeshRender3D()
 	{
-		m_material = nullptr;
+		m_instance.setMaterial(nullptr);
 		m_model = nullptr;
 	}
 
@@ -63,7 +63,7 @@ namespace Engine
 		ENGINE_TRACE("MeshRender3D Details for Entity: {0}", parent->getName());
 		ENGINE_TRACE("==========================================");
 		if(m_model) ENGINE_TRACE("Model Name: {0}", m_model->getName());
-		if(m_material) ENGINE_TRACE("Material Name: {0}", m_material->getName());
+		if(m_instance.getMaterial()) ENGINE_TRACE("Material Name: {0}", m_instance.getMaterial()->getName());
 		ENGINE_TRACE("==========================================");
 	}
 
@@ -95,7 +95,7 @@ namespace Engine
 	void MeshRender3D::setMaterial(Material* material)
 	{
 		if (material)
-			m_material = material;
+			m_instance.setMaterial(material);
 		else
 			ENGINE_ERROR("[MeshRender3D::setMaterial] An invalid material was provided.");
 	}
@@ -106,7 +106,16 @@ namespace Engine
 	*/
 	Material* MeshRender3D::getMaterial()
 	{
-		return m_material;
+		return m_instance.getMaterial();
+	}
+
+	//!	getInstance()
+	/*!
+	\return a MaterialInstance& - A reference to the material instance, its parameters are the entity's own
+	*/
+	MaterialInstance& MeshRender3D::getInstance()
+	{
+		return m_instance;
 	}
 
 	//! onRender()
@@ -114,15 +123,34 @@ namespace Engine
 	{
 		if (getParent()->containsComponent<Transform>())
 		{
-			if (m_material)
+			Material* material = m_instance.getMaterial();
+			if (material)
 			{
 				if (getParent()->containsComponent<NativeScript>())
 				{
 					getParent()->getComponent<NativeScript>()->onSubmit(Renderers::Renderer3D, "Default");
 				}
 
-				for (auto& mesh : m_model->getMeshes())
-					Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), m_material, getParent()->getComponent<Transform>()->getModelMatrix());
+				Transform* transform = getParent()->getComponent<Transform>();
+				if (Renderer3D::hasCullPlane())
+				{
+					// The matrix is needed now to test the bounds against the clip plane
+					const glm::mat4 model = transform->getModelMatrix();
+					for (auto& mesh : m_model->getMeshes())
+					{
+						if (Renderer3D::isClipped(mesh.getGeometry(), model)) continue;
+						Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), material, model, m_instance.getParameters());
+					}
+				}
+				else
+				{
+					// Otherwise the renderer composes the matrix along with the rest of the batch
+					const glm::vec3 position = transform->getWorldPosition();
+					const glm::vec3 orientation = transform->getOrientation();
+					const glm::vec3 scale = transform->getScale();
+					for (auto& mesh : m_model->getMeshes())
+						Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), material, position, orientation, scale, m_instance.getParameters());
+				}
 			}
 			else
 			{
@@ -131,8 +159,26 @@ namespace Engine
 					getParent()->getComponent<NativeScript>()->onSubmit(Renderers::Renderer3D, "Default");
 				}
 
-				for (auto& mesh : m_model->getMeshes())
-					Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), mesh.getMaterial(), getParent()->getComponent<Transform>()->getModelMatrix());
+				Transform* transform = getParent()->getComponent<Transform>();
+				if (Renderer3D::hasCullPlane())
+				{
+					// The matrix is needed now to test the bounds against the clip plane
+					const glm::mat4 model = transform->getModelMatrix();
+					for (auto& mesh : m_model->getMeshes())
+					{
+						if (Renderer3D::isClipped(mesh.getGeometry(), model)) continue;
+						Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), mesh.getMaterial(), model, m_instance.getParameters(mesh.getMaterial()));
+					}
+				}
+				else
+				{
+					// Otherwise the renderer composes the matrix along with the rest of the batch
+					const glm::vec3 position = transform->getWorldPosition();
+					const glm::vec3 orientation = transform->getOrientation();
+					const glm::vec3 scale = transform->getScale();
+					for (auto& mesh : m_model->getMeshes())
+						Renderer3D::submit(getParent()->getName(), mesh.getGeometry(), mesh.getMaterial(), position, orientation, scale, m_instance.getParameters(mesh.getMaterial()));
+				}
 			}
 		}
 		else
@@ -6,16 +6,59 @@
 *
 */
 #include "independent/entities/components/nativeScript.h"
+#include "independent/systems/systems/eventManager.h"
 
 namespace Engine
 {
 	//! NativeScript()
-	NativeScript::NativeScript() : EntityComponent(ComponentType::NativeScript)
+	NativeScript::NativeScript() : EntityComponent(ComponentType::NativeScript), m_subscriptions(0)
 	{
 	}
 
 	//! ~NativeScript()
 	NativeScript::~NativeScript()
 	{
+		// Remove this script from all listener lists it was added to
+		for (uint32_t i = 0; i < EventTypeCount; i++)
+		{
+			if (m_subscriptions & (1 << i))
+				EventManager::unsubscribe(static_cast<EventType>(i), this);
+		}
+	}
+
+	//! subscribe()
+	/*!
+	\param type a const EventType - The event type
+	*/
+	void NativeScript::subscribe(const EventType type)
+	{
+		if (!isSubscribed(type))
+		{
+			m_subscriptions |= (1 << static_cast<uint32_t>(type));
+			EventManager::subscribe(type, this);
+		}
+	}
+
+	//! unsubscribe()
+	/*!
+	\param type a const EventType - The event type
+	*/
+	void NativeScript::unsubscribe(const EventType type)
+	{
+		if (isSubscribed(type))
+		{
+			m_subscriptions &= ~(1 << static_cast<uint32_t>(type));
+			EventManager::unsubscribe(type, this);
+		}
+	}
+
+	//! isSubscribed()
+	/*!
+	\param type a const EventType - The event type
+	\return a const bool - Is this script subscribed to the event type
+	*/
+	const bool NativeScript::isSubscribed(const EventType type) const
+	{
+		return (m_subscriptions & (1 << static_cast<uint32_t>(type))) != 0;
 	}
 }
\ No newline at end of file
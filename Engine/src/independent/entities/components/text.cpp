@@ -79,7 +79,11 @@ namespace Engine
 	*/
 	void Text::setText(const std::string& text)
 	{
+		// Scripts set the same text most frames, only a change needs laying out again
+		if (text == m_text) return;
+
 		m_text = text;
+		m_glyphRun.invalidate();
 	}
 
 	//! getText()
@@ -118,7 +122,10 @@ namespace Engine
 		Font* font = FontManager::getFont(fontName);
 
 		if (font)
+		{
+			if (fontName != m_font) m_glyphRun.invalidate();
 			m_font = fontName;
+		}
 		else
 			ENGINE_ERROR("[Text::setFont] An invalid font name was provided. Cannot set new font name.");
 	}
@@ -132,6 +139,18 @@ namespace Engine
 		return m_font;
 	}
 
+	//! getGlyphRun()
+	/*!
+	\return a GlyphRun& - The text laid out in its font
+	*/
+	GlyphRun& Text::getGlyphRun()
+	{
+		if (!m_glyphRun.isValid())
+			m_glyphRun.build(m_text, FontManager::getFont(m_font));
+
+		return m_glyphRun;
+	}
+
 	//! onRender()
 	void Text::onRender()
 	{
@@ -10,6 +10,7 @@
 #include "independent/entities/entity.h"
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/sceneManager.h"
+#include "independent/utils/batchTransforms.h"
 
 namespace Engine
 {
@@ -228,12 +229,6 @@ namespace Engine
 	glm::mat4 Transform::getModelMatrix()
 	{
 		// Order: Translate then Rotation then Scale
-		glm::mat4 model = glm::mat4(1.f);
-		model = glm::translate(model, getWorldPosition());
-		model = glm::rotate(model, glm::radians(getOrientation().x), glm::vec3(1.f, 0.f, 0.f));
-		model = glm::rotate(model, glm::radians(getOrientation().y), glm::vec3(0.f, 1.f, 0.f));
-		model = glm::rotate(model, glm::radians(getOrientation().z), glm::vec3(0.f, 0.f, 1.f));
-		model = glm::scale(model, getScale());
-		return model;
+		return BatchTransforms::composeModelMatrix(getWorldPosition(), getOrientation(), getScale());
 	}
 }
\ No newline at end of file
@@ -17,6 +17,8 @@ namespace Engine
 	Entity::Entity()
 	{
 		m_entityName = "";
+		m_handle = InvalidEntityHandle;
+		m_listIndex = UINT32_MAX;
 		m_parentScene = nullptr;
 		m_parentEntity = nullptr;
 		m_layer = nullptr;
@@ -29,6 +31,10 @@ namespace Engine
 	{
 		ENGINE_INFO("[Entity::~Entity] Deleting entity named: {0}", m_entityName);
 
+		// Children take themselves out of the list as they are deleted below
+		if (m_parentScene)
+			m_parentScene->removeFromEntityList(this);
+
 		for (auto& comp : m_components)
 		{
 			if (comp)
@@ -72,6 +78,24 @@ namespace Engine
 		m_entityName = entityName;
 	}
 
+	//! getHandle()
+	/*!
+	\return a const EntityHandle - The handle of the entity in its scene
+	*/
+	const EntityHandle Entity::getHandle() const
+	{
+		return m_handle;
+	}
+
+	//! setHandle()
+	/*!
+	\param handle a const EntityHandle - The handle of the entity in its scene
+	*/
+	void Entity::setHandle(const EntityHandle handle)
+	{
+		m_handle = handle;
+	}
+
 	//! onUpdate()
 	/*!
 	\param timestep a const float - The update time step
@@ -79,43 +103,17 @@ namespace Engine
 	*/
 	void Entity::onUpdate(const float timestep, const float totalTime)
 	{
-		// Delete any child entities that are scheuled to be deleted, can also update entities if entity is not to be deleted
-		for (auto it = m_childEntities.cbegin(); it != m_childEntities.cend(); )
+		// Queue any child entities that are scheduled to be deleted, components are updated by the tick scheduler
+		for (auto& child : m_childEntities)
 		{
 			// Check if entity is a valid entity
-			if (it->second)
+			if (child.second)
 			{
-				// Check if the entity is to be destroyed
-				if (it->second->getDestroyed())
-				{
-					// Do NOT delete the entity which contains the main camera
-					if (it->second == getParentScene()->getMainCamera()->getParent())
-					{
-						ENGINE_ERROR("[Entity::onUpdate] Cannot delete the entity when it contains the scene's main camera. Scene: {0}, Entity: {1}.", getParentScene()->getName(), it->second->getName());
-						it->second->undestroy();
-						return;
-					}
-
-					// Check for validness again and then delete
-					if (it->second) delete it->second;
-					m_childEntities.erase(it++);
-					getParentScene()->setEntityListUpdated(true);
-				}
+				// The scene deletes every destroyed entity together at the end of the frame
+				if (child.second->getDestroyed())
+					getParentScene()->queueDestroyedEntity(child.second);
 				else
-				{
-					// Entity is not to be deleted, update components
-					if (it->second)
-					{
-						it->second->onUpdate(timestep, totalTime);
-						for (auto& component : it->second->getAllComponents())
-						{
-							// Check if component is valid
-							if (component)
-								component->onUpdate(timestep, totalTime);
-						}
-						++it;
-					}
-				}
+					child.second->onUpdate(timestep, totalTime);
 			}
 		}
 	}
@@ -323,7 +321,7 @@ namespace Engine
 			entity->setParentScene(getParentScene());
 			entity->setParentEntity(this);
 			entity->setName(childName);
-			getParentScene()->setEntityListUpdated(true);
+			getParentScene()->addToEntityList(entity);
 			return true;
 		}
 		else
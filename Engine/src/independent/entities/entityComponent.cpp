@@ -17,6 +17,7 @@ namespace Engine
 	*/
 	EntityComponent::EntityComponent(const ComponentType type) : m_componentType(type), m_parentEntity(0)
 	{
+		m_tickGroups = 0;
 	}
 
 	//! ~EntityComponent()
@@ -26,6 +27,13 @@ namespace Engine
 			ENGINE_TRACE("[EntityComponent::~EntityComponent] Deleting entity component: {0} attached to entity: {1}.", m_name, m_parentEntity->getName());
 		else
 			ENGINE_TRACE("[EntityComponent::~EntityComponent] Deleting entity component: {0}.", m_name);
+
+		// Remove this component from all tick groups it was added to
+		for (uint32_t i = 0; i < TickGroupCount; i++)
+		{
+			if (m_tickGroups & (1 << i))
+				TickScheduler::remove(this, static_cast<TickGroup>(i));
+		}
 	}
 
 	//! detach()
@@ -90,4 +98,51 @@ namespace Engine
 	{
 		return m_componentType;
 	}
+
+	//! tick()
+	/*!
+	\param group a const TickGroup - The tick group
+	\param interval a const float - The seconds between updates, TickRate::EveryFrame or TickRate::OnDemand
+	\param threadSafe a const bool - Can this component be updated on another thread, it must only change its own state
+	*/
+	void EntityComponent::tick(const TickGroup group, const float interval, const bool threadSafe)
+	{
+		m_tickGroups |= (1 << static_cast<uint32_t>(group));
+		TickScheduler::add(this, group, interval, threadSafe);
+	}
+
+	//! untick()
+	/*!
+	\param group a const TickGroup - The tick group
+	*/
+	void EntityComponent::untick(const TickGroup group)
+	{
+		if (isTicking(group))
+		{
+			m_tickGroups &= ~(1 << static_cast<uint32_t>(group));
+			TickScheduler::remove(this, group);
+		}
+	}
+
+	//! requestTick()
+	/*!
+	\param group a const TickGroup - The tick group
+	*/
+	void EntityComponent::requestTick(const TickGroup group)
+	{
+		if (isTicking(group))
+			TickScheduler::request(this, group);
+		else
+			ENGINE_ERROR("[EntityComponent::requestTick] The component is not in this tick group. Component Name: {0}.", m_name);
+	}
+
+	//! isTicking()
+	/*!
+	\param group a const TickGroup - The tick group
+	\return a const bool - Is this component updated in the tick group
+	*/
+	const bool EntityComponent::isTicking(const TickGroup group) const
+	{
+		return (m_tickGroups & (1 << static_cast<uint32_t>(group))) != 0;
+	}
 }
\ No newline at end of file
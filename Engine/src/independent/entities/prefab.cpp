@@ -0,0 +1,134 @@
+/*! \file prefab.cpp
+*
+* \brief A prefab is an entity template which is built once and instantiated many times
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/entities/prefab.h"
+#include "independent/systems/components/scene.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	//! Prefab()
+	/*!
+	\param layerName a const std::string& - The layer every instance is put on
+	\param display a const bool - Should instances be displayed
+	*/
+	Prefab::Prefab(const std::string& layerName, const bool display) : m_layerName(layerName), m_display(display)
+	{
+	}
+
+	//! attachComponents()
+	/*!
+	\param entity an Entity* - The entity
+	\param position a const glm::vec3* - The position of the instance, nullptr to keep the template's position
+	*/
+	void Prefab::attachComponents(Entity* entity, const glm::vec3* position) const
+	{
+		// The template can only hold one component of each class, so the attach checks are not needed
+		entity->m_components.reserve(m_components.size());
+		for (auto& componentTemplate : m_components)
+		{
+			EntityComponent* component = componentTemplate.create();
+			component->setName(componentTemplate.name);
+			component->setParent(entity);
+			entity->m_components.emplace_back(component);
+
+			if (position && componentTemplate.type == std::type_index(typeid(Transform)))
+				static_cast<Transform*>(component)->setLocalPosition(*position);
+
+			component->onAttach();
+		}
+	}
+
+	//! createInstances()
+	/*!
+	\param scene a Scene* - The scene to add the instances to
+	\param count a const uint32_t - The number of instances
+	\param positions a const glm::vec3* - The position of each instance, nullptr to keep the template's position
+	\return a std::vector<EntityHandle> - The handles of the instances
+	*/
+	std::vector<EntityHandle> Prefab::createInstances(Scene* scene, const uint32_t count, const glm::vec3* positions) const
+	{
+		std::vector<EntityHandle> handles;
+
+		if (!scene)
+		{
+			ENGINE_ERROR("[Prefab::createInstances] Cannot create instances because the scene is invalid.");
+			return handles;
+		}
+
+		Layer* layer = scene->getLayerManager()->getLayer(m_layerName);
+		if (!layer)
+			ENGINE_ERROR("[Prefab::createInstances] The prefab's layer does not exist in this scene. Scene: {0}, Layer: {1}.", scene->getName(), m_layerName);
+
+		// Grow the component pools once for the whole batch
+		for (auto& componentTemplate : m_components)
+			PoolAllocator::reserve(componentTemplate.size, count);
+
+		std::vector<Entity*> entities;
+		entities.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+			entities.push_back(new Entity);
+
+		// The scene's entity list is invalidated once, not once per instance
+		scene->addEntities(entities);
+
+		handles.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Entity* entity = entities[i];
+			if (layer) entity->setLayer(layer);
+			entity->setDisplay(m_display);
+			attachComponents(entity, positions ? &positions[i] : nullptr);
+			handles.push_back(entity->getHandle());
+		}
+
+		return handles;
+	}
+
+	//! instantiate()
+	/*!
+	\param scene a Scene* - The scene to add the instance to
+	\param position a const glm::vec3& - The position of the instance
+	\return an EntityHandle - The handle of the instance
+	*/
+	EntityHandle Prefab::instantiate(Scene* scene, const glm::vec3& position) const
+	{
+		std::vector<EntityHandle> handles = createInstances(scene, 1, &position);
+		return handles.empty() ? InvalidEntityHandle : handles.front();
+	}
+
+	//! instantiate()
+	/*!
+	\param scene a Scene* - The scene to add the instances to
+	\param positions a const std::vector<glm::vec3>& - The position of each instance
+	\return a std::vector<EntityHandle> - The handles of the instances
+	*/
+	std::vector<EntityHandle> Prefab::instantiate(Scene* scene, const std::vector<glm::vec3>& positions) const
+	{
+		return createInstances(scene, static_cast<uint32_t>(positions.size()), positions.data());
+	}
+
+	//! instantiate()
+	/*!
+	\param scene a Scene* - The scene to add the instances to
+	\param count a const uint32_t - The number of instances
+	\return a std::vector<EntityHandle> - The handles of the instances
+	*/
+	std::vector<EntityHandle> Prefab::instantiate(Scene* scene, const uint32_t count) const
+	{
+		return createInstances(scene, count, nullptr);
+	}
+
+	//! getComponentCount()
+	/*!
+	\return a const uint32_t - The number of components each instance has
+	*/
+	const uint32_t Prefab::getComponentCount() const
+	{
+		return static_cast<uint32_t>(m_components.size());
+	}
+}
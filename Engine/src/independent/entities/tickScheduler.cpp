@@ -0,0 +1,218 @@
+/*! \file tickScheduler.cpp
+*
+* \brief Keeps the components which asked to be updated, so a frame only visits the ones with work to do
+*
+* \author Daniel Bullin
+*
+*/
+#include <future>
+#include <thread>
+#include "independent/entities/tickScheduler.h"
+#include "independent/entities/entity.h"
+#include "independent/entities/components/nativeScript.h"
+#include "independent/systems/components/scene.h"
+#include "independent/systems/systems/log.h"
+#include "independent/utils/frameAllocator.h"
+
+namespace Engine
+{
+	std::array<std::vector<TickEntry>, TickGroupCount> TickScheduler::s_ticks; //!< Initialise empty groups
+	std::array<bool, TickGroupCount> TickScheduler::s_dirty = { false, false, false }; //!< Nothing to clear out
+	uint32_t TickScheduler::s_runDepth = 0; //!< Set to 0
+
+	//! tickComponent()
+	/*!
+	\param component an EntityComponent* - The component
+	\param group a const TickGroup - The group being run
+	\param timestep a const float - The time since the component last ticked
+	\param totalTime a const float - The total time of the application
+	*/
+	void TickScheduler::tickComponent(EntityComponent* component, const TickGroup group, const float timestep, const float totalTime)
+	{
+		switch (group)
+		{
+			case TickGroup::PreUpdate:
+				static_cast<NativeScript*>(component)->onPreUpdate(timestep, totalTime);
+				break;
+			case TickGroup::Update:
+				component->onUpdate(timestep, totalTime);
+				break;
+			case TickGroup::PostUpdate:
+				static_cast<NativeScript*>(component)->onPostUpdate(timestep, totalTime);
+				break;
+		}
+	}
+
+	//! compact()
+	/*!
+	\param group a const TickGroup - The group
+	*/
+	void TickScheduler::compact(const TickGroup group)
+	{
+		std::vector<TickEntry>& ticks = s_ticks[static_cast<uint32_t>(group)];
+		ticks.erase(std::remove_if(ticks.begin(), ticks.end(), [](const TickEntry& entry) { return entry.Component == nullptr; }), ticks.end());
+		s_dirty[static_cast<uint32_t>(group)] = false;
+	}
+
+	//! add()
+	/*!
+	\param component an EntityComponent* - The component
+	\param group a const TickGroup - The group
+	\param interval a const float - The seconds between ticks, TickRate::EveryFrame or TickRate::OnDemand
+	\param threadSafe a const bool - Can the component tick on another thread while other thread safe components tick
+	*/
+	void TickScheduler::add(EntityComponent* component, const TickGroup group, const float interval, const bool threadSafe)
+	{
+		if (!component) return;
+
+		if (group != TickGroup::Update && component->getComponentType() != ComponentType::NativeScript)
+		{
+			ENGINE_ERROR("[TickScheduler::add] Only scripts can tick before or after the update. Component Name: {0}.", component->getName());
+			return;
+		}
+
+		std::vector<TickEntry>& ticks = s_ticks[static_cast<uint32_t>(group)];
+		for (auto& entry : ticks)
+		{
+			// Registering again changes the rate
+			if (entry.Component == component)
+			{
+				entry.Interval = interval;
+				entry.ThreadSafe = threadSafe;
+				return;
+			}
+		}
+
+		ticks.push_back({ component, interval, 0.f, threadSafe, false });
+	}
+
+	//! remove()
+	/*!
+	\param component an EntityComponent* - The component
+	\param group a const TickGroup - The group
+	*/
+	void TickScheduler::remove(EntityComponent* component, const TickGroup group)
+	{
+		const uint32_t index = static_cast<uint32_t>(group);
+		std::vector<TickEntry>& ticks = s_ticks[index];
+		auto it = std::find_if(ticks.begin(), ticks.end(), [component](const TickEntry& entry) { return entry.Component == component; });
+
+		if (it != ticks.end())
+		{
+			// Cannot erase while a group is being walked, so clear the entry and remove it once the run has finished
+			if (s_runDepth > 0)
+			{
+				it->Component = nullptr;
+				s_dirty[index] = true;
+			}
+			else
+				ticks.erase(it);
+		}
+	}
+
+	//! request()
+	/*!
+	\param component an EntityComponent* - The component
+	\param group a const TickGroup - The group
+	*/
+	void TickScheduler::request(EntityComponent* component, const TickGroup group)
+	{
+		for (auto& entry : s_ticks[static_cast<uint32_t>(group)])
+		{
+			if (entry.Component == component)
+			{
+				entry.Requested = true;
+				return;
+			}
+		}
+	}
+
+	//! run()
+	/*!
+	\param group a const TickGroup - The group
+	\param scene a Scene* - The scene whose components tick
+	\param timestep a const float - The time since the last frame
+	\param totalTime a const float - The total time of the application
+	*/
+	void TickScheduler::run(const TickGroup group, Scene* scene, const float timestep, const float totalTime)
+	{
+		if (!scene) return;
+
+		const uint32_t index = static_cast<uint32_t>(group);
+		std::vector<TickEntry>& ticks = s_ticks[index];
+
+		ScratchArena scratch;
+		auto parallel = scratch.createVector<std::pair<EntityComponent*, float>>();
+
+		// Components may register or remove themselves while ticking, so only walk the entries present when the run started
+		// and index into the list each time as it may grow
+		s_runDepth++;
+
+		const size_t tickCount = ticks.size();
+		for (size_t i = 0; i < tickCount; i++)
+		{
+			EntityComponent* component = ticks[i].Component;
+			if (!component) continue;
+
+			// Components of other scenes, destroyed entities and inactive layers do not tick and do not build up time
+			Entity* entity = component->getParent();
+			if (!entity || entity->getParentScene() != scene || entity->getDestroyed() || !entity->getLayer() || !entity->getLayer()->getActive())
+				continue;
+
+			TickEntry& entry = ticks[i];
+			entry.Elapsed += timestep;
+			const bool due = entry.Requested || (entry.Interval >= 0.f && entry.Elapsed >= entry.Interval);
+			if (!due) continue;
+
+			// A reduced rate component is told the time since its last tick
+			const float elapsed = entry.Elapsed;
+			entry.Elapsed = 0.f;
+			entry.Requested = false;
+
+			if (entry.ThreadSafe)
+				parallel.push_back({ component, elapsed });
+			else
+				tickComponent(component, group, elapsed, totalTime);
+		}
+
+		// Thread safe components only touch their own state, so they tick together once everything else in the group has
+		const uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), static_cast<uint32_t>(parallel.size()));
+		if (parallel.size() < ParallelTickCount || threadCount < 2)
+		{
+			for (auto& tick : parallel)
+				tickComponent(tick.first, group, tick.second, totalTime);
+		}
+		else
+		{
+			auto tickEvery = [&parallel, group, totalTime, threadCount](const uint32_t first)
+			{
+				for (size_t i = first; i < parallel.size(); i += threadCount)
+					tickComponent(parallel[i].first, group, parallel[i].second, totalTime);
+			};
+
+			std::vector<std::future<void>> workers;
+			workers.reserve(threadCount - 1);
+			for (uint32_t i = 1; i < threadCount; i++)
+				workers.push_back(std::async(std::launch::async, tickEvery, i));
+
+			tickEvery(0);
+			for (auto& worker : workers)
+				worker.wait();
+		}
+
+		s_runDepth--;
+
+		if (s_runDepth == 0 && s_dirty[index])
+			compact(group);
+	}
+
+	//! getTickCount()
+	/*!
+	\param group a const TickGroup - The group
+	\return a const uint32_t - The number of components registered in the group
+	*/
+	const uint32_t TickScheduler::getTickCount(const TickGroup group)
+	{
+		return static_cast<uint32_t>(s_ticks[static_cast<uint32_t>(group)].size());
+	}
+}
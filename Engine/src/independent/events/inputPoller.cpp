@@ -33,24 +33,6 @@ namespace Engine
 
 #ifdef NG_PLATFORM_WINDOWS
 
-	//! isAnyKeyPressed()
-	/*!
-	\return a std::vector<uint32_t> - A list of all keys currently pressed
-	*/
-	std::vector<uint32_t> InputPoller::isAnyKeyPressed()
-	{
-		return GLFWInputPoller::isAnyKeyPressed();
-	}
-
-	//! isAnyMouseButtonPressed()
-	/*!
-	\return a std::vector<uint32_t> - A list of all mouse buttons currently pressed
-	*/
-	std::vector<uint32_t> InputPoller::isAnyMouseButtonPressed()
-	{
-		return GLFWInputPoller::isAnyMouseButtonPressed();
-	}
-
 	//! isKeyPressed()
 	/*!
 	\param keyCode a const int32_t - The key pressed
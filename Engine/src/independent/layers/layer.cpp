@@ -9,6 +9,7 @@
 #include "independent/layers/layerManager.h"
 #include "independent/systems/components/scene.h"
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/eventManager.h"
 
 namespace Engine
 {
@@ -16,7 +17,7 @@ namespace Engine
 	/*!
 	\param layerName a const char* - The layer name
 	*/
-	Layer::Layer(const char* layerName) : m_layerName(layerName), m_display(true), m_active(true), m_layerManager(nullptr)
+	Layer::Layer(const char* layerName) : m_layerName(layerName), m_display(true), m_active(true), m_layerManager(nullptr), m_subscriptions(0)
 	{
 	}
 
@@ -30,6 +31,49 @@ namespace Engine
 		}
 		else
 			ENGINE_INFO("[Layer::~Layer] Deleting layer named: {0}.", m_layerName);
+
+		// Remove this layer from all listener lists it was added to
+		for (uint32_t i = 0; i < EventTypeCount; i++)
+		{
+			if (m_subscriptions & (1 << i))
+				EventManager::unsubscribe(static_cast<EventType>(i), this);
+		}
+	}
+
+	//! subscribe()
+	/*!
+	\param type a const EventType - The event type
+	*/
+	void Layer::subscribe(const EventType type)
+	{
+		if (!isSubscribed(type))
+		{
+			m_subscriptions |= (1 << static_cast<uint32_t>(type));
+			EventManager::subscribe(type, this);
+		}
+	}
+
+	//! unsubscribe()
+	/*!
+	\param type a const EventType - The event type
+	*/
+	void Layer::unsubscribe(const EventType type)
+	{
+		if (isSubscribed(type))
+		{
+			m_subscriptions &= ~(1 << static_cast<uint32_t>(type));
+			EventManager::unsubscribe(type, this);
+		}
+	}
+
+	//! isSubscribed()
+	/*!
+	\param type a const EventType - The event type
+	\return a const bool - Is this layer subscribed to the event type
+	*/
+	const bool Layer::isSubscribed(const EventType type) const
+	{
+		return (m_subscriptions & (1 << static_cast<uint32_t>(type))) != 0;
 	}
 
 	//! printLayerDetails()
@@ -112,11 +156,11 @@ namespace Engine
 
 	//! getEntities()
 	/*!
-	\return a std::vector<Entity*> - A list of all entities on this layer
+	\return a FrameVector<Entity*> - A list of all entities on this layer
 	*/
-	std::vector<Entity*> Layer::getEntities()
+	FrameVector<Entity*> Layer::getEntities()
 	{
-		std::vector<Entity*> list;
+		FrameVector<Entity*> list = FrameAllocator::createVector<Entity*>();
 
 		// Go through all the entities
 		for (auto& entity : getLayerManager()->getParentScene()->getEntities())
@@ -133,11 +177,11 @@ namespace Engine
 
 	//! getRenderableEntities()
 	/*!
-	\return a std::vector<Entity*> - A list of all renderable entities on this layer
+	\return a FrameVector<Entity*> - A list of all renderable entities on this layer
 	*/
-	std::vector<Entity*> Layer::getRenderableEntities()
+	FrameVector<Entity*> Layer::getRenderableEntities()
 	{
-		std::vector<Entity*> list;
+		FrameVector<Entity*> list = FrameAllocator::createVector<Entity*>();
 
 		// Go through all the entities
 		for (auto& entity : getLayerManager()->getParentScene()->getEntities())
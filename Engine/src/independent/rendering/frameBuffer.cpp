@@ -18,6 +18,7 @@ namespace Engine
 	*/
 	FrameBuffer::FrameBuffer(const std::string& frameBufferName) : Resource(frameBufferName, ResourceType::FrameBuffer)
 	{
+		m_sceneScale = 1.f;
 	}
 
 	//! ~FrameBuffer()
@@ -25,6 +26,16 @@ namespace Engine
 	{
 	}
 
+	//! getScaledSize()
+	/*!
+	\param sceneSize a const glm::ivec2& - The size of the scene view
+	\return a glm::ivec2 - The size of the framebuffer, never less than a pixel along each axis
+	*/
+	glm::ivec2 FrameBuffer::getScaledSize(const glm::ivec2& sceneSize) const
+	{
+		return glm::max(glm::ivec2(glm::vec2(sceneSize) * m_sceneScale), glm::ivec2(1));
+	}
+
 	//! create()
 	/*!
 	\param frameBufferName a const std::string& - The name of the framebuffer
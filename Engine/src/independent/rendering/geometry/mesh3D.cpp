@@ -6,6 +6,7 @@
 *
 */
 #include "independent/rendering/geometry/mesh3D.h"
+#include "independent/utils/mappedFile.h"
 #include "independent/systems/systems/log.h"
 
 namespace Engine
@@ -14,7 +15,7 @@ namespace Engine
 	/*!
 	\param geometry a const Geometry3D& - A reference to the geometry data
 	*/
-	Mesh3D::Mesh3D(const Geometry3D& geometry) : m_geometry(geometry)
+	Mesh3D::Mesh3D(const Geometry3D& geometry) : m_geometry(geometry), m_mappedVertices(nullptr), m_mappedIndices(nullptr), m_mappedVertexCount(0), m_mappedIndexCount(0)
 	{
 	}
 
@@ -23,7 +24,8 @@ namespace Engine
 	\param vertices a std::vector<Vertex3D>& - A list of vertices
 	\param indices a std::vector<uint32_t>& - A list of indices
 	*/
-	Mesh3D::Mesh3D(std::vector<Vertex3D>& vertices, std::vector<uint32_t> indices) : m_vertices(vertices), m_indices(indices)
+	Mesh3D::Mesh3D(std::vector<Vertex3D>& vertices, std::vector<uint32_t> indices) : m_vertices(vertices), m_indices(indices), m_mappedVertices(nullptr),
+		m_mappedIndices(nullptr), m_mappedVertexCount(0), m_mappedIndexCount(0)
 	{
 	}
 
@@ -88,4 +90,71 @@ namespace Engine
 	{
 		return m_indices;
 	}
+
+	//! setMappedData()
+	/*!
+	\param file a const Shared<MappedFile>& - The mapped file, kept open until the data is released
+	\param vertices a const Vertex3D* - The first vertex of the mesh in the file
+	\param vertexCount a const uint32_t - The number of vertices
+	\param indices a const uint32_t* - The first index of the mesh in the file
+	\param indexCount a const uint32_t - The number of indices
+	*/
+	void Mesh3D::setMappedData(const Shared<MappedFile>& file, const Vertex3D* vertices, const uint32_t vertexCount, const uint32_t* indices, const uint32_t indexCount)
+	{
+		m_vertices.clear();
+		m_indices.clear();
+		m_mappedFile = file;
+		m_mappedVertices = vertices;
+		m_mappedIndices = indices;
+		m_mappedVertexCount = vertexCount;
+		m_mappedIndexCount = indexCount;
+	}
+
+	//! getVertexData()
+	/*!
+	\return a const Vertex3D* - The mapped vertices if there are any, otherwise the vertex list
+	*/
+	const Vertex3D* Mesh3D::getVertexData() const
+	{
+		return m_mappedFile ? m_mappedVertices : m_vertices.data();
+	}
+
+	//! getVertexCount()
+	/*!
+	\return a const uint32_t - The number of vertices getVertexData() points to
+	*/
+	const uint32_t Mesh3D::getVertexCount() const
+	{
+		return m_mappedFile ? m_mappedVertexCount : static_cast<uint32_t>(m_vertices.size());
+	}
+
+	//! getIndexData()
+	/*!
+	\return a const uint32_t* - The mapped indices if there are any, otherwise the index list
+	*/
+	const uint32_t* Mesh3D::getIndexData() const
+	{
+		return m_mappedFile ? m_mappedIndices : m_indices.data();
+	}
+
+	//! getIndexCount()
+	/*!
+	\return a const uint32_t - The number of indices getIndexData() points to
+	*/
+	const uint32_t Mesh3D::getIndexCount() const
+	{
+		return m_mappedFile ? m_mappedIndexCount : static_cast<uint32_t>(m_indices.size());
+	}
+
+	//! releaseData()
+	void Mesh3D::releaseData()
+	{
+		m_vertices.clear();
+		m_indices.clear();
+		m_mappedFile.reset();
+		m_mappedVertices = nullptr;
+		m_mappedIndices = nullptr;
+		m_mappedVertexCount = 0;
+		m_mappedIndexCount = 0;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,583 @@
+/*! \file meshCooker.cpp
+*
+* \brief Cooks models read by assimp into a binary file of ready to upload vertices and indices
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include "independent/rendering/geometry/meshCooker.h"
+#include "independent/rendering/geometry/meshOptimiser.h"
+#include "independent/utils/assimpLoader.h"
+#include "independent/utils/mappedFile.h"
+#include "independent/utils/memoryUtils.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	namespace
+	{
+		//! align()
+		/*!
+		\param offset a const uint64_t - The offset
+		\return a const uint64_t - The offset rounded up to a multiple of eight
+		*/
+		const uint64_t align(const uint64_t offset)
+		{
+			return (offset + 7) & ~static_cast<uint64_t>(7);
+		}
+
+		//! toFraction()
+		/*!
+		\param value a const float - The value
+		\param min a const float - The smallest value in the range
+		\param max a const float - The largest value in the range
+		\return a const uint16_t - The value as a fraction of the range
+		*/
+		const uint16_t toFraction(const float value, const float min, const float max)
+		{
+			if (max <= min) return 0;
+			return static_cast<uint16_t>(glm::clamp((value - min) / (max - min), 0.f, 1.f) * 65535.f + 0.5f);
+		}
+
+		//! fromFraction()
+		/*!
+		\param value a const uint16_t - The value as a fraction of the range
+		\param min a const float - The smallest value in the range
+		\param max a const float - The largest value in the range
+		\return a const float - The value
+		*/
+		const float fromFraction(const uint16_t value, const float min, const float max)
+		{
+			return min + (max - min) * (static_cast<float>(value) / 65535.f);
+		}
+
+		//! getSourceStamp()
+		/*!
+		\param filePath a const std::string& - The model file
+		\param size a uint64_t& - The size of the file
+		\param time an int64_t& - The write time of the file
+		\return a const bool - Was the file found
+		*/
+		const bool getSourceStamp(const std::string& filePath, uint64_t& size, int64_t& time)
+		{
+			std::error_code error;
+			size = static_cast<uint64_t>(std::filesystem::file_size(filePath, error));
+			time = static_cast<int64_t>(std::filesystem::last_write_time(filePath, error).time_since_epoch().count());
+			return !error;
+		}
+
+		//! readHeader()
+		/*!
+		\param file a const MappedFile& - The mapped cooked file
+		\param header a CookedMeshHeader& - The header of the file
+		\param sourceSize a const uint64_t - The size of the model file, the cooked file is only read if it matches, 0 to read any
+		\param sourceTime a const int64_t - The write time of the model file, the cooked file is only read if it matches, 0 to read any
+		\return a const bool - Is the file a valid cooked mesh of the model, with every table, submesh and name inside it
+		*/
+		const bool readHeader(const MappedFile& file, CookedMeshHeader& header, const uint64_t sourceSize, const int64_t sourceTime)
+		{
+			if (file.getSize() < sizeof(CookedMeshHeader)) return false;
+
+			const uint8_t* data = file.getData();
+			memcpy(&header, data, sizeof(CookedMeshHeader));
+			if (header.magic != CookedMeshFormat::Magic || header.version != CookedMeshFormat::Version) return false;
+			if ((sourceSize || sourceTime) && (header.sourceSize != sourceSize || header.sourceTime != sourceTime)) return false;
+
+			const bool quantised = (header.flags & CookedMeshFormat::Quantised) != 0;
+			if (header.vertexSize != (quantised ? sizeof(QuantisedVertex3D) : sizeof(Vertex3D))) return false;
+
+			// Every table must lie inside the file before anything is read from it
+			const uint64_t submeshOffset = sizeof(CookedMeshHeader);
+			const uint64_t materialOffset = submeshOffset + static_cast<uint64_t>(header.submeshCount) * sizeof(CookedSubmesh);
+			if (header.submeshCount == 0 || materialOffset + static_cast<uint64_t>(header.materialCount) * sizeof(CookedMaterial) > header.namesOffset) return false;
+			if (header.namesOffset > header.vertexOffset || header.vertexOffset + static_cast<uint64_t>(header.vertexCount) * header.vertexSize > header.indexOffset) return false;
+			const uint64_t indexSize = (header.flags & CookedMeshFormat::ShortIndices) ? sizeof(uint16_t) : sizeof(uint32_t);
+			if (header.indexOffset + static_cast<uint64_t>(header.indexCount) * indexSize != file.getSize()) return false;
+
+			for (uint32_t i = 0; i < header.submeshCount; i++)
+			{
+				CookedSubmesh submesh;
+				memcpy(&submesh, data + submeshOffset + (i * sizeof(CookedSubmesh)), sizeof(CookedSubmesh));
+				if (submesh.MaterialIndex >= header.materialCount || static_cast<uint64_t>(submesh.FirstVertex) + submesh.VertexCount > header.vertexCount
+					|| static_cast<uint64_t>(submesh.FirstIndex) + submesh.IndexCount > header.indexCount)
+					return false;
+			}
+
+			for (uint32_t i = 0; i < header.materialCount; i++)
+			{
+				CookedMaterial material;
+				memcpy(&material, data + materialOffset + (i * sizeof(CookedMaterial)), sizeof(CookedMaterial));
+				if (header.namesOffset + material.NameOffset + material.NameLength > header.vertexOffset) return false;
+			}
+			return true;
+		}
+	}
+
+	bool MeshCooker::s_initialised = false; //!< Initialise with false
+	bool MeshCooker::s_enabled = false; //!< Initialise with false
+	bool MeshCooker::s_quantise = false; //!< Initialise with false
+	bool MeshCooker::s_verify = false; //!< Initialise with false
+	std::string MeshCooker::s_directory = ""; //!< Initialise with empty string
+
+	//! initialise()
+	void MeshCooker::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("meshCook")) return;
+
+		s_enabled = configData["meshCook"]["enabled"].get<uint32_t>() != 0;
+		s_directory = configData["meshCook"]["directory"].get<std::string>();
+		s_quantise = configData["meshCook"]["quantise"].get<uint32_t>() != 0;
+		s_verify = configData["meshCook"]["verify"].get<uint32_t>() != 0;
+
+		if (s_enabled)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(s_directory, error);
+			if (error)
+			{
+				ENGINE_ERROR("[MeshCooker::initialise] Cannot create the cooked mesh directory: {0}.", s_directory);
+				s_enabled = false;
+			}
+		}
+	}
+
+	//! getCookedPath()
+	/*!
+	\param sourcePath a const std::string& - The model file
+	\return a std::string - The cooked file
+	*/
+	std::string MeshCooker::getCookedPath(const std::string& sourcePath)
+	{
+		// Turning the optimiser on or off cooks the meshes again
+		const uint32_t flags = (s_quantise ? CookedMeshFormat::Quantised : 0) | (MeshOptimiser::isEnabled() ? 0x100 : 0);
+		const uint64_t key = MemoryUtils::hash(&flags, sizeof(uint32_t), MemoryUtils::hash(sourcePath.data(), sourcePath.size()));
+
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+		return s_directory + "/" + name + ".cmsh";
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Are cooked meshes used
+	*/
+	const bool MeshCooker::isEnabled()
+	{
+		initialise();
+		return s_enabled;
+	}
+
+	//! build()
+	/*!
+	\param sourcePath a const std::string& - The model file
+	\param mesh a CookedMesh& - The model's meshes
+	\return a const bool - Was the model read
+	*/
+	const bool MeshCooker::build(const std::string& sourcePath, CookedMesh& mesh)
+	{
+		std::vector<Mesh3D> meshes;
+		std::vector<std::string> materialNames;
+		AssimpLoader::loadModel(sourcePath, meshes, &materialNames);
+		if (meshes.empty()) return false;
+
+		mesh = CookedMesh();
+		mesh.Bounds = { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+		for (uint32_t i = 0; i < meshes.size(); i++)
+		{
+			std::vector<Vertex3D>& vertices = meshes[i].getVertices();
+			std::vector<uint32_t>& indices = meshes[i].getIndices();
+			MeshOptimiser::optimise(sourcePath + " mesh " + std::to_string(i), vertices, indices);
+
+			// Meshes which share a material in the model file share an entry in the material table
+			const std::string& materialName = i < materialNames.size() ? materialNames[i] : "";
+			auto material = std::find(mesh.Materials.begin(), mesh.Materials.end(), materialName);
+			if (material == mesh.Materials.end()) material = mesh.Materials.insert(mesh.Materials.end(), materialName);
+
+			CookedSubmesh submesh = {};
+			submesh.FirstVertex = static_cast<uint32_t>(mesh.Vertices.size());
+			submesh.VertexCount = static_cast<uint32_t>(vertices.size());
+			submesh.FirstIndex = static_cast<uint32_t>(mesh.Indices.size());
+			submesh.IndexCount = static_cast<uint32_t>(indices.size());
+			submesh.MaterialIndex = static_cast<uint32_t>(material - mesh.Materials.begin());
+			submesh.Bounds = { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+			submesh.UVMin = glm::vec2(FLT_MAX);
+			submesh.UVMax = glm::vec2(-FLT_MAX);
+
+			for (auto& vertex : vertices)
+			{
+				submesh.Bounds.Min = glm::min(submesh.Bounds.Min, vertex.Position);
+				submesh.Bounds.Max = glm::max(submesh.Bounds.Max, vertex.Position);
+				submesh.UVMin = glm::min(submesh.UVMin, vertex.TexCoords);
+				submesh.UVMax = glm::max(submesh.UVMax, vertex.TexCoords);
+			}
+
+			if (vertices.empty())
+			{
+				submesh.Bounds = { glm::vec3(0.f), glm::vec3(0.f) };
+				submesh.UVMin = submesh.UVMax = glm::vec2(0.f);
+			}
+			else
+			{
+				mesh.Bounds.Min = glm::min(mesh.Bounds.Min, submesh.Bounds.Min);
+				mesh.Bounds.Max = glm::max(mesh.Bounds.Max, submesh.Bounds.Max);
+			}
+
+			mesh.Submeshes.push_back(submesh);
+			mesh.Vertices.insert(mesh.Vertices.end(), vertices.begin(), vertices.end());
+			mesh.Indices.insert(mesh.Indices.end(), indices.begin(), indices.end());
+		}
+
+		if (mesh.Vertices.empty()) mesh.Bounds = { glm::vec3(0.f), glm::vec3(0.f) };
+		return true;
+	}
+
+	//! read()
+	/*!
+	\param cookedPath a const std::string& - The cooked file
+	\param mesh a CookedMesh& - The model's meshes
+	\param sourceSize a const uint64_t - The size of the model file, the cooked file is only read if it matches, 0 to read any
+	\param sourceTime a const int64_t - The write time of the model file, the cooked file is only read if it matches, 0 to read any
+	\return a const bool - Was the file a valid cooked mesh of the model
+	*/
+	const bool MeshCooker::read(const std::string& cookedPath, CookedMesh& mesh, const uint64_t sourceSize, const int64_t sourceTime)
+	{
+		MappedFile file;
+		if (!file.open(cookedPath)) return false;
+
+		CookedMeshHeader header;
+		if (!readHeader(file, header, sourceSize, sourceTime)) return false;
+
+		const uint8_t* data = file.getData();
+		const bool quantised = (header.flags & CookedMeshFormat::Quantised) != 0;
+		const uint64_t materialOffset = sizeof(CookedMeshHeader) + static_cast<uint64_t>(header.submeshCount) * sizeof(CookedSubmesh);
+		const uint64_t indexSize = (header.flags & CookedMeshFormat::ShortIndices) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+		mesh = CookedMesh();
+		mesh.Bounds = header.bounds;
+		mesh.Submeshes.resize(header.submeshCount);
+		memcpy(mesh.Submeshes.data(), data + sizeof(CookedMeshHeader), header.submeshCount * sizeof(CookedSubmesh));
+
+		mesh.Materials.reserve(header.materialCount);
+		for (uint32_t i = 0; i < header.materialCount; i++)
+		{
+			CookedMaterial material;
+			memcpy(&material, data + materialOffset + (i * sizeof(CookedMaterial)), sizeof(CookedMaterial));
+			mesh.Materials.emplace_back(reinterpret_cast<const char*>(data + header.namesOffset + material.NameOffset), material.NameLength);
+		}
+
+		// Unquantised vertices are already in the layout the renderer uploads
+		mesh.Vertices.resize(header.vertexCount);
+		if (!quantised)
+			memcpy(mesh.Vertices.data(), data + header.vertexOffset, static_cast<size_t>(header.vertexCount) * sizeof(Vertex3D));
+		else
+		{
+			const QuantisedVertex3D* vertices = reinterpret_cast<const QuantisedVertex3D*>(data + header.vertexOffset);
+			for (auto& submesh : mesh.Submeshes)
+			{
+				const AABB& bounds = submesh.Bounds;
+				for (uint32_t i = submesh.FirstVertex; i < submesh.FirstVertex + submesh.VertexCount; i++)
+				{
+					QuantisedVertex3D vertex;
+					memcpy(&vertex, vertices + i, sizeof(QuantisedVertex3D));
+
+					Vertex3D& output = mesh.Vertices[i];
+					output.Position = { fromFraction(vertex.Position[0], bounds.Min.x, bounds.Max.x), fromFraction(vertex.Position[1], bounds.Min.y, bounds.Max.y),
+						fromFraction(vertex.Position[2], bounds.Min.z, bounds.Max.z) };
+					output.TexCoords = { fromFraction(vertex.TexCoords[0], submesh.UVMin.x, submesh.UVMax.x), fromFraction(vertex.TexCoords[1], submesh.UVMin.y, submesh.UVMax.y) };
+					output.Normal = vertex.Normal;
+					output.Tangent = vertex.Tangent;
+					output.Bitangent = vertex.Bitangent;
+				}
+			}
+		}
+
+		// The renderer's index buffer is 32 bit, so short indices are widened
+		mesh.Indices.resize(header.indexCount);
+		if (indexSize == sizeof(uint32_t))
+			memcpy(mesh.Indices.data(), data + header.indexOffset, static_cast<size_t>(header.indexCount) * sizeof(uint32_t));
+		else
+		{
+			const uint16_t* indices = reinterpret_cast<const uint16_t*>(data + header.indexOffset);
+			for (uint32_t i = 0; i < header.indexCount; i++) mesh.Indices[i] = indices[i];
+		}
+		return true;
+	}
+
+	//! map()
+	/*!
+	\param cookedPath a const std::string& - The cooked file
+	\param meshes a std::vector<Mesh3D>& - The meshes of the model, each pointing at its vertices and indices in the mapped file
+	\param sourceSize a const uint64_t - The size of the model file, the cooked file is only mapped if it matches, 0 to map any
+	\param sourceTime a const int64_t - The write time of the model file, the cooked file is only mapped if it matches, 0 to map any
+	\return a const bool - Was the file a valid cooked mesh of the model in the layout the renderer uploads
+	*/
+	const bool MeshCooker::map(const std::string& cookedPath, std::vector<Mesh3D>& meshes, const uint64_t sourceSize, const int64_t sourceTime)
+	{
+		Shared<MappedFile> file(new MappedFile);
+		if (!file->open(cookedPath)) return false;
+
+		// Quantised vertices and short indices have to be expanded first, so only read() can load them
+		CookedMeshHeader header;
+		if (!readHeader(*file, header, sourceSize, sourceTime)) return false;
+		if (header.flags & (CookedMeshFormat::Quantised | CookedMeshFormat::ShortIndices)) return false;
+
+		// Both offsets are multiples of eight from the start of the mapping, so the vertices and indices can be used where they are
+		const uint8_t* data = file->getData();
+		const Vertex3D* vertices = reinterpret_cast<const Vertex3D*>(data + header.vertexOffset);
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + header.indexOffset);
+
+		meshes.clear();
+		meshes.reserve(header.submeshCount);
+		std::vector<Vertex3D> noVertices;
+		for (uint32_t i = 0; i < header.submeshCount; i++)
+		{
+			CookedSubmesh submesh;
+			memcpy(&submesh, data + sizeof(CookedMeshHeader) + (i * sizeof(CookedSubmesh)), sizeof(CookedSubmesh));
+			meshes.emplace_back(noVertices, std::vector<uint32_t>());
+			meshes.back().setMappedData(file, vertices + submesh.FirstVertex, submesh.VertexCount, indices + submesh.FirstIndex, submesh.IndexCount);
+		}
+		return true;
+	}
+
+	//! write()
+	/*!
+	\param cookedPath a const std::string& - The cooked file
+	\param mesh a const CookedMesh& - The model's meshes
+	\param quantise a const bool - Store positions and texture coordinates as 16 bit fractions of their submesh's bounds
+	\param sourceSize a const uint64_t - The size of the model file
+	\param sourceTime a const int64_t - The write time of the model file
+	\return a const bool - Was the file written
+	*/
+	const bool MeshCooker::write(const std::string& cookedPath, const CookedMesh& mesh, const bool quantise, const uint64_t sourceSize, const int64_t sourceTime)
+	{
+		if (mesh.Submeshes.empty()) return false;
+
+		std::vector<CookedMaterial> materials;
+		std::string names;
+		for (auto& material : mesh.Materials)
+		{
+			materials.push_back({ static_cast<uint32_t>(names.size()), static_cast<uint32_t>(material.size()) });
+			names += material;
+		}
+
+		CookedMeshHeader header;
+		header.sourceSize = sourceSize;
+		header.sourceTime = sourceTime;
+		// Indices are relative to their submesh, so the short form only needs every submesh to be small enough. Unquantised meshes
+		// keep 32 bit indices, the renderer's index buffer is 32 bit so short ones would have to be widened rather than mapped
+		bool shortIndices = quantise;
+		for (auto& submesh : mesh.Submeshes)
+			shortIndices = shortIndices && MeshOptimiser::canUseShortIndices(submesh.VertexCount);
+
+		header.flags = (quantise ? CookedMeshFormat::Quantised : 0) | (shortIndices ? CookedMeshFormat::ShortIndices : 0);
+		header.vertexSize = quantise ? sizeof(QuantisedVertex3D) : sizeof(Vertex3D);
+		header.submeshCount = static_cast<uint32_t>(mesh.Submeshes.size());
+		header.materialCount = static_cast<uint32_t>(materials.size());
+		header.vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+		header.indexCount = static_cast<uint32_t>(mesh.Indices.size());
+		header.namesOffset = sizeof(CookedMeshHeader) + (mesh.Submeshes.size() * sizeof(CookedSubmesh)) + (materials.size() * sizeof(CookedMaterial));
+		header.vertexOffset = align(header.namesOffset + names.size());
+		header.indexOffset = align(header.vertexOffset + (static_cast<uint64_t>(header.vertexCount) * header.vertexSize));
+		header.bounds = mesh.Bounds;
+
+		std::ofstream file(cookedPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			ENGINE_ERROR("[MeshCooker::write] Cannot write the cooked mesh: {0}.", cookedPath);
+			return false;
+		}
+
+		const char padding[8] = {};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(CookedMeshHeader));
+		file.write(reinterpret_cast<const char*>(mesh.Submeshes.data()), mesh.Submeshes.size() * sizeof(CookedSubmesh));
+		file.write(reinterpret_cast<const char*>(materials.data()), materials.size() * sizeof(CookedMaterial));
+		file.write(names.data(), names.size());
+		file.write(padding, header.vertexOffset - (header.namesOffset + names.size()));
+
+		if (!quantise)
+			file.write(reinterpret_cast<const char*>(mesh.Vertices.data()), mesh.Vertices.size() * sizeof(Vertex3D));
+		else
+		{
+			std::vector<QuantisedVertex3D> vertices(mesh.Vertices.size());
+			for (auto& submesh : mesh.Submeshes)
+			{
+				const AABB& bounds = submesh.Bounds;
+				for (uint32_t i = submesh.FirstVertex; i < submesh.FirstVertex + submesh.VertexCount; i++)
+				{
+					const Vertex3D& vertex = mesh.Vertices[i];
+					QuantisedVertex3D& output = vertices[i];
+					output.Position = { toFraction(vertex.Position.x, bounds.Min.x, bounds.Max.x), toFraction(vertex.Position.y, bounds.Min.y, bounds.Max.y),
+						toFraction(vertex.Position.z, bounds.Min.z, bounds.Max.z) };
+					output.TexCoords = { toFraction(vertex.TexCoords.x, submesh.UVMin.x, submesh.UVMax.x), toFraction(vertex.TexCoords.y, submesh.UVMin.y, submesh.UVMax.y) };
+					output.Normal = vertex.Normal;
+					output.Tangent = vertex.Tangent;
+					output.Bitangent = vertex.Bitangent;
+				}
+			}
+			file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(QuantisedVertex3D));
+		}
+
+		file.write(padding, header.indexOffset - (header.vertexOffset + (static_cast<uint64_t>(header.vertexCount) * header.vertexSize)));
+		if (shortIndices)
+		{
+			std::vector<uint16_t> indices;
+			MeshOptimiser::toShortIndices(mesh.Indices, indices);
+			file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint16_t));
+		}
+		else
+			file.write(reinterpret_cast<const char*>(mesh.Indices.data()), mesh.Indices.size() * sizeof(uint32_t));
+		return static_cast<bool>(file);
+	}
+
+	//! cook()
+	/*!
+	\param sourcePath a const std::string& - The model file
+	\param cookedPath a const std::string& - The cooked file
+	\param quantise a const bool - Store positions and texture coordinates as 16 bit fractions of their submesh's bounds
+	\return a const bool - Was the model cooked
+	*/
+	const bool MeshCooker::cook(const std::string& sourcePath, const std::string& cookedPath, const bool quantise)
+	{
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		getSourceStamp(sourcePath, sourceSize, sourceTime);
+
+		CookedMesh mesh;
+		return build(sourcePath, mesh) && write(cookedPath, mesh, quantise, sourceSize, sourceTime);
+	}
+
+	//! verify()
+	/*!
+	\param sourcePath a const std::string& - The model file
+	\param cookedPath a const std::string& - The cooked file
+	\return a const bool - Does the cooked mesh match assimp's output, quantised attributes may differ by one step of their range
+	*/
+	const bool MeshCooker::verify(const std::string& sourcePath, const std::string& cookedPath)
+	{
+		CookedMesh cooked;
+		if (!read(cookedPath, cooked))
+		{
+			ENGINE_ERROR("[MeshCooker::verify] Cannot read the cooked mesh: {0}.", cookedPath);
+			return false;
+		}
+
+		CookedMesh expected;
+		if (!build(sourcePath, expected)) return false;
+
+		if (cooked.Submeshes.size() != expected.Submeshes.size() || cooked.Vertices.size() != expected.Vertices.size() || cooked.Indices != expected.Indices || cooked.Materials != expected.Materials)
+		{
+			ENGINE_ERROR("[MeshCooker::verify] The cooked mesh: {0} does not have the submeshes, indices or materials of its model: {1}.", cookedPath, sourcePath);
+			return false;
+		}
+
+		float positionError = 0.f, uvError = 0.f;
+		bool passed = true;
+		for (uint32_t s = 0; s < cooked.Submeshes.size() && passed; s++)
+		{
+			const CookedSubmesh& submesh = cooked.Submeshes[s];
+			const CookedSubmesh& source = expected.Submeshes[s];
+			if (memcmp(&submesh, &source, sizeof(CookedSubmesh)) != 0)
+			{
+				ENGINE_ERROR("[MeshCooker::verify] Submesh {0} of the cooked mesh: {1} does not match its model: {2}.", s, cookedPath, sourcePath);
+				return false;
+			}
+
+			// One quantisation step of the submesh's range, with room for float rounding
+			const glm::vec3 positionStep = (submesh.Bounds.Max - submesh.Bounds.Min) / 65535.f + glm::abs(submesh.Bounds.Max) * 1e-6f + 1e-6f;
+			const glm::vec2 uvStep = (submesh.UVMax - submesh.UVMin) / 65535.f + glm::abs(submesh.UVMax) * 1e-6f + 1e-6f;
+
+			for (uint32_t i = submesh.FirstVertex; i < submesh.FirstVertex + submesh.VertexCount; i++)
+			{
+				const Vertex3D& vertex = cooked.Vertices[i];
+				const Vertex3D& sourceVertex = expected.Vertices[i];
+
+				const glm::vec3 positionDifference = glm::abs(vertex.Position - sourceVertex.Position);
+				const glm::vec2 uvDifference = glm::abs(vertex.TexCoords - sourceVertex.TexCoords);
+				positionError = glm::max(positionError, glm::max(positionDifference.x, glm::max(positionDifference.y, positionDifference.z)));
+				uvError = glm::max(uvError, glm::max(uvDifference.x, uvDifference.y));
+
+				if (glm::any(glm::greaterThan(positionDifference, positionStep)) || glm::any(glm::greaterThan(uvDifference, uvStep))
+					|| vertex.Normal != sourceVertex.Normal || vertex.Tangent != sourceVertex.Tangent || vertex.Bitangent != sourceVertex.Bitangent)
+				{
+					ENGINE_ERROR("[MeshCooker::verify] Vertex {0} of the cooked mesh: {1} does not match its model: {2}.", i, cookedPath, sourcePath);
+					passed = false;
+					break;
+				}
+			}
+		}
+
+		if (passed)
+			ENGINE_INFO("[MeshCooker::verify] {0}: {1} submeshes and {2} vertices match, largest position difference {3}, largest UV difference {4}.",
+				sourcePath, cooked.Submeshes.size(), cooked.Vertices.size(), positionError, uvError);
+		return passed;
+	}
+
+	//! load()
+	/*!
+	\param filePath a const std::string& - The model file
+	\param meshes a std::vector<Mesh3D>& - The meshes of the model
+	\return a const bool - Was the model loaded
+	*/
+	const bool MeshCooker::load(const std::string& filePath, std::vector<Mesh3D>& meshes)
+	{
+		ENGINE_PROFILE_FUNCTION();
+
+		if (!isEnabled())
+		{
+			AssimpLoader::loadModel(filePath, meshes);
+			for (uint32_t i = 0; i < meshes.size(); i++)
+				MeshOptimiser::optimise(filePath + " mesh " + std::to_string(i), meshes[i].getVertices(), meshes[i].getIndices());
+			return !meshes.empty();
+		}
+
+		// A cooked file is only used while the model it was cooked from is unchanged
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		if (!getSourceStamp(filePath, sourceSize, sourceTime))
+		{
+			ENGINE_ERROR("[MeshCooker::load] Could not find the model file: {0}", filePath);
+			return false;
+		}
+
+		// Unquantised meshes are uploaded straight from the mapped file
+		const std::string cookedPath = getCookedPath(filePath);
+		if (!s_quantise && map(cookedPath, meshes, sourceSize, sourceTime)) return true;
+
+		CookedMesh mesh;
+		if (!read(cookedPath, mesh, sourceSize, sourceTime))
+		{
+			if (!build(filePath, mesh)) return false;
+
+			if (write(cookedPath, mesh, s_quantise, sourceSize, sourceTime))
+			{
+				if (s_verify) verify(filePath, cookedPath);
+
+				// Read the quantised mesh back, so the first start draws exactly what later starts will
+				if (s_quantise)
+					read(cookedPath, mesh);
+				else if (map(cookedPath, meshes))
+					return true;
+			}
+		}
+
+		meshes.clear();
+		meshes.reserve(mesh.Submeshes.size());
+		std::vector<Vertex3D> noVertices;
+		for (auto& submesh : mesh.Submeshes)
+		{
+			meshes.emplace_back(noVertices, std::vector<uint32_t>());
+			meshes.back().getVertices().assign(mesh.Vertices.begin() + submesh.FirstVertex, mesh.Vertices.begin() + submesh.FirstVertex + submesh.VertexCount);
+			meshes.back().getIndices().assign(mesh.Indices.begin() + submesh.FirstIndex, mesh.Indices.begin() + submesh.FirstIndex + submesh.IndexCount);
+		}
+		return true;
+	}
+}
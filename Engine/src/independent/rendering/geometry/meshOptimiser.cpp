@@ -0,0 +1,519 @@
+/*! \file meshOptimiser.cpp
+*
+* \brief Welds duplicate vertices and reorders triangles and vertices so meshes draw with fewer vertex shader runs
+*
+* \author Daniel Bullin
+*
+*/
+#include <cmath>
+#include <unordered_map>
+#include "independent/rendering/geometry/meshOptimiser.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	namespace
+	{
+		const uint32_t ScoringCacheSize = 32; //!< The cache size Forsyth's scores are tuned for
+		const float CacheDecayPower = 1.5f; //!< How quickly a vertex's score falls as it moves down the cache
+		const float LastTriangleScore = 0.75f; //!< The score of the vertices of the last triangle, lower so strips do not zigzag
+		const float ValenceBoostScale = 2.f; //!< The score given to vertices with few triangles left
+		const float ValenceBoostPower = 0.5f; //!< How quickly the valence boost falls with the triangles left
+
+		//! getVertexScore()
+		/*!
+		\param cachePosition a const int32_t - The position of the vertex in the cache, -1 when it is not in the cache
+		\param remainingTriangles a const uint32_t - The number of triangles still to be added which use the vertex
+		\return a const float - The score of the vertex
+		*/
+		const float getVertexScore(const int32_t cachePosition, const uint32_t remainingTriangles)
+		{
+			if (remainingTriangles == 0) return -1.f;
+
+			float score = 0.f;
+			if (cachePosition >= 0)
+			{
+				if (cachePosition < 3)
+					score = LastTriangleScore;
+				else
+					score = std::pow(1.f - (static_cast<float>(cachePosition - 3) / static_cast<float>(ScoringCacheSize - 3)), CacheDecayPower);
+			}
+
+			return score + (ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower));
+		}
+
+		//! hashFloats()
+		/*!
+		\param values a const float* - The values
+		\param count a const uint32_t - The number of values
+		\param hash a const uint64_t - The hash to carry on from, a new hash by default
+		\return a const uint64_t - The hash of the values, -0 hashed the same as 0 since they compare equal
+		*/
+		const uint64_t hashFloats(const float* values, const uint32_t count, const uint64_t hash = 14695981039346656037ull)
+		{
+			float normalised[3];
+			for (uint32_t i = 0; i < count; i++)
+				normalised[i] = values[i] == 0.f ? 0.f : values[i];
+			return MemoryUtils::hash(normalised, sizeof(float) * count, hash);
+		}
+
+		//! hashVertex()
+		/*!
+		\param vertex a const Vertex3D& - The vertex
+		\return a const size_t - The hash of every attribute, the padding is not read
+		*/
+		const size_t hashVertex(const Vertex3D& vertex)
+		{
+			uint64_t hash = hashFloats(&vertex.Position.x, 3);
+			hash = hashFloats(&vertex.TexCoords.x, 2, hash);
+			hash = MemoryUtils::hash(vertex.Normal.data(), sizeof(int16_t) * 3, hash);
+			hash = MemoryUtils::hash(vertex.Tangent.data(), sizeof(int16_t) * 3, hash);
+			return static_cast<size_t>(MemoryUtils::hash(vertex.Bitangent.data(), sizeof(int16_t) * 3, hash));
+		}
+
+		//! hashVertex()
+		/*!
+		\param vertex a const TerrainVertex& - The vertex
+		\return a const size_t - The hash of every attribute
+		*/
+		const size_t hashVertex(const TerrainVertex& vertex)
+		{
+			return static_cast<size_t>(hashFloats(&vertex.TexCoords.x, 2, hashFloats(&vertex.Position.x, 3)));
+		}
+
+		//! isSameVertex()
+		/*!
+		\param a a const Vertex3D& - The first vertex
+		\param b a const Vertex3D& - The second vertex
+		\return a const bool - Are the attributes of both vertices equal
+		*/
+		const bool isSameVertex(const Vertex3D& a, const Vertex3D& b)
+		{
+			return a.Position == b.Position && a.TexCoords == b.TexCoords && a.Normal == b.Normal && a.Tangent == b.Tangent && a.Bitangent == b.Bitangent;
+		}
+
+		//! isSameVertex()
+		/*!
+		\param a a const TerrainVertex& - The first vertex
+		\param b a const TerrainVertex& - The second vertex
+		\return a const bool - Are the attributes of both vertices equal
+		*/
+		const bool isSameVertex(const TerrainVertex& a, const TerrainVertex& b)
+		{
+			return a.Position == b.Position && a.TexCoords == b.TexCoords;
+		}
+
+		//! weldVertices()
+		/*!
+		\param vertices a std::vector<Vertex>& - The vertices, replaced by the unique vertices
+		\param indices a std::vector<uint32_t>& - The indices, remapped to the unique vertices
+		*/
+		template<typename Vertex>
+		void weldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			// The map is keyed by index into the original vertices, so nothing is copied to look a vertex up
+			auto hasher = [&vertices](const uint32_t index) { return hashVertex(vertices[index]); };
+			auto equal = [&vertices](const uint32_t a, const uint32_t b) { return isSameVertex(vertices[a], vertices[b]); };
+			std::unordered_map<uint32_t, uint32_t, decltype(hasher), decltype(equal)> unique(vertices.size(), hasher, equal);
+
+			std::vector<uint32_t> remap(vertices.size());
+			std::vector<Vertex> welded;
+			welded.reserve(vertices.size());
+
+			for (uint32_t i = 0; i < vertices.size(); i++)
+			{
+				auto result = unique.emplace(i, static_cast<uint32_t>(welded.size()));
+				if (result.second) welded.push_back(vertices[i]);
+				remap[i] = result.first->second;
+			}
+
+			for (auto& index : indices)
+				index = remap[index];
+			vertices = std::move(welded);
+		}
+
+		//! reorderVertices()
+		/*!
+		\param vertices a std::vector<Vertex>& - The vertices, reordered and without any which are not used
+		\param indices a std::vector<uint32_t>& - The indices, remapped to the reordered vertices
+		*/
+		template<typename Vertex>
+		void reorderVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			const uint32_t unused = UINT32_MAX;
+			std::vector<uint32_t> remap(vertices.size(), unused);
+			std::vector<Vertex> reordered;
+			reordered.reserve(vertices.size());
+
+			for (auto& index : indices)
+			{
+				if (remap[index] == unused)
+				{
+					remap[index] = static_cast<uint32_t>(reordered.size());
+					reordered.push_back(vertices[index]);
+				}
+				index = remap[index];
+			}
+			vertices = std::move(reordered);
+		}
+	}
+
+	bool MeshOptimiser::s_initialised = false; //!< Initialise with false
+	bool MeshOptimiser::s_enabled = false; //!< Initialise with false
+	bool MeshOptimiser::s_overdraw = false; //!< Initialise with false
+
+	//! initialise()
+	void MeshOptimiser::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("meshOptimiser")) return;
+
+		s_enabled = configData["meshOptimiser"]["enabled"].get<uint32_t>() != 0;
+		s_overdraw = configData["meshOptimiser"]["overdraw"].get<uint32_t>() != 0;
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Are meshes optimised
+	*/
+	const bool MeshOptimiser::isEnabled()
+	{
+		initialise();
+		return s_enabled;
+	}
+
+	//! setEnabled()
+	/*!
+	\param enabled a const bool - Are meshes optimised
+	\param overdraw a const bool - Are triangle clusters ordered to reduce overdraw
+	*/
+	void MeshOptimiser::setEnabled(const bool enabled, const bool overdraw)
+	{
+		// The config is not read afterwards, so tools and tests without one keep these settings
+		s_initialised = true;
+		s_enabled = enabled;
+		s_overdraw = overdraw;
+	}
+
+	//! weld()
+	/*!
+	\param vertices a std::vector<Vertex3D>& - The vertices, replaced by the unique vertices
+	\param indices a std::vector<uint32_t>& - The indices, remapped to the unique vertices
+	*/
+	void MeshOptimiser::weld(std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices)
+	{
+		weldVertices(vertices, indices);
+	}
+
+	//! weld()
+	/*!
+	\param vertices a std::vector<TerrainVertex>& - The vertices, replaced by the unique vertices
+	\param indices a std::vector<uint32_t>& - The indices, remapped to the unique vertices
+	*/
+	void MeshOptimiser::weld(std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		weldVertices(vertices, indices);
+	}
+
+	//! optimiseVertexCache()
+	/*!
+	\param indices a std::vector<uint32_t>& - The indices of a triangle list, each triangle keeps its winding
+	\param vertexCount a const uint32_t - The number of vertices the indices refer to
+	*/
+	void MeshOptimiser::optimiseVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount < 2) return;
+
+		// The triangles of every vertex, packed into one list
+		std::vector<uint32_t> remaining(vertexCount, 0);
+		for (uint32_t i = 0; i < triangleCount * 3; i++) remaining[indices[i]]++;
+
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		for (uint32_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + remaining[v];
+
+		std::vector<uint32_t> adjacency(triangleCount * 3);
+		std::vector<uint32_t> filled(offsets.begin(), offsets.end() - 1);
+		for (uint32_t i = 0; i < triangleCount * 3; i++) adjacency[filled[indices[i]]++] = i / 3;
+
+		std::vector<int32_t> cachePositions(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++) vertexScores[v] = getVertexScore(-1, remaining[v]);
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<bool> added(triangleCount, false);
+		int64_t best = -1;
+		float bestScore = -1.f;
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+			if (triangleScores[t] > bestScore) { bestScore = triangleScores[t]; best = t; }
+		}
+
+		std::vector<uint32_t> output;
+		output.reserve(triangleCount * 3);
+		uint32_t cache[ScoringCacheSize + 3];
+		uint32_t newCache[ScoringCacheSize + 3];
+		uint32_t cacheCount = 0;
+		uint32_t nextTriangle = 0;
+
+		for (uint32_t i = 0; i < triangleCount; i++)
+		{
+			// With nothing in the cache to continue from, start again at the first triangle left
+			if (best < 0)
+			{
+				while (added[nextTriangle]) nextTriangle++;
+				best = nextTriangle;
+			}
+
+			const uint32_t triangle = static_cast<uint32_t>(best);
+			const uint32_t* triangleIndices = indices.data() + (triangle * 3);
+			added[triangle] = true;
+
+			// The triangle's vertices move to the front of the cache, the rest move down
+			uint32_t newCount = 0;
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				const uint32_t vertex = triangleIndices[k];
+				output.push_back(vertex);
+				newCache[newCount++] = vertex;
+
+				uint32_t* triangles = adjacency.data() + offsets[vertex];
+				for (uint32_t j = 0; j < remaining[vertex]; j++)
+				{
+					if (triangles[j] == triangle)
+					{
+						std::swap(triangles[j], triangles[remaining[vertex] - 1]);
+						break;
+					}
+				}
+				remaining[vertex]--;
+			}
+
+			for (uint32_t j = 0; j < cacheCount; j++)
+			{
+				const uint32_t vertex = cache[j];
+				if (vertex != triangleIndices[0] && vertex != triangleIndices[1] && vertex != triangleIndices[2])
+					newCache[newCount++] = vertex;
+			}
+
+			for (uint32_t j = 0; j < newCount; j++)
+			{
+				const uint32_t vertex = newCache[j];
+				cachePositions[vertex] = j < ScoringCacheSize ? static_cast<int32_t>(j) : -1;
+				vertexScores[vertex] = getVertexScore(cachePositions[vertex], remaining[vertex]);
+			}
+
+			cacheCount = std::min(newCount, ScoringCacheSize);
+			std::copy(newCache, newCache + cacheCount, cache);
+
+			// Only the triangles of the vertices which moved can change score, the best of them is added next
+			best = -1;
+			bestScore = -1.f;
+			for (uint32_t j = 0; j < newCount; j++)
+			{
+				const uint32_t vertex = newCache[j];
+				const uint32_t* triangles = adjacency.data() + offsets[vertex];
+				for (uint32_t k = 0; k < remaining[vertex]; k++)
+				{
+					const uint32_t t = triangles[k];
+					triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+					if (triangleScores[t] > bestScore) { bestScore = triangleScores[t]; best = t; }
+				}
+			}
+		}
+
+		indices.resize(output.size());
+		std::copy(output.begin(), output.end(), indices.begin());
+	}
+
+	//! optimiseOverdraw()
+	/*!
+	\param indices a std::vector<uint32_t>& - The indices of a triangle list, already ordered for the vertex cache
+	\param vertices a const std::vector<Vertex3D>& - The vertices
+	*/
+	void MeshOptimiser::optimiseOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex3D>& vertices)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount < 2 || vertices.empty()) return;
+
+		// A cluster starts wherever the cache order already starts over, a triangle with all three vertices missing the cache,
+		// so moving the clusters around costs almost no cache hits
+		std::vector<uint32_t> clusters;
+		std::vector<uint32_t> cacheTimes(vertices.size(), 0);
+		uint32_t time = CacheSize + 1;
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			uint32_t misses = 0;
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				const uint32_t vertex = indices[t * 3 + k];
+				if (time - cacheTimes[vertex] > CacheSize)
+				{
+					cacheTimes[vertex] = time++;
+					misses++;
+				}
+			}
+			if (t == 0 || misses == 3) clusters.push_back(t);
+		}
+		if (clusters.size() < 2) return;
+		clusters.push_back(triangleCount);
+
+		glm::vec3 meshCentre(0.f);
+		for (auto& vertex : vertices) meshCentre += vertex.Position;
+		meshCentre /= static_cast<float>(vertices.size());
+
+		// Clusters facing furthest out of the mesh are drawn first, so they hide the inside before it is shaded
+		std::vector<std::pair<float, uint32_t>> order(clusters.size() - 1);
+		for (uint32_t c = 0; c + 1 < clusters.size(); c++)
+		{
+			glm::vec3 centre(0.f), normal(0.f);
+			float area = 0.f;
+			for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+			{
+				const glm::vec3& a = vertices[indices[t * 3]].Position;
+				const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+				const glm::vec3& p = vertices[indices[t * 3 + 2]].Position;
+				const glm::vec3 triangleNormal = glm::cross(b - a, p - a);
+				const float triangleArea = glm::length(triangleNormal);
+
+				centre += (a + b + p) * (triangleArea / 3.f);
+				normal += triangleNormal;
+				area += triangleArea;
+			}
+
+			const float normalLength = glm::length(normal);
+			const float facing = area > 0.f && normalLength > 0.f ? glm::dot((centre / area) - meshCentre, normal / normalLength) : -FLT_MAX;
+			order[c] = { facing, c };
+		}
+
+		std::stable_sort(order.begin(), order.end(), [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.first > b.first; });
+
+		std::vector<uint32_t> output;
+		output.reserve(indices.size());
+		for (auto& cluster : order)
+			output.insert(output.end(), indices.begin() + (clusters[cluster.second] * 3), indices.begin() + (clusters[cluster.second + 1] * 3));
+		std::copy(output.begin(), output.end(), indices.begin());
+	}
+
+	//! optimiseVertexFetch()
+	/*!
+	\param vertices a std::vector<Vertex3D>& - The vertices, reordered and without any which are not used
+	\param indices a std::vector<uint32_t>& - The indices, remapped to the reordered vertices
+	*/
+	void MeshOptimiser::optimiseVertexFetch(std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices)
+	{
+		reorderVertices(vertices, indices);
+	}
+
+	//! optimiseVertexFetch()
+	/*!
+	\param vertices a std::vector<TerrainVertex>& - The vertices, reordered and without any which are not used
+	\param indices a std::vector<uint32_t>& - The indices, remapped to the reordered vertices
+	*/
+	void MeshOptimiser::optimiseVertexFetch(std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		reorderVertices(vertices, indices);
+	}
+
+	//! getACMR()
+	/*!
+	\param indices a const std::vector<uint32_t>& - The indices of a triangle list
+	\param vertexCount a const uint32_t - The number of vertices the indices refer to
+	\param cacheSize a const uint32_t - The size of the FIFO cache to simulate
+	\return a const float - The average number of vertices transformed per triangle, 0.5 at best and 3 at worst
+	*/
+	const float MeshOptimiser::getACMR(const std::vector<uint32_t>& indices, const uint32_t vertexCount, const uint32_t cacheSize)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0) return 0.f;
+
+		std::vector<uint32_t> cacheTimes(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+		uint32_t misses = 0;
+		for (uint32_t i = 0; i < triangleCount * 3; i++)
+		{
+			if (time - cacheTimes[indices[i]] > cacheSize)
+			{
+				cacheTimes[indices[i]] = time++;
+				misses++;
+			}
+		}
+		return static_cast<float>(misses) / static_cast<float>(triangleCount);
+	}
+
+	//! canUseShortIndices()
+	/*!
+	\param vertexCount a const uint32_t - The number of vertices in the mesh
+	\return a const bool - Can every index of the mesh be stored in 16 bits
+	*/
+	const bool MeshOptimiser::canUseShortIndices(const uint32_t vertexCount)
+	{
+		return vertexCount <= 65536;
+	}
+
+	//! toShortIndices()
+	/*!
+	\param indices a const std::vector<uint32_t>& - The indices, each must fit in 16 bits
+	\param shortIndices a std::vector<uint16_t>& - The narrowed indices
+	*/
+	void MeshOptimiser::toShortIndices(const std::vector<uint32_t>& indices, std::vector<uint16_t>& shortIndices)
+	{
+		shortIndices.resize(indices.size());
+		for (size_t i = 0; i < indices.size(); i++)
+			shortIndices[i] = static_cast<uint16_t>(indices[i]);
+	}
+
+	//! optimise()
+	/*!
+	\param meshName a const std::string& - The name the results are reported under
+	\param vertices a std::vector<Vertex3D>& - The vertices
+	\param indices a std::vector<uint32_t>& - The indices of a triangle list
+	*/
+	void MeshOptimiser::optimise(const std::string& meshName, std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices)
+	{
+		ENGINE_PROFILE_FUNCTION();
+
+		if (!isEnabled() || vertices.empty() || indices.size() < 3) return;
+
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const float acmr = getACMR(indices, vertexCount);
+
+		weld(vertices, indices);
+		optimiseVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+		if (s_overdraw) optimiseOverdraw(indices, vertices);
+		optimiseVertexFetch(vertices, indices);
+
+		ENGINE_INFO("[MeshOptimiser::optimise] {0}: {1} vertices welded to {2}, ACMR {3:.3f} before and {4:.3f} after.", meshName, vertexCount, vertices.size(),
+			acmr, getACMR(indices, static_cast<uint32_t>(vertices.size())));
+	}
+
+	//! optimise()
+	/*!
+	\param meshName a const std::string& - The name the results are reported under
+	\param vertices a std::vector<TerrainVertex>& - The vertices
+	\param indices a std::vector<uint32_t>& - The indices of a triangle list
+	*/
+	void MeshOptimiser::optimise(const std::string& meshName, std::vector<TerrainVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		ENGINE_PROFILE_FUNCTION();
+
+		if (!isEnabled() || vertices.empty() || indices.size() < 3) return;
+
+		// Terrain is a flat grid displaced on the GPU, so there is no overdraw order worth finding
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const float acmr = getACMR(indices, vertexCount);
+
+		weld(vertices, indices);
+		optimiseVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+		optimiseVertexFetch(vertices, indices);
+
+		ENGINE_INFO("[MeshOptimiser::optimise] {0}: {1} vertices welded to {2}, ACMR {3:.3f} before and {4:.3f} after.", meshName, vertexCount, vertices.size(),
+			acmr, getACMR(indices, static_cast<uint32_t>(vertices.size())));
+	}
+}
@@ -197,6 +197,20 @@ namespace Engine
 	{
 		return m_shininess;
 	}
+
+	//! getParameters()
+	/*
+	\return a MaterialParameters - The tint, the UV rectangle of the first subtexture and the shininess
+	*/
+	MaterialParameters Material::getParameters() const
+	{
+		MaterialParameters parameters;
+		parameters.Tint = m_tint;
+		if (!m_subTextures.empty() && m_subTextures[0])
+			parameters.UVRect = { m_subTextures[0]->getUVStart(), m_subTextures[0]->getUVEnd() };
+		parameters.Scalars.x = m_shininess;
+		return parameters;
+	}
 	
 	//! printDetails()
 	void Material::printDetails()
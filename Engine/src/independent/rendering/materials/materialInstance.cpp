@@ -0,0 +1,91 @@
+/*! \file materialInstance.cpp
+*
+* \brief An instance of a shared material, which can change its own parameters without changing the material
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/rendering/materials/materialInstance.h"
+
+namespace Engine
+{
+	//! MaterialInstance()
+	/*!
+	\param material a Material* - A pointer to the shared material
+	*/
+	MaterialInstance::MaterialInstance(Material* material) : m_material(material), m_overrides(Override::None)
+	{
+	}
+
+	//! setTint()
+	/*!
+	\param tint a const glm::vec4& - The tint
+	*/
+	void MaterialInstance::setTint(const glm::vec4& tint)
+	{
+		m_parameters.Tint = tint;
+		m_overrides |= Override::Tint;
+	}
+
+	//! getTint()
+	/*!
+	\return a const glm::vec4& - The tint of the instance, the material's when the instance has none
+	*/
+	const glm::vec4& MaterialInstance::getTint() const
+	{
+		if (!(m_overrides & Override::Tint) && m_material)
+			return m_material->getTint();
+
+		return m_parameters.Tint;
+	}
+
+	//! setUVRect()
+	/*!
+	\param uvRect a const glm::vec4& - The start UV in xy and the end UV in zw
+	*/
+	void MaterialInstance::setUVRect(const glm::vec4& uvRect)
+	{
+		m_parameters.UVRect = uvRect;
+		m_overrides |= Override::UVRect;
+	}
+
+	//! setScalars()
+	/*!
+	\param scalars a const glm::vec4& - The scalar parameters, the shininess in x
+	*/
+	void MaterialInstance::setScalars(const glm::vec4& scalars)
+	{
+		m_parameters.Scalars = scalars;
+		m_overrides |= Override::Scalars;
+	}
+
+	//! reset()
+	void MaterialInstance::reset()
+	{
+		m_parameters = MaterialParameters();
+		m_overrides = Override::None;
+	}
+
+	//! getParameters()
+	/*!
+	\return a MaterialParameters - The material's parameters with the instance's applied
+	*/
+	MaterialParameters MaterialInstance::getParameters() const
+	{
+		return getParameters(m_material);
+	}
+
+	//! getParameters()
+	/*!
+	\param material a Material* - A pointer to a material, such as the material of one mesh in a model
+	\return a MaterialParameters - The material's parameters with the instance's applied
+	*/
+	MaterialParameters MaterialInstance::getParameters(Material* material) const
+	{
+		MaterialParameters parameters = material ? material->getParameters() : MaterialParameters();
+		if (m_overrides & Override::Tint) parameters.Tint = m_parameters.Tint;
+		if (m_overrides & Override::UVRect) parameters.UVRect = m_parameters.UVRect;
+		if (m_overrides & Override::Scalars) parameters.Scalars = m_parameters.Scalars;
+		return parameters;
+	}
+}
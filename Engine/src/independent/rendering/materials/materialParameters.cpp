@@ -0,0 +1,31 @@
+/*! \file materialParameters.cpp
+*
+* \brief The per-instance parameters of a material, packed into a buffer each frame and indexed by instance ID
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/rendering/materials/materialParameters.h"
+
+namespace Engine
+{
+	std::vector<MaterialParameters> MaterialParameterBuffer::s_parameters; //!< Initialise to empty list
+
+	//! add()
+	/*!
+	\param parameters a const MaterialParameters& - The parameters of a submission
+	\return a const uint32_t - The instance ID of the block, valid until the end of the frame
+	*/
+	const uint32_t MaterialParameterBuffer::add(const MaterialParameters& parameters)
+	{
+		s_parameters.push_back(parameters);
+		return static_cast<uint32_t>(s_parameters.size()) - 1;
+	}
+
+	//! onFrameEnd()
+	void MaterialParameterBuffer::onFrameEnd()
+	{
+		// Clearing keeps the capacity, so after the first few frames adding never allocates
+		s_parameters.clear();
+	}
+}
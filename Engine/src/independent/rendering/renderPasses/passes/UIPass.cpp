@@ -9,6 +9,7 @@
 #include "independent/rendering/renderUtils.h"
 #include "independent/systems/components/scene.h"
 #include "independent/rendering/renderers/renderer2D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -69,10 +70,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void UIPass::onRender(std::vector<Entity*>& entities)
+	void UIPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		// Bind the framebuffer chosen
 		m_previousFBO->bind();
 
@@ -9,6 +9,7 @@
 #include "independent/rendering/renderUtils.h"
 #include "independent/systems/components/scene.h"
 #include "independent/rendering/renderers/renderer2D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -58,10 +59,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void BlurPass::onRender(std::vector<Entity*>& entities)
+	void BlurPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		// Bind the framebuffer chosen
 		m_framebuffer->bind();
 
@@ -11,6 +11,7 @@
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/windowManager.h"
 #include "independent/rendering/renderers/renderer3D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -41,9 +42,9 @@ namespace Engine
 	//! uploadLightData()
 	void FirstPass::uploadLightData()
 	{
-		std::vector<DirectionalLight*> dirLights = m_attachedScene->getClosestDirectionalLights();
-		std::vector<PointLight*> pointLights = m_attachedScene->getClosestPointLights();
-		std::vector<SpotLight*> spotLights = m_attachedScene->getClosestSpotLights();
+		FrameVector<DirectionalLight*> dirLights = m_attachedScene->getClosestDirectionalLights();
+		FrameVector<PointLight*> pointLights = m_attachedScene->getClosestPointLights();
+		FrameVector<SpotLight*> spotLights = m_attachedScene->getClosestSpotLights();
 
 		/////////
 		// DIRECTIONAL LIGHTING
@@ -167,10 +168,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void FirstPass::onRender(std::vector<Entity*>& entities)
+	void FirstPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		// Bind FBO
 		m_frameBuffer->bind();
 
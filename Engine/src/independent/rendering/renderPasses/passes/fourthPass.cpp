@@ -12,6 +12,7 @@
 #include "independent/systems/systems/sceneManager.h"
 #include "independent/rendering/renderers/renderer2D.h"
 #include "independent/rendering/geometry/quad.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -64,10 +65,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void FourthPass::onRender(std::vector<Entity*>& entities)
+	void FourthPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		// Bind the framebuffer chosen
 		m_frameBuffer->bind();
 
@@ -11,6 +11,7 @@
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/sceneManager.h"
 #include "independent/rendering/renderers/renderer2D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -60,10 +61,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void SecondPass::onRender(std::vector<Entity*>& entities)
+	void SecondPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		m_horizontal = 1;
 		unsigned int amount = ResourceManager::getConfigValue(Config::BloomBlurFactor);
 
@@ -13,6 +13,7 @@
 #include "independent/systems/systems/sceneManager.h"
 #include "independent/rendering/renderers/renderer3D.h"
 #include "independent/rendering/renderers/renderer2D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -63,10 +64,12 @@ namespace Engine
 
 	//! onRender()
 	/*!
-	\param entities a std::vector<Entity*>& - The list of entities to render
+	\param entities a FrameVector<Entity*>& - The list of entities to render
 	*/
-	void ThirdPass::onRender(std::vector<Entity*>& entities)
+	void ThirdPass::onRender(FrameVector<Entity*>& entities)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		// Bind the bloom fbo (Blur)
 		m_frameBuffer->bind();
 
@@ -9,6 +9,7 @@
 #include "independent/rendering/renderUtils.h"
 #include "independent/systems/components/scene.h"
 #include "independent/rendering/renderers/renderer3D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -26,6 +27,7 @@ namespace Engine
 		m_clipUBO->uploadData("u_plane", &reflecPlane);
 		m_clipUBO->uploadData("u_mode", &reflectMode);
 		RenderUtils::enableClipDistance(true);
+		Renderer3D::setCullPlane(reflecPlane);
 
 		Camera* cam = m_attachedScene->getMainCamera();
 		m_cameraUBO->uploadData("u_view", static_cast<void*>(&cam->getViewMatrix(true)));
@@ -44,6 +46,7 @@ namespace Engine
 		m_clipUBO->uploadData("u_plane", &refracPlane);
 		m_clipUBO->uploadData("u_mode", &refractMode);
 		RenderUtils::enableClipDistance(true);
+		Renderer3D::setCullPlane(refracPlane);
 
 		Camera* cam = m_attachedScene->getMainCamera();
 		m_cameraUBO->uploadData("u_view", static_cast<void*>(&cam->getViewMatrix(true)));
@@ -57,6 +60,14 @@ namespace Engine
 		m_refractionFrameBuffer = ResourceManager::getResource<FrameBuffer>("refractionFBO");
 		m_clipUBO = ResourceManager::getResource<UniformBuffer>("ClipUBO");
 		m_cameraUBO = ResourceManager::getResource<UniformBuffer>("CameraUBO");
+		m_reflectionInterval = 1;
+		m_frameCount = 0;
+
+		// The reflection changes little from frame to frame, so it can be drawn less often than the refraction
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (configData.find("water") != configData.end())
+			m_reflectionInterval = std::max(configData["water"].value("reflectionInterval", 1u), 1u);
+
 		s_initialised = true;
 	}
 
@@ -69,22 +80,8 @@ namespace Engine
 		s_initialised = false;
 	}
 
-	void WaterPass::onRender(std::vector<Entity*>& entities)
+	void WaterPass::renderScene(FrameVector<Entity*>& entities)
 	{
-		float normalMode = 0.f;
-
-		// Bind FBO
-		m_reflectionFrameBuffer->bind();
-		
-		glm::vec3 pos = m_attachedScene->getMainCamera()->getParent()->getParentEntity()->getComponent<Transform>()->getWorldPosition();
-		//pos += m_attachedScene->getMainCamera()->getParent()->getComponent<Transform>()->getLocalPosition();
-
-		float distance = 2 * (pos.y - 20.f);
-		pos.y -= distance;
-		m_attachedScene->getMainCamera()->getParent()->getParentEntity()->getComponent<Transform>()->setLocalPosition(pos);
-		m_attachedScene->getMainCamera()->inversePitch();
-		setupPass();
-		
 		RenderUtils::enablePatchDrawing(true);
 
 		Renderer3D::begin();
@@ -122,54 +119,52 @@ namespace Engine
 			skybox->onRender();
 
 		Renderer3D::end();
+	}
+
+	void WaterPass::renderReflection(FrameVector<Entity*>& entities)
+	{
+		// Bind FBO
+		m_reflectionFrameBuffer->bind();
+		
+		glm::vec3 pos = m_attachedScene->getMainCamera()->getParent()->getParentEntity()->getComponent<Transform>()->getWorldPosition();
+		//pos += m_attachedScene->getMainCamera()->getParent()->getComponent<Transform>()->getLocalPosition();
+
+		float distance = 2 * (pos.y - 20.f);
+		pos.y -= distance;
+		m_attachedScene->getMainCamera()->getParent()->getParentEntity()->getComponent<Transform>()->setLocalPosition(pos);
+		m_attachedScene->getMainCamera()->inversePitch();
+		setupPass();
+
+		renderScene(entities);
 
 		pos.y += distance;
 		m_attachedScene->getMainCamera()->getParent()->getParentEntity()->getComponent<Transform>()->setLocalPosition(pos);
 		m_attachedScene->getMainCamera()->inversePitch();
+	}
 
+	void WaterPass::renderRefraction(FrameVector<Entity*>& entities)
+	{
 		// Bind FBO
 		m_refractionFrameBuffer->bind();
 		setupPass1();
 
-		RenderUtils::enablePatchDrawing(true);
-
-		Renderer3D::begin();
-		for (auto& entity : entities)
-		{
-			if (entity->getLayer()->getDisplayed() && entity->getDisplay())
-			{
-				if (entity->containsComponent<NativeScript>())
-					entity->getComponent<NativeScript>()->onRender(Renderers::Renderer3D, "Terrain");
-			}
-		}
-		Renderer3D::end();
-
-		RenderUtils::enablePatchDrawing(false);
-		RenderUtils::enableWireframe(false);
-		RenderUtils::enableFaceCulling(false);
-		Renderer3D::begin();
-		// Go through each 3D object (including light source objects) + skybox and render them to HDR buffer + brightness texture
-		for (auto& entity : entities)
-		{
-			if (entity->getLayer()->getDisplayed() && entity->getDisplay())
-			{
-				if (entity->getName() == "Water1") continue;
+		renderScene(entities);
+	}
 
-				if (entity->containsComponent<MeshRender3D>())
-					entity->getComponent<MeshRender3D>()->onRender();
+	void WaterPass::onRender(FrameVector<Entity*>& entities)
+	{
+		ENGINE_PROFILE_FUNCTION();
 
-				if (entity->containsComponent<NativeScript>())
-					entity->getComponent<NativeScript>()->onRender(Renderers::Renderer3D, "Default");
-			}
-		}
+		float normalMode = 0.f;
 
-		skybox = m_attachedScene->getMainCamera()->getSkybox();
-		if (skybox)
-			skybox->onRender();
+		// The reflection keeps what it last drew on the frames it is skipped
+		if (m_frameCount++ % m_reflectionInterval == 0)
+			renderReflection(entities);
 
-		Renderer3D::end();
+		renderRefraction(entities);
 
 		RenderUtils::enableClipDistance(false);
+		Renderer3D::clearCullPlane();
 		m_clipUBO->uploadData("u_mode", &normalMode);
 	}
 
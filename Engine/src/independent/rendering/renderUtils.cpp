@@ -481,6 +481,38 @@ namespace Engine
 		}
 	}
 
+	//! drawInstanced()
+	/*!
+	\param drawCount a const uint32_t - The number of indices
+	\param instanceCount a const uint32_t - The number of instances
+	*/
+	void RenderUtils::drawInstanced(const uint32_t drawCount, const uint32_t instanceCount)
+	{
+		switch (RenderAPI::getAPI())
+		{
+		case GraphicsAPI::None:
+		{
+			ENGINE_ERROR("[RenderUtils::drawInstanced] No rendering API selected.");
+			break;
+		}
+		case GraphicsAPI::OpenGL:
+		{
+			OpenGLRenderUtils::drawInstanced(drawCount, instanceCount);
+			break;
+		}
+		case GraphicsAPI::Direct3D:
+		{
+			ENGINE_ERROR("[RenderUtils::drawInstanced] Direct3D not supported.");
+			break;
+		}
+		case GraphicsAPI::Vulkan:
+		{
+			ENGINE_ERROR("[RenderUtils::drawInstanced] Vulkan not supported.");
+			break;
+		}
+		}
+	}
+
 	//! drawMultiIndirect()
 	/*!
 	\param commandsSize a const uint32_t - The number of commands
@@ -10,6 +10,7 @@
 #include "independent/systems/systems/fontManager.h"
 #include "independent/rendering/renderers/utils/fillBuffers.h"
 #include "independent/rendering/renderUtils.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -17,10 +18,12 @@ namespace Engine
 	TextureUnitManager* Renderer2D::s_unitManager = nullptr; //!< Set to null pointer
 	std::array<int32_t, 16> Renderer2D::s_unit; //!< Initialise to empty array
 	std::vector<BatchEntry2D> Renderer2D::s_batchQueue = std::vector<BatchEntry2D>(); //!< Initialise to empty list
+	std::vector<BatchEntry2D> Renderer2D::s_drawQueue = std::vector<BatchEntry2D>(); //!< Initialise to empty list
+	uint32_t Renderer2D::s_queuedInstances = 0; //!< Set to 0
 
 	//! initialise()
 	/*!
-	\param batchCapacity a const uint32_t - The total number of 2D geometry submissions before a flush occurs
+	\param batchCapacity a const uint32_t - The total number of 2D geometry submissions before a flush occurs, set by the memory given to the instance buffer
 	*/
 	void Renderer2D::initialise(const uint32_t batchCapacity)
 	{
@@ -30,10 +33,12 @@ namespace Engine
 			ENGINE_ERROR("[Renderer2D::initialise] An unusual batch capacity was provided. Value: {0}.", batchCapacity);
 
 		// Set the batch capacity
+		// The queues are not reserved to the capacity as it can be very large, they grow to the busiest frame and keep their memory
 		s_batchCapacity = batchCapacity;
 
 		// Create the index buffer used for 2D rendering and register it with the resource manager to handle
-		std::vector<uint32_t> indicesData = Quad::getIndices(batchCapacity);
+		// Every quad is an instance, so only the indices of one quad are needed
+		std::vector<uint32_t> indicesData = Quad::getIndices(1);
 		IndexBuffer* indexBuffer = IndexBuffer::create("QuadIBuffer", indicesData.data(), static_cast<uint32_t>(indicesData.size()));
 		ResourceManager::registerResource("QuadIBuffer", indexBuffer);
 	}
@@ -42,14 +47,16 @@ namespace Engine
 	void Renderer2D::begin()
 	{
 		s_batchQueue.clear();
+		s_queuedInstances = 0;
 	}
 
 	//! submissionChecks()
 	/*
 	\param shaderProgram a ShaderProgram* - A pointer to the shader program
-	\param subTextures a const std::vector<SubTexture*>& - A list of subtextures
+	\param subTextures a SubTexture* const* - The subtextures
+	\param subTextureCount a const uint32_t - The number of subtextures
 	*/
-	bool Renderer2D::submissionChecks(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures)
+	bool Renderer2D::submissionChecks(ShaderProgram* shaderProgram, SubTexture* const* subTextures, const uint32_t subTextureCount)
 	{
 		// Check shader program, base textures and subtextures for validity
 		if (!shaderProgram)
@@ -58,8 +65,9 @@ namespace Engine
 			return false;
 		}
 
-		for (auto& subTexture : subTextures)
+		for (uint32_t i = 0; i < subTextureCount; i++)
 		{
+			SubTexture* subTexture = subTextures[i];
 			if (subTexture)
 			{
 				if (!subTexture->getBaseTexture())
@@ -77,37 +85,70 @@ namespace Engine
 		return true;
 	}
 
-	//! submit()
+	//! submitEntry()
 	/*!
 	\param shaderProgram a ShaderProgram* - A pointer to the shader program
-	\param subTextures a const std::vector<SubTexture*>& - A list of subtextures
+	\param subTextures a SubTexture* const* - The subtextures
+	\param subTextureCount a const uint32_t - The number of subtextures
 	\param modelMatrix a const glm::mat4& - A model matrix
-	\param tint a const glm::vec4& - The tint to apply
+	\param parameters a const MaterialParameters& - The parameters of this submission
 	*/
-	void Renderer2D::submit(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures, const glm::mat4& modelMatrix, const glm::vec4& tint)
+	void Renderer2D::submitEntry(ShaderProgram* shaderProgram, SubTexture* const* subTextures, const uint32_t subTextureCount, const glm::mat4& modelMatrix, const MaterialParameters& parameters)
 	{
 		// First lets do some error checking
-		if (submissionChecks(shaderProgram, subTextures))
+		if (submissionChecks(shaderProgram, subTextures, subTextureCount))
 		{
 			/////
 			// Submitting
 			/////
 
 			// We need to check if this new submission would take us over capacity, if it does, flush the current contents and try submitting again
-			if (s_batchQueue.size() >= s_batchCapacity)
+			if (s_queuedInstances >= s_batchCapacity)
 				flush();
 
 			// Each subtexture has a base texture which needs a texture unit to be bound to, so lets create a units list equal to the subtexture size
-			std::vector<int32_t> units;
-			units.resize(subTextures.size());
+			// Both lists live in frame memory so submitting allocates nothing from the heap
+			LinearArena& arena = FrameAllocator::getArena();
+
+			const char* name = "Submission";
+			if (subTextureCount != 0)
+				name = subTextures[0]->getName().c_str();
+
+			// Add to the back of the queue [SHADER, SUBTEXTURES, UNITS, MODELMATRIX, PARAMETERS]
+			// Only the instance ID of the parameters is kept, so submissions which differ in nothing else are drawn together
+			s_batchQueue.push_back({ name, shaderProgram, FrameVector<SubTexture*>(subTextures, subTextures + subTextureCount, arena), FrameVector<int32_t>(subTextureCount, 0, arena),
+				modelMatrix, MaterialParameterBuffer::add(parameters), nullptr, 1 });
+			s_queuedInstances++;
+		}
+	}
 
-			std::string name = "Submission";
-			if (subTextures.size() != 0)
-				name = subTextures.at(0)->getName();
+	//! submit()
+	/*!
+	\param shaderProgram a ShaderProgram* - A pointer to the shader program
+	\param subTextures a const std::vector<SubTexture*>& - A list of subtextures
+	\param modelMatrix a const glm::mat4& - A model matrix
+	\param tint a const glm::vec4& - The tint to apply
+	*/
+	void Renderer2D::submit(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures, const glm::mat4& modelMatrix, const glm::vec4& tint)
+	{
+		MaterialParameters parameters;
+		parameters.Tint = tint;
+		if (!subTextures.empty() && subTextures[0])
+			parameters.UVRect = { subTextures[0]->getUVStart(), subTextures[0]->getUVEnd() };
 
-			// Add to the back of the queue [SHADER, SUBTEXTURES, UNITS, MODELMATRIX, TINT]
-			s_batchQueue.push_back({ name, shaderProgram, subTextures, units, modelMatrix, tint });
-		}
+		submitEntry(shaderProgram, subTextures.data(), static_cast<uint32_t>(subTextures.size()), modelMatrix, parameters);
+	}
+
+	//! submit()
+	/*!
+	\param shaderProgram a ShaderProgram* - A pointer to the shader program
+	\param subTextures a const std::vector<SubTexture*>& - A list of subtextures
+	\param modelMatrix a const glm::mat4& - A model matrix
+	\param parameters a const MaterialParameters& - The parameters of this submission, such as those of a material instance
+	*/
+	void Renderer2D::submit(ShaderProgram* shaderProgram, const std::vector<SubTexture*>& subTextures, const glm::mat4& modelMatrix, const MaterialParameters& parameters)
+	{
+		submitEntry(shaderProgram, subTextures.data(), static_cast<uint32_t>(subTextures.size()), modelMatrix, parameters);
 	}
 
 	//! submitText()
@@ -124,7 +165,8 @@ namespace Engine
 			return;
 		}
 
-		submitText(text->getText(), text->getFont(), text->getColour(), modelMatrix);
+		// The component keeps its layout, so unchanged text is not laid out again
+		submitGlyphRun(text->getGlyphRun(), text->getColour(), modelMatrix);
 	}
 
 	//! submitText()
@@ -136,18 +178,8 @@ namespace Engine
 	*/
 	void Renderer2D::submitText(const std::string& text, const std::string& fontName, const glm::vec4& tint, const glm::mat4& modelMatrix)
 	{
-		// Get the length of the text we're rendering
-		uint32_t len = static_cast<uint32_t>(strlen(text.c_str()));
-
 		// If the legnth of the text is 0, lets not bother doing any more processing and return
-		if (len == 0) return;
-
-		// Text will only ever use one specific material, so lets check that from the resource manager
-		Material* material = ResourceManager::getResource<Material>("textMaterial");
-		if (!material) return;
-
-		// Get x position of the entity from the model matrix, and keep the current advance
-		float advance = 0.f, x = modelMatrix[3][0];
+		if (text.empty()) return;
 
 		// Get the font for this text render
 		auto font = FontManager::getFont(fontName);
@@ -158,39 +190,70 @@ namespace Engine
 			return;
 		}
 
-		// For each character we want to render
-		for (int i = 0; i < static_cast<int>(len); i++)
-		{
-			// Get the character by indexing
-			char ch = text.at(i);
+		// Text without a component to keep its layout is laid out every time it is submitted
+		// The run does not live until the flush, so its quads are copied into frame memory
+		GlyphRun glyphRun;
+		glyphRun.build(text, font);
+		const std::vector<QuadInstance2D>& instances = glyphRun.getInstances(glm::vec3(modelMatrix[3]), tint);
+		if (instances.empty()) return;
 
-			// Check whether this character has a glyph data associated with it, we check this by making sure the character is in between the range of the
-			// first and last glyph
-			if (ch > font->getFirstGlyph() && ch <= font->getLastGlyph())
-			{
-				// Get the character's glyph data from the font
-				GlyphData& gd = font->getGlyphData().at(ch - font->getFirstGlyph());
+		QuadInstance2D* frameInstances = static_cast<QuadInstance2D*>(FrameAllocator::getArena().allocate(sizeof(QuadInstance2D) * instances.size(), alignof(QuadInstance2D)));
+		memcpy(frameInstances, instances.data(), sizeof(QuadInstance2D) * instances.size());
+		submitGlyphs(glyphRun, frameInstances, tint, modelMatrix);
+	}
 
-				// Create the position and size of the text quad
-				glm::vec2 pos = { x, modelMatrix[3][1] };
-				glm::vec2 glyphHalfExtents(gd.size * 0.5f);
-				glm::vec2 glyphCentre = (pos + gd.bearing) + glyphHalfExtents;
+	//! submitGlyphRun()
+	/*!
+	\param glyphRun a GlyphRun& - The text laid out in its font, its quads are read when the batch is flushed so it must live until then
+	\param tint a const glm::vec4& - The colour of the text
+	\param modelMatrix a const glm::mat4& - A model matrix, only its translation is used
+	*/
+	void Renderer2D::submitGlyphRun(GlyphRun& glyphRun, const glm::vec4& tint, const glm::mat4& modelMatrix)
+	{
+		if (glyphRun.getGlyphs().empty()) return;
 
-				advance = gd.advance;
+		// The run keeps its quads until it moves or changes colour, so still text is queued without building anything
+		submitGlyphs(glyphRun, glyphRun.getInstances(glm::vec3(modelMatrix[3]), tint).data(), tint, modelMatrix);
+	}
 
-				// Create a new model matrix
-				glm::mat4 model = glm::mat4(1.f);
-				model = glm::translate(model, glm::vec3(glyphCentre, modelMatrix[3][2]));
-				model = glm::scale(model, glm::vec3(glyphHalfExtents * 2.f, 0.f));
+	//! submitGlyphs()
+	/*!
+	\param glyphRun a const GlyphRun& - The text laid out in its font
+	\param instances a QuadInstance2D* - The quad of each glyph, they must live until the batch is flushed
+	\param tint a const glm::vec4& - The colour of the text
+	\param modelMatrix a const glm::mat4& - A model matrix, only its translation is used
+	*/
+	void Renderer2D::submitGlyphs(const GlyphRun& glyphRun, QuadInstance2D* instances, const glm::vec4& tint, const glm::mat4& modelMatrix)
+	{
+		const std::vector<PositionedGlyph>& glyphs = glyphRun.getGlyphs();
+		if (glyphs.empty()) return;
+
+		// Text only uses the text material, or the distance field text material when the font's glyphs are distance fields
+		Material* material = ResourceManager::getResource<Material>(glyphRun.isSDF() ? "sdfTextMaterial" : "textMaterial");
+		if (!material || !submissionChecks(material->getShader(), nullptr, 0)) return;
+
+		ShaderProgram* shader = material->getShader();
+		MaterialParameters parameters = material->getParameters();
+		parameters.Tint = tint;
+		const uint32_t parameterID = MaterialParameterBuffer::add(parameters);
+
+		// Every glyph is in the font's atlas, so the first glyph's subtexture binds the texture for the whole run
+		// The run is one entry unless it does not fit in what is left of the batch, then it is split across flushes
+		SubTexture* const* atlas = &glyphs[0].Texture;
+		LinearArena& arena = FrameAllocator::getArena();
+		const uint32_t count = static_cast<uint32_t>(glyphs.size());
+		uint32_t offset = 0;
+		while (offset < count)
+		{
+			if (s_queuedInstances >= s_batchCapacity)
+				flush();
 
-				// Update the material's subtexture to the subtexture of the glyph we want to render
-				material->setSubTexture(0, gd.subTexture);
-				// Now we can submit this new quad
-				submit(material->getShader(), material->getSubTextures(), model, tint);
-			}
+			const uint32_t spanCount = std::min(count - offset, s_batchCapacity - s_queuedInstances);
+			s_batchQueue.push_back({ (*atlas)->getName().c_str(), shader, FrameVector<SubTexture*>(atlas, atlas + 1, arena), FrameVector<int32_t>(1, 0, arena),
+				modelMatrix, parameterID, instances + offset, spanCount });
 
-			// Move the x position along by the advance
-			x += advance;
+			s_queuedInstances += spanCount;
+			offset += spanCount;
 		}
 	}
 
@@ -213,6 +276,8 @@ namespace Engine
 	//! flush()
 	void Renderer2D::flush()
 	{
+		CounterSystem::increment(Counter::BatchFlushes2D);
+
 		/////
 		// SORTING SHADERS
 		/////
@@ -221,15 +286,14 @@ namespace Engine
 		/////
 		// Begin setting the necassary data
 		/////
-		std::vector<BatchEntry2D> tmpList;
+		std::vector<BatchEntry2D>& tmpList = s_drawQueue;
 		ShaderProgram* currentShader = s_batchQueue.at(0).shader;
 		for (auto& submission : s_batchQueue)
 		{
 			// If we've moved onto a new shader, draw the current list
 			if (submission.shader != currentShader)
 			{
-				generateVertexList(tmpList);
-				draw(tmpList);
+				draw(tmpList, generateQuadInstances(tmpList));
 				tmpList.clear();
 				currentShader = submission.shader;
 			}
@@ -237,8 +301,7 @@ namespace Engine
 			// If we cannot bind the textures for the current submission, draw the current list
 			if (s_unitManager->getRemainingUnitCount() < submission.subTextures.size())
 			{
-				generateVertexList(tmpList);
-				draw(tmpList);
+				draw(tmpList, generateQuadInstances(tmpList));
 				s_unitManager->clear(true);
 				tmpList.clear();
 			}
@@ -255,51 +318,41 @@ namespace Engine
 				submission.textureUnits.at(i) = unit;
 			}
 
-			tmpList.push_back(submission);
+			// The submission is not used again once it is in the list
+			tmpList.push_back(std::move(submission));
 		}
 
 		// Draw anything left in the list
 		if (tmpList.size() != 0)
-		{
-			generateVertexList(tmpList);
-			draw(tmpList);
-		}
+			draw(tmpList, generateQuadInstances(tmpList));
 
 		// All shader entries have been drawn, lets clear all data
 		s_batchQueue.clear();
 		tmpList.clear();
+		s_queuedInstances = 0;
 	}
 
 	//! draw()
 	/*
 	\param submissionList a std::vector<BatchEntry2D>& - A list of submissions
+	\param instanceCount a const uint32_t - The number of quads the submissions filled the instance buffer with
 	*/
-	void Renderer2D::draw(std::vector<BatchEntry2D>& submissionList)
+	void Renderer2D::draw(std::vector<BatchEntry2D>& submissionList, const uint32_t instanceCount)
 	{
 		if (submissionList.size() != 0)
 		{
 			// Use the shader program
 			submissionList.at(0).shader->start();
 
-			// Attach the UBO
-			for (auto& dataPair : submissionList.at(0).shader->getUniformBuffers())
-			{
-				const char* nameOfUniformBlock = dataPair.first.c_str();
-				dataPair.second->attachShaderBlock(submissionList.at(0).shader, nameOfUniformBlock);
-			}
-
-			// Normally we need to check what kind of uniforms we have to send
-			// I don't think we will ever use anything other than 2D samplers for 2D rendering
-			// This will be different for 3D rendering
-			submissionList.at(0).shader->sendIntArray("u_textures", s_unit.data(), 16);
+			// The uniform blocks and sampler units were bound once when the shader was linked
 
 			// Bind VAO
 			submissionList.at(0).shader->getVertexArray()->bind();
 			ResourceManager::getResource<IndexBuffer>("QuadIBuffer")->bind();
 
 			// Issue the draw call
-			// The number of submissions for the shader that we want to render * 6 indices
-			RenderUtils::draw(static_cast<uint32_t>(submissionList.size()) * 6);
+			// 6 indices for one quad, drawn once for every quad of the shader's submissions
+			RenderUtils::drawInstanced(6, instanceCount);
 		}
 	}
 
@@ -319,6 +372,7 @@ namespace Engine
 		// Clean up renderer data
 		s_unitManager = nullptr;
 		s_batchQueue.clear();
+		s_queuedInstances = 0;
 	}
 
 	//! setTextureUnitManager()
@@ -9,6 +9,8 @@
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/rendering/renderers/utils/fillBuffers.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -19,10 +21,14 @@ namespace Engine
 	uint32_t Renderer3D::s_indexCapacity = 0; //!< Initialise to 0
 
 	std::vector<BatchEntry3D> Renderer3D::s_batchQueue = std::vector<BatchEntry3D>(); //!< Initialise to empty list
+	std::vector<BatchEntry3D> Renderer3D::s_drawQueue = std::vector<BatchEntry3D>(); //!< Initialise to empty list
 	std::map<VertexBuffer*, std::vector<DrawElementsIndirectCommand>> Renderer3D::s_batchCommandsQueue; //!< Initialise to empty list
 	std::map<VertexBuffer*, uint32_t> Renderer3D::s_nextVertex = std::map<VertexBuffer*, uint32_t>(); //!< Initialise to empty list
 	uint32_t Renderer3D::s_nextIndex = 0; //!< Initialise to  0
 	IndirectBuffer* Renderer3D::s_indirectBuffer = nullptr; //!< Initialise to null pointer
+	std::map<VertexBuffer*, std::vector<AABB>> Renderer3D::s_localBounds; //!< Initialise to empty list
+	bool Renderer3D::s_cullPlaneEnabled = false; //!< Initialise to false
+	glm::vec4 Renderer3D::s_cullPlane = glm::vec4(0.f); //!< Initialise to 0
 
 	//! clearBatch()
 	void Renderer3D::clearBatch()
@@ -55,6 +61,8 @@ namespace Engine
 		s_batchCapacity = batchCapacity;
 		s_vertexCapacity = vertexCapacity;
 		s_indexCapacity = indexCapacity;
+		s_batchQueue.reserve(batchCapacity);
+		s_drawQueue.reserve(batchCapacity);
 
 		// Set the indirect buffer by retrieving it from the resource manager
 		IndirectBuffer* indirectBuffer = IndirectBuffer::create("indirectBuffer", nullptr, batchCapacity);
@@ -122,6 +130,57 @@ namespace Engine
 	\param modelMatrix a const glm::mat4& - A model matrix
 	*/
 	void Renderer3D::submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::mat4& modelMatrix)
+	{
+		submit(submissionName, geometry, material, modelMatrix, material ? material->getParameters() : MaterialParameters());
+	}
+
+	//! submit()
+	/*!
+	\param submissionName a const std::string& - The name of the submission
+	\param geometry a Geometry3D - A piece of 3D geometry
+	\param material a Material* - A pointer to a material, only its shader and textures are used
+	\param modelMatrix a const glm::mat4& - A model matrix
+	\param parameters a const MaterialParameters& - The parameters of this submission, such as those of a material instance
+	*/
+	void Renderer3D::submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::mat4& modelMatrix, const MaterialParameters& parameters)
+	{
+		BatchEntry3D* entry = queueSubmission(submissionName, geometry, material, parameters);
+		if (entry)
+			entry->modelMatrix = modelMatrix;
+	}
+
+	//! submit()
+	/*!
+	\param submissionName a const std::string& - The name of the submission
+	\param geometry a Geometry3D - A piece of 3D geometry
+	\param material a Material* - A pointer to a material, only its shader and textures are used
+	\param position a const glm::vec3& - The position
+	\param orientation a const glm::vec3& - The rotation around x, y and z in degrees
+	\param scale a const glm::vec3& - The scale
+	\param parameters a const MaterialParameters& - The parameters of this submission, such as those of a material instance
+	*/
+	void Renderer3D::submit(const std::string& submissionName, Geometry3D geometry, Material* material, const glm::vec3& position, const glm::vec3& orientation, const glm::vec3& scale, const MaterialParameters& parameters)
+	{
+		// The matrix is built when the instance data is filled, four at a time straight into the upload
+		BatchEntry3D* entry = queueSubmission(submissionName, geometry, material, parameters);
+		if (entry)
+		{
+			entry->position = position;
+			entry->orientation = orientation;
+			entry->scale = scale;
+			entry->composeMatrix = true;
+		}
+	}
+
+	//! queueSubmission()
+	/*!
+	\param submissionName a const std::string& - The name of the submission
+	\param geometry a Geometry3D& - A piece of 3D geometry
+	\param material a Material* - A pointer to a material, only its shader and textures are used
+	\param parameters a const MaterialParameters& - The parameters of this submission
+	eturn a BatchEntry3D* - The queued entry with an identity model matrix, nullptr if nothing was queued
+	*/
+	BatchEntry3D* Renderer3D::queueSubmission(const std::string& submissionName, Geometry3D& geometry, Material* material, const MaterialParameters& parameters)
 	{
 		// First lets do some error checking
 		if (submissionChecks(material, geometry))
@@ -136,15 +195,19 @@ namespace Engine
 				flushBatch();
 			else
 			{
-				std::vector<int32_t> units;
-				units.resize(material->getSubTextures().size());
-
-				std::vector<int32_t> cubeUnits;
-				cubeUnits.resize(material->getCubemapTextures().size());
-
-				s_batchQueue.push_back({ submissionName, geometry, shader, material->getSubTextures(), material->getCubemapTextures(), units, cubeUnits, material->getShininess(), modelMatrix, material->getTint() });
+				// Every list in the entry lives in frame memory so submitting allocates nothing from the heap
+				LinearArena& arena = FrameAllocator::getArena();
+				const std::vector<SubTexture*>& subTextures = material->getSubTextures();
+				const std::vector<CubeMapTexture*>& cubeTextures = material->getCubemapTextures();
+
+				s_batchQueue.push_back({ FrameAllocator::copyString(submissionName), geometry, shader,
+					FrameVector<SubTexture*>(subTextures.begin(), subTextures.end(), arena), FrameVector<CubeMapTexture*>(cubeTextures.begin(), cubeTextures.end(), arena),
+					FrameVector<int32_t>(subTextures.size(), 0, arena), FrameVector<int32_t>(cubeTextures.size(), 0, arena), glm::mat4(1.f),
+					glm::vec3(0.f), glm::vec3(0.f), glm::vec3(1.f), false, MaterialParameterBuffer::add(parameters) });
+				return &s_batchQueue.back();
 			}
 		}
+		return nullptr;
 	}
 
 	//! sortSubmissions()
@@ -166,6 +229,9 @@ namespace Engine
 	//! flushBatch()
 	void Renderer3D::flushBatch()
 	{
+		ENGINE_PROFILE_FUNCTION();
+		CounterSystem::increment(Counter::BatchFlushes3D);
+
 		/////
 		// SORTING SHADERS
 		/////
@@ -174,7 +240,7 @@ namespace Engine
 		/////
 		// Begin setting the necassary data
 		/////
-		std::vector<BatchEntry3D> tmpList;
+		std::vector<BatchEntry3D>& tmpList = s_drawQueue;
 		ShaderProgram* currentShader = s_batchQueue.at(0).shader;
 		uint32_t runningInstanceCount = 0;
 		int32_t unit = 0;
@@ -244,7 +310,8 @@ namespace Engine
 			commands.InstanceCount++;
 			runningInstanceCount++;
 
-			tmpList.push_back(submission);
+			// The submission is not used again once it is in the list
+			tmpList.push_back(std::move(submission));
 		}
 
 		// Draw anything left in the list
@@ -314,17 +381,7 @@ namespace Engine
 				// Start the shader
 				queue.at(0).shader->start();
 
-				// Attach all the UBOs to the shader blocks
-				for (auto& dataPair : queue.at(0).shader->getUniformBuffers())
-				{
-					const char* nameOfUniformBlock = dataPair.first.c_str();
-					dataPair.second->attachShaderBlock(queue.at(0).shader, nameOfUniformBlock);
-				}
-
-				// Upload texture units
-				auto uniforms = queue.at(0).shader->getUniforms();
-				if (uniforms.find("u_diffuseMap") != uniforms.end()) queue.at(0).shader->sendIntArray("u_diffuseMap", s_unit.data(), 16);
-				if (uniforms.find("u_cubeMap") != uniforms.end()) queue.at(0).shader->sendIntArray("u_cubeMap", s_unit.data(), 16);
+				// The uniform blocks and sampler units were bound once when the shader was linked
 
 				// Bind VAO which provides all of the attributes and the VBOs which provide the data
 				VertexArray* vArray = queue.at(0).shader->getVertexArray();
@@ -359,6 +416,8 @@ namespace Engine
 		s_unitManager = nullptr;
 		s_batchQueue.clear();
 		s_batchCommandsQueue.clear();
+		s_localBounds.clear();
+		s_cullPlaneEnabled = false;
 
 		if (s_indirectBuffer) delete s_indirectBuffer;
 		s_indirectBuffer = nullptr;
@@ -376,17 +435,80 @@ namespace Engine
 		s_unit = unit;
 	}
 
+	//! setCullPlane()
+	/*!
+	\param plane a const glm::vec4& - The clip plane, the same one given to the shaders
+	*/
+	void Renderer3D::setCullPlane(const glm::vec4& plane)
+	{
+		s_cullPlane = plane;
+		s_cullPlaneEnabled = true;
+	}
+
+	//! clearCullPlane()
+	void Renderer3D::clearCullPlane()
+	{
+		s_cullPlaneEnabled = false;
+	}
+
+	//! isClipped()
+	/*!
+	\param worldBounds a const AABB& - The world bounds of a submission
+	\return a const bool - Is the box completely below the clip plane, always false when there isn't one
+	*/
+	const bool Renderer3D::isClipped(const AABB& worldBounds)
+	{
+		if (!s_cullPlaneEnabled) return false;
+
+		// The corner furthest along the plane's normal, if it is below the plane so is the rest of the box
+		const glm::vec3 corner = { s_cullPlane.x >= 0.f ? worldBounds.Max.x : worldBounds.Min.x, s_cullPlane.y >= 0.f ? worldBounds.Max.y : worldBounds.Min.y,
+			s_cullPlane.z >= 0.f ? worldBounds.Max.z : worldBounds.Min.z };
+
+		if (glm::dot(glm::vec3(s_cullPlane), corner) + s_cullPlane.w >= 0.f) return false;
+
+		CounterSystem::increment(Counter::SubmissionsClipped);
+		return true;
+	}
+
+	//! isClipped()
+	/*!
+	\param geometry a const Geometry3D& - A piece of model geometry
+	\param modelMatrix a const glm::mat4& - The model matrix it will be submitted with
+	\return a const bool - Is the geometry completely below the clip plane, false when its bounds are not known
+	*/
+	const bool Renderer3D::isClipped(const Geometry3D& geometry, const glm::mat4& modelMatrix)
+	{
+		if (!s_cullPlaneEnabled) return false;
+
+		auto bounds = s_localBounds.find(geometry.VertexBuffer);
+		if (bounds == s_localBounds.end() || geometry.ID >= bounds->second.size()) return false;
+
+		AABB worldBounds;
+		BatchTransforms::transformBounds(&modelMatrix, &bounds->second[geometry.ID], &worldBounds, 1);
+		return isClipped(worldBounds);
+	}
+
 	//! addGeometry()
 	/*!
-	\param vertices a std::vector<Vertex3D>& - The list of vertices
-	\param indices a std::vector<uint32_t>& - The list of indices
+	\param vertices a const std::vector<Vertex3D>& - The list of vertices
+	\param indices a const std::vector<uint32_t>& - The list of indices
 	\param geometry a Geometry3D& - A reference to the model's geometry
 	*/
-	void Renderer3D::addGeometry(std::vector<Vertex3D>& vertices, std::vector<uint32_t> indices, Geometry3D& geometry)
+	void Renderer3D::addGeometry(const std::vector<Vertex3D>& vertices, const std::vector<uint32_t>& indices, Geometry3D& geometry)
 	{
-		uint32_t vertexCount = static_cast<uint32_t>(vertices.size()); // The total number of vertices we're adding
-		uint32_t indexCount = static_cast<uint32_t>(indices.size()); // The total number of indices we're adding
+		addGeometry(vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()), geometry);
+	}
 
+	//! addGeometry()
+	/*!
+	\param vertices a const Vertex3D* - The first vertex, read straight from wherever it is kept such as a mapped cooked mesh
+	\param vertexCount a const uint32_t - The total number of vertices we're adding
+	\param indices a const uint32_t* - The first index
+	\param indexCount a const uint32_t - The total number of indices we're adding
+	\param geometry a Geometry3D& - A reference to the model's geometry
+	*/
+	void Renderer3D::addGeometry(const Vertex3D* vertices, const uint32_t vertexCount, const uint32_t* indices, const uint32_t indexCount, Geometry3D& geometry)
+	{
 		// Check a valid vertex count was provided
 		if (vertexCount == 0 || indexCount == 0)
 		{
@@ -415,8 +537,8 @@ namespace Engine
 		}
 
 		// Capacity wont be reached, so add the data to the buffer
-		VBO->edit(vertices.data(), static_cast<uint32_t>(vertices.size()) * sizeof(Vertex3D), s_nextVertex[VBO] * sizeof(Vertex3D));
-		IBO->edit(indices.data(), indexCount, s_nextIndex);
+		VBO->edit(vertices, vertexCount * sizeof(Vertex3D), s_nextVertex[VBO] * sizeof(Vertex3D));
+		IBO->edit(indices, indexCount, s_nextIndex);
 
 		// Create geometry data
 		geometry.ID = static_cast<uint32_t>(s_batchCommandsQueue[VBO].size());
@@ -429,6 +551,17 @@ namespace Engine
 		s_nextVertex[VBO] += vertexCount;
 		s_nextIndex += indexCount;
 		s_batchCommandsQueue[VBO].push_back({ 0, 0, 0, 0, 0 });
+
+		// Keep the bounds so submissions can be culled without touching the vertices again
+		AABB bounds = { vertices[0].Position, vertices[0].Position };
+		for (uint32_t i = 1; i < vertexCount; i++)
+		{
+			bounds.Min = glm::min(bounds.Min, vertices[i].Position);
+			bounds.Max = glm::max(bounds.Max, vertices[i].Position);
+		}
+		std::vector<AABB>& localBounds = s_localBounds[VBO];
+		if (localBounds.size() <= geometry.ID) localBounds.resize(geometry.ID + 1);
+		localBounds[geometry.ID] = bounds;
 	}
 
 	//! addGeometry()
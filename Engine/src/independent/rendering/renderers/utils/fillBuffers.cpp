@@ -6,92 +6,104 @@
 *
 */
 #include "independent/rendering/renderers/utils/fillBuffers.h"
+#include "independent/utils/batchTransforms.h"
+#include "independent/utils/frameAllocator.h"
 
 namespace Engine
 {
-	//! generateVertexList()
+	//! generateQuadInstances()
 	/*
 	\param batchEntries a std::vector<BatchEntry2D>& - A list of batch entries
+	\return a const uint32_t - The number of quads written to the VBO
 	*/
-	void generateVertexList(std::vector<BatchEntry2D>& batchEntries)
+	const uint32_t generateQuadInstances(std::vector<BatchEntry2D>& batchEntries)
 	{
-		if (batchEntries.size() != 0)
-		{
-			// Generate a list of vertices and edit the VBO depending on the vertex array
-			if (batchEntries.at(0).shader->getVertexArray()->getName() == "QuadArray")
-				generateListOfVertex2D(batchEntries);
-			else if (batchEntries.at(0).shader->getVertexArray()->getName() == "QuadMultiTexturedArray")
-				generateListOfVertex2DMutlitextured(batchEntries);
-		}
-	}
+		if (batchEntries.size() == 0) return 0;
 
-	//! generateListOfVertex2D()
-	/*
-	\param batchEntries a std::vector<BatchEntry2D>& - A list of batch entries
-	*/
-	void generateListOfVertex2D(std::vector<BatchEntry2D>& batchEntries)
-	{
-		// Create a fresh new list of vertices and then edit the VBO
-		std::vector<Vertex2D> vertexList;
-		uint32_t count = static_cast<uint32_t>(batchEntries.size());
-		vertexList.resize(count * 4);
+		size_t instanceCount = 0;
+		for (auto& entry : batchEntries)
+			instanceCount += entry.instanceCount;
+
+		// Create a fresh new list of instances in scratch memory and then edit the VBO
+		// Each quad is a single record, its corners are worked out in the vertex shader
+		ScratchArena scratch;
+		ArenaVector<QuadInstance2D> instanceList = scratch.createVector<QuadInstance2D>(instanceCount);
+		instanceList.resize(instanceCount);
 
-		// Starting from the beginning of the list
-		uint32_t startIndex = 0;
+		size_t next = 0;
 		for (auto& entry : batchEntries)
 		{
-			// Edit the next 4 vertices in the list
-			for (int i = 0; i < 4; i++)
+			if (entry.instances)
 			{
-				vertexList[i + startIndex].Position = entry.modelMatrix * Quad::getLocalVertices().at(i).Position;
-				vertexList[i + startIndex].TexUnit = entry.textureUnits[0];
-				vertexList[i + startIndex].Tint = MemoryUtils::pack(entry.tint);
-			}
+				// A glyph run's quads are already built, only the unit its atlas was bound to can differ from the last time it was drawn
+				const int32_t unit = entry.textureUnits[0];
+				if (entry.instances[0].TexUnit1 != unit)
+				{
+					for (uint32_t i = 0; i < entry.instanceCount; i++)
+						entry.instances[i].TexUnit1 = unit;
+				}
 
-			vertexList[startIndex].TexCoords = entry.subTextures.at(0)->getUVEnd();
-			vertexList[startIndex + 1].TexCoords = { entry.subTextures.at(0)->getUVEnd().x, entry.subTextures.at(0)->getUVStart().y };
-			vertexList[startIndex + 2].TexCoords = entry.subTextures.at(0)->getUVStart();
-			vertexList[startIndex + 3].TexCoords = { entry.subTextures.at(0)->getUVStart().x, entry.subTextures.at(0)->getUVEnd().y };
+				memcpy(&instanceList[next], entry.instances, sizeof(QuadInstance2D) * entry.instanceCount);
+				next += entry.instanceCount;
+				continue;
+			}
 
-			startIndex += 4;
+			QuadInstance2D& instance = instanceList[next++];
+			BatchTransforms::decomposeQuad(entry.modelMatrix, instance.Transform, instance.Size);
+			const MaterialParameters& parameters = MaterialParameterBuffer::get(entry.parameters);
+			instance.UVRect = parameters.UVRect;
+			instance.Tint = MemoryUtils::pack(parameters.Tint);
+			instance.TexUnit1 = entry.textureUnits.size() > 0 ? entry.textureUnits[0] : 0;
+			instance.TexUnit2 = entry.textureUnits.size() > 1 ? entry.textureUnits[1] : 0;
 		}
 
-		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(0)->edit(vertexList.data(), static_cast<uint32_t>(sizeof(Vertex2D) * vertexList.size()), 0);
+		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(0)->edit(instanceList.data(), static_cast<uint32_t>(sizeof(QuadInstance2D) * instanceList.size()), 0);
+		return static_cast<uint32_t>(instanceCount);
 	}
 
-	//! generateListOfVertex2DMutlitextured()
+	//! fillModelMatrices()
 	/*
-	\param batchEntries a std::vector<BatchEntry2D>& - A list of batch entries
+	\param batchEntries a std::vector<BatchEntry3D>& - A list of batch entries
+	\param matrices an ArenaVector<glm::mat4>& - The model matrix of each entry, in the order of the entries
+	\param scratch a ScratchArena& - The scratch memory to gather the transforms in
 	*/
-	void generateListOfVertex2DMutlitextured(std::vector<BatchEntry2D>& batchEntries)
+	void fillModelMatrices(std::vector<BatchEntry3D>& batchEntries, ArenaVector<glm::mat4>& matrices, ScratchArena& scratch)
 	{
-		// Create a fresh new list of vertices and then edit the VBO
-		std::vector<Vertex2DMultiTextured> vertexList;
-		uint32_t count = static_cast<uint32_t>(batchEntries.size());
-		vertexList.resize(count * 4);
+		const size_t count = batchEntries.size();
+		matrices.resize(count);
 
-		// Starting from the beginning of the list
-		uint32_t startIndex = 0;
-		for (auto& entry : batchEntries)
+		ArenaVector<glm::vec3> positions = scratch.createVector<glm::vec3>(count);
+		ArenaVector<glm::vec3> orientations = scratch.createVector<glm::vec3>(count);
+		ArenaVector<glm::vec3> scales = scratch.createVector<glm::vec3>(count);
+		ArenaVector<uint32_t> slots = scratch.createVector<uint32_t>(count);
+
+		for (size_t i = 0; i < count; i++)
 		{
-			// Edit the next 4 vertices in the list
-			for (int i = 0; i < 4; i++)
+			BatchEntry3D& entry = batchEntries[i];
+			if (entry.composeMatrix)
 			{
-				vertexList[i + startIndex].Position = entry.modelMatrix * Quad::getLocalVertices().at(i).Position;
-				vertexList[i + startIndex].TexUnit1 = entry.textureUnits[0];
-				vertexList[i + startIndex].TexUnit2 = entry.textureUnits[1];
-				vertexList[i + startIndex].Tint = MemoryUtils::pack(entry.tint);
+				positions.push_back(entry.position);
+				orientations.push_back(entry.orientation);
+				scales.push_back(entry.scale);
+				slots.push_back(static_cast<uint32_t>(i));
 			}
+			else
+				matrices[i] = entry.modelMatrix;
+		}
 
-			vertexList[startIndex].TexCoords = entry.subTextures.at(0)->getUVEnd();
-			vertexList[startIndex + 1].TexCoords = { entry.subTextures.at(0)->getUVEnd().x, entry.subTextures.at(0)->getUVStart().y };
-			vertexList[startIndex + 2].TexCoords = entry.subTextures.at(0)->getUVStart();
-			vertexList[startIndex + 3].TexCoords = { entry.subTextures.at(0)->getUVStart().x, entry.subTextures.at(0)->getUVEnd().y };
+		if (slots.empty()) return;
 
-			startIndex += 4;
+		// When every entry gave a transform the matrices are composed straight into the upload, otherwise they are scattered into place
+		if (slots.size() == count)
+			BatchTransforms::composeModelMatrices(positions.data(), orientations.data(), scales.data(), matrices.data(), static_cast<uint32_t>(count));
+		else
+		{
+			ArenaVector<glm::mat4> composed = scratch.createVector<glm::mat4>(slots.size());
+			composed.resize(slots.size());
+			BatchTransforms::composeModelMatrices(positions.data(), orientations.data(), scales.data(), composed.data(), static_cast<uint32_t>(slots.size()));
+			for (size_t i = 0; i < slots.size(); i++)
+				matrices[slots[i]] = composed[i];
 		}
-
-		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(0)->edit(vertexList.data(), static_cast<uint32_t>(sizeof(Vertex2DMultiTextured) * vertexList.size()), 0);
 	}
 
 	//! generateInstanceData()
@@ -124,22 +136,23 @@ namespace Engine
 	*/
 	void generateBasic3D(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::mat4> modelInstanceData; //!< The model matrix instance data
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<int32_t> unit1InstanceData; //!< The texture unit data
-		std::vector<int32_t> unit2InstanceData; //!< The texture unit data
-		std::vector<float> shininessInstanceData; //!< The shininess data
-		std::vector<glm::vec4> subTextureUVs; //!< The Start and End UV coordinates of the subtexture
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::mat4> modelInstanceData = scratch.createVector<glm::mat4>(batchEntries.size()); //!< The model matrix instance data
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<int32_t> unit1InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<int32_t> unit2InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<float> shininessInstanceData = scratch.createVector<float>(batchEntries.size()); //!< The shininess data
+		ArenaVector<glm::vec4> subTextureUVs = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The Start and End UV coordinates of the subtexture
 
+		fillModelMatrices(batchEntries, modelInstanceData, scratch);
 		for (auto& entry : batchEntries)
 		{
-			modelInstanceData.push_back(entry.modelMatrix);
 			unit1InstanceData.push_back(entry.textureUnits[0]);
 			unit2InstanceData.push_back(entry.textureUnits[1]);
-			tintInstanceData.push_back(entry.tint);
-			shininessInstanceData.push_back(entry.shininess);
-			subTextureUVs.push_back(glm::vec4(entry.subTextures.at(0)->getUVStart().x, entry.subTextures.at(0)->getUVStart().y,
-				entry.subTextures.at(0)->getUVEnd().x, entry.subTextures.at(0)->getUVEnd().y));
+			const MaterialParameters& parameters = MaterialParameterBuffer::get(entry.parameters);
+			tintInstanceData.push_back(parameters.Tint);
+			shininessInstanceData.push_back(parameters.Scalars.x);
+			subTextureUVs.push_back(parameters.UVRect);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(modelInstanceData.data(), sizeof(glm::mat4) * static_cast<uint32_t>(batchEntries.size()), 0);
@@ -156,24 +169,25 @@ namespace Engine
 	*/
 	void generateNormal(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::mat4> modelInstanceData; //!< The model matrix instance data
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<int32_t> unit1InstanceData; //!< The texture unit data
-		std::vector<int32_t> unit2InstanceData; //!< The texture unit data
-		std::vector<int32_t> unit3InstanceData; //!< The texture unit data
-		std::vector<float> shininessInstanceData; //!< The shininess data
-		std::vector<glm::vec4> subTextureUVs; //!< The Start and End UV coordinates of the subtexture
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::mat4> modelInstanceData = scratch.createVector<glm::mat4>(batchEntries.size()); //!< The model matrix instance data
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<int32_t> unit1InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<int32_t> unit2InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<int32_t> unit3InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<float> shininessInstanceData = scratch.createVector<float>(batchEntries.size()); //!< The shininess data
+		ArenaVector<glm::vec4> subTextureUVs = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The Start and End UV coordinates of the subtexture
 
+		fillModelMatrices(batchEntries, modelInstanceData, scratch);
 		for (auto& entry : batchEntries)
 		{
-			modelInstanceData.push_back(entry.modelMatrix);
 			unit1InstanceData.push_back(entry.textureUnits[0]);
 			unit2InstanceData.push_back(entry.textureUnits[1]);
 			unit3InstanceData.push_back(entry.textureUnits[2]);
-			tintInstanceData.push_back(entry.tint);
-			shininessInstanceData.push_back(entry.shininess);
-			subTextureUVs.push_back(glm::vec4(entry.subTextures.at(0)->getUVStart().x, entry.subTextures.at(0)->getUVStart().y,
-				entry.subTextures.at(0)->getUVEnd().x, entry.subTextures.at(0)->getUVEnd().y));
+			const MaterialParameters& parameters = MaterialParameterBuffer::get(entry.parameters);
+			tintInstanceData.push_back(parameters.Tint);
+			shininessInstanceData.push_back(parameters.Scalars.x);
+			subTextureUVs.push_back(parameters.UVRect);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(modelInstanceData.data(), sizeof(glm::mat4) * static_cast<uint32_t>(batchEntries.size()), 0);
@@ -191,13 +205,14 @@ namespace Engine
 	*/
 	void generateSkybox(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<int32_t> unitInstanceData; //!< The texture unit data
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<int32_t> unitInstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
 
 		for (auto& entry : batchEntries)
 		{
 			unitInstanceData.push_back(entry.cubeTextureUnits[0]);
-			tintInstanceData.push_back(entry.tint);
+			tintInstanceData.push_back(MaterialParameterBuffer::get(entry.parameters).Tint);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(unitInstanceData.data(), sizeof(int32_t) * static_cast<uint32_t>(batchEntries.size()), 0);
@@ -210,13 +225,14 @@ namespace Engine
 	*/
 	void generateLightSource(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<glm::mat4> modelInstanceData; //!< The model matrix instance data
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<glm::mat4> modelInstanceData = scratch.createVector<glm::mat4>(batchEntries.size()); //!< The model matrix instance data
 
+		fillModelMatrices(batchEntries, modelInstanceData, scratch);
 		for (auto& entry : batchEntries)
 		{
-			modelInstanceData.push_back(entry.modelMatrix);
-			tintInstanceData.push_back(entry.tint);
+			tintInstanceData.push_back(MaterialParameterBuffer::get(entry.parameters).Tint);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(modelInstanceData.data(), sizeof(glm::mat4) * static_cast<uint32_t>(batchEntries.size()), 0);
@@ -229,18 +245,19 @@ namespace Engine
 	*/
 	void generateTerrain(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::mat4> modelInstanceData; //!< The model matrix instance data
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<int32_t> unit1InstanceData; //!< The texture unit data
-		std::vector<glm::vec4> subTextureUVs; //!< The Start and End UV coordinates of the subtexture
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::mat4> modelInstanceData = scratch.createVector<glm::mat4>(batchEntries.size()); //!< The model matrix instance data
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<int32_t> unit1InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<glm::vec4> subTextureUVs = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The Start and End UV coordinates of the subtexture
 
+		fillModelMatrices(batchEntries, modelInstanceData, scratch);
 		for (auto& entry : batchEntries)
 		{
-			modelInstanceData.push_back(entry.modelMatrix);
 			unit1InstanceData.push_back(entry.textureUnits[0]);
-			tintInstanceData.push_back(entry.tint);
-			subTextureUVs.push_back(glm::vec4(entry.subTextures.at(0)->getUVStart().x, entry.subTextures.at(0)->getUVStart().y,
-				entry.subTextures.at(0)->getUVEnd().x, entry.subTextures.at(0)->getUVEnd().y));
+			const MaterialParameters& parameters = MaterialParameterBuffer::get(entry.parameters);
+			tintInstanceData.push_back(parameters.Tint);
+			subTextureUVs.push_back(parameters.UVRect);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(modelInstanceData.data(), sizeof(glm::mat4) * static_cast<uint32_t>(batchEntries.size()), 0);
@@ -255,19 +272,20 @@ namespace Engine
 	*/
 	void generateWater(std::vector<BatchEntry3D>& batchEntries)
 	{
-		std::vector<glm::mat4> modelInstanceData; //!< The model matrix instance data
-		std::vector<glm::vec4> tintInstanceData; //!< The tint instance data
-		std::vector<int32_t> unit1InstanceData; //!< The texture unit data
-		std::vector<int32_t> unit2InstanceData; //!< The texture unit data
-		std::vector<int32_t> unit3InstanceData; //!< The texture unit data
+		ScratchArena scratch; //!< Instance data lives in scratch memory until it is uploaded
+		ArenaVector<glm::mat4> modelInstanceData = scratch.createVector<glm::mat4>(batchEntries.size()); //!< The model matrix instance data
+		ArenaVector<glm::vec4> tintInstanceData = scratch.createVector<glm::vec4>(batchEntries.size()); //!< The tint instance data
+		ArenaVector<int32_t> unit1InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<int32_t> unit2InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
+		ArenaVector<int32_t> unit3InstanceData = scratch.createVector<int32_t>(batchEntries.size()); //!< The texture unit data
 
+		fillModelMatrices(batchEntries, modelInstanceData, scratch);
 		for (auto& entry : batchEntries)
 		{
-			modelInstanceData.push_back(entry.modelMatrix);
 			unit1InstanceData.push_back(entry.textureUnits[0]);
 			unit2InstanceData.push_back(entry.textureUnits[1]);
 			unit3InstanceData.push_back(entry.textureUnits[2]);
-			tintInstanceData.push_back(entry.tint);
+			tintInstanceData.push_back(MaterialParameterBuffer::get(entry.parameters).Tint);
 		}
 
 		batchEntries.at(0).shader->getVertexArray()->getVertexBuffers().at(1)->edit(modelInstanceData.data(), sizeof(glm::mat4) * static_cast<uint32_t>(batchEntries.size()), 0);
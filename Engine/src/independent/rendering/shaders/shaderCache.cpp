@@ -0,0 +1,132 @@
+/*! \file shaderCache.cpp
+*
+* \brief A disk cache of linked program binaries keyed by the hash of their preprocessed sources
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include "independent/rendering/shaders/shaderCache.h"
+#include "independent/utils/mappedFile.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	bool ShaderCache::s_initialised = false; //!< Initialise with false
+	bool ShaderCache::s_enabled = false; //!< Initialise with false
+	std::string ShaderCache::s_directory = ""; //!< Initialise with empty string
+
+	//! initialise()
+	void ShaderCache::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("shaderCache")) return;
+
+		s_enabled = configData["shaderCache"]["enabled"].get<uint32_t>() != 0;
+		s_directory = configData["shaderCache"]["directory"].get<std::string>();
+
+		if (s_enabled)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(s_directory, error);
+			if (error)
+			{
+				ENGINE_ERROR("[ShaderCache::initialise] Cannot create the shader cache directory: {0}.", s_directory);
+				s_enabled = false;
+			}
+		}
+	}
+
+	//! getFilePath()
+	/*!
+	\param key a const uint64_t - The key
+	\return a std::string - The file the key is stored in
+	*/
+	std::string ShaderCache::getFilePath(const uint64_t key)
+	{
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+		return s_directory + "/" + name + ".bin";
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Is the cache used
+	*/
+	const bool ShaderCache::isEnabled()
+	{
+		initialise();
+		return s_enabled;
+	}
+
+	//! load()
+	/*!
+	\param key a const uint64_t - The key
+	\param format a uint32_t& - The format of the binary
+	\param binary a std::vector<uint8_t>& - The binary
+	\return a const bool - Was a binary stored under the key
+	*/
+	const bool ShaderCache::load(const uint64_t key, uint32_t& format, std::vector<uint8_t>& binary)
+	{
+		if (!isEnabled()) return false;
+
+		MappedFile file;
+		if (!file.open(getFilePath(key))) return false;
+		if (file.getSize() < sizeof(ShaderCacheHeader)) return false;
+
+		ShaderCacheHeader header;
+		memcpy(&header, file.getData(), sizeof(ShaderCacheHeader));
+		if (header.magic != ShaderCacheFormat::Magic || header.version != ShaderCacheFormat::Version || header.key != key || sizeof(ShaderCacheHeader) + header.size != file.getSize())
+			return false;
+
+		format = header.format;
+		binary.assign(file.getData() + sizeof(ShaderCacheHeader), file.getData() + file.getSize());
+		return true;
+	}
+
+	//! save()
+	/*!
+	\param key a const uint64_t - The key
+	\param format a const uint32_t - The format of the binary
+	\param binary a const std::vector<uint8_t>& - The binary
+	\return a const bool - Was the binary written
+	*/
+	const bool ShaderCache::save(const uint64_t key, const uint32_t format, const std::vector<uint8_t>& binary)
+	{
+		if (!isEnabled() || binary.empty()) return false;
+
+		ShaderCacheHeader header;
+		header.key = key;
+		header.format = format;
+		header.size = static_cast<uint32_t>(binary.size());
+
+		std::ofstream file(getFilePath(key), std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			ENGINE_ERROR("[ShaderCache::save] Cannot write the shader cache file: {0}.", getFilePath(key));
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(ShaderCacheHeader));
+		file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+		return static_cast<bool>(file);
+	}
+
+	//! remove()
+	/*!
+	\param key a const uint64_t - The key
+	*/
+	void ShaderCache::remove(const uint64_t key)
+	{
+		if (!isEnabled()) return;
+
+		std::error_code error;
+		std::filesystem::remove(getFilePath(key), error);
+	}
+}
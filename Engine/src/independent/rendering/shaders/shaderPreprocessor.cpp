@@ -0,0 +1,268 @@
+/*! \file shaderPreprocessor.cpp
+*
+* \brief Expands #include directives and inserts permutation defines into shader source before it is compiled
+*
+* \author Daniel Bullin
+*
+*/
+#include <sstream>
+#include <cstring>
+#include <unordered_set>
+#include "independent/rendering/shaders/shaderPreprocessor.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+#include "independent/utils/memoryUtils.h"
+
+namespace Engine
+{
+	namespace
+	{
+		const uint32_t MaxIncludeDepth = 16; //!< The deepest chain of includes allowed
+
+		//! startsWith()
+		/*!
+		\param line a const std::string& - The line
+		\param directive a const char* - The directive
+		\param rest a std::string& - The rest of the line after the directive
+		\return a const bool - Does the line start with the directive, ignoring leading whitespace
+		*/
+		const bool startsWith(const std::string& line, const char* directive, std::string& rest)
+		{
+			const size_t start = line.find_first_not_of(" \t");
+			if (start == std::string::npos) return false;
+
+			const size_t length = strlen(directive);
+			if (line.compare(start, length, directive) != 0) return false;
+
+			rest = line.substr(start + length);
+			return true;
+		}
+
+		//! appendDefines()
+		/*!
+		\param defines a const ShaderDefines& - The defines
+		\param output a std::string& - The source to append to
+		*/
+		void appendDefines(const ShaderDefines& defines, std::string& output)
+		{
+			for (auto& define : defines)
+				output += "#define " + define.first + " " + define.second + "\n";
+		}
+
+		//! expand()
+		/*!
+		\param filePath a const std::string& - The file the source was read from
+		\param source a const std::string& - The source
+		\param defines a const ShaderDefines* - The defines to insert after the #version line, nullptr in included files
+		\param reader a const ShaderFileReader& - Reads included files
+		\param depth a const uint32_t - How many includes deep the file is
+		\param included a std::unordered_set<std::string>& - The files already included in this stage
+		\param output a std::string& - The expanded source to append to
+		\return a const bool - Was every include found
+		*/
+		const bool expand(const std::string& filePath, const std::string& source, const ShaderDefines* defines, const ShaderFileReader& reader, const uint32_t depth, std::unordered_set<std::string>& included, std::string& output)
+		{
+			std::istringstream stream(source);
+			std::string line;
+			std::string rest;
+			uint32_t lineNumber = 0;
+
+			while (std::getline(stream, line))
+			{
+				lineNumber++;
+				if (!line.empty() && line.back() == '\r') line.pop_back();
+
+				if (startsWith(line, "#version", rest))
+				{
+					// Only the file being compiled keeps its version, the defines must follow it
+					if (defines)
+					{
+						output += line + "\n";
+						appendDefines(*defines, output);
+						output += "#line " + std::to_string(lineNumber + 1) + "\n";
+					}
+					else
+						output += "\n";
+				}
+				else if (startsWith(line, "#include", rest))
+				{
+					const size_t open = rest.find('"');
+					const size_t close = open != std::string::npos ? rest.find('"', open + 1) : std::string::npos;
+					if (close == std::string::npos)
+					{
+						ENGINE_ERROR("[ShaderPreprocessor::process] Malformed include in file: {0}, line: {1}.", filePath, lineNumber);
+						return false;
+					}
+
+					if (depth + 1 >= MaxIncludeDepth)
+					{
+						ENGINE_ERROR("[ShaderPreprocessor::process] Includes are nested too deeply in file: {0}, line: {1}.", filePath, lineNumber);
+						return false;
+					}
+
+					const std::string includePath = ShaderPreprocessor::resolvePath(filePath, rest.substr(open + 1, close - open - 1));
+					// Every file is only included once per stage, so shared blocks can include each other freely
+					if (included.insert(includePath).second)
+					{
+						const std::string includeSource = reader(includePath);
+						if (includeSource.empty())
+						{
+							ENGINE_ERROR("[ShaderPreprocessor::process] Cannot read included file: {0}, included from: {1}, line: {2}.", includePath, filePath, lineNumber);
+							return false;
+						}
+
+						output += "#line 1\n";
+						if (!expand(includePath, includeSource, nullptr, reader, depth + 1, included, output)) return false;
+						output += "#line " + std::to_string(lineNumber + 1) + "\n";
+					}
+					else
+						output += "\n";
+				}
+				else if (startsWith(line, "#pragma once", rest))
+					output += "\n";
+				else
+					output += line + "\n";
+			}
+
+			return true;
+		}
+	}
+
+	//! process()
+	/*!
+	\param filePath a const std::string& - The shader file
+	\param defines a const ShaderDefines& - The defines of the permutation
+	\param output a std::string& - The preprocessed source
+	\param reader a const ShaderFileReader& - Reads the file and any it includes, the resource manager is used when empty
+	\return a const bool - Was the file preprocessed
+	*/
+	const bool ShaderPreprocessor::process(const std::string& filePath, const ShaderDefines& defines, std::string& output, const ShaderFileReader& reader)
+	{
+		const ShaderFileReader fileReader = reader ? reader : ShaderFileReader(&ResourceManager::getContents);
+
+		const std::string source = fileReader(filePath);
+		if (source.empty())
+		{
+			ENGINE_ERROR("[ShaderPreprocessor::process] Cannot read file: {0}.", filePath);
+			return false;
+		}
+
+		return processSource(filePath, source, defines, output, fileReader);
+	}
+
+	//! processSource()
+	/*!
+	\param filePath a const std::string& - The file the source was read from, includes are relative to it
+	\param source a const std::string& - The source
+	\param defines a const ShaderDefines& - The defines of the permutation
+	\param output a std::string& - The preprocessed source
+	\param reader a const ShaderFileReader& - Reads any included files
+	\return a const bool - Was the source preprocessed
+	*/
+	const bool ShaderPreprocessor::processSource(const std::string& filePath, const std::string& source, const ShaderDefines& defines, std::string& output, const ShaderFileReader& reader)
+	{
+		output.clear();
+		output.reserve(source.size() + 256);
+
+		// Without a #version line the defines go first
+		std::string rest;
+		std::istringstream stream(source);
+		std::string line;
+		bool hasVersion = false;
+		while (!hasVersion && std::getline(stream, line))
+			hasVersion = startsWith(line, "#version", rest);
+
+		if (!hasVersion)
+		{
+			appendDefines(defines, output);
+			output += "#line 1\n";
+		}
+
+		std::unordered_set<std::string> included = { filePath };
+		return expand(filePath, source, hasVersion ? &defines : nullptr, reader, 0, included, output);
+	}
+
+	//! getDefines()
+	/*!
+	\return a ShaderDefines - The defines every shader is compiled with
+	*/
+	ShaderDefines ShaderPreprocessor::getDefines()
+	{
+		ShaderDefines defines;
+		defines.push_back({ "MAX_LIGHTS", std::to_string(ResourceManager::getConfigValue(Config::MaxLightsPerDraw)) });
+		defines.push_back({ "USE_BLOOM", std::to_string(ResourceManager::getConfigValue(Config::UseBloom)) });
+
+		// Any extra defines from the config, for permutations the engine does not know about
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (configData.contains("shaderDefines"))
+		{
+			for (auto& define : configData["shaderDefines"].items())
+				defines.push_back({ define.key(), define.value().is_string() ? define.value().get<std::string>() : define.value().dump() });
+		}
+
+		return defines;
+	}
+
+	//! getPermutationKey()
+	/*!
+	\param defines a const ShaderDefines& - The defines of the permutation
+	\return a std::string - The key, each define as NAME=VALUE separated by semicolons
+	*/
+	std::string ShaderPreprocessor::getPermutationKey(const ShaderDefines& defines)
+	{
+		std::string key;
+		for (auto& define : defines)
+		{
+			if (!key.empty()) key += ";";
+			key += define.first + "=" + define.second;
+		}
+		return key;
+	}
+
+	//! hash()
+	/*!
+	\param data a const std::string& - The data
+	\param seed a const uint64_t - The hash to continue from, so several strings can be hashed together
+	\return a const uint64_t - The 64 bit FNV-1a hash
+	*/
+	const uint64_t ShaderPreprocessor::hash(const std::string& data, const uint64_t seed)
+	{
+		return MemoryUtils::hash(data.data(), data.size(), seed);
+	}
+
+	//! resolvePath()
+	/*!
+	\param includingFile a const std::string& - The file with the #include
+	\param includePath a const std::string& - The path in the #include, relative to the including file
+	\return a std::string - The path of the included file with any . and .. removed
+	*/
+	std::string ShaderPreprocessor::resolvePath(const std::string& includingFile, const std::string& includePath)
+	{
+		const size_t slash = includingFile.find_last_of("/\\");
+		const std::string path = (slash != std::string::npos ? includingFile.substr(0, slash + 1) : std::string()) + includePath;
+
+		std::vector<std::string> parts;
+		size_t start = 0;
+		while (start <= path.size())
+		{
+			size_t end = path.find_first_of("/\\", start);
+			if (end == std::string::npos) end = path.size();
+
+			const std::string part = path.substr(start, end - start);
+			if (part == ".." && !parts.empty() && parts.back() != "..")
+				parts.pop_back();
+			else if (!part.empty() && part != ".")
+				parts.push_back(part);
+
+			start = end + 1;
+		}
+
+		std::string resolved = !path.empty() && (path[0] == '/' || path[0] == '\\') ? "/" : "";
+		for (auto& part : parts)
+		{
+			if (!resolved.empty() && resolved.back() != '/') resolved += "/";
+			resolved += part;
+		}
+		return resolved;
+	}
+}
@@ -56,4 +56,95 @@ namespace Engine
 		}
 		return nullptr;
 	}
+
+	//! sendInt()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const int - The uniform value
+	*/
+	void ShaderProgram::sendInt(const std::string& uniformName, const int value)
+	{
+		sendInt(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendIntArray()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param values a int32_t* - The uniform values
+	\param count a const uint32_t - The number of elements
+	*/
+	void ShaderProgram::sendIntArray(const std::string& uniformName, int32_t* values, const uint32_t count)
+	{
+		sendIntArray(m_reflection.getHandle(uniformName), values, count);
+	}
+
+	//! sendBool()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const bool - The uniform value
+	*/
+	void ShaderProgram::sendBool(const std::string& uniformName, const bool value)
+	{
+		sendBool(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendFloat()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const float - The uniform value
+	*/
+	void ShaderProgram::sendFloat(const std::string& uniformName, const float value)
+	{
+		sendFloat(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendVec2()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const glm::vec2& - The uniform value
+	*/
+	void ShaderProgram::sendVec2(const std::string& uniformName, const glm::vec2& value)
+	{
+		sendVec2(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendVec3()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const glm::vec3& - The uniform value
+	*/
+	void ShaderProgram::sendVec3(const std::string& uniformName, const glm::vec3& value)
+	{
+		sendVec3(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendVec4()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param value a const glm::vec4& - The uniform value
+	*/
+	void ShaderProgram::sendVec4(const std::string& uniformName, const glm::vec4& value)
+	{
+		sendVec4(m_reflection.getHandle(uniformName), value);
+	}
+
+	//! sendMat3()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param mat a const glm::mat3& - The uniform value
+	*/
+	void ShaderProgram::sendMat3(const std::string& uniformName, const glm::mat3& mat)
+	{
+		sendMat3(m_reflection.getHandle(uniformName), mat);
+	}
+
+	//! sendMat4()
+	/*!
+	\param uniformName a const std::string& - The uniform name
+	\param mat a const glm::mat4& - The uniform value
+	*/
+	void ShaderProgram::sendMat4(const std::string& uniformName, const glm::mat4& mat)
+	{
+		sendMat4(m_reflection.getHandle(uniformName), mat);
+	}
 }
\ No newline at end of file
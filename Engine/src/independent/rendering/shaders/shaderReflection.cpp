@@ -0,0 +1,198 @@
+/*! \file shaderReflection.cpp
+*
+* \brief The active uniforms, samplers and uniform blocks of a linked shader program, read once at link time
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/rendering/shaders/shaderReflection.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	//! clear()
+	void ShaderReflection::clear()
+	{
+		m_uniforms.clear();
+		m_blocks.clear();
+	}
+
+	//! addUniform()
+	/*!
+	\param uniform a const ShaderUniform& - The active uniform
+	*/
+	void ShaderReflection::addUniform(const ShaderUniform& uniform)
+	{
+		m_uniforms.push_back(uniform);
+	}
+
+	//! addBlock()
+	/*!
+	\param block a const ShaderBlock& - The active uniform block
+	*/
+	void ShaderReflection::addBlock(const ShaderBlock& block)
+	{
+		m_blocks.push_back(block);
+	}
+
+	//! getUniform()
+	/*!
+	\param name a const std::string& - The uniform name
+	\return a const ShaderUniform* - The uniform, nullptr if it is not active
+	*/
+	const ShaderUniform* ShaderReflection::getUniform(const std::string& name) const
+	{
+		// Programs only have a handful of uniforms, a search is quicker than hashing the name
+		for (auto& uniform : m_uniforms)
+		{
+			if (uniform.Name == name) return &uniform;
+		}
+		return nullptr;
+	}
+
+	//! getBlock()
+	/*!
+	\param name a const std::string& - The block name
+	\return a ShaderBlock* - The uniform block, nullptr if it is not active
+	*/
+	ShaderBlock* ShaderReflection::getBlock(const std::string& name)
+	{
+		for (auto& block : m_blocks)
+		{
+			if (block.Name == name) return &block;
+		}
+		return nullptr;
+	}
+
+	//! getHandle()
+	/*!
+	\param name a const std::string& - The uniform name
+	\return a const int32_t - The handle to send the uniform with, -1 if it is not active
+	*/
+	const int32_t ShaderReflection::getHandle(const std::string& name) const
+	{
+		const ShaderUniform* uniform = getUniform(name);
+		return uniform ? uniform->Location : -1;
+	}
+
+	//! toJSON()
+	/*!
+	\return a nlohmann::json - The reflection as a JSON object
+	*/
+	nlohmann::json ShaderReflection::toJSON() const
+	{
+		nlohmann::json data;
+		data["uniforms"] = nlohmann::json::array();
+		data["blocks"] = nlohmann::json::array();
+
+		for (auto& uniform : m_uniforms)
+		{
+			data["uniforms"].push_back({
+				{ "name", uniform.Name },
+				{ "type", SDT::convertSDTToString(uniform.Type) },
+				{ "location", uniform.Location },
+				{ "count", uniform.Count },
+				{ "sampler", uniform.Sampler }
+			});
+		}
+
+		for (auto& block : m_blocks)
+		{
+			data["blocks"].push_back({
+				{ "name", block.Name },
+				{ "index", block.Index },
+				{ "binding", block.Binding },
+				{ "size", block.Size }
+			});
+		}
+
+		return data;
+	}
+
+	//! fromJSON()
+	/*!
+	\param data a const nlohmann::json& - The reflection as written by toJSON
+	\return a ShaderReflection - The reflection
+	*/
+	ShaderReflection ShaderReflection::fromJSON(const nlohmann::json& data)
+	{
+		ShaderReflection reflection;
+		if (data.contains("uniforms"))
+		{
+			for (auto& entry : data["uniforms"])
+			{
+				ShaderUniform uniform;
+				uniform.Name = entry["name"].get<std::string>();
+				uniform.Type = SDT::convertStringToSDT(entry["type"].get<std::string>());
+				uniform.Location = entry["location"].get<int32_t>();
+				uniform.Count = entry["count"].get<uint32_t>();
+				uniform.Sampler = entry["sampler"].get<bool>();
+				reflection.addUniform(uniform);
+			}
+		}
+
+		if (data.contains("blocks"))
+		{
+			for (auto& entry : data["blocks"])
+			{
+				ShaderBlock block;
+				block.Name = entry["name"].get<std::string>();
+				block.Index = entry["index"].get<uint32_t>();
+				block.Binding = entry["binding"].get<int32_t>();
+				block.Size = entry["size"].get<uint32_t>();
+				reflection.addBlock(block);
+			}
+		}
+
+		return reflection;
+	}
+
+	//! validate()
+	/*!
+	\param program a const nlohmann::json& - The program's entry in shaders.json
+	\param programName a const std::string& - The name of the program, for the log
+	\return a const bool - Is every uniform and uniform block the entry names active in the program
+	*/
+	const bool ShaderReflection::validate(const nlohmann::json& program, const std::string& programName) const
+	{
+		bool valid = true;
+		if (program.contains("uniforms"))
+		{
+			for (auto& name : program["uniforms"])
+			{
+				if (!getUniform(name.get<std::string>()))
+				{
+					ENGINE_ERROR("[ShaderReflection::validate] Uniform with name: {0} cannot be found in program: {1}", name.get<std::string>(), programName);
+					valid = false;
+				}
+			}
+		}
+
+		if (program.contains("uniformBuffers"))
+		{
+			// Format is: [UNIFORM BLOCK NAME], [UNIFORM BUFFER NAME], etc
+			auto& buffers = program["uniformBuffers"];
+			for (size_t i = 0; i < buffers.size(); i += 2)
+			{
+				const std::string blockName = buffers[i].get<std::string>();
+				bool found = false;
+				for (auto& block : m_blocks)
+				{
+					if (block.Name == blockName)
+					{
+						found = true;
+						break;
+					}
+				}
+
+				if (!found)
+				{
+					ENGINE_ERROR("[ShaderReflection::validate] Uniform block with name: {0} cannot be found in program: {1}", blockName, programName);
+					valid = false;
+				}
+			}
+		}
+
+		return valid;
+	}
+}
@@ -0,0 +1,135 @@
+/*! \file distanceField.cpp
+*
+* \brief Turns a coverage bitmap into a signed distance field, so one rasterised size can be drawn sharply at any size
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstring>
+#include "independent/rendering/textures/distanceField.h"
+#include "independent/utils/frameAllocator.h"
+
+namespace Engine
+{
+	namespace
+	{
+		const float Infinity = 1e20f; //!< The squared distance of a pixel with nothing to measure to
+
+		//! transform1D()
+		/*!
+		\param f a const float* - The squared distances along a line, 0 where the feature is and Infinity elsewhere
+		\param d a float* - The squared distance of each point to the nearest feature on the line
+		\param v an int32_t* - Working space for the lower envelope's parabola positions, n long
+		\param z a float* - Working space for the lower envelope's boundaries, n + 1 long
+		\param n a const int32_t - The length of the line
+		*/
+		void transform1D(const float* f, float* d, int32_t* v, float* z, const int32_t n)
+		{
+			// Felzenszwalb and Huttenlocher, the lower envelope of a parabola rooted at every point
+			int32_t k = 0;
+			v[0] = 0;
+			z[0] = -Infinity;
+			z[1] = Infinity;
+
+			for (int32_t q = 1; q < n; q++)
+			{
+				float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * q - 2.f * v[k]);
+				while (s <= z[k])
+				{
+					k--;
+					s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * q - 2.f * v[k]);
+				}
+				k++;
+				v[k] = q;
+				z[k] = s;
+				z[k + 1] = Infinity;
+			}
+
+			k = 0;
+			for (int32_t q = 0; q < n; q++)
+			{
+				while (z[k + 1] < q) k++;
+				d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+			}
+		}
+
+		//! transform2D()
+		/*!
+		\param grid a float* - The squared distances, 0 where the feature is and Infinity elsewhere, replaced with the squared distance to the nearest feature
+		\param width a const int32_t - The width of the grid
+		\param height a const int32_t - The height of the grid
+		\param scratch a ScratchArena& - The arena the working space is taken from
+		*/
+		void transform2D(float* grid, const int32_t width, const int32_t height, ScratchArena& scratch)
+		{
+			const int32_t length = std::max(width, height);
+			ArenaVector<float> f = scratch.createVector<float>(length);
+			ArenaVector<float> d = scratch.createVector<float>(length);
+			ArenaVector<int32_t> v = scratch.createVector<int32_t>(length);
+			ArenaVector<float> z = scratch.createVector<float>(length + 1);
+			f.resize(length);
+			d.resize(length);
+			v.resize(length);
+			z.resize(length + 1);
+
+			// Columns then rows, the squared distance separates into one pass per axis
+			for (int32_t x = 0; x < width; x++)
+			{
+				for (int32_t y = 0; y < height; y++) f[y] = grid[y * width + x];
+				transform1D(f.data(), d.data(), v.data(), z.data(), height);
+				for (int32_t y = 0; y < height; y++) grid[y * width + x] = d[y];
+			}
+
+			for (int32_t y = 0; y < height; y++)
+			{
+				transform1D(grid + y * width, d.data(), v.data(), z.data(), width);
+				memcpy(grid + y * width, d.data(), sizeof(float) * width);
+			}
+		}
+	}
+
+	//! generate()
+	/*!
+	\param coverage a const unsigned char* - The coverage of each pixel, 255 fully inside, with at least spread empty pixels around the shape
+	\param width a const uint32_t - The width of the bitmap
+	\param height a const uint32_t - The height of the bitmap
+	\param spread a const uint32_t - The distance in pixels from the edge at which the field reaches 0 or 1
+	\param output an unsigned char* - The distance field, the same size as the bitmap
+	*/
+	void DistanceField::generate(const unsigned char* coverage, const uint32_t width, const uint32_t height, const uint32_t spread, unsigned char* output)
+	{
+		const size_t count = static_cast<size_t>(width) * height;
+		if (count == 0) return;
+
+		ScratchArena scratch;
+		ArenaVector<float> toInside = scratch.createVector<float>(count);
+		ArenaVector<float> toOutside = scratch.createVector<float>(count);
+		toInside.resize(count);
+		toOutside.resize(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const bool inside = coverage[i] >= 128;
+			toInside[i] = inside ? 0.f : Infinity;
+			toOutside[i] = inside ? Infinity : 0.f;
+		}
+
+		transform2D(toInside.data(), static_cast<int32_t>(width), static_cast<int32_t>(height), scratch);
+		transform2D(toOutside.data(), static_cast<int32_t>(width), static_cast<int32_t>(height), scratch);
+
+		const float range = 2.f * static_cast<float>(std::max(spread, 1u));
+		for (size_t i = 0; i < count; i++)
+		{
+			// The edge lies half a pixel past the last pixel on either side of it, partly covered pixels place it more finely
+			float distance;
+			if (coverage[i] > 0 && coverage[i] < 255)
+				distance = static_cast<float>(coverage[i]) / 255.f - 0.5f;
+			else if (coverage[i] >= 128)
+				distance = sqrtf(toOutside[i]) - 0.5f;
+			else
+				distance = 0.5f - sqrtf(toInside[i]);
+
+			output[i] = static_cast<unsigned char>(glm::clamp(0.5f + distance / range, 0.f, 1.f) * 255.f + 0.5f);
+		}
+	}
+}
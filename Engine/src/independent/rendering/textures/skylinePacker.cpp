@@ -0,0 +1,139 @@
+/*! \file skylinePacker.cpp
+*
+* \brief Packs rectangles into a fixed area by keeping the outline of the tops of everything placed so far
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/rendering/textures/skylinePacker.h"
+
+namespace Engine
+{
+	//! SkylinePacker()
+	/*!
+	\param size a const glm::ivec2& - The size of the area to pack
+	\param reservedSegments a const uint32_t - The number of skyline segments to reserve
+	*/
+	SkylinePacker::SkylinePacker(const glm::ivec2& size, const uint32_t reservedSegments)
+	{
+		m_skyline.reserve(reservedSegments);
+		reset(size);
+	}
+
+	//! reset()
+	/*!
+	\param size a const glm::ivec2& - The size of the area to pack
+	*/
+	void SkylinePacker::reset(const glm::ivec2& size)
+	{
+		m_size = size;
+		m_usedHeight = 0;
+		m_skyline.clear();
+		m_skyline.push_back({ 0, 0, size.x });
+	}
+
+	//! fit()
+	/*!
+	\param index a const size_t - The index of the segment the rectangle's left edge is placed on
+	\param width a const int32_t - The width of the rectangle
+	\param height a const int32_t - The height of the rectangle
+	\return a const int32_t - The height the rectangle would sit at, -1 if it does not fit
+	*/
+	const int32_t SkylinePacker::fit(const size_t index, const int32_t width, const int32_t height) const
+	{
+		const int32_t x = m_skyline[index].x;
+		if (x + width > m_size.x) return -1;
+
+		// The rectangle rests on the highest segment beneath it
+		int32_t y = 0;
+		int32_t widthLeft = width;
+		for (size_t i = index; widthLeft > 0 && i < m_skyline.size(); i++)
+		{
+			y = std::max(y, m_skyline[i].y);
+			if (y + height > m_size.y) return -1;
+			widthLeft -= m_skyline[i].width;
+		}
+
+		return y;
+	}
+
+	//! place()
+	/*!
+	\param index a const size_t - The index of the segment the rectangle's left edge is placed on
+	\param x a const int32_t - The left of the rectangle
+	\param y a const int32_t - The bottom of the rectangle
+	\param width a const int32_t - The width of the rectangle
+	\param height a const int32_t - The height of the rectangle
+	*/
+	void SkylinePacker::place(const size_t index, const int32_t x, const int32_t y, const int32_t width, const int32_t height)
+	{
+		m_skyline.insert(m_skyline.begin() + index, { x, y + height, width });
+
+		// Shrink or remove the segments now hidden under the rectangle
+		for (size_t i = index + 1; i < m_skyline.size();)
+		{
+			Segment& segment = m_skyline[i];
+			const int32_t overlap = x + width - segment.x;
+			if (overlap <= 0) break;
+
+			if (overlap < segment.width)
+			{
+				segment.x += overlap;
+				segment.width -= overlap;
+				break;
+			}
+
+			m_skyline.erase(m_skyline.begin() + i);
+		}
+
+		// Join neighbours of the same height so the skyline stays short
+		for (size_t i = 0; i + 1 < m_skyline.size();)
+		{
+			if (m_skyline[i].y == m_skyline[i + 1].y)
+			{
+				m_skyline[i].width += m_skyline[i + 1].width;
+				m_skyline.erase(m_skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		m_usedHeight = std::max(m_usedHeight, y + height);
+	}
+
+	//! pack()
+	/*!
+	\param width a const int32_t - The width of the rectangle
+	\param height a const int32_t - The height of the rectangle
+	\param position a glm::ivec2& - The bottom left of the rectangle once placed
+	\return a const bool - Was there room for the rectangle
+	*/
+	const bool SkylinePacker::pack(const int32_t width, const int32_t height, glm::ivec2& position)
+	{
+		if (width <= 0 || height <= 0) return false;
+
+		size_t bestIndex = m_skyline.size();
+		int32_t bestTop = INT32_MAX;
+		int32_t bestWidth = INT32_MAX;
+
+		for (size_t i = 0; i < m_skyline.size(); i++)
+		{
+			const int32_t y = fit(i, width, height);
+			if (y < 0) continue;
+
+			// Lowest top first, then the narrowest segment so wide gaps are kept for wide rectangles
+			if (y + height < bestTop || (y + height == bestTop && m_skyline[i].width < bestWidth))
+			{
+				bestIndex = i;
+				bestTop = y + height;
+				bestWidth = m_skyline[i].width;
+			}
+		}
+
+		if (bestIndex == m_skyline.size()) return false;
+
+		position = { m_skyline[bestIndex].x, bestTop - height };
+		place(bestIndex, position.x, position.y, width, height);
+		return true;
+	}
+}
@@ -121,6 +121,40 @@ namespace Engine
 		return nullptr;
 	}
 
+	//! create()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param properties a TextureProperties - The properties of the texture, the size is taken from the image
+	\param image a const TextureImage& - The image, loaded by the texture cooker
+	\return a Texture2D* - The 2D texture of type defined by the graphics API chosen
+	*/
+	Texture2D* Texture2D::create(const std::string& textureName, TextureProperties properties, const TextureImage& image)
+	{
+		switch (RenderAPI::getAPI())
+		{
+			case GraphicsAPI::None:
+			{
+				ENGINE_ERROR("[Texture2D::create] No rendering API selected.");
+				break;
+			}
+			case GraphicsAPI::OpenGL:
+			{
+				return new OpenGLTexture2D(textureName, properties, image);
+			}
+			case GraphicsAPI::Direct3D:
+			{
+				ENGINE_ERROR("[Texture2D::create] Direct3D not supported.");
+				break;
+			}
+			case GraphicsAPI::Vulkan:
+			{
+				ENGINE_ERROR("[Texture2D::create] Vulkan not supported.");
+				break;
+			}
+		}
+		return nullptr;
+	}
+
 	//! create()
 	/*!
 	\param textureName a const std::string& - The name of the texture
@@ -154,4 +188,38 @@ namespace Engine
 		}
 		return nullptr;
 	}
+
+	//! create()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param folderPath a const std::string& - The path to the folder the faces were loaded from
+	\param faces a const std::vector<TextureImage>& - The right, left, top, bottom, front and back faces
+	\return a CubeMapTexture* - The cubemap texture of type defined by the graphics API chosen
+	*/
+	CubeMapTexture* CubeMapTexture::create(const std::string& textureName, const std::string& folderPath, const std::vector<TextureImage>& faces)
+	{
+		switch (RenderAPI::getAPI())
+		{
+			case GraphicsAPI::None:
+			{
+				ENGINE_ERROR("[CubeMapTexture::create] No rendering API selected.");
+				break;
+			}
+			case GraphicsAPI::OpenGL:
+			{
+				return new OpenGLCubeMapTexture(textureName, folderPath, faces);
+			}
+			case GraphicsAPI::Direct3D:
+			{
+				ENGINE_ERROR("[CubeMapTexture::create] Direct3D not supported.");
+				break;
+			}
+			case GraphicsAPI::Vulkan:
+			{
+				ENGINE_ERROR("[CubeMapTexture::create] Vulkan not supported.");
+				break;
+			}
+		}
+		return nullptr;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+/*! \file textureAtlasBuilder.cpp
+*
+* \brief Packs the small 2D textures marked for atlasing into a few atlas pages when the resources are loaded
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstring>
+#include "independent/rendering/textures/textureAtlasBuilder.h"
+#include "independent/rendering/textures/skylinePacker.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	bool TextureAtlasBuilder::s_initialised = false; //!< Initialise with false
+	bool TextureAtlasBuilder::s_enabled = false; //!< Initialise with false
+	uint32_t TextureAtlasBuilder::s_maxTextureSize = 1024; //!< Initialise with 1024
+	uint32_t TextureAtlasBuilder::s_pageSize = 2048; //!< Initialise with 2048
+	std::vector<TextureAtlasBuilder::PendingTexture> TextureAtlasBuilder::s_pending = std::vector<TextureAtlasBuilder::PendingTexture>(); //!< Initialise with empty list
+	std::unordered_map<std::string, AtlasRegion> TextureAtlasBuilder::s_regions = std::unordered_map<std::string, AtlasRegion>(); //!< Initialise with empty map
+
+	//! initialise()
+	void TextureAtlasBuilder::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("textureAtlas")) return;
+
+		s_enabled = configData["textureAtlas"]["enabled"].get<uint32_t>() != 0;
+		s_maxTextureSize = configData["textureAtlas"]["maxTextureSize"].get<uint32_t>();
+		s_pageSize = configData["textureAtlas"]["pageSize"].get<uint32_t>();
+
+		// Every texture has a pixel of its edge repeated around it, so it must fit in the page with that border
+		if (s_maxTextureSize + 2 > s_pageSize)
+			s_maxTextureSize = s_pageSize > 2 ? s_pageSize - 2 : 0;
+	}
+
+	//! accepts()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param size a const glm::ivec2& - The size of the texture's image
+	\param properties a const TextureProperties& - The properties the texture was given
+	\return a const bool - Can the texture be atlased, when false the texture should be created on its own
+	*/
+	const bool TextureAtlasBuilder::accepts(const std::string& textureName, const glm::ivec2& size, const TextureProperties& properties)
+	{
+		initialise();
+
+		// Pages are linear RGB, gamma corrected textures keep their own texture
+		if (!s_enabled || properties.GammaCorrect || s_regions.find(textureName) != s_regions.end()) return false;
+
+		for (auto& pending : s_pending)
+		{
+			if (pending.Name == textureName) return false;
+		}
+
+		return size.x > 0 && size.y > 0 && static_cast<uint32_t>(size.x) <= s_maxTextureSize && static_cast<uint32_t>(size.y) <= s_maxTextureSize;
+	}
+
+	//! add()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param image a TextureImage& - The RGBA image of the texture, its pixels are moved into the atlas builder
+	*/
+	void TextureAtlasBuilder::add(const std::string& textureName, TextureImage& image)
+	{
+		if (image.Format != TextureImageFormat::RGBA8 || image.Mips.empty())
+		{
+			ENGINE_ERROR("[TextureAtlasBuilder::add] The texture: {0} is not RGBA and cannot be atlased.", textureName);
+			return;
+		}
+
+		PendingTexture pending;
+		pending.Name = textureName;
+		pending.Size = { static_cast<int32_t>(image.getWidth()), static_cast<int32_t>(image.getHeight()) };
+		pending.Pixels = std::move(image.Data);
+		pending.Pixels.resize(static_cast<size_t>(image.Mips[0].Size));
+		s_pending.push_back(std::move(pending));
+		image.Mips.clear();
+	}
+
+	//! createPage()
+	/*!
+	\param textures a std::vector<PendingTexture*>& - The textures left to pack, tallest first, the packed ones are removed
+	\param pageIndex a const uint32_t - The index of the page
+	\return a const uint32_t - The number of textures packed into the page
+	*/
+	const uint32_t TextureAtlasBuilder::createPage(std::vector<PendingTexture*>& textures, const uint32_t pageIndex)
+	{
+		const int32_t pageSize = static_cast<int32_t>(s_pageSize);
+		SkylinePacker packer({ pageSize, pageSize });
+
+		std::vector<std::pair<PendingTexture*, glm::ivec2>> placed;
+		std::vector<PendingTexture*> remaining;
+		uint64_t textureArea = 0;
+
+		for (auto texture : textures)
+		{
+			glm::ivec2 position;
+			if (packer.pack(texture->Size.x + 2, texture->Size.y + 2, position))
+			{
+				placed.push_back({ texture, position });
+				textureArea += static_cast<uint64_t>(texture->Size.x) * texture->Size.y;
+			}
+			else
+				remaining.push_back(texture);
+		}
+
+		if (placed.empty()) return 0;
+
+		// The page is only as tall as it needs to be, rounded up to a multiple of four rows
+		const int32_t pageHeight = (packer.getUsedHeight() + 3) & ~3;
+
+		std::vector<unsigned char> pixels(static_cast<size_t>(pageSize) * pageHeight * 4, 0);
+		for (auto& entry : placed)
+		{
+			const PendingTexture& texture = *entry.first;
+			const glm::ivec2& position = entry.second;
+
+			// Copy the texture with its edge pixels repeated one pixel out, so filtering at the edge does not pick up a neighbour
+			for (int32_t y = -1; y <= texture.Size.y; y++)
+			{
+				const int32_t sourceY = glm::clamp(y, 0, texture.Size.y - 1);
+				unsigned char* row = pixels.data() + ((static_cast<size_t>(position.y + 1 + y) * pageSize + position.x) * 4);
+				const unsigned char* sourceRow = texture.Pixels.data() + (static_cast<size_t>(sourceY) * texture.Size.x * 4);
+
+				memcpy(row, sourceRow, 4);
+				memcpy(row + 4, sourceRow, static_cast<size_t>(texture.Size.x) * 4);
+				memcpy(row + ((static_cast<size_t>(texture.Size.x) + 1) * 4), sourceRow + ((static_cast<size_t>(texture.Size.x) - 1) * 4), 4);
+			}
+		}
+
+		const std::string pageName = "TextureAtlasPage" + std::to_string(pageIndex);
+		TextureProperties properties(pageSize, pageHeight, "ClampToEdge", "ClampToEdge", "ClampToEdge", "Linear", "Linear", false, false);
+		Texture2D* page = Texture2D::create(pageName, properties, 4, pixels.data());
+		if (!page)
+		{
+			ENGINE_ERROR("[TextureAtlasBuilder::createPage] Cannot create the atlas page: {0}.", pageName);
+			return 0;
+		}
+		ResourceManager::registerResource(pageName, page);
+
+		for (auto& entry : placed)
+		{
+			const glm::vec2 start = glm::vec2(entry.second + glm::ivec2(1));
+			const glm::vec2 end = start + glm::vec2(entry.first->Size);
+			s_regions[entry.first->Name] = { page, start / glm::vec2(pageSize, pageHeight), end / glm::vec2(pageSize, pageHeight) };
+		}
+
+		ENGINE_INFO("[TextureAtlasBuilder::build] Created {0}, {1}x{2} with {3} textures, {4}% of the page is texture pixels.", pageName, pageSize, pageHeight,
+			placed.size(), static_cast<uint32_t>((100 * textureArea) / (static_cast<uint64_t>(pageSize) * pageHeight)));
+
+		const uint32_t packed = static_cast<uint32_t>(placed.size());
+		textures = std::move(remaining);
+		return packed;
+	}
+
+	//! build()
+	void TextureAtlasBuilder::build()
+	{
+		if (s_pending.empty()) return;
+
+		// Tallest first keeps the skyline flat
+		std::vector<PendingTexture*> textures;
+		textures.reserve(s_pending.size());
+		for (auto& pending : s_pending)
+			textures.push_back(&pending);
+
+		std::sort(textures.begin(), textures.end(), [](const PendingTexture* a, const PendingTexture* b)
+		{
+			return a->Size.y != b->Size.y ? a->Size.y > b->Size.y : a->Size.x > b->Size.x;
+		});
+
+		const size_t textureCount = textures.size();
+		uint32_t pageCount = 0;
+		while (!textures.empty())
+		{
+			if (createPage(textures, pageCount) == 0)
+			{
+				ENGINE_ERROR("[TextureAtlasBuilder::build] Cannot create an atlas page, {0} textures were not loaded.", textures.size());
+				break;
+			}
+			pageCount++;
+		}
+
+		ENGINE_INFO("[TextureAtlasBuilder::build] Packed {0} textures into {1} atlas pages.", textureCount - textures.size(), pageCount);
+
+		s_pending.clear();
+		s_pending.shrink_to_fit();
+	}
+
+	//! getRegion()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param region an AtlasRegion& - Where the texture was packed
+	\return a const bool - Was the texture atlased
+	*/
+	const bool TextureAtlasBuilder::getRegion(const std::string& textureName, AtlasRegion& region)
+	{
+		auto it = s_regions.find(textureName);
+		if (it == s_regions.end()) return false;
+
+		region = it->second;
+		return true;
+	}
+
+	//! clear()
+	void TextureAtlasBuilder::clear()
+	{
+		s_pending.clear();
+		s_regions.clear();
+	}
+}
@@ -0,0 +1,877 @@
+/*! \file textureCooker.cpp
+*
+* \brief Decodes texture images off the main thread and cooks them into a container of ready to upload mip levels
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include "independent/rendering/textures/textureCooker.h"
+#include "independent/utils/mappedFile.h"
+#include "independent/utils/memoryUtils.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/log.h"
+#include <stb_image.h>
+
+namespace Engine
+{
+	namespace
+	{
+		const uint32_t MaxMipCount = 32; //!< More levels than any texture the API can create
+
+		//! getBlockSize()
+		/*!
+		\param format a const TextureImageFormat - The format
+		\return a const uint32_t - The size of a 4x4 block, 0 for formats which are not compressed
+		*/
+		const uint32_t getBlockSize(const TextureImageFormat format)
+		{
+			if (format == TextureImageFormat::BC1) return 8;
+			if (format == TextureImageFormat::BC3) return 16;
+			return 0;
+		}
+
+		//! getLevelSize()
+		/*!
+		\param format a const TextureImageFormat - The format
+		\param width a const uint32_t - The width of the level
+		\param height a const uint32_t - The height of the level
+		\return a const uint64_t - The size of the level in bytes
+		*/
+		const uint64_t getLevelSize(const TextureImageFormat format, const uint32_t width, const uint32_t height)
+		{
+			const uint32_t blockSize = getBlockSize(format);
+			if (blockSize)
+				return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+
+			const uint32_t channels = format == TextureImageFormat::R8 ? 1 : format == TextureImageFormat::RGB8 ? 3 : 4;
+			return static_cast<uint64_t>(width) * height * channels;
+		}
+
+		//! toRGB565()
+		/*!
+		\param colour a const float* - The red, green and blue from 0 to 255
+		\return a const uint16_t - The colour packed as 5 bits red, 6 bits green and 5 bits blue
+		*/
+		const uint16_t toRGB565(const float* colour)
+		{
+			const uint32_t r = static_cast<uint32_t>(glm::clamp(colour[0], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+			const uint32_t g = static_cast<uint32_t>(glm::clamp(colour[1], 0.f, 255.f) * 63.f / 255.f + 0.5f);
+			const uint32_t b = static_cast<uint32_t>(glm::clamp(colour[2], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		//! fromRGB565()
+		/*!
+		\param packed a const uint16_t - The packed colour
+		\param colour a int32_t* - The red, green and blue from 0 to 255
+		*/
+		void fromRGB565(const uint16_t packed, int32_t* colour)
+		{
+			const int32_t r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+			colour[0] = (r << 3) | (r >> 2);
+			colour[1] = (g << 2) | (g >> 4);
+			colour[2] = (b << 3) | (b >> 2);
+		}
+
+		//! fitColourBlock()
+		/*!
+		\param block a const uint8_t* - The 16 RGBA pixels of the block
+		\param high a const float* - The red, green and blue of one endpoint
+		\param low a const float* - The red, green and blue of the other endpoint
+		\param output a uint8_t* - The 8 bytes of the colour block
+		\return a const uint32_t - The squared error of the block's pixels once decoded
+		*/
+		const uint32_t fitColourBlock(const uint8_t* block, const float* high, const float* low, uint8_t* output)
+		{
+			uint16_t colour0 = toRGB565(high);
+			uint16_t colour1 = toRGB565(low);
+			if (colour0 < colour1) std::swap(colour0, colour1);
+
+			int32_t palette[4][3];
+			fromRGB565(colour0, palette[0]);
+			fromRGB565(colour1, palette[1]);
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			// Four colour mode, the two endpoints and two thirds between them. With equal endpoints every index gives the same colour
+			uint32_t indices = 0;
+			uint32_t error = 0;
+			const uint32_t paletteSize = colour0 != colour1 ? 4 : 1;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t best = 0;
+				int32_t bestDistance = INT32_MAX;
+				for (uint32_t p = 0; p < paletteSize; p++)
+				{
+					const int32_t r = block[i * 4] - palette[p][0], g = block[i * 4 + 1] - palette[p][1], b = block[i * 4 + 2] - palette[p][2];
+					const int32_t distance = r * r + g * g + b * b;
+					if (distance < bestDistance) { bestDistance = distance; best = p; }
+				}
+				indices |= best << (i * 2);
+				error += static_cast<uint32_t>(bestDistance);
+			}
+
+			output[0] = colour0 & 0xFF; output[1] = colour0 >> 8;
+			output[2] = colour1 & 0xFF; output[3] = colour1 >> 8;
+			for (uint32_t i = 0; i < 4; i++) output[4 + i] = (indices >> (i * 8)) & 0xFF;
+			return error;
+		}
+
+		//! encodeColourBlock()
+		/*!
+		\param block a const uint8_t* - The 16 RGBA pixels of the block
+		\param output a uint8_t* - The 8 bytes of the colour block
+		*/
+		void encodeColourBlock(const uint8_t* block, uint8_t* output)
+		{
+			// The endpoints are the pixels furthest along the block's principal axis
+			float mean[3] = { 0.f, 0.f, 0.f };
+			for (uint32_t i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < 3; c++) mean[c] += block[i * 4 + c] / 16.f;
+
+			float covariance[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const float r = block[i * 4] - mean[0], g = block[i * 4 + 1] - mean[1], b = block[i * 4 + 2] - mean[2];
+				covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+				covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+			}
+
+			float axis[3] = { 1.f, 1.f, 1.f };
+			for (uint32_t iteration = 0; iteration < 4; iteration++)
+			{
+				const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+				const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+				const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+				const float length = glm::max(glm::max(glm::abs(x), glm::abs(y)), glm::abs(z));
+				if (length < 1e-6f) break;
+				axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+			}
+
+			uint32_t minIndex = 0, maxIndex = 0;
+			float minDot = FLT_MAX, maxDot = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const float dot = block[i * 4] * axis[0] + block[i * 4 + 1] * axis[1] + block[i * 4 + 2] * axis[2];
+				if (dot < minDot) { minDot = dot; minIndex = i; }
+				if (dot > maxDot) { maxDot = dot; maxIndex = i; }
+			}
+
+			// Pulling the endpoints in by a sixteenth of their range lowers the error of the pixels between them, but a block of
+			// only two colours is matched exactly by the pixels themselves, so both are tried and the closer one is kept
+			float high[3], low[3], insetHigh[3], insetLow[3];
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				high[c] = block[maxIndex * 4 + c];
+				low[c] = block[minIndex * 4 + c];
+				const float inset = (high[c] - low[c]) / 16.f;
+				insetHigh[c] = high[c] - inset;
+				insetLow[c] = low[c] + inset;
+			}
+
+			uint8_t candidate[8];
+			uint32_t bestError = fitColourBlock(block, insetHigh, insetLow, output);
+			if (bestError != 0)
+			{
+				const uint32_t error = fitColourBlock(block, high, low, candidate);
+				if (error < bestError)
+				{
+					bestError = error;
+					memcpy(output, candidate, sizeof(candidate));
+				}
+			}
+
+			// Endpoints solved by least squares for the chosen indices are often closer than any pixel of the block
+			const float weights[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+			for (uint32_t iteration = 0; iteration < 2 && bestError != 0; iteration++)
+			{
+				const uint32_t indices = output[4] | (output[5] << 8) | (output[6] << 16) | (static_cast<uint32_t>(output[7]) << 24);
+				float alphaSquared = 0.f, betaSquared = 0.f, alphaBeta = 0.f;
+				float alphaColour[3] = { 0.f, 0.f, 0.f }, betaColour[3] = { 0.f, 0.f, 0.f };
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					const float alpha = weights[(indices >> (i * 2)) & 3], beta = 1.f - alpha;
+					alphaSquared += alpha * alpha;
+					betaSquared += beta * beta;
+					alphaBeta += alpha * beta;
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						alphaColour[c] += alpha * block[i * 4 + c];
+						betaColour[c] += beta * block[i * 4 + c];
+					}
+				}
+
+				const float determinant = alphaSquared * betaSquared - alphaBeta * alphaBeta;
+				if (glm::abs(determinant) < 1e-6f) break;
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					high[c] = (alphaColour[c] * betaSquared - betaColour[c] * alphaBeta) / determinant;
+					low[c] = (betaColour[c] * alphaSquared - alphaColour[c] * alphaBeta) / determinant;
+				}
+
+				const uint32_t error = fitColourBlock(block, high, low, candidate);
+				if (error >= bestError) break;
+				bestError = error;
+				memcpy(output, candidate, sizeof(candidate));
+			}
+		}
+
+		//! encodeAlphaBlock()
+		/*!
+		\param block a const uint8_t* - The 16 RGBA pixels of the block
+		\param output a uint8_t* - The 8 bytes of the alpha block
+		*/
+		void encodeAlphaBlock(const uint8_t* block, uint8_t* output)
+		{
+			int32_t alpha0 = 0, alpha1 = 255;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				alpha0 = glm::max(alpha0, static_cast<int32_t>(block[i * 4 + 3]));
+				alpha1 = glm::min(alpha1, static_cast<int32_t>(block[i * 4 + 3]));
+			}
+
+			output[0] = static_cast<uint8_t>(alpha0);
+			output[1] = static_cast<uint8_t>(alpha1);
+
+			uint64_t indices = 0;
+			if (alpha0 != alpha1)
+			{
+				// Eight alpha mode, the two endpoints and six steps between them
+				int32_t palette[8] = { alpha0, alpha1 };
+				for (int32_t p = 1; p < 7; p++)
+					palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					uint64_t best = 0;
+					int32_t bestDistance = INT32_MAX;
+					for (uint32_t p = 0; p < 8; p++)
+					{
+						const int32_t distance = glm::abs(static_cast<int32_t>(block[i * 4 + 3]) - palette[p]);
+						if (distance < bestDistance) { bestDistance = distance; best = p; }
+					}
+					indices |= best << (i * 3);
+				}
+			}
+
+			for (uint32_t i = 0; i < 6; i++) output[2 + i] = (indices >> (i * 8)) & 0xFF;
+		}
+
+		//! decodeColourBlock()
+		/*!
+		\param input a const uint8_t* - The 8 bytes of the colour block
+		\param block a uint8_t* - The 16 RGBA pixels of the block
+		\param allowTransparent a const bool - Can the block use three colour mode with transparent black, only in BC1
+		*/
+		void decodeColourBlock(const uint8_t* input, uint8_t* block, const bool allowTransparent)
+		{
+			const uint16_t colour0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+			const uint16_t colour1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+
+			int32_t palette[4][4];
+			fromRGB565(colour0, palette[0]);
+			fromRGB565(colour1, palette[1]);
+			palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				if (colour0 > colour1 || !allowTransparent)
+				{
+					palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+				}
+				else
+				{
+					palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+					palette[3][c] = 0;
+				}
+			}
+			if (colour0 <= colour1 && allowTransparent) palette[3][3] = 0;
+
+			const uint32_t indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const uint32_t index = (indices >> (i * 2)) & 3;
+				for (uint32_t c = 0; c < 4; c++) block[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+			}
+		}
+
+		//! decodeAlphaBlock()
+		/*!
+		\param input a const uint8_t* - The 8 bytes of the alpha block
+		\param block a uint8_t* - The 16 RGBA pixels of the block, only alpha is written
+		*/
+		void decodeAlphaBlock(const uint8_t* input, uint8_t* block)
+		{
+			const int32_t alpha0 = input[0], alpha1 = input[1];
+			int32_t palette[8] = { alpha0, alpha1 };
+			if (alpha0 > alpha1)
+			{
+				for (int32_t p = 1; p < 7; p++) palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+			}
+			else
+			{
+				for (int32_t p = 1; p < 5; p++) palette[p + 1] = ((5 - p) * alpha0 + p * alpha1) / 5;
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+
+			uint64_t indices = 0;
+			for (uint32_t i = 0; i < 6; i++) indices |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+			for (uint32_t i = 0; i < 16; i++)
+				block[i * 4 + 3] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+		}
+
+		//! build()
+		/*!
+		\param filePath a const std::string& - The source image
+		\param settings a const TextureCookSettings& - How to cook the source
+		\param image a TextureImage& - The cooked image
+		\return a const bool - Was the source decoded
+		*/
+		const bool build(const std::string& filePath, const TextureCookSettings& settings, TextureImage& image)
+		{
+			if (!TextureCooker::decode(filePath, settings, image)) return false;
+			if (settings.GenerateMips) TextureCooker::generateMips(image);
+			if (settings.Compress) TextureCooker::compress(image);
+			return true;
+		}
+	}
+
+	bool TextureCooker::s_initialised = false; //!< Initialise with false
+	bool TextureCooker::s_enabled = false; //!< Initialise with false
+	bool TextureCooker::s_compress = false; //!< Initialise with false
+	bool TextureCooker::s_verify = false; //!< Initialise with false
+	std::string TextureCooker::s_directory = ""; //!< Initialise with empty string
+
+	//! getChannels()
+	/*!
+	\return a const uint32_t - The number of channels of the pixels, once decompressed for block formats
+	*/
+	const uint32_t TextureImage::getChannels() const
+	{
+		switch (Format)
+		{
+			case TextureImageFormat::R8: return 1;
+			case TextureImageFormat::RGB8: return 3;
+			case TextureImageFormat::BC1: return 3;
+			default: return 4;
+		}
+	}
+
+	//! initialise()
+	void TextureCooker::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("textureCook")) return;
+
+		s_enabled = configData["textureCook"]["enabled"].get<uint32_t>() != 0;
+		s_directory = configData["textureCook"]["directory"].get<std::string>();
+		s_compress = configData["textureCook"]["compress"].get<uint32_t>() != 0;
+		s_verify = configData["textureCook"]["verify"].get<uint32_t>() != 0;
+
+		if (s_enabled)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(s_directory, error);
+			if (error)
+			{
+				ENGINE_ERROR("[TextureCooker::initialise] Cannot create the cooked texture directory: {0}.", s_directory);
+				s_enabled = false;
+			}
+		}
+	}
+
+	//! getCookedPath()
+	/*!
+	\param sourcePath a const std::string& - The source image
+	\param settings a const TextureCookSettings& - How the source is cooked
+	\return a std::string - The cooked file
+	*/
+	std::string TextureCooker::getCookedPath(const std::string& sourcePath, const TextureCookSettings& settings)
+	{
+		const uint32_t flags = (settings.FlipUVs ? 1 : 0) | (settings.GenerateMips ? 2 : 0) | (settings.Compress ? 4 : 0) | (settings.ForceRGBA ? 8 : 0);
+		const uint64_t key = MemoryUtils::hash(&flags, sizeof(uint32_t), MemoryUtils::hash(sourcePath.data(), sourcePath.size()));
+
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+		return s_directory + "/" + name + ".ctex";
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Are cooked textures used
+	*/
+	const bool TextureCooker::isEnabled()
+	{
+		initialise();
+		return s_enabled;
+	}
+
+	//! shouldCompress()
+	/*!
+	\return a const bool - Are textures compressed unless they opt out
+	*/
+	const bool TextureCooker::shouldCompress()
+	{
+		initialise();
+		return s_compress;
+	}
+
+	//! getSize()
+	/*!
+	\param filePath a const std::string& - The source image
+	\param size a glm::ivec2& - The width and height
+	\return a const bool - Could the image's header be read
+	*/
+	const bool TextureCooker::getSize(const std::string& filePath, glm::ivec2& size)
+	{
+		int32_t channels;
+		return stbi_info(filePath.c_str(), &size.x, &size.y, &channels) != 0;
+	}
+
+	//! decode()
+	/*!
+	\param filePath a const std::string& - The source image
+	\param settings a const TextureCookSettings& - How to cook the source, only the flip and channels are used
+	\param image a TextureImage& - The image, with only its first level
+	\return a const bool - Was the source decoded
+	*/
+	const bool TextureCooker::decode(const std::string& filePath, const TextureCookSettings& settings, TextureImage& image)
+	{
+		// The flip is done here rather than by stb_image, its flip setting is shared by every thread
+		int32_t width, height, channels;
+		unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, settings.ForceRGBA ? 4 : 0);
+		if (!data)
+		{
+			ENGINE_ERROR("[TextureCooker::decode] Could not load the texture from file: {0}", filePath);
+			return false;
+		}
+		if (settings.ForceRGBA) channels = 4;
+
+		// Grey with alpha has no colour format of its own, so it is expanded to RGBA
+		image.Format = channels == 1 ? TextureImageFormat::R8 : channels == 3 ? TextureImageFormat::RGB8 : TextureImageFormat::RGBA8;
+		const uint32_t imageChannels = image.getChannels();
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+
+		image.Data.resize(pixelCount * imageChannels);
+		if (channels == 2)
+		{
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				image.Data[i * 4] = image.Data[i * 4 + 1] = image.Data[i * 4 + 2] = data[i * 2];
+				image.Data[i * 4 + 3] = data[i * 2 + 1];
+			}
+		}
+		else
+			memcpy(image.Data.data(), data, image.Data.size());
+
+		stbi_image_free(data);
+
+		if (settings.FlipUVs)
+		{
+			const size_t rowSize = static_cast<size_t>(width) * imageChannels;
+			for (int32_t y = 0; y < height / 2; y++)
+				std::swap_ranges(image.Data.begin() + (y * rowSize), image.Data.begin() + ((y + 1) * rowSize), image.Data.begin() + ((height - 1 - y) * rowSize));
+		}
+
+		image.Mips.clear();
+		image.Mips.push_back({ static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, image.Data.size() });
+		return true;
+	}
+
+	//! generateMips()
+	/*!
+	\param image a TextureImage& - The image, every level below the first is replaced
+	*/
+	void TextureCooker::generateMips(TextureImage& image)
+	{
+		if (image.isCompressed() || image.Mips.empty()) return;
+
+		const uint32_t channels = image.getChannels();
+		image.Mips.resize(1);
+
+		// Reserve every level up front so the data is only allocated once
+		uint64_t totalSize = image.Mips[0].Size;
+		for (uint32_t width = image.getWidth(), height = image.getHeight(); width > 1 || height > 1;)
+		{
+			width = glm::max(width / 2, 1u);
+			height = glm::max(height / 2, 1u);
+			totalSize += static_cast<uint64_t>(width) * height * channels;
+		}
+		image.Data.reserve(static_cast<size_t>(totalSize));
+
+		// Each level is a box filter of the one above it, an odd edge reuses its last pixel
+		while (image.Mips.back().Width > 1 || image.Mips.back().Height > 1)
+		{
+			const TextureMipLevel parent = image.Mips.back();
+			TextureMipLevel level;
+			level.Width = glm::max(parent.Width / 2, 1u);
+			level.Height = glm::max(parent.Height / 2, 1u);
+			level.Offset = image.Data.size();
+			level.Size = static_cast<uint64_t>(level.Width) * level.Height * channels;
+			image.Data.resize(static_cast<size_t>(level.Offset + level.Size));
+
+			const uint8_t* source = image.Data.data() + parent.Offset;
+			uint8_t* destination = image.Data.data() + level.Offset;
+			for (uint32_t y = 0; y < level.Height; y++)
+			{
+				const uint32_t y0 = glm::min(y * 2, parent.Height - 1), y1 = glm::min(y * 2 + 1, parent.Height - 1);
+				for (uint32_t x = 0; x < level.Width; x++)
+				{
+					const uint32_t x0 = glm::min(x * 2, parent.Width - 1), x1 = glm::min(x * 2 + 1, parent.Width - 1);
+					for (uint32_t c = 0; c < channels; c++)
+					{
+						const uint32_t sum = source[(y0 * parent.Width + x0) * channels + c] + source[(y0 * parent.Width + x1) * channels + c]
+							+ source[(y1 * parent.Width + x0) * channels + c] + source[(y1 * parent.Width + x1) * channels + c];
+						destination[(y * level.Width + x) * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+					}
+				}
+			}
+
+			image.Mips.push_back(level);
+		}
+	}
+
+	//! compress()
+	/*!
+	\param image a TextureImage& - The image, RGB becomes BC1 and RGBA becomes BC3
+	\return a const bool - Was the image compressed, single channel images are left as they are
+	*/
+	const bool TextureCooker::compress(TextureImage& image)
+	{
+		if (image.Format != TextureImageFormat::RGB8 && image.Format != TextureImageFormat::RGBA8) return false;
+
+		const bool alpha = image.Format == TextureImageFormat::RGBA8;
+		const uint32_t channels = image.getChannels();
+
+		TextureImage compressed;
+		compressed.Format = alpha ? TextureImageFormat::BC3 : TextureImageFormat::BC1;
+		const uint32_t blockSize = getBlockSize(compressed.Format);
+
+		uint64_t totalSize = 0;
+		for (auto& mip : image.Mips) totalSize += getLevelSize(compressed.Format, mip.Width, mip.Height);
+		compressed.Data.resize(static_cast<size_t>(totalSize));
+
+		uint64_t offset = 0;
+		uint8_t block[64];
+		for (auto& mip : image.Mips)
+		{
+			const TextureMipLevel level = { mip.Width, mip.Height, offset, getLevelSize(compressed.Format, mip.Width, mip.Height) };
+			const uint8_t* source = image.getMipData(static_cast<uint32_t>(compressed.Mips.size()));
+			uint8_t* output = compressed.Data.data() + offset;
+
+			// Blocks past the edge of the level repeat its last row and column
+			for (uint32_t blockY = 0; blockY < mip.Height; blockY += 4)
+			{
+				for (uint32_t blockX = 0; blockX < mip.Width; blockX += 4)
+				{
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						const uint32_t x = glm::min(blockX + (i & 3), mip.Width - 1), y = glm::min(blockY + (i >> 2), mip.Height - 1);
+						const uint8_t* pixel = source + ((static_cast<size_t>(y) * mip.Width + x) * channels);
+						block[i * 4] = pixel[0];
+						block[i * 4 + 1] = pixel[1];
+						block[i * 4 + 2] = pixel[2];
+						block[i * 4 + 3] = alpha ? pixel[3] : 255;
+					}
+
+					if (alpha)
+					{
+						encodeAlphaBlock(block, output);
+						encodeColourBlock(block, output + 8);
+					}
+					else
+						encodeColourBlock(block, output);
+					output += blockSize;
+				}
+			}
+
+			compressed.Mips.push_back(level);
+			offset += level.Size;
+		}
+
+		image = std::move(compressed);
+		return true;
+	}
+
+	//! decompress()
+	/*!
+	\param image a const TextureImage& - The image
+	\param mip a const uint32_t - The level
+	\param pixels a std::vector<uint8_t>& - The pixels of the level, RGB for BC1 and RGBA for BC3
+	\return a const bool - Was the level expanded, levels which are not compressed are copied
+	*/
+	const bool TextureCooker::decompress(const TextureImage& image, const uint32_t mip, std::vector<uint8_t>& pixels)
+	{
+		if (mip >= image.Mips.size()) return false;
+
+		const TextureMipLevel& level = image.Mips[mip];
+		const uint8_t* input = image.getMipData(mip);
+		if (!image.isCompressed())
+		{
+			pixels.assign(input, input + level.Size);
+			return true;
+		}
+
+		const bool alpha = image.Format == TextureImageFormat::BC3;
+		const uint32_t channels = image.getChannels();
+		const uint32_t blockSize = getBlockSize(image.Format);
+		pixels.resize(static_cast<size_t>(level.Width) * level.Height * channels);
+
+		uint8_t block[64];
+		for (uint32_t blockY = 0; blockY < level.Height; blockY += 4)
+		{
+			for (uint32_t blockX = 0; blockX < level.Width; blockX += 4)
+			{
+				if (alpha)
+				{
+					decodeColourBlock(input + 8, block, false);
+					decodeAlphaBlock(input, block);
+				}
+				else
+					decodeColourBlock(input, block, true);
+				input += blockSize;
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					const uint32_t x = blockX + (i & 3), y = blockY + (i >> 2);
+					if (x >= level.Width || y >= level.Height) continue;
+					memcpy(pixels.data() + ((static_cast<size_t>(y) * level.Width + x) * channels), block + (i * 4), channels);
+				}
+			}
+		}
+		return true;
+	}
+
+	//! read()
+	/*!
+	\param cookedPath a const std::string& - The cooked file
+	\param image a TextureImage& - The image
+	\param sourceSize a const uint64_t - The size of the source image, the file is only read if it matches, 0 to read any
+	\param sourceTime a const int64_t - The write time of the source image, the file is only read if it matches, 0 to read any
+	\return a const bool - Was the file a valid cooked texture of the source
+	*/
+	const bool TextureCooker::read(const std::string& cookedPath, TextureImage& image, const uint64_t sourceSize, const int64_t sourceTime)
+	{
+		MappedFile file;
+		if (!file.open(cookedPath)) return false;
+		if (file.getSize() < sizeof(CookedTextureHeader)) return false;
+
+		CookedTextureHeader header;
+		memcpy(&header, file.getData(), sizeof(CookedTextureHeader));
+		if (header.magic != CookedTextureFormat::Magic || header.version != CookedTextureFormat::Version) return false;
+		if ((sourceSize || sourceTime) && (header.sourceSize != sourceSize || header.sourceTime != sourceTime)) return false;
+		if (header.format > static_cast<uint32_t>(TextureImageFormat::BC3) || header.mipCount == 0 || header.mipCount > MaxMipCount) return false;
+
+		const uint64_t tableSize = static_cast<uint64_t>(header.mipCount) * sizeof(TextureMipLevel);
+		if (sizeof(CookedTextureHeader) + tableSize + header.dataSize != file.getSize()) return false;
+
+		image.Format = static_cast<TextureImageFormat>(header.format);
+		image.Mips.resize(header.mipCount);
+		memcpy(image.Mips.data(), file.getData() + sizeof(CookedTextureHeader), static_cast<size_t>(tableSize));
+
+		for (auto& mip : image.Mips)
+		{
+			if (mip.Width == 0 || mip.Height == 0 || mip.Size != getLevelSize(image.Format, mip.Width, mip.Height) || mip.Offset > header.dataSize || mip.Size > header.dataSize - mip.Offset)
+			{
+				image.Mips.clear();
+				return false;
+			}
+		}
+
+		const uint8_t* data = file.getData() + sizeof(CookedTextureHeader) + tableSize;
+		image.Data.assign(data, data + header.dataSize);
+		return true;
+	}
+
+	//! write()
+	/*!
+	\param cookedPath a const std::string& - The cooked file
+	\param image a const TextureImage& - The image
+	\param sourceSize a const uint64_t - The size of the source image
+	\param sourceTime a const int64_t - The write time of the source image
+	\return a const bool - Was the file written
+	*/
+	const bool TextureCooker::write(const std::string& cookedPath, const TextureImage& image, const uint64_t sourceSize, const int64_t sourceTime)
+	{
+		if (image.Mips.empty() || image.Mips.size() > MaxMipCount) return false;
+
+		CookedTextureHeader header;
+		header.sourceSize = sourceSize;
+		header.sourceTime = sourceTime;
+		header.format = static_cast<uint32_t>(image.Format);
+		header.mipCount = static_cast<uint32_t>(image.Mips.size());
+		header.dataSize = image.Data.size();
+
+		std::ofstream file(cookedPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			ENGINE_ERROR("[TextureCooker::write] Cannot write the cooked texture: {0}.", cookedPath);
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(CookedTextureHeader));
+		file.write(reinterpret_cast<const char*>(image.Mips.data()), image.Mips.size() * sizeof(TextureMipLevel));
+		file.write(reinterpret_cast<const char*>(image.Data.data()), image.Data.size());
+		return static_cast<bool>(file);
+	}
+
+	//! cook()
+	/*!
+	\param sourcePath a const std::string& - The source image
+	\param cookedPath a const std::string& - The cooked file
+	\param settings a const TextureCookSettings& - How to cook the source
+	\return a const bool - Was the texture cooked
+	*/
+	const bool TextureCooker::cook(const std::string& sourcePath, const std::string& cookedPath, const TextureCookSettings& settings)
+	{
+		std::error_code error;
+		const uint64_t sourceSize = static_cast<uint64_t>(std::filesystem::file_size(sourcePath, error));
+		const int64_t sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count());
+
+		TextureImage image;
+		return build(sourcePath, settings, image) && write(cookedPath, image, sourceSize, sourceTime);
+	}
+
+	//! verify()
+	/*!
+	\param sourcePath a const std::string& - The source image
+	\param cookedPath a const std::string& - The cooked file
+	\param settings a const TextureCookSettings& - How the source was cooked
+	\param maxError a const float - The largest root mean square error of a compressed level, levels which are not compressed must match exactly
+	\return a const bool - Does every level of the cooked texture match the source
+	*/
+	const bool TextureCooker::verify(const std::string& sourcePath, const std::string& cookedPath, const TextureCookSettings& settings, const float maxError)
+	{
+		TextureImage cooked;
+		if (!read(cookedPath, cooked))
+		{
+			ENGINE_ERROR("[TextureCooker::verify] Cannot read the cooked texture: {0}.", cookedPath);
+			return false;
+		}
+
+		// The expected levels are built again from the source, without compression
+		TextureImage expected;
+		if (!decode(sourcePath, settings, expected)) return false;
+		if (settings.GenerateMips) generateMips(expected);
+
+		const bool formatMatches = cooked.Format == expected.Format
+			|| (cooked.Format == TextureImageFormat::BC1 && expected.Format == TextureImageFormat::RGB8)
+			|| (cooked.Format == TextureImageFormat::BC3 && expected.Format == TextureImageFormat::RGBA8);
+		if (!formatMatches || cooked.Mips.size() != expected.Mips.size())
+		{
+			ENGINE_ERROR("[TextureCooker::verify] The cooked texture: {0} does not have the format or levels of its source: {1}.", cookedPath, sourcePath);
+			return false;
+		}
+
+		std::vector<uint8_t> pixels;
+		int32_t largestDifference = 0;
+		double squaredError = 0.0;
+		uint64_t sampleCount = 0;
+		for (uint32_t mip = 0; mip < cooked.Mips.size(); mip++)
+		{
+			if (cooked.Mips[mip].Width != expected.Mips[mip].Width || cooked.Mips[mip].Height != expected.Mips[mip].Height || !decompress(cooked, mip, pixels) || pixels.size() != expected.Mips[mip].Size)
+			{
+				ENGINE_ERROR("[TextureCooker::verify] Level {0} of the cooked texture: {1} does not match its source: {2}.", mip, cookedPath, sourcePath);
+				return false;
+			}
+
+			const uint8_t* source = expected.getMipData(mip);
+			for (size_t i = 0; i < pixels.size(); i++)
+			{
+				const int32_t difference = glm::abs(static_cast<int32_t>(pixels[i]) - static_cast<int32_t>(source[i]));
+				largestDifference = glm::max(largestDifference, difference);
+				squaredError += static_cast<double>(difference) * difference;
+			}
+			sampleCount += pixels.size();
+		}
+
+		const float error = sampleCount ? static_cast<float>(std::sqrt(squaredError / static_cast<double>(sampleCount))) : 0.f;
+		const bool passed = cooked.isCompressed() ? error <= maxError : largestDifference == 0;
+
+		if (passed)
+			ENGINE_INFO("[TextureCooker::verify] {0}: {1} levels match, largest difference {2}, RMS error {3}.", sourcePath, cooked.Mips.size(), largestDifference, error);
+		else
+			ENGINE_ERROR("[TextureCooker::verify] {0}: the cooked levels do not match, largest difference {1}, RMS error {2}.", sourcePath, largestDifference, error);
+		return passed;
+	}
+
+	//! load()
+	/*!
+	\param filePath a const std::string& - The source image
+	\param settings a const TextureCookSettings& - How to cook the source
+	\param image a TextureImage& - The image
+	\return a const bool - Was the image loaded
+	*/
+	const bool TextureCooker::load(const std::string& filePath, const TextureCookSettings& settings, TextureImage& image)
+	{
+		if (!isEnabled()) return build(filePath, settings, image);
+
+		// A cooked file is only used while the source it was cooked from is unchanged
+		std::error_code error;
+		const uint64_t sourceSize = static_cast<uint64_t>(std::filesystem::file_size(filePath, error));
+		const int64_t sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(filePath, error).time_since_epoch().count());
+		if (error)
+		{
+			ENGINE_ERROR("[TextureCooker::load] Could not find the texture file: {0}", filePath);
+			return false;
+		}
+
+		const std::string cookedPath = getCookedPath(filePath, settings);
+		if (read(cookedPath, image, sourceSize, sourceTime)) return true;
+
+		if (!build(filePath, settings, image)) return false;
+		if (write(cookedPath, image, sourceSize, sourceTime) && s_verify)
+			verify(filePath, cookedPath, settings);
+		return true;
+	}
+
+	//! loadAll()
+	/*!
+	\param jobs a std::vector<TextureLoadJob>& - The images to load
+	*/
+	void TextureCooker::loadAll(std::vector<TextureLoadJob>& jobs)
+	{
+		ENGINE_PROFILE_FUNCTION();
+
+		if (jobs.empty()) return;
+		initialise();
+
+		// Images differ a lot in size, so each worker takes the next job rather than a fixed share
+		std::atomic<size_t> next(0);
+		auto loadJobs = [&jobs, &next]()
+		{
+			for (size_t i = next++; i < jobs.size(); i = next++)
+				jobs[i].Loaded = load(jobs[i].FilePath, jobs[i].Settings, jobs[i].Image);
+		};
+
+		const uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), static_cast<uint32_t>(jobs.size()));
+		std::vector<std::thread> workers;
+		workers.reserve(threadCount - 1);
+		for (uint32_t i = 1; i < threadCount; i++)
+		{
+			workers.emplace_back([&loadJobs]()
+			{
+				Profiler::setThreadName("Texture Loader");
+				loadJobs();
+			});
+		}
+
+		loadJobs();
+		for (auto& worker : workers)
+			worker.join();
+	}
+}
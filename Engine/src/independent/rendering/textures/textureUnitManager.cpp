@@ -8,6 +8,7 @@
 #include "independent/rendering/textures/textureUnitManager.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -131,7 +132,10 @@ namespace Engine
 		// Find the texture unit the texture is bound to, and bind it
 		for (int i = 0; i < m_buffer.size(); i++)
 			if (m_buffer[i] == texture->getID())
+			{
 				texture->bind(i);
+				CounterSystem::increment(Counter::TextureBinds);
+			}
 	}
 
 	//! getBufferByTextureNames
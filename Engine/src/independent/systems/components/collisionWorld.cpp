@@ -0,0 +1,630 @@
+/*! \file collisionWorld.cpp
+*
+* \brief The colliders of a scene, capsules moved by characters are pushed out of static shapes, each other and the terrain at a fixed rate
+*
+* \author Daniel Bullin
+*
+*/
+#include <future>
+#include <thread>
+#include "independent/systems/components/collisionWorld.h"
+#include "independent/entities/components/transform.h"
+#include "independent/systems/systems/log.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/utils/frameAllocator.h"
+
+namespace Engine
+{
+	namespace
+	{
+		//! getBodyBounds()
+		/*!
+		\param body a const CapsuleBody& - The body
+		\return an AABB - The box around the capsule
+		*/
+		AABB getBodyBounds(const CapsuleBody& body)
+		{
+			return { body.Position - glm::vec3(body.Radius, 0.f, body.Radius), body.Position + glm::vec3(body.Radius, body.Height, body.Radius) };
+		}
+
+		//! pushBody()
+		/*!
+		\param body a CapsuleBody& - The body
+		\param normal a glm::vec3 - The direction to push in
+		\param depth a const float - How far to push
+		*/
+		void pushBody(CapsuleBody& body, glm::vec3 normal, const float depth)
+		{
+			// Bodies on the ground only slide sideways, the terrain decides their height
+			if (body.FollowGround)
+			{
+				normal.y = 0.f;
+				const float length = glm::length(normal);
+				if (length < 0.0001f) return;
+				normal /= length;
+			}
+
+			body.Position += normal * depth;
+		}
+	}
+
+	//! CollisionWorld()
+	/*!
+	\param fixedTimestep a const float - The time between steps in seconds
+	\param cellSize a const float - The width of a grid cell, a little larger than most static colliders works best
+	*/
+	CollisionWorld::CollisionWorld(const float fixedTimestep, const float cellSize)
+	{
+		m_fixedTimestep = fixedTimestep;
+		m_accumulator = 0.f;
+		m_cellSize = cellSize;
+		m_islandCount = 0;
+		m_heightfield = nullptr;
+	}
+
+	//! ~CollisionWorld()
+	CollisionWorld::~CollisionWorld()
+	{
+		m_statics.clear();
+		m_freeStatics.clear();
+		m_grid.clear();
+		m_bodies.clear();
+		m_freeBodies.clear();
+		m_islands.clear();
+	}
+
+	//! getCellKey()
+	/*!
+	\param x a const int32_t - The x index of the cell
+	\param z a const int32_t - The z index of the cell
+	\return an uint64_t - The key of the cell
+	*/
+	uint64_t CollisionWorld::getCellKey(const int32_t x, const int32_t z) const
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+	}
+
+	//! insertIntoGrid()
+	/*!
+	\param id a const ColliderID - The static collider
+	*/
+	void CollisionWorld::insertIntoGrid(const ColliderID id)
+	{
+		const AABB& bounds = m_statics[id].Bounds;
+		const int32_t minX = static_cast<int32_t>(floorf(bounds.Min.x / m_cellSize));
+		const int32_t maxX = static_cast<int32_t>(floorf(bounds.Max.x / m_cellSize));
+		const int32_t minZ = static_cast<int32_t>(floorf(bounds.Min.z / m_cellSize));
+		const int32_t maxZ = static_cast<int32_t>(floorf(bounds.Max.z / m_cellSize));
+
+		for (int32_t x = minX; x <= maxX; x++)
+			for (int32_t z = minZ; z <= maxZ; z++)
+				m_grid[getCellKey(x, z)].push_back(id);
+	}
+
+	//! removeFromGrid()
+	/*!
+	\param id a const ColliderID - The static collider
+	*/
+	void CollisionWorld::removeFromGrid(const ColliderID id)
+	{
+		const AABB& bounds = m_statics[id].Bounds;
+		const int32_t minX = static_cast<int32_t>(floorf(bounds.Min.x / m_cellSize));
+		const int32_t maxX = static_cast<int32_t>(floorf(bounds.Max.x / m_cellSize));
+		const int32_t minZ = static_cast<int32_t>(floorf(bounds.Min.z / m_cellSize));
+		const int32_t maxZ = static_cast<int32_t>(floorf(bounds.Max.z / m_cellSize));
+
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			for (int32_t z = minZ; z <= maxZ; z++)
+			{
+				auto cell = m_grid.find(getCellKey(x, z));
+				if (cell == m_grid.end()) continue;
+
+				auto it = std::find(cell->second.begin(), cell->second.end(), id);
+				if (it != cell->second.end())
+				{
+					*it = cell->second.back();
+					cell->second.pop_back();
+				}
+			}
+		}
+	}
+
+	template<typename Vector>
+	//! gatherStatics()
+	/*!
+	\param bounds a const AABB& - The box
+	\param ids a Vector& - Filled with each static collider whose box overlaps, once each
+	*/
+	void CollisionWorld::gatherStatics(const AABB& bounds, Vector& ids) const
+	{
+		const int32_t minX = static_cast<int32_t>(floorf(bounds.Min.x / m_cellSize));
+		const int32_t maxX = static_cast<int32_t>(floorf(bounds.Max.x / m_cellSize));
+		const int32_t minZ = static_cast<int32_t>(floorf(bounds.Min.z / m_cellSize));
+		const int32_t maxZ = static_cast<int32_t>(floorf(bounds.Max.z / m_cellSize));
+
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			for (int32_t z = minZ; z <= maxZ; z++)
+			{
+				auto cell = m_grid.find(getCellKey(x, z));
+				if (cell == m_grid.end()) continue;
+
+				for (auto id : cell->second)
+				{
+					const AABB& other = m_statics[id].Bounds;
+					if (other.Min.x <= bounds.Max.x && other.Max.x >= bounds.Min.x && other.Min.y <= bounds.Max.y && other.Max.y >= bounds.Min.y &&
+						other.Min.z <= bounds.Max.z && other.Max.z >= bounds.Min.z)
+						ids.push_back(id);
+				}
+			}
+		}
+
+		// A collider spanning several cells is found once per cell
+		std::sort(ids.begin(), ids.end());
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	}
+
+	//! onUpdate()
+	/*!
+	\param timestep a const float - The time since the last frame
+	*/
+	void CollisionWorld::onUpdate(const float timestep)
+	{
+		ENGINE_PROFILE_FUNCTION();
+
+		m_accumulator += timestep;
+		uint32_t steps = static_cast<uint32_t>(m_accumulator / m_fixedTimestep);
+		if (steps > MaxStepsPerFrame)
+		{
+			steps = MaxStepsPerFrame;
+			m_accumulator = 0.f;
+		}
+		else
+			m_accumulator -= steps * m_fixedTimestep;
+
+		// Movement asked for this frame is kept until a frame has a step to spend it in
+		if (steps == 0) return;
+
+		// Spread the movement evenly over the steps, each takes its share of what is left
+		for (uint32_t i = 0; i < steps; i++)
+			step(1.f / static_cast<float>(steps - i));
+
+		for (auto& body : m_bodies)
+		{
+			if (body.Active && body.Owner)
+				body.Owner->setLocalPosition(body.Position);
+		}
+	}
+
+	//! step()
+	/*!
+	\param fraction a const float - The part of each body's remaining movement to use in this step
+	*/
+	void CollisionWorld::step(const float fraction)
+	{
+		for (auto& body : m_bodies)
+		{
+			if (!body.Active) continue;
+
+			const glm::vec3 move = body.Displacement * fraction;
+			body.Displacement -= move;
+			body.Position += move;
+		}
+
+		buildIslands();
+
+		uint32_t bodyCount = static_cast<uint32_t>(m_bodies.size() - m_freeBodies.size());
+		uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), m_islandCount);
+
+		// Islands share no bodies so they can be solved on any thread, static colliders and the terrain are only read
+		if (bodyCount < ParallelBodyCount || threadCount < 2)
+		{
+			for (uint32_t i = 0; i < m_islandCount; i++)
+				solveIsland(m_islands[i]);
+			return;
+		}
+
+		auto solveEvery = [this, threadCount](const uint32_t first)
+		{
+			for (uint32_t i = first; i < m_islandCount; i += threadCount)
+				solveIsland(m_islands[i]);
+		};
+
+		std::vector<std::future<void>> workers;
+		workers.reserve(threadCount - 1);
+		for (uint32_t i = 1; i < threadCount; i++)
+			workers.push_back(std::async(std::launch::async, solveEvery, i));
+
+		solveEvery(0);
+		for (auto& worker : workers)
+			worker.wait();
+	}
+
+	//! buildIslands()
+	void CollisionWorld::buildIslands()
+	{
+		ScratchArena scratch;
+		auto bodies = scratch.createVector<BodyID>(m_bodies.size());
+		for (BodyID id = 0; id < m_bodies.size(); id++)
+		{
+			if (m_bodies[id].Active)
+				bodies.push_back(id);
+		}
+
+		// Sort by the left edge so each body only has to be checked against the ones which start before it ends
+		std::sort(bodies.begin(), bodies.end(), [this](const BodyID a, const BodyID b)
+		{
+			return m_bodies[a].Position.x - m_bodies[a].Radius < m_bodies[b].Position.x - m_bodies[b].Radius;
+		});
+
+		auto parent = scratch.createVector<uint32_t>(bodies.size());
+		for (uint32_t i = 0; i < bodies.size(); i++)
+			parent.push_back(i);
+
+		auto findRoot = [&parent](uint32_t i)
+		{
+			while (parent[i] != i)
+			{
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+			}
+			return i;
+		};
+
+		for (uint32_t i = 0; i < bodies.size(); i++)
+		{
+			const AABB a = getBodyBounds(m_bodies[bodies[i]]);
+			for (uint32_t j = i + 1; j < bodies.size(); j++)
+			{
+				const AABB b = getBodyBounds(m_bodies[bodies[j]]);
+				if (b.Min.x > a.Max.x) break;
+
+				if (b.Min.y <= a.Max.y && b.Max.y >= a.Min.y && b.Min.z <= a.Max.z && b.Max.z >= a.Min.z)
+					parent[findRoot(j)] = findRoot(i);
+			}
+		}
+
+		// Give each root an island, bodies touching nothing are islands of one
+		auto islandOf = scratch.createVector<uint32_t>(bodies.size());
+		islandOf.resize(bodies.size(), 0xFFFFFFFF);
+		for (auto& island : m_islands)
+			island.clear();
+		m_islandCount = 0;
+
+		for (uint32_t i = 0; i < bodies.size(); i++)
+		{
+			const uint32_t root = findRoot(i);
+			if (islandOf[root] == 0xFFFFFFFF)
+			{
+				islandOf[root] = m_islandCount++;
+				if (m_islands.size() < m_islandCount)
+					m_islands.emplace_back();
+			}
+
+			m_islands[islandOf[root]].push_back(bodies[i]);
+		}
+	}
+
+	//! solveIsland()
+	/*!
+	\param island a const std::vector<BodyID>& - The bodies of the island
+	*/
+	void CollisionWorld::solveIsland(const std::vector<BodyID>& island)
+	{
+		for (uint32_t iteration = 0; iteration < SolverIterations; iteration++)
+		{
+			for (auto id : island)
+				resolveStatics(m_bodies[id]);
+
+			// Upright capsules overlap when their axes are closer than their radii, the vertical gap only counts when their segments do not overlap
+			for (uint32_t i = 0; i < island.size(); i++)
+			{
+				CapsuleBody& a = m_bodies[island[i]];
+				for (uint32_t j = i + 1; j < island.size(); j++)
+				{
+					CapsuleBody& b = m_bodies[island[j]];
+
+					const float aBottom = a.Position.y + a.Radius, aTop = a.Position.y + a.Height - a.Radius;
+					const float bBottom = b.Position.y + b.Radius, bTop = b.Position.y + b.Height - b.Radius;
+					float gapY = 0.f;
+					if (aBottom > bTop) gapY = aBottom - bTop;
+					else if (bBottom > aTop) gapY = aTop - bBottom;
+
+					glm::vec3 offset(a.Position.x - b.Position.x, gapY, a.Position.z - b.Position.z);
+					const float distance = glm::length(offset);
+					const float radii = a.Radius + b.Radius;
+					if (distance >= radii) continue;
+
+					const glm::vec3 normal = distance > 0.0001f ? offset / distance : glm::vec3(1.f, 0.f, 0.f);
+					const float depth = (radii - distance) * 0.5f;
+					pushBody(a, normal, depth);
+					pushBody(b, -normal, depth);
+				}
+			}
+
+			for (auto id : island)
+				resolveTerrain(m_bodies[id]);
+		}
+	}
+
+	//! resolveStatics()
+	/*!
+	\param body a CapsuleBody& - The body
+	*/
+	void CollisionWorld::resolveStatics(CapsuleBody& body)
+	{
+		ScratchArena scratch;
+		auto ids = scratch.createVector<ColliderID>(32);
+		gatherStatics(getBodyBounds(body), ids);
+
+		for (auto id : ids)
+		{
+			const StaticCollider& collider = m_statics[id];
+			const float segmentBottom = body.Position.y + body.Radius;
+			const float segmentTop = body.Position.y + body.Height - body.Radius;
+
+			if (collider.Shape == ColliderShape::Sphere)
+			{
+				const glm::vec3 closest(body.Position.x, glm::clamp(collider.Centre.y, segmentBottom, segmentTop), body.Position.z);
+				const glm::vec3 offset = closest - collider.Centre;
+				const float distance = glm::length(offset);
+				const float radii = body.Radius + collider.Radius;
+				if (distance >= radii) continue;
+
+				pushBody(body, distance > 0.0001f ? offset / distance : glm::vec3(1.f, 0.f, 0.f), radii - distance);
+				continue;
+			}
+
+			// The closest point on an upright segment to a box is found per axis, sideways from the axis and up or down to the nearest end
+			const AABB& box = collider.Bounds;
+			glm::vec3 onSegment(body.Position.x, 0.f, body.Position.z);
+			glm::vec3 onBox(glm::clamp(body.Position.x, box.Min.x, box.Max.x), 0.f, glm::clamp(body.Position.z, box.Min.z, box.Max.z));
+			if (segmentBottom > box.Max.y)
+			{
+				onSegment.y = segmentBottom;
+				onBox.y = box.Max.y;
+			}
+			else if (segmentTop < box.Min.y)
+			{
+				onSegment.y = segmentTop;
+				onBox.y = box.Min.y;
+			}
+			else
+			{
+				onSegment.y = glm::clamp(body.Position.y + body.Height * 0.5f, std::max(segmentBottom, box.Min.y), std::min(segmentTop, box.Max.y));
+				onBox.y = onSegment.y;
+			}
+
+			const glm::vec3 offset = onSegment - onBox;
+			const float distance = glm::length(offset);
+			if (distance >= body.Radius) continue;
+
+			if (distance > 0.0001f)
+			{
+				pushBody(body, offset / distance, body.Radius - distance);
+				continue;
+			}
+
+			// The axis is inside the box, leave through the nearest side
+			const float exits[4] = { body.Position.x - box.Min.x, box.Max.x - body.Position.x, body.Position.z - box.Min.z, box.Max.z - body.Position.z };
+			const glm::vec3 normals[4] = { { -1.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, 0.f, 1.f } };
+			const uint32_t nearest = static_cast<uint32_t>(std::min_element(exits, exits + 4) - exits);
+			pushBody(body, normals[nearest], exits[nearest] + body.Radius);
+		}
+	}
+
+	//! resolveTerrain()
+	/*!
+	\param body a CapsuleBody& - The body
+	*/
+	void CollisionWorld::resolveTerrain(CapsuleBody& body)
+	{
+		if (!m_heightfield) return;
+
+		const float height = m_heightfield(body.Position.x, body.Position.z);
+		if (body.FollowGround || body.Position.y < height)
+			body.Position.y = height;
+	}
+
+	//! addBox()
+	/*!
+	\param bounds a const AABB& - The box
+	\return a ColliderID - The collider
+	*/
+	ColliderID CollisionWorld::addBox(const AABB& bounds)
+	{
+		ColliderID id;
+		addBoxes(&bounds, 1, &id);
+		return id;
+	}
+
+	//! addSphere()
+	/*!
+	\param centre a const glm::vec3& - The centre
+	\param radius a const float - The radius
+	\return a ColliderID - The collider
+	*/
+	ColliderID CollisionWorld::addSphere(const glm::vec3& centre, const float radius)
+	{
+		ColliderID id = static_cast<ColliderID>(m_statics.size());
+		if (!m_freeStatics.empty())
+		{
+			id = m_freeStatics.back();
+			m_freeStatics.pop_back();
+		}
+		else
+			m_statics.emplace_back();
+
+		m_statics[id] = { ColliderShape::Sphere, { centre - glm::vec3(radius), centre + glm::vec3(radius) }, centre, radius, true };
+		insertIntoGrid(id);
+		return id;
+	}
+
+	//! addBoxes()
+	/*!
+	\param bounds a const AABB* - The boxes
+	\param count a const uint32_t - The number of boxes
+	\param ids a ColliderID* - Filled with the collider of each box
+	*/
+	void CollisionWorld::addBoxes(const AABB* bounds, const uint32_t count, ColliderID* ids)
+	{
+		if (m_freeStatics.size() < count)
+			m_statics.reserve(m_statics.size() + count - m_freeStatics.size());
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ColliderID id = static_cast<ColliderID>(m_statics.size());
+			if (!m_freeStatics.empty())
+			{
+				id = m_freeStatics.back();
+				m_freeStatics.pop_back();
+			}
+			else
+				m_statics.emplace_back();
+
+			m_statics[id] = { ColliderShape::Box, bounds[i], (bounds[i].Min + bounds[i].Max) * 0.5f, 0.f, true };
+			insertIntoGrid(id);
+			ids[i] = id;
+		}
+	}
+
+	//! removeCollider()
+	/*!
+	\param id a const ColliderID - The collider
+	*/
+	void CollisionWorld::removeCollider(const ColliderID id)
+	{
+		if (id >= m_statics.size() || !m_statics[id].Active)
+		{
+			ENGINE_ERROR("[CollisionWorld::removeCollider] The collider does not exist. ID: {0}.", id);
+			return;
+		}
+
+		removeFromGrid(id);
+		m_statics[id].Active = false;
+		m_freeStatics.push_back(id);
+	}
+
+	//! queryStatics()
+	/*!
+	\param bounds a const AABB& - The box
+	\param ids a std::vector<ColliderID>& - Filled with each static collider whose box overlaps
+	*/
+	void CollisionWorld::queryStatics(const AABB& bounds, std::vector<ColliderID>& ids) const
+	{
+		ids.clear();
+		gatherStatics(bounds, ids);
+	}
+
+	//! getStaticCount()
+	/*!
+	\return a const uint32_t - The number of static colliders
+	*/
+	const uint32_t CollisionWorld::getStaticCount() const
+	{
+		return static_cast<uint32_t>(m_statics.size() - m_freeStatics.size());
+	}
+
+	//! addCapsule()
+	/*!
+	\param position a const glm::vec3& - The bottom of the capsule
+	\param radius a const float - The radius
+	\param height a const float - The height from bottom to top
+	\param followGround a const bool - Keep the body on the terrain instead of only above it
+	\param owner a Transform* - The transform the position is written back to after each frame's steps, it should belong to a root entity
+	\return a BodyID - The body
+	*/
+	BodyID CollisionWorld::addCapsule(const glm::vec3& position, const float radius, const float height, const bool followGround, Transform* owner)
+	{
+		BodyID id = static_cast<BodyID>(m_bodies.size());
+		if (!m_freeBodies.empty())
+		{
+			id = m_freeBodies.back();
+			m_freeBodies.pop_back();
+		}
+		else
+			m_bodies.emplace_back();
+
+		m_bodies[id] = { position, glm::vec3(0.f), radius, std::max(height, radius * 2.f), followGround, true, owner };
+		return id;
+	}
+
+	//! removeBody()
+	/*!
+	\param id a const BodyID - The body
+	*/
+	void CollisionWorld::removeBody(const BodyID id)
+	{
+		if (id >= m_bodies.size() || !m_bodies[id].Active)
+		{
+			ENGINE_ERROR("[CollisionWorld::removeBody] The body does not exist. ID: {0}.", id);
+			return;
+		}
+
+		m_bodies[id].Active = false;
+		m_bodies[id].Owner = nullptr;
+		m_freeBodies.push_back(id);
+	}
+
+	//! moveBody()
+	/*!
+	\param id a const BodyID - The body
+	\param displacement a const glm::vec3& - The movement
+	*/
+	void CollisionWorld::moveBody(const BodyID id, const glm::vec3& displacement)
+	{
+		if (id < m_bodies.size() && m_bodies[id].Active)
+			m_bodies[id].Displacement += displacement;
+		else
+			ENGINE_ERROR("[CollisionWorld::moveBody] The body does not exist. ID: {0}.", id);
+	}
+
+	//! setBodyPosition()
+	/*!
+	\param id a const BodyID - The body
+	\param position a const glm::vec3& - The bottom of the capsule
+	*/
+	void CollisionWorld::setBodyPosition(const BodyID id, const glm::vec3& position)
+	{
+		if (id < m_bodies.size() && m_bodies[id].Active)
+		{
+			m_bodies[id].Position = position;
+			m_bodies[id].Displacement = glm::vec3(0.f);
+		}
+		else
+			ENGINE_ERROR("[CollisionWorld::setBodyPosition] The body does not exist. ID: {0}.", id);
+	}
+
+	//! getBodyPosition()
+	/*!
+	\param id a const BodyID - The body
+	\return a glm::vec3 - The bottom of the capsule
+	*/
+	glm::vec3 CollisionWorld::getBodyPosition(const BodyID id) const
+	{
+		if (id < m_bodies.size() && m_bodies[id].Active)
+			return m_bodies[id].Position;
+
+		ENGINE_ERROR("[CollisionWorld::getBodyPosition] The body does not exist. ID: {0}.", id);
+		return glm::vec3(0.f);
+	}
+
+	//! setHeightfield()
+	/*!
+	\param heightfield a const std::function<float(float, float)>& - Gives the terrain height at an x and z, it is called from more than one thread
+	*/
+	void CollisionWorld::setHeightfield(const std::function<float(float, float)>& heightfield)
+	{
+		m_heightfield = heightfield;
+	}
+
+	//! hasHeightfield()
+	/*!
+	\return a const bool - Does the world have a terrain
+	*/
+	const bool CollisionWorld::hasHeightfield() const
+	{
+		return static_cast<bool>(m_heightfield);
+	}
+}
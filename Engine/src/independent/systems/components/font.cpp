@@ -13,126 +13,53 @@ namespace Engine
 {
 	//!	Font()
 	/*!
-	\param ft a FT_Library& - A reference to the freetype library
-	\param fontName a const std::string& - The name of the font
-	\param fontFilePath a const std::string& - The filepath of the font
-	\param pixelSize a const uint32_t - The size of the font
-	\param firstGlyph an unsigned char - The ASCII value of the first glyph
-	\param lastGlyph an unsigned char - The ASCII value of the last glyph
+	\param bakedFont a const BakedFont& - The font's glyphs and kerning, from the font baker or the font cache
+	\param glyphAtlas a Texture2D* - The atlas texture the glyphs are in
+	\param firstGlyph a const unsigned char - The ASCII value of the first glyph
+	\param lastGlyph a const unsigned char - The ASCII value of the last glyph
 	*/
-	Font::Font(FT_Library& ft, const std::string& fontName, const std::string& fontFilePath, const uint32_t pixelSize, unsigned char firstGlyph, unsigned char lastGlyph)
+	Font::Font(const BakedFont& bakedFont, Texture2D* glyphAtlas, const unsigned char firstGlyph, const unsigned char lastGlyph)
 	{
-		ENGINE_TRACE("[Font::Font] Creating font named: {0} from file path: {1}.", fontName, fontFilePath);
+		ENGINE_TRACE("[Font::Font] Creating font named: {0} from file path: {1}.", bakedFont.Name, bakedFont.FilePath);
 
-		// Load font into font face
-		if (FT_New_Face(ft, fontFilePath.c_str(), 0, &m_fontFace))
+		if (!glyphAtlas)
 		{
-			ENGINE_ERROR("[Font::Font] Could not load font from filepath: {0}.", fontFilePath);
+			ENGINE_ERROR("[Font::Font] Invalid texture atlas. Cannot continue with font: {0}.", bakedFont.Name);
 			return;
 		}
 
-		// Set size of font (Pixel size)
-		if (FT_Set_Pixel_Sizes(m_fontFace, 0, pixelSize))
+		if (lastGlyph <= firstGlyph || lastGlyph - firstGlyph > 500)
 		{
-			ENGINE_ERROR("[Font::Font] Error freetype can not set font size: {0}.", pixelSize);
+			ENGINE_ERROR("[Font::Font] Unusual glyph data list size. Cannot continue with font: {0}.", bakedFont.Name);
 			return;
 		}
 
-		m_fontName = fontName;
-		m_fontFilePath = fontFilePath;
+		m_fontName = bakedFont.Name;
+		m_fontFilePath = bakedFont.FilePath;
+		m_pixelSize = bakedFont.PixelSize;
+		m_sdf = bakedFont.SDF;
+		m_glyphAtlas = glyphAtlas;
 		m_firstGlyph = firstGlyph;
 		m_lastGlyph = lastGlyph;
 
-		// Create the texture atlas which will create all the glyph subtextures
-		m_glyphAtlas.reset(new TextureAtlas("Font_" + m_fontName));
-
-		// Resize all the glyph data about the glyphs we will load
+		// Each glyph is kept at the index of its character, glyphs which failed to bake have no subtexture
 		m_glyphData.resize(lastGlyph - firstGlyph);
+		for (uint32_t i = 0; i < m_glyphData.size(); i++)
+			m_glyphData[i] = { static_cast<unsigned char>(firstGlyph + i), glm::vec2(0.f), glm::vec2(0.f), 0.f, nullptr };
 
-		// Create some tmp glyph data
-		std::vector<std::pair<unsigned char, std::pair<GlyphData, unsigned char*>>> tmpGlyphdata;
-		tmpGlyphdata.resize(lastGlyph - firstGlyph);
-
-		if (tmpGlyphdata.size() < 1 || tmpGlyphdata.size() > 500)
-		{
-			ENGINE_ERROR("[Font::Font] Unusual glyph data list size. Cannot continue with font: {0}.", m_fontName);
-			return;
-		}
-
-		if (!m_glyphAtlas)
-		{
-			ENGINE_ERROR("[Font::Font] Invalid texture atlas. Cannot continue with font: {0}.", m_fontName);
-			return;
-		}
-
-		// Fill the texture atlas
-		for (unsigned char ch = firstGlyph; ch < lastGlyph; ch++)
-		{
-			if (FT_Load_Char(m_fontFace, ch, FT_LOAD_RENDER))
-				ENGINE_ERROR("[Font::Font] Cannot load character into font face: {0}", ch);
-			else
-			{
-				// Get the tmp glyph data of the current character
-				auto& pair1 = tmpGlyphdata.at(ch - firstGlyph);
-
-				// Store the loaded character into the glyph data held in the tmp list
-				pair1.first = ch;
-				GlyphData& gd = pair1.second.first;
-
-				gd.ch = ch; // Store the characyer
-				gd.size = glm::vec2(m_fontFace->glyph->bitmap.width, m_fontFace->glyph->bitmap.rows); // Pixel dimensions
-				gd.bearing = glm::vec2(m_fontFace->glyph->bitmap_left, -m_fontFace->glyph->bitmap_top);
-				gd.advance = static_cast<float>(m_fontFace->glyph->advance.x >> 6);
-
-				// Create the buffer data for the glyph [Dimensions * 4 channels * size of an unsigned char]
-				glm::vec2 glyphDims = gd.size;
-				uint32_t glyphBufferSize = static_cast<uint32_t>(glyphDims.x * glyphDims.y * 4 * sizeof(unsigned char));
-				// Malloc, must delete once done
-				pair1.second.second = static_cast<unsigned char*>(malloc(glyphBufferSize));
-
-				// Convert single channel glyph data in font bitmap buffer to our 4 channel buffer
-				RtoRGBA(pair1.second.second, m_fontFace->glyph->bitmap.buffer, static_cast<uint32_t>(gd.size.x), static_cast<uint32_t>(gd.size.y));
-			}
-		}
-
-		// Sort the tmp glyph list into descending order of size
-		std::sort(tmpGlyphdata.begin(), tmpGlyphdata.end(), [](std::pair<unsigned char, std::pair<GlyphData, unsigned char*>>& a, std::pair<unsigned char, std::pair<GlyphData, unsigned char*>>& b)
-		{
-			return a.second.first.size.x > b.second.first.size.x;
-		}
-		);
-
-		// Go through each entry of the tmp list
-		for (unsigned char currentGlyph = 0; currentGlyph < (lastGlyph - firstGlyph); currentGlyph++)
+		for (auto& glyph : bakedFont.Glyphs)
 		{
-			// Get the glyph data of the current character
-			auto& gd = tmpGlyphdata.at(currentGlyph).second.first;
-
-			// Get the glyph buffer
-			auto glyphBuffer = tmpGlyphdata.at(currentGlyph).second.second;
+			if (glyph.Character < firstGlyph || glyph.Character >= lastGlyph) continue;
 
-			// Send the glyph data, updated glyph buffer and subtexture reference to atlas to create subtexture
-			if (!m_glyphAtlas->add(static_cast<uint32_t>(gd.size.x), static_cast<uint32_t>(gd.size.y), 4, glyphBuffer, gd.subTexture, std::string(1, char(gd.ch))))
-				ENGINE_ERROR("Font::Font] Error adding to text buffer to the texture atlas.");
-			else
-			{
-				// Now update the actual list of loaded glyphs with tmp glyph data
-				m_glyphData.at(currentGlyph) = gd;
-			}
-			// No longer need buffer, free the memory
-			free(glyphBuffer);
-		}
-
-		// Sort actual list of glyph data by character order (ASCII)
-		std::sort(m_glyphData.begin(), m_glyphData.end(), [](GlyphData& a, GlyphData& b)
-		{
-			return a.ch < b.ch;
+			GlyphData& gd = m_glyphData[glyph.Character - firstGlyph];
+			gd.size = glyph.Size;
+			gd.bearing = glyph.Bearing;
+			gd.advance = glyph.Advance;
+			gd.subTexture = new SubTexture(std::string(1, char(glyph.Character)), glyphAtlas, glyph.UVStart, glyph.UVEnd, false);
 		}
-		);
-
-		// Registering the texture atlas for this font with the resource manager
-		if(m_glyphAtlas) ResourceManager::registerResource(getName(), m_glyphAtlas->getBaseTexture());
 
+		for (auto& kerning : bakedFont.Kerning)
+			m_kerning[kerning.Pair] = kerning.Amount;
 	}
 
 	//! ~Font()
@@ -170,6 +97,24 @@ namespace Engine
 		return m_fontFilePath;
 	}
 
+	//!	getPixelSize()
+	/*!
+	\return a const uint32_t - The size of the font in pixels
+	*/
+	const uint32_t Font::getPixelSize() const
+	{
+		return m_pixelSize;
+	}
+
+	//!	isSDF()
+	/*!
+	\return a const bool - Are the glyphs signed distance fields, drawn with the distance field text material
+	*/
+	const bool Font::isSDF() const
+	{
+		return m_sdf;
+	}
+
 	//!	getFirstGlyph()
 	/*!
 	\return a const unsigned char - The first glyph
@@ -197,6 +142,18 @@ namespace Engine
 		return m_glyphData;
 	}
 
+	//! getKerning()
+	/*!
+	\param left a const unsigned char - The character before
+	\param right a const unsigned char - The character after
+	\return a const float - The pixels to move the pen by between the two characters, 0 if the font has no kerning
+	*/
+	const float Font::getKerning(const unsigned char left, const unsigned char right) const
+	{
+		auto it = m_kerning.find((static_cast<uint32_t>(left) << 8) | right);
+		return it != m_kerning.end() ? it->second : 0.f;
+	}
+
 	//! printFontDetails()
 	void Font::printFontDetails()
 	{
@@ -206,8 +163,11 @@ namespace Engine
 		ENGINE_TRACE("First Glyph: {0}", m_firstGlyph);
 		ENGINE_TRACE("Last Glyph: {0}", m_lastGlyph);
 
+		ENGINE_TRACE("Pixel Size: {0}, SDF: {1}", m_pixelSize, m_sdf);
+		ENGINE_TRACE("Kerned Pairs: {0}", m_kerning.size());
+
 		if(m_glyphAtlas)
-			ENGINE_TRACE("Glyph Atlas Base Texture ID: {0}, Name: {1}.", m_glyphAtlas->getBaseTexture()->getID(), m_glyphAtlas->getBaseTexture()->getName());
+			ENGINE_TRACE("Glyph Atlas Base Texture ID: {0}, Name: {1}.", m_glyphAtlas->getID(), m_glyphAtlas->getName());
 		else
 			ENGINE_TRACE("Invalid Glyph Atlas.");
 
@@ -243,31 +203,4 @@ namespace Engine
 		for (unsigned char c = m_firstGlyph; c < m_lastGlyph; c++)
 			printCharacterDetails(c);
 	}
-
-	//!	RtoRGBA()
-	/*!
-	\param DSTBuffer an unsigned char* - The destination buffer
-	\param SRCBuffer an unsigned char* - The source single channel buffer
-	\param width an uint32_t - The width of the glyph
-	\param height an uint32_t - The height of the glyph
-	*/
-	void Font::RtoRGBA(unsigned char* DSTBuffer, unsigned char* SRCBuffer, uint32_t width, uint32_t height)
-	{
-		unsigned char* pWalker = DSTBuffer;
-
-		int iHeight = static_cast<int>(height);
-		int iWidth = static_cast<int>(width);
-		for (int i = 0; i < iHeight; i++)
-		{
-			for (int j = 0; j < iWidth; j++)
-			{
-				*pWalker = 255; pWalker++;
-				*pWalker = 255; pWalker++;
-				*pWalker = 255; pWalker++;
-				*pWalker = *SRCBuffer;
-				pWalker++;
-				SRCBuffer++;
-			}
-		}
-	}
 }
\ No newline at end of file
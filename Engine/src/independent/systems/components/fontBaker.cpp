@@ -0,0 +1,298 @@
+/*! \file fontBaker.cpp
+*
+* \brief Rasterises the glyphs of every configured font into one atlas, opening each font file once
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstring>
+#include "independent/systems/components/fontBaker.h"
+#include "independent/rendering/textures/skylinePacker.h"
+#include "independent/rendering/textures/distanceField.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	namespace
+	{
+		/*! \struct RasterGlyph
+		* \brief A glyph rasterised at its set's size, before it is placed in the atlas
+		*/
+		struct RasterGlyph
+		{
+			uint32_t Character; //!< The character
+			glm::ivec2 Size; //!< The size of the bitmap
+			glm::vec2 Bearing; //!< The offset of the bitmap's top left from the pen
+			float Advance; //!< The distance to move the pen after the glyph
+			std::vector<unsigned char> Alpha; //!< The coverage or distance of each pixel
+			glm::ivec2 Position; //!< The bitmap's place in the atlas
+		};
+
+		/*! \struct GlyphSet
+		* \brief The glyphs of one file rasterised at one size, shared by every font drawn from them
+		*/
+		struct GlyphSet
+		{
+			std::string FilePath; //!< The font file
+			uint32_t RasterSize; //!< The size the glyphs were rasterised at
+			std::vector<RasterGlyph> Glyphs; //!< The glyphs
+			std::vector<BakedKerning> Kerning; //!< The kerned pairs at the raster size
+		};
+
+		//! rasterise()
+		/*!
+		\param face a FT_Face - The face of the set's file
+		\param set a GlyphSet& - The set to fill
+		\param settings a const FontAtlasSettings& - The atlas settings
+		\param firstGlyph a const unsigned char - The first character
+		\param lastGlyph a const unsigned char - The character after the last one
+		\return a const bool - Could the face be set to the set's size
+		*/
+		const bool rasterise(FT_Face face, GlyphSet& set, const FontAtlasSettings& settings, const unsigned char firstGlyph, const unsigned char lastGlyph)
+		{
+			if (FT_Set_Pixel_Sizes(face, 0, set.RasterSize))
+			{
+				ENGINE_ERROR("[FontBaker::bake] Error freetype can not set font size: {0}, file: {1}.", set.RasterSize, set.FilePath);
+				return false;
+			}
+
+			// Distance fields need room around the glyph for the field to fall off
+			const int32_t padding = settings.SDF ? static_cast<int32_t>(settings.SDFSpread) : 0;
+			std::vector<unsigned char> coverage;
+
+			set.Glyphs.reserve(lastGlyph - firstGlyph);
+			for (uint32_t ch = firstGlyph; ch < lastGlyph; ch++)
+			{
+				if (FT_Load_Char(face, ch, FT_LOAD_RENDER))
+				{
+					ENGINE_ERROR("[FontBaker::bake] Cannot load character into font face: {0}, file: {1}.", ch, set.FilePath);
+					continue;
+				}
+
+				const FT_Bitmap& bitmap = face->glyph->bitmap;
+				const int32_t width = static_cast<int32_t>(bitmap.width);
+				const int32_t height = static_cast<int32_t>(bitmap.rows);
+
+				RasterGlyph glyph;
+				glyph.Character = ch;
+				glyph.Advance = static_cast<float>(face->glyph->advance.x) / 64.f;
+				glyph.Position = { 0, 0 };
+
+				if (width == 0 || height == 0)
+				{
+					// Glyphs such as a space only move the pen
+					glyph.Size = { 0, 0 };
+					glyph.Bearing = { 0.f, 0.f };
+					set.Glyphs.push_back(std::move(glyph));
+					continue;
+				}
+
+				glyph.Size = { width + 2 * padding, height + 2 * padding };
+				glyph.Bearing = { static_cast<float>(face->glyph->bitmap_left - padding), static_cast<float>(-face->glyph->bitmap_top - padding) };
+
+				// Copy the rows into the middle of the padded bitmap, freetype rows can be wider than the glyph
+				coverage.assign(static_cast<size_t>(glyph.Size.x) * glyph.Size.y, 0);
+				for (int32_t y = 0; y < height; y++)
+					memcpy(&coverage[(y + padding) * glyph.Size.x + padding], bitmap.buffer + y * bitmap.pitch, width);
+
+				glyph.Alpha.resize(coverage.size());
+				if (settings.SDF)
+					DistanceField::generate(coverage.data(), glyph.Size.x, glyph.Size.y, settings.SDFSpread, glyph.Alpha.data());
+				else
+					glyph.Alpha = coverage;
+
+				set.Glyphs.push_back(std::move(glyph));
+			}
+
+			if (FT_HAS_KERNING(face))
+			{
+				// Distance field glyphs are scaled, so their kerning is kept unrounded
+				const FT_UInt mode = settings.SDF ? FT_KERNING_UNFITTED : FT_KERNING_DEFAULT;
+				for (uint32_t left = firstGlyph; left < lastGlyph; left++)
+				{
+					const FT_UInt leftIndex = FT_Get_Char_Index(face, left);
+					for (uint32_t right = firstGlyph; right < lastGlyph; right++)
+					{
+						FT_Vector delta;
+						if (!FT_Get_Kerning(face, leftIndex, FT_Get_Char_Index(face, right), mode, &delta) && delta.x != 0)
+							set.Kerning.push_back({ (left << 8) | right, static_cast<float>(delta.x) / 64.f });
+					}
+				}
+			}
+
+			return true;
+		}
+
+		//! pack()
+		/*!
+		\param sets a std::vector<GlyphSet>& - The glyph sets to place
+		\param maxSize a const uint32_t - The largest the atlas may grow to
+		\param size a glm::ivec2& - The size of the atlas the glyphs fit in
+		\return a const bool - Did every glyph fit
+		*/
+		const bool pack(std::vector<GlyphSet>& sets, const uint32_t maxSize, glm::ivec2& size)
+		{
+			// Placing the tallest glyphs first leaves the fewest gaps under the skyline
+			std::vector<RasterGlyph*> glyphs;
+			for (auto& set : sets)
+			{
+				for (auto& glyph : set.Glyphs)
+				{
+					if (glyph.Size.x > 0 && glyph.Size.y > 0)
+						glyphs.push_back(&glyph);
+				}
+			}
+
+			std::sort(glyphs.begin(), glyphs.end(), [](const RasterGlyph* a, const RasterGlyph* b)
+			{
+				if (a->Size.y != b->Size.y) return a->Size.y > b->Size.y;
+				return a->Size.x > b->Size.x;
+			}
+			);
+
+			// Start small and grow the shorter side until everything fits
+			size = { 256, 256 };
+			SkylinePacker packer(size);
+			while (true)
+			{
+				bool packed = true;
+				for (auto glyph : glyphs)
+				{
+					// A pixel is left between glyphs so linear filtering does not pick up a neighbour
+					if (!packer.pack(glyph->Size.x + 1, glyph->Size.y + 1, glyph->Position))
+					{
+						packed = false;
+						break;
+					}
+				}
+
+				if (packed) return true;
+
+				if (size.x <= size.y) size.x *= 2;
+				else size.y *= 2;
+
+				if (static_cast<uint32_t>(std::max(size.x, size.y)) > maxSize) return false;
+				packer.reset(size);
+			}
+		}
+	}
+
+	//! bake()
+	/*!
+	\param freetype a FT_Library& - The freetype library
+	\param fonts a const std::vector<FontDescription>& - The fonts to bake
+	\param settings a const FontAtlasSettings& - How to rasterise the glyphs
+	\param firstGlyph a const unsigned char - The first character
+	\param lastGlyph a const unsigned char - The character after the last one
+	\param atlas a BakedFontAtlas& - The baked atlas
+	\return a const bool - Were the fonts baked
+	*/
+	const bool FontBaker::bake(FT_Library& freetype, const std::vector<FontDescription>& fonts, const FontAtlasSettings& settings,
+		const unsigned char firstGlyph, const unsigned char lastGlyph, BakedFontAtlas& atlas)
+	{
+		atlas = BakedFontAtlas();
+		if (fonts.empty() || lastGlyph <= firstGlyph) return false;
+
+		// Fonts drawn from the same glyphs share a set, with distance fields that is every size of a file
+		std::vector<GlyphSet> sets;
+		std::vector<size_t> fontSets;
+		for (auto& font : fonts)
+		{
+			const uint32_t rasterSize = settings.SDF ? settings.SDFPixelSize : font.PixelSize;
+
+			size_t index = 0;
+			while (index < sets.size() && !(sets[index].FilePath == font.FilePath && sets[index].RasterSize == rasterSize)) index++;
+			if (index == sets.size())
+				sets.push_back({ font.FilePath, rasterSize, {}, {} });
+
+			fontSets.push_back(index);
+		}
+
+		// Each file is opened once however many sets use it
+		std::map<std::string, FT_Face> faces;
+		bool rasterised = true;
+		for (auto& set : sets)
+		{
+			FT_Face& face = faces[set.FilePath];
+			if (!face && FT_New_Face(freetype, set.FilePath.c_str(), 0, &face))
+			{
+				ENGINE_ERROR("[FontBaker::bake] Could not load font from filepath: {0}.", set.FilePath);
+				face = nullptr;
+				rasterised = false;
+				continue;
+			}
+
+			if (!rasterise(face, set, settings, firstGlyph, lastGlyph))
+				rasterised = false;
+		}
+
+		for (auto& face : faces)
+		{
+			if (face.second) FT_Done_Face(face.second);
+		}
+
+		if (!rasterised) return false;
+
+		glm::ivec2 size;
+		if (!pack(sets, settings.MaxSize, size))
+		{
+			ENGINE_ERROR("[FontBaker::bake] The glyphs do not fit in the largest atlas allowed: {0}.", settings.MaxSize);
+			return false;
+		}
+
+		// Fill the atlas, white everywhere so filtering at a glyph's edge only blends its alpha
+		atlas.Width = static_cast<uint32_t>(size.x);
+		atlas.Height = static_cast<uint32_t>(size.y);
+		atlas.Pixels.resize(static_cast<size_t>(atlas.Width) * atlas.Height * 4);
+		for (size_t i = 0; i < atlas.Pixels.size(); i += 4)
+		{
+			atlas.Pixels[i] = 255;
+			atlas.Pixels[i + 1] = 255;
+			atlas.Pixels[i + 2] = 255;
+			atlas.Pixels[i + 3] = 0;
+		}
+
+		for (auto& set : sets)
+		{
+			for (auto& glyph : set.Glyphs)
+			{
+				for (int32_t y = 0; y < glyph.Size.y; y++)
+				{
+					unsigned char* row = &atlas.Pixels[((glyph.Position.y + y) * static_cast<size_t>(atlas.Width) + glyph.Position.x) * 4];
+					for (int32_t x = 0; x < glyph.Size.x; x++)
+						row[x * 4 + 3] = glyph.Alpha[y * glyph.Size.x + x];
+				}
+			}
+		}
+
+		// Each font scales its set's glyphs to its own size
+		const glm::vec2 atlasSize = { static_cast<float>(atlas.Width), static_cast<float>(atlas.Height) };
+		for (size_t i = 0; i < fonts.size(); i++)
+		{
+			const GlyphSet& set = sets[fontSets[i]];
+			const float scale = static_cast<float>(fonts[i].PixelSize) / static_cast<float>(set.RasterSize);
+
+			BakedFont font;
+			font.Name = fonts[i].Name;
+			font.FilePath = fonts[i].FilePath;
+			font.PixelSize = fonts[i].PixelSize;
+			font.SDF = settings.SDF;
+
+			font.Glyphs.reserve(set.Glyphs.size());
+			for (auto& glyph : set.Glyphs)
+			{
+				const glm::vec2 position = glm::vec2(glyph.Position);
+				const glm::vec2 glyphSize = glm::vec2(glyph.Size);
+				font.Glyphs.push_back({ glyph.Character, glyphSize * scale, glyph.Bearing * scale, glyph.Advance * scale, position / atlasSize, (position + glyphSize) / atlasSize });
+			}
+
+			font.Kerning.reserve(set.Kerning.size());
+			for (auto& kerning : set.Kerning)
+				font.Kerning.push_back({ kerning.Pair, kerning.Amount * scale });
+
+			atlas.Fonts.push_back(std::move(font));
+		}
+
+		return true;
+	}
+}
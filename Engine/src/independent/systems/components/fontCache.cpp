@@ -0,0 +1,240 @@
+/*! \file fontCache.cpp
+*
+* \brief A disk cache of the baked font atlas and glyph metrics, so a warm start does not rasterise any glyphs
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include "independent/systems/components/fontCache.h"
+#include "independent/utils/mappedFile.h"
+#include "independent/utils/memoryUtils.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	namespace
+	{
+		/*! \struct CacheReader
+		* \brief Reads values from the mapped cache file, failing rather than reading past its end
+		*/
+		struct CacheReader
+		{
+			const uint8_t* data; //!< The mapped file
+			uint64_t size; //!< The size of the file
+			uint64_t offset; //!< The bytes read so far
+
+			//! read()
+			/*!
+			\param destination a void* - Where to copy the bytes
+			\param count a const uint64_t - The number of bytes
+			\return a const bool - Were there enough bytes left
+			*/
+			const bool read(void* destination, const uint64_t count)
+			{
+				if (count > size - offset) return false;
+				if (count > 0) memcpy(destination, data + offset, static_cast<size_t>(count));
+				offset += count;
+				return true;
+			}
+
+			//! fits()
+			/*!
+			\param count a const uint64_t - The number of values
+			\param valueSize a const uint64_t - The smallest number of bytes each value takes in the file
+			\return a const bool - Are there enough bytes left for the values, checked before anything is sized from the count
+			*/
+			const bool fits(const uint64_t count, const uint64_t valueSize) const
+			{
+				return count * valueSize <= size - offset;
+			}
+
+			//! readString()
+			/*!
+			\param string a std::string& - The string read
+			\return a const bool - Were there enough bytes left
+			*/
+			const bool readString(std::string& string)
+			{
+				uint32_t length = 0;
+				if (!read(&length, sizeof(uint32_t)) || length > size - offset) return false;
+				string.assign(reinterpret_cast<const char*>(data + offset), length);
+				offset += length;
+				return true;
+			}
+		};
+
+		//! writeString()
+		/*!
+		\param file a std::ofstream& - The file
+		\param string a const std::string& - The string to write after its length
+		*/
+		void writeString(std::ofstream& file, const std::string& string)
+		{
+			const uint32_t length = static_cast<uint32_t>(string.size());
+			file.write(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+			file.write(string.data(), length);
+		}
+	}
+
+	bool FontCache::s_initialised = false; //!< Initialise with false
+	std::string FontCache::s_filePath = ""; //!< Initialise with empty string
+
+	//! initialise()
+	void FontCache::initialise()
+	{
+		if (s_initialised) return;
+		s_initialised = true;
+
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (!configData.contains("fontAtlas") || !configData["fontAtlas"].contains("cacheFile")) return;
+
+		s_filePath = configData["fontAtlas"]["cacheFile"].get<std::string>();
+		if (s_filePath.empty()) return;
+
+		const std::filesystem::path directory = std::filesystem::path(s_filePath).parent_path();
+		if (!directory.empty())
+		{
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
+			if (error)
+			{
+				ENGINE_ERROR("[FontCache::initialise] Cannot create the font cache directory: {0}.", directory.string());
+				s_filePath.clear();
+			}
+		}
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Is the cache used
+	*/
+	const bool FontCache::isEnabled()
+	{
+		initialise();
+		return !s_filePath.empty();
+	}
+
+	//! getKey()
+	/*!
+	\param fonts a const std::vector<FontDescription>& - The fonts
+	\param settings a const FontAtlasSettings& - The atlas settings
+	\param firstGlyph a const unsigned char - The first character
+	\param lastGlyph a const unsigned char - The character after the last one
+	\return a const uint64_t - The key
+	*/
+	const uint64_t FontCache::getKey(const std::vector<FontDescription>& fonts, const FontAtlasSettings& settings, const unsigned char firstGlyph, const unsigned char lastGlyph)
+	{
+		const uint32_t values[] = { FontCacheFormat::Version, firstGlyph, lastGlyph, settings.SDF ? 1u : 0u, settings.SDFPixelSize, settings.SDFSpread, settings.MaxSize };
+		uint64_t key = MemoryUtils::hash(values, sizeof(values));
+
+		for (auto& font : fonts)
+		{
+			key = MemoryUtils::hash(font.Name.data(), font.Name.size() + 1, key);
+			key = MemoryUtils::hash(font.FilePath.data(), font.FilePath.size() + 1, key);
+			key = MemoryUtils::hash(&font.PixelSize, sizeof(uint32_t), key);
+
+			// A font file which is replaced will differ in size or time, the file itself is not read
+			std::error_code error;
+			const uint64_t fileSize = static_cast<uint64_t>(std::filesystem::file_size(font.FilePath, error));
+			const int64_t writeTime = static_cast<int64_t>(std::filesystem::last_write_time(font.FilePath, error).time_since_epoch().count());
+			key = MemoryUtils::hash(&fileSize, sizeof(uint64_t), key);
+			key = MemoryUtils::hash(&writeTime, sizeof(int64_t), key);
+		}
+
+		return key;
+	}
+
+	//! load()
+	/*!
+	\param key a const uint64_t - The key
+	\param atlas a BakedFontAtlas& - The baked atlas
+	\return a const bool - Was an atlas stored under the key
+	*/
+	const bool FontCache::load(const uint64_t key, BakedFontAtlas& atlas)
+	{
+		if (!isEnabled()) return false;
+
+		MappedFile file;
+		if (!file.open(s_filePath)) return false;
+
+		CacheReader reader = { file.getData(), file.getSize(), 0 };
+		FontCacheHeader header;
+		if (!reader.read(&header, sizeof(FontCacheHeader))) return false;
+		if (header.magic != FontCacheFormat::Magic || header.version != FontCacheFormat::Version || header.key != key)
+			return false;
+
+		atlas = BakedFontAtlas();
+		atlas.Width = header.width;
+		atlas.Height = header.height;
+
+		// Every font has two string lengths and its values, so a corrupt count cannot size the list past the file
+		if (!reader.fits(header.fontCount, sizeof(uint32_t) * 6)) return false;
+		atlas.Fonts.resize(header.fontCount);
+
+		for (auto& font : atlas.Fonts)
+		{
+			uint32_t values[4];
+			if (!reader.readString(font.Name) || !reader.readString(font.FilePath) || !reader.read(values, sizeof(values)))
+				return false;
+
+			font.PixelSize = values[0];
+			font.SDF = values[1] != 0;
+			if (!reader.fits(values[2], sizeof(BakedGlyph)) || !reader.fits(values[3], sizeof(BakedKerning)))
+				return false;
+
+			font.Glyphs.resize(values[2]);
+			font.Kerning.resize(values[3]);
+			if (!reader.read(font.Glyphs.data(), sizeof(BakedGlyph) * font.Glyphs.size()) || !reader.read(font.Kerning.data(), sizeof(BakedKerning) * font.Kerning.size()))
+				return false;
+		}
+
+		const uint64_t pixelSize = static_cast<uint64_t>(atlas.Width) * atlas.Height * 4;
+		if (pixelSize != reader.size - reader.offset) return false;
+
+		atlas.Pixels.assign(reader.data + reader.offset, reader.data + reader.size);
+		return true;
+	}
+
+	//! save()
+	/*!
+	\param key a const uint64_t - The key
+	\param atlas a const BakedFontAtlas& - The baked atlas
+	\return a const bool - Was the atlas written
+	*/
+	const bool FontCache::save(const uint64_t key, const BakedFontAtlas& atlas)
+	{
+		if (!isEnabled() || atlas.Pixels.empty()) return false;
+
+		std::ofstream file(s_filePath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			ENGINE_ERROR("[FontCache::save] Cannot write the font cache file: {0}.", s_filePath);
+			return false;
+		}
+
+		FontCacheHeader header;
+		header.key = key;
+		header.width = atlas.Width;
+		header.height = atlas.Height;
+		header.fontCount = static_cast<uint32_t>(atlas.Fonts.size());
+		file.write(reinterpret_cast<const char*>(&header), sizeof(FontCacheHeader));
+
+		for (auto& font : atlas.Fonts)
+		{
+			writeString(file, font.Name);
+			writeString(file, font.FilePath);
+
+			const uint32_t values[4] = { font.PixelSize, font.SDF ? 1u : 0u, static_cast<uint32_t>(font.Glyphs.size()), static_cast<uint32_t>(font.Kerning.size()) };
+			file.write(reinterpret_cast<const char*>(values), sizeof(values));
+			file.write(reinterpret_cast<const char*>(font.Glyphs.data()), sizeof(BakedGlyph) * font.Glyphs.size());
+			file.write(reinterpret_cast<const char*>(font.Kerning.data()), sizeof(BakedKerning) * font.Kerning.size());
+		}
+
+		file.write(reinterpret_cast<const char*>(atlas.Pixels.data()), atlas.Pixels.size());
+		return static_cast<bool>(file);
+	}
+}
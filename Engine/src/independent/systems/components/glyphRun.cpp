@@ -0,0 +1,109 @@
+/*! \file glyphRun.cpp
+*
+* \brief A string laid out in a font once, so text which does not change is not laid out again every frame
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/systems/components/glyphRun.h"
+#include "independent/systems/systems/counterSystem.h"
+
+namespace Engine
+{
+	//! GlyphRun()
+	GlyphRun::GlyphRun() : m_valid(false), m_sdf(false), m_boundsMin(0.f), m_boundsMax(0.f), m_advance(0.f), m_origin(0.f), m_tint(0.f), m_instancesValid(false)
+	{
+	}
+
+	//! build()
+	/*!
+	\param text a const std::string& - The text
+	\param font a Font* - The font
+	*/
+	void GlyphRun::build(const std::string& text, Font* font)
+	{
+		CounterSystem::increment(Counter::GlyphRunsBuilt);
+
+		m_valid = true;
+		m_instancesValid = false;
+		m_glyphs.clear();
+		m_boundsMin = glm::vec2(0.f);
+		m_boundsMax = glm::vec2(0.f);
+		m_advance = 0.f;
+
+		m_sdf = false;
+
+		if (!font) return;
+
+		m_sdf = font->isSDF();
+
+		std::vector<GlyphData>& glyphData = font->getGlyphData();
+		m_glyphs.reserve(text.size());
+
+		// Characters without a glyph move the pen by the last glyph's advance
+		float x = 0.f, advance = 0.f;
+		unsigned char previous = 0;
+		for (const char c : text)
+		{
+			const unsigned char ch = static_cast<unsigned char>(c);
+			const uint32_t index = ch - font->getFirstGlyph();
+
+			if (ch > font->getFirstGlyph() && ch <= font->getLastGlyph() && index < glyphData.size() && glyphData[index].subTexture)
+			{
+				GlyphData& gd = glyphData[index];
+				if (previous) x += font->getKerning(previous, ch);
+
+				PositionedGlyph glyph;
+				glyph.Size = gd.size;
+				glyph.Centre = glm::vec2(x, 0.f) + gd.bearing + (gd.size * 0.5f);
+				glyph.UVRect = { gd.subTexture->getUVStart(), gd.subTexture->getUVEnd() };
+				glyph.Texture = gd.subTexture;
+
+				const glm::vec2 glyphMin = glyph.Centre - (gd.size * 0.5f);
+				const glm::vec2 glyphMax = glyph.Centre + (gd.size * 0.5f);
+				m_boundsMin = m_glyphs.empty() ? glyphMin : glm::min(m_boundsMin, glyphMin);
+				m_boundsMax = m_glyphs.empty() ? glyphMax : glm::max(m_boundsMax, glyphMax);
+
+				m_glyphs.push_back(glyph);
+				advance = gd.advance;
+			}
+
+			x += advance;
+			previous = ch;
+		}
+
+		m_advance = x;
+	}
+
+	//! invalidate()
+	void GlyphRun::invalidate()
+	{
+		m_valid = false;
+		m_instancesValid = false;
+	}
+
+	//! getInstances()
+	/*!
+	\param origin a const glm::vec3& - The position of the text, only x and y move the glyphs and z is their depth
+	\param tint a const glm::vec4& - The colour of the text
+	\return a std::vector<QuadInstance2D>& - The quad of each glyph, the renderer reads them when it flushes so the run must not be moved or destroyed before then
+	*/
+	std::vector<QuadInstance2D>& GlyphRun::getInstances(const glm::vec3& origin, const glm::vec4& tint)
+	{
+		if (m_instancesValid && origin == m_origin && tint == m_tint) return m_instances;
+
+		m_origin = origin;
+		m_tint = tint;
+		m_instancesValid = true;
+		m_instances.resize(m_glyphs.size());
+
+		// Glyphs are never rotated, the texture unit of the atlas is filled in by the renderer when it is bound
+		for (size_t i = 0; i < m_glyphs.size(); i++)
+		{
+			const PositionedGlyph& glyph = m_glyphs[i];
+			m_instances[i] = QuadInstance2D({ origin.x + glyph.Centre.x, origin.y + glyph.Centre.y, origin.z, 0.f }, glyph.Size, glyph.UVRect, tint, 0, 0);
+		}
+
+		return m_instances;
+	}
+}
@@ -5,11 +5,14 @@
 * \author Daniel Bullin
 *
 */
+#include <algorithm>
 #include "independent/systems/components/scene.h"
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/windowManager.h"
 #include "independent/systems/systems/eventManager.h"
+#include "independent/systems/systems/counterSystem.h"
+#include "independent/utils/allocationTracker.h"
 
 namespace Engine
 {
@@ -23,8 +26,10 @@ namespace Engine
 		m_sceneName = name;
 		m_sceneFolderPath = sceneFolderPath;
 		m_layerManager = new LayerManager(this);
+		m_collisionWorld = new CollisionWorld;
 		m_renderPasses.reserve(ResourceManager::getConfigValue(Config::MaxRenderPassesPerScene));
 		m_mainCamera = nullptr;
+		m_nextHandle = InvalidEntityHandle + 1;
 		m_entityListUpdated = true;
 
 		// Print the scene's details upon creation
@@ -37,6 +42,10 @@ namespace Engine
 	{
 		ENGINE_INFO("[Scene::~Scene] Destroying scene: {0}.", m_sceneName);
 
+		// Nothing needs to be taken out of the list one by one as the whole scene goes
+		m_entitiesList.clear();
+		m_destroyQueue.clear();
+
 		// If there is any entities in the scene, delete them
 		if (m_rootEntities.size() != 0)
 		{
@@ -45,6 +54,14 @@ namespace Engine
 				delete rootEntity.second;
 
 			m_rootEntities.clear();
+			m_handles.clear();
+		}
+
+		// Entities remove their bodies as they are deleted, so the collision world goes after them
+		if (m_collisionWorld)
+		{
+			delete m_collisionWorld;
+			m_collisionWorld = nullptr;
 		}
 
 		// If there is a valid layer manager, delete it
@@ -71,7 +88,6 @@ namespace Engine
 		if (m_mainCamera) m_mainCamera = nullptr;
 
 		m_entityListUpdated = true;
-		m_entitiesList.clear();
 	}
 
 	//! getName()
@@ -99,51 +115,56 @@ namespace Engine
 	*/
 	void Scene::onUpdate(const float timestep, const float totalTime)
 	{
-		// Delete any entities that are scheuled to be deleted, can also update components if entity is not to be deleted
-		for (auto it = m_rootEntities.cbegin(); it != m_rootEntities.cend(); )
+		AllocationScope allocationScope(AllocationTag::Scene);
+
+		// Queue any entities that are scheduled to be deleted
+		for (auto& rootEntity : m_rootEntities)
 		{
 			// Check if entity is a valid entity
-			if (it->second)
+			if (rootEntity.second)
 			{
-				// Check if the entity is to be destroyed
-				if (it->second->getDestroyed())
-				{
-					// Do NOT delete the entity which contains the main camera
-					if (it->second == m_mainCamera->getParent())
-					{
-						ENGINE_ERROR("[Scene::onUpdate] Cannot delete the entity when it contains the scene's main camera. Scene: {0}, Entity: {1}.", m_sceneName, it->second->getName());
-						it->second->undestroy();
-						return;
-					}
-
-					// Check for validness again and then delete
-					if (it->second) delete it->second;
-					m_rootEntities.erase(it++);
-					setEntityListUpdated(true);
-				}
+				// Deleting here would change the maps being walked, so every destroyed entity is deleted at the end of the frame
+				if (rootEntity.second->getDestroyed())
+					queueDestroyedEntity(rootEntity.second);
 				else
-				{
-					// Entity is not to be deleted, update components
-					if (it->second)
-					{
-						it->second->onUpdate(timestep, totalTime);
-						for (auto& component : it->second->getAllComponents())
-						{
-							// Check if component is valid
-							if (component)
-								component->onUpdate(timestep, totalTime);
-						}
-						++it;
-					}
-				}
+					rootEntity.second->onUpdate(timestep, totalTime);
 			}
 		}
 
+		// Only components which asked to be updated are, the rest are never visited
+		TickScheduler::run(TickGroup::Update, this, timestep, totalTime);
+
+		// Resolve collisions for the movement asked for this frame
+		if (m_collisionWorld)
+			m_collisionWorld->onUpdate(timestep);
+
 		// Update the layer manager if it is valid
 		if (m_layerManager)
 			m_layerManager->onUpdate(timestep, totalTime);
 	}
 
+	//! registerRootEntity()
+	/*!
+	\param name a const std::string& - The name of the entity
+	\param entity an Entity* - A pointer to the entity
+	*/
+	void Scene::registerRootEntity(const std::string& name, Entity* entity)
+	{
+		if (entity->getParentEntity() != nullptr)
+			entity->getParentEntity()->getChildEntities().erase(entity->getName());
+
+		// Every root entity gets a handle, whether it is named or not
+		if (entity->getHandle() == InvalidEntityHandle)
+			entity->setHandle(m_nextHandle++);
+		m_handles[entity->getHandle()] = entity;
+
+		// Set the parent scene of the entity and its name
+		m_rootEntities[name] = entity;
+		entity->setParentScene(this);
+		entity->setParentEntity(nullptr);
+		entity->setName(name);
+	}
+
 	//! addEntity()
 	/*!
 	\param name a const std::string& - The name of the entity
@@ -160,20 +181,62 @@ namespace Engine
 				return;
 			}
 
-			if (entity->getParentEntity() != nullptr)
-				entity->getParentEntity()->getChildEntities().erase(entity->getName());
-
-			// Set the parent scene of the entity and its name
-			m_rootEntities[name] = entity;
-			entity->setParentScene(this);
-			entity->setParentEntity(nullptr);
-			entity->setName(name);
-			setEntityListUpdated(true);
+			registerRootEntity(name, entity);
+			addToEntityList(entity);
 		}
 		else
 			ENGINE_ERROR("[Scene::addEntity] Name for entity already taken. Cannot add. Entity Name: {0} for scene: {1}.", name, m_sceneName);
 	}
 
+	//! addEntity()
+	/*!
+	\param entity an Entity* - A pointer to the entity
+	\return an EntityHandle - The handle of the entity, InvalidEntityHandle if it could not be added
+	*/
+	EntityHandle Scene::addEntity(Entity* entity)
+	{
+		if (!entity)
+		{
+			ENGINE_ERROR("[Scene:addEntity] An invalid entity pointer was provided for scene: {0}.", m_sceneName);
+			return InvalidEntityHandle;
+		}
+
+		// Unnamed entities are named after their handle, '#' is never used in scene files
+		if (entity->getHandle() == InvalidEntityHandle)
+			entity->setHandle(m_nextHandle++);
+		registerRootEntity("#" + std::to_string(entity->getHandle()), entity);
+		addToEntityList(entity);
+
+		return entity->getHandle();
+	}
+
+	//! addEntities()
+	/*!
+	\param entities a const std::vector<Entity*>& - The entities, each is given a handle
+	*/
+	void Scene::addEntities(const std::vector<Entity*>& entities)
+	{
+		for (auto& entity : entities)
+		{
+			if (entity)
+			{
+				if (entity->getHandle() == InvalidEntityHandle)
+					entity->setHandle(m_nextHandle++);
+				registerRootEntity("#" + std::to_string(entity->getHandle()), entity);
+			}
+			else
+				ENGINE_ERROR("[Scene:addEntities] An invalid entity pointer was provided for scene: {0}.", m_sceneName);
+		}
+
+		// Grow the entity list once for the whole batch
+		m_entitiesList.reserve(m_entitiesList.size() + entities.size());
+		for (auto& entity : entities)
+		{
+			if (entity)
+				addToEntityList(entity);
+		}
+	}
+
 	//! getEntity()
 	/*!
 	\param name a const std::string& - The name of the entity
@@ -194,34 +257,136 @@ namespace Engine
 		return nullptr;
 	}
 
+	//! getEntity()
+	/*!
+	\param handle a const EntityHandle - The handle of the entity
+	\return an Entity* - A pointer to the entity, nullptr if no root entity has the handle
+	*/
+	Entity* Scene::getEntity(const EntityHandle handle)
+	{
+		auto it = m_handles.find(handle);
+		if (it != m_handles.end())
+			return it->second;
+
+		return nullptr;
+	}
+
 	//! getEntities()
 	/*!
-	\return a std::vector<Entity*> - A list of all entities in the scene
+	\return a FrameVector<Entity*> - A list of all entities in the scene, a copy in frame memory so entities can be added while it is walked
 	*/
-	std::vector<Entity*> Scene::getEntities()
+	FrameVector<Entity*> Scene::getEntities()
 	{
-		// A list of all the entities in this scene
+		// The list is kept up to date as entities come and go, it is only rebuilt when asked to
 		if (m_entityListUpdated)
 		{
-			// The entities in this scene has been updated
-			// Clear the rendering entity list and refill it
 			m_entitiesList.clear();
 
 			for (auto& entity : m_rootEntities)
 			{
 				// Only add entity if its valid
 				if (entity.second)
-				{
-					std::vector<Entity*> entList;
-					entity.second->getAllEntities(entList);
-					m_entitiesList.push_back(entity.second);
-					m_entitiesList.insert(m_entitiesList.end(), entList.begin(), entList.end());
-				}
+					addToEntityList(entity.second);
 			}
 
 			m_entityListUpdated = false;
 		}
-		return m_entitiesList;
+
+		CounterSystem::setGauge(Gauge::SceneEntities, static_cast<int64_t>(m_entitiesList.size()));
+
+		// Every caller walks the whole list
+		CounterSystem::increment(Counter::EntitiesTraversed, m_entitiesList.size());
+		return FrameVector<Entity*>(m_entitiesList.begin(), m_entitiesList.end(), FrameAllocator::getArena());
+	}
+
+	//! addToEntityList()
+	/*!
+	\param entity an Entity* - The entity, its children are added too
+	*/
+	void Scene::addToEntityList(Entity* entity)
+	{
+		// Entities already in the list keep their place, along with their children
+		if (entity->m_listIndex < m_entitiesList.size() && m_entitiesList[entity->m_listIndex] == entity)
+			return;
+
+		entity->m_listIndex = static_cast<uint32_t>(m_entitiesList.size());
+		m_entitiesList.push_back(entity);
+
+		for (auto& child : entity->getChildEntities())
+		{
+			if (child.second)
+				addToEntityList(child.second);
+		}
+	}
+
+	//! removeFromEntityList()
+	/*!
+	\param entity an Entity* - The entity, its children are not removed
+	*/
+	void Scene::removeFromEntityList(Entity* entity)
+	{
+		const uint32_t index = entity->m_listIndex;
+		if (index >= m_entitiesList.size() || m_entitiesList[index] != entity)
+			return;
+
+		// Move the last entity into the gap
+		Entity* last = m_entitiesList.back();
+		m_entitiesList[index] = last;
+		last->m_listIndex = index;
+		m_entitiesList.pop_back();
+
+		entity->m_listIndex = UINT32_MAX;
+	}
+
+	//! queueDestroyedEntity()
+	/*!
+	\param entity an Entity* - The destroyed entity
+	*/
+	void Scene::queueDestroyedEntity(Entity* entity)
+	{
+		m_destroyQueue.push_back(entity);
+	}
+
+	//! deleteDestroyedEntities()
+	void Scene::deleteDestroyedEntities()
+	{
+		if (m_destroyQueue.empty()) return;
+
+		// An entity whose ancestor is also destroyed goes when the ancestor does
+		// This is checked before anything is deleted so every pointer is still valid
+		auto end = std::remove_if(m_destroyQueue.begin(), m_destroyQueue.end(), [](Entity* entity)
+		{
+			for (Entity* parent = entity->getParentEntity(); parent; parent = parent->getParentEntity())
+			{
+				if (parent->getDestroyed()) return true;
+			}
+			return false;
+		});
+		m_destroyQueue.erase(end, m_destroyQueue.end());
+
+		for (auto& entity : m_destroyQueue)
+		{
+			// Do NOT delete the entity which contains the main camera
+			if (m_mainCamera && entity == m_mainCamera->getParent())
+			{
+				ENGINE_ERROR("[Scene::deleteDestroyedEntities] Cannot delete the entity when it contains the scene's main camera. Scene: {0}, Entity: {1}.", m_sceneName, entity->getName());
+				entity->undestroy();
+				continue;
+			}
+
+			if (entity->getParentEntity())
+				entity->getParentEntity()->getChildEntities().erase(entity->getName());
+			else
+			{
+				m_rootEntities.erase(entity->getName());
+				m_handles.erase(entity->getHandle());
+			}
+
+			// The entity and its children take themselves out of the entity list
+			delete entity;
+		}
+
+		m_destroyQueue.clear();
 	}
 
 	//! getRootEntities()
@@ -235,22 +400,23 @@ namespace Engine
 
 	//! getClosestPointLights()
 	/*
-	\return a std::vector<PointLight*> - A list of point lights sorted by distance from main camera
+	\return a FrameVector<PointLight*> - A list of point lights sorted by distance from main camera
 	*/
-	std::vector<PointLight*> Scene::getClosestPointLights()
+	FrameVector<PointLight*> Scene::getClosestPointLights()
 	{
-		std::vector<PointLight*> pointLights;
+		FrameVector<PointLight*> pointLights = FrameAllocator::createVector<PointLight*>();
+		const glm::vec3 cameraPosition = getMainCamera()->getWorldPosition();
 
 		for (auto& entity : getEntities())
 		{
-			auto pointLight = entity->getComponent<PointLight>();
-			if (pointLight) pointLights.emplace_back(pointLight);
+			auto light = entity->getComponent<PointLight>();
+			if (light) pointLights.emplace_back(light);
 		}
 
 		std::sort(pointLights.begin(), pointLights.end(),
-			[=](PointLight*& a, PointLight*& b)
+			[&cameraPosition](PointLight* a, PointLight* b)
 		{
-			return glm::distance(a->getWorldPosition(), getMainCamera()->getWorldPosition()) < glm::distance(b->getWorldPosition(), getMainCamera()->getWorldPosition());
+			return glm::distance(a->getWorldPosition(), cameraPosition) < glm::distance(b->getWorldPosition(), cameraPosition);
 		}
 		);
 
@@ -259,22 +425,23 @@ namespace Engine
 
 	//! getClosestSpotLights()
 	/*
-	\return a std::vector<PointLight*> - A list of spot lights sorted by distance from main camera
+	\return a FrameVector<SpotLight*> - A list of spot lights sorted by distance from main camera
 	*/
-	std::vector<SpotLight*> Scene::getClosestSpotLights()
+	FrameVector<SpotLight*> Scene::getClosestSpotLights()
 	{
-		std::vector<SpotLight*> spotLights;
+		FrameVector<SpotLight*> spotLights = FrameAllocator::createVector<SpotLight*>();
+		const glm::vec3 cameraPosition = getMainCamera()->getWorldPosition();
 
 		for (auto& entity : getEntities())
 		{
-			auto spotLight = entity->getComponent<SpotLight>();
-			if (spotLight) spotLights.emplace_back(spotLight);
+			auto light = entity->getComponent<SpotLight>();
+			if (light) spotLights.emplace_back(light);
 		}
 
 		std::sort(spotLights.begin(), spotLights.end(),
-			[=](SpotLight*& a, SpotLight*& b)
+			[&cameraPosition](SpotLight* a, SpotLight* b)
 		{
-			return glm::distance(a->getWorldPosition(), getMainCamera()->getWorldPosition()) < glm::distance(b->getWorldPosition(), getMainCamera()->getWorldPosition());
+			return glm::distance(a->getWorldPosition(), cameraPosition) < glm::distance(b->getWorldPosition(), cameraPosition);
 		}
 		);
 
@@ -283,22 +450,23 @@ namespace Engine
 
 	//! getClosestDirectionalLights()
 	/*
-	\return a std::vector<PointLight*> - A list of directional lights sorted by distance from main camera
+	\return a FrameVector<DirectionalLight*> - A list of directional lights sorted by distance from main camera
 	*/
-	std::vector<DirectionalLight*> Scene::getClosestDirectionalLights()
+	FrameVector<DirectionalLight*> Scene::getClosestDirectionalLights()
 	{
-		std::vector<DirectionalLight*> dirLights;
+		FrameVector<DirectionalLight*> dirLights = FrameAllocator::createVector<DirectionalLight*>();
+		const glm::vec3 cameraPosition = getMainCamera()->getWorldPosition();
 
 		for (auto& entity : getEntities())
 		{
-			auto dirLight = entity->getComponent<DirectionalLight>();
-			if (dirLight) dirLights.emplace_back(dirLight);
+			auto light = entity->getComponent<DirectionalLight>();
+			if (light) dirLights.emplace_back(light);
 		}
 
 		std::sort(dirLights.begin(), dirLights.end(),
-			[=](DirectionalLight*& a, DirectionalLight*& b)
+			[&cameraPosition](DirectionalLight* a, DirectionalLight* b)
 		{
-			return glm::distance(a->getWorldPosition(), getMainCamera()->getWorldPosition()) < glm::distance(b->getWorldPosition(), getMainCamera()->getWorldPosition());
+			return glm::distance(a->getWorldPosition(), cameraPosition) < glm::distance(b->getWorldPosition(), cameraPosition);
 		}
 		);
 
@@ -357,6 +525,15 @@ namespace Engine
 		return m_layerManager;
 	}
 
+	//! getCollisionWorld()
+	/*!
+	\return a CollisionWorld* - A pointer to the collision world
+	*/
+	CollisionWorld* Scene::getCollisionWorld()
+	{
+		return m_collisionWorld;
+	}
+
 	//! addRenderPass()
 	/*!
 	\param pass a RenderPass* - The render pass to add
@@ -445,6 +622,7 @@ namespace Engine
 		ENGINE_TRACE("Scene Address: {0}", (void*)this);
 		ENGINE_TRACE("Scene Name: {0}", getName());
 		ENGINE_TRACE("Layer Manager Address: {0}", (void*)getLayerManager());
+		ENGINE_TRACE("Static Colliders: {0}", m_collisionWorld ? m_collisionWorld->getStaticCount() : 0);
 		ENGINE_TRACE("Number of Render Passes: {0}", getRenderPasses().size());
 		ENGINE_TRACE("Number of Root Entities: {0}", m_rootEntities.size());
 		ENGINE_TRACE("Main Camera Address: {0}", (void*)getMainCamera());
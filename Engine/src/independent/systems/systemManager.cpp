@@ -145,6 +145,21 @@ namespace Engine
 						s_activeSystems.push_back(new ThreadManager);
 						break;
 					}
+					case SystemType::InputManager:
+					{
+						s_activeSystems.push_back(new InputManager);
+						break;
+					}
+					case SystemType::Profiler:
+					{
+						s_activeSystems.push_back(new Profiler);
+						break;
+					}
+					case SystemType::CounterSystem:
+					{
+						s_activeSystems.push_back(new CounterSystem);
+						break;
+					}
 					default:
 						break;
 					}
@@ -0,0 +1,319 @@
+/*! \file counterSystem.cpp
+*
+* \brief A counter system which keeps per-frame engine counters and gauges
+*
+* \author Daniel Bullin
+*
+*/
+#include <json.hpp>
+#include "independent/systems/systems/counterSystem.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+#include "independent/utils/allocationTracker.h"
+
+namespace Engine
+{
+	bool CounterSystem::s_enabled = false; //!< Set to false
+	std::array<std::atomic<uint64_t>, Counter::Count> CounterSystem::s_counters; //!< Zero initialised before any allocation can happen
+	std::array<std::atomic<int64_t>, Gauge::Count> CounterSystem::s_gauges; //!< Zero initialised
+	std::array<FrameCounters, CounterSystem::HistorySize> CounterSystem::s_history; //!< Initialise empty history
+	uint32_t CounterSystem::s_historyCount = 0; //!< Set to 0
+	uint64_t CounterSystem::s_frameNumber = 0; //!< Set to 0
+	std::ofstream CounterSystem::s_dumpFile; //!< Not open
+	DumpFormat CounterSystem::s_dumpFormat = DumpFormat::CSV; //!< Set to CSV
+	uint64_t CounterSystem::s_dumpedFrames = 0; //!< Set to 0
+
+	//! CounterSystem()
+	CounterSystem::CounterSystem() : System(SystemType::CounterSystem)
+	{
+	}
+
+	//! ~CounterSystem()
+	CounterSystem::~CounterSystem()
+	{
+	}
+
+	//! start()
+	void CounterSystem::start()
+	{
+		// Start system if its disabled
+		if (!s_enabled)
+		{
+			ENGINE_INFO("[CounterSystem::start] Starting the counter system.");
+			s_historyCount = 0;
+			s_frameNumber = 0;
+			s_enabled = true;
+
+			// A dump path in the config lets a run record every frame without any input
+			nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+			if (configData.find("counterDump") != configData.end())
+			{
+				const std::string filePath = configData["counterDump"]["filePath"].get<std::string>();
+				const DumpFormat format = configData["counterDump"]["format"].get<std::string>() == "json" ? DumpFormat::JSON : DumpFormat::CSV;
+				if (filePath != "")
+					startDump(filePath, format);
+			}
+
+			// The allocation counters are filled in by the tracker, which has its own settings
+			AllocationTracker::configure();
+		}
+	}
+
+	//! stop()
+	void CounterSystem::stop()
+	{
+		// Stop system if its enabled
+		if (s_enabled)
+		{
+			ENGINE_INFO("[CounterSystem::stop] Stopping the counter system.");
+			if (isDumping()) stopDump();
+			s_enabled = false;
+		}
+	}
+
+	//! getHistory()
+	/*!
+	\param framesAgo a const uint32_t - How many frames before the last complete frame
+	\return a const FrameCounters& - The frame
+	*/
+	const FrameCounters& CounterSystem::getHistory(const uint32_t framesAgo)
+	{
+		return s_history[(s_frameNumber - 1 - framesAgo) % HistorySize];
+	}
+
+	//! onFrameEnd()
+	/*!
+	\param timestep a const float - The time the frame took in seconds
+	*/
+	void CounterSystem::onFrameEnd(const float timestep)
+	{
+		if (s_enabled)
+		{
+			setGauge(Gauge::FrameTimeMicroseconds, static_cast<int64_t>(timestep * 1000000.f));
+
+			// Move the counters into the history ring and reset them for the next frame
+			FrameCounters& frame = s_history[s_frameNumber % HistorySize];
+			frame.frame = s_frameNumber;
+			for (uint32_t i = 0; i < Counter::Count; i++)
+				frame.counters[i] = s_counters[i].exchange(0, std::memory_order_relaxed);
+			for (uint32_t i = 0; i < Gauge::Count; i++)
+				frame.gauges[i] = s_gauges[i].load(std::memory_order_relaxed);
+
+			s_frameNumber++;
+			if (s_historyCount < HistorySize) s_historyCount++;
+
+			if (isDumping()) writeDumpRow(frame);
+		}
+	}
+
+	//! getCounter()
+	/*!
+	\param counter a const Counter::Counter - The counter
+	\return a const uint64_t - The value of the counter so far this frame
+	*/
+	const uint64_t CounterSystem::getCounter(const Counter::Counter counter)
+	{
+		return s_counters[counter].load(std::memory_order_relaxed);
+	}
+
+	//! getGauge()
+	/*!
+	\param gauge a const Gauge::Gauge - The gauge
+	\return a const int64_t - The value of the gauge
+	*/
+	const int64_t CounterSystem::getGauge(const Gauge::Gauge gauge)
+	{
+		return s_gauges[gauge].load(std::memory_order_relaxed);
+	}
+
+	//! getLastFrame()
+	/*!
+	\param counter a const Counter::Counter - The counter
+	\return a const uint64_t - The value of the counter in the last complete frame
+	*/
+	const uint64_t CounterSystem::getLastFrame(const Counter::Counter counter)
+	{
+		if (s_historyCount == 0) return 0;
+		return getHistory(0).counters[counter];
+	}
+
+	//! getAverage()
+	/*!
+	\param counter a const Counter::Counter - The counter
+	\return a const float - The average value of the counter over the rolling window
+	*/
+	const float CounterSystem::getAverage(const Counter::Counter counter)
+	{
+		if (s_historyCount == 0) return 0.f;
+
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < s_historyCount; i++)
+			total += getHistory(i).counters[counter];
+
+		return static_cast<float>(total) / static_cast<float>(s_historyCount);
+	}
+
+	//! getMax()
+	/*!
+	\param counter a const Counter::Counter - The counter
+	\return a const uint64_t - The largest value of the counter over the rolling window
+	*/
+	const uint64_t CounterSystem::getMax(const Counter::Counter counter)
+	{
+		uint64_t max = 0;
+		for (uint32_t i = 0; i < s_historyCount; i++)
+			max = std::max(max, getHistory(i).counters[counter]);
+
+		return max;
+	}
+
+	//! getAverage()
+	/*!
+	\param gauge a const Gauge::Gauge - The gauge
+	\return a const float - The average value of the gauge over the rolling window
+	*/
+	const float CounterSystem::getAverage(const Gauge::Gauge gauge)
+	{
+		if (s_historyCount == 0) return 0.f;
+
+		int64_t total = 0;
+		for (uint32_t i = 0; i < s_historyCount; i++)
+			total += getHistory(i).gauges[gauge];
+
+		return static_cast<float>(total) / static_cast<float>(s_historyCount);
+	}
+
+	//! startDump()
+	/*!
+	\param filePath a const std::string& - The file to write to
+	\param format a const DumpFormat - The format of the file
+	*/
+	void CounterSystem::startDump(const std::string& filePath, const DumpFormat format)
+	{
+		if (s_enabled)
+		{
+			if (isDumping()) stopDump();
+
+			s_dumpFile.open(filePath);
+			if (!s_dumpFile.is_open())
+			{
+				ENGINE_ERROR("[CounterSystem::startDump] Cannot open file. Path: {0}.", filePath);
+				return;
+			}
+
+			ENGINE_INFO("[CounterSystem::startDump] Writing counters every frame to {0}.", filePath);
+			s_dumpFormat = format;
+			s_dumpedFrames = 0;
+
+			if (s_dumpFormat == DumpFormat::CSV)
+			{
+				// Header row
+				s_dumpFile << "frame";
+				for (uint32_t i = 0; i < Counter::Count; i++)
+					s_dumpFile << "," << toString(static_cast<Counter::Counter>(i));
+				for (uint32_t i = 0; i < Gauge::Count; i++)
+					s_dumpFile << "," << toString(static_cast<Gauge::Gauge>(i));
+				s_dumpFile << "\n";
+			}
+			else
+				s_dumpFile << "[\n";
+		}
+		else
+			ENGINE_ERROR("[CounterSystem::startDump] This system has not been enabled.");
+	}
+
+	//! stopDump()
+	void CounterSystem::stopDump()
+	{
+		if (isDumping())
+		{
+			if (s_dumpFormat == DumpFormat::JSON)
+				s_dumpFile << "\n]\n";
+
+			s_dumpFile.close();
+			ENGINE_INFO("[CounterSystem::stopDump] Stopped writing counters.");
+		}
+	}
+
+	//! isDumping()
+	/*!
+	\return a const bool - Are frames being written to file
+	*/
+	const bool CounterSystem::isDumping()
+	{
+		return s_dumpFile.is_open();
+	}
+
+	//! writeDumpRow()
+	/*!
+	\param frame a const FrameCounters& - The frame to write
+	*/
+	void CounterSystem::writeDumpRow(const FrameCounters& frame)
+	{
+		if (s_dumpFormat == DumpFormat::CSV)
+		{
+			s_dumpFile << frame.frame;
+			for (auto& value : frame.counters)
+				s_dumpFile << "," << value;
+			for (auto& value : frame.gauges)
+				s_dumpFile << "," << value;
+			s_dumpFile << "\n";
+		}
+		else
+		{
+			// One object per line so partial files are still easy to read
+			if (s_dumpedFrames > 0) s_dumpFile << ",\n";
+			s_dumpFile << "{\"frame\":" << frame.frame;
+			for (uint32_t i = 0; i < Counter::Count; i++)
+				s_dumpFile << ",\"" << toString(static_cast<Counter::Counter>(i)) << "\":" << frame.counters[i];
+			for (uint32_t i = 0; i < Gauge::Count; i++)
+				s_dumpFile << ",\"" << toString(static_cast<Gauge::Gauge>(i)) << "\":" << frame.gauges[i];
+			s_dumpFile << "}";
+		}
+
+		s_dumpedFrames++;
+	}
+
+	//! toString()
+	/*!
+	\param counter a const Counter::Counter - The counter
+	\return a const char* - The name of the counter
+	*/
+	const char* CounterSystem::toString(const Counter::Counter counter)
+	{
+		switch (counter)
+		{
+			case Counter::DrawCalls: return "DrawCalls";
+			case Counter::DrawCommands: return "DrawCommands";
+			case Counter::BatchFlushes3D: return "BatchFlushes3D";
+			case Counter::BatchFlushes2D: return "BatchFlushes2D";
+			case Counter::TextureBinds: return "TextureBinds";
+			case Counter::VertexBytesUploaded: return "VertexBytesUploaded";
+			case Counter::IndexBytesUploaded: return "IndexBytesUploaded";
+			case Counter::UniformBytesUploaded: return "UniformBytesUploaded";
+			case Counter::EntitiesTraversed: return "EntitiesTraversed";
+			case Counter::Allocations: return "Allocations";
+			case Counter::AllocatedBytes: return "AllocatedBytes";
+			case Counter::ResourcesLoaded: return "ResourcesLoaded";
+			case Counter::SubmissionsClipped: return "SubmissionsClipped";
+			case Counter::GlyphRunsBuilt: return "GlyphRunsBuilt";
+			default: return "Unknown";
+		}
+	}
+
+	//! toString()
+	/*!
+	\param gauge a const Gauge::Gauge - The gauge
+	\return a const char* - The name of the gauge
+	*/
+	const char* CounterSystem::toString(const Gauge::Gauge gauge)
+	{
+		switch (gauge)
+		{
+			case Gauge::SceneEntities: return "SceneEntities";
+			case Gauge::FrameTimeMicroseconds: return "FrameTimeMicroseconds";
+			case Gauge::FrameArenaBytes: return "FrameArenaBytes";
+			default: return "Unknown";
+		}
+	}
+}
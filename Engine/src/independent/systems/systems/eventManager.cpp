@@ -12,13 +12,21 @@
 #include "independent/systems/systems/timerSystem.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/threadManager.h"
+#include "independent/systems/systems/inputManager.h"
 #include "independent/entities/entity.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/utils/allocationTracker.h"
 
 namespace Engine
 {
 	bool EventManager::s_enabled = false; //!< Initialise with default value of false
 	EventData EventManager::s_eventData = EventData(); //!< Initialise with default constructor
 	Scene* EventManager::s_currentScene = nullptr; //!< Initialise with null pointer
+	std::array<std::vector<Layer*>, EventTypeCount> EventManager::s_layerListeners; //!< Initialise empty listener lists
+	std::array<std::vector<NativeScript*>, EventTypeCount> EventManager::s_scriptListeners; //!< Initialise empty listener lists
+	std::array<bool, EventTypeCount> EventManager::s_listenersDirty = {}; //!< Initialise as clean
+	uint32_t EventManager::s_dispatchDepth = 0; //!< Initialise with no dispatches in progress
+	std::vector<QueuedEvent> EventManager::s_eventQueue; //!< Initialise an empty queue
 
 	//! calculateMouseOffset()
 	/*!
@@ -74,10 +82,82 @@ namespace Engine
 		if (s_enabled)
 		{
 			ENGINE_INFO("[EventManager::stop] Stopping the event manager system.");
+			s_eventQueue.clear();
 			s_enabled = false;
 		}
 	}
 
+	template<typename T>
+	//! dispatch()
+	/*!
+	\param e a T& - Reference to the event
+	\param layerHandler a void(Layer::*)(T&, const float, const float) - The layer function which handles this event
+	\param scriptHandler a void(NativeScript::*)(T&, const float, const float) - The script function which handles this event
+	*/
+	void EventManager::dispatch(T& e, void(Layer::*layerHandler)(T&, const float, const float), void(NativeScript::*scriptHandler)(T&, const float, const float))
+	{
+		if (!s_currentScene)
+		{
+			ENGINE_ERROR("[EventManager::dispatch] Cannot get the active scene.");
+			return;
+		}
+
+		const uint32_t type = static_cast<uint32_t>(T::getStaticType());
+		const float timestep = TimerSystem::getStoredTime("FPS");
+		const float totalTime = TimerSystem::getStoredTime("TotalTime");
+
+		// Listeners may subscribe or unsubscribe while handling the event, so only walk the listeners present when the dispatch started
+		// and index into the list each time as it may grow
+		s_dispatchDepth++;
+
+		std::vector<Layer*>& layers = s_layerListeners[type];
+		const size_t layerCount = layers.size();
+		for (size_t i = 0; i < layerCount; i++)
+		{
+			Layer* layer = layers[i];
+			if (layer && layer->getActive() && layer->getLayerManager())
+			{
+				if (layer->getLayerManager()->getParentScene() == s_currentScene)
+					(layer->*layerHandler)(e, timestep, totalTime);
+			}
+		}
+
+		std::vector<NativeScript*>& scripts = s_scriptListeners[type];
+		const size_t scriptCount = scripts.size();
+		for (size_t i = 0; i < scriptCount; i++)
+		{
+			NativeScript* script = scripts[i];
+			if (script)
+			{
+				Entity* entity = script->getParent();
+				if (entity && entity->getParentScene() == s_currentScene && entity->getLayer()->getActive())
+					(script->*scriptHandler)(e, timestep, totalTime);
+			}
+		}
+
+		s_dispatchDepth--;
+
+		if (s_dispatchDepth == 0 && s_listenersDirty[type])
+			compactListeners(T::getStaticType());
+	}
+
+	//! compactListeners()
+	/*!
+	\param type a const EventType - The event type
+	*/
+	void EventManager::compactListeners(const EventType type)
+	{
+		const uint32_t index = static_cast<uint32_t>(type);
+
+		std::vector<Layer*>& layers = s_layerListeners[index];
+		layers.erase(std::remove(layers.begin(), layers.end(), nullptr), layers.end());
+
+		std::vector<NativeScript*>& scripts = s_scriptListeners[index];
+		scripts.erase(std::remove(scripts.begin(), scripts.end(), nullptr), scripts.end());
+
+		s_listenersDirty[index] = false;
+	}
+
 	//! onWindowClose()
 	/*!
 	\param window a Window* - A pointer to the window which triggered the event
@@ -108,38 +188,20 @@ namespace Engine
 			if (!window) return;
 
 			window->onWindowResize(e);
-			s_currentScene->getMainCamera()->updateProjection(window->getProperties().getSizef());
 
 			auto framebuffers = ResourceManager::getResourcesOfType<FrameBuffer>(ResourceType::FrameBuffer);
 			for (auto& fbo : framebuffers)
 			{
 				if (fbo->useSceneSize())
-					fbo->resize(e.getSize());
+					fbo->resize(fbo->getScaledSize(e.getSize()));
 			}
 
-			// Pass input event to layers and entities 
 			if (s_currentScene)
 			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onWindowResize(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
+				s_currentScene->getMainCamera()->updateProjection(window->getProperties().getSizef());
 
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onWindowResize(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
+				// Pass input event to subscribed layers and entities
+				dispatch(e, &Layer::onWindowResize, &NativeScript::onWindowResize);
 			}
 			else
 				ENGINE_ERROR("[EventManager::onWindowResize] Cannot get the active scene.");
@@ -163,28 +225,7 @@ namespace Engine
 			WindowManager::setFocusedWindowByName(window->getName().c_str());
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onWindowFocus(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onWindowFocus(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onWindowFocus, &NativeScript::onWindowFocus);
 		}
 	}
 
@@ -203,28 +244,7 @@ namespace Engine
 			window->onWindowLostFocus(e);
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onWindowLostFocus(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onWindowLostFocus(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onWindowLostFocus, &NativeScript::onWindowLostFocus);
 		}
 	}
 
@@ -243,28 +263,7 @@ namespace Engine
 			window->onWindowMoved(e);
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onWindowMoved(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onWindowMoved(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onWindowMoved, &NativeScript::onWindowMoved);
 		}
 	}
 
@@ -281,28 +280,7 @@ namespace Engine
 			if (!window) return;
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onKeyPress(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onKeyPress(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onKeyPress, &NativeScript::onKeyPress);
 		}
 	}
 
@@ -319,28 +297,7 @@ namespace Engine
 			if (!window) return;
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onKeyRelease(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onKeyRelease(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onKeyRelease, &NativeScript::onKeyRelease);
 		}
 	}
 
@@ -371,28 +328,7 @@ namespace Engine
 			if (!window) return;
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onMousePress(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onMousePress(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onMousePress, &NativeScript::onMousePress);
 		}
 	}
 
@@ -409,28 +345,7 @@ namespace Engine
 			if (!window) return;
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onMouseRelease(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onMouseRelease(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onMouseRelease, &NativeScript::onMouseRelease);
 		}
 	}
 
@@ -450,28 +365,7 @@ namespace Engine
 			if (window == WindowManager::getFocusedWindow()) calculateMouseOffset(e);
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onMouseMoved(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onMouseMoved(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onMouseMoved, &NativeScript::onMouseMoved);
 		}
 	}
 
@@ -488,28 +382,7 @@ namespace Engine
 			if (!window) return;
 
 			if (s_currentScene)
-			{
-				if (s_currentScene->getLayerManager())
-				{
-					for (auto& layer : s_currentScene->getLayerManager()->getLayers())
-					{
-						if (layer)
-						{
-							if (layer->getActive())
-								layer->onMouseScrolled(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-						}
-					}
-				}
-
-				for (auto& entity : s_currentScene->getEntities())
-				{
-					if (entity)
-					{
-						if (entity->getLayer()->getActive() && entity->containsComponent<NativeScript>())
-							entity->getComponent<NativeScript>()->onMouseScrolled(e, TimerSystem::getStoredTime("FPS"), TimerSystem::getStoredTime("TotalTime"));
-					}
-				}
-			}
+				dispatch(e, &Layer::onMouseScrolled, &NativeScript::onMouseScrolled);
 		}
 	}
 
@@ -521,6 +394,8 @@ namespace Engine
 	*/
 	void EventManager::onUpdate(Scene* scene, const float timestep, const float totalTime)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		if (s_enabled)
 		{
 			// Check if scene is valid
@@ -536,27 +411,15 @@ namespace Engine
 				return;
 			}
 
-			// Call entity preupdate
-			for (auto& entity : s_currentScene->getEntities())
 			{
-				if (entity)
-				{
-					if (entity->containsComponent<NativeScript>())
-						entity->getComponent<NativeScript>()->onPreUpdate(timestep, totalTime);
-				}
-			}
+				// Scripts and the events they listen to are charged to scripts
+				AllocationScope allocationScope(AllocationTag::Scripts);
 
-			// Use input poller to check for input and send event
-			for (auto key : InputPoller::isAnyKeyPressed())
-			{
-				KeyPressedEvent keyE(key, 1);
-				onKeyPressed(window, keyE);
-			}
+				// Call preupdate on the scripts which asked for it
+				TickScheduler::run(TickGroup::PreUpdate, s_currentScene, timestep, totalTime);
 
-			for (auto button : InputPoller::isAnyMouseButtonPressed())
-			{
-				MousePressedEvent mouseE(button);
-				onMousePressed(window, mouseE);
+				// Send all window events recorded since the last frame
+				dispatchQueuedEvents();
 			}
 
 			// Update Active scene
@@ -564,6 +427,9 @@ namespace Engine
 
 			ThreadManager::onUpdate(timestep, totalTime);
 
+			// Clear this frame's input edges before the windows poll for new input
+			InputManager::onUpdate();
+
 			// Update all registered windows
 			for (auto& window : WindowManager::getRegisteredWindows())
 			{
@@ -571,15 +437,221 @@ namespace Engine
 					window.second->onUpdate(timestep, totalTime);
 			}
 
-			// Call entity postupdate
-			for (auto& entity : s_currentScene->getEntities())
+			// Call postupdate on the scripts which asked for it
+			AllocationScope allocationScope(AllocationTag::Scripts);
+			TickScheduler::run(TickGroup::PostUpdate, s_currentScene, timestep, totalTime);
+		}
+	}
+
+	//! queueEvent()
+	/*!
+	\param window a Window* - A pointer to the window which triggered the event
+	\param type a const EventType - The type of event
+	\param data a const glm::vec2& - The event data
+	*/
+	void EventManager::queueEvent(Window* window, const EventType type, const glm::vec2& data)
+	{
+		if (s_enabled)
+		{
+			// Check window is valid
+			if (!window) return;
+
+			// Consecutive events which only report the latest state are merged into the last queued event
+			if (!s_eventQueue.empty() && (type == EventType::MouseMoved || type == EventType::WindowResize || type == EventType::WindowMoved))
 			{
-				if (entity)
+				QueuedEvent& last = s_eventQueue.back();
+				if (last.type == type && last.window == window)
 				{
-					if (entity->containsComponent<NativeScript>())
-						entity->getComponent<NativeScript>()->onPostUpdate(timestep, totalTime);
+					last.data = data;
+					return;
 				}
 			}
+
+			s_eventQueue.push_back({ type, window, data });
+		}
+	}
+
+	//! dispatchQueuedEvents()
+	void EventManager::dispatchQueuedEvents()
+	{
+		if (s_enabled)
+		{
+			// Handlers may cause new events to be queued, these will be sent next frame
+			std::vector<QueuedEvent> queue;
+			queue.swap(s_eventQueue);
+
+			for (auto& queued : queue)
+			{
+				switch (queued.type)
+				{
+				case EventType::WindowClose:
+				{
+					WindowCloseEvent e;
+					onWindowClose(queued.window, e);
+					break;
+				}
+				case EventType::WindowResize:
+				{
+					WindowResizeEvent e(static_cast<int32_t>(queued.data.x), static_cast<int32_t>(queued.data.y));
+					onWindowResize(queued.window, e);
+					break;
+				}
+				case EventType::WindowFocus:
+				{
+					WindowFocusEvent e;
+					onWindowFocus(queued.window, e);
+					break;
+				}
+				case EventType::WindowLostFocus:
+				{
+					WindowLostFocusEvent e;
+					onWindowLostFocus(queued.window, e);
+					break;
+				}
+				case EventType::WindowMoved:
+				{
+					WindowMovedEvent e(static_cast<int32_t>(queued.data.x), static_cast<int32_t>(queued.data.y));
+					onWindowMoved(queued.window, e);
+					break;
+				}
+				case EventType::KeyPressed:
+				{
+					KeyPressedEvent e(static_cast<int32_t>(queued.data.x), static_cast<int32_t>(queued.data.y));
+					onKeyPressed(queued.window, e);
+					break;
+				}
+				case EventType::KeyReleased:
+				{
+					KeyReleasedEvent e(static_cast<int32_t>(queued.data.x));
+					onKeyReleased(queued.window, e);
+					break;
+				}
+				case EventType::KeyTyped:
+				{
+					KeyTypedEvent e(static_cast<int32_t>(queued.data.x));
+					onKeyTyped(queued.window, e);
+					break;
+				}
+				case EventType::MousePressed:
+				{
+					MousePressedEvent e(static_cast<int32_t>(queued.data.x));
+					onMousePressed(queued.window, e);
+					break;
+				}
+				case EventType::MouseReleased:
+				{
+					MouseReleasedEvent e(static_cast<int32_t>(queued.data.x));
+					onMouseReleased(queued.window, e);
+					break;
+				}
+				case EventType::MouseMoved:
+				{
+					MouseMovedEvent e(queued.data.x, queued.data.y);
+					onMouseMoved(queued.window, e);
+					break;
+				}
+				case EventType::MouseScrolled:
+				{
+					MouseScrolledEvent e(queued.data.x, queued.data.y);
+					onMouseScrolled(queued.window, e);
+					break;
+				}
+				default:
+					break;
+				}
+			}
+
+			// Keep the allocation for next frame unless new events were queued during dispatch
+			if (s_eventQueue.empty())
+			{
+				queue.clear();
+				s_eventQueue.swap(queue);
+			}
+		}
+	}
+
+	//! discardQueuedEvents()
+	/*!
+	\param window a Window* - A pointer to the window
+	*/
+	void EventManager::discardQueuedEvents(Window* window)
+	{
+		s_eventQueue.erase(std::remove_if(s_eventQueue.begin(), s_eventQueue.end(), [window](const QueuedEvent& e) { return e.window == window; }), s_eventQueue.end());
+	}
+
+	//! subscribe()
+	/*!
+	\param type a const EventType - The event type
+	\param layer a Layer* - A pointer to the layer
+	*/
+	void EventManager::subscribe(const EventType type, Layer* layer)
+	{
+		if (!layer) return;
+
+		std::vector<Layer*>& layers = s_layerListeners[static_cast<uint32_t>(type)];
+		if (std::find(layers.begin(), layers.end(), layer) == layers.end())
+			layers.emplace_back(layer);
+	}
+
+	//! subscribe()
+	/*!
+	\param type a const EventType - The event type
+	\param script a NativeScript* - A pointer to the script
+	*/
+	void EventManager::subscribe(const EventType type, NativeScript* script)
+	{
+		if (!script) return;
+
+		std::vector<NativeScript*>& scripts = s_scriptListeners[static_cast<uint32_t>(type)];
+		if (std::find(scripts.begin(), scripts.end(), script) == scripts.end())
+			scripts.emplace_back(script);
+	}
+
+	//! unsubscribe()
+	/*!
+	\param type a const EventType - The event type
+	\param layer a Layer* - A pointer to the layer
+	*/
+	void EventManager::unsubscribe(const EventType type, Layer* layer)
+	{
+		const uint32_t index = static_cast<uint32_t>(type);
+		std::vector<Layer*>& layers = s_layerListeners[index];
+		auto it = std::find(layers.begin(), layers.end(), layer);
+
+		if (it != layers.end())
+		{
+			// Cannot erase while the list is being walked, so clear the slot and remove it once the dispatch has finished
+			if (s_dispatchDepth > 0)
+			{
+				*it = nullptr;
+				s_listenersDirty[index] = true;
+			}
+			else
+				layers.erase(it);
+		}
+	}
+
+	//! unsubscribe()
+	/*!
+	\param type a const EventType - The event type
+	\param script a NativeScript* - A pointer to the script
+	*/
+	void EventManager::unsubscribe(const EventType type, NativeScript* script)
+	{
+		const uint32_t index = static_cast<uint32_t>(type);
+		std::vector<NativeScript*>& scripts = s_scriptListeners[index];
+		auto it = std::find(scripts.begin(), scripts.end(), script);
+
+		if (it != scripts.end())
+		{
+			// Cannot erase while the list is being walked, so clear the slot and remove it once the dispatch has finished
+			if (s_dispatchDepth > 0)
+			{
+				*it = nullptr;
+				s_listenersDirty[index] = true;
+			}
+			else
+				scripts.erase(it);
 		}
 	}
 
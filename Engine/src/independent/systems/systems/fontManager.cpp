@@ -6,6 +6,7 @@
 *
 */
 #include "independent/systems/systems/fontManager.h"
+#include "independent/systems/components/fontCache.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/log.h"
 
@@ -16,6 +17,7 @@ namespace Engine
 	FT_Library FontManager::s_freetype; //!< The ft library
 	unsigned char FontManager::s_firstGlyph = 0; //!< The first char (ASCII)
 	unsigned char FontManager::s_lastGlyph = 0; //!< The last char (ASCII)
+	FontAtlasSettings FontManager::s_atlasSettings = FontAtlasSettings(); //!< Initialise with the default settings
 
 	//! FontManager
 	FontManager::FontManager() : System(SystemType::FontManager)
@@ -45,10 +47,41 @@ namespace Engine
 			
 			s_enabled = true;
 
-			// Load all fonts stored in config file
-			nlohmann::json configData = ResourceManager::getJSON("assets/config.json")["fonts"];
-			for (auto& font : configData)
-				FontManager::loadFont(font["name"].get<std::string>(), font["filePath"].get<std::string>(), font["characterSize"]);
+			nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+
+			// The atlas settings are optional, without them the glyphs are plain coverage bitmaps
+			if (configData.contains("fontAtlas"))
+			{
+				nlohmann::json& atlasData = configData["fontAtlas"];
+				if (atlasData.contains("sdf")) s_atlasSettings.SDF = atlasData["sdf"].get<uint32_t>() != 0;
+				if (atlasData.contains("sdfPixelSize")) s_atlasSettings.SDFPixelSize = atlasData["sdfPixelSize"].get<uint32_t>();
+				if (atlasData.contains("sdfSpread")) s_atlasSettings.SDFSpread = atlasData["sdfSpread"].get<uint32_t>();
+				if (atlasData.contains("maxSize")) s_atlasSettings.MaxSize = atlasData["maxSize"].get<uint32_t>();
+			}
+
+			// Every font stored in the config file is baked into one atlas, read from the cache when nothing has changed
+			std::vector<FontDescription> fonts;
+			for (auto& font : configData["fonts"])
+				fonts.push_back({ font["name"].get<std::string>(), font["filePath"].get<std::string>(), font["characterSize"].get<uint32_t>() });
+
+			if (fonts.empty()) return;
+
+			BakedFontAtlas atlas;
+			const uint64_t key = FontCache::getKey(fonts, s_atlasSettings, s_firstGlyph, s_lastGlyph);
+			if (FontCache::load(key, atlas))
+				ENGINE_TRACE("[FontManager::start] Loaded {0} fonts from the font cache.", atlas.Fonts.size());
+			else
+			{
+				if (!FontBaker::bake(s_freetype, fonts, s_atlasSettings, s_firstGlyph, s_lastGlyph, atlas))
+				{
+					ENGINE_ERROR("[FontManager::start] Cannot bake the font atlas.");
+					return;
+				}
+
+				FontCache::save(key, atlas);
+			}
+
+			createFonts(atlas, "FontAtlas");
 		}
 	}
 
@@ -88,14 +121,12 @@ namespace Engine
 			// Check if the font name is already taken
 			if (s_fontsList.find(fontName) == s_fontsList.end() && fontName != "" && fontFilePath != "")
 			{
-				// Font name is free, so load the font
-				Font* newFont = new Font(s_freetype, fontName.c_str(), fontFilePath.c_str(), pixelSize, s_firstGlyph, s_lastGlyph);
-
-				// If the font was not loaded correctly, it will be a valid pointer but no name
-				if (newFont->getName() == "")
-					delete newFont;
+				// Font name is free, so bake the font into its own atlas, fonts loaded at runtime are not cached
+				BakedFontAtlas atlas;
+				if (FontBaker::bake(s_freetype, { { fontName, fontFilePath, pixelSize } }, s_atlasSettings, s_firstGlyph, s_lastGlyph, atlas))
+					createFonts(atlas, "Font_" + fontName);
 				else
-					s_fontsList[fontName] = newFont;
+					ENGINE_ERROR("[FontManager::loadFont] Cannot bake the font. Name: {0}, Path: {1}.", fontName, fontFilePath);
 			}
 			else
 				ENGINE_ERROR("[FontManager::loadFont] Font name already exists or an invalid name was given, cannot load the new font. Name: {0}, Path: {1}.", fontName, fontFilePath);
@@ -104,6 +135,44 @@ namespace Engine
 			ENGINE_ERROR("[FontManager::loadFont] This system has not been enabled.");
 	}
 
+	//! createFonts()
+	/*!
+	\param atlas a const BakedFontAtlas& - The baked atlas
+	\param textureName a const std::string& - The name to register the atlas texture under
+	*/
+	void FontManager::createFonts(const BakedFontAtlas& atlas, const std::string& textureName)
+	{
+		if (atlas.Pixels.empty()) return;
+
+		// The resource manager owns the atlas texture, the fonts only own their glyph subtextures
+		TextureProperties properties(atlas.Width, atlas.Height, "Repeat", "Repeat", "Repeat", "Linear", "Linear", false, false);
+		Texture2D* texture = Texture2D::create(textureName, properties, 4, const_cast<unsigned char*>(atlas.Pixels.data()));
+		if (!texture)
+		{
+			ENGINE_ERROR("[FontManager::createFonts] Cannot create the font atlas texture: {0}.", textureName);
+			return;
+		}
+
+		ResourceManager::registerResource(textureName, texture);
+
+		for (auto& bakedFont : atlas.Fonts)
+		{
+			if (s_fontsList.find(bakedFont.Name) != s_fontsList.end())
+			{
+				ENGINE_ERROR("[FontManager::createFonts] Font name already exists, cannot load the new font. Name: {0}.", bakedFont.Name);
+				continue;
+			}
+
+			Font* newFont = new Font(bakedFont, texture, s_firstGlyph, s_lastGlyph);
+
+			// If the font was not loaded correctly, it will be a valid pointer but no name
+			if (newFont->getName() == "")
+				delete newFont;
+			else
+				s_fontsList[bakedFont.Name] = newFont;
+		}
+	}
+
 	//! destroyFont()
 	/*!
 	\param fontName a const std::string& - The name of the font
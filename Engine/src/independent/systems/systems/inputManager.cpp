@@ -0,0 +1,316 @@
+/*! \file inputManager.cpp
+*
+* \brief An input manager system which tracks key and mouse button state from window callbacks
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/systems/systems/inputManager.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	bool InputManager::s_enabled = false; //!< Set to false
+	std::bitset<KeyCount> InputManager::s_keysDown; //!< Initialise with all keys up
+	std::bitset<KeyCount> InputManager::s_keysPressed; //!< Initialise with no edges
+	std::bitset<KeyCount> InputManager::s_keysReleased; //!< Initialise with no edges
+	std::bitset<MouseButtonCount> InputManager::s_buttonsDown; //!< Initialise with all buttons up
+	std::bitset<MouseButtonCount> InputManager::s_buttonsPressed; //!< Initialise with no edges
+	std::bitset<MouseButtonCount> InputManager::s_buttonsReleased; //!< Initialise with no edges
+	std::vector<int32_t> InputManager::s_changedKeys; //!< Initialise empty list
+	std::vector<int32_t> InputManager::s_heldKeys; //!< Initialise empty list
+	std::vector<ActionBinding> InputManager::s_actions; //!< Initialise empty list
+
+	//! validKey()
+	/*!
+	\param keyCode a const int32_t - The key code
+	\return a const bool - Is the key code in range
+	*/
+	const bool InputManager::validKey(const int32_t keyCode)
+	{
+		return keyCode >= 0 && keyCode < static_cast<int32_t>(KeyCount);
+	}
+
+	//! validButton()
+	/*!
+	\param button a const int32_t - The mouse button
+	\return a const bool - Is the mouse button in range
+	*/
+	const bool InputManager::validButton(const int32_t button)
+	{
+		return button >= 0 && button < static_cast<int32_t>(MouseButtonCount);
+	}
+
+	//! InputManager()
+	InputManager::InputManager() : System(SystemType::InputManager)
+	{
+	}
+
+	//! ~InputManager()
+	InputManager::~InputManager()
+	{
+	}
+
+	//! start()
+	void InputManager::start()
+	{
+		// Start system if its disabled
+		if (!s_enabled)
+		{
+			ENGINE_INFO("[InputManager::start] Starting the input manager.");
+			s_changedKeys.reserve(16);
+			s_heldKeys.reserve(16);
+			clear();
+			s_enabled = true;
+		}
+	}
+
+	//! stop()
+	void InputManager::stop()
+	{
+		// Stop system if its enabled
+		if (s_enabled)
+		{
+			ENGINE_INFO("[InputManager::stop] Stopping the input manager.");
+			clear();
+			s_actions.clear();
+			s_enabled = false;
+		}
+	}
+
+	//! onUpdate()
+	void InputManager::onUpdate()
+	{
+		if (s_enabled)
+		{
+			// Only the keys which changed state can have an edge set
+			for (auto key : s_changedKeys)
+			{
+				s_keysPressed.reset(key);
+				s_keysReleased.reset(key);
+			}
+			s_changedKeys.clear();
+
+			s_buttonsPressed.reset();
+			s_buttonsReleased.reset();
+		}
+	}
+
+	//! clear()
+	void InputManager::clear()
+	{
+		s_keysDown.reset();
+		s_keysPressed.reset();
+		s_keysReleased.reset();
+		s_buttonsDown.reset();
+		s_buttonsPressed.reset();
+		s_buttonsReleased.reset();
+		s_changedKeys.clear();
+		s_heldKeys.clear();
+	}
+
+	//! setKeyState()
+	/*!
+	\param keyCode a const int32_t - The key code
+	\param down a const bool - Is the key now held down
+	*/
+	void InputManager::setKeyState(const int32_t keyCode, const bool down)
+	{
+		if (s_enabled)
+		{
+			// Ignore unknown keys and repeated states
+			if (!validKey(keyCode) || s_keysDown.test(keyCode) == down) return;
+
+			if (!s_keysPressed.test(keyCode) && !s_keysReleased.test(keyCode))
+				s_changedKeys.push_back(keyCode);
+
+			s_keysDown.set(keyCode, down);
+
+			if (down)
+			{
+				s_keysPressed.set(keyCode);
+				s_heldKeys.push_back(keyCode);
+			}
+			else
+			{
+				s_keysReleased.set(keyCode);
+
+				// Swap the key with the last held key and remove it
+				auto it = std::find(s_heldKeys.begin(), s_heldKeys.end(), keyCode);
+				if (it != s_heldKeys.end())
+				{
+					*it = s_heldKeys.back();
+					s_heldKeys.pop_back();
+				}
+			}
+		}
+	}
+
+	//! setMouseButtonState()
+	/*!
+	\param button a const int32_t - The mouse button
+	\param down a const bool - Is the mouse button now held down
+	*/
+	void InputManager::setMouseButtonState(const int32_t button, const bool down)
+	{
+		if (s_enabled)
+		{
+			// Ignore unknown buttons and repeated states
+			if (!validButton(button) || s_buttonsDown.test(button) == down) return;
+
+			s_buttonsDown.set(button, down);
+
+			if (down)
+				s_buttonsPressed.set(button);
+			else
+				s_buttonsReleased.set(button);
+		}
+	}
+
+	//! isKeyDown()
+	/*!
+	\param keyCode a const int32_t - The key code
+	\return a const bool - Is the key held down
+	*/
+	const bool InputManager::isKeyDown(const int32_t keyCode)
+	{
+		return validKey(keyCode) && s_keysDown.test(keyCode);
+	}
+
+	//! wasKeyPressed()
+	/*!
+	\param keyCode a const int32_t - The key code
+	\return a const bool - Did the key go down this frame
+	*/
+	const bool InputManager::wasKeyPressed(const int32_t keyCode)
+	{
+		return validKey(keyCode) && s_keysPressed.test(keyCode);
+	}
+
+	//! wasKeyReleased()
+	/*!
+	\param keyCode a const int32_t - The key code
+	\return a const bool - Did the key go up this frame
+	*/
+	const bool InputManager::wasKeyReleased(const int32_t keyCode)
+	{
+		return validKey(keyCode) && s_keysReleased.test(keyCode);
+	}
+
+	//! isMouseButtonDown()
+	/*!
+	\param button a const int32_t - The mouse button
+	\return a const bool - Is the mouse button held down
+	*/
+	const bool InputManager::isMouseButtonDown(const int32_t button)
+	{
+		return validButton(button) && s_buttonsDown.test(button);
+	}
+
+	//! wasMouseButtonPressed()
+	/*!
+	\param button a const int32_t - The mouse button
+	\return a const bool - Did the mouse button go down this frame
+	*/
+	const bool InputManager::wasMouseButtonPressed(const int32_t button)
+	{
+		return validButton(button) && s_buttonsPressed.test(button);
+	}
+
+	//! wasMouseButtonReleased()
+	/*!
+	\param button a const int32_t - The mouse button
+	\return a const bool - Did the mouse button go up this frame
+	*/
+	const bool InputManager::wasMouseButtonReleased(const int32_t button)
+	{
+		return validButton(button) && s_buttonsReleased.test(button);
+	}
+
+	//! getHeldKeys()
+	/*!
+	\return a const std::vector<int32_t>& - All the keys currently held down
+	*/
+	const std::vector<int32_t>& InputManager::getHeldKeys()
+	{
+		return s_heldKeys;
+	}
+
+	//! bindAction()
+	/*!
+	\param action a const uint32_t - The action
+	\param key1 a const int32_t - The first key to bind
+	\param key2 a const int32_t - The second key to bind, -1 for none
+	*/
+	void InputManager::bindAction(const uint32_t action, const int32_t key1, const int32_t key2)
+	{
+		if (action >= s_actions.size())
+			s_actions.resize(action + 1);
+
+		s_actions[action].key1 = key1;
+		s_actions[action].key2 = key2;
+	}
+
+	//! unbindAction()
+	/*!
+	\param action a const uint32_t - The action
+	*/
+	void InputManager::unbindAction(const uint32_t action)
+	{
+		if (action < s_actions.size())
+			s_actions[action] = ActionBinding();
+	}
+
+	//! getActionBinding()
+	/*!
+	\param action a const uint32_t - The action
+	\return a const ActionBinding - The keys bound to the action
+	*/
+	const ActionBinding InputManager::getActionBinding(const uint32_t action)
+	{
+		if (action < s_actions.size())
+			return s_actions[action];
+		return ActionBinding();
+	}
+
+	//! isActionDown()
+	/*!
+	\param action a const uint32_t - The action
+	\return a const bool - Is either key bound to the action held down
+	*/
+	const bool InputManager::isActionDown(const uint32_t action)
+	{
+		if (action >= s_actions.size()) return false;
+
+		const ActionBinding& binding = s_actions[action];
+		return isKeyDown(binding.key1) || isKeyDown(binding.key2);
+	}
+
+	//! wasActionPressed()
+	/*!
+	\param action a const uint32_t - The action
+	\return a const bool - Did a bound key go down this frame while the other bound key was not already held
+	*/
+	const bool InputManager::wasActionPressed(const uint32_t action)
+	{
+		if (action >= s_actions.size()) return false;
+
+		const ActionBinding& binding = s_actions[action];
+		const bool held1 = isKeyDown(binding.key1) && !wasKeyPressed(binding.key1);
+		const bool held2 = isKeyDown(binding.key2) && !wasKeyPressed(binding.key2);
+		return (wasKeyPressed(binding.key1) || wasKeyPressed(binding.key2)) && !held1 && !held2;
+	}
+
+	//! wasActionReleased()
+	/*!
+	\param action a const uint32_t - The action
+	\return a const bool - Did a bound key go up this frame leaving no bound key held
+	*/
+	const bool InputManager::wasActionReleased(const uint32_t action)
+	{
+		if (action >= s_actions.size()) return false;
+
+		const ActionBinding& binding = s_actions[action];
+		return (wasKeyReleased(binding.key1) || wasKeyReleased(binding.key2)) && !isActionDown(action);
+	}
+}
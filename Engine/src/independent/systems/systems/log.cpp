@@ -5,13 +5,91 @@
 * \author DMU Course material
 *
 */
+#include <chrono>
 #include "independent/systems/systems/log.h"
 
 namespace Engine
 {
+	namespace
+	{
+		const uint32_t QueueCapacity = 1024; //!< The number of messages the queue can hold, must be a power of two
+		const uint32_t MaxMessageLength = 512; //!< The longest message kept, longer messages are cut
+
+		/*! \struct QueuedMessage
+		* \brief A message waiting to be printed
+		*/
+		struct QueuedMessage
+		{
+			std::atomic<size_t> sequence; //!< The position this slot is ready for
+			spdlog::level::level_enum level; //!< The level of the message
+			uint32_t length; //!< The length of the text
+			char text[MaxMessageLength]; //!< The text
+		};
+
+		std::array<QueuedMessage, QueueCapacity> s_queue; //!< A bounded lock-free queue, any thread pushes and only the flusher pops
+		std::atomic<size_t> s_enqueuePosition(0); //!< The next position to push to
+		size_t s_dequeuePosition = 0; //!< The next position to pop from, only used by the flusher
+		std::atomic<uint32_t> s_dropped(0); //!< The number of messages dropped because the queue was full
+	}
+
 	bool Log::s_enabled = false; //!< Set to false
 	std::shared_ptr<spdlog::logger> Log::s_consoleLogger = nullptr; //!< Initialise the console logger
 	std::shared_ptr<spdlog::logger> Log::s_fileLogger = nullptr; //!< Initialise the file logger
+	std::thread Log::s_flusher; //!< Not started
+	std::atomic<bool> Log::s_flusherRunning(false); //!< Set to false
+
+	//! LogSite()
+	LogSite::LogSite() : m_windowStart(0), m_windowCount(0), m_suppressed(0), m_lastHash(0)
+	{
+	}
+
+	//! allow()
+	/*!
+	\param now a const uint64_t - The current time in milliseconds
+	\return a const bool - Is the call site under its limit for this window
+	*/
+	const bool LogSite::allow(const uint64_t now)
+	{
+		// Start a new window once the current one has passed, only one thread wins the swap
+		uint64_t start = m_windowStart.load(std::memory_order_relaxed);
+		if (now - start >= Window && m_windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+		{
+			m_windowCount.store(0, std::memory_order_relaxed);
+
+			// Let a repeated message through once per window so its count is reported
+			m_lastHash.store(0, std::memory_order_relaxed);
+		}
+
+		if (m_windowCount.fetch_add(1, std::memory_order_relaxed) < Burst)
+			return true;
+
+		m_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	//! isRepeat()
+	/*!
+	\param hash a const size_t - The hash of the formatted message
+	\return a const bool - Is the message the same as the last one printed in this window
+	*/
+	const bool LogSite::isRepeat(const size_t hash)
+	{
+		if (m_lastHash.exchange(hash, std::memory_order_relaxed) == hash)
+		{
+			m_suppressed.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	//! takeSuppressed()
+	/*!
+	\return a const uint32_t - The number of messages suppressed since the last printed message
+	*/
+	const uint32_t LogSite::takeSuppressed()
+	{
+		return m_suppressed.exchange(0, std::memory_order_relaxed);
+	}
 
 	//! Log()
 	Log::Log() : System(SystemType::Logger)
@@ -32,6 +110,24 @@ namespace Engine
 			spdlog::set_pattern("%^[%T]: %v%$");
 			spdlog::set_level(spdlog::level::trace);
 			s_consoleLogger = spdlog::stderr_color_mt("Console");
+
+			for (uint32_t i = 0; i < QueueCapacity; i++)
+				s_queue[i].sequence.store(i, std::memory_order_relaxed);
+			s_enqueuePosition.store(0, std::memory_order_relaxed);
+			s_dequeuePosition = 0;
+
+			// Console output happens on its own thread so a slow terminal never stalls a frame
+			s_flusherRunning.store(true);
+			s_flusher = std::thread([]()
+			{
+				while (s_flusherRunning.load())
+				{
+					flush();
+					std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				}
+				flush();
+			});
+
 			s_enabled = true;
 			ENGINE_INFO("[Log::start] Starting the logger system.");
 		}
@@ -45,6 +141,11 @@ namespace Engine
 		{
 			// Print stopping message and reset pointer
 			ENGINE_INFO("[Log::stop] Stopping the logger system.");
+			s_enabled = false;
+
+			// The flusher prints everything left in the queue before it exits
+			s_flusherRunning.store(false);
+			if (s_flusher.joinable()) s_flusher.join();
 
 			// Remove loggers from spdlog registry
 			spdlog::drop_all();
@@ -52,10 +153,89 @@ namespace Engine
 			s_consoleLogger = nullptr;
 			s_fileLogger.reset();
 			s_fileLogger = nullptr;
-			s_enabled = false;
 		}
 	}
 
+	//! submit()
+	/*!
+	\param level a const spdlog::level::level_enum - The level of the message
+	\param text a const char* - The formatted text
+	\param length a const size_t - The length of the text
+	\param suppressed a const uint32_t - The number of messages from the same call site which were not printed
+	*/
+	void Log::submit(const spdlog::level::level_enum level, const char* text, const size_t length, const uint32_t suppressed)
+	{
+		// Claim a slot, if the queue is full the message is dropped rather than waiting
+		size_t position = s_enqueuePosition.load(std::memory_order_relaxed);
+		QueuedMessage* message = nullptr;
+		while (!message)
+		{
+			QueuedMessage& slot = s_queue[position & (QueueCapacity - 1)];
+			const intptr_t difference = static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(position);
+
+			if (difference == 0)
+			{
+				if (s_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					message = &slot;
+			}
+			else if (difference < 0)
+			{
+				s_dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			else
+				position = s_enqueuePosition.load(std::memory_order_relaxed);
+		}
+
+		message->level = level;
+		message->length = static_cast<uint32_t>(std::min<size_t>(length, MaxMessageLength));
+		memcpy(message->text, text, message->length);
+
+		// Report how many messages from this call site were held back
+		if (suppressed > 0)
+		{
+			char suffix[64];
+			const int suffixLength = snprintf(suffix, sizeof(suffix), " (%u similar messages suppressed)", suppressed);
+			const uint32_t copyLength = std::min<uint32_t>(static_cast<uint32_t>(suffixLength), MaxMessageLength - message->length);
+			memcpy(message->text + message->length, suffix, copyLength);
+			message->length += copyLength;
+		}
+
+		message->sequence.store(position + 1, std::memory_order_release);
+	}
+
+	//! flush()
+	void Log::flush()
+	{
+		if (!s_consoleLogger) return;
+
+		// Print every message which has finished being written
+		while (true)
+		{
+			QueuedMessage& slot = s_queue[s_dequeuePosition & (QueueCapacity - 1)];
+			if (slot.sequence.load(std::memory_order_acquire) != s_dequeuePosition + 1)
+				break;
+
+			s_consoleLogger->log(slot.level, fmt::StringRef(slot.text, slot.length));
+
+			slot.sequence.store(s_dequeuePosition + QueueCapacity, std::memory_order_release);
+			s_dequeuePosition++;
+		}
+
+		const uint32_t dropped = s_dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped > 0)
+			s_consoleLogger->warn("[Log::flush] The log queue was full, {0} messages were dropped.", dropped);
+	}
+
+	//! getMilliseconds()
+	/*!
+	\return a const uint64_t - The current time in milliseconds
+	*/
+	const uint64_t Log::getMilliseconds()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
 	//! enableFileLogging()
 	/*!
 	\param enable a const bool - Enable/Disable the file logging
@@ -86,7 +266,7 @@ namespace Engine
 				catch (const spdlog::spdlog_ex& e)
 				{
 					// An error occurred, print error message
-					Log::error("[Log::enableFileLogging] Could not start file logger. Reason: {0}", e.what());
+					ENGINE_ERROR("[Log::enableFileLogging] Could not start file logger. Reason: {0}", e.what());
 					s_fileLogger.reset();
 				}
 			}
@@ -98,4 +278,4 @@ namespace Engine
 			}
 		}
 	}
-}
\ No newline at end of file
+}
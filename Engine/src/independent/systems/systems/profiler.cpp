@@ -0,0 +1,326 @@
+/*! \file profiler.cpp
+*
+* \brief A profiler system which records nested timing zones from any thread and exports them as a Chrome trace
+*
+* \author Daniel Bullin
+*
+*/
+#include <json.hpp>
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	bool Profiler::s_enabled = false; //!< Set to false
+	std::atomic<bool> Profiler::s_capturing(false); //!< Set to false
+	std::chrono::steady_clock::time_point Profiler::s_epoch; //!< Set when the system starts
+	std::mutex Profiler::s_bufferMutex; //!< Guards the buffer list
+	std::vector<ProfileBuffer*> Profiler::s_buffers; //!< Initialise empty list
+	std::vector<std::pair<uint32_t, ProfileEvent>> Profiler::s_capturedEvents; //!< Initialise empty list
+	std::vector<std::pair<uint64_t, uint64_t>> Profiler::s_frameMarkers; //!< Initialise empty list
+	uint64_t Profiler::s_frameNumber = 0; //!< Set to 0
+	uint32_t Profiler::s_framesRemaining = 0; //!< Set to 0
+	uint32_t Profiler::s_droppedEvents = 0; //!< Set to 0
+	std::string Profiler::s_capturePath = ""; //!< Set to empty
+
+	//! ProfileBuffer()
+	/*!
+	\param threadID a const uint32_t - The id of the owning thread in the trace
+	*/
+	ProfileBuffer::ProfileBuffer(const uint32_t threadID) : m_head(0), m_tail(0), m_dropped(0), m_threadID(threadID), m_threadName("Thread " + std::to_string(threadID)), m_depth(0)
+	{
+	}
+
+	//! push()
+	/*!
+	\param event a const ProfileEvent& - The completed zone
+	*/
+	void ProfileBuffer::push(const ProfileEvent& event)
+	{
+		const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+		// The ring is full until the consumer catches up, drop rather than block
+		if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		m_events[head & (Capacity - 1)] = event;
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	//! drain()
+	/*!
+	\param events a std::vector<std::pair<uint32_t, ProfileEvent>>& - The list to move the events into
+	*/
+	void ProfileBuffer::drain(std::vector<std::pair<uint32_t, ProfileEvent>>& events)
+	{
+		const uint32_t head = m_head.load(std::memory_order_acquire);
+		uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+		for (; tail != head; ++tail)
+			events.emplace_back(m_threadID, m_events[tail & (Capacity - 1)]);
+
+		m_tail.store(tail, std::memory_order_release);
+	}
+
+	//! takeDropped()
+	/*!
+	\return a const uint32_t - The number of events dropped since the last call
+	*/
+	const uint32_t ProfileBuffer::takeDropped()
+	{
+		return m_dropped.exchange(0, std::memory_order_relaxed);
+	}
+
+	//! ProfileZone()
+	/*!
+	\param name a const char* - The name of the zone, must outlive the capture
+	*/
+	ProfileZone::ProfileZone(const char* name) : m_name(name), m_start(0), m_buffer(nullptr)
+	{
+		if (Profiler::isCapturing())
+		{
+			m_buffer = Profiler::getThreadBuffer();
+			m_buffer->m_depth++;
+			m_start = Profiler::getTime();
+		}
+	}
+
+	//! ~ProfileZone()
+	ProfileZone::~ProfileZone()
+	{
+		if (m_buffer)
+		{
+			const uint64_t end = Profiler::getTime();
+			m_buffer->m_depth--;
+			m_buffer->push({ m_name, m_start, end, m_buffer->m_depth });
+		}
+	}
+
+	//! Profiler()
+	Profiler::Profiler() : System(SystemType::Profiler)
+	{
+	}
+
+	//! ~Profiler()
+	Profiler::~Profiler()
+	{
+	}
+
+	//! start()
+	void Profiler::start()
+	{
+		// Start system if its disabled
+		if (!s_enabled)
+		{
+			ENGINE_INFO("[Profiler::start] Starting the profiler.");
+			s_epoch = std::chrono::steady_clock::now();
+			s_enabled = true;
+
+			// The system is started on the main thread, make sure it gets the first id
+			setThreadName("Main");
+		}
+	}
+
+	//! stop()
+	void Profiler::stop()
+	{
+		// Stop system if its enabled
+		if (s_enabled)
+		{
+			ENGINE_INFO("[Profiler::stop] Stopping the profiler.");
+
+			// Write out any capture which is still running
+			if (isCapturing())
+				endCapture();
+
+			// The buffers are kept for the life of the process, every thread caches its own in a thread_local and may
+			// still have a zone open, so they are emptied rather than deleted
+			collect();
+			s_droppedEvents = 0;
+
+			s_capturedEvents.clear();
+			s_capturedEvents.shrink_to_fit();
+			s_frameMarkers.clear();
+			s_enabled = false;
+		}
+	}
+
+	//! beginCapture()
+	/*!
+	\param frameCount a const uint32_t - The number of frames to capture, 0 to capture until endCapture is called
+	\param filePath a const std::string& - The file to write the capture to
+	*/
+	void Profiler::beginCapture(const uint32_t frameCount, const std::string& filePath)
+	{
+		if (s_enabled)
+		{
+			if (isCapturing())
+			{
+				ENGINE_ERROR("[Profiler::beginCapture] A capture is already running. Path: {0}.", s_capturePath);
+				return;
+			}
+
+			ENGINE_INFO("[Profiler::beginCapture] Capturing {0} frames to {1}.", frameCount, filePath);
+
+			// Throw away anything left from zones which were still open when the last capture ended
+			collect();
+			s_capturedEvents.clear();
+			s_frameMarkers.clear();
+			s_droppedEvents = 0;
+
+			s_framesRemaining = frameCount;
+			s_capturePath = filePath;
+			s_capturing.store(true, std::memory_order_relaxed);
+		}
+		else
+			ENGINE_ERROR("[Profiler::beginCapture] This system has not been enabled.");
+	}
+
+	//! endCapture()
+	void Profiler::endCapture()
+	{
+		if (s_enabled)
+		{
+			if (!isCapturing())
+			{
+				ENGINE_ERROR("[Profiler::endCapture] There is no capture running.");
+				return;
+			}
+
+			s_capturing.store(false, std::memory_order_relaxed);
+			collect();
+
+			if (s_droppedEvents > 0)
+				ENGINE_WARN("[Profiler::endCapture] {0} events were dropped because a thread buffer was full.", s_droppedEvents);
+
+			exportChromeTrace(s_capturePath);
+
+			s_capturedEvents.clear();
+			s_capturedEvents.shrink_to_fit();
+			s_frameMarkers.clear();
+		}
+		else
+			ENGINE_ERROR("[Profiler::endCapture] This system has not been enabled.");
+	}
+
+	//! onFrameEnd()
+	void Profiler::onFrameEnd()
+	{
+		if (s_enabled)
+		{
+			s_frameNumber++;
+
+			if (isCapturing())
+			{
+				s_frameMarkers.emplace_back(getTime(), s_frameNumber);
+
+				// Empty the thread buffers every frame so they never fill during a long capture
+				collect();
+
+				if (s_framesRemaining > 0 && --s_framesRemaining == 0)
+					endCapture();
+			}
+		}
+	}
+
+	//! setThreadName()
+	/*!
+	\param threadName a const std::string& - The name of the calling thread
+	*/
+	void Profiler::setThreadName(const std::string& threadName)
+	{
+		if (s_enabled)
+		{
+			ProfileBuffer* buffer = getThreadBuffer();
+
+			std::lock_guard<std::mutex> lock(s_bufferMutex);
+			buffer->m_threadName = threadName;
+		}
+	}
+
+	//! getThreadBuffer()
+	/*!
+	\return a ProfileBuffer* - The calling thread's buffer
+	*/
+	ProfileBuffer* Profiler::getThreadBuffer()
+	{
+		thread_local ProfileBuffer* buffer = nullptr;
+
+		// Only the first zone on each thread takes the lock, the buffer is never deleted so the cached pointer stays valid
+		// across a stop and start of the profiler
+		if (!buffer)
+		{
+			std::lock_guard<std::mutex> lock(s_bufferMutex);
+			buffer = new ProfileBuffer(static_cast<uint32_t>(s_buffers.size()));
+			s_buffers.push_back(buffer);
+		}
+
+		return buffer;
+	}
+
+	//! getTime()
+	/*!
+	\return a const uint64_t - The time in nanoseconds since the profiler started
+	*/
+	const uint64_t Profiler::getTime()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+	}
+
+	//! collect()
+	void Profiler::collect()
+	{
+		std::lock_guard<std::mutex> lock(s_bufferMutex);
+		for (auto& buffer : s_buffers)
+		{
+			buffer->drain(s_capturedEvents);
+			s_droppedEvents += buffer->takeDropped();
+		}
+	}
+
+	//! exportChromeTrace()
+	/*!
+	\param filePath a const std::string& - The file to write to
+	*/
+	void Profiler::exportChromeTrace(const std::string& filePath)
+	{
+		std::ofstream file(filePath);
+		if (!file.is_open())
+		{
+			ENGINE_ERROR("[Profiler::exportChromeTrace] Cannot open file. Path: {0}.", filePath);
+			return;
+		}
+
+		// Chrome and Perfetto want times in microseconds
+		nlohmann::json trace;
+		nlohmann::json& events = trace["traceEvents"];
+		events = nlohmann::json::array();
+
+		{
+			std::lock_guard<std::mutex> lock(s_bufferMutex);
+			for (auto& buffer : s_buffers)
+				events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", buffer->m_threadID }, { "args", { { "name", buffer->m_threadName } } } });
+		}
+
+		for (auto& event : s_capturedEvents)
+		{
+			events.push_back({ { "name", event.second.name }, { "cat", "engine" }, { "ph", "X" }, { "pid", 0 }, { "tid", event.first },
+				{ "ts", event.second.start / 1000.0 }, { "dur", (event.second.end - event.second.start) / 1000.0 }, { "args", { { "depth", event.second.depth } } } });
+		}
+
+		for (auto& marker : s_frameMarkers)
+		{
+			events.push_back({ { "name", "Frame" }, { "ph", "i" }, { "s", "g" }, { "pid", 0 }, { "tid", 0 },
+				{ "ts", marker.first / 1000.0 }, { "args", { { "frame", marker.second } } } });
+		}
+
+		trace["displayTimeUnit"] = "ms";
+		file << trace.dump();
+		file.close();
+
+		ENGINE_INFO("[Profiler::exportChromeTrace] Wrote {0} events over {1} frames to {2}.", s_capturedEvents.size(), s_frameMarkers.size(), filePath);
+	}
+}
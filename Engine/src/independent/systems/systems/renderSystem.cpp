@@ -9,6 +9,8 @@
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/rendering/renderUtils.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/utils/allocationTracker.h"
 
 namespace Engine
 {
@@ -80,8 +82,11 @@ namespace Engine
 	*/
 	void RenderSystem::onRender(Scene* scene)
 	{
+		ENGINE_PROFILE_FUNCTION();
+		AllocationScope allocationScope(AllocationTag::Render);
+
 		// Get a list of all entities in the scene
-		std::vector<Entity*> entityList = scene->getEntities();
+		FrameVector<Entity*> entityList = scene->getEntities();
 
 		// Get a list of all the render passes for this scene
 		std::vector<RenderPass*> renderPassList = scene->getRenderPasses();
@@ -7,7 +7,11 @@
 */
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/utils/resourceLoader.h"
+#include "independent/rendering/textures/textureAtlasBuilder.h"
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/counterSystem.h"
+#include "independent/utils/allocationTracker.h"
+#include "independent/rendering/geometry/vertex.h"
 
 namespace Engine
 {
@@ -80,7 +84,8 @@ namespace Engine
 			s_configValues.push_back(configData["vertex3DCapacity"]);
 			s_configValues.push_back(configData["index3DCapacity"]);
 			s_configValues.push_back(configData["batchCapacity3D"]);
-			s_configValues.push_back(configData["batchCapacity2D"]);
+			// The 2D batch is given a number of bytes for its instance buffer, and holds as many quads as fit
+			s_configValues.push_back(configData["batchMemory2D"].get<uint32_t>() / static_cast<uint32_t>(sizeof(QuadInstance2D)));
 			s_configValues.push_back(configData["maxLayersPerScene"]);
 			s_configValues.push_back(configData["maxRenderPassesPerScene"]);
 			s_configValues.push_back(configData["maxLightsPerRenderCall"]);
@@ -99,6 +104,7 @@ namespace Engine
 		{
 			ENGINE_INFO("[ResourceManager::stop] Stopping the resource manager.");
 			destroyResource(); //!< By providing no resource name, all resources will be deleted
+			TextureAtlasBuilder::clear();
 			s_enabled = false;
 		}
 	}
@@ -132,6 +138,7 @@ namespace Engine
 				}
 
 				s_loadedResources[resourceName] = resource;
+				CounterSystem::increment(Counter::ResourcesLoaded);
 			}
 			else
 				ENGINE_WARN("[ResourceManager::registerResource] This resource name has already been taken by another resource. Name: {0}.", resourceName);
@@ -201,6 +208,7 @@ namespace Engine
 	//! loadNTResources()
 	void ResourceManager::loadNTResources()
 	{
+		AllocationScope allocationScope(AllocationTag::Resources);
 		ENGINE_INFO("[ResourceManager::start] Loading non-threaded resources.");
 		ResourceLoader::loadVertexBuffers("assets/vertexBuffers.json");
 		ResourceLoader::loadVertexArrays("assets/vertexArrays.json");
@@ -210,6 +218,7 @@ namespace Engine
 		ResourceLoader::loadShaderPrograms("assets/engine/shaders.json");
 		ResourceLoader::loadTextures("assets/textures.json");
 		ResourceLoader::loadTextures("assets/engine/textures.json");
+		TextureAtlasBuilder::build();
 		ResourceLoader::loadSubTextures("assets/subTextures.json");
 		ResourceLoader::loadSubTextures("assets/engine/subTextures.json");
 		ResourceLoader::loadMaterials("assets/materials.json");
@@ -219,6 +228,7 @@ namespace Engine
 	//! loadTResources()
 	void ResourceManager::loadTResources()
 	{
+		AllocationScope allocationScope(AllocationTag::Resources);
 		ENGINE_INFO("[ResourceManager::start] Loading threaded resources.");
 		ResourceLoader::load3DModels("assets/models.json");
 
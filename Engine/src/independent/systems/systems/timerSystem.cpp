@@ -11,7 +11,7 @@
 namespace Engine
 {
 	bool TimerSystem::s_enabled = false; //!< Is this system enabled
-	std::map<const char*, std::pair<Timer*, float>> TimerSystem::s_timers = std::map<const char*, std::pair<Timer*, float>>(); //!< All running timers
+	std::map<std::string, std::pair<Timer*, float>, std::less<>> TimerSystem::s_timers = std::map<std::string, std::pair<Timer*, float>, std::less<>>(); //!< All running timers
 
 	//! TimerSystem
 	TimerSystem::TimerSystem() : System(SystemType::TimerSystem)
@@ -276,9 +276,9 @@ namespace Engine
 
 	//! getAllTimers()
 	/*!
-	\return a const std::map<const char*, std::pair<Timer*, float>>& - The list of times
+	\return a const std::map<std::string, std::pair<Timer*, float>, std::less<>>& - The list of times
 	*/
-	const std::map<const char*, std::pair<Timer*, float>>& TimerSystem::getAllTimers()
+	const std::map<std::string, std::pair<Timer*, float>, std::less<>>& TimerSystem::getAllTimers()
 	{
 		if(!s_enabled)
 			ENGINE_ERROR("[TimerSystem::getAllTimers] This system has not been enabled.");
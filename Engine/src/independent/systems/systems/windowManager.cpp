@@ -160,6 +160,9 @@ namespace Engine
 						if (s_focusedWindow == it->second)
 							s_focusedWindow = nullptr;
 
+						// Drop any events the window queued this frame
+						EventManager::discardQueuedEvents(it->second);
+
 						delete it->second;
 						s_registeredWindows.erase((it++)->first);
 					}
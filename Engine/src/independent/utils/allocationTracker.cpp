@@ -0,0 +1,511 @@
+/*! \file allocationTracker.cpp
+*
+* \brief Counts every heap allocation in the process by thread and by subsystem tag, with optional per-frame budgets. The global
+* new and delete are only replaced in builds which define NG_TRACK_ALLOCATIONS, Debug does and Release does not
+*
+* \author Daniel Bullin
+*
+*/
+#include <new>
+#include <cstdlib>
+#include <cassert>
+#include "independent/utils/allocationTracker.h"
+#include "independent/systems/systems/counterSystem.h"
+#include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	AllocationTracker::ThreadTotals AllocationTracker::s_threads[AllocationTracker::MaxThreads]; //!< Zero initialised before any allocation can happen
+	thread_local AllocationTracker::ThreadTotals* AllocationTracker::s_threadTotals = nullptr; //!< Set to null pointer
+	thread_local AllocationTag::AllocationTag AllocationTracker::s_currentTag = AllocationTag::Untagged; //!< Set to untagged
+	std::atomic<uint32_t> AllocationTracker::s_threadCount; //!< Zero initialised
+	std::array<AllocationStats, AllocationTag::Count> AllocationTracker::s_lastTotals; //!< Initialise to 0
+	std::array<AllocationStats, AllocationTag::Count> AllocationTracker::s_lastFrame; //!< Initialise to 0
+	std::array<uint64_t, AllocationTag::Count> AllocationTracker::s_budgets = { AllocationTracker::NoBudget, AllocationTracker::NoBudget, AllocationTracker::NoBudget, AllocationTracker::NoBudget, AllocationTracker::NoBudget }; //!< No budgets
+	std::atomic<bool> AllocationTracker::s_enabled(false); //!< Set to false
+	bool AllocationTracker::s_breakOnBudget = false; //!< Set to false
+	uint32_t AllocationTracker::s_logInterval = 0; //!< Set to 0
+	uint32_t AllocationTracker::s_warmupFrames = 0; //!< Set to 0
+	uint64_t AllocationTracker::s_frameNumber = 0; //!< Set to 0
+
+	//! registerThread()
+	/*!
+	\return a AllocationTracker::ThreadTotals* - The totals of the calling thread
+	*/
+	AllocationTracker::ThreadTotals* AllocationTracker::registerThread()
+	{
+		const uint32_t index = s_threadCount.fetch_add(1, std::memory_order_relaxed);
+		ThreadTotals* totals = &s_threads[std::min(index, MaxThreads - 1)];
+		s_threadTotals = totals;
+		return totals;
+	}
+
+	//! configure()
+	void AllocationTracker::configure()
+	{
+		nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+		if (configData.find("allocationTracking") == configData.end()) return;
+
+		nlohmann::json& settings = configData["allocationTracking"];
+		s_breakOnBudget = settings.value("breakOnBudget", 0) != 0;
+		s_logInterval = settings.value("logInterval", 0u);
+		s_warmupFrames = settings.value("warmupFrames", 0u);
+
+		// A budget of -1 or a missing tag is not checked
+		if (settings.find("budgets") != settings.end())
+		{
+			for (uint32_t i = 0; i < AllocationTag::Count; i++)
+			{
+				const AllocationTag::AllocationTag tag = static_cast<AllocationTag::AllocationTag>(i);
+				const int64_t budget = settings["budgets"].value(toString(tag), int64_t(-1));
+				setBudget(tag, budget < 0 ? NoBudget : static_cast<uint64_t>(budget));
+			}
+		}
+
+		setEnabled(settings.value("enabled", 0) != 0);
+	}
+
+	//! onAllocate()
+	/*!
+	\param size a const size_t - The number of bytes allocated
+	*/
+	void AllocationTracker::onAllocate(const size_t size)
+	{
+		if (!s_enabled.load(std::memory_order_relaxed)) return;
+
+		ThreadTotals* totals = s_threadTotals;
+		if (!totals) totals = registerThread();
+
+		// Each thread owns its totals so a plain load and store is enough, only the shared overflow slot needs an atomic add
+		std::atomic<uint64_t>& allocations = totals->allocations[s_currentTag];
+		std::atomic<uint64_t>& bytes = totals->bytes[s_currentTag];
+		if (totals != &s_threads[MaxThreads - 1])
+		{
+			allocations.store(allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			bytes.store(bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+		}
+		else
+		{
+			allocations.fetch_add(1, std::memory_order_relaxed);
+			bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+	}
+
+	//! onFrameEnd()
+	void AllocationTracker::onFrameEnd()
+	{
+		// The totals only grow, so this frame is the difference from the totals at the end of the last one
+		const uint32_t threadCount = std::min(s_threadCount.load(std::memory_order_relaxed), MaxThreads);
+		AllocationStats frameTotal;
+		for (uint32_t tag = 0; tag < AllocationTag::Count; tag++)
+		{
+			AllocationStats totals;
+			for (uint32_t thread = 0; thread < threadCount; thread++)
+			{
+				totals.allocations += s_threads[thread].allocations[tag].load(std::memory_order_relaxed);
+				totals.bytes += s_threads[thread].bytes[tag].load(std::memory_order_relaxed);
+			}
+
+			s_lastFrame[tag].allocations = totals.allocations - s_lastTotals[tag].allocations;
+			s_lastFrame[tag].bytes = totals.bytes - s_lastTotals[tag].bytes;
+			s_lastTotals[tag] = totals;
+
+			frameTotal.allocations += s_lastFrame[tag].allocations;
+			frameTotal.bytes += s_lastFrame[tag].bytes;
+		}
+
+		CounterSystem::increment(Counter::Allocations, frameTotal.allocations);
+		CounterSystem::increment(Counter::AllocatedBytes, frameTotal.bytes);
+		s_frameNumber++;
+
+		if (!s_enabled.load(std::memory_order_relaxed)) return;
+
+		if (s_frameNumber > s_warmupFrames)
+		{
+			for (uint32_t i = 0; i < AllocationTag::Count; i++)
+			{
+				const AllocationTag::AllocationTag tag = static_cast<AllocationTag::AllocationTag>(i);
+				if (s_lastFrame[tag].allocations > s_budgets[tag])
+				{
+					ENGINE_WARN("[AllocationTracker::onFrameEnd] {0} went over its allocation budget. Allocations: {1}, Budget: {2}, Bytes: {3}.",
+						toString(tag), s_lastFrame[tag].allocations, s_budgets[tag], s_lastFrame[tag].bytes);
+					assert(!s_breakOnBudget && "An allocation budget was exceeded");
+				}
+			}
+		}
+
+		if (s_logInterval != 0 && s_frameNumber % s_logInterval == 0)
+		{
+			ENGINE_INFO("[AllocationTracker::onFrameEnd] Frame {0}: {1} allocations, {2} bytes. Render: {3}, Scene: {4}, Scripts: {5}, Resources: {6}, Untagged: {7}.",
+				s_frameNumber, frameTotal.allocations, frameTotal.bytes, s_lastFrame[AllocationTag::Render].allocations, s_lastFrame[AllocationTag::Scene].allocations,
+				s_lastFrame[AllocationTag::Scripts].allocations, s_lastFrame[AllocationTag::Resources].allocations, s_lastFrame[AllocationTag::Untagged].allocations);
+		}
+	}
+
+	//! setEnabled()
+	/*!
+	\param enabled a const bool - Should allocations be counted, tags reported and budgets checked
+	*/
+	void AllocationTracker::setEnabled(const bool enabled)
+	{
+		s_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	//! isEnabled()
+	/*!
+	\return a const bool - Are allocations counted, tags reported and budgets checked
+	*/
+	const bool AllocationTracker::isEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	//! setBudget()
+	/*!
+	\param tag a const AllocationTag::AllocationTag - The tag
+	\param allocations a const uint64_t - The most allocations the tag may make in a frame, NoBudget to stop checking it
+	*/
+	void AllocationTracker::setBudget(const AllocationTag::AllocationTag tag, const uint64_t allocations)
+	{
+		s_budgets[tag] = allocations;
+	}
+
+	//! getBudget()
+	/*!
+	\param tag a const AllocationTag::AllocationTag - The tag
+	\return a const uint64_t - The most allocations the tag may make in a frame
+	*/
+	const uint64_t AllocationTracker::getBudget(const AllocationTag::AllocationTag tag)
+	{
+		return s_budgets[tag];
+	}
+
+	//! getLastFrame()
+	/*!
+	\param tag a const AllocationTag::AllocationTag - The tag
+	\return a const AllocationStats& - The allocations of the tag in the last complete frame
+	*/
+	const AllocationStats& AllocationTracker::getLastFrame(const AllocationTag::AllocationTag tag)
+	{
+		return s_lastFrame[tag];
+	}
+
+	//! getLastFrameTotal()
+	/*!
+	\return an AllocationStats - The allocations of every tag in the last complete frame
+	*/
+	AllocationStats AllocationTracker::getLastFrameTotal()
+	{
+		AllocationStats total;
+		for (auto& stats : s_lastFrame)
+		{
+			total.allocations += stats.allocations;
+			total.bytes += stats.bytes;
+		}
+		return total;
+	}
+
+	//! getCurrentTag()
+	/*!
+	\return an AllocationTag::AllocationTag - The tag of the calling thread
+	*/
+	AllocationTag::AllocationTag AllocationTracker::getCurrentTag()
+	{
+		return s_currentTag;
+	}
+
+	//! setCurrentTag()
+	/*!
+	\param tag a const AllocationTag::AllocationTag - The tag
+	*/
+	void AllocationTracker::setCurrentTag(const AllocationTag::AllocationTag tag)
+	{
+		s_currentTag = tag;
+	}
+
+	//! toString()
+	/*!
+	\param tag a const AllocationTag::AllocationTag - The tag
+	\return a const char* - The name of the tag
+	*/
+	const char* AllocationTracker::toString(const AllocationTag::AllocationTag tag)
+	{
+		switch (tag)
+		{
+			case AllocationTag::Untagged: return "Untagged";
+			case AllocationTag::Render: return "Render";
+			case AllocationTag::Scene: return "Scene";
+			case AllocationTag::Scripts: return "Scripts";
+			case AllocationTag::Resources: return "Resources";
+			default: return "Unknown";
+		}
+	}
+}
+
+#ifdef NG_TRACK_ALLOCATIONS
+namespace
+{
+	//! allocate()
+	/*!
+	\param size a std::size_t - The number of bytes to allocate
+	\return a void* - The allocated memory, nullptr if there was none left
+	*/
+	void* allocate(std::size_t size)
+	{
+		Engine::AllocationTracker::onAllocate(size);
+		return std::malloc(size ? size : 1);
+	}
+
+	//! allocateAligned()
+	/*!
+	\param size a std::size_t - The number of bytes to allocate
+	\param alignment a std::align_val_t - The alignment of the memory
+	\return a void* - The allocated memory, nullptr if there was none left
+	*/
+	void* allocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		Engine::AllocationTracker::onAllocate(size);
+#ifdef _MSC_VER
+		return _aligned_malloc(size ? size : 1, static_cast<std::size_t>(alignment));
+#else
+		void* memory = nullptr;
+		const std::size_t bytes = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+		return posix_memalign(&memory, bytes, size ? size : 1) == 0 ? memory : nullptr;
+#endif
+	}
+
+	//! freeAligned()
+	/*!
+	\param memory a void* - The memory to free, allocated by allocateAligned
+	*/
+	void freeAligned(void* memory)
+	{
+#ifdef _MSC_VER
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+}
+
+// Every form of new and delete is replaced so none of them bypass the counters or free memory from the wrong heap
+
+//! operator new()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\return a void* - The allocated memory
+*/
+void* operator new(std::size_t size)
+{
+	void* memory = allocate(size);
+	if (!memory) throw std::bad_alloc();
+	return memory;
+}
+
+//! operator new[]()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\return a void* - The allocated memory
+*/
+void* operator new[](std::size_t size)
+{
+	void* memory = allocate(size);
+	if (!memory) throw std::bad_alloc();
+	return memory;
+}
+
+//! operator new()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param nothrow a const std::nothrow_t& - Return nullptr rather than throw
+\return a void* - The allocated memory, nullptr if there was none left
+*/
+void* operator new(std::size_t size, const std::nothrow_t& nothrow) noexcept
+{
+	return allocate(size);
+}
+
+//! operator new[]()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param nothrow a const std::nothrow_t& - Return nullptr rather than throw
+\return a void* - The allocated memory, nullptr if there was none left
+*/
+void* operator new[](std::size_t size, const std::nothrow_t& nothrow) noexcept
+{
+	return allocate(size);
+}
+
+//! operator new()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param alignment a std::align_val_t - The alignment of the memory
+\return a void* - The allocated memory
+*/
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	void* memory = allocateAligned(size, alignment);
+	if (!memory) throw std::bad_alloc();
+	return memory;
+}
+
+//! operator new[]()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param alignment a std::align_val_t - The alignment of the memory
+\return a void* - The allocated memory
+*/
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	void* memory = allocateAligned(size, alignment);
+	if (!memory) throw std::bad_alloc();
+	return memory;
+}
+
+//! operator new()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param alignment a std::align_val_t - The alignment of the memory
+\param nothrow a const std::nothrow_t& - Return nullptr rather than throw
+\return a void* - The allocated memory, nullptr if there was none left
+*/
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+//! operator new[]()
+/*!
+\param size a std::size_t - The number of bytes to allocate
+\param alignment a std::align_val_t - The alignment of the memory
+\param nothrow a const std::nothrow_t& - Return nullptr rather than throw
+\return a void* - The allocated memory, nullptr if there was none left
+*/
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+*/
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+*/
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+\param size a std::size_t - The number of bytes allocated
+*/
+void operator delete(void* memory, std::size_t size) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+\param size a std::size_t - The number of bytes allocated
+*/
+void operator delete[](void* memory, std::size_t size) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+\param nothrow a const std::nothrow_t& - The nothrow form
+*/
+void operator delete(void* memory, const std::nothrow_t& nothrow) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+\param nothrow a const std::nothrow_t& - The nothrow form
+*/
+void operator delete[](void* memory, const std::nothrow_t& nothrow) noexcept
+{
+	std::free(memory);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+\param alignment a std::align_val_t - The alignment of the memory
+*/
+void operator delete(void* memory, std::align_val_t alignment) noexcept
+{
+	freeAligned(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+\param alignment a std::align_val_t - The alignment of the memory
+*/
+void operator delete[](void* memory, std::align_val_t alignment) noexcept
+{
+	freeAligned(memory);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+\param size a std::size_t - The number of bytes allocated
+\param alignment a std::align_val_t - The alignment of the memory
+*/
+void operator delete(void* memory, std::size_t size, std::align_val_t alignment) noexcept
+{
+	freeAligned(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+\param size a std::size_t - The number of bytes allocated
+\param alignment a std::align_val_t - The alignment of the memory
+*/
+void operator delete[](void* memory, std::size_t size, std::align_val_t alignment) noexcept
+{
+	freeAligned(memory);
+}
+
+//! operator delete()
+/*!
+\param memory a void* - The memory to free
+\param alignment a std::align_val_t - The alignment of the memory
+\param nothrow a const std::nothrow_t& - The nothrow form
+*/
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t& nothrow) noexcept
+{
+	freeAligned(memory);
+}
+
+//! operator delete[]()
+/*!
+\param memory a void* - The memory to free
+\param alignment a std::align_val_t - The alignment of the memory
+\param nothrow a const std::nothrow_t& - The nothrow form
+*/
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t& nothrow) noexcept
+{
+	freeAligned(memory);
+}
+#endif
@@ -18,8 +18,9 @@ namespace Engine
 	\param node a aiNode* - A node containing a number of meshes
 	\param scene a const aiScene* - A scene containing all data loaded from model into assimp
 	\param meshes a std::vector<Mesh3D>& - A vector of meshes referenced from the model we're currently loading
+	\param materialNames a std::vector<std::string>* - The name of each mesh's material in the model file, nullptr if not needed
 	*/
-	void AssimpLoader::processNode(aiNode* node, const aiScene* scene, std::vector<Mesh3D>& meshes)
+	void AssimpLoader::processNode(aiNode* node, const aiScene* scene, std::vector<Mesh3D>& meshes, std::vector<std::string>* materialNames)
 	{
 		// Create meshes for all aiMeshes in the current node
 		for (unsigned int i = 0; i < node->mNumMeshes; i++)
@@ -29,11 +30,14 @@ namespace Engine
 			// Use aiMesh to create our custom Mesh object
 			// Populate the vector of meshes we were given by reference
 			meshes.push_back(processMesh(mesh, scene));
+
+			if (materialNames)
+				materialNames->push_back(mesh->mMaterialIndex < scene->mNumMaterials ? scene->mMaterials[mesh->mMaterialIndex]->GetName().C_Str() : "");
 		}
 
 		// After we've processed all meshes for the current node, go through all the child nodes
 		for (unsigned int i = 0; i < node->mNumChildren; i++)
-			processNode(node->mChildren[i], scene, meshes);
+			processNode(node->mChildren[i], scene, meshes, materialNames);
 	}
 
 	//! processMesh()
@@ -83,8 +87,9 @@ namespace Engine
 	/*!
 	\param filePath a const std::string& - The file path of the model
 	\param meshes a std::vector<Mesh3D>& - The vector of meshes in the model
+	\param materialNames a std::vector<std::string>* - The name of each mesh's material in the model file, nullptr if not needed
 	*/
-	void AssimpLoader::loadModel(const std::string& filePath, std::vector<Mesh3D>& meshes)
+	void AssimpLoader::loadModel(const std::string& filePath, std::vector<Mesh3D>& meshes, std::vector<std::string>* materialNames)
 	{
 		// Read model file into assimp
 		Assimp::Importer importer;
@@ -101,8 +106,9 @@ namespace Engine
 
 		// Clear any previous meshes in the models' meshes
 		meshes.clear();
+		if (materialNames) materialNames->clear();
 
 		// Recursively go through each node and create meshes
-		processNode(scene->mRootNode, scene, meshes);
+		processNode(scene->mRootNode, scene, meshes, materialNames);
 	}
 }
\ No newline at end of file
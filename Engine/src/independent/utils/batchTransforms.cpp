@@ -0,0 +1,293 @@
+/*! \file batchTransforms.cpp
+*
+* \brief Math kernels which build and apply transforms for many objects at once, using SSE where it is available
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/utils/batchTransforms.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define NG_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define NG_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Engine
+{
+	namespace
+	{
+		/*! \struct Rotation
+		* \brief The rotation part of a model matrix, stored by column
+		*/
+		struct Rotation
+		{
+			float m[3][3]; //!< The columns
+		};
+
+		//! getRotation()
+		/*!
+		\param orientation a const glm::vec3& - The rotation around x, y and z in degrees
+		\return a Rotation - The same matrix glm::rotate gives when applied around x, then y, then z
+		*/
+		Rotation getRotation(const glm::vec3& orientation)
+		{
+			const float sa = sinf(glm::radians(orientation.x)), ca = cosf(glm::radians(orientation.x));
+			const float sb = sinf(glm::radians(orientation.y)), cb = cosf(glm::radians(orientation.y));
+			const float sc = sinf(glm::radians(orientation.z)), cc = cosf(glm::radians(orientation.z));
+
+			// Rx * Ry * Rz multiplied out
+			Rotation rotation;
+			rotation.m[0][0] = cb * cc;
+			rotation.m[0][1] = ca * sc + sa * sb * cc;
+			rotation.m[0][2] = sa * sc - ca * sb * cc;
+			rotation.m[1][0] = -cb * sc;
+			rotation.m[1][1] = ca * cc - sa * sb * sc;
+			rotation.m[1][2] = sa * cc + ca * sb * sc;
+			rotation.m[2][0] = sb;
+			rotation.m[2][1] = -sa * cb;
+			rotation.m[2][2] = ca * cb;
+			return rotation;
+		}
+
+#ifdef NG_SIMD_SSE2
+		//! sinCos()
+		/*!
+		\param x a const __m128 - Four angles in radians
+		\param sine a __m128& - The sine of each angle
+		\param cosine a __m128& - The cosine of each angle
+		*/
+		void sinCos(const __m128 x, __m128& sine, __m128& cosine)
+		{
+			// Cephes' single precision sinf and cosf, four at a time. The angle is brought into the octant around zero
+			// and both polynomials are evaluated, each lane then picks the one its octant needs
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			__m128 sineSign = _mm_and_ps(x, signMask);
+			__m128 angle = _mm_andnot_ps(signMask, x);
+
+			__m128i octant = _mm_cvttps_epi32(_mm_mul_ps(angle, _mm_set1_ps(1.27323954473516f)));
+			octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+			const __m128 y = _mm_cvtepi32_ps(octant);
+
+			sineSign = _mm_xor_ps(sineSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29)));
+			const __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+			const __m128 usesSinePolynomial = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+			// Subtract the octant's multiple of pi / 4 in three parts to keep the precision
+			angle = _mm_sub_ps(angle, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+			angle = _mm_sub_ps(angle, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+			angle = _mm_sub_ps(angle, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+			const __m128 z = _mm_mul_ps(angle, angle);
+
+			__m128 cosinePolynomial = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+			cosinePolynomial = _mm_add_ps(_mm_mul_ps(cosinePolynomial, z), _mm_set1_ps(4.166664568298827e-2f));
+			cosinePolynomial = _mm_mul_ps(_mm_mul_ps(cosinePolynomial, z), z);
+			cosinePolynomial = _mm_add_ps(_mm_sub_ps(cosinePolynomial, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.f));
+
+			__m128 sinePolynomial = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+			sinePolynomial = _mm_add_ps(_mm_mul_ps(sinePolynomial, z), _mm_set1_ps(-1.6666654611e-1f));
+			sinePolynomial = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinePolynomial, z), angle), angle);
+
+			sine = _mm_or_ps(_mm_and_ps(usesSinePolynomial, sinePolynomial), _mm_andnot_ps(usesSinePolynomial, cosinePolynomial));
+			cosine = _mm_or_ps(_mm_and_ps(usesSinePolynomial, cosinePolynomial), _mm_andnot_ps(usesSinePolynomial, sinePolynomial));
+			sine = _mm_xor_ps(sine, sineSign);
+			cosine = _mm_xor_ps(cosine, cosineSign);
+		}
+
+		//! gather()
+		/*!
+		\param vectors a const glm::vec3* - Four vectors
+		\param axis a const int - The component to gather
+		\return a __m128 - The component of each vector
+		*/
+		inline __m128 gather(const glm::vec3* vectors, const int axis)
+		{
+			return _mm_set_ps(vectors[3][axis], vectors[2][axis], vectors[1][axis], vectors[0][axis]);
+		}
+#endif
+	}
+
+	//! composeModelMatrix()
+	/*!
+	\param position a const glm::vec3& - The position
+	\param orientation a const glm::vec3& - The rotation around x, y and z in degrees
+	\param scale a const glm::vec3& - The scale
+	\return a glm::mat4 - The model matrix, translate then rotate then scale
+	*/
+	glm::mat4 BatchTransforms::composeModelMatrix(const glm::vec3& position, const glm::vec3& orientation, const glm::vec3& scale)
+	{
+		const Rotation rotation = getRotation(orientation);
+
+		glm::mat4 model;
+		for (int i = 0; i < 3; i++)
+			model[i] = glm::vec4(rotation.m[i][0] * scale[i], rotation.m[i][1] * scale[i], rotation.m[i][2] * scale[i], 0.f);
+		model[3] = glm::vec4(position, 1.f);
+		return model;
+	}
+
+	//! composeModelMatrices()
+	/*!
+	\param positions a const glm::vec3* - The positions
+	\param orientations a const glm::vec3* - The rotations around x, y and z in degrees
+	\param scales a const glm::vec3* - The scales
+	\param matrices a glm::mat4* - The model matrices, can point straight into an instance buffer
+	\param count a const uint32_t - The number of matrices
+	*/
+	void BatchTransforms::composeModelMatrices(const glm::vec3* positions, const glm::vec3* orientations, const glm::vec3* scales, glm::mat4* matrices, const uint32_t count)
+	{
+		uint32_t i = 0;
+
+#ifdef NG_SIMD_SSE2
+		// Four matrices at a time, each register holds one element of all four so the sines and cosines are worked out together
+		const __m128 toRadians = _mm_set1_ps(glm::radians(1.f));
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 sa, ca, sb, cb, sc, cc;
+			sinCos(_mm_mul_ps(gather(orientations + i, 0), toRadians), sa, ca);
+			sinCos(_mm_mul_ps(gather(orientations + i, 1), toRadians), sb, cb);
+			sinCos(_mm_mul_ps(gather(orientations + i, 2), toRadians), sc, cc);
+
+			const __m128 scaleX = gather(scales + i, 0);
+			const __m128 scaleY = gather(scales + i, 1);
+			const __m128 scaleZ = gather(scales + i, 2);
+			const __m128 sasb = _mm_mul_ps(sa, sb);
+			const __m128 casb = _mm_mul_ps(ca, sb);
+
+			// The same Rx * Ry * Rz as getRotation, with each column scaled
+			__m128 columns[4][4];
+			columns[0][0] = _mm_mul_ps(_mm_mul_ps(cb, cc), scaleX);
+			columns[0][1] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ca, sc), _mm_mul_ps(sasb, cc)), scaleX);
+			columns[0][2] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sa, sc), _mm_mul_ps(casb, cc)), scaleX);
+			columns[1][0] = _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(cb, sc)), scaleY);
+			columns[1][1] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(ca, cc), _mm_mul_ps(sasb, sc)), scaleY);
+			columns[1][2] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sa, cc), _mm_mul_ps(casb, sc)), scaleY);
+			columns[2][0] = _mm_mul_ps(sb, scaleZ);
+			columns[2][1] = _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sa, cb)), scaleZ);
+			columns[2][2] = _mm_mul_ps(_mm_mul_ps(ca, cb), scaleZ);
+			for (int column = 0; column < 3; column++)
+			{
+				columns[column][3] = _mm_setzero_ps();
+				columns[3][column] = gather(positions + i, column);
+			}
+			columns[3][3] = _mm_set1_ps(1.f);
+
+			// Turn each column from one element of four matrices into four elements of one matrix
+			for (int column = 0; column < 4; column++)
+			{
+				_MM_TRANSPOSE4_PS(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+				for (uint32_t lane = 0; lane < 4; lane++)
+					_mm_storeu_ps(&matrices[i + lane][column][0], columns[column][lane]);
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+			matrices[i] = composeModelMatrix(positions[i], orientations[i], scales[i]);
+	}
+
+	//! composeModelMatrices()
+	/*!
+	\param positions a const glm::vec3* - The positions
+	\param scale a const glm::vec3& - The scale of every matrix
+	\param matrices a glm::mat4* - The model matrices, can point straight into an instance buffer
+	\param count a const uint32_t - The number of matrices
+	*/
+	void BatchTransforms::composeModelMatrices(const glm::vec3* positions, const glm::vec3& scale, glm::mat4* matrices, const uint32_t count)
+	{
+#ifdef NG_SIMD_SSE
+		// Only the translation changes between matrices
+		const __m128 column0 = _mm_set_ps(0.f, 0.f, 0.f, scale.x);
+		const __m128 column1 = _mm_set_ps(0.f, 0.f, scale.y, 0.f);
+		const __m128 column2 = _mm_set_ps(0.f, scale.z, 0.f, 0.f);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			float* matrix = &matrices[i][0][0];
+			_mm_storeu_ps(matrix, column0);
+			_mm_storeu_ps(matrix + 4, column1);
+			_mm_storeu_ps(matrix + 8, column2);
+			_mm_storeu_ps(matrix + 12, _mm_set_ps(1.f, positions[i].z, positions[i].y, positions[i].x));
+		}
+#else
+		for (uint32_t i = 0; i < count; i++)
+		{
+			matrices[i] = glm::mat4(1.f);
+			matrices[i][0][0] = scale.x;
+			matrices[i][1][1] = scale.y;
+			matrices[i][2][2] = scale.z;
+			matrices[i][3] = glm::vec4(positions[i], 1.f);
+		}
+#endif
+	}
+
+	//! decomposeQuad()
+	/*!
+	\param matrix a const glm::mat4& - The model matrix of a unit quad
+	\param transform a glm::vec4& - The centre of the quad in x and y, its depth in z and its rotation in radians in w
+	\param size a glm::vec2& - The width and height of the quad, the height is negative when the quad is mirrored
+	*/
+	void BatchTransforms::decomposeQuad(const glm::mat4& matrix, glm::vec4& transform, glm::vec2& size)
+	{
+		// Only the x and y axes and the translation place a flat quad, any shear is dropped
+		const glm::vec2 x = glm::vec2(matrix[0]);
+		const glm::vec2 y = glm::vec2(matrix[1]);
+
+		size.x = glm::length(x);
+		size.y = glm::length(y);
+		if (x.x * y.y - x.y * y.x < 0.f) size.y = -size.y;
+
+		// A quad with no width takes its rotation from the y axis instead
+		const float rotation = size.x > 0.f ? glm::atan(x.y, x.x) : glm::atan(-y.x, y.y);
+		transform = glm::vec4(matrix[3][0], matrix[3][1], matrix[3][2], rotation);
+	}
+
+	//! transformBounds()
+	/*!
+	\param matrices a const glm::mat4* - The model matrices
+	\param localBounds a const AABB* - The bounding boxes in local space
+	\param worldBounds an AABB* - The bounding boxes which contain the transformed local boxes
+	\param count a const uint32_t - The number of bounding boxes
+	*/
+	void BatchTransforms::transformBounds(const glm::mat4* matrices, const AABB* localBounds, AABB* worldBounds, const uint32_t count)
+	{
+		// Transform the centre and grow the half size by the absolute rotation and scale, which avoids transforming all eight corners
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::vec3 centre = (localBounds[i].Min + localBounds[i].Max) * 0.5f;
+			const glm::vec3 extent = (localBounds[i].Max - localBounds[i].Min) * 0.5f;
+
+#ifdef NG_SIMD_SSE
+			const float* matrix = &matrices[i][0][0];
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 column0 = _mm_loadu_ps(matrix);
+			const __m128 column1 = _mm_loadu_ps(matrix + 4);
+			const __m128 column2 = _mm_loadu_ps(matrix + 8);
+
+			__m128 worldCentre = _mm_loadu_ps(matrix + 12);
+			worldCentre = _mm_add_ps(worldCentre, _mm_mul_ps(column0, _mm_set1_ps(centre.x)));
+			worldCentre = _mm_add_ps(worldCentre, _mm_mul_ps(column1, _mm_set1_ps(centre.y)));
+			worldCentre = _mm_add_ps(worldCentre, _mm_mul_ps(column2, _mm_set1_ps(centre.z)));
+
+			__m128 worldExtent = _mm_mul_ps(_mm_andnot_ps(signMask, column0), _mm_set1_ps(extent.x));
+			worldExtent = _mm_add_ps(worldExtent, _mm_mul_ps(_mm_andnot_ps(signMask, column1), _mm_set1_ps(extent.y)));
+			worldExtent = _mm_add_ps(worldExtent, _mm_mul_ps(_mm_andnot_ps(signMask, column2), _mm_set1_ps(extent.z)));
+
+			alignas(16) float minimum[4], maximum[4];
+			_mm_store_ps(minimum, _mm_sub_ps(worldCentre, worldExtent));
+			_mm_store_ps(maximum, _mm_add_ps(worldCentre, worldExtent));
+			worldBounds[i].Min = { minimum[0], minimum[1], minimum[2] };
+			worldBounds[i].Max = { maximum[0], maximum[1], maximum[2] };
+#else
+			const glm::mat3 rotationScale(matrices[i]);
+			const glm::vec3 worldCentre = rotationScale * centre + glm::vec3(matrices[i][3]);
+			const glm::vec3 worldExtent = glm::mat3(glm::abs(rotationScale[0]), glm::abs(rotationScale[1]), glm::abs(rotationScale[2])) * extent;
+			worldBounds[i].Min = worldCentre - worldExtent;
+			worldBounds[i].Max = worldCentre + worldExtent;
+#endif
+		}
+	}
+}
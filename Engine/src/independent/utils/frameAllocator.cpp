@@ -0,0 +1,192 @@
+/*! \file frameAllocator.cpp
+*
+* \brief Linear arenas for memory which only lives for a frame or a function, freed all at once instead of one allocation at a time
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/utils/frameAllocator.h"
+#include "independent/systems/systems/counterSystem.h"
+
+namespace Engine
+{
+	uint32_t FrameAllocator::s_current = 0; //!< Start with the first arena
+
+	//! LinearArena()
+	/*!
+	\param initialSize a const size_t - The size of the first block
+	*/
+	LinearArena::LinearArena(const size_t initialSize)
+	{
+		m_current = 0;
+		m_offset = 0;
+		m_used = 0;
+		m_highWater = 0;
+		m_blocks.push_back({ static_cast<char*>(::operator new(initialSize)), initialSize });
+	}
+
+	//! ~LinearArena()
+	LinearArena::~LinearArena()
+	{
+		for (auto& block : m_blocks)
+			::operator delete(block.memory);
+		m_blocks.clear();
+	}
+
+	//! nextBlock()
+	/*!
+	\param minimumSize a const size_t - The size of the allocation which did not fit
+	*/
+	void LinearArena::nextBlock(const size_t minimumSize)
+	{
+		m_used += m_offset;
+		m_offset = 0;
+		m_current++;
+
+		// Blocks left over from earlier use are reused when they are large enough
+		while (m_current < m_blocks.size() && m_blocks[m_current].size < minimumSize)
+		{
+			::operator delete(m_blocks[m_current].memory);
+			m_blocks.erase(m_blocks.begin() + m_current);
+		}
+
+		// Each new block is at least double the last so an arena which keeps growing needs few of them
+		if (m_current == m_blocks.size())
+		{
+			const size_t size = std::max(minimumSize, m_blocks.back().size * 2);
+			m_blocks.push_back({ static_cast<char*>(::operator new(size)), size });
+		}
+	}
+
+	//! allocate()
+	/*!
+	\param size a const size_t - The size in bytes
+	\param alignment a const size_t - The alignment, must be a power of two
+	\return a void* - The memory
+	*/
+	void* LinearArena::allocate(const size_t size, const size_t alignment)
+	{
+		const uintptr_t mask = ~(static_cast<uintptr_t>(alignment) - 1);
+		uintptr_t base = reinterpret_cast<uintptr_t>(m_blocks[m_current].memory);
+		uintptr_t start = (base + m_offset + alignment - 1) & mask;
+
+		if (start + size > base + m_blocks[m_current].size)
+		{
+			// Out of room, move on to the next block
+			nextBlock(size + alignment);
+			base = reinterpret_cast<uintptr_t>(m_blocks[m_current].memory);
+			start = (base + alignment - 1) & mask;
+		}
+
+		m_offset = start + size - base;
+		m_highWater = std::max(m_highWater, getUsed());
+		return reinterpret_cast<void*>(start);
+	}
+
+	//! reset()
+	void LinearArena::reset()
+	{
+		// An arena which needed several blocks is given one block big enough for all of them, so the next use needs no heap allocations
+		if (m_blocks.size() > 1)
+		{
+			size_t total = 0;
+			for (auto& block : m_blocks)
+			{
+				total += block.size;
+				::operator delete(block.memory);
+			}
+
+			m_blocks.clear();
+			m_blocks.push_back({ static_cast<char*>(::operator new(total)), total });
+		}
+
+		m_current = 0;
+		m_offset = 0;
+		m_used = 0;
+	}
+
+	//! getMarker()
+	/*!
+	\return a LinearArena::Marker - The current position
+	*/
+	LinearArena::Marker LinearArena::getMarker() const
+	{
+		return { m_current, m_offset, m_used };
+	}
+
+	//! rewind()
+	/*!
+	\param marker a const LinearArena::Marker& - A position taken earlier from this arena
+	*/
+	void LinearArena::rewind(const Marker& marker)
+	{
+		// Later blocks are kept and used again as the arena fills back up
+		m_current = marker.block;
+		m_offset = marker.offset;
+		m_used = marker.used;
+	}
+
+	//! getArenas()
+	/*!
+	\return a std::array<LinearArena, 2>& - Both arenas
+	*/
+	std::array<LinearArena, 2>& FrameAllocator::getArenas()
+	{
+		// Created on first use so frame memory can be used during static initialisation
+		static std::array<LinearArena, 2> arenas;
+		return arenas;
+	}
+
+	//! getArena()
+	/*!
+	\return a LinearArena& - This frame's arena
+	*/
+	LinearArena& FrameAllocator::getArena()
+	{
+		return getArenas()[s_current];
+	}
+
+	//! onFrameEnd()
+	void FrameAllocator::onFrameEnd()
+	{
+		CounterSystem::setGauge(Gauge::FrameArenaBytes, static_cast<int64_t>(getArena().getUsed()));
+
+		// Memory from this frame is still valid next frame, memory from the frame before is not
+		s_current = 1 - s_current;
+		getArena().reset();
+	}
+
+	//! copyString()
+	/*!
+	\param string a const std::string& - The string
+	\return a const char* - The null terminated copy
+	*/
+	const char* FrameAllocator::copyString(const std::string& string)
+	{
+		char* copy = static_cast<char*>(getArena().allocate(string.size() + 1, 1));
+		memcpy(copy, string.c_str(), string.size() + 1);
+		return copy;
+	}
+
+	//! ScratchArena()
+	ScratchArena::ScratchArena()
+	{
+		m_marker = getArena().getMarker();
+	}
+
+	//! ~ScratchArena()
+	ScratchArena::~ScratchArena()
+	{
+		getArena().rewind(m_marker);
+	}
+
+	//! getArena()
+	/*!
+	\return a LinearArena& - This thread's arena
+	*/
+	LinearArena& ScratchArena::getArena()
+	{
+		static thread_local LinearArena arena;
+		return arena;
+	}
+}
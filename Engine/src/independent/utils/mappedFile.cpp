@@ -0,0 +1,130 @@
+/*! \file mappedFile.cpp
+*
+* \brief A read only view of a whole file mapped into memory, pages are only read from disk when first touched
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/utils/mappedFile.h"
+#include "independent/systems/systems/log.h"
+
+#ifdef NG_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Engine
+{
+	//! MappedFile()
+	MappedFile::MappedFile()
+	{
+		m_data = nullptr;
+		m_size = 0;
+		m_fileHandle = nullptr;
+		m_mappingHandle = nullptr;
+	}
+
+	//! MappedFile()
+	/*!
+	\param filePath a const std::string& - The path of the file to map
+	*/
+	MappedFile::MappedFile(const std::string& filePath) : MappedFile()
+	{
+		open(filePath);
+	}
+
+	//! ~MappedFile()
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	//! open()
+	/*!
+	\param filePath a const std::string& - The path of the file to map
+	\return a const bool - Was the file mapped
+	*/
+	const bool MappedFile::open(const std::string& filePath)
+	{
+		close();
+
+#ifdef NG_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			ENGINE_ERROR("[MappedFile::open] Could not create a mapping of the file. File Path: {0}.", filePath);
+			CloseHandle(file);
+			return false;
+		}
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			ENGINE_ERROR("[MappedFile::open] Could not map a view of the file. File Path: {0}.", filePath);
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_fileHandle = file;
+		m_mappingHandle = mapping;
+		m_data = static_cast<const uint8_t*>(view);
+		m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+		const int file = ::open(filePath.c_str(), O_RDONLY);
+		if (file < 0) return false;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || status.st_size == 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping keeps the file open by itself
+		::close(file);
+		if (view == MAP_FAILED)
+		{
+			ENGINE_ERROR("[MappedFile::open] Could not map the file. File Path: {0}.", filePath);
+			return false;
+		}
+
+		m_data = static_cast<const uint8_t*>(view);
+		m_size = static_cast<uint64_t>(status.st_size);
+#endif
+		return true;
+	}
+
+	//! close()
+	void MappedFile::close()
+	{
+#ifdef NG_PLATFORM_WINDOWS
+		if (m_data) UnmapViewOfFile(m_data);
+		if (m_mappingHandle) CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+		if (m_fileHandle) CloseHandle(static_cast<HANDLE>(m_fileHandle));
+#else
+		if (m_data) munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_fileHandle = nullptr;
+		m_mappingHandle = nullptr;
+	}
+}
@@ -6,6 +6,7 @@
 *
 */
 #include "independent/utils/mathUtils.h"
+#include "independent/utils/batchTransforms.h"
 
 namespace Engine
 {
@@ -32,8 +33,7 @@ namespace Engine
 	glm::mat4 MathUtils::getModelMatrix(const glm::vec3& pos)
 	{
 		glm::mat4 model = glm::mat4(1.f);
-		model = glm::translate(model, pos);
-		model = glm::scale(model, { 1.f, 1.f, 1.f });
+		model[3] = glm::vec4(pos, 1.f);
 		return model;
 	}
 
@@ -45,9 +45,8 @@ namespace Engine
 	*/
 	glm::mat4 MathUtils::getModelMatrix(const glm::vec3 & pos, const glm::vec3& scale)
 	{
-		glm::mat4 model = glm::mat4(1.f);
-		model = glm::translate(model, pos);
-		model = glm::scale(model, scale);
+		glm::mat4 model;
+		BatchTransforms::composeModelMatrices(&pos, scale, &model, 1);
 		return model;
 	}
 }
\ No newline at end of file
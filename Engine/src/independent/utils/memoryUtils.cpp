@@ -79,4 +79,23 @@ namespace Engine
 	{
 		return pack({ data.x, data.y, data.z, 1.f });
 	}
+
+	//! hash()
+	/*!
+	\param data a const void* - The bytes to hash
+	\param size a const size_t - The number of bytes
+	\param seed a const uint64_t - The hash to continue from, so several pieces of data can be hashed together
+	\return an uint64_t - The 64 bit FNV-1a hash
+	*/
+	uint64_t MemoryUtils::hash(const void* data, const size_t size, const uint64_t seed)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t value = seed;
+		for (size_t i = 0; i < size; i++)
+		{
+			value ^= bytes[i];
+			value *= 1099511628211ull;
+		}
+		return value;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*! \file poolAllocator.cpp
+*
+* \brief A pool allocator which hands out fixed size blocks from large chunks, used for small objects which are created and deleted often
+*
+* \author Daniel Bullin
+*
+*/
+#include "independent/utils/poolAllocator.h"
+
+namespace Engine
+{
+	//! ~SizeClass()
+	PoolAllocator::SizeClass::~SizeClass()
+	{
+		for (auto& chunk : chunks)
+			::operator delete(chunk);
+		chunks.clear();
+		freeList = nullptr;
+	}
+
+	//! getClasses()
+	/*!
+	\return a std::array<SizeClass, ClassCount>& - The size classes
+	*/
+	std::array<PoolAllocator::SizeClass, PoolAllocator::ClassCount>& PoolAllocator::getClasses()
+	{
+		// Created on first use so objects allocated during static initialisation still work
+		static std::array<SizeClass, ClassCount> classes;
+		return classes;
+	}
+
+	//! addChunk()
+	/*!
+	\param sizeClass a SizeClass& - The size class, its mutex must be held
+	\param blockSize a const uint32_t - The size of each block
+	\param blockCount a const uint32_t - The number of blocks in the chunk
+	*/
+	void PoolAllocator::addChunk(SizeClass& sizeClass, const uint32_t blockSize, const uint32_t blockCount)
+	{
+		char* chunk = static_cast<char*>(::operator new(static_cast<size_t>(blockSize) * blockCount));
+		sizeClass.chunks.push_back(chunk);
+
+		// Thread the new blocks onto the front of the free list
+		for (uint32_t i = blockCount; i > 0; i--)
+		{
+			void* block = chunk + static_cast<size_t>(i - 1) * blockSize;
+			*static_cast<void**>(block) = sizeClass.freeList;
+			sizeClass.freeList = block;
+		}
+	}
+
+	//! allocate()
+	/*!
+	\param size a const size_t - The size in bytes
+	\return a void* - The block
+	*/
+	void* PoolAllocator::allocate(const size_t size)
+	{
+		if (size == 0 || size > MaxBlockSize)
+			return ::operator new(size ? size : 1);
+
+		const uint32_t index = getClassIndex(size);
+		SizeClass& sizeClass = getClasses()[index];
+
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+		if (!sizeClass.freeList)
+			addChunk(sizeClass, (index + 1) * Granularity, BlocksPerChunk);
+
+		void* block = sizeClass.freeList;
+		sizeClass.freeList = *static_cast<void**>(block);
+		sizeClass.blocksInUse++;
+		return block;
+	}
+
+	//! deallocate()
+	/*!
+	\param memory a void* - The block
+	\param size a const size_t - The size in bytes the block was allocated with
+	*/
+	void PoolAllocator::deallocate(void* memory, const size_t size)
+	{
+		if (!memory) return;
+
+		if (size == 0 || size > MaxBlockSize)
+		{
+			::operator delete(memory);
+			return;
+		}
+
+		SizeClass& sizeClass = getClasses()[getClassIndex(size)];
+
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+		*static_cast<void**>(memory) = sizeClass.freeList;
+		sizeClass.freeList = memory;
+		sizeClass.blocksInUse--;
+	}
+
+	//! reserve()
+	/*!
+	\param size a const size_t - The size in bytes
+	\param count a const uint32_t - The number of blocks which should be available
+	*/
+	void PoolAllocator::reserve(const size_t size, const uint32_t count)
+	{
+		if (size == 0 || size > MaxBlockSize) return;
+
+		const uint32_t index = getClassIndex(size);
+		SizeClass& sizeClass = getClasses()[index];
+
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+
+		uint32_t available = 0;
+		for (void* block = sizeClass.freeList; block && available < count; block = *static_cast<void**>(block))
+			available++;
+
+		// One chunk large enough for the whole batch
+		if (available < count)
+			addChunk(sizeClass, (index + 1) * Granularity, count - available);
+	}
+
+	//! getBlocksInUse()
+	/*!
+	\param size a const size_t - The size in bytes
+	\return a const uint32_t - The number of blocks of the size class in use
+	*/
+	const uint32_t PoolAllocator::getBlocksInUse(const size_t size)
+	{
+		if (size == 0 || size > MaxBlockSize) return 0;
+
+		SizeClass& sizeClass = getClasses()[getClassIndex(size)];
+		std::lock_guard<std::mutex> lock(sizeClass.mutex);
+		return sizeClass.blocksInUse;
+	}
+}
@@ -5,12 +5,17 @@
 * \author Daniel Bullin
 *
 */
+#include <unordered_set>
 #include "independent/utils/resourceLoader.h"
 #include "independent/systems/systems/log.h"
 #include "independent/rendering/geometry/vertex.h"
 #include "independent/utils/assimpLoader.h"
+#include "independent/rendering/geometry/meshCooker.h"
+#include "independent/rendering/textures/textureAtlasBuilder.h"
+#include "independent/rendering/textures/textureCooker.h"
 #include "independent/systems/systems/windowManager.h"
 #include "independent/rendering/renderers/renderer3D.h"
+#include "independent/systems/systems/profiler.h"
 
 namespace Engine
 {
@@ -29,10 +34,8 @@ namespace Engine
 			return static_cast<uint32_t>(sizeof(Vertex3D));
 		else if (dataTypeName == "TerrainVertex")
 			return static_cast<uint32_t>(sizeof(TerrainVertex));
-		else if (dataTypeName == "Vertex2D")
-			return static_cast<uint32_t>(sizeof(Vertex2D));
-		else if (dataTypeName == "Vertex2DMultiTextured")
-			return static_cast<uint32_t>(sizeof(Vertex2DMultiTextured));
+		else if (dataTypeName == "QuadInstance2D")
+			return static_cast<uint32_t>(sizeof(QuadInstance2D));
 		else if (dataTypeName == "Mat4")
 			return static_cast<uint32_t>(sizeof(glm::mat4));
 		else if (dataTypeName == "Vec4")
@@ -61,12 +64,8 @@ namespace Engine
 
 		if (capacityLocation == "VertexCapacity3D")
 			return ResourceManager::getConfigValue(Config::VertexCapacity3D);
-		else if (capacityLocation == "VertexCapacity2D")
-			return ResourceManager::getConfigValue(Config::BatchCapacity2D) * 4; // 4 vertices per quad
 		else if (capacityLocation == "IndexCapacity3D")
 			return ResourceManager::getConfigValue(Config::IndexCapacity3D);
-		else if (capacityLocation == "IndexCapacity2D")
-			return ResourceManager::getConfigValue(Config::BatchCapacity2D) * 6; // 6 indices per quad
 		else if (capacityLocation == "Batch3DCapacity")
 			return ResourceManager::getConfigValue(Config::BatchCapacity3D); // Number of 3D Submissions
 		else if (capacityLocation == "Batch2DCapacity")
@@ -80,6 +79,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadVertexBuffers(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadVertexBuffers] Loading Vertex Buffers");
@@ -99,6 +100,7 @@ namespace Engine
 				VertexBufferUsage usage;
 				if (buffer["usage"] == 1) usage = VertexBufferUsage::StaticDraw;
 				if (buffer["usage"] == 2) usage = VertexBufferUsage::DynamicDraw;
+				if (buffer["usage"] == 3) usage = VertexBufferUsage::StreamDraw;
 
 				// Get the layout
 				VertexBufferLayout layout = { {}, getSize(buffer["dataType"].get<std::string>()) };
@@ -144,6 +146,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadVertexArrays(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadVertexArrays] Loading Vertex Arrays");
@@ -197,6 +201,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadUniformBuffers(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadUniformBuffers] Loading Uniform Buffers");
@@ -247,6 +253,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadFrameBuffers(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadFrameBuffers] Loading Framebuffers");
@@ -282,14 +290,16 @@ namespace Engine
 
 					// We now need to calculate the dimensions, first check if we should use the window dimensions
 					glm::ivec2 dimensions;
+					const float sceneScale = buffer.value("sceneScale", 1.f);
 
 					// We can either use the dimensions of the scene view (starts as size of window) or enter them manually
 					if (buffer["useSceneSize"].get<bool>())
 					{
 						auto window = WindowManager::getFocusedWindow();
 
+						// A framebuffer can be a fraction of the scene view, such as the water's reflection
 						if (window)
-							dimensions = WindowManager::getFocusedWindow()->getProperties().getSize();
+							dimensions = glm::max(glm::ivec2(glm::vec2(WindowManager::getFocusedWindow()->getProperties().getSize()) * sceneScale), glm::ivec2(1));
 						else
 						{
 							dimensions = glm::ivec2(buffer["dimensions"][0], buffer["dimensions"][1]);
@@ -301,6 +311,7 @@ namespace Engine
 
 					// Only need to provide the layout
 					newBuffer = FrameBuffer::create(name, buffer["useSceneSize"].get<bool>(), dimensions, layout);
+					if (newBuffer) newBuffer->setSceneScale(sceneScale);
 				}
 				else
 					newBuffer = FrameBuffer::createDefault(name);
@@ -320,6 +331,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadShaderPrograms(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadShaderPrograms] Loading Shader programs");
@@ -353,11 +366,6 @@ namespace Engine
 				// Build
 				newShader->build(vArray, vertexShader.c_str(), fragmentShader.c_str(), geometryShader.c_str(), tessControlShader.c_str(), tessEvaluationShader.c_str());
 
-				// Get and set all uniforms
-				std::vector<std::string> uniforms;
-				for (auto& uniform : shader["uniforms"])
-					uniforms.push_back(uniform.get<std::string>());
-
 				std::unordered_map<std::string, UniformBuffer*> ubos;
 				for (int i = 0; i < shader["uniformBuffers"].size();)
 				{
@@ -369,8 +377,9 @@ namespace Engine
 					i += 2;
 				}
 
-				newShader->setUniforms(uniforms);
 				newShader->setUniformBuffers(ubos);
+				// The uniforms listed are no longer looked up by name, but the list is still checked against what the program exposes
+				newShader->getReflection().validate(shader, name);
 				newShader->setOrderImportance(shader["orderImportance"].get<uint32_t>());
 
 				// Register shader with resource manager
@@ -388,18 +397,38 @@ namespace Engine
 	*/
 	void ResourceLoader::loadTextures(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadTextures] Loading Textures");
 
-		// Go through each 2D texture and load it
+		/*! \struct PendingTexture
+		* \brief A texture waiting for its images to be loaded
+		*/
+		struct PendingTexture
+		{
+			std::string Name; //!< The name of the texture
+			std::string Path; //!< The file or folder the texture is loaded from
+			TextureProperties Properties; //!< The properties of a 2D texture
+			size_t FirstJob; //!< The index of the texture's first load job
+			bool Atlas; //!< Is the 2D texture atlased
+		};
+
+		// Every image is decoded by the texture cooker's workers first, then the textures are created on this thread
+		std::vector<TextureLoadJob> jobs;
+		std::vector<PendingTexture> textures2D;
+		std::vector<PendingTexture> cubeMaps;
+		std::unordered_set<std::string> pendingNames;
+
+		// Go through each 2D texture and queue it
 		for (auto& texture : jsonData["textures2D"])
 		{
 			// Get the texture name
 			std::string name = texture["name"].get<std::string>();
 
 			// Check if it exists
-			if (!ResourceManager::resourceExists(name))
+			if (!ResourceManager::resourceExists(name) && pendingNames.insert(name).second)
 			{
 				// Fill texture properties
 				// [Width], [Height], [WrapS], [WrapT], [WrapR], [MinFilter], [MaxFilter], [gammaCorrect], [FlipUVs]
@@ -410,40 +439,99 @@ namespace Engine
 
 				// Check if we're loading an image from file
 				std::string filePath = texture["filePath"].get<std::string>().c_str();
-				Texture2D* newTexture;
 
-				// Either load an image into the texture or just leave texture blank
-				if (filePath != "")
-					newTexture = Texture2D::create(name, texture["filePath"].get<std::string>().c_str(), properties);
-				else
-					newTexture = Texture2D::create(name, properties, texture["channels"], nullptr);
+				// A blank texture has nothing to load
+				if (filePath == "")
+				{
+					Texture2D* newTexture = Texture2D::create(name, properties, texture["channels"], nullptr);
+					ResourceManager::registerResource(name, newTexture);
+					ENGINE_TRACE("Loaded {0} from {1}.", name, filePath);
+					continue;
+				}
 
-				// Register texture with resource manager
-				ResourceManager::registerResource(name, newTexture);
-				ENGINE_TRACE("Loaded {0} from {1}.", name, filePath);
+				// Small 2D textures can be packed into an atlas page once every texture file has been loaded
+				glm::ivec2 size;
+				const bool atlas = texture.contains("atlas") && texture["atlas"].get<bool>() && TextureCooker::getSize(filePath, size) && TextureAtlasBuilder::accepts(name, size, properties);
+
+				TextureLoadJob job;
+				job.FilePath = filePath;
+				job.Settings.FlipUVs = properties.FlipUVs;
+				job.Settings.ForceRGBA = atlas;
+				job.Settings.GenerateMips = !atlas;
+				job.Settings.Compress = !atlas && TextureCooker::shouldCompress() && (!texture.contains("compress") || texture["compress"].get<bool>());
+
+				textures2D.push_back({ name, filePath, properties, jobs.size(), atlas });
+				jobs.push_back(std::move(job));
 			}
 			else
 				ENGINE_ERROR("[ResourceLoader::loadTextures] Resource name already taken. Name: {0}", name);
 		}
 
-		// Go through each texture for cubemap and load it
+		// Go through each texture for cubemap and queue its faces
 		for (auto& texture : jsonData["cubeMaps"])
 		{
 			// Get the texture name
 			std::string name = texture["name"].get<std::string>();
 			// Check if it exists
-			if (!ResourceManager::resourceExists(name))
+			if (!ResourceManager::resourceExists(name) && pendingNames.insert(name).second)
 			{
-				// Create new cubemap texture
-				CubeMapTexture* newTexture = CubeMapTexture::create(name, texture["folderPath"].get<std::string>().c_str(), texture["fileType"].get<std::string>().c_str());
+				const std::string folderPath = texture["folderPath"].get<std::string>();
+				const std::string fileType = texture["fileType"].get<std::string>();
 
-				// Register texture with resource manager
-				ResourceManager::registerResource(name, newTexture);
-				ENGINE_TRACE("Loaded {0} from {1}.", name, filePath);
+				cubeMaps.push_back({ name, folderPath, TextureProperties(), jobs.size(), false });
+				for (auto& face : { "right", "left", "top", "bottom", "front", "back" })
+				{
+					TextureLoadJob job;
+					job.FilePath = folderPath + face + fileType;
+					job.Settings.GenerateMips = false;
+					jobs.push_back(std::move(job));
+				}
 			}
 			else
 				ENGINE_ERROR("[ResourceLoader::loadTextures] Resource name already taken. Name: {0}", name);
 		}
+
+		TextureCooker::loadAll(jobs);
+
+		// Create the 2D textures, any image which failed to load has already been reported
+		for (auto& texture : textures2D)
+		{
+			TextureLoadJob& job = jobs[texture.FirstJob];
+			if (!job.Loaded) continue;
+
+			if (texture.Atlas)
+			{
+				TextureAtlasBuilder::add(texture.Name, job.Image);
+				ENGINE_TRACE("Read {0} from {1} to be atlased.", texture.Name, texture.Path);
+			}
+			else
+			{
+				// Register texture with resource manager
+				Texture2D* newTexture = Texture2D::create(texture.Name, texture.Properties, job.Image);
+				ResourceManager::registerResource(texture.Name, newTexture);
+				ENGINE_TRACE("Loaded {0} from {1}.", texture.Name, texture.Path);
+			}
+			job.Image = TextureImage();
+		}
+
+		// Create the cubemaps from their six faces
+		for (auto& texture : cubeMaps)
+		{
+			std::vector<TextureImage> faces;
+			for (size_t i = texture.FirstJob; i < texture.FirstJob + 6 && jobs[i].Loaded; i++)
+				faces.push_back(std::move(jobs[i].Image));
+
+			if (faces.size() != 6)
+			{
+				ENGINE_ERROR("[ResourceLoader::loadTextures] Could not load the cubemap from folder: {0}", texture.Path);
+				continue;
+			}
+
+			// Register texture with resource manager
+			CubeMapTexture* newTexture = CubeMapTexture::create(texture.Name, texture.Path, faces);
+			ResourceManager::registerResource(texture.Name, newTexture);
+			ENGINE_TRACE("Loaded {0} from {1}.", texture.Name, texture.Path);
+		}
 	}
 
 	//! loadSubTextures()
@@ -452,6 +540,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadSubTextures(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadSubTextures] Loading Subtextures");
@@ -467,8 +557,24 @@ namespace Engine
 			{
 				// Get the base texture name
 				Texture2D* baseTexture = ResourceManager::getResource<Texture2D>(subTexture["baseTextureName"].get<std::string>());
+				glm::vec2 UVStart(subTexture["UVStart"][0], subTexture["UVStart"][1]);
+				glm::vec2 UVEnd(subTexture["UVEnd"][0], subTexture["UVEnd"][1]);
+				const bool convertToBottomLeft = subTexture["ConvertBottomLeft"].get<bool>();
+
+				// The UVs of a subtexture of an atlased texture are moved into the texture's region of its atlas page
+				AtlasRegion region;
+				const bool atlased = TextureAtlasBuilder::getRegion(subTexture["baseTextureName"].get<std::string>(), region);
+				if (atlased)
+				{
+					baseTexture = region.Page;
+					UVStart = region.UVStart + (UVStart * (region.UVEnd - region.UVStart));
+					UVEnd = region.UVStart + (UVEnd * (region.UVEnd - region.UVStart));
 
-				if (subTexture["baseTextureName"].get<std::string>() == "refractionTexture")
+					// Converting flips the subtexture's own rect, which now lies in the texture's region
+					if (convertToBottomLeft)
+						std::swap(UVStart.y, UVEnd.y);
+				}
+				else if (subTexture["baseTextureName"].get<std::string>() == "refractionTexture")
 					baseTexture = ResourceManager::getResource<FrameBuffer>("refractionFBO")->getSampledTarget("Colour0");
 				else if (subTexture["baseTextureName"].get<std::string>() == "reflectionTexture")
 						baseTexture = ResourceManager::getResource<FrameBuffer>("reflectionFBO")->getSampledTarget("Colour0");
@@ -480,7 +586,7 @@ namespace Engine
 				{
 					// Create new subtexture
 					// [Texture], [UVStart], [UVEnd]
-					SubTexture* newSubTexture = new SubTexture(name, baseTexture, { subTexture["UVStart"][0], subTexture["UVStart"][1] }, { subTexture["UVEnd"][0], subTexture["UVEnd"][1] }, subTexture["ConvertBottomLeft"].get<bool>());
+					SubTexture* newSubTexture = new SubTexture(name, baseTexture, UVStart, UVEnd, convertToBottomLeft && !atlased);
 
 					// Register subTexture with resource manager
 					ResourceManager::registerResource(name, newSubTexture);
@@ -500,6 +606,8 @@ namespace Engine
 	*/
 	void ResourceLoader::load3DModels(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::load3DModels] Loading 3D Models");
@@ -517,10 +625,10 @@ namespace Engine
 				// Model name doesn't exist, we can use it. Now let's load the model
 				Model3D* newModel = new Model3D(name);
 
-				// We will use ASSIMP to read the model file
+				// We will use ASSIMP to read the model file, unless it has already been cooked
 				if (model["modelFilePath"].get<std::string>() != "")
 				{
-					AssimpLoader::loadModel(model["modelFilePath"].get<std::string>(), newModel->getMeshes());
+					MeshCooker::load(model["modelFilePath"].get<std::string>(), newModel->getMeshes());
 				}
 
 				if (newModel->getMeshes().size() == 0)
@@ -565,6 +673,8 @@ namespace Engine
 	*/
 	void ResourceLoader::loadMaterials(const std::string& filePath)
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		nlohmann::json jsonData = ResourceManager::getJSON(filePath);
 
 		ENGINE_INFO("[ResourceLoader::loadMaterials] Loading Materials");
@@ -632,6 +742,8 @@ namespace Engine
 	//! uploadModels()
 	void ResourceLoader::uploadModels()
 	{
+		ENGINE_PROFILE_FUNCTION();
+
 		auto modelList = ResourceManager::getResourcesOfType<Model3D>(ResourceType::Model3D);
 
 		for (auto& model : modelList)
@@ -639,17 +751,16 @@ namespace Engine
 			auto& meshList = model->getMeshes();
 			for (auto& mesh : meshList)
 			{
-				// Create a piece of geometry using local vertices and indices information
+				// Create a piece of geometry using local vertices and indices information, or the mapped cooked mesh's
 				Geometry3D geometry;
 				geometry.VertexBuffer = ResourceManager::getResource<VertexBuffer>("Vertex3DBuffer");
-				Renderer3D::addGeometry(mesh.getVertices(), mesh.getIndices(), geometry);
+				Renderer3D::addGeometry(mesh.getVertexData(), mesh.getVertexCount(), mesh.getIndexData(), mesh.getIndexCount(), geometry);
 
 				if (geometry.VertexCount == 0)
 					ENGINE_ERROR("[AssimpLoader::processMesh] Vertices were not uploaded to the vertex buffer correctly.");
 
 				mesh.getGeometryRef() = geometry;
-				mesh.getVertices().clear();
-				mesh.getIndices().clear();
+				mesh.releaseData();
 				ENGINE_TRACE("Uploaded mesh: {0}.", model->getName());
 			}
 		}
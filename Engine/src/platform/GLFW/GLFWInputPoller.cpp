@@ -12,36 +12,6 @@
 
 namespace Engine
 {
-	//! isAnyKeyPressed()
-	/*!
-	\return a std::vector<uint32_t> - A list of all keys currently pressed
-	*/
-	std::vector<uint32_t> GLFWInputPoller::isAnyKeyPressed()
-	{
-		// Check each key if its currently pressed and add it to the key list if it is
-		std::vector<uint32_t> keysPressed;
-		for (int i = 32; i < 349; i++)
-			if (isKeyPressed(i))
-				keysPressed.push_back(i);
-
-		return keysPressed;
-	}
-
-	//! isAnyMouseButtonPressed()
-	/*!
-	\return a std::vector<uint32_t> - A list of all mouse buttons currently pressed
-	*/
-	std::vector<uint32_t> GLFWInputPoller::isAnyMouseButtonPressed()
-	{
-		// Check each mouse button if its currently pressed and add it to the mouse list if it is
-		std::vector<uint32_t> mouseButtonsPressed;
-		for (int i = 0; i < 3; i++)
-			if (isMousePressed(i))
-				mouseButtonsPressed.push_back(i);
-		
-		return mouseButtonsPressed;
-	}
-
 	//! isKeyPressed()
 	/*!
 	\param keyCode a const int32_t - The key pressed
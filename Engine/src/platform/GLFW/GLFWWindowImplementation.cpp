@@ -9,6 +9,7 @@
 #include "platform/GLFW/GLFWGLGraphicsContext.h"
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/eventManager.h"
+#include "independent/systems/systems/inputManager.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -174,20 +175,19 @@ namespace Engine
 	{
 #ifndef ENGINETESTS
 		// Set all GLFW callback functions needed
+		// Events are queued with the event manager and dispatched once per frame
 
 		glfwSetWindowCloseCallback(m_native,
 			[](GLFWwindow* window)
 		{
-			WindowCloseEvent e;
-			EventManager::onWindowClose(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::WindowClose);
 		}
 		);
 
 		glfwSetWindowSizeCallback(m_native,
 			[](GLFWwindow* window, int newWidth, int newHeight)
 		{
-			WindowResizeEvent e(newWidth, newHeight);
-			EventManager::onWindowResize(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::WindowResize, { newWidth, newHeight });
 		}
 		);
 
@@ -195,34 +195,38 @@ namespace Engine
 			[](GLFWwindow* window, int focused)
 		{
 			if (focused)
-			{
-				WindowFocusEvent e;
-				EventManager::onWindowFocus(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
-			}
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::WindowFocus);
 			else
-			{
-				WindowLostFocusEvent e;
-				EventManager::onWindowLostFocus(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
-			}
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::WindowLostFocus);
 		}
 		);
 
 		glfwSetWindowPosCallback(m_native,
 			[](GLFWwindow* window, int xpos, int ypos)
 		{
-			WindowMovedEvent e(xpos, ypos);
-			EventManager::onWindowMoved(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::WindowMoved, { xpos, ypos });
 		}
 		);
 
 		glfwSetKeyCallback(m_native,
 			[](GLFWwindow* window, int key, int scancode, int action, int mods)
 		{
-			if (action == GLFW_RELEASE)
+			if (action == GLFW_PRESS)
+			{
+				// Key is pressed
+				InputManager::setKeyState(key, true);
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::KeyPressed, { key, 0 });
+			}
+			else if (action == GLFW_REPEAT)
+			{
+				// Key is being held and the OS has sent a repeat
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::KeyPressed, { key, 1 });
+			}
+			else if (action == GLFW_RELEASE)
 			{
 				// Key is released
-				KeyReleasedEvent e(key);
-				EventManager::onKeyReleased(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+				InputManager::setKeyState(key, false);
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::KeyReleased, { key, 0 });
 			}
 		}
 		);
@@ -230,18 +234,22 @@ namespace Engine
 		glfwSetCharCallback(m_native,
 			[](GLFWwindow* window, unsigned int codepoint)
 		{
-			KeyTypedEvent e(codepoint);
-			EventManager::onKeyTyped(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::KeyTyped, { codepoint, 0 });
 		}
 		);
 
 		glfwSetMouseButtonCallback(m_native,
 			[](GLFWwindow* window, int button, int action, int mods)
 		{
-			if (action == GLFW_RELEASE)
+			if (action == GLFW_PRESS)
+			{
+				InputManager::setMouseButtonState(button, true);
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::MousePressed, { button, 0 });
+			}
+			else if (action == GLFW_RELEASE)
 			{
-				MouseReleasedEvent e(button);
-				EventManager::onMouseReleased(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+				InputManager::setMouseButtonState(button, false);
+				EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::MouseReleased, { button, 0 });
 			}
 		}
 		);
@@ -249,16 +257,14 @@ namespace Engine
 		glfwSetCursorPosCallback(m_native,
 			[](GLFWwindow* window, double xpos, double ypos)
 		{
-			MouseMovedEvent e(static_cast<float>(xpos), static_cast<float>(ypos));
-			EventManager::onMouseMoved(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::MouseMoved, { xpos, ypos });
 		}
 		);
 
 		glfwSetScrollCallback(m_native,
 			[](GLFWwindow* window, double xoffset, double yoffset)
 		{
-			MouseScrolledEvent e(static_cast<float>(xoffset), static_cast<float>(yoffset));
-			EventManager::onMouseScrolled(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), e);
+			EventManager::queueEvent(static_cast<GLFWWindowImplementation*>(glfwGetWindowUserPointer(window)), EventType::MouseScrolled, { xoffset, yoffset });
 		}
 		);
 
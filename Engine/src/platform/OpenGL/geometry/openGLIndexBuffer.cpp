@@ -9,6 +9,7 @@
 #include "platform/OpenGL/geometry/openGLIndexBuffer.h"
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -57,6 +58,7 @@ namespace Engine
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
 		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint32_t), size * sizeof(uint32_t), indices);
+		CounterSystem::increment(Counter::IndexBytesUploaded, size * sizeof(uint32_t));
 	}
 
 	//! bind()
@@ -9,6 +9,7 @@
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "platform/OpenGL/geometry/OpenGLVertexBuffer.h"
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -24,6 +25,7 @@ namespace Engine
 		{
 		case VertexBufferUsage::StaticDraw:    return GL_STATIC_DRAW;
 		case VertexBufferUsage::DynamicDraw:   return GL_DYNAMIC_DRAW;
+		case VertexBufferUsage::StreamDraw:    return GL_STREAM_DRAW;
 		}
 		return 0;
 	}
@@ -93,7 +95,13 @@ namespace Engine
 
 		// Edit the buffer contents
 		bind();
+
+		// A streamed buffer is rewritten from the start every flush, so give the driver new storage rather than waiting on a draw still reading the old data
+		if (m_usage == VertexBufferUsage::StreamDraw && offset == 0)
+			glBufferData(GL_ARRAY_BUFFER, m_byteSize, nullptr, GL_STREAM_DRAW);
+
 		glBufferSubData(GL_ARRAY_BUFFER, offset, size, vertices);
+		CounterSystem::increment(Counter::VertexBytesUploaded, size);
 	}
 
 	//! bind()
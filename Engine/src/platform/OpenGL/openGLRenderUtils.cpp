@@ -9,6 +9,7 @@
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/log.h"
 #include <glad/glad.h>
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -314,10 +315,30 @@ namespace Engine
 		else
 			glDrawElements(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, nullptr);
 
+		CounterSystem::increment(Counter::DrawCalls);
+
 		if (ResourceManager::getConfigValue(Config::PrintOpenGLDebugMessages))
 			ENGINE_TRACE("[OpenGLRenderUtils::draw] Drawing elements. Count: {0}.", drawCount);
 	}
 
+	//! drawInstanced()
+	/*!
+	\param drawCount a const uint32_t - The number of indices
+	\param instanceCount a const uint32_t - The number of instances
+	*/
+	void OpenGLRenderUtils::drawInstanced(const uint32_t drawCount, const uint32_t instanceCount)
+	{
+		if (s_patchDrawing)
+			glDrawElementsInstanced(GL_PATCHES, drawCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+		else
+			glDrawElementsInstanced(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+
+		CounterSystem::increment(Counter::DrawCalls);
+
+		if (ResourceManager::getConfigValue(Config::PrintOpenGLDebugMessages))
+			ENGINE_TRACE("[OpenGLRenderUtils::drawInstanced] Drawing instanced elements. Count: {0}, Instances: {1}.", drawCount, instanceCount);
+	}
+
 	//! drawMultiIndirect()
 	/*!
 	\param commandsSize a const uint32_t - The number of commands
@@ -329,6 +350,9 @@ namespace Engine
 		else
 			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (GLvoid*)0, commandsSize, 0);
 
+		CounterSystem::increment(Counter::DrawCalls);
+		CounterSystem::increment(Counter::DrawCommands, commandsSize);
+
 		if (ResourceManager::getConfigValue(Config::PrintOpenGLDebugMessages))
 			ENGINE_TRACE("[OpenGLRenderUtils::drawMultiIndirect] Drawing multi elements. Count: {0}.", commandsSize);
 	}
@@ -10,6 +10,7 @@
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/rendering/shaders/shaderProgram.h"
 #include <glad/glad.h>
+#include "independent/systems/systems/counterSystem.h"
 
 namespace Engine
 {
@@ -72,6 +73,7 @@ namespace Engine
 		auto& pair = m_uniformCache[uniformName];
 		glBindBuffer(GL_UNIFORM_BUFFER, m_bufferID);
 		glBufferSubData(GL_UNIFORM_BUFFER, pair.first, pair.second, data);
+		CounterSystem::increment(Counter::UniformBytesUploaded, pair.second);
 		if (ResourceManager::getConfigValue(Config::PrintOpenGLDebugMessages)) ENGINE_TRACE("OpenGLUniformBuffer::uploadData] Uploading {0} bytes to {1} from offset: {2}.", pair.second, m_name, pair.first);
 	}
 
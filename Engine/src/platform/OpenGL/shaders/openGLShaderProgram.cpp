@@ -9,24 +9,25 @@
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "platform/OpenGL/shaders/openGLShaderProgram.h"
+#include "independent/rendering/shaders/shaderPreprocessor.h"
+#include "independent/rendering/shaders/shaderCache.h"
 
 namespace Engine
 {
 	//! constructShaders()
 	/*!
 	\param shaderType a const int - The OpenGL shader type
-	\param filePath a const char* - The file path to the shader to be constructed
+	\param source a const std::string& - The preprocessed source code
+	\param filePath a const std::string& - The file path the source was read from, for the log
 	\return an int32_t - The shader object ID
 	*/
-	uint32_t OpenGLShaderProgram::constructShaders(const int shaderType, const char* filePath)
+	uint32_t OpenGLShaderProgram::constructShaders(const int shaderType, const std::string& source, const std::string& filePath)
 	{
 		uint32_t shaderID;
 		// Create shader by type
 		shaderID = glCreateShader(shaderType);
-		// Get the source code from file
-		std::string srcCode = ResourceManager::getContents(filePath);
 		// Convert to char*
-		const char* srcCodeChar = srcCode.c_str();
+		const char* srcCodeChar = source.c_str();
 
 		// Upload source and compile
 		glShaderSource(shaderID, 1, &srcCodeChar, NULL);
@@ -49,6 +50,133 @@ namespace Engine
 		return shaderID;
 	}
 
+	//! loadBinary()
+	/*!
+	\param key a const uint64_t - The key of the preprocessed sources
+	\return a const bool - Was a cached binary accepted by the driver
+	*/
+	const bool OpenGLShaderProgram::loadBinary(const uint64_t key)
+	{
+		uint32_t format = 0;
+		std::vector<uint8_t> binary;
+		if (!ShaderCache::load(key, format, binary)) return false;
+
+		m_programID = glCreateProgram();
+		glProgramBinary(m_programID, static_cast<GLenum>(format), binary.data(), static_cast<GLsizei>(binary.size()));
+
+		// A driver update can refuse an old binary, then the program is built from source and cached again
+		GLint success;
+		glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glDeleteProgram(m_programID);
+			m_programID = 0;
+			ShaderCache::remove(key);
+			return false;
+		}
+
+		return true;
+	}
+
+	//! saveBinary()
+	/*!
+	\param key a const uint64_t - The key of the preprocessed sources
+	*/
+	void OpenGLShaderProgram::saveBinary(const uint64_t key)
+	{
+		GLint length = 0;
+		glGetProgramiv(m_programID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) return;
+
+		GLenum format = 0;
+		std::vector<uint8_t> binary(static_cast<size_t>(length));
+		glGetProgramBinary(m_programID, length, nullptr, &format, binary.data());
+		ShaderCache::save(key, static_cast<uint32_t>(format), binary);
+	}
+
+	//! reflect()
+	void OpenGLShaderProgram::reflect()
+	{
+		m_reflection.clear();
+
+		GLint uniformCount = 0;
+		GLint blockCount = 0;
+		GLchar name[256];
+		glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+		// Samplers keep their texture units for the life of the program, so they are set now instead of on every draw
+		glUseProgram(m_programID);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			// Members of uniform blocks are set through their uniform buffer
+			GLuint index = static_cast<GLuint>(i);
+			GLint blockIndex = -1;
+			glGetActiveUniformsiv(m_programID, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+			if (blockIndex != -1) continue;
+
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_programID, index, sizeof(name), nullptr, &size, &type, name);
+
+			ShaderUniform uniform;
+			uniform.Location = glGetUniformLocation(m_programID, name);
+			uniform.Count = static_cast<uint32_t>(size);
+			// Arrays are reported as name[0]
+			uniform.Name = name;
+			const size_t bracket = uniform.Name.find('[');
+			if (bracket != std::string::npos) uniform.Name.erase(bracket);
+
+			switch (type)
+			{
+				case GL_FLOAT: uniform.Type = ShaderDataType::Float; break;
+				case GL_FLOAT_VEC2: uniform.Type = ShaderDataType::Float2; break;
+				case GL_FLOAT_VEC3: uniform.Type = ShaderDataType::Float3; break;
+				case GL_FLOAT_VEC4: uniform.Type = ShaderDataType::Float4; break;
+				case GL_FLOAT_MAT3: uniform.Type = ShaderDataType::Mat3; break;
+				case GL_FLOAT_MAT4: uniform.Type = ShaderDataType::Mat4; break;
+				case GL_INT: uniform.Type = ShaderDataType::Int; break;
+				case GL_INT_VEC2: uniform.Type = ShaderDataType::Int2; break;
+				case GL_INT_VEC3: uniform.Type = ShaderDataType::Int3; break;
+				case GL_INT_VEC4: uniform.Type = ShaderDataType::Int4; break;
+				case GL_BOOL: uniform.Type = ShaderDataType::Bool; break;
+				case GL_SAMPLER_2D:
+				case GL_SAMPLER_CUBE:
+				case GL_SAMPLER_2D_ARRAY:
+				case GL_SAMPLER_3D:
+				case GL_SAMPLER_2D_SHADOW:
+					uniform.Type = ShaderDataType::Int;
+					uniform.Sampler = true;
+					break;
+				default: uniform.Type = ShaderDataType::None; break;
+			}
+
+			if (uniform.Sampler)
+			{
+				std::vector<int32_t> units(uniform.Count);
+				for (uint32_t unit = 0; unit < uniform.Count; unit++)
+					units[unit] = static_cast<int32_t>(unit);
+				glUniform1iv(uniform.Location, static_cast<GLsizei>(uniform.Count), units.data());
+			}
+
+			m_reflection.addUniform(uniform);
+		}
+		glUseProgram(0);
+
+		for (GLint i = 0; i < blockCount; i++)
+		{
+			GLint size = 0;
+			glGetActiveUniformBlockName(m_programID, static_cast<GLuint>(i), sizeof(name), nullptr, name);
+			glGetActiveUniformBlockiv(m_programID, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+
+			ShaderBlock block;
+			block.Name = name;
+			block.Index = static_cast<uint32_t>(i);
+			block.Size = static_cast<uint32_t>(size);
+			m_reflection.addBlock(block);
+		}
+	}
+
 	//! OpenGLShaderProgram()
 	/*
 	\param shaderName a const std::string& - The name of the shader program
@@ -83,30 +211,57 @@ namespace Engine
 
 		if (vertexArray) m_vertexArray = vertexArray;
 
-		// Create the shader objects by providing path
-		// buildShader creates, loads src code, compiles and returns id
-		GLuint VertexID = constructShaders(GL_VERTEX_SHADER, vertexPath.c_str());
-		GLuint FragmentID = constructShaders(GL_FRAGMENT_SHADER, fragmentPath.c_str());
-		GLuint GeometryID;
-		GLuint TessControlID;
-		GLuint TessEvaluationID;
-		// Only do geometry shader if file was provided
-		if (geometryPath != "") { GeometryID = constructShaders(GL_GEOMETRY_SHADER, geometryPath.c_str()); }
-		// Only do tess control shader if file was provided
-		if (tessControlPath != "") { TessControlID = constructShaders(GL_TESS_CONTROL_SHADER, tessControlPath.c_str()); }
-		// Only do tess evaluation shader if file was provided
-		if (tessEvalPath != "") { TessEvaluationID = constructShaders(GL_TESS_EVALUATION_SHADER, tessEvalPath.c_str()); }
-
-		// Create the program
+		m_vertexPath = vertexPath;
+		m_fragmentPath = fragmentPath;
+		m_geometryPath = geometryPath;
+		m_tessellationControlPath = tessControlPath;
+		m_tessellationEvalPath = tessEvalPath;
+
+		// Stages without a file are left empty
+		const uint32_t stageCount = 5;
+		const GLenum stageTypes[stageCount] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER };
+		const std::string* stagePaths[stageCount] = { &vertexPath, &fragmentPath, &geometryPath, &tessControlPath, &tessEvalPath };
+		std::string sources[stageCount];
+
+		// The key covers the driver, the permutation and every preprocessed stage, so a change to any of them builds the program again
+		const ShaderDefines defines = ShaderPreprocessor::getDefines();
+		uint64_t key = ShaderPreprocessor::hash(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+		key = ShaderPreprocessor::hash(reinterpret_cast<const char*>(glGetString(GL_VERSION)), key);
+		key = ShaderPreprocessor::hash(ShaderPreprocessor::getPermutationKey(defines), key);
+		for (uint32_t i = 0; i < stageCount; i++)
+		{
+			if (stagePaths[i]->empty()) continue;
+
+			if (!ShaderPreprocessor::process(*stagePaths[i], defines, sources[i]))
+				ENGINE_ERROR("[OpenGLShaderProgram::build] Cannot preprocess shader with file path: {0}", *stagePaths[i]);
+
+			key = ShaderPreprocessor::hash(std::to_string(stageTypes[i]) + sources[i], key);
+		}
+
+		// A warm start takes the linked binary straight from the cache
+		if (loadBinary(key))
+		{
+			reflect();
+			return;
+		}
+
+		// Create the shader objects from the preprocessed sources
+		GLuint stageIDs[stageCount] = { 0, 0, 0, 0, 0 };
+		for (uint32_t i = 0; i < stageCount; i++)
+		{
+			if (!stagePaths[i]->empty())
+				stageIDs[i] = constructShaders(stageTypes[i], sources[i], *stagePaths[i]);
+		}
+
+		// Create the program and attach the shader objects which exist
 		m_programID = glCreateProgram();
-		// Attach shader objects, add geometry, tess control and tess eval if they exist
-		glAttachShader(m_programID, VertexID);
-		glAttachShader(m_programID, FragmentID);
-		if (geometryPath != "") { glAttachShader(m_programID, GeometryID); }
-		if (tessControlPath != "") { glAttachShader(m_programID, TessControlID); }
-		if (tessEvalPath != "") { glAttachShader(m_programID, TessEvaluationID); }
-
-		// Link
+		for (uint32_t i = 0; i < stageCount; i++)
+		{
+			if (stageIDs[i] != 0) glAttachShader(m_programID, stageIDs[i]);
+		}
+
+		// Link, keeping the binary retrievable for the cache
+		if (ShaderCache::isEnabled()) glProgramParameteri(m_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(m_programID);
 
 		// Get link status
@@ -120,42 +275,16 @@ namespace Engine
 			ENGINE_ERROR("[OpenGLShaderProgram::build] Cannot link program: {0}", infoLog);
 			glDeleteProgram(m_programID);
 		}
-		// Shader objects no longer needed as linked with program, delete
-		glDeleteShader(VertexID);
-		glDeleteShader(FragmentID);
-		if (geometryPath != "")
-			glDeleteShader(GeometryID);
-
-		if (tessControlPath != "")
-			glDeleteShader(TessControlID);
-
-		if (tessEvalPath != "")
-			glDeleteShader(TessEvaluationID);
-
-		m_vertexPath = vertexPath;
-		m_fragmentPath = fragmentPath;
-		m_geometryPath = geometryPath;
-		m_tessellationControlPath = tessControlPath;
-		m_tessellationEvalPath = tessEvalPath;
-	}
+		else
+		{
+			reflect();
+			saveBinary(key);
+		}
 
-	//! setUniforms()
-	/*!
-	\param uniformNames a const std::vector<std::string>& - All uniform names
-	*/
-	void OpenGLShaderProgram::setUniforms(const std::vector<std::string>& uniformNames)
-	{
-		// Get all uniform locations and store results
-		for (auto& name : uniformNames)
+		// Shader objects no longer needed as linked with program, delete
+		for (uint32_t i = 0; i < stageCount; i++)
 		{
-			uint32_t uniformLocation = glGetUniformLocation(m_programID, name.c_str());
-			if (uniformLocation == -1)
-			{
-				// Cannot find location so send error message
-				ENGINE_ERROR("[OpenGLShaderProgram::setUniforms] Uniform with name: {0} cannot be found in program with id: {1}", name, m_programID);
-			}
-			else
-				m_uniforms[name] = uniformLocation;
+			if (stageIDs[i] != 0) glDeleteShader(stageIDs[i]);
 		}
 	}
 
@@ -166,6 +295,19 @@ namespace Engine
 	void OpenGLShaderProgram::setUniformBuffers(const std::unordered_map<std::string, UniformBuffer*>& uniformBuffers)
 	{
 		m_uniformBuffers = uniformBuffers;
+
+		// Every buffer keeps its own binding point, so each block only has to be pointed at it once
+		for (auto& buffer : m_uniformBuffers)
+		{
+			ShaderBlock* block = m_reflection.getBlock(buffer.first);
+			if (!block)
+				ENGINE_ERROR("[OpenGLShaderProgram::setUniformBuffers] Cannot find the uniform block in the shader program. Shader Name: {0}, Block name: {1}", m_name, buffer.first);
+			else if (buffer.second)
+			{
+				glUniformBlockBinding(m_programID, block->Index, buffer.second->getBlockNumber());
+				block->Binding = static_cast<int32_t>(buffer.second->getBlockNumber());
+			}
+		}
 	}
 
 	//! start()
@@ -190,102 +332,102 @@ namespace Engine
 
 	//! uploadInt()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const int - The uniform value
 	*/
-	void OpenGLShaderProgram::sendInt(const std::string& uniformName, const int value)
+	void OpenGLShaderProgram::sendInt(const int32_t handle, const int value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform1i(m_uniforms.at(uniformName), value);
+		if (handle != -1)
+			glUniform1i(handle, value);
 	}
 
 	//! sendIntArray()
 	/*!<
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param values a int32_t* - The uniform values
 	\param count a const uint32_t - The number of elements
 	*/
-	void OpenGLShaderProgram::sendIntArray(const std::string& uniformName, int32_t* values, const uint32_t count)
+	void OpenGLShaderProgram::sendIntArray(const int32_t handle, int32_t* values, const uint32_t count)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform1iv(m_uniforms.at(uniformName), count, values);
+		if (handle != -1)
+			glUniform1iv(handle, count, values);
 	}
 
 	//! uploadBool()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const bool - The uniform value
 	*/
-	void OpenGLShaderProgram::sendBool(const std::string& uniformName, const bool value)
+	void OpenGLShaderProgram::sendBool(const int32_t handle, const bool value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform1i(m_uniforms.at(uniformName), (int)value);
+		if (handle != -1)
+			glUniform1i(handle, (int)value);
 	}
 
 	//! uploadFloat()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const float - The uniform value
 	*/
-	void OpenGLShaderProgram::sendFloat(const std::string& uniformName, const float value)
+	void OpenGLShaderProgram::sendFloat(const int32_t handle, const float value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform1f(m_uniforms.at(uniformName), value);
+		if (handle != -1)
+			glUniform1f(handle, value);
 	}
 
 	//! uploadVec2()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const glm::vec2& - The uniform value
 	*/
-	void OpenGLShaderProgram::sendVec2(const std::string& uniformName, const glm::vec2& value)
+	void OpenGLShaderProgram::sendVec2(const int32_t handle, const glm::vec2& value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform2fv(m_uniforms.at(uniformName), 1, &value[0]);
+		if (handle != -1)
+			glUniform2fv(handle, 1, &value[0]);
 	}
 
 	//! uploadVec3()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const glm::vec3& - The uniform value
 	*/
-	void OpenGLShaderProgram::sendVec3(const std::string& uniformName, const glm::vec3& value)
+	void OpenGLShaderProgram::sendVec3(const int32_t handle, const glm::vec3& value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform3fv(m_uniforms.at(uniformName), 1, &value[0]);
+		if (handle != -1)
+			glUniform3fv(handle, 1, &value[0]);
 	}
 
 	//! uploadVec4()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param value a const glm::vec4& - The uniform value
 	*/
-	void OpenGLShaderProgram::sendVec4(const std::string& uniformName, const glm::vec4& value)
+	void OpenGLShaderProgram::sendVec4(const int32_t handle, const glm::vec4& value)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniform4fv(m_uniforms.at(uniformName), 1, &value[0]);
+		if (handle != -1)
+			glUniform4fv(handle, 1, &value[0]);
 	}
 
 	//! uploadMat3()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param mat a const glm::mat3& - The uniform value
 	*/
-	void OpenGLShaderProgram::sendMat3(const std::string& uniformName, const glm::mat3& mat)
+	void OpenGLShaderProgram::sendMat3(const int32_t handle, const glm::mat3& mat)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniformMatrix3fv(m_uniforms.at(uniformName), 1, GL_FALSE, &mat[0][0]);
+		if (handle != -1)
+			glUniformMatrix3fv(handle, 1, GL_FALSE, &mat[0][0]);
 	}
 
 	//! uploadMat4()
 	/*!
-	\param uniformName a const std::string& - The uniform name
+	\param handle a const int32_t - The uniform handle
 	\param mat a const glm::mat4& - The uniform value
 	*/
-	void OpenGLShaderProgram::sendMat4(const std::string& uniformName, const glm::mat4& mat)
+	void OpenGLShaderProgram::sendMat4(const int32_t handle, const glm::mat4& mat)
 	{
-		if (m_uniforms.find(uniformName) != m_uniforms.end())
-			glUniformMatrix4fv(m_uniforms.at(uniformName), 1, GL_FALSE, &mat[0][0]);
+		if (handle != -1)
+			glUniformMatrix4fv(handle, 1, GL_FALSE, &mat[0][0]);
 	}
 
 	//! printDetails()
@@ -299,8 +441,11 @@ namespace Engine
 		ENGINE_TRACE("Tessellation Control Path: {0}.", m_tessellationControlPath);
 		ENGINE_TRACE("Tessellation Evaluation Path: {0}.", m_tessellationEvalPath);
 
-		for (auto& uniform : m_uniforms)
-			ENGINE_TRACE("Uniform: {0}, Location: {1}.", uniform.first, uniform.second);
+		for (auto& uniform : m_reflection.getUniforms())
+			ENGINE_TRACE("Uniform: {0}, Location: {1}, Count: {2}, Sampler: {3}.", uniform.Name, uniform.Location, uniform.Count, uniform.Sampler);
+
+		for (auto& block : m_reflection.getBlocks())
+			ENGINE_TRACE("Uniform Block: {0}, Index: {1}, Binding: {2}, Size: {3}.", block.Name, block.Index, block.Binding, block.Size);
 
 		if (m_vertexArray)
 			ENGINE_TRACE("VertexArray: {0}", m_vertexArray->getName());
@@ -9,10 +9,17 @@
 #include "independent/systems/systems/log.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "platform/OpenGL/textures/openGLTexture.h"
+#include "independent/rendering/textures/textureCooker.h"
 #include <stb_image.h>
 
 namespace Engine
 {
+	// The S3TC formats are an extension glad was not generated with
+	static const GLenum CompressedRGBDXT1 = 0x83F0; //!< GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	static const GLenum CompressedRGBADXT5 = 0x83F3; //!< GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	static const GLenum CompressedSRGBDXT1 = 0x8C4C; //!< GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	static const GLenum CompressedSRGBADXT5 = 0x8C4F; //!< GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+
 	//! toGLType()
 	/*!
 	\param type a const TextureParameter - The parameter type
@@ -59,11 +66,74 @@ namespace Engine
 			return "RGBA16F";
 		case GL_DEPTH_COMPONENT:
 			return "Depth";
+		case GL_SRGB:
+			return "SRGB";
+		case GL_SRGB_ALPHA:
+			return "SRGBA";
+		case CompressedRGBDXT1:
+			return "BC1";
+		case CompressedRGBADXT5:
+			return "BC3";
+		case CompressedSRGBDXT1:
+			return "SRGB BC1";
+		case CompressedSRGBADXT5:
+			return "SRGBA BC3";
 		default:
 			return "None";
 		}
 	}
 
+	//! getImageFormat()
+	/*!
+	\param format a const TextureImageFormat - The format of the image
+	\param gammaCorrect a const bool - Is the image in sRGB space
+	\param dataFormat a GLenum& - The format of the pixel data, unused by compressed images
+	\return a GLenum - The internal format
+	*/
+	static GLenum getImageFormat(const TextureImageFormat format, const bool gammaCorrect, GLenum& dataFormat)
+	{
+		switch (format)
+		{
+		case TextureImageFormat::R8:
+			dataFormat = GL_RED;
+			return GL_RED;
+		case TextureImageFormat::RGB8:
+			dataFormat = GL_RGB;
+			return gammaCorrect ? GL_SRGB : GL_RGB;
+		case TextureImageFormat::BC1:
+			dataFormat = GL_RGB;
+			return gammaCorrect ? CompressedSRGBDXT1 : CompressedRGBDXT1;
+		case TextureImageFormat::BC3:
+			dataFormat = GL_RGBA;
+			return gammaCorrect ? CompressedSRGBADXT5 : CompressedRGBADXT5;
+		default:
+			dataFormat = GL_RGBA;
+			return gammaCorrect ? GL_SRGB_ALPHA : GL_RGBA;
+		}
+	}
+
+	//! uploadImage()
+	/*!
+	\param target a const GLenum - The texture target of the image
+	\param image a const TextureImage& - The image
+	\param internalFormat a const GLenum - The internal format
+	\param dataFormat a const GLenum - The format of the pixel data
+	*/
+	static void uploadImage(const GLenum target, const TextureImage& image, const GLenum internalFormat, const GLenum dataFormat)
+	{
+		// Every level was built when the image was cooked, rows are tightly packed
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (uint32_t mip = 0; mip < image.Mips.size(); mip++)
+		{
+			const TextureMipLevel& level = image.Mips[mip];
+			if (image.isCompressed())
+				glCompressedTexImage2D(target, mip, internalFormat, level.Width, level.Height, 0, static_cast<GLsizei>(level.Size), image.getMipData(mip));
+			else
+				glTexImage2D(target, mip, internalFormat, level.Width, level.Height, 0, dataFormat, GL_UNSIGNED_BYTE, image.getMipData(mip));
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
 	//! init()
 	/*!
 	\param data an unsigned char* - A pointer to the data to store
@@ -175,6 +245,38 @@ namespace Engine
 		init(data, channels);
 	}
 
+	//! OpenGLTexture2D()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param properties a const TextureProperties& - A reference to the texture properties
+	\param image a const TextureImage& - The image, every level it has is uploaded
+	*/
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& textureName, const TextureProperties& properties, const TextureImage& image)
+		: Texture2D(textureName, properties)
+	{
+		m_textureProperties.Width = image.getWidth();
+		m_textureProperties.Height = image.getHeight();
+		m_channels = image.getChannels();
+		m_pixelDataType = GL_UNSIGNED_BYTE;
+
+		glGenTextures(1, &m_textureID);
+		glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, toGLType(m_textureProperties.WrapS));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, toGLType(m_textureProperties.WrapT));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, toGLType(m_textureProperties.WrapR));
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, toGLType(m_textureProperties.MinFilter));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, toGLType(m_textureProperties.MaxFilter));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.Mips.size()) - 1);
+
+		GLenum dataFormat;
+		m_internalFormat = getImageFormat(image.Format, m_textureProperties.GammaCorrect, dataFormat);
+		uploadImage(GL_TEXTURE_2D, image, m_internalFormat, dataFormat);
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
 	//! ~OpenGLTexture2D()
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
@@ -288,6 +390,38 @@ namespace Engine
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
+	//! OpenGLCubeMapTexture()
+	/*!
+	\param textureName a const std::string& - The name of the texture
+	\param folderPath a const std::string& - The path to the folder the faces were loaded from
+	\param faces a const std::vector<TextureImage>& - The right, left, top, bottom, front and back faces
+	*/
+	OpenGLCubeMapTexture::OpenGLCubeMapTexture(const std::string& textureName, const std::string& folderPath, const std::vector<TextureImage>& faces) : CubeMapTexture(textureName)
+	{
+		m_folderPath = folderPath;
+
+		glGenTextures(1, &m_textureID);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
+
+		// Like the faces read from file, the internal format is always RGB
+		for (uint32_t i = 0; i < faces.size() && i < 6; i++)
+		{
+			GLenum dataFormat;
+			GLenum internalFormat = getImageFormat(faces[i].Format, false, dataFormat);
+			if (!faces[i].isCompressed()) internalFormat = GL_RGB;
+			uploadImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, faces[i], internalFormat, dataFormat);
+		}
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, faces.empty() ? 0 : static_cast<GLint>(faces[0].Mips.size()) - 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	}
+
 	//! ~OpenGLCubeMapTexture()
 	OpenGLCubeMapTexture::~OpenGLCubeMapTexture()
 	{
@@ -15,53 +15,10 @@ in VS_OUT {
 	float Shininess;
 } fs_in;
 
-struct DirectionalLight {
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
-	
-struct PointLight {
-    vec4 position;
-    vec4 ambient;
-    vec4 diffuse;
-    vec4 specular;
-    float constant;
-    float linear;
-    float quadratic;
-};
-
-struct SpotLight {
-	vec4 position;
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-	float cutOff;
-	float outerCutOff;
-	float constant;
-	float linear;
-	float quadratic;
-};
+#include "../include/lights.glsl"
 
 uniform sampler2D[16] u_diffuseMap;
 
-layout(std140) uniform DirectionalLights
-{
-	DirectionalLight dirLight;
-};
-
-layout(std140) uniform PointLights
-{
-	PointLight pointLight[10];
-};
-
-layout(std140) uniform SpotLights
-{
-	SpotLight spotLight[10];
-};
-
 layout(std140) uniform Settings
 {
 	bool u_applyFog;
@@ -148,7 +105,7 @@ void main()
 	if(dirLight.direction != vec4(0.0, 0.0, 0.0, 0.0))
 		result += CalcDirLight(dirLight, norm, viewDir);
 
-    for(int i = 0; i < 10; i++)
+    for(int i = 0; i < MAX_LIGHTS; i++)
 	{
 		if(pointLight[i].constant != 1.0)
 			break;
@@ -156,7 +113,7 @@ void main()
 		result += CalcPointLight(pointLight[i], norm, fs_in.FragPos, viewDir); 	
 	}
 
-	for(int i = 0; i < 10; i++)
+	for(int i = 0; i < MAX_LIGHTS; i++)
 	{
 		if(spotLight[i].constant != 1.0)
 			break;
@@ -175,12 +132,16 @@ void main()
 		result = mix(vec3(0.5, 0.5, 0.5), result, visibility);
 	}
 
+#if USE_BLOOM
 	// check whether result is higher than some threshold, if so, output as bloom threshold color
     float brightness = dot(result, vec3(0.2126, 0.7152, 0.0722));
     if(brightness > 1.0)
         BrightColor = vec4(result, 1.0) * fs_in.Tint;
     else
         BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#else
+	BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#endif
 	
     FragColor = vec4(result, 1.0) * fs_in.Tint;
 }
\ No newline at end of file
@@ -24,12 +24,7 @@ out VS_OUT {
 	float Shininess;
 } vs_out;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 layout(std140) uniform Clip
 {
@@ -1,16 +1,7 @@
 #version 440 core
-			
-layout(location = 0) in vec4 a_vertexPosition;
-layout(location = 1) in vec2 a_texCoord;
-layout(location = 2) in int a_texUnit1;
-layout(location = 3) in int a_texUnit2;
-layout(location = 4) in vec4 a_tint;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-};
+#include "../include/quad.glsl"
+#include "../include/camera.glsl"
 
 out vec2 texCoord;
 out flat int texUnit1;
@@ -19,9 +10,9 @@ out vec4 tint;
 
 void main()
 {
-	texCoord = vec2(a_texCoord);
+	texCoord = getQuadTexCoord();
 	texUnit1 = a_texUnit1;
 	texUnit2 = a_texUnit2;
 	tint = a_tint;
-	gl_Position =  u_projection * u_view * a_vertexPosition;
+	gl_Position =  u_projection * u_view * getQuadPosition();
 }
\ No newline at end of file
@@ -0,0 +1,7 @@
+// The camera block, filled by the CameraUBO
+layout(std140) uniform Camera
+{
+	mat4 u_view;
+	mat4 u_projection;
+	vec3 u_viewPos;
+};
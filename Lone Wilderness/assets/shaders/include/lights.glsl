@@ -0,0 +1,45 @@
+// The light structures and blocks, filled by the light UBOs. MAX_LIGHTS must not be more than the UBOs hold
+struct DirectionalLight {
+	vec4 direction;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+};
+	
+struct PointLight {
+    vec4 position;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+struct SpotLight {
+	vec4 position;
+	vec4 direction;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	float cutOff;
+	float outerCutOff;
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+layout(std140) uniform DirectionalLights
+{
+	DirectionalLight dirLight;
+};
+
+layout(std140) uniform PointLights
+{
+	PointLight pointLight[MAX_LIGHTS];
+};
+
+layout(std140) uniform SpotLights
+{
+	SpotLight spotLight[MAX_LIGHTS];
+};
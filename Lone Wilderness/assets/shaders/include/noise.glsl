@@ -0,0 +1,37 @@
+// The terrain height noise, this must stay the same as Terrain::noise so the ground collided with is the ground drawn
+#include "tessellation.glsl"
+
+float hash(float n) {
+    return fract(sin(n) * 753.5453123);
+}
+
+float snoise(vec3 x)
+{
+	vec3 p = floor(x);
+	vec3 f = fract(x);
+	f = f * f * (3.0f - (2.0f * f));
+
+	float n = p.x + p.y * 157.0f + 113.0f * p.z;
+	return mix(mix(mix(hash(n + 0.0f), hash(n + 1.0f), f.x),
+		mix(hash(n + 157.0f), hash(n + 158.0f), f.x), f.y),
+		mix(mix(hash(n + 113.0f), hash(n + 114.0f), f.x),
+			mix(hash(n + 270.0f), hash(n + 271.0f), f.x), f.y), f.z);
+}
+
+float noise(vec3 position, int octaves)
+{
+	float total = 0.0;
+	float frequency = u_frequency;
+	float maxAmplitude = 0.0;
+	float amplitude = u_amplitude;
+	float scale = u_scale;
+	
+	for(int i = 0; i < octaves; i++)
+	{
+		total += snoise(position * frequency) * amplitude;
+		frequency *= u_frequencyMultiplier;
+		amplitude /= u_amplitudeDivisor;
+		maxAmplitude += amplitude;
+	}
+	return (total / maxAmplitude) * scale;
+}
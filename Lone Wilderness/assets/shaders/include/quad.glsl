@@ -0,0 +1,26 @@
+// One quad from the 2D renderer's instance buffer, laid out as QuadInstance2D
+layout(location = 0) in vec4 a_transform; // The centre in xy, the depth in z and the rotation in radians in w
+layout(location = 1) in vec2 a_size;
+layout(location = 2) in vec4 a_uvRect; // The UV start in xy and the UV end in zw
+layout(location = 3) in vec4 a_tint;
+layout(location = 4) in int a_texUnit1;
+layout(location = 5) in int a_texUnit2;
+
+// The corners of the unit quad, the quad index buffer picks them by gl_VertexID in the same order as Quad::getLocalVertices
+const vec2 quadCorners[4] = vec2[4](vec2(0.5, 0.5), vec2(0.5, -0.5), vec2(-0.5, -0.5), vec2(-0.5, 0.5));
+
+// The position of this vertex's corner, scaled, rotated and moved to the quad's centre
+vec4 getQuadPosition()
+{
+	vec2 corner = quadCorners[gl_VertexID] * a_size;
+	float s = sin(a_transform.w);
+	float c = cos(a_transform.w);
+	return vec4(a_transform.xy + vec2(corner.x * c - corner.y * s, corner.x * s + corner.y * c), a_transform.z, 1.0);
+}
+
+// The texture coordinate of this vertex's corner, the positive corners take the end of the UV rectangle
+vec2 getQuadTexCoord()
+{
+	vec2 corner = quadCorners[gl_VertexID];
+	return vec2(corner.x > 0.0 ? a_uvRect.z : a_uvRect.x, corner.y > 0.0 ? a_uvRect.w : a_uvRect.y);
+}
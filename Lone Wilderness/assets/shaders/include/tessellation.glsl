@@ -0,0 +1,12 @@
+// The terrain generation settings, filled by the TessellationUBO
+layout(std140) uniform Tessellation
+{
+	int u_tessellationEquation;
+	bool u_generateY;
+	int u_octaves;
+	float u_scale;
+	float u_frequency;
+	float u_amplitude;
+	float u_amplitudeDivisor;
+	float u_frequencyMultiplier;
+};
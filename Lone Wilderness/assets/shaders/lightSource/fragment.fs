@@ -11,9 +11,13 @@ void main()
 {    
     FragColor = fs_in.Tint;
 	
+#if USE_BLOOM
 	float brightness = dot(FragColor.rgb, vec3(0.2126, 0.7152, 0.0722));
     if(brightness > 1.0)
         BrightColor = vec4(FragColor.rgb, 1.0);
 	else
 		BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#else
+	BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#endif
 }
\ No newline at end of file
@@ -12,12 +12,7 @@ out VS_OUT {
 	vec4 Tint;
 } vs_out;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 void main()
 {
@@ -3,35 +3,7 @@
 layout (location = 0) out vec4 FragColor;
 layout (location = 1) out vec4 BrightColor;
 
-struct DirectionalLight {
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
-	
-struct PointLight {
-    vec4 position;
-    vec4 ambient;
-    vec4 diffuse;
-    vec4 specular;
-    float constant;
-    float linear;
-    float quadratic;
-};
-
-struct SpotLight {
-	vec4 position;
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-	float cutOff;
-	float outerCutOff;
-	float constant;
-	float linear;
-	float quadratic;
-};
+#include "../include/lights.glsl"
 
 in VS_OUT {
 	vec2 TexCoords1;
@@ -51,33 +23,13 @@ in VS_OUT {
 
 uniform sampler2D[16] u_diffuseMap;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 layout(std140) uniform Settings
 {
 	bool u_applyFog;
 };
 
-layout(std140) uniform DirectionalLights
-{
-	DirectionalLight dirLight;
-};
-
-layout(std140) uniform PointLights
-{
-	PointLight pointLight[10];
-};
-
-layout(std140) uniform SpotLights
-{
-	SpotLight spotLight[10];
-};
-
 // Calculates the color when using a directional light.
 vec3 CalcDirLight(DirectionalLight light, vec3 normal, vec3 viewDir)
 {
@@ -153,7 +105,7 @@ void main()
     
     vec3 result = vec3(0.0, 0.0, 0.0);
 	
-    for(int i = 0; i < 10; i++)
+    for(int i = 0; i < MAX_LIGHTS; i++)
 	{
 		if(pointLight[i].constant != 1.0)
 			break;
@@ -170,6 +122,7 @@ void main()
 		result = mix(vec3(0.0, 0.0, 0.0), result, visibility);
 	}
 	
+#if USE_BLOOM
 	// check whether result is higher than some threshold, if so, output as bloom threshold color
     float brightness = dot(result, vec3(0.2126, 0.7152, 0.0722));
 	//brightness = mix(vec4(0.0, 0.0, 0.0, 1.0), brightness, visibility);
@@ -177,6 +130,9 @@ void main()
         BrightColor = vec4(result, 1.0) * fs_in.Tint;
     else
         BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#else
+	BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+#endif
 	
 	FragColor = vec4(result, 1.0) * fs_in.Tint;
 }
\ No newline at end of file
@@ -1,15 +1,7 @@
 #version 440 core
-			
-layout(location = 0) in vec4 a_vertexPosition;
-layout(location = 1) in vec2 a_texCoord;
-layout(location = 2) in int a_texUnit;
-layout(location = 3) in vec4 a_tint;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-};
+#include "../include/quad.glsl"
+#include "../include/camera.glsl"
 
 out vec2 texCoord;
 out flat int texUnit;
@@ -17,8 +9,8 @@ out vec4 tint;
 
 void main()
 {
-	texCoord = vec2(a_texCoord);
-	texUnit = a_texUnit;
+	texCoord = getQuadTexCoord();
+	texUnit = a_texUnit1;
 	tint = a_tint;
-	gl_Position =  u_projection * u_view * a_vertexPosition;
+	gl_Position =  u_projection * u_view * getQuadPosition();
 }
\ No newline at end of file
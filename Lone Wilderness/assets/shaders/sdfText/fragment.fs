@@ -0,0 +1,18 @@
+#version 440 core
+
+layout(location = 0) out vec4 colour;
+
+in vec2 texCoord;
+in flat int texUnit;
+in vec4 tint;
+
+uniform sampler2D[16] u_textures;
+
+void main()
+{
+	// The alpha is the distance to the glyph edge, the edge is at 0.5 and the smoothing is kept to about a pixel at any scale
+	float distance = texture(u_textures[texUnit], texCoord).a;
+	float width = max(fwidth(distance), 0.0001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+	colour = vec4(tint.rgb, tint.a * alpha);
+}
@@ -12,52 +12,14 @@ in GS_OUT {
 	vec3 FragPos;
 } fs_in;
 
-struct DirectionalLight {
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
-	
-struct PointLight {
-    vec4 position;
-    vec4 ambient;
-    vec4 diffuse;
-    vec4 specular;
-    float constant;
-    float linear;
-    float quadratic;
-};
-
-struct SpotLight {
-	vec4 position;
-	vec4 direction;
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-	float cutOff;
-	float outerCutOff;
-	float constant;
-	float linear;
-	float quadratic;
-};
+#include "../include/lights.glsl"
 
 layout(std140) uniform Settings
 {
 	bool u_applyFog;
 };
 
-layout(std140) uniform Tessellation
-{
-	int u_tessellationEquation;
-	bool u_generateY;
-	int u_octaves;
-	float u_scale;
-	float u_frequency;
-	float u_amplitude;
-	float u_amplitudeDivisor;
-	float u_frequencyMultiplier;
-};
+#include "../include/tessellation.glsl"
 
 layout(std140) uniform Clip
 {
@@ -65,21 +27,6 @@ layout(std140) uniform Clip
 	float u_mode;
 };
 
-layout(std140) uniform DirectionalLights
-{
-	DirectionalLight dirLight;
-};
-
-layout(std140) uniform PointLights
-{
-	PointLight pointLight[10];
-};
-
-layout(std140) uniform SpotLights
-{
-	SpotLight spotLight[10];
-};
-
 uniform sampler2D[16] u_diffuseMap;
 
 const float shininess = 32.0;
@@ -195,7 +142,7 @@ void main()
 	if(dirLight.direction != vec4(0.0, 0.0, 0.0, 0.0))
 		result += CalcDirLight(dirLight, norm, viewDir, col);
 
-    for(int i = 0; i < 10; i++)
+    for(int i = 0; i < MAX_LIGHTS; i++)
 	{
 		if(pointLight[i].constant != 1.0)
 			break;
@@ -203,7 +150,7 @@ void main()
 		result += CalcPointLight(pointLight[i], norm, fs_in.FragPos, viewDir, col); 	
 	}
 
-	for(int i = 0; i < 10; i++)
+	for(int i = 0; i < MAX_LIGHTS; i++)
 	{
 		if(spotLight[i].constant != 1.0)
 			break;
@@ -21,12 +21,7 @@ out GS_OUT {
 	vec3 FragPos;
 } gs_out;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 vec3 getNormal();
 
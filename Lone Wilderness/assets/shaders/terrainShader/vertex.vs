@@ -14,12 +14,7 @@ out VS_OUT {
 	vec3 FragPos;
 } vs_out;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 void main()
 {
@@ -20,12 +20,7 @@ out VS_OUT {
 	vec2 TexCoords;
 } vs_out;
 
-layout(std140) uniform Camera
-{
-	mat4 u_view;
-	mat4 u_projection;
-	vec3 u_viewPos;
-};
+#include "../include/camera.glsl"
 
 const float tiling = 6.0;
 
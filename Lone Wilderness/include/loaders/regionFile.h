@@ -0,0 +1,102 @@
+/*! \file regionFile.h
+*
+* \brief A region file, the saved changes of a square of chunks in a compact binary encoding which is read straight from a mapped file
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef REGIONFILE_H
+#define REGIONFILE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "independent/utils/mappedFile.h"
+
+namespace Engine
+{
+	namespace RegionFormat
+	{
+		const uint32_t Magic = 0x4E47524C; //!< The first four bytes of every region file, 'LRGN'
+		const uint32_t Version = 1; //!< Increase whenever the header or the chunk encoding changes
+		const int32_t RegionSize = 16; //!< The number of chunks along each side of a region
+		const uint32_t ChunkCount = RegionSize * RegionSize; //!< The number of chunks in a region
+	}
+
+	/*! \struct PlacedObject
+	* \brief An object the player has placed in the world
+	*/
+	struct PlacedObject
+	{
+		uint32_t Item; //!< The item the object was placed from
+		glm::vec3 Position; //!< The world position
+	};
+
+	/*! \struct ChunkDelta
+	* \brief Everything in a chunk which differs from the generated world
+	*/
+	struct ChunkDelta
+	{
+		std::vector<PlacedObject> Placed; //!< Objects placed in the chunk
+		std::vector<uint32_t> Harvested; //!< Keys of the generated objects removed from the chunk, kept sorted
+
+		inline const bool empty() const { return Placed.empty() && Harvested.empty(); } //!< Does the chunk hold no changes
+			/*!< \return a const bool - Does the chunk hold no changes */
+	};
+
+	/*! \struct RegionEntry
+	* \brief Where a chunk's encoded changes are found in the file
+	*/
+	struct RegionEntry
+	{
+		uint32_t offset = 0; //!< The offset in bytes from the start of the file
+		uint32_t size = 0; //!< The size in bytes, 0 when the chunk has no changes
+	};
+
+	/*! \struct RegionHeader
+	* \brief The start of every region file, followed by the encoded chunks
+	*/
+	struct RegionHeader
+	{
+		uint32_t magic = RegionFormat::Magic; //!< Identifies the file as a region
+		uint32_t version = RegionFormat::Version; //!< The format version
+		int32_t regionX = 0; //!< The x coordinate of the region
+		int32_t regionZ = 0; //!< The z coordinate of the region
+		float chunkSize = 0.f; //!< The width of a chunk in world units, positions are stored relative to their chunk
+		uint32_t totalSize = 0; //!< The size of the whole file in bytes
+		RegionEntry chunks[RegionFormat::ChunkCount]; //!< The entry of each chunk, row by row along z
+	};
+
+	/*! \class RegionFile
+	* \brief A mapped region file, only the chunks asked for are decoded
+	*/
+	class RegionFile
+	{
+	private:
+		MappedFile m_file; //!< The mapped file
+
+		inline const RegionHeader& getHeader() const { return *reinterpret_cast<const RegionHeader*>(m_file.getData()); } //!< Get the header
+			/*!< \return a const RegionHeader& - The header */
+	public:
+		RegionFile(); //!< Constructor
+
+		const bool open(const std::string& filePath); //!< Map and check a region file
+		void close(); //!< Unmap the region file
+		inline const bool isOpen() const { return m_file.isOpen(); } //!< Is a valid region file mapped
+			/*!< \return a const bool - Is a valid region file mapped */
+
+		const bool hasChunk(const uint32_t index) const; //!< Does the file hold changes for a chunk
+		const bool readChunk(const uint32_t index, ChunkDelta& chunk) const; //!< Decode the changes of a chunk
+
+		static void encodeChunk(const ChunkDelta& chunk, const glm::vec2& origin, const float chunkSize, std::vector<uint8_t>& data); //!< Append the encoding of a chunk
+		static const bool decodeChunk(const uint8_t* data, const uint32_t size, const glm::vec2& origin, const float chunkSize, ChunkDelta& chunk); //!< Decode an encoded chunk
+		static const bool write(const std::string& filePath, const glm::ivec2& region, const float chunkSize, const std::unordered_map<uint32_t, ChunkDelta>& chunks); //!< Write every chunk of a region to file
+
+		static glm::ivec2 getRegion(const glm::ivec2& chunk); //!< Get the region a chunk is in
+		static const uint32_t getChunkIndex(const glm::ivec2& chunk); //!< Get the index of a chunk within its region
+		static glm::ivec2 getChunk(const glm::ivec2& region, const uint32_t index); //!< Get a chunk from its region and index
+	};
+}
+#endif
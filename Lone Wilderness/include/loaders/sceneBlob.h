@@ -0,0 +1,156 @@
+/*! \file sceneBlob.h
+*
+* \brief A compiled entity file, a flat binary blob which can be walked without parsing any JSON
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef SCENEBLOB_H
+#define SCENEBLOB_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Engine
+{
+	namespace SceneBlobFormat
+	{
+		const uint32_t Magic = 0x4E43534C; //!< The first four bytes of every blob, 'LSCN'
+		const uint32_t Version = 1; //!< Increase whenever a record layout or the value order of a component changes
+		const uint32_t NoIndex = 0xFFFFFFFF; //!< An unused string or resource index
+	}
+
+	/*! \struct BlobSection
+	* \brief The position of an array within the blob
+	*/
+	struct BlobSection
+	{
+		uint32_t offset = 0; //!< The offset in bytes from the start of the blob
+		uint32_t count = 0; //!< The number of elements
+	};
+
+	/*! \struct SceneBlobHeader
+	* \brief The start of every blob, every other section is found through it
+	*/
+	struct SceneBlobHeader
+	{
+		uint32_t magic = SceneBlobFormat::Magic; //!< Identifies the file as a blob
+		uint32_t version = SceneBlobFormat::Version; //!< The format version
+		uint64_t sourceSize = 0; //!< The size of the JSON file the blob was compiled from
+		int64_t sourceTime = 0; //!< The write time of the JSON file the blob was compiled from
+		BlobSection entities; //!< The entity records, in depth-first order
+		BlobSection components; //!< The component records
+		BlobSection values; //!< The numeric component values
+		BlobSection resources; //!< The resource table, string indices of every resource name used
+		BlobSection strings; //!< The string table, offsets into the characters
+		BlobSection characters; //!< Null terminated string characters
+		BlobSection scriptData; //!< MessagePack encoded script parameters
+		uint32_t totalSize = 0; //!< The size of the whole blob in bytes
+	};
+
+	/*! \struct BlobEntity
+	* \brief An entity record, its whole subtree follows it directly
+	*/
+	struct BlobEntity
+	{
+		uint32_t name; //!< The string index of the entity's name
+		uint32_t layer; //!< The string index of the entity's layer name
+		uint32_t display; //!< Should the entity be displayed
+		uint32_t firstComponent; //!< The index of the entity's first component
+		uint32_t componentCount; //!< The number of components
+		uint32_t descendantCount; //!< The number of entities below this one, used to skip a whole subtree
+	};
+
+	/*! \struct BlobComponent
+	* \brief A component record, the meaning of each field depends on the component type
+	*/
+	struct BlobComponent
+	{
+		uint32_t type; //!< The component type
+		uint32_t name; //!< The string index of the component's name
+		uint32_t flags; //!< Boolean properties
+		uint32_t firstValue; //!< The index of the component's first numeric value
+		uint32_t valueCount; //!< The number of numeric values
+		uint32_t strings[2]; //!< String indices of text properties
+		uint32_t resources[2]; //!< Resource table indices
+		uint32_t scriptDataOffset; //!< The offset of the script parameters in the script data
+		uint32_t scriptDataSize; //!< The size of the script parameters, 0 when there are none
+	};
+
+	/*! \class SceneBlob
+	* \brief A view over a compiled entity file, every record refers to others by index so the bytes can be used as read
+	*/
+	class SceneBlob
+	{
+	private:
+		std::vector<char> m_data; //!< The blob
+
+		template<typename T> const T* getSection(const BlobSection& section) const { return reinterpret_cast<const T*>(m_data.data() + section.offset); } //!< Get the start of a section
+			/*!< \param section a const BlobSection& - The section
+				 \return a const T* - The first element of the section */
+		template<typename T> const bool checkSection(const BlobSection& section) const; //!< Check a section lies within the blob
+	public:
+		SceneBlob(); //!< Constructor
+
+		const bool setData(std::vector<char>&& data); //!< Take and check a blob
+		const bool readFromFile(const std::string& filePath); //!< Read and check a blob from file
+		const bool writeToFile(const std::string& filePath) const; //!< Write the blob to file
+		const bool isValid() const; //!< Does the blob hold valid data
+		const bool matchesSource(const uint64_t sourceSize, const int64_t sourceTime) const; //!< Was the blob compiled from this version of the source
+
+		inline const SceneBlobHeader& getHeader() const { return *reinterpret_cast<const SceneBlobHeader*>(m_data.data()); } //!< Get the header
+			/*!< \return a const SceneBlobHeader& - The header */
+		inline const BlobEntity* getEntities() const { return getSection<BlobEntity>(getHeader().entities); } //!< Get the entity records
+			/*!< \return a const BlobEntity* - The first entity */
+		inline const BlobComponent* getComponents() const { return getSection<BlobComponent>(getHeader().components); } //!< Get the component records
+			/*!< \return a const BlobComponent* - The first component */
+		inline const float* getValues() const { return getSection<float>(getHeader().values); } //!< Get the numeric values
+			/*!< \return a const float* - The first value */
+		inline const uint32_t* getResources() const { return getSection<uint32_t>(getHeader().resources); } //!< Get the resource table
+			/*!< \return a const uint32_t* - The string index of the first resource name */
+		inline const char* getString(const uint32_t index) const { return getSection<char>(getHeader().characters) + getSection<uint32_t>(getHeader().strings)[index]; } //!< Get a string
+			/*!< \param index a const uint32_t - The string index
+				 \return a const char* - The null terminated string */
+		inline const uint8_t* getScriptData(const uint32_t offset) const { return getSection<uint8_t>(getHeader().scriptData) + offset; } //!< Get script parameters
+			/*!< \param offset a const uint32_t - The offset of the parameters
+				 \return a const uint8_t* - The first byte of the parameters */
+	};
+
+	/*! \class SceneBlobBuilder
+	* \brief Collects records while a JSON entity file is compiled and lays them out as a blob
+	*/
+	class SceneBlobBuilder
+	{
+	private:
+		std::vector<BlobEntity> m_entities; //!< The entity records
+		std::vector<BlobComponent> m_components; //!< The component records
+		std::vector<float> m_values; //!< The numeric values
+		std::vector<uint32_t> m_resources; //!< The resource table
+		std::vector<uint32_t> m_strings; //!< The string table
+		std::vector<char> m_characters; //!< The string characters
+		std::vector<uint8_t> m_scriptData; //!< The script parameters
+		std::unordered_map<std::string, uint32_t> m_stringIndices; //!< Strings already added, so each is stored once
+		std::unordered_map<uint32_t, uint32_t> m_resourceIndices; //!< Resources already added, by string index
+	public:
+		const uint32_t addEntity(); //!< Add an entity record
+		const uint32_t addComponent(); //!< Add a component record
+		inline BlobEntity& getEntity(const uint32_t index) { return m_entities[index]; } //!< Get an entity record
+			/*!< \param index a const uint32_t - The entity index
+				 \return a BlobEntity& - The entity record */
+		inline BlobComponent& getComponent(const uint32_t index) { return m_components[index]; } //!< Get a component record
+			/*!< \param index a const uint32_t - The component index
+				 \return a BlobComponent& - The component record */
+		inline const uint32_t getEntityCount() const { return static_cast<uint32_t>(m_entities.size()); } //!< Get the number of entity records
+			/*!< \return a const uint32_t - The number of entity records */
+
+		const uint32_t addString(const std::string& string); //!< Add a string
+		const uint32_t addResource(const std::string& resourceName); //!< Add a resource name to the resource table
+		void addValue(const uint32_t componentIndex, const float value); //!< Add a numeric value to the last component
+		const uint32_t addScriptData(const std::vector<uint8_t>& data); //!< Add script parameters
+
+		std::vector<char> build(const uint64_t sourceSize, const int64_t sourceTime) const; //!< Lay the records out as a blob
+	};
+}
+#endif
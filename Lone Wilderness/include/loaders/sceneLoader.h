@@ -9,7 +9,9 @@
 #define SCENELOADER_H
 
 #include <string>
+#include <unordered_map>
 #include <json.hpp>
+#include "loaders/sceneBlob.h"
 
 namespace Engine
 {
@@ -20,6 +22,7 @@ namespace Engine
 	class Entity; //!< Forward declare entity
 	class Layer; //!< Forward declare layer
 	class RenderPass; //!< Forward declare render pass
+	class Resource; //!< Forward declare resource
 
 	/*! \class SceneLoader
 	* \brief A loader class which loads the scene object by creating all the objects from files
@@ -27,16 +30,23 @@ namespace Engine
 	class SceneLoader
 	{
 	private:
+		static std::unordered_map<std::string, SceneBlob> s_compiledEntities; //!< Compiled entity files by JSON file path
+
 		static Layer* createLayer(const std::string& layerName); //!< Create a new layer by converting string layer name literal
 		static RenderPass* createRenderPass(const std::string& passName); //!< Create a new render pass by converting string pass name literal
-		static bool loadSceneProperties(Scene* scene, json sceneData); //!< Load the scenes properties/core data
-		static bool loadEntityProperties(Entity* entity, json entityData); //!< Load the entity's properties/core data
-		static void loadEntity(Scene* scene, Entity* parent, json entityData); //!< Load an entity
-		static void loadComponents(Scene* scene, Entity* entity, json componentData); //!< Load components
+		static bool loadSceneProperties(Scene* scene, const json& sceneData); //!< Load the scenes properties/core data
+		static void compileEntity(SceneBlobBuilder& builder, const json& entityData); //!< Compile an entity and its children
+		static void compileComponents(SceneBlobBuilder& builder, const json& componentData); //!< Compile components
+		static const SceneBlob* getCompiledEntities(const std::string& entityFilePath); //!< Get the compiled form of an entity file, compiling it if needed
+		static bool loadEntityProperties(Entity* entity, const SceneBlob& blob, const BlobEntity& entityRecord); //!< Load the entity's properties/core data
+		static void loadEntity(Scene* scene, Entity* parent, const SceneBlob& blob, const std::vector<Resource*>& resources, uint32_t& entityIndex); //!< Load an entity
+		static void loadComponents(Scene* scene, Entity* entity, const SceneBlob& blob, const BlobEntity& entityRecord, const std::vector<Resource*>& resources); //!< Load components
 	public:
-		static NativeScript* createNewScript(const std::string& scriptName, nlohmann::json scriptData = nlohmann::json()); //!< Create a new script
+		static NativeScript* createNewScript(const std::string& scriptName, const nlohmann::json& scriptData = nlohmann::json()); //!< Create a new script
 		static void load(const std::string& sceneName, const std::string& sceneFolderPath); //!< Load the scene
 		static void loadEntities(Scene* scene, const std::string& entityFilePath); //!< Load entities into the scene
+		static bool compile(const std::string& entityFilePath, SceneBlob& blob); //!< Compile an entity file and write the blob beside it
+		static std::string getCompiledPath(const std::string& entityFilePath); //!< Get the path the compiled form of an entity file is written to
 	};
 }
 
@@ -25,7 +25,6 @@ public:
 	Cyborg(); //!< Constructor
 	~Cyborg(); //!< Destructor
 	void onPreUpdate(const float timestep, const float totalTime) override; //!< Call before game update
-	void onKeyPress(KeyPressedEvent& e, const float timestep, const float totalTime) override;
 	void onKeyRelease(KeyReleasedEvent& e, const float timestep, const float totalTime) override; //!< Call upon key release
 };
 #endif
\ No newline at end of file
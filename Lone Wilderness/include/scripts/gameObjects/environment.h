@@ -8,8 +8,10 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <random>
 #include "independent/entities/components/nativeScript.h"
 #include "independent/entities/components/transform.h"
+#include "independent/systems/components/collisionWorld.h"
 
 using namespace Engine;
 
@@ -34,15 +36,25 @@ private:
 	std::vector<BoundingBox> m_treeBB;
 	std::vector<std::pair<glm::vec3, bool>> m_rockPositions;
 	std::vector<BoundingBox> m_rockBB;
+	std::vector<glm::mat4> m_treeMatrices; //!< The model matrix of every tree, rebuilt when a tree is removed
+	std::vector<glm::mat4> m_rockMatrices; //!< The model matrix of every rock, rebuilt when a rock is removed
+	std::vector<ColliderID> m_treeColliders; //!< The collider of every tree
+	std::vector<ColliderID> m_rockColliders; //!< The collider of every rock
+	std::vector<uint32_t> m_treeIndices; //!< The index every tree was generated at, which it is saved under when harvested
+	std::vector<uint32_t> m_rockIndices; //!< The index every rock was generated at, which it is saved under when harvested
+	std::mt19937 m_generator; //!< Seeded from the world so the same objects are generated every time it is loaded
 	Entity* m_treeHighlightedEntity;
 	Entity* m_rockHighlightedEntity;
 
 	bool existsInsideBB(BoundingBox bb, Transform* otherTransform);
+	void addColliders(const std::vector<std::pair<glm::vec3, bool>>& positions, const glm::vec3& halfSize, const float height, std::vector<ColliderID>& colliders); //!< Add a static box for each of a set of objects
+	void composeMatrices(const std::vector<std::pair<glm::vec3, bool>>& positions, const glm::vec3& scale, std::vector<glm::mat4>& matrices); //!< Build the model matrices of a set of objects
 public:
 	Environment(); //!< Constructor
 	~Environment(); //!< Destructor
 
 	void onAttach() override; //!< Called when attached to the entity
+	void onDetach() override; //!< Called when detached from the entity
 	void onPostUpdate(const float timestep, const float totalTime) override; //!< Call after game update
 	void onKeyRelease(KeyReleasedEvent& e, const float timestep, const float totalTime) override; //!< Call upon key release
 	void onRender(const Renderers renderer, const std::string& renderState) override; //!< Call upon render
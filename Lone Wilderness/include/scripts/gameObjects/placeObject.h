@@ -9,6 +9,8 @@
 #define PLACEOBJECT_H
 
 #include "independent/entities/components/nativeScript.h"
+#include "independent/entities/prefab.h"
+#include "scripts/gameObjects/player/item.h"
 
 using namespace Engine;
 
@@ -23,11 +25,15 @@ private:
 	Entity* m_camera;
 	Entity* m_currentEntity;
 	Player* m_player;
-	uint32_t number = 0;
+	std::map<Items::Items, Prefab> m_prefabs; //!< The placed object template of each placeable item
 	bool m_final = false;
+
+	Entity* createObject(Items::Items item, const glm::vec3& position); //!< Create an object from its item's template
 public:
 	PlaceObject(); //!< Constructor
 	~PlaceObject(); //!< Destructor
+	void onAttach() override; //!< Called when attached to the entity
+	void onDetach() override; //!< Called when detached from the entity
 	void onPreUpdate(const float timestep, const float totalTime) override; //!< Call before game update
 	void onMouseRelease(MouseReleasedEvent& e, const float timestep, const float totalTime) override;
 };
@@ -0,0 +1,29 @@
+/*! \file placedCollider.h
+*
+* \brief A script which keeps the collider of a placed object and removes it with the object
+*
+* \author: Daniel Bullin
+*
+*/
+#ifndef PLACEDCOLLIDER_H
+#define PLACEDCOLLIDER_H
+
+#include "independent/entities/components/nativeScript.h"
+#include "independent/systems/components/collisionWorld.h"
+
+using namespace Engine;
+
+/*! \class PlacedCollider
+* \brief A script which keeps the collider of a placed object and removes it with the object
+*/
+class PlacedCollider : public NativeScript
+{
+private:
+	ColliderID m_collider; //!< The object's box in the scene's collision world
+public:
+	PlacedCollider(); //!< Constructor
+	~PlacedCollider(); //!< Destructor
+	void onDetach() override; //!< Called when detached from the entity
+	void setCollider(const ColliderID collider); //!< Set the object's box
+};
+#endif
@@ -36,6 +36,7 @@ public:
 	~Player(); //!< Destructor
 
 	void onAttach() override; //!< Called when attached to the entity
+	void onDetach() override; //!< Called when detached from the entity
 	void onPreUpdate(const float timestep, const float totalTime) override; //!< Call before game update
 	void onPostUpdate(const float timestep, const float totalTime) override; //!< Call after game update
 	void onKeyPress(KeyPressedEvent& e, const float timestep, const float totalTime) override; //!< Call upon key press
@@ -10,6 +10,7 @@
 
 #include "independent/entities/components/nativeScript.h"
 #include "scripts/gameTimer.h"
+#include "independent/rendering/materials/materialInstance.h"
 
 using namespace Engine;
 
@@ -21,7 +22,7 @@ class Sun : public NativeScript
 private:
 	GameTimer* m_timer;
 	float m_cycleTime;
-	Material* m_skyboxMaterial;
+	MaterialInstance* m_skyInstance;
 	bool m_approachingNight;
 public:
 	Sun(); //!< Constructor
@@ -43,6 +43,8 @@ public:
 	Terrain(); //!< Constructor
 	~Terrain(); //!< Destructor
 
+	void onAttach() override; //!< Called when attached to the entity
+	void onDetach() override; //!< Called when detached from the entity
 	void onPostUpdate(const float timestep, const float totalTime) override; //!< Call after game update
 	void onRender(const Renderers renderer, const std::string& renderState); //!< On Render
 	void onKeyRelease(KeyReleasedEvent& e, const float timestep, const float totalTime) override; //!< Call upon key release
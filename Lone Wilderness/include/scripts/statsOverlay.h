@@ -0,0 +1,35 @@
+/*! \file statsOverlay.h
+*
+* \brief A text overlay which shows the engine counters
+*
+* \author: Daniel Bullin
+*
+*/
+#ifndef STATSOVERLAY_H
+#define STATSOVERLAY_H
+
+#include "independent/entities/components/nativeScript.h"
+#include "independent/systems/components/glyphRun.h"
+
+using namespace Engine;
+
+/*! \class StatsOverlay
+* \brief A script which draws the rolling counter averages, toggled with F3
+*/
+class StatsOverlay : public NativeScript
+{
+private:
+	bool m_visible; //!< Is the overlay shown
+	std::vector<std::string> m_lines; //!< The lines of text to draw
+	std::vector<GlyphRun> m_runs; //!< The laid out lines, only built again when the lines are refreshed
+	float m_lineHeight; //!< The distance between lines
+
+	void refresh(); //!< Rebuild the lines of text from the counters
+public:
+	StatsOverlay(); //!< Constructor
+	~StatsOverlay(); //!< Destructor
+	void onPostUpdate(const float timestep, const float totalTime) override; //!< Call after game update
+	void onKeyRelease(KeyReleasedEvent& e, const float timestep, const float totalTime) override; //!< Call upon key release
+	void onRender(const Renderers renderer, const std::string& renderState) override; //!< Call upon rendering
+};
+#endif
@@ -26,5 +26,6 @@ public:
 	~Chunk(); //!< Destructor
 	void setChunkPosition(const glm::ivec2& chunkPos, const float positionMultiplier); //!< Set the chunk's position
 	glm::vec3 getWorldPositon(); //!< Get chunk's world position
+	glm::ivec2 getChunkPosition(); //!< Get chunk's position
 };
 #endif
\ No newline at end of file
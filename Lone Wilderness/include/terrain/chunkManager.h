@@ -8,7 +8,9 @@
 #ifndef CHUNKMANAGER_H
 #define CHUNKMANAGER_H
 
+#include <functional>
 #include "independent/systems/systems/resourceManager.h"
+#include "independent/utils/batchTransforms.h"
 #include "chunk.h"
 
 using namespace Engine;
@@ -24,8 +26,12 @@ private:
 	static int s_chunkSize; //!< The total number of tiles in any axis
 	static int s_chunkStepSize; //!< The size of a tile in width
 	static Model3D* s_model; //!< The model of the terrain
+	static std::function<float(float, float)> s_heightfield; //!< Gives the height of the terrain at an x and z
+	static std::map<std::pair<int, int>, glm::vec2> s_heightRanges; //!< The lowest and highest point of each chunk bounded so far
 
 	static TerrainVertex makeVertex(int x, int z, float xTotalLength, float zTotalLength); //!< Make a new vertex
+	static glm::vec2 getHeightRange(const glm::ivec2& chunkPos); //!< Get the lowest and highest point of a chunk
+	static AABB getChunkBounds(Chunk* chunk); //!< Get the world bounds of a chunk
 public:
 	ChunkManager(); //!< Constructor
 	~ChunkManager(); //!< Destructor
@@ -36,6 +42,8 @@ public:
 	static void deleteChunks(); //!< Delete chunks
 	static void setChunksSize(const int size); //!< Set the number of chunks along an axis
 	static int getChunksSize(); //!< Get the number of chunks along an axis
+	static float getChunkWorldSize(); //!< Get the width of a chunk in world units
+	static void setHeightfield(const std::function<float(float, float)>& heightfield); //!< Set the function giving the height of the terrain
 
 	static void updateChunks(const glm::ivec2& playerPos); //!< Update all the chunks
 
@@ -0,0 +1,111 @@
+/*! \file worldSave.h
+*
+* \brief Saves the changes made to the world in region files keyed by chunk, regions are written on a background thread and mapped as chunks stream in
+*
+* \author: Daniel Bullin
+*
+*/
+#ifndef WORLDSAVE_H
+#define WORLDSAVE_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <unordered_set>
+#include "loaders/regionFile.h"
+
+using namespace Engine;
+
+class Inventory;
+
+namespace WorldObject
+{
+	/*! \enum WorldObject
+	* \brief The kinds of generated object which can be harvested
+	*/
+	enum WorldObject
+	{
+		Tree, Rock
+	};
+}
+
+/*! \class WorldSave
+* \brief Keeps the changes of every chunk read or changed since the world was opened. A region is only mapped when one of its chunks is first
+* needed and only the chunks needed are decoded, once a chunk in a region changes the whole region is held in memory and rewritten on the next save
+*/
+class WorldSave
+{
+private:
+	/*! \struct Region
+	* \brief The chunks of a region read or changed so far
+	*/
+	struct Region
+	{
+		glm::ivec2 Coordinate; //!< The region coordinate
+		RegionFile File; //!< The mapped file, closed once the region is held in memory
+		std::unordered_map<uint32_t, ChunkDelta> Chunks; //!< The chunks by index within the region
+		bool Resident = false; //!< Are all the region's chunks held in memory
+		bool Dirty = false; //!< Has a chunk changed since the region was last saved
+	};
+
+	/*! \struct SaveJob
+	* \brief A file for the writer thread, it holds its own copy of everything so the world can keep changing
+	*/
+	struct SaveJob
+	{
+		std::string FilePath; //!< The file to write
+		glm::ivec2 Region; //!< The region coordinate, unused for the world file
+		std::unordered_map<uint32_t, ChunkDelta> Chunks; //!< The chunks of the region
+		std::vector<uint8_t> Data; //!< The encoded world file, empty for a region
+	};
+
+	static bool s_open; //!< Is a world open
+	static std::string s_directory; //!< The directory the world is saved in
+	static float s_chunkSize; //!< The width of a chunk in world units
+	static float s_autosaveInterval; //!< The seconds between saves
+	static float s_sinceSave; //!< The seconds since the last save
+	static uint32_t s_seed; //!< The seed the environment is generated from
+	static Inventory* s_inventory; //!< The inventory saved with the world
+	static std::vector<uint8_t> s_savedWorld; //!< The world file as last written, so it is only written when it changes
+
+	static std::unordered_map<uint64_t, Region> s_regions; //!< The regions used so far
+	static std::unordered_set<uint64_t> s_streamedChunks; //!< The chunks whose placed objects have been created
+	static glm::ivec2 s_streamCentre; //!< The chunk streaming was last centred on
+	static bool s_hasStreamed; //!< Have any chunks been streamed in
+	static std::function<void(const PlacedObject&)> s_placedObjectLoader; //!< Creates a placed object as its chunk streams in
+
+	static std::thread s_writer; //!< The thread which writes files
+	static std::mutex s_jobMutex; //!< Guards the jobs
+	static std::condition_variable s_jobCondition; //!< Wakes the writer
+	static std::deque<SaveJob> s_jobs; //!< Files waiting to be written
+	static bool s_stopWriter; //!< Should the writer finish once the jobs are written
+
+	static uint64_t getKey(const glm::ivec2& coordinate); //!< Get the key of a chunk or region coordinate
+	static glm::ivec2 getChunkCoordinate(const glm::vec3& position); //!< Get the chunk a position is in
+	static Region& getRegion(const glm::ivec2& region); //!< Get a region, mapping its file the first time
+	static ChunkDelta& getChunk(const glm::ivec2& chunk); //!< Get the changes of a chunk to read
+	static ChunkDelta& editChunk(const glm::ivec2& chunk); //!< Get the changes of a chunk to change
+
+	static void encodeWorld(std::vector<uint8_t>& data); //!< Encode the seed and the inventory
+	static void readWorld(); //!< Read the seed and the inventory, or start a new world
+	static void queueJob(SaveJob&& job); //!< Give a file to the writer thread
+	static void runWriter(); //!< Write files until told to stop
+public:
+	static void open(); //!< Open the world set in the config
+	static void close(); //!< Save and close the world, waiting for every file to be written
+	static const bool isOpen(); //!< Is a world open
+
+	static void onUpdate(const float timestep); //!< Save the world whenever the autosave interval passes
+	static void save(); //!< Hand every changed region to the writer thread
+	static void streamChunks(const glm::vec3& position, const int radius); //!< Create the placed objects of chunks which have come into range
+
+	static void setPlacedObjectLoader(const std::function<void(const PlacedObject&)>& loader); //!< Set the function which creates placed objects
+	static void addPlacedObject(const uint32_t item, const glm::vec3& position); //!< Record an object placed by the player
+	static void harvest(const WorldObject::WorldObject type, const uint32_t index, const glm::vec3& position); //!< Record a generated object being removed
+	static const bool isHarvested(const WorldObject::WorldObject type, const uint32_t index, const glm::vec3& position); //!< Has a generated object been removed
+	static const uint32_t getSeed(); //!< Get the seed the environment is generated from
+	static void setInventory(Inventory* inventory); //!< Fill an inventory with the saved items and save it with the world
+};
+#endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 */
 #include "gameApplication.h"
 #include "loaders/sceneLoader.h"
+#include "terrain/worldSave.h"
 
 //! GameApplication()
 GameApplication::GameApplication()
@@ -17,6 +18,9 @@ GameApplication::GameApplication()
 //! ~GameApplication()
 GameApplication::~GameApplication()
 {
+	// The player closes the world when it is detached, but a scene can open the world without one. Closing here, while every scene
+	// is still alive, saves the world and joins the writer thread before it is destroyed
+	WorldSave::close();
 }
 
 //! startApplication()
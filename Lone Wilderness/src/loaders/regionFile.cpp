@@ -0,0 +1,315 @@
+/*! \file regionFile.cpp
+*
+* \brief A region file, the saved changes of a square of chunks in a compact binary encoding which is read straight from a mapped file
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <filesystem>
+#include "loaders/regionFile.h"
+#include "independent/systems/systems/log.h"
+
+namespace Engine
+{
+	namespace
+	{
+		const float PositionScale = 65535.f; //!< Positions within a chunk are stored as a fraction of the chunk out of this
+
+		//! writeVarint()
+		/*!
+		\param value a uint32_t - The value, seven bits are stored per byte so small values take one byte
+		\param data a std::vector<uint8_t>& - The data to append to
+		*/
+		void writeVarint(uint32_t value, std::vector<uint8_t>& data)
+		{
+			while (value >= 0x80)
+			{
+				data.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			data.push_back(static_cast<uint8_t>(value));
+		}
+
+		//! readVarint()
+		/*!
+		\param data a const uint8_t*& - The next byte to read, moved past the value
+		\param end a const uint8_t* - The end of the data
+		\param value a uint32_t& - The value read
+		\return a const bool - Was a whole value read
+		*/
+		const bool readVarint(const uint8_t*& data, const uint8_t* end, uint32_t& value)
+		{
+			value = 0;
+			for (uint32_t shift = 0; shift < 35 && data < end; shift += 7)
+			{
+				const uint8_t byte = *data++;
+				value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return true;
+			}
+			return false;
+		}
+
+		template<typename T>
+		//! writeValue()
+		/*!
+		\param value a const T - The value, stored as its bytes
+		\param data a std::vector<uint8_t>& - The data to append to
+		*/
+		void writeValue(const T value, std::vector<uint8_t>& data)
+		{
+			const size_t offset = data.size();
+			data.resize(offset + sizeof(T));
+			memcpy(data.data() + offset, &value, sizeof(T));
+		}
+
+		template<typename T>
+		//! readValue()
+		/*!
+		\param data a const uint8_t*& - The next byte to read, moved past the value
+		\param end a const uint8_t* - The end of the data
+		\param value a T& - The value read
+		\return a const bool - Was the whole value read
+		*/
+		const bool readValue(const uint8_t*& data, const uint8_t* end, T& value)
+		{
+			if (static_cast<size_t>(end - data) < sizeof(T)) return false;
+			memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return true;
+		}
+
+		//! floorDivide()
+		/*!
+		\param value a const int32_t - The value
+		\param divisor a const int32_t - The divisor, above 0
+		\return an int32_t - The value divided and rounded down, so negative chunks are not pulled into region 0
+		*/
+		int32_t floorDivide(const int32_t value, const int32_t divisor)
+		{
+			return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+		}
+	}
+
+	//! RegionFile()
+	RegionFile::RegionFile()
+	{
+	}
+
+	//! open()
+	/*!
+	\param filePath a const std::string& - The region file
+	\return a const bool - Was a valid region file mapped
+	*/
+	const bool RegionFile::open(const std::string& filePath)
+	{
+		if (!m_file.open(filePath)) return false;
+
+		// Every chunk entry is checked once here, so reading a chunk only has to check its own encoding
+		bool valid = m_file.getSize() >= sizeof(RegionHeader);
+		if (valid)
+		{
+			const RegionHeader& header = getHeader();
+			valid = header.magic == RegionFormat::Magic && header.version == RegionFormat::Version && header.totalSize == m_file.getSize() && header.chunkSize > 0.f;
+			for (uint32_t i = 0; valid && i < RegionFormat::ChunkCount; i++)
+				valid = header.chunks[i].size == 0 || static_cast<uint64_t>(header.chunks[i].offset) + header.chunks[i].size <= m_file.getSize();
+		}
+
+		if (!valid)
+		{
+			ENGINE_ERROR("[RegionFile::open] The region file is not valid. File Path: {0}.", filePath);
+			m_file.close();
+		}
+
+		return valid;
+	}
+
+	//! close()
+	void RegionFile::close()
+	{
+		m_file.close();
+	}
+
+	//! hasChunk()
+	/*!
+	\param index a const uint32_t - The index of the chunk within the region
+	\return a const bool - Does the file hold changes for the chunk
+	*/
+	const bool RegionFile::hasChunk(const uint32_t index) const
+	{
+		return isOpen() && index < RegionFormat::ChunkCount && getHeader().chunks[index].size != 0;
+	}
+
+	//! readChunk()
+	/*!
+	\param index a const uint32_t - The index of the chunk within the region
+	\param chunk a ChunkDelta& - The decoded changes, left empty when the file has none for the chunk
+	\return a const bool - Was the chunk decoded
+	*/
+	const bool RegionFile::readChunk(const uint32_t index, ChunkDelta& chunk) const
+	{
+		chunk.Placed.clear();
+		chunk.Harvested.clear();
+		if (!hasChunk(index)) return isOpen();
+
+		const RegionHeader& header = getHeader();
+		const glm::ivec2 chunkPos = getChunk({ header.regionX, header.regionZ }, index);
+		const glm::vec2 origin = glm::vec2(chunkPos) * header.chunkSize;
+		return decodeChunk(m_file.getData() + header.chunks[index].offset, header.chunks[index].size, origin, header.chunkSize, chunk);
+	}
+
+	//! encodeChunk()
+	/*!
+	\param chunk a const ChunkDelta& - The changes of the chunk
+	\param origin a const glm::vec2& - The x and z world position of the chunk's corner
+	\param chunkSize a const float - The width of a chunk
+	\param data a std::vector<uint8_t>& - The data to append to
+	*/
+	void RegionFile::encodeChunk(const ChunkDelta& chunk, const glm::vec2& origin, const float chunkSize, std::vector<uint8_t>& data)
+	{
+		// An object is a byte for its item, its x and z as a fraction of the chunk and its height, 9 bytes instead of 16
+		writeVarint(static_cast<uint32_t>(chunk.Placed.size()), data);
+		for (auto& object : chunk.Placed)
+		{
+			const float x = glm::clamp((object.Position.x - origin.x) / chunkSize, 0.f, 1.f);
+			const float z = glm::clamp((object.Position.z - origin.y) / chunkSize, 0.f, 1.f);
+			writeValue(static_cast<uint8_t>(object.Item), data);
+			writeValue(static_cast<uint16_t>(std::lround(x * PositionScale)), data);
+			writeValue(static_cast<uint16_t>(std::lround(z * PositionScale)), data);
+			writeValue(object.Position.y, data);
+		}
+
+		// Harvested keys are sorted, so each is stored as the gap from the one before
+		writeVarint(static_cast<uint32_t>(chunk.Harvested.size()), data);
+		uint32_t previous = 0;
+		for (auto key : chunk.Harvested)
+		{
+			writeVarint(key - previous, data);
+			previous = key;
+		}
+	}
+
+	//! decodeChunk()
+	/*!
+	\param data a const uint8_t* - The encoded chunk
+	\param size a const uint32_t - The size of the encoded chunk
+	\param origin a const glm::vec2& - The x and z world position of the chunk's corner
+	\param chunkSize a const float - The width of a chunk
+	\param chunk a ChunkDelta& - The decoded changes
+	\return a const bool - Was the whole chunk decoded
+	*/
+	const bool RegionFile::decodeChunk(const uint8_t* data, const uint32_t size, const glm::vec2& origin, const float chunkSize, ChunkDelta& chunk)
+	{
+		const uint8_t* end = data + size;
+
+		uint32_t count = 0;
+		// Each object takes 9 bytes, so a count larger than the data left is corrupt
+		if (!readVarint(data, end, count) || count > static_cast<uint32_t>(end - data) / 9) return false;
+
+		chunk.Placed.resize(count);
+		for (auto& object : chunk.Placed)
+		{
+			uint8_t item;
+			uint16_t x, z;
+			readValue(data, end, item);
+			readValue(data, end, x);
+			readValue(data, end, z);
+			readValue(data, end, object.Position.y);
+
+			object.Item = item;
+			object.Position.x = origin.x + (static_cast<float>(x) / PositionScale) * chunkSize;
+			object.Position.z = origin.y + (static_cast<float>(z) / PositionScale) * chunkSize;
+		}
+
+		if (!readVarint(data, end, count) || count > static_cast<uint32_t>(end - data)) return false;
+
+		chunk.Harvested.resize(count);
+		uint32_t previous = 0;
+		for (auto& key : chunk.Harvested)
+		{
+			uint32_t gap;
+			if (!readVarint(data, end, gap)) return false;
+			key = previous + gap;
+			previous = key;
+		}
+
+		return data == end;
+	}
+
+	//! write()
+	/*!
+	\param filePath a const std::string& - The region file
+	\param region a const glm::ivec2& - The region coordinate
+	\param chunkSize a const float - The width of a chunk
+	\param chunks a const std::unordered_map<uint32_t, ChunkDelta>& - The changes of each chunk by index within the region
+	\return a const bool - Was the file written
+	*/
+	const bool RegionFile::write(const std::string& filePath, const glm::ivec2& region, const float chunkSize, const std::unordered_map<uint32_t, ChunkDelta>& chunks)
+	{
+		RegionHeader header;
+		header.regionX = region.x;
+		header.regionZ = region.y;
+		header.chunkSize = chunkSize;
+
+		std::vector<uint8_t> data(sizeof(RegionHeader));
+		for (auto& chunk : chunks)
+		{
+			if (chunk.second.empty() || chunk.first >= RegionFormat::ChunkCount) continue;
+
+			const glm::vec2 origin = glm::vec2(getChunk(region, chunk.first)) * chunkSize;
+			header.chunks[chunk.first].offset = static_cast<uint32_t>(data.size());
+			encodeChunk(chunk.second, origin, chunkSize, data);
+			header.chunks[chunk.first].size = static_cast<uint32_t>(data.size()) - header.chunks[chunk.first].offset;
+		}
+		header.totalSize = static_cast<uint32_t>(data.size());
+		memcpy(data.data(), &header, sizeof(RegionHeader));
+
+		// Write next to the old file and swap it in, so a file is never left half written
+		const std::string tempPath = filePath + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open()) return false;
+
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+			if (!file) return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, filePath, error);
+		return !error;
+	}
+
+	//! getRegion()
+	/*!
+	\param chunk a const glm::ivec2& - The chunk coordinate
+	\return a glm::ivec2 - The region coordinate
+	*/
+	glm::ivec2 RegionFile::getRegion(const glm::ivec2& chunk)
+	{
+		return { floorDivide(chunk.x, RegionFormat::RegionSize), floorDivide(chunk.y, RegionFormat::RegionSize) };
+	}
+
+	//! getChunkIndex()
+	/*!
+	\param chunk a const glm::ivec2& - The chunk coordinate
+	\return a const uint32_t - The index of the chunk within its region
+	*/
+	const uint32_t RegionFile::getChunkIndex(const glm::ivec2& chunk)
+	{
+		const glm::ivec2 local = chunk - getRegion(chunk) * RegionFormat::RegionSize;
+		return static_cast<uint32_t>(local.y * RegionFormat::RegionSize + local.x);
+	}
+
+	//! getChunk()
+	/*!
+	\param region a const glm::ivec2& - The region coordinate
+	\param index a const uint32_t - The index of the chunk within the region
+	\return a glm::ivec2 - The chunk coordinate
+	*/
+	glm::ivec2 RegionFile::getChunk(const glm::ivec2& region, const uint32_t index)
+	{
+		return region * RegionFormat::RegionSize + glm::ivec2(index % RegionFormat::RegionSize, index / RegionFormat::RegionSize);
+	}
+}
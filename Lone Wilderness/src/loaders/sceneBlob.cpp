@@ -0,0 +1,306 @@
+/*! \file sceneBlob.cpp
+*
+* \brief A compiled entity file, a flat binary blob which can be walked without parsing any JSON
+*
+* \author Daniel Bullin
+*
+*/
+#include <fstream>
+#include <cstring>
+#include "loaders/sceneBlob.h"
+
+namespace Engine
+{
+	namespace
+	{
+		//! alignOffset()
+		/*!
+		\param offset a const uint32_t - The offset
+		\return a const uint32_t - The offset rounded up so any record can start there
+		*/
+		const uint32_t alignOffset(const uint32_t offset)
+		{
+			return (offset + 7) & ~7u;
+		}
+
+		template<typename T>
+		//! appendSection()
+		/*!
+		\param blob a std::vector<char>& - The blob being built
+		\param elements a const std::vector<T>& - The elements to append
+		\return a BlobSection - Where the elements were placed
+		*/
+		BlobSection appendSection(std::vector<char>& blob, const std::vector<T>& elements)
+		{
+			BlobSection section;
+			section.offset = alignOffset(static_cast<uint32_t>(blob.size()));
+			section.count = static_cast<uint32_t>(elements.size());
+
+			blob.resize(section.offset + elements.size() * sizeof(T));
+			if (!elements.empty())
+				memcpy(blob.data() + section.offset, elements.data(), elements.size() * sizeof(T));
+
+			return section;
+		}
+	}
+
+	//! SceneBlob()
+	SceneBlob::SceneBlob()
+	{
+	}
+
+	template<typename T>
+	//! checkSection()
+	/*!
+	\param section a const BlobSection& - The section
+	\return a const bool - Does the section lie within the blob
+	*/
+	const bool SceneBlob::checkSection(const BlobSection& section) const
+	{
+		return section.offset % alignof(T) == 0 && static_cast<uint64_t>(section.offset) + static_cast<uint64_t>(section.count) * sizeof(T) <= m_data.size();
+	}
+
+	//! setData()
+	/*!
+	\param data a std::vector<char>&& - The blob
+	\return a const bool - Was the blob valid
+	*/
+	const bool SceneBlob::setData(std::vector<char>&& data)
+	{
+		m_data = std::move(data);
+
+		if (!isValid())
+		{
+			m_data.clear();
+			return false;
+		}
+
+		// Every index a record holds is checked once here, so walking the blob needs no checks
+		const SceneBlobHeader& header = getHeader();
+		const uint32_t* strings = getSection<uint32_t>(header.strings);
+		for (uint32_t i = 0; i < header.strings.count; i++)
+		{
+			if (strings[i] >= header.characters.count)
+			{
+				m_data.clear();
+				return false;
+			}
+		}
+
+		const uint32_t* resources = getResources();
+		for (uint32_t i = 0; i < header.resources.count; i++)
+		{
+			if (resources[i] >= header.strings.count)
+			{
+				m_data.clear();
+				return false;
+			}
+		}
+
+		const BlobEntity* entities = getEntities();
+		for (uint32_t i = 0; i < header.entities.count; i++)
+		{
+			const BlobEntity& entity = entities[i];
+			if (entity.name >= header.strings.count || entity.layer >= header.strings.count || entity.descendantCount >= header.entities.count - i ||
+				static_cast<uint64_t>(entity.firstComponent) + entity.componentCount > header.components.count)
+			{
+				m_data.clear();
+				return false;
+			}
+		}
+
+		const BlobComponent* components = getComponents();
+		for (uint32_t i = 0; i < header.components.count; i++)
+		{
+			const BlobComponent& component = components[i];
+			bool valid = component.name < header.strings.count && static_cast<uint64_t>(component.firstValue) + component.valueCount <= header.values.count &&
+				static_cast<uint64_t>(component.scriptDataOffset) + component.scriptDataSize <= header.scriptData.count;
+			for (auto& string : component.strings)
+				valid = valid && (string == SceneBlobFormat::NoIndex || string < header.strings.count);
+			for (auto& resource : component.resources)
+				valid = valid && (resource == SceneBlobFormat::NoIndex || resource < header.resources.count);
+
+			if (!valid)
+			{
+				m_data.clear();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//! readFromFile()
+	/*!
+	\param filePath a const std::string& - The file to read
+	\return a const bool - Was a valid blob read
+	*/
+	const bool SceneBlob::readFromFile(const std::string& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) return false;
+
+		// The blob is read in one go and used as is
+		std::vector<char> data(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(data.data(), data.size());
+		if (!file) return false;
+
+		return setData(std::move(data));
+	}
+
+	//! writeToFile()
+	/*!
+	\param filePath a const std::string& - The file to write
+	\return a const bool - Was the blob written
+	*/
+	const bool SceneBlob::writeToFile(const std::string& filePath) const
+	{
+		if (!isValid()) return false;
+
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) return false;
+
+		file.write(m_data.data(), m_data.size());
+		return static_cast<bool>(file);
+	}
+
+	//! isValid()
+	/*!
+	\return a const bool - Does the blob hold valid data
+	*/
+	const bool SceneBlob::isValid() const
+	{
+		if (m_data.size() < sizeof(SceneBlobHeader)) return false;
+
+		const SceneBlobHeader& header = getHeader();
+		if (header.magic != SceneBlobFormat::Magic || header.version != SceneBlobFormat::Version || header.totalSize != m_data.size())
+			return false;
+
+		// Strings must end inside the character section
+		if (header.characters.count == 0 || getSection<char>(header.characters)[header.characters.count - 1] != '\0')
+			return false;
+
+		return checkSection<BlobEntity>(header.entities) && checkSection<BlobComponent>(header.components) && checkSection<float>(header.values) &&
+			checkSection<uint32_t>(header.resources) && checkSection<uint32_t>(header.strings) && checkSection<char>(header.characters) && checkSection<uint8_t>(header.scriptData);
+	}
+
+	//! matchesSource()
+	/*!
+	\param sourceSize a const uint64_t - The size of the JSON file
+	\param sourceTime a const int64_t - The write time of the JSON file
+	\return a const bool - Was the blob compiled from this version of the source
+	*/
+	const bool SceneBlob::matchesSource(const uint64_t sourceSize, const int64_t sourceTime) const
+	{
+		return isValid() && getHeader().sourceSize == sourceSize && getHeader().sourceTime == sourceTime;
+	}
+
+	//! addEntity()
+	/*!
+	\return a const uint32_t - The index of the new entity record
+	*/
+	const uint32_t SceneBlobBuilder::addEntity()
+	{
+		m_entities.push_back({ SceneBlobFormat::NoIndex, SceneBlobFormat::NoIndex, 0, static_cast<uint32_t>(m_components.size()), 0, 0 });
+		return static_cast<uint32_t>(m_entities.size() - 1);
+	}
+
+	//! addComponent()
+	/*!
+	\return a const uint32_t - The index of the new component record
+	*/
+	const uint32_t SceneBlobBuilder::addComponent()
+	{
+		m_components.push_back({ 0, SceneBlobFormat::NoIndex, 0, static_cast<uint32_t>(m_values.size()), 0,
+			{ SceneBlobFormat::NoIndex, SceneBlobFormat::NoIndex }, { SceneBlobFormat::NoIndex, SceneBlobFormat::NoIndex }, 0, 0 });
+		return static_cast<uint32_t>(m_components.size() - 1);
+	}
+
+	//! addString()
+	/*!
+	\param string a const std::string& - The string
+	\return a const uint32_t - The string index
+	*/
+	const uint32_t SceneBlobBuilder::addString(const std::string& string)
+	{
+		auto it = m_stringIndices.find(string);
+		if (it != m_stringIndices.end()) return it->second;
+
+		const uint32_t index = static_cast<uint32_t>(m_strings.size());
+		m_strings.push_back(static_cast<uint32_t>(m_characters.size()));
+		m_characters.insert(m_characters.end(), string.begin(), string.end());
+		m_characters.push_back('\0');
+
+		m_stringIndices[string] = index;
+		return index;
+	}
+
+	//! addResource()
+	/*!
+	\param resourceName a const std::string& - The name of the resource
+	\return a const uint32_t - The resource table index
+	*/
+	const uint32_t SceneBlobBuilder::addResource(const std::string& resourceName)
+	{
+		const uint32_t stringIndex = addString(resourceName);
+
+		auto it = m_resourceIndices.find(stringIndex);
+		if (it != m_resourceIndices.end()) return it->second;
+
+		const uint32_t index = static_cast<uint32_t>(m_resources.size());
+		m_resources.push_back(stringIndex);
+		m_resourceIndices[stringIndex] = index;
+		return index;
+	}
+
+	//! addValue()
+	/*!
+	\param componentIndex a const uint32_t - The index of the last component record added
+	\param value a const float - The value
+	*/
+	void SceneBlobBuilder::addValue(const uint32_t componentIndex, const float value)
+	{
+		// A component's values must all be added before the next component
+		m_values.push_back(value);
+		m_components[componentIndex].valueCount++;
+	}
+
+	//! addScriptData()
+	/*!
+	\param data a const std::vector<uint8_t>& - The encoded parameters
+	\return a const uint32_t - The offset of the parameters
+	*/
+	const uint32_t SceneBlobBuilder::addScriptData(const std::vector<uint8_t>& data)
+	{
+		const uint32_t offset = static_cast<uint32_t>(m_scriptData.size());
+		m_scriptData.insert(m_scriptData.end(), data.begin(), data.end());
+		return offset;
+	}
+
+	//! build()
+	/*!
+	\param sourceSize a const uint64_t - The size of the JSON file
+	\param sourceTime a const int64_t - The write time of the JSON file
+	\return a std::vector<char> - The blob
+	*/
+	std::vector<char> SceneBlobBuilder::build(const uint64_t sourceSize, const int64_t sourceTime) const
+	{
+		std::vector<char> blob(sizeof(SceneBlobHeader));
+
+		SceneBlobHeader header;
+		header.sourceSize = sourceSize;
+		header.sourceTime = sourceTime;
+		header.entities = appendSection(blob, m_entities);
+		header.components = appendSection(blob, m_components);
+		header.values = appendSection(blob, m_values);
+		header.resources = appendSection(blob, m_resources);
+		header.strings = appendSection(blob, m_strings);
+		header.characters = appendSection(blob, m_characters.empty() ? std::vector<char>(1, '\0') : m_characters);
+		header.scriptData = appendSection(blob, m_scriptData);
+		header.totalSize = static_cast<uint32_t>(blob.size());
+
+		memcpy(blob.data(), &header, sizeof(SceneBlobHeader));
+		return blob;
+	}
+}
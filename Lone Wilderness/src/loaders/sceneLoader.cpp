@@ -5,10 +5,12 @@
 * \author Daniel Bullin
 *
 */
+#include <filesystem>
 #include "loaders/sceneLoader.h"
 #include "independent/systems/systems/sceneManager.h"
 
 #include "scripts/gameObjects/player.h"
+#include "terrain/worldSave.h"
 #include "scripts/gameObjects/cyborg.h"
 #include "scripts/menus/mainMenuText.h"
 #include "scripts/menus/pauseMenuText.h"
@@ -27,6 +29,7 @@
 #include "scripts/engineScript.h"
 #include "scripts/testing/testScript.h"
 #include "scripts/FPSCounter.h"
+#include "scripts/statsOverlay.h"
 #include "scripts/gameTimer.h"
 #include "scripts/gameObjects/terrain.h"
 #include "scripts/gameObjects/placeObject.h"
@@ -51,58 +54,102 @@
 
 namespace Engine
 {
-	//! createNewScript()
-	/*!
-	\param scriptName a const std::string& - The name of the script
-	\return a NativeScript* - A pointer to the script
-	*/
-	NativeScript* SceneLoader::createNewScript(const std::string& scriptName, nlohmann::json scriptData)
+	namespace
 	{
-		// All subclasses of Entity must be added and returned here
-		// All subclasses of Entity must be added and returned here
-		if (scriptName == "Player") return new Player;
-		else if (scriptName == "Cyborg") return new Cyborg;
-		else if (scriptName == "FPSCounter") return new FPSCounter;
-		else if (scriptName == "MainMenuText") return new MainMenuText;
-		else if (scriptName == "PauseMenuText") return new PauseMenuText;
-		else if (scriptName == "SettingsMenuText") return new SettingsMenuText;
-		else if (scriptName == "StaticLight") return new StaticLight;
-		else if (scriptName == "CameraRotationScript") return new CameraRotationScript;
-		else if (scriptName == "ResourcesScript") return new ResourcesScript;
-		else if (scriptName == "PauseScript") return new PauseScript;
-		else if (scriptName == "SettingsScript") return new SettingsScript;
-		else if (scriptName == "EngineScript") return new EngineScript;
-		else if (scriptName == "KeybindText")
+		using ScriptFactory = NativeScript*(*)(const nlohmann::json&); //!< Type alias
+
+		template<typename T>
+		//! createScript()
+		/*!
+		\param scriptData a const nlohmann::json& - The script data, unused
+		\return a NativeScript* - A pointer to the script
+		*/
+		NativeScript* createScript(const nlohmann::json& scriptData)
 		{
-			if (scriptData.empty())
-				return new KeybindText;
-			else
-				return new KeybindText(scriptData);
+			return new T;
 		}
-		else if (scriptName == "TestScript") return new TestScript;
-		else if (scriptName == "Terrain") return new Terrain;
-		else if (scriptName == "Water") return new Water;
-		else if (scriptName == "PlaceObject") return new PlaceObject;
-		else if (scriptName == "Environment") return new Environment;
-		else if (scriptName == "GameTimer") return new GameTimer;
-		else if (scriptName == "Sun") return new Sun;
-		else if (scriptName == "InventoryMenu") return new InventoryMenu;
-		else if (scriptName == "CraftingMenu") return new CraftingMenu;
-		else if (scriptName == "CraftButton") return new CraftButton;
-		else if (scriptName == "InventoryElement")
+
+		template<typename T>
+		//! createScriptWithData()
+		/*!
+		\param scriptData a const nlohmann::json& - The script data
+		\return a NativeScript* - A pointer to the script
+		*/
+		NativeScript* createScriptWithData(const nlohmann::json& scriptData)
 		{
 			if (scriptData.empty())
-				return new InventoryElement;
+				return new T;
 			else
-				return new InventoryElement(scriptData);
+				return new T(scriptData);
 		}
-		else if (scriptName == "CraftingElement")
+
+		//! getValueCount()
+		/*!
+		\param type a const ComponentType - The component type
+		\return a const uint32_t - The number of numeric values a compiled component of this type holds
+		*/
+		const uint32_t getValueCount(const ComponentType type)
 		{
-			if (scriptData.empty())
-				return new CraftingElement;
-			else
-				return new CraftingElement(scriptData);
+			switch (type)
+			{
+				case ComponentType::Camera: return 16;
+				case ComponentType::Transform: return 9;
+				case ComponentType::Text: return 4;
+				case ComponentType::CharacterController: return 2;
+				case ComponentType::PointLight: return 12;
+				case ComponentType::SpotLight: return 17;
+				case ComponentType::DirectionalLight: return 12;
+				case ComponentType::UIElement: return 6;
+				default: return 0;
+			}
 		}
+	}
+
+	std::unordered_map<std::string, SceneBlob> SceneLoader::s_compiledEntities; //!< Initialise empty map
+
+	//! createNewScript()
+	/*!
+	\param scriptName a const std::string& - The name of the script
+	\param scriptData a const nlohmann::json& - The script data, passed to scripts which take parameters
+	\return a NativeScript* - A pointer to the script
+	*/
+	NativeScript* SceneLoader::createNewScript(const std::string& scriptName, const nlohmann::json& scriptData)
+	{
+		// All subclasses of NativeScript must be added here
+		static const std::unordered_map<std::string, ScriptFactory> scripts =
+		{
+			{ "Player", &createScript<Player> },
+			{ "Cyborg", &createScript<Cyborg> },
+			{ "FPSCounter", &createScript<FPSCounter> },
+			{ "StatsOverlay", &createScript<StatsOverlay> },
+			{ "MainMenuText", &createScript<MainMenuText> },
+			{ "PauseMenuText", &createScript<PauseMenuText> },
+			{ "SettingsMenuText", &createScript<SettingsMenuText> },
+			{ "StaticLight", &createScript<StaticLight> },
+			{ "CameraRotationScript", &createScript<CameraRotationScript> },
+			{ "ResourcesScript", &createScript<ResourcesScript> },
+			{ "PauseScript", &createScript<PauseScript> },
+			{ "SettingsScript", &createScript<SettingsScript> },
+			{ "EngineScript", &createScript<EngineScript> },
+			{ "KeybindText", &createScriptWithData<KeybindText> },
+			{ "TestScript", &createScript<TestScript> },
+			{ "Terrain", &createScript<Terrain> },
+			{ "Water", &createScript<Water> },
+			{ "PlaceObject", &createScript<PlaceObject> },
+			{ "Environment", &createScript<Environment> },
+			{ "GameTimer", &createScript<GameTimer> },
+			{ "Sun", &createScript<Sun> },
+			{ "InventoryMenu", &createScript<InventoryMenu> },
+			{ "CraftingMenu", &createScript<CraftingMenu> },
+			{ "CraftButton", &createScript<CraftButton> },
+			{ "InventoryElement", &createScriptWithData<InventoryElement> },
+			{ "CraftingElement", &createScriptWithData<CraftingElement> }
+		};
+
+		auto it = scripts.find(scriptName);
+		if (it != scripts.end())
+			return it->second(scriptData);
+
 		return nullptr;
 	}
 
@@ -141,13 +188,14 @@ namespace Engine
 		else return nullptr;
 	}
 
+
 	//! loadSceneProperties()
 	/*
 	\param scene a Scene* - A pointer to the scene we're loading
-	\param sceneData a json - The scene's JSON data
+	\param sceneData a const json& - The scene's JSON data
 	\return a bool - The success value
 	*/
-	bool SceneLoader::loadSceneProperties(Scene* scene, json sceneData)
+	bool SceneLoader::loadSceneProperties(Scene* scene, const json& sceneData)
 	{
 		if (scene)
 		{
@@ -192,13 +240,293 @@ namespace Engine
 		return false;
 	}
 
-	//! loadSceneProperties()
+	//! compileEntity()
+	/*
+	\param builder a SceneBlobBuilder& - The blob being built
+	\param entityData a const json& - The entity's JSON data
+	*/
+	void SceneLoader::compileEntity(SceneBlobBuilder& builder, const json& entityData)
+	{
+		// Entities are stored depth first, each followed by its whole subtree
+		const uint32_t entityIndex = builder.addEntity();
+		const uint32_t name = builder.addString(entityData.at("name").get<std::string>());
+		const uint32_t layer = builder.addString(entityData.at("layer").get<std::string>());
+
+		BlobEntity& entityRecord = builder.getEntity(entityIndex);
+		entityRecord.name = name;
+		entityRecord.layer = layer;
+		entityRecord.display = entityData.at("display").get<bool>();
+
+		if (entityData.contains("components"))
+		{
+			compileComponents(builder, entityData["components"]);
+			builder.getEntity(entityIndex).componentCount = static_cast<uint32_t>(entityData["components"].size());
+		}
+
+		if (entityData.contains("childEntities"))
+		{
+			for (auto& child : entityData["childEntities"])
+				compileEntity(builder, child);
+		}
+
+		builder.getEntity(entityIndex).descendantCount = builder.getEntityCount() - entityIndex - 1;
+	}
+
+	//! compileComponents()
+	/*
+	\param builder a SceneBlobBuilder& - The blob being built
+	\param componentData a const json& - The json data for the components
+	*/
+	void SceneLoader::compileComponents(SceneBlobBuilder& builder, const json& componentData)
+	{
+		for (auto& component : componentData)
+		{
+			const uint32_t componentIndex = builder.addComponent();
+			const ComponentType componentType = Components::toType(component.at("type").get<std::string>());
+			const uint32_t name = builder.addString(component.at("name").get<std::string>());
+
+			// Numeric values are stored in the order the loader reads them back
+			auto addValues = [&](const char* key)
+			{
+				for (auto& value : component.at(key))
+					builder.addValue(componentIndex, value.get<float>());
+			};
+			auto addValue = [&](const char* key)
+			{
+				builder.addValue(componentIndex, component.at(key).get<float>());
+			};
+
+			uint32_t flags = 0;
+			uint32_t strings[2] = { SceneBlobFormat::NoIndex, SceneBlobFormat::NoIndex };
+			uint32_t resources[2] = { SceneBlobFormat::NoIndex, SceneBlobFormat::NoIndex };
+			uint32_t scriptDataOffset = 0;
+			uint32_t scriptDataSize = 0;
+
+			switch (componentType)
+			{
+				case ComponentType::Camera:
+				{
+					addValues("front");
+					addValues("up");
+					addValues("worldUp");
+					addValue("Yaw");
+					addValue("Pitch");
+					addValue("Zoom");
+					addValues("clearColour");
+
+					if (component.contains("skybox") && component["skybox"].size() != 0)
+					{
+						resources[0] = builder.addResource(component["skybox"][0].at("model").get<std::string>());
+						resources[1] = builder.addResource(component["skybox"][0].at("material").get<std::string>());
+					}
+
+					flags = component.at("setMainCamera").get<bool>();
+					break;
+				}
+				case ComponentType::Transform:
+				{
+					addValues("position");
+					addValues("rotation");
+					addValues("scale");
+					break;
+				}
+				case ComponentType::Text:
+				{
+					strings[0] = builder.addString(component.at("text").get<std::string>());
+					strings[1] = builder.addString(component.at("fontName").get<std::string>());
+					addValues("colour");
+					break;
+				}
+				case ComponentType::CharacterController:
+				{
+					addValue("speed");
+					addValue("sensitivity");
+					flags = component.at("frozen").get<bool>();
+					break;
+				}
+				case ComponentType::MeshRender3D:
+				{
+					resources[0] = builder.addResource(component.at("modelName").get<std::string>());
+					resources[1] = builder.addResource(component.at("materialName").get<std::string>());
+					break;
+				}
+				case ComponentType::MeshRender2D:
+				{
+					resources[0] = builder.addResource(component.at("materialName").get<std::string>());
+					break;
+				}
+				case ComponentType::PointLight:
+				{
+					addValues("ambient");
+					addValues("diffuse");
+					addValues("specular");
+					addValue("constant");
+					addValue("linear");
+					addValue("quadratic");
+					break;
+				}
+				case ComponentType::SpotLight:
+				{
+					addValues("direction");
+					addValues("ambient");
+					addValues("diffuse");
+					addValues("specular");
+					addValue("cutOff");
+					addValue("outerCutOff");
+					addValue("constant");
+					addValue("linear");
+					addValue("quadratic");
+					break;
+				}
+				case ComponentType::DirectionalLight:
+				{
+					addValues("direction");
+					addValues("ambient");
+					addValues("diffuse");
+					addValues("specular");
+					break;
+				}
+				case ComponentType::UIElement:
+				{
+					addValues("anchor");
+					addValues("offset");
+					addValues("scale");
+					flags = component.at("useAbsoluteSize").get<bool>();
+					break;
+				}
+				case ComponentType::NativeScript:
+				{
+					strings[0] = builder.addString(component.at("scriptName").get<std::string>());
+
+					// Anything beyond the common keys is a script parameter, kept as MessagePack
+					json scriptData = component;
+					scriptData.erase("name");
+					scriptData.erase("type");
+					scriptData.erase("scriptName");
+					if (!scriptData.empty())
+					{
+						const std::vector<uint8_t> encoded = json::to_msgpack(scriptData);
+						scriptDataOffset = builder.addScriptData(encoded);
+						scriptDataSize = static_cast<uint32_t>(encoded.size());
+					}
+					break;
+				}
+				default:
+				{
+					// Stored anyway so every load still reports it
+					ENGINE_ERROR("[SceneLoader::compileComponents] An invalid component type was provided. Type: {0}.", component.at("type").get<std::string>());
+					break;
+				}
+			}
+
+			BlobComponent& componentRecord = builder.getComponent(componentIndex);
+			componentRecord.type = static_cast<uint32_t>(componentType);
+			componentRecord.name = name;
+			componentRecord.flags = flags;
+			componentRecord.strings[0] = strings[0];
+			componentRecord.strings[1] = strings[1];
+			componentRecord.resources[0] = resources[0];
+			componentRecord.resources[1] = resources[1];
+			componentRecord.scriptDataOffset = scriptDataOffset;
+			componentRecord.scriptDataSize = scriptDataSize;
+		}
+	}
+
+	//! compile()
+	/*!
+	\param entityFilePath a const std::string& - The filepath to the entity json file
+	\param blob a SceneBlob& - The blob to fill
+	\return a bool - Was the file compiled
+	*/
+	bool SceneLoader::compile(const std::string& entityFilePath, SceneBlob& blob)
+	{
+		std::error_code error;
+		const uint64_t sourceSize = std::filesystem::file_size(entityFilePath, error);
+		const int64_t sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(entityFilePath, error).time_since_epoch().count());
+		if (error)
+		{
+			ENGINE_ERROR("[SceneLoader::compile] Cannot find the entity file. Path: {0}.", entityFilePath);
+			return false;
+		}
+
+		json entityData = ResourceManager::getJSON(entityFilePath);
+		SceneBlobBuilder builder;
+
+		try
+		{
+			if (entityData.contains("entities"))
+			{
+				for (auto& rootEntity : entityData["entities"])
+					compileEntity(builder, rootEntity);
+			}
+		}
+		catch (const json::exception& e)
+		{
+			ENGINE_ERROR("[SceneLoader::compile] The entity file is missing data. Path: {0}. Reason: {1}", entityFilePath, e.what());
+			return false;
+		}
+
+		if (!blob.setData(builder.build(sourceSize, sourceTime)))
+		{
+			ENGINE_ERROR("[SceneLoader::compile] The compiled entity file is invalid. Path: {0}.", entityFilePath);
+			return false;
+		}
+
+		// A missing blob only means the file is compiled again next run
+		if (!blob.writeToFile(getCompiledPath(entityFilePath)))
+			ENGINE_WARN("[SceneLoader::compile] Cannot write the compiled entity file. Path: {0}.", getCompiledPath(entityFilePath));
+
+		return true;
+	}
+
+	//! getCompiledPath()
+	/*!
+	\param entityFilePath a const std::string& - The filepath to the entity json file
+	\return a std::string - The filepath of the compiled entity file
+	*/
+	std::string SceneLoader::getCompiledPath(const std::string& entityFilePath)
+	{
+		return entityFilePath.substr(0, entityFilePath.find_last_of('.')) + ".scenebin";
+	}
+
+	//! getCompiledEntities()
+	/*!
+	\param entityFilePath a const std::string& - The filepath to the entity json file
+	\return a const SceneBlob* - The compiled entity file, nullptr if it could not be compiled
+	*/
+	const SceneBlob* SceneLoader::getCompiledEntities(const std::string& entityFilePath)
+	{
+		std::error_code error;
+		const uint64_t sourceSize = std::filesystem::file_size(entityFilePath, error);
+		const int64_t sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(entityFilePath, error).time_since_epoch().count());
+		if (error)
+		{
+			ENGINE_ERROR("[SceneLoader::getCompiledEntities] Cannot find the entity file. Path: {0}.", entityFilePath);
+			return nullptr;
+		}
+
+		// The JSON is the source of truth, a blob is only used while it matches it
+		SceneBlob& blob = s_compiledEntities[entityFilePath];
+		if (blob.matchesSource(sourceSize, sourceTime))
+			return &blob;
+
+		if (blob.readFromFile(getCompiledPath(entityFilePath)) && blob.matchesSource(sourceSize, sourceTime))
+			return &blob;
+
+		if (compile(entityFilePath, blob))
+			return &blob;
+
+		return nullptr;
+	}
+
+	//! loadEntityProperties()
 	/*
 	\param entity a Entity* - A pointer to the entity we're loading
-	\param entityData a json - The entity's JSON data
+	\param blob a const SceneBlob& - The compiled entity file
+	\param entityRecord a const BlobEntity& - The entity's record
 	\return a bool - The success value
 	*/
-	bool SceneLoader::loadEntityProperties(Entity* entity, json entityData)
+	bool SceneLoader::loadEntityProperties(Entity* entity, const SceneBlob& blob, const BlobEntity& entityRecord)
 	{
 		if (entity)
 		{
@@ -206,8 +534,8 @@ namespace Engine
 
 			if (layerManager)
 			{
-				entity->setLayer(layerManager->getLayer(entityData["layer"].get<std::string>()));
-				entity->setDisplay(entityData["display"].get<bool>());
+				entity->setLayer(layerManager->getLayer(blob.getString(entityRecord.layer)));
+				entity->setDisplay(entityRecord.display != 0);
 				return true;
 			}
 			else
@@ -223,11 +551,15 @@ namespace Engine
 	/*
 	\param scene a Scene* - A pointer to the scene
 	\param parent an Entity* - A pointer to the parent entity
-	\param entityData a json - The entity's JSON data
+	\param blob a const SceneBlob& - The compiled entity file
+	\param resources a const std::vector<Resource*>& - The resolved resource table
+	\param entityIndex a uint32_t& - The index of the entity, moved past its subtree
 	*/
-	void SceneLoader::loadEntity(Scene* scene, Entity* parent, json entityData)
+	void SceneLoader::loadEntity(Scene* scene, Entity* parent, const SceneBlob& blob, const std::vector<Resource*>& resources, uint32_t& entityIndex)
 	{
-		std::string entityName = entityData["name"].get<std::string>();
+		const BlobEntity& entityRecord = blob.getEntities()[entityIndex];
+		const uint32_t subtreeEnd = entityIndex + entityRecord.descendantCount + 1;
+		const std::string entityName = blob.getString(entityRecord.name);
 
 		Entity* newEntity = new Entity;
 
@@ -236,17 +568,22 @@ namespace Engine
 		else
 			scene->addEntity(entityName, newEntity);
 
-		bool entityCoreSuccess = loadEntityProperties(newEntity, entityData);
-		loadComponents(scene, newEntity, entityData["components"]);
+		bool entityCoreSuccess = loadEntityProperties(newEntity, blob, entityRecord);
+		loadComponents(scene, newEntity, blob, entityRecord, resources);
 
-		for (auto& child : entityData["childEntities"])
+		entityIndex++;
+		while (entityIndex < subtreeEnd)
 		{
-			if (!newEntity->checkChildEntityNameTaken(child["name"].get<std::string>()))
+			const BlobEntity& child = blob.getEntities()[entityIndex];
+			if (!newEntity->checkChildEntityNameTaken(blob.getString(child.name)))
 			{
-				loadEntity(scene, newEntity, child);
+				loadEntity(scene, newEntity, blob, resources, entityIndex);
 			}
 			else
-				ENGINE_ERROR("[SceneLoader::loadEntity] Child name already taken. Parent: {0}, Child: {1}.", entityName, child["name"].get<std::string>());
+			{
+				ENGINE_ERROR("[SceneLoader::loadEntity] Child name already taken. Parent: {0}, Child: {1}.", entityName, blob.getString(child.name));
+				entityIndex += child.descendantCount + 1;
+			}
 		}
 	}
 
@@ -254,97 +591,123 @@ namespace Engine
 	/*
 	\param scene a Scene* - A pointer to the scene
 	\param entity an Entity* - A pointer to an entity
-	\param componentData a json - The json data for the components
+	\param blob a const SceneBlob& - The compiled entity file
+	\param entityRecord a const BlobEntity& - The entity's record
+	\param resources a const std::vector<Resource*>& - The resolved resource table
 	*/
-	void SceneLoader::loadComponents(Scene* scene, Entity* entity, json componentData)
+	void SceneLoader::loadComponents(Scene* scene, Entity* entity, const SceneBlob& blob, const BlobEntity& entityRecord, const std::vector<Resource*>& resources)
 	{
 		/////
 		// Loading all components
 		/////
 
-		for (auto& component : componentData)
+		for (uint32_t i = 0; i < entityRecord.componentCount; i++)
 		{
-			std::string compName = component["name"].get<std::string>();
-			ComponentType componentType = Components::toType(component["type"].get<std::string>());
+			const BlobComponent& component = blob.getComponents()[entityRecord.firstComponent + i];
+			const ComponentType componentType = static_cast<ComponentType>(component.type);
+			const std::string compName = blob.getString(component.name);
+			const float* values = blob.getValues() + component.firstValue;
+
+			if (component.valueCount != getValueCount(componentType))
+			{
+				ENGINE_ERROR("[SceneLoader::loadComponents] The component has the wrong number of values. Entity Name: {0}. Component Name: {1}.", entity->getName(), compName);
+				continue;
+			}
+
+			// Resource handles are looked up once per file, these only index the table
+			auto getResource = [&](const uint32_t slot) -> Resource*
+			{
+				return slot == SceneBlobFormat::NoIndex ? nullptr : resources[slot];
+			};
 
 			switch (componentType)
 			{
 			case ComponentType::Camera:
 			{
-				CameraData camData({ component["front"][0], component["front"][1], component["front"][2] }, { component["up"][0], component["up"][1], component["up"][2] }, { component["worldUp"][0], component["worldUp"][1], component["worldUp"][2] }, component["Yaw"], component["Pitch"], component["Zoom"]);
+				CameraData camData({ values[0], values[1], values[2] }, { values[3], values[4], values[5] }, { values[6], values[7], values[8] }, values[9], values[10], values[11]);
 				entity->attach<Camera>(compName, camData);
-				entity->getComponent<Camera>()->setClearColour({ component["clearColour"][0], component["clearColour"][1] , component["clearColour"][2] , component["clearColour"][3] });
+				entity->getComponent<Camera>()->setClearColour({ values[12], values[13], values[14], values[15] });
 
 				// Load the cameras skybox if it has one
-				if (component["skybox"].size() != 0)
-					entity->getComponent<Camera>()->setSkybox(new Skybox(ResourceManager::getResource<Model3D>(component["skybox"][0]["model"].get<std::string>()), ResourceManager::getResource<Material>(component["skybox"][0]["material"].get<std::string>())));
+				if (component.resources[0] != SceneBlobFormat::NoIndex)
+					entity->getComponent<Camera>()->setSkybox(new Skybox(static_cast<Model3D*>(getResource(component.resources[0])), static_cast<Material*>(getResource(component.resources[1]))));
 
 				// Camera is main camera, set the scene's main camera to this
-				if (component["setMainCamera"].get<bool>())
+				if (component.flags)
 					scene->setMainCamera(entity->getComponent<Camera>());
 
 				break;
 			}
 			case ComponentType::Transform:
 			{
-				entity->attach<Transform>(compName, component["position"][0], component["position"][1], component["position"][2], component["rotation"][0], component["rotation"][1], component["rotation"][2], component["scale"][0], component["scale"][1], component["scale"][2]);
+				entity->attach<Transform>(compName, values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7], values[8]);
 				break;
 			}
 			case ComponentType::Text:
 			{
-				entity->attach<Text>(compName, component["text"].get<std::string>(), glm::vec4(component["colour"][0], component["colour"][1], component["colour"][2], component["colour"][3]), component["fontName"].get<std::string>());
+				entity->attach<Text>(compName, blob.getString(component.strings[0]), glm::vec4(values[0], values[1], values[2], values[3]), blob.getString(component.strings[1]));
 				break;
 			}
 			case ComponentType::CharacterController:
 			{
-				entity->attach<CharacterController>(compName, component["speed"], component["sensitivity"], component["frozen"].get<bool>());
+				entity->attach<CharacterController>(compName, values[0], values[1], component.flags != 0);
 				break;
 			}
 			case ComponentType::MeshRender3D:
 			{
-				entity->attach<MeshRender3D>(compName, ResourceManager::getResource<Model3D>(component["modelName"].get<std::string>()), ResourceManager::getResource<Material>(component["materialName"].get<std::string>()));
+				entity->attach<MeshRender3D>(compName, static_cast<Model3D*>(getResource(component.resources[0])), static_cast<Material*>(getResource(component.resources[1])));
 				break;
 			}
 			case ComponentType::MeshRender2D:
 			{
-				entity->attach<MeshRender2D>(compName, ResourceManager::getResource<Material>(component["materialName"].get<std::string>()));
+				entity->attach<MeshRender2D>(compName, static_cast<Material*>(getResource(component.resources[0])));
 				break;
 			}
 			case ComponentType::PointLight:
 			{
-				entity->attach<PointLight>(compName, glm::vec3(component["ambient"][0], component["ambient"][1], component["ambient"][2]), glm::vec3(component["diffuse"][0], component["diffuse"][1], component["diffuse"][2]), glm::vec3(component["specular"][0], component["specular"][1], component["specular"][2]), component["constant"], component["linear"], component["quadratic"]);
+				entity->attach<PointLight>(compName, glm::vec3(values[0], values[1], values[2]), glm::vec3(values[3], values[4], values[5]), glm::vec3(values[6], values[7], values[8]), values[9], values[10], values[11]);
 				break;
 			}
 			case ComponentType::SpotLight:
 			{
-				entity->attach<SpotLight>(compName, glm::vec3(component["direction"][0], component["direction"][1], component["direction"][2]), glm::vec3(component["ambient"][0], component["ambient"][1], component["ambient"][2]), glm::vec3(component["diffuse"][0], component["diffuse"][1], component["diffuse"][2]), glm::vec3(component["specular"][0], component["specular"][1], component["specular"][2]), component["cutOff"], component["outerCutOff"], component["constant"], component["linear"], component["quadratic"]);
+				entity->attach<SpotLight>(compName, glm::vec3(values[0], values[1], values[2]), glm::vec3(values[3], values[4], values[5]), glm::vec3(values[6], values[7], values[8]), glm::vec3(values[9], values[10], values[11]), values[12], values[13], values[14], values[15], values[16]);
 				break;
 			}
 			case ComponentType::DirectionalLight:
 			{
-				entity->attach<DirectionalLight>(compName, glm::vec3(component["direction"][0], component["direction"][1], component["direction"][2]), glm::vec3(component["ambient"][0], component["ambient"][1], component["ambient"][2]), glm::vec3(component["diffuse"][0], component["diffuse"][1], component["diffuse"][2]), glm::vec3(component["specular"][0], component["specular"][1], component["specular"][2]));
+				entity->attach<DirectionalLight>(compName, glm::vec3(values[0], values[1], values[2]), glm::vec3(values[3], values[4], values[5]), glm::vec3(values[6], values[7], values[8]), glm::vec3(values[9], values[10], values[11]));
 				break;
 			}
 			case ComponentType::UIElement:
 			{
-				entity->attach<UIElement>(compName, glm::vec2(component["anchor"][0], component["anchor"][1]), glm::vec2(component["offset"][0], component["offset"][1]), glm::vec2(component["scale"][0], component["scale"][1]), component["useAbsoluteSize"].get<bool>());
+				entity->attach<UIElement>(compName, glm::vec2(values[0], values[1]), glm::vec2(values[2], values[3]), glm::vec2(values[4], values[5]), component.flags != 0);
 				break;
 			}
 			case ComponentType::NativeScript:
 			{
-				NativeScript* script = createNewScript(component["scriptName"].get<std::string>(), component);
-				script->setName(compName);
+				// Only scripts which take parameters decode anything
+				json scriptData;
+				if (component.scriptDataSize > 0)
+				{
+					const uint8_t* data = blob.getScriptData(component.scriptDataOffset);
+					scriptData = json::from_msgpack(data, data + component.scriptDataSize);
+				}
+
+				NativeScript* script = createNewScript(blob.getString(component.strings[0]), scriptData);
 
 				if (script)
+				{
+					script->setName(compName);
 					entity->attach<NativeScript>(script);
+				}
 				else
-					ENGINE_ERROR("[SceneLoader::loadComponents] The script name provided isn't a valid script name. Script: {0}.", component["scriptName"].get<std::string>());
+					ENGINE_ERROR("[SceneLoader::loadComponents] The script name provided isn't a valid script name. Script: {0}.", blob.getString(component.strings[0]));
 
 				break;
 			}
 			default:
 			{
-				ENGINE_ERROR("[SceneLoader::loadComponents] An invalid component type was provided. Entity Name: {0}. Type: {1}.", entity->getName(), component["type"].get<std::string>());
+				ENGINE_ERROR("[SceneLoader::loadComponents] An invalid component type was provided. Entity Name: {0}. Component Name: {1}.", entity->getName(), compName);
 				break;
 			}
 			}
@@ -378,6 +741,10 @@ namespace Engine
 			json sceneData = ResourceManager::getJSON(sceneFolderPath + "config.json");
 			bool coreLoadSuccess = loadSceneProperties(scene, sceneData);
 
+			// The world is opened before any entity is attached, so whatever order the entities are in they can all read the save
+			if (sceneData.value("worldSave", false))
+				WorldSave::open();
+
 			loadEntities(scene, sceneFolderPath + "entities.json");
 		}
 		else
@@ -394,18 +761,32 @@ namespace Engine
 		/////
 		// Loading Entities
 		/////
-		json sceneData = ResourceManager::getJSON(entityFilePath);
-
-		// Go through each entity and add its components
-		for (auto& rootEntity : sceneData["entities"])
+		const SceneBlob* blob = getCompiledEntities(entityFilePath);
+		if (!blob) return;
+
+		// Resolve every resource the file uses once
+		const uint32_t resourceCount = blob->getHeader().resources.count;
+		std::vector<Resource*> resources;
+		resources.reserve(resourceCount);
+		for (uint32_t i = 0; i < resourceCount; i++)
+			resources.push_back(ResourceManager::getResource<Resource>(blob->getString(blob->getResources()[i])));
+
+		// Go through each root entity, each is followed by its children
+		const uint32_t entityCount = blob->getHeader().entities.count;
+		uint32_t entityIndex = 0;
+		while (entityIndex < entityCount)
 		{
-			std::string rootEntityName = rootEntity["name"].get<std::string>();
+			const BlobEntity& rootEntity = blob->getEntities()[entityIndex];
+			const std::string rootEntityName = blob->getString(rootEntity.name);
 			if (!scene->checkRootEntityNameTaken(rootEntityName))
 			{
-				loadEntity(scene, nullptr, rootEntity);
+				loadEntity(scene, nullptr, *blob, resources, entityIndex);
 			}
 			else
+			{
 				ENGINE_ERROR("[SceneLoader::loadEntities] This root entity name is already taken. Name: {0}.", rootEntityName);
+				entityIndex += rootEntity.descendantCount + 1;
+			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -12,7 +12,8 @@
 //! FPSCounter()
 FPSCounter::FPSCounter()
 {
-	TimerSystem::startTimer("FPSRefresh");
+	// The text only changes once a second
+	tick(TickGroup::PostUpdate, 1.f);
 }
 
 //! ~FPSCounter()
@@ -36,13 +37,8 @@ void FPSCounter::onPreUpdate(const float timestep, const float totalTime)
 */
 void FPSCounter::onPostUpdate(const float timestep, const float totalTime)
 {
-	if (TimerSystem::getTime("FPSRefresh", false, true) > 1.f)
-	{
-		Text* text = getParent()->getComponent<Text>();
+	Text* text = getParent()->getComponent<Text>();
 
-		if (text)
-			text->setText("FPS: " + std::to_string(static_cast<uint32_t>(TimerSystem::getFPS())));
-
-		TimerSystem::stopTimer("FPSRefresh", false, true);
-	}
+	if (text)
+		text->setText("FPS: " + std::to_string(static_cast<uint32_t>(TimerSystem::getFPS())));
 }
\ No newline at end of file
@@ -9,10 +9,13 @@
 #include "settings/settings.h"
 #include "independent/systems/systems/sceneManager.h"
 #include "independent/systems/systems/windowManager.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/counterSystem.h"
 
 //! EngineScript()
 EngineScript::EngineScript()
 {
+	subscribe(EventType::KeyReleased);
 }
 
 //! ~OwlEngine()
@@ -35,4 +38,17 @@ void EngineScript::onKeyRelease(KeyReleasedEvent & e, const float timestep, cons
 	{
 		ResourceManager::setConfigValue(Config::ApplyFog, !ResourceManager::getConfigValue(Config::ApplyFog));
 	}
+
+	// Capture the next few seconds of frames, open the file in chrome://tracing or Perfetto
+	if (e.getKeyCode() == Keys::F9 && !Profiler::isCapturing())
+		Profiler::beginCapture(300, "profile.json");
+
+	// Start or stop writing the counters of every frame to file
+	if (e.getKeyCode() == Keys::F10)
+	{
+		if (CounterSystem::isDumping())
+			CounterSystem::stopDump();
+		else
+			CounterSystem::startDump("counters.csv", DumpFormat::CSV);
+	}
 }
\ No newline at end of file
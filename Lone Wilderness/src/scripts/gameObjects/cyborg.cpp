@@ -8,11 +8,15 @@
 #include "scripts/gameObjects/cyborg.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/entities/entity.h"
+#include "independent/systems/systems/inputManager.h"
 
 //! Cyborg()
 Cyborg::Cyborg()
 {
 	m_controller = nullptr;
+
+	subscribe(EventType::KeyReleased);
+	tick(TickGroup::PreUpdate);
 }
 
 //! ~Cyborg()
@@ -26,49 +30,27 @@ Cyborg::~Cyborg()
 \param totalTime a const float - The total time of the application
 */
 void Cyborg::onPreUpdate(const float timestep, const float totalTime)
-{
-}
-
-//! onKeyPress()
-/*!
-\param e a KeyPressedEvent& - A key press event
-\param timestep a const float - The timestep
-\param totalTime a const float - The total time of the application
-*/
-void Cyborg::onKeyPress(KeyPressedEvent & e, const float timestep, const float totalTime)
 {
 	if (!m_controller) m_controller = getParent()->getComponent<CharacterController>();
 	else
 	{
-		if (e.getKeyCode() == Keys::UP)
-		{
+		if (InputManager::isKeyDown(Keys::UP))
 			m_controller->move(FORWARD, timestep);
-		}
 
-		if (e.getKeyCode() == Keys::DOWN)
-		{
+		if (InputManager::isKeyDown(Keys::DOWN))
 			m_controller->move(BACKWARD, timestep);
-		}
 
-		if (e.getKeyCode() == Keys::LEFT)
-		{
+		if (InputManager::isKeyDown(Keys::LEFT))
 			m_controller->move(LEFT, timestep);
-		}
 
-		if (e.getKeyCode() == Keys::RIGHT)
-		{
+		if (InputManager::isKeyDown(Keys::RIGHT))
 			m_controller->move(RIGHT, timestep);
-		}
 
-		if (e.getKeyCode() == Keys::SPACE)
-		{
+		if (InputManager::isKeyDown(Keys::SPACE))
 			m_controller->move(UP, timestep);
-		}
 
-		if (e.getKeyCode() == Keys::X)
-		{
+		if (InputManager::isKeyDown(Keys::X))
 			m_controller->move(RIGHT, timestep);
-		}
 	}
 }
 
@@ -8,10 +8,10 @@
 #include "scripts/gameObjects/environment.h"
 #include "scripts/gameObjects/player.h"
 #include "independent/rendering/renderers/renderer3D.h"
-#include "independent/utils/mathUtils.h"
+#include "independent/utils/batchTransforms.h"
 #include "scripts/gameObjects/terrain.h"
 #include "independent/systems/systems/sceneManager.h"
-#include "independent/systems/systems/randomiser.h"
+#include "terrain/worldSave.h"
 
 bool Environment::existsInsideBB(BoundingBox bb, Transform* otherTransform)
 {
@@ -25,10 +25,35 @@ bool Environment::existsInsideBB(BoundingBox bb, Transform* otherTransform)
 	return false;
 }
 
+void Environment::composeMatrices(const std::vector<std::pair<glm::vec3, bool>>& positions, const glm::vec3& scale, std::vector<glm::mat4>& matrices)
+{
+	std::vector<glm::vec3> points;
+	points.reserve(positions.size());
+	for (auto& pos : positions)
+		points.push_back(pos.first);
+
+	matrices.resize(points.size());
+	BatchTransforms::composeModelMatrices(points.data(), scale, matrices.data(), static_cast<uint32_t>(points.size()));
+}
+
+void Environment::addColliders(const std::vector<std::pair<glm::vec3, bool>>& positions, const glm::vec3& halfSize, const float height, std::vector<ColliderID>& colliders)
+{
+	std::vector<AABB> bounds;
+	bounds.reserve(positions.size());
+	for (auto& pos : positions)
+		bounds.push_back({ pos.first - glm::vec3(halfSize.x, 0.f, halfSize.z), pos.first + glm::vec3(halfSize.x, height, halfSize.z) });
+
+	colliders.resize(bounds.size());
+	getParent()->getParentScene()->getCollisionWorld()->addBoxes(bounds.data(), static_cast<uint32_t>(bounds.size()), colliders.data());
+}
+
 Environment::Environment()
 {
 	m_treeHighlightedEntity = nullptr;
 	m_rockHighlightedEntity = nullptr;
+
+	subscribe(EventType::MousePressed);
+	tick(TickGroup::PostUpdate);
 }
 
 Environment::~Environment()
@@ -41,7 +66,9 @@ void Environment::onAttach()
 	m_rockHighlightedEntity = getParent()->getParentScene()->getEntity("Rock1");
 	m_treeModel = ResourceManager::getResource<Model3D>("tree");
 	m_rockModel = ResourceManager::getResource<Model3D>("rock");
+	m_generator.seed(WorldSave::getSeed());
 
+	// Every object is generated so the sequence matches the last time the world was loaded, harvested ones are then left out
 	for (int i = 0; i < 50; i++)
 	{
 		glm::vec3 generatedPos = { 0.f, -10.f, 0.f};
@@ -49,8 +76,11 @@ void Environment::onAttach()
 		{
 			generatedPos = generatePoint();
 		}
+		if (WorldSave::isHarvested(WorldObject::Tree, i, generatedPos)) continue;
+
 		m_treePositions.push_back({ generatedPos, false });
 		m_treeBB.push_back(generateBB(m_treePositions.back().first));
+		m_treeIndices.push_back(i);
 	}
 
 	for (int i = 0; i < 50; i++)
@@ -60,9 +90,28 @@ void Environment::onAttach()
 		{
 			generatedPos = generatePoint();
 		}
+		if (WorldSave::isHarvested(WorldObject::Rock, i, generatedPos)) continue;
+
 		m_rockPositions.push_back({generatedPos, false});
 		m_rockBB.push_back(generateBB(m_rockPositions.back().first));
+		m_rockIndices.push_back(i);
 	}
+
+	// Trunks and rocks block the player, the boxes are only as wide as the trunk and the rock
+	addColliders(m_treePositions, { 1.5f, 0.f, 1.5f }, 15.f, m_treeColliders);
+	addColliders(m_rockPositions, { 1.5f, 0.f, 1.5f }, 2.f, m_rockColliders);
+}
+
+void Environment::onDetach()
+{
+	CollisionWorld* world = getParent()->getParentScene()->getCollisionWorld();
+	for (auto collider : m_treeColliders)
+		world->removeCollider(collider);
+	for (auto collider : m_rockColliders)
+		world->removeCollider(collider);
+
+	m_treeColliders.clear();
+	m_rockColliders.clear();
 }
 
 void Environment::onPostUpdate(const float timestep, const float totalTime)
@@ -129,19 +178,27 @@ void Environment::onRender(const Renderers renderer, const std::string& renderSt
 {
 	if (renderer == Renderers::Renderer3D && renderState != "Terrain")
 	{
-		for (auto& pos : m_treePositions)
+		// Objects never move, they are only ever removed
+		if (m_treeMatrices.size() != m_treePositions.size())
+			composeMatrices(m_treePositions, { 6.f, 6.f, 6.f }, m_treeMatrices);
+		if (m_rockMatrices.size() != m_rockPositions.size())
+			composeMatrices(m_rockPositions, { 0.25f, 0.25f, 0.25f }, m_rockMatrices);
+
+		for (auto& model : m_treeMatrices)
 		{
 			for (auto& mesh : m_treeModel->getMeshes())
 			{
-				Renderer3D::submit("Tree", mesh.getGeometry(), mesh.getMaterial(), MathUtils::getModelMatrix(pos.first, { 6.f, 6.f, 6.f }));
+				if (Renderer3D::isClipped(mesh.getGeometry(), model)) continue;
+				Renderer3D::submit("Tree", mesh.getGeometry(), mesh.getMaterial(), model);
 			}
 		}
 
-		for (auto& pos : m_rockPositions)
+		for (auto& model : m_rockMatrices)
 		{
 			for (auto& mesh : m_rockModel->getMeshes())
 			{
-				Renderer3D::submit("Rock", mesh.getGeometry(), mesh.getMaterial(), MathUtils::getModelMatrix(pos.first, { 0.25f, 0.25f, 0.25f }));
+				if (Renderer3D::isClipped(mesh.getGeometry(), model)) continue;
+				Renderer3D::submit("Rock", mesh.getGeometry(), mesh.getMaterial(), model);
 			}
 		}
 	}
@@ -159,7 +216,11 @@ void Environment::onMousePress(MousePressedEvent & e, const float timestep, cons
 			{
 				m_treeHighlightedEntity->setDisplay(false);
 				m_treeHighlightedEntity->setSelected(false);
+				WorldSave::harvest(WorldObject::Tree, m_treeIndices[i], m_treePositions[i].first);
+				m_treeIndices.erase(m_treeIndices.begin() + i);
 				m_treePositions.erase(m_treePositions.begin()+i);
+				getParent()->getParentScene()->getCollisionWorld()->removeCollider(m_treeColliders[i]);
+				m_treeColliders.erase(m_treeColliders.begin() + i);
 				player->getInventory()->giveItem(Items::Log, 0, 1);
 				return;
 			}
@@ -171,7 +232,11 @@ void Environment::onMousePress(MousePressedEvent & e, const float timestep, cons
 			{
 				m_rockHighlightedEntity->setDisplay(false);
 				m_rockHighlightedEntity->setSelected(false);
+				WorldSave::harvest(WorldObject::Rock, m_rockIndices[i], m_rockPositions[i].first);
+				m_rockIndices.erase(m_rockIndices.begin() + i);
 				m_rockPositions.erase(m_rockPositions.begin() + i);
+				getParent()->getParentScene()->getCollisionWorld()->removeCollider(m_rockColliders[i]);
+				m_rockColliders.erase(m_rockColliders.begin() + i);
 				player->getInventory()->giveItem(Items::Stone, 0, 1);
 				return;
 			}
@@ -182,10 +247,12 @@ void Environment::onMousePress(MousePressedEvent & e, const float timestep, cons
 glm::vec3 Environment::generatePoint()
 {
 	Terrain* terrain = static_cast<Terrain*>(getParent()->getParentScene()->getEntity("Terrain1")->getComponent<NativeScript>());
-	float x = Randomiser::uniformFloatBetween(-500.f, 500.f);
-	float z = Randomiser::uniformFloatBetween(-500.f, 500.f);
-	float posX = Randomiser::uniformIntBetween(0, 1);
-	float posZ = Randomiser::uniformIntBetween(0, 1);
+	std::uniform_real_distribution<float> position(-500.f, 500.f);
+	std::uniform_int_distribution<int32_t> side(0, 1);
+	float x = position(m_generator);
+	float z = position(m_generator);
+	float posX = side(m_generator);
+	float posZ = side(m_generator);
 	if (posX == 0) x = -x;
 	if (posZ == 0) z = -z;
 	return { x, terrain->getYCoord(x, z), z };
@@ -11,6 +11,24 @@
 #include "independent/entities/entity.h"
 #include "scripts/gameObjects/terrain.h"
 #include "scripts/gameObjects/player.h"
+#include "scripts/gameObjects/placedCollider.h"
+#include "terrain/worldSave.h"
+
+Entity* PlaceObject::createObject(Items::Items item, const glm::vec3& position)
+{
+	// Build the template once per item, every placement after is a single instantiate
+	auto prefab = m_prefabs.find(item);
+	if (prefab == m_prefabs.end())
+	{
+		prefab = m_prefabs.emplace(item, Prefab("Default")).first;
+		prefab->second.add<Transform>("Transform1", 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f);
+		prefab->second.add<MeshRender3D>("MeshR", Items::getModel(item), ResourceManager::getResource<Material>("placeObjectMaterial"));
+		prefab->second.add<PlacedCollider>("Collider1");
+	}
+
+	Scene* scene = getParent()->getParentScene();
+	return scene->getEntity(prefab->second.instantiate(scene, position));
+}
 
 PlaceObject::PlaceObject()
 {
@@ -18,12 +36,34 @@ PlaceObject::PlaceObject()
 	m_camera = nullptr;
 	m_currentEntity = nullptr;
 	m_final = true;
+
+	subscribe(EventType::MouseReleased);
+	tick(TickGroup::PreUpdate);
 }
 
 PlaceObject::~PlaceObject()
 {
 }
 
+void PlaceObject::onAttach()
+{
+	// Objects placed in earlier sessions are created as their chunks come into range
+	WorldSave::setPlacedObjectLoader([this](const PlacedObject& object)
+	{
+		Items::Items item = static_cast<Items::Items>(object.Item);
+		if (!Items::isPlaceable(item)) return;
+
+		Entity* ent = createObject(item, object.Position);
+		ent->getComponent<MeshRender3D>()->setMaterial(Items::getWorldMaterial(item));
+		ent->getComponent<PlacedCollider>()->setCollider(getParent()->getParentScene()->getCollisionWorld()->addBox({ object.Position - glm::vec3(1.f), object.Position + glm::vec3(1.f) }));
+	});
+}
+
+void PlaceObject::onDetach()
+{
+	WorldSave::setPlacedObjectLoader(nullptr);
+}
+
 void PlaceObject::onPreUpdate(const float timestep, const float totalTime)
 {
 	if (!m_camera)
@@ -49,14 +89,9 @@ void PlaceObject::onPreUpdate(const float timestep, const float totalTime)
 			{
 				glm::vec3 playerPos = m_camera->getComponent<Transform>()->getWorldPosition();
 				glm::vec3 viewDir = m_camera->getComponent<Camera>()->getCameraData().Front * 4.f;
+				Items::Items item = m_player->getInventory()->getItem(m_player->getHotbar()->getSelectedItem())->getType();
 
-				Entity* ent = new Entity;
-				SceneManager::getActiveScene()->addEntity("NewObj" + std::to_string(number), ent);
-				ent->setDisplay(true);
-				ent->setLayer(SceneManager::getActiveScene()->getLayerManager()->getLayer("Default"));
-				ent->attach<Transform>("Transform1", playerPos.x + viewDir.x, playerPos.y + viewDir.y, playerPos.z + viewDir.z, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f);
-				ent->attach<MeshRender3D>("MeshR", Items::getModel(m_player->getInventory()->getItem(m_player->getHotbar()->getSelectedItem())->getType()), ResourceManager::getResource<Material>("placeObjectMaterial"));
-				number++;
+				Entity* ent = createObject(item, playerPos + viewDir);
 				m_final = false;
 				m_currentEntity = ent;
 			}
@@ -86,7 +121,14 @@ void PlaceObject::onMouseRelease(MouseReleasedEvent & e, const float timestep, c
 	{
 		if (m_currentEntity)
 		{
-			m_currentEntity->getComponent<MeshRender3D>()->setMaterial(Items::getWorldMaterial(m_player->getInventory()->getItem(m_player->getHotbar()->getSelectedItem())->getType()));
+			// Placed objects block the player like the rest of the environment, the box goes when the object is destroyed
+			const glm::vec3 position = m_currentEntity->getComponent<Transform>()->getWorldPosition();
+			m_currentEntity->getComponent<PlacedCollider>()->setCollider(getParent()->getParentScene()->getCollisionWorld()->addBox({ position - glm::vec3(1.f), position + glm::vec3(1.f) }));
+
+			Items::Items item = m_player->getInventory()->getItem(m_player->getHotbar()->getSelectedItem())->getType();
+			WorldSave::addPlacedObject(item, position);
+
+			m_currentEntity->getComponent<MeshRender3D>()->setMaterial(Items::getWorldMaterial(item));
 			m_currentEntity = nullptr;
 			m_player->getInventory()->takeItem(m_player->getInventory()->getItem(m_player->getHotbar()->getSelectedItem())->getType(), 0, 1);
 		}
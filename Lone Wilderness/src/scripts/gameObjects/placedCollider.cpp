@@ -0,0 +1,40 @@
+/*! \file placedCollider.cpp
+*
+* \brief A script which keeps the collider of a placed object and removes it with the object
+*
+* \author: Daniel Bullin
+*
+*/
+#include "scripts/gameObjects/placedCollider.h"
+#include "independent/entities/entity.h"
+#include "independent/systems/components/scene.h"
+
+//! PlacedCollider()
+PlacedCollider::PlacedCollider()
+{
+	m_collider = InvalidCollider;
+}
+
+//! ~PlacedCollider()
+PlacedCollider::~PlacedCollider()
+{
+}
+
+//! onDetach()
+void PlacedCollider::onDetach()
+{
+	// Destroying the object takes its box out of the world, the scene deletes its entities before its collision world
+	setCollider(InvalidCollider);
+}
+
+//! setCollider()
+/*!
+\param collider a const ColliderID - The object's box, any box it had before is removed
+*/
+void PlacedCollider::setCollider(const ColliderID collider)
+{
+	if (m_collider != InvalidCollider && getParent() && getParent()->getParentScene())
+		getParent()->getParentScene()->getCollisionWorld()->removeCollider(m_collider);
+
+	m_collider = collider;
+}
@@ -6,13 +6,14 @@
 *
 */
 #include "scripts/gameObjects/player.h"
+#include "independent/systems/systems/inputManager.h"
 #include "loaders/sceneLoader.h"
 #include "independent/systems/systems/sceneManager.h"
 #include "independent/systems/systems/eventManager.h"
 #include "independent/rendering/renderers/renderer2D.h"
 #include "independent/utils/mathUtils.h"
-#include "scripts/gameObjects/terrain.h"
 #include "settings/settings.h"
+#include "terrain/worldSave.h"
 
 //! Player()
 Player::Player()
@@ -22,6 +23,11 @@ Player::Player()
 	m_dmgText = new Text("0", { 1.0, 1.0, 1.0, 1.0 }, "Ubuntu20");
 	m_health = 100;
 	m_atkDmg = 25;
+
+	subscribe(EventType::KeyPressed);
+	subscribe(EventType::MouseScrolled);
+	subscribe(EventType::MouseMoved);
+	tick(TickGroup::PreUpdate);
 }
 
 //! ~Player()
@@ -38,10 +44,24 @@ Player::~Player()
 void Player::onAttach()
 {
 	m_controller = getParent()->getComponent<CharacterController>();
+
+	// The capsule reaches from the feet to just above the camera, the scene keeps it on the terrain
+	if (m_controller)
+		m_controller->enableCollision(1.f, 8.5f, true);
 	m_hotbar = new Hotbar;
 	m_inventory = new Inventory;
 
 	m_inventory->onAttach();
+
+	// The scene loader opens the world before any entity is attached
+	WorldSave::setInventory(m_inventory);
+}
+
+//! onDetach()
+void Player::onDetach()
+{
+	// Saves what changed since the last autosave and waits for it to be written
+	WorldSave::close();
 }
 
 //! onPreUpdate()
@@ -54,10 +74,17 @@ void Player::onPreUpdate(const float timestep, const float totalTime)
 	m_hotbar->onPreUpdate(timestep, totalTime);
 	m_inventory->onPreUpdate(timestep, totalTime);
 
-	Transform* trans = getParent()->getComponent<Transform>();
-	Terrain* terrain = static_cast<Terrain*>(getParent()->getParentScene()->getEntity("Terrain1")->getComponent<NativeScript>());
-	float y = terrain->getYCoord(trans->getWorldPosition().x, trans->getWorldPosition().z);
-	trans->setLocalPosition({ trans->getWorldPosition().x, y , trans->getWorldPosition().z });
+	if (m_controller)
+	{
+		if (InputManager::isActionDown(PlayerConfig::MoveForward))
+			m_controller->move(FORWARD, timestep);
+		if (InputManager::isActionDown(PlayerConfig::MoveLeft))
+			m_controller->move(LEFT, timestep);
+		if (InputManager::isActionDown(PlayerConfig::MoveBack))
+			m_controller->move(BACKWARD, timestep);
+		if (InputManager::isActionDown(PlayerConfig::MoveRight))
+			m_controller->move(RIGHT, timestep);
+	}
 }
 
 //! onPostUpdate()
@@ -79,27 +106,6 @@ void Player::onPostUpdate(const float timestep, const float totalTime)
 void Player::onKeyPress(KeyPressedEvent& e, const float timestep, const float totalTime)
 {
 	m_hotbar->onKeyPress(e, timestep, totalTime);
-
-	if (e.getKeyCode() == Settings::getKeys(PlayerConfig::MoveForward).first)
-	{
-		if (m_controller)
-			m_controller->move(FORWARD, timestep);
-	}
-	if (e.getKeyCode() == Settings::getKeys(PlayerConfig::MoveLeft).first)
-	{
-		if (m_controller)
-			m_controller->move(LEFT, timestep);
-	}
-	if (e.getKeyCode() == Settings::getKeys(PlayerConfig::MoveBack).first)
-	{
-		if (m_controller)
-			m_controller->move(BACKWARD, timestep);
-	}
-	if (e.getKeyCode() == Settings::getKeys(PlayerConfig::MoveRight).first)
-	{
-		if (m_controller)
-			m_controller->move(RIGHT, timestep);
-	}
 }
 
 //! onKeyRelease()
@@ -62,7 +62,10 @@ void Hotbar::onPreUpdate(const float timestep, const float totalTime)
 				{
 					m_hotbarElements.at(i).first->getParent()->setDisplay(true);
 					m_hotbarElements.at(i).second->getParent()->setDisplay(true);
-					m_hotbarElements.at(i).first->setMaterial(Items::getMaterial(m_player->getInventory()->getItem(i)->getType()));
+					// Only swapped when the slot's item changes
+					Material* material = Items::getMaterial(m_player->getInventory()->getItem(i)->getType());
+					if (m_hotbarElements.at(i).first->getMaterial() != material)
+						m_hotbarElements.at(i).first->setMaterial(material);
 					m_hotbarElements.at(i).second->setText(std::to_string(m_player->getInventory()->getItemCount(i)));
 				}
 				else
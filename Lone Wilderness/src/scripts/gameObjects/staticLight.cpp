@@ -29,6 +29,6 @@ void StaticLight::onSubmit(const Renderers renderer, const std::string& renderSt
 {
 	if (getParent()->containsComponent<MeshRender3D>())
 	{
-		getParent()->getComponent<MeshRender3D>()->getMaterial()->setTint({ getParent()->getComponent<PointLight>()->getDiffuseFactor(), 1.f });
+		getParent()->getComponent<MeshRender3D>()->getInstance().setTint({ getParent()->getComponent<PointLight>()->getDiffuseFactor(), 1.f });
 	}
 }
\ No newline at end of file
@@ -13,9 +13,11 @@
 Sun::Sun()
 {
 	m_timer = nullptr;
-	m_skyboxMaterial = nullptr;
+	m_skyInstance = nullptr;
 	m_cycleTime = 600.f;
 	m_approachingNight = true;
+
+	tick(TickGroup::PreUpdate);
 }
 
 Sun::~Sun()
@@ -29,8 +31,13 @@ void Sun::onPreUpdate(const float timestep, const float totalTime)
 		m_timer = static_cast<GameTimer*>(getParent()->getParentScene()->getEntity("TimerEntity")->getComponent<NativeScript>());
 	}
 
-	if (!m_skyboxMaterial)
-		m_skyboxMaterial = ResourceManager::getResource<Material>("skyboxMaterial");
+	// The sky is darkened through the skybox's own parameters, the shared sky material is left alone
+	if (!m_skyInstance)
+	{
+		Skybox* skybox = getParent()->getParentScene()->getMainCamera()->getSkybox();
+		if (!skybox) return;
+		m_skyInstance = &skybox->getInstance();
+	}
 
 	DirectionalLight* light = getParent()->getComponent<DirectionalLight>();
 
@@ -39,21 +46,21 @@ void Sun::onPreUpdate(const float timestep, const float totalTime)
 		if (m_approachingNight)
 		{
 			light->setDiffuseFactor(light->getDiffuseFactor() - glm::vec3(0.001f, 0.001f, 0.001f));
-			m_skyboxMaterial->setTint(m_skyboxMaterial->getTint() - glm::vec4(0.002f, 0.002f, 0.002f, 0.f));
+			m_skyInstance->setTint(m_skyInstance->getTint() - glm::vec4(0.002f, 0.002f, 0.002f, 0.f));
 		}
 		else
 		{
 			light->setDiffuseFactor(light->getDiffuseFactor() + glm::vec3(0.001f, 0.001f, 0.001f));
-			m_skyboxMaterial->setTint(m_skyboxMaterial->getTint() + glm::vec4(0.002f, 0.002f, 0.002f, 0.f));
+			m_skyInstance->setTint(m_skyInstance->getTint() + glm::vec4(0.002f, 0.002f, 0.002f, 0.f));
 		}
 
-		if (m_skyboxMaterial->getTint().r <= 0.f && m_approachingNight)
+		if (m_skyInstance->getTint().r <= 0.f && m_approachingNight)
 		{
 			m_timer->reset();
 			m_approachingNight = false;
 		}
 
-		if (m_skyboxMaterial->getTint().r >= 1.f && !m_approachingNight)
+		if (m_skyInstance->getTint().r >= 1.f && !m_approachingNight)
 		{
 			m_timer->reset();
 			m_approachingNight = true;
@@ -66,6 +73,6 @@ void Sun::onSubmit(const Renderers renderer, const std::string & renderState)
 {
 	if (getParent()->containsComponent<MeshRender3D>())
 	{
-		getParent()->getComponent<MeshRender3D>()->getMaterial()->setTint({ getParent()->getComponent<PointLight>()->getDiffuseFactor(), 1.f });
+		getParent()->getComponent<MeshRender3D>()->getInstance().setTint({ getParent()->getComponent<PointLight>()->getDiffuseFactor(), 1.f });
 	}
 }
\ No newline at end of file
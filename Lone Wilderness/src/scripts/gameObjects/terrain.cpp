@@ -9,6 +9,7 @@
 #include "independent/entities/entity.h"
 #include "independent/systems/components/scene.h"
 #include "independent/rendering/renderers/renderer3D.h"
+#include "terrain/worldSave.h"
 
 ChunkManager* Terrain::s_chunkManager = nullptr;
 
@@ -30,6 +31,7 @@ Terrain::Terrain()
 	m_frequencyMultiplier = 2.f;
 	m_playerTransform = nullptr;
 
+	tick(TickGroup::PostUpdate);
 }
 
 //! ~Terrain()
@@ -38,9 +40,29 @@ Terrain::~Terrain()
 	if (s_chunkManager)
 		delete s_chunkManager;
 
+	ChunkManager::setHeightfield(nullptr);
+
 	s_chunkManager = nullptr;
 }
 
+//! onAttach()
+void Terrain::onAttach()
+{
+	// Characters are kept on the same heights the terrain is drawn with
+	getParent()->getParentScene()->getCollisionWorld()->setHeightfield([this](float x, float z) { return getYCoord(x, z); });
+
+	// Chunks are bounded with the same heights so they can be culled against the water
+	ChunkManager::setHeightfield([this](float x, float z) { return getYCoord(x, z); });
+}
+
+//! onDetach()
+void Terrain::onDetach()
+{
+	// Both heightfields call back into this script, so they cannot outlive it
+	getParent()->getParentScene()->getCollisionWorld()->setHeightfield(nullptr);
+	ChunkManager::setHeightfield(nullptr);
+}
+
 //! onPostUpdate()
 /*!
 \param timestep a const float - The timestep
@@ -52,6 +74,10 @@ void Terrain::onPostUpdate(const float timestep, const float totalTime)
 
 	glm::vec3 playerPos = m_playerTransform->getWorldPosition();
 	s_chunkManager->updateChunks({ playerPos.x, playerPos.z });
+
+	// Saved objects appear as their chunks come into range, the world is saved in the background every so often
+	WorldSave::streamChunks(playerPos, ChunkManager::getChunksSize());
+	WorldSave::onUpdate(timestep);
 }
 
 //! onRender
@@ -13,6 +13,8 @@ Water::Water()
 {
 	m_moveFactor = 0.f;
 	ResourceManager::getResource<UniformBuffer>("WaterUBO")->uploadData("u_moveFactor", &m_moveFactor);
+
+	tick(TickGroup::PostUpdate);
 }
 
 Water::~Water()
@@ -12,6 +12,8 @@ GameTimer::GameTimer()
 {
 	m_time = 0;
 	m_enabled = true;
+
+	tick(TickGroup::PreUpdate, TickRate::EveryFrame, true);
 }
 
 GameTimer::~GameTimer()
@@ -21,6 +21,8 @@ ResourcesScript::ResourcesScript()
 	m_uploadedModels = false;
 	m_loadingText = nullptr;
 	m_thread = nullptr;
+
+	tick(TickGroup::PostUpdate);
 }
 
 //! ~ResourcesScript()
@@ -12,6 +12,7 @@
 //! CameraRotationScript()
 CameraRotationScript::CameraRotationScript()
 {
+	tick(TickGroup::PostUpdate);
 }
 
 //! ~CameraRotationScript()
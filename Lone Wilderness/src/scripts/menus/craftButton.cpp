@@ -16,6 +16,9 @@ CraftButton::CraftButton()
 {
 	m_render = nullptr;
 	m_hovered = false;
+
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
 }
 
 CraftButton::~CraftButton()
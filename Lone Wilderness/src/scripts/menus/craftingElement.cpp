@@ -17,6 +17,10 @@ CraftingElement::CraftingElement()
 	m_render = nullptr;
 	m_selectedTint = { 1.f, 1.f, 1.f, 1.f };
 	m_itemIndex = -1;
+
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	tick(TickGroup::PreUpdate);
 }
 
 CraftingElement::CraftingElement(nlohmann::json scriptData)
@@ -24,6 +28,10 @@ CraftingElement::CraftingElement(nlohmann::json scriptData)
 	m_render = nullptr;
 	m_selectedTint = { 1.f, 1.f, 1.f, 1.f };
 	m_itemIndex = scriptData["index"].get<int>();
+
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	tick(TickGroup::PreUpdate);
 }
 
 CraftingElement::~CraftingElement()
@@ -82,7 +90,7 @@ void CraftingElement::onSubmit(const Renderers renderer, const std::string & ren
 {
 	if (getParent()->containsComponent<MeshRender2D>())
 	{
-		getParent()->getComponent<MeshRender2D>()->getMaterial()->setTint(m_selectedTint);
+		getParent()->getComponent<MeshRender2D>()->getInstance().setTint(m_selectedTint);
 	}
 }
 
@@ -17,6 +17,8 @@
 CraftingMenu::CraftingMenu()
 {
 	m_itemSelected = Items::None;
+
+	subscribe(EventType::KeyReleased);
 }
 
 CraftingMenu::~CraftingMenu()
@@ -38,6 +40,7 @@ void CraftingMenu::onKeyRelease(KeyReleasedEvent & e, const float timestep, cons
 		{
 			LayerControl::hide("Crafting", scene);
 			LayerControl::deactivate("Crafting", scene);
+			untick(TickGroup::PreUpdate);
 			WindowManager::getFocusedWindow()->setCursorInputMode(CursorInputMode::Disabled);
 			SceneManager::getActiveScene()->getEntity("Player1")->getComponent<CharacterController>()->setFrozen(false);
 			LayerControl::show("UI", scene);
@@ -46,6 +49,9 @@ void CraftingMenu::onKeyRelease(KeyReleasedEvent & e, const float timestep, cons
 		{
 			LayerControl::show("Crafting", scene);
 			LayerControl::activate("Crafting", scene);
+			// The costs only need refreshing while the menu is open, and not every frame
+			tick(TickGroup::PreUpdate, TickRate::TenHertz);
+			requestTick(TickGroup::PreUpdate);
 			WindowManager::getFocusedWindow()->setCursorInputMode(CursorInputMode::Visible);
 			SceneManager::getActiveScene()->getEntity("Player1")->getComponent<CharacterController>()->setFrozen(true);
 			LayerControl::hide("UI", scene);
@@ -93,6 +99,9 @@ void CraftingMenu::onPreUpdate(const float timestep, const float totalTime)
 void CraftingMenu::selectItem(Items::Items item)
 {
 	m_itemSelected = item;
+
+	if (isTicking(TickGroup::PreUpdate))
+		requestTick(TickGroup::PreUpdate);
 }
 
 Items::Items CraftingMenu::getSelectedItem()
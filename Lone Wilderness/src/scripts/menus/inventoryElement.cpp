@@ -18,6 +18,10 @@ InventoryElement::InventoryElement()
 	m_inventorySlot = nullptr;
 	m_inventoryCurrent = nullptr;
 	m_inventoryIndex = 0;
+
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	tick(TickGroup::PreUpdate);
 }
 
 InventoryElement::InventoryElement(nlohmann::json scriptData)
@@ -27,6 +31,10 @@ InventoryElement::InventoryElement(nlohmann::json scriptData)
 	m_inventorySlot = nullptr;
 	m_inventoryCurrent = nullptr;
 	m_inventoryIndex = scriptData["index"].get<uint32_t>();
+
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	tick(TickGroup::PreUpdate);
 }
 
 InventoryElement::~InventoryElement()
@@ -83,13 +91,17 @@ void InventoryElement::onPreUpdate(const float timestep, const float totalTime)
 {
 	if (!m_inventoryCurrent)
 		m_inventoryCurrent = getParent()->getParentScene()->getEntity("inventoryCurrent");
+
+	// Nothing else to do each frame once the entity has been found
+	if (m_inventoryCurrent)
+		untick(TickGroup::PreUpdate);
 }
 
 void InventoryElement::onSubmit(const Renderers renderer, const std::string & renderState)
 {
 	if (getParent()->containsComponent<MeshRender2D>())
 	{
-		getParent()->getComponent<MeshRender2D>()->getMaterial()->setTint(m_selectedTint);
+		getParent()->getComponent<MeshRender2D>()->getInstance().setTint(m_selectedTint);
 	}
 }
 
@@ -101,9 +113,9 @@ Entity * InventoryElement::getSlot()
 void InventoryElement::resetSlot()
 {
 	m_inventorySlot = 0;
-	m_inventoryCurrent->setDisplay(false);
+	if (m_inventoryCurrent) m_inventoryCurrent->setDisplay(false);
 	m_selectedTint = { 1.f, 1.f, 1.f, 1.f };
-	getParent()->getComponent<MeshRender2D>()->getMaterial()->setTint(m_selectedTint);
+	getParent()->getComponent<MeshRender2D>()->getInstance().setTint(m_selectedTint);
 }
 
 uint32_t InventoryElement::getInvenIndex()
@@ -21,6 +21,8 @@ InventoryMenu::InventoryMenu()
 {
 	m_updated = true;
 	m_player = nullptr;
+
+	subscribe(EventType::KeyReleased);
 }
 
 //! ~InventoryMenu()
@@ -50,6 +52,7 @@ void InventoryMenu::onKeyRelease(KeyReleasedEvent & e, const float timestep, con
 		{
 			LayerControl::hide("Inven", scene);
 			LayerControl::deactivate("Inven", scene);
+			untick(TickGroup::PreUpdate);
 			WindowManager::getFocusedWindow()->setCursorInputMode(CursorInputMode::Disabled);
 			SceneManager::getActiveScene()->getEntity("Player1")->getComponent<CharacterController>()->setFrozen(false);
 			LayerControl::show("UI", scene);
@@ -67,6 +70,8 @@ void InventoryMenu::onKeyRelease(KeyReleasedEvent & e, const float timestep, con
 		{
 			LayerControl::show("Inven", scene);
 			LayerControl::activate("Inven", scene);
+			// The slots only need updating while the menu is open
+			tick(TickGroup::PreUpdate);
 			WindowManager::getFocusedWindow()->setCursorInputMode(CursorInputMode::Visible);
 			SceneManager::getActiveScene()->getEntity("Player1")->getComponent<CharacterController>()->setFrozen(true);
 			LayerControl::hide("UI", scene);
@@ -32,6 +32,10 @@ void MainMenuText::loadScene(const std::string& sceneName)
 MainMenuText::MainMenuText()
 {
 	m_text = nullptr;
+
+	subscribe(EventType::MousePressed);
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
 }
 
 //! ~MainMenuText()
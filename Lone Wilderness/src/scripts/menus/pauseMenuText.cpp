@@ -32,6 +32,10 @@ void PauseMenuText::loadScene(const std::string& sceneName)
 PauseMenuText::PauseMenuText()
 {
 	m_text = nullptr;
+
+	subscribe(EventType::MousePressed);
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
 }
 
 //! ~PauseMenuText()
@@ -16,6 +16,7 @@
 //! PauseScript()
 PauseScript::PauseScript()
 {
+	subscribe(EventType::KeyReleased);
 }
 
 //! ~PauseScript()
@@ -18,6 +18,12 @@ KeybindText::KeybindText()
 	m_text = nullptr;
 	m_changing = false;
 	TimerSystem::startTimer("KeybindSwitch");
+
+	subscribe(EventType::MousePressed);
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	subscribe(EventType::KeyReleased);
+	tick(TickGroup::PostUpdate);
 }
 
 //! KeybindText()
@@ -30,6 +36,12 @@ KeybindText::KeybindText(nlohmann::json scriptData)
 	m_text = nullptr;
 	m_changing = false;
 	TimerSystem::startTimer("KeybindSwitch");
+
+	subscribe(EventType::MousePressed);
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
+	subscribe(EventType::KeyReleased);
+	tick(TickGroup::PostUpdate);
 }
 
 //! ~KeybindText()
@@ -14,6 +14,10 @@
 SettingsMenuText::SettingsMenuText()
 {
 	m_text = nullptr;
+
+	subscribe(EventType::MousePressed);
+	subscribe(EventType::MouseReleased);
+	subscribe(EventType::MouseMoved);
 }
 
 //! ~SettingsMenuText()
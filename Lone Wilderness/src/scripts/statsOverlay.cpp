@@ -0,0 +1,117 @@
+/*! \file statsOverlay.cpp
+*
+* \brief A text overlay which shows the engine counters
+*
+* \author: Daniel Bullin
+*
+*/
+#include "scripts/statsOverlay.h"
+#include "independent/systems/systems/counterSystem.h"
+#include "independent/utils/allocationTracker.h"
+#include "independent/rendering/renderers/renderer2D.h"
+#include "independent/entities/entity.h"
+#include "independent/systems/systems/fontManager.h"
+
+//! StatsOverlay()
+StatsOverlay::StatsOverlay()
+{
+	m_visible = false;
+	m_lineHeight = 22.f;
+
+	subscribe(EventType::KeyReleased);
+}
+
+//! ~StatsOverlay()
+StatsOverlay::~StatsOverlay()
+{
+}
+
+//! refresh()
+void StatsOverlay::refresh()
+{
+	m_lines.clear();
+
+	// Each counter line shows the average and the worst frame over the rolling window
+	const Counter::Counter counters[] = { Counter::DrawCalls, Counter::DrawCommands, Counter::BatchFlushes3D, Counter::BatchFlushes2D, Counter::TextureBinds,
+		Counter::VertexBytesUploaded, Counter::IndexBytesUploaded, Counter::UniformBytesUploaded, Counter::EntitiesTraversed, Counter::SubmissionsClipped, Counter::GlyphRunsBuilt, Counter::Allocations, Counter::AllocatedBytes };
+
+	for (auto counter : counters)
+	{
+		m_lines.push_back(std::string(CounterSystem::toString(counter)) + ": " + std::to_string(static_cast<uint64_t>(CounterSystem::getAverage(counter)))
+			+ " (max " + std::to_string(CounterSystem::getMax(counter)) + ")");
+	}
+
+	m_lines.push_back("SceneEntities: " + std::to_string(CounterSystem::getGauge(Gauge::SceneEntities)));
+	m_lines.push_back("FrameTime: " + std::to_string(CounterSystem::getAverage(Gauge::FrameTimeMicroseconds) / 1000.f) + "ms");
+
+	// The last frame's allocations by subsystem, shown when tracking is turned on in the config
+	if (AllocationTracker::isEnabled())
+	{
+		for (uint32_t i = 0; i < AllocationTag::Count; i++)
+		{
+			const AllocationTag::AllocationTag tag = static_cast<AllocationTag::AllocationTag>(i);
+			const uint64_t budget = AllocationTracker::getBudget(tag);
+			m_lines.push_back(std::string("Alloc ") + AllocationTracker::toString(tag) + ": " + std::to_string(AllocationTracker::getLastFrame(tag).allocations)
+				+ (budget == AllocationTracker::NoBudget ? "" : " (budget " + std::to_string(budget) + ")"));
+		}
+	}
+
+	Font* font = FontManager::getFont("Ubuntu20");
+	m_runs.resize(m_lines.size());
+	for (size_t i = 0; i < m_lines.size(); i++)
+		m_runs[i].build(m_lines[i], font);
+}
+
+//! onPostUpdate()
+/*!
+\param timestep a const float - The timestep
+\param totalTime a const float - The total time of the application
+*/
+void StatsOverlay::onPostUpdate(const float timestep, const float totalTime)
+{
+	refresh();
+}
+
+//! onKeyRelease()
+/*!
+\param e a KeyReleasedEvent& - A key release event
+\param timestep a const float - The timestep
+\param totalTime a const float - The total time of the application
+*/
+void StatsOverlay::onKeyRelease(KeyReleasedEvent& e, const float timestep, const float totalTime)
+{
+	if (e.getKeyCode() == Keys::F3)
+	{
+		m_visible = !m_visible;
+
+		// Only refresh twice a second while the overlay is shown
+		if (m_visible)
+		{
+			refresh();
+			tick(TickGroup::PostUpdate, 0.5f);
+		}
+		else
+			untick(TickGroup::PostUpdate);
+	}
+}
+
+//! onRender()
+/*!
+\param renderer a const Renderers - The renderer type
+\param renderState a const std::string& - The render state
+*/
+void StatsOverlay::onRender(const Renderers renderer, const std::string& renderState)
+{
+	if (renderer == Renderers::Renderer2D && m_visible)
+	{
+		Transform* trans = getParent()->getComponent<Transform>();
+		if (!trans) return;
+
+		glm::vec3 position = trans->getWorldPosition();
+		for (auto& run : m_runs)
+		{
+			Renderer2D::submitGlyphRun(run, { 1.f, 1.f, 1.f, 1.f }, glm::translate(glm::mat4(1.f), position));
+			position.y += m_lineHeight;
+		}
+	}
+}
@@ -10,6 +10,7 @@
 //! TestScript()
 TestScript::TestScript()
 {
+	tick(TickGroup::PostUpdate);
 }
 
 //! ~TestScript()
@@ -8,6 +8,7 @@
 #include "settings/settings.h"
 #include "independent/systems/systems/resourceManager.h"
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/inputManager.h"
 
 namespace Engine
 {
@@ -43,6 +44,9 @@ namespace Engine
 	void Settings::bindKey(const PlayerConfig::ConfigData function, const uint32_t key1, const uint32_t key2)
 	{
 		s_keyBinds[function] = { key1, key2 };
+
+		// A key of 0 means the slot is unbound
+		InputManager::bindAction(function, key1 ? key1 : -1, key2 ? key2 : -1);
 	}
 
 	//! getKeys()
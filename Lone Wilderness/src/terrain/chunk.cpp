@@ -35,4 +35,13 @@ void Chunk::setChunkPosition(const glm::ivec2& chunkPos, const float positionMul
 glm::vec3 Chunk::getWorldPositon()
 {
 	return m_chunkWorldPosition;
+}
+
+//! getChunkPosition
+/*
+\return a glm::ivec2 - The chunk's position
+*/
+glm::ivec2 Chunk::getChunkPosition()
+{
+	return m_chunkPosition;
 }
\ No newline at end of file
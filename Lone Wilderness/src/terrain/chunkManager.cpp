@@ -5,18 +5,25 @@
 * \author: Daniel Bullin
 *
 */
+#include <limits>
 #include "terrain/chunkManager.h"
 #include "independent/rendering/renderers/renderer3D.h"
+#include "independent/rendering/geometry/meshOptimiser.h"
 #include "independent/systems/systems/log.h"
+#include "independent/systems/systems/profiler.h"
 
 #define CHUNKSIZE 10
 #define CHUNKSTEPSIZE 5
+#define HEIGHTMARGIN 5.f
+#define MAXHEIGHTRANGES 4096
 
 std::map<std::pair<int, int>, Chunk*> ChunkManager::s_chunks; //!< A vector of all the chunks loaded
 int ChunkManager::s_chunksSize; //!< The number of chunks layers around the player's current chunk
 int ChunkManager::s_chunkSize; //!< The total number of tiles in any axis
 int ChunkManager::s_chunkStepSize; //!< The size of a tile in width
 Model3D* ChunkManager::s_model; //!< The model of the terrain
+std::function<float(float, float)> ChunkManager::s_heightfield; //!< Gives the height of the terrain at an x and z
+std::map<std::pair<int, int>, glm::vec2> ChunkManager::s_heightRanges; //!< The lowest and highest point of each chunk bounded so far
 
 //! makeVertex()
 /*
@@ -30,6 +37,58 @@ TerrainVertex ChunkManager::makeVertex(int x, int z, float xTotalLength, float z
 	return { { x, 0.f, z} , { (float)x / xTotalLength, (float)z / zTotalLength } };
 }
 
+//! getHeightRange()
+/*
+\param chunkPos a const glm::ivec2& - The chunk position
+\return a glm::vec2 - The lowest and highest point of the chunk
+*/
+glm::vec2 ChunkManager::getHeightRange(const glm::ivec2& chunkPos)
+{
+	auto range = s_heightRanges.find({ chunkPos.x, chunkPos.y });
+	if (range != s_heightRanges.end())
+		return range->second;
+
+	// Without the heights nothing is known, so the chunk can never be culled
+	if (!s_heightfield)
+		return { -std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+
+	// The range is kept for every chunk seen, it is cheap to start again if the player travels far enough
+	if (s_heightRanges.size() >= MAXHEIGHTRANGES)
+		s_heightRanges.clear();
+
+	const float chunkWidth = static_cast<float>(s_chunkSize * s_chunkStepSize);
+	const glm::vec2 origin = glm::vec2(chunkPos) * chunkWidth;
+	glm::vec2 heights = { std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+	// Sample at every vertex, the tessellation adds detail between them so the range is widened by a margin
+	for (int z = 0; z <= s_chunkSize; z++)
+	{
+		for (int x = 0; x <= s_chunkSize; x++)
+		{
+			const float height = s_heightfield(origin.x + static_cast<float>(x * s_chunkStepSize), origin.y + static_cast<float>(z * s_chunkStepSize));
+			heights.x = std::min(heights.x, height);
+			heights.y = std::max(heights.y, height);
+		}
+	}
+	heights += glm::vec2(-HEIGHTMARGIN, HEIGHTMARGIN);
+
+	s_heightRanges[{ chunkPos.x, chunkPos.y }] = heights;
+	return heights;
+}
+
+//! getChunkBounds()
+/*
+\param chunk a Chunk* - The chunk
+\return an AABB - The world bounds of the chunk once its heights are applied
+*/
+AABB ChunkManager::getChunkBounds(Chunk* chunk)
+{
+	const float chunkWidth = static_cast<float>(s_chunkSize * s_chunkStepSize);
+	const glm::vec3 worldPos = chunk->getWorldPositon();
+	const glm::vec2 heights = getHeightRange(chunk->getChunkPosition());
+	return { { worldPos.x, heights.x, worldPos.z }, { worldPos.x + chunkWidth, heights.y, worldPos.z + chunkWidth } };
+}
+
 //! ChunkManager()
 ChunkManager::ChunkManager()
 {
@@ -55,6 +114,8 @@ void ChunkManager::start()
 */
 void ChunkManager::createGeometry(int chunkSize, int stepSize)
 {
+	ENGINE_PROFILE_FUNCTION();
+
 	s_chunkSize = chunkSize;
 	s_chunkStepSize = stepSize;
 
@@ -94,6 +155,9 @@ void ChunkManager::createGeometry(int chunkSize, int stepSize)
 		}
 	}
 
+	// Neighbouring tiles share their corners, weld them and order the triangles for the vertex cache
+	MeshOptimiser::optimise("Terrain", vertices, indices);
+
 	// Create a piece of geometry using local vertices and indices information
 	Geometry3D geometry;
 	geometry.VertexBuffer = ResourceManager::getResource<VertexBuffer>("TerrainVertexBuffer");
@@ -109,6 +173,8 @@ void ChunkManager::createGeometry(int chunkSize, int stepSize)
 //! deleteChunks()
 void ChunkManager::deleteChunks()
 {
+	ENGINE_PROFILE_FUNCTION();
+
 	for (auto& chunk : s_chunks)
 	{
 		if (chunk.second)
@@ -136,12 +202,33 @@ int ChunkManager::getChunksSize()
 	return s_chunksSize;
 }
 
+//! getChunkWorldSize()
+/*
+\return a float - The width of a chunk in world units
+*/
+float ChunkManager::getChunkWorldSize()
+{
+	return static_cast<float>(CHUNKSIZE * CHUNKSTEPSIZE);
+}
+
+//! setHeightfield()
+/*
+\param heightfield a const std::function<float(float, float)>& - Gives the height of the terrain at an x and z, chunks are only culled once it is set
+*/
+void ChunkManager::setHeightfield(const std::function<float(float, float)>& heightfield)
+{
+	s_heightfield = heightfield;
+	s_heightRanges.clear();
+}
+
 //! updateChunks
 /*
 \param playerPos a const glm::ivec2& - The player's position
 */
 void ChunkManager::updateChunks(const glm::ivec2& playerPos)
 {
+	ENGINE_PROFILE_FUNCTION();
+
 	int currentChunkX = static_cast<int>(floor(static_cast<float>(playerPos.x) / (static_cast<float>(s_chunkSize) * static_cast<float>(s_chunkStepSize))));
 	int currentChunkZ = static_cast<int>(floor(static_cast<float>(playerPos.y) / (static_cast<float>(s_chunkSize) * static_cast<float>(s_chunkStepSize))));
 
@@ -164,10 +251,15 @@ void ChunkManager::updateChunks(const glm::ivec2& playerPos)
 */
 void ChunkManager::onRender(const Renderers renderer, const std::string& renderState)
 {
+	ENGINE_PROFILE_FUNCTION();
+
 	if (renderer == Renderers::Renderer3D && renderState == "Terrain")
 	{
 		for (auto& chunk : s_chunks)
 		{
+			// Chunks completely on the clipped side of the water are left out of the reflection and refraction
+			if (Renderer3D::hasCullPlane() && Renderer3D::isClipped(getChunkBounds(chunk.second))) continue;
+
 			glm::mat4 model = glm::mat4(1.f);
 			glm::vec3 worldPos = chunk.second->getWorldPositon();
 
@@ -0,0 +1,502 @@
+/*! \file worldSave.cpp
+*
+* \brief Saves the changes made to the world in region files keyed by chunk, regions are written on a background thread and mapped as chunks stream in
+*
+* \author: Daniel Bullin
+*
+*/
+#include <fstream>
+#include <filesystem>
+#include "terrain/worldSave.h"
+#include "terrain/chunkManager.h"
+#include "scripts/gameObjects/player/inventory.h"
+#include "independent/systems/systems/randomiser.h"
+#include "independent/systems/systems/profiler.h"
+#include "independent/systems/systems/log.h"
+
+namespace
+{
+	const uint32_t WorldMagic = 0x444C574C; //!< The first four bytes of the world file, 'LWLD'
+	const uint32_t WorldVersion = 1; //!< Increase whenever the world file changes
+
+	/*! \struct WorldHeader
+	* \brief The start of the world file, followed by the inventory slots
+	*/
+	struct WorldHeader
+	{
+		uint32_t magic = WorldMagic; //!< Identifies the file as a world
+		uint32_t version = WorldVersion; //!< The format version
+		uint32_t seed = 0; //!< The seed the environment is generated from
+		uint32_t slotCount = 0; //!< The number of inventory slots which follow
+	};
+
+	/*! \struct SavedSlot
+	* \brief An inventory slot
+	*/
+	struct SavedSlot
+	{
+		uint8_t item; //!< The item
+		uint8_t state; //!< The item's state
+		uint16_t amount; //!< The number of items
+	};
+
+	//! getHarvestKey()
+	/*!
+	\param type a const WorldObject::WorldObject - The kind of object
+	\param index a const uint32_t - The index the object was generated at
+	\return a uint32_t - The key the object is saved under
+	*/
+	uint32_t getHarvestKey(const WorldObject::WorldObject type, const uint32_t index)
+	{
+		return (static_cast<uint32_t>(type) << 24) | (index & 0xFFFFFF);
+	}
+
+	//! getRegionPath()
+	/*!
+	\param directory a const std::string& - The directory of the world
+	\param region a const glm::ivec2& - The region coordinate
+	\return a std::string - The path of the region's file
+	*/
+	std::string getRegionPath(const std::string& directory, const glm::ivec2& region)
+	{
+		return directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".region";
+	}
+}
+
+bool WorldSave::s_open = false; //!< Set to false
+std::string WorldSave::s_directory = ""; //!< Set to blank
+float WorldSave::s_chunkSize = 0.f; //!< Set to 0
+float WorldSave::s_autosaveInterval = 10.f; //!< Save every 10 seconds unless the config says otherwise
+float WorldSave::s_sinceSave = 0.f; //!< Set to 0
+uint32_t WorldSave::s_seed = 0; //!< Set to 0
+Inventory* WorldSave::s_inventory = nullptr; //!< Set to null pointer
+std::vector<uint8_t> WorldSave::s_savedWorld; //!< Initialise empty
+std::unordered_map<uint64_t, WorldSave::Region> WorldSave::s_regions; //!< Initialise empty
+std::unordered_set<uint64_t> WorldSave::s_streamedChunks; //!< Initialise empty
+glm::ivec2 WorldSave::s_streamCentre = { 0, 0 }; //!< Set to the origin
+bool WorldSave::s_hasStreamed = false; //!< Set to false
+std::function<void(const PlacedObject&)> WorldSave::s_placedObjectLoader; //!< Set to no loader
+std::thread WorldSave::s_writer; //!< Not started
+std::mutex WorldSave::s_jobMutex; //!< Default mutex
+std::condition_variable WorldSave::s_jobCondition; //!< Default condition
+std::deque<WorldSave::SaveJob> WorldSave::s_jobs; //!< Initialise empty
+bool WorldSave::s_stopWriter = false; //!< Set to false
+
+//! getKey()
+/*!
+\param coordinate a const glm::ivec2& - The chunk or region coordinate
+\return a uint64_t - The key
+*/
+uint64_t WorldSave::getKey(const glm::ivec2& coordinate)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(coordinate.x)) << 32) | static_cast<uint32_t>(coordinate.y);
+}
+
+//! getChunkCoordinate()
+/*!
+\param position a const glm::vec3& - The world position
+\return a glm::ivec2 - The chunk the position is in, the same chunks the chunk manager draws
+*/
+glm::ivec2 WorldSave::getChunkCoordinate(const glm::vec3& position)
+{
+	return { static_cast<int>(floor(position.x / s_chunkSize)), static_cast<int>(floor(position.z / s_chunkSize)) };
+}
+
+//! getRegion()
+/*!
+\param region a const glm::ivec2& - The region coordinate
+\return a WorldSave::Region& - The region
+*/
+WorldSave::Region& WorldSave::getRegion(const glm::ivec2& region)
+{
+	auto it = s_regions.find(getKey(region));
+	if (it != s_regions.end()) return it->second;
+
+	// Nothing is read yet, chunks are decoded from the mapping as they are asked for
+	Region& newRegion = s_regions[getKey(region)];
+	newRegion.Coordinate = region;
+	newRegion.File.open(getRegionPath(s_directory, region));
+	return newRegion;
+}
+
+//! getChunk()
+/*!
+\param chunk a const glm::ivec2& - The chunk coordinate
+\return a ChunkDelta& - The changes of the chunk
+*/
+ChunkDelta& WorldSave::getChunk(const glm::ivec2& chunk)
+{
+	Region& region = getRegion(RegionFile::getRegion(chunk));
+	const uint32_t index = RegionFile::getChunkIndex(chunk);
+
+	auto it = region.Chunks.find(index);
+	if (it != region.Chunks.end()) return it->second;
+
+	ChunkDelta& delta = region.Chunks[index];
+	if (region.File.isOpen() && !region.File.readChunk(index, delta))
+		ENGINE_ERROR("[WorldSave::getChunk] Could not read a chunk, its changes are lost. Chunk: {0}, {1}.", chunk.x, chunk.y);
+
+	return delta;
+}
+
+//! editChunk()
+/*!
+\param chunk a const glm::ivec2& - The chunk coordinate
+\return a ChunkDelta& - The changes of the chunk
+*/
+ChunkDelta& WorldSave::editChunk(const glm::ivec2& chunk)
+{
+	Region& region = getRegion(RegionFile::getRegion(chunk));
+
+	// The whole region is rewritten when it is saved, so every chunk it holds is read before the mapping is let go
+	if (!region.Resident)
+	{
+		for (uint32_t i = 0; i < RegionFormat::ChunkCount; i++)
+		{
+			if (region.File.hasChunk(i) && region.Chunks.find(i) == region.Chunks.end())
+				region.File.readChunk(i, region.Chunks[i]);
+		}
+
+		region.File.close();
+		region.Resident = true;
+	}
+
+	region.Dirty = true;
+	return region.Chunks[RegionFile::getChunkIndex(chunk)];
+}
+
+//! encodeWorld()
+/*!
+\param data a std::vector<uint8_t>& - The encoded world file
+*/
+void WorldSave::encodeWorld(std::vector<uint8_t>& data)
+{
+	std::vector<SavedSlot> slots;
+	if (s_inventory)
+	{
+		for (uint32_t i = 0; i < INVENLIMIT; i++)
+		{
+			Item* item = s_inventory->getItem(i);
+			if (item)
+				slots.push_back({ static_cast<uint8_t>(item->getType()), static_cast<uint8_t>(item->getState()), static_cast<uint16_t>(s_inventory->getItemCount(i)) });
+		}
+	}
+
+	WorldHeader header;
+	header.seed = s_seed;
+	header.slotCount = static_cast<uint32_t>(slots.size());
+
+	data.resize(sizeof(WorldHeader) + slots.size() * sizeof(SavedSlot));
+	memcpy(data.data(), &header, sizeof(WorldHeader));
+	if (!slots.empty())
+		memcpy(data.data() + sizeof(WorldHeader), slots.data(), slots.size() * sizeof(SavedSlot));
+}
+
+//! readWorld()
+void WorldSave::readWorld()
+{
+	std::ifstream file(s_directory + "/world.dat", std::ios::binary | std::ios::ate);
+	if (file.is_open())
+	{
+		s_savedWorld.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(s_savedWorld.data()), s_savedWorld.size());
+
+		WorldHeader header;
+		if (file && s_savedWorld.size() >= sizeof(WorldHeader))
+		{
+			memcpy(&header, s_savedWorld.data(), sizeof(WorldHeader));
+			if (header.magic == WorldMagic && header.version == WorldVersion && s_savedWorld.size() == sizeof(WorldHeader) + header.slotCount * sizeof(SavedSlot))
+			{
+				s_seed = header.seed;
+				return;
+			}
+		}
+
+		ENGINE_ERROR("[WorldSave::readWorld] The world file is not valid, starting a new world. Directory: {0}.", s_directory);
+	}
+
+	// A new world, the seed is saved so the same trees and rocks are generated next time
+	s_savedWorld.clear();
+	s_seed = static_cast<uint32_t>(Randomiser::uniformIntBetween(0, INT32_MAX));
+}
+
+//! queueJob()
+/*!
+\param job a SaveJob&& - The file to write
+*/
+void WorldSave::queueJob(SaveJob&& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(s_jobMutex);
+
+		// A file still waiting from the last save is replaced, only its newest contents matter
+		auto it = std::find_if(s_jobs.begin(), s_jobs.end(), [&job](const SaveJob& queued) { return queued.FilePath == job.FilePath; });
+		if (it != s_jobs.end())
+			*it = std::move(job);
+		else
+			s_jobs.push_back(std::move(job));
+	}
+	s_jobCondition.notify_one();
+}
+
+//! runWriter()
+void WorldSave::runWriter()
+{
+	Profiler::setThreadName("WorldSave");
+
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(s_jobMutex);
+		s_jobCondition.wait(lock, [] { return s_stopWriter || !s_jobs.empty(); });
+		if (s_jobs.empty()) return;
+
+		SaveJob job = std::move(s_jobs.front());
+		s_jobs.pop_front();
+		lock.unlock();
+
+		ENGINE_PROFILE_SCOPE("WorldSave::write");
+		bool written;
+		if (job.Data.empty())
+			written = RegionFile::write(job.FilePath, job.Region, s_chunkSize, job.Chunks);
+		else
+		{
+			// Written next to the old file and swapped in, like the region files
+			{
+				std::ofstream file(job.FilePath + ".tmp", std::ios::binary | std::ios::trunc);
+				file.write(reinterpret_cast<const char*>(job.Data.data()), job.Data.size());
+				written = static_cast<bool>(file);
+			}
+
+			std::error_code error;
+			if (written) std::filesystem::rename(job.FilePath + ".tmp", job.FilePath, error);
+			written = written && !error;
+		}
+
+		if (!written)
+			ENGINE_ERROR("[WorldSave::runWriter] Could not write a save file. File Path: {0}.", job.FilePath);
+	}
+}
+
+//! open()
+void WorldSave::open()
+{
+	if (s_open) return;
+
+	nlohmann::json configData = ResourceManager::getJSON("assets/config.json");
+	s_directory = "saves/world";
+	if (configData.find("worldSave") != configData.end())
+	{
+		s_directory = configData["worldSave"].value("directory", s_directory);
+		s_autosaveInterval = configData["worldSave"].value("autosaveInterval", s_autosaveInterval);
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(s_directory, error);
+	if (error)
+	{
+		ENGINE_ERROR("[WorldSave::open] Could not create the save directory, the world will not be saved. Directory: {0}.", s_directory);
+		return;
+	}
+
+	s_chunkSize = ChunkManager::getChunkWorldSize();
+	s_sinceSave = 0.f;
+	s_hasStreamed = false;
+	readWorld();
+
+	s_stopWriter = false;
+	s_writer = std::thread(&WorldSave::runWriter);
+	s_open = true;
+}
+
+//! close()
+void WorldSave::close()
+{
+	if (!s_open) return;
+
+	save();
+
+	{
+		std::lock_guard<std::mutex> lock(s_jobMutex);
+		s_stopWriter = true;
+	}
+	s_jobCondition.notify_one();
+	s_writer.join();
+
+	s_regions.clear();
+	s_streamedChunks.clear();
+	s_savedWorld.clear();
+	s_inventory = nullptr;
+	s_placedObjectLoader = nullptr;
+	s_open = false;
+}
+
+//! isOpen()
+/*!
+\return a const bool - Is a world open
+*/
+const bool WorldSave::isOpen()
+{
+	return s_open;
+}
+
+//! onUpdate()
+/*!
+\param timestep a const float - The timestep
+*/
+void WorldSave::onUpdate(const float timestep)
+{
+	if (!s_open) return;
+
+	s_sinceSave += timestep;
+	if (s_sinceSave >= s_autosaveInterval)
+		save();
+}
+
+//! save()
+void WorldSave::save()
+{
+	ENGINE_PROFILE_FUNCTION();
+	if (!s_open) return;
+
+	s_sinceSave = 0.f;
+
+	// Only the regions changed since the last save are written, each is copied so the writer never sees a chunk change
+	for (auto& region : s_regions)
+	{
+		if (!region.second.Dirty) continue;
+
+		SaveJob job;
+		job.FilePath = getRegionPath(s_directory, region.second.Coordinate);
+		job.Region = region.second.Coordinate;
+		job.Chunks = region.second.Chunks;
+		queueJob(std::move(job));
+
+		region.second.Dirty = false;
+	}
+
+	std::vector<uint8_t> world;
+	encodeWorld(world);
+	if (world != s_savedWorld)
+	{
+		s_savedWorld = world;
+
+		SaveJob job;
+		job.FilePath = s_directory + "/world.dat";
+		job.Data = std::move(world);
+		queueJob(std::move(job));
+	}
+}
+
+//! streamChunks()
+/*!
+\param position a const glm::vec3& - The position streaming is centred on
+\param radius a const int - The number of chunks around the centre chunk in each direction
+*/
+void WorldSave::streamChunks(const glm::vec3& position, const int radius)
+{
+	if (!s_open) return;
+
+	// Nothing new can come into range until the centre moves to another chunk
+	const glm::ivec2 centre = getChunkCoordinate(position);
+	if (s_hasStreamed && centre == s_streamCentre) return;
+
+	ENGINE_PROFILE_FUNCTION();
+	s_streamCentre = centre;
+	s_hasStreamed = true;
+
+	for (int z = -radius; z <= radius; z++)
+	{
+		for (int x = -radius; x <= radius; x++)
+		{
+			const glm::ivec2 chunk = centre + glm::ivec2(x, z);
+			if (!s_streamedChunks.insert(getKey(chunk)).second) continue;
+
+			const ChunkDelta& delta = getChunk(chunk);
+			if (s_placedObjectLoader)
+			{
+				for (auto& object : delta.Placed)
+					s_placedObjectLoader(object);
+			}
+		}
+	}
+}
+
+//! setPlacedObjectLoader()
+/*!
+\param loader a const std::function<void(const PlacedObject&)>& - The function which creates a placed object
+*/
+void WorldSave::setPlacedObjectLoader(const std::function<void(const PlacedObject&)>& loader)
+{
+	s_placedObjectLoader = loader;
+}
+
+//! addPlacedObject()
+/*!
+\param item a const uint32_t - The item the object was placed from
+\param position a const glm::vec3& - The world position
+*/
+void WorldSave::addPlacedObject(const uint32_t item, const glm::vec3& position)
+{
+	if (!s_open) return;
+
+	editChunk(getChunkCoordinate(position)).Placed.push_back({ item, position });
+}
+
+//! harvest()
+/*!
+\param type a const WorldObject::WorldObject - The kind of object
+\param index a const uint32_t - The index the object was generated at
+\param position a const glm::vec3& - The world position
+*/
+void WorldSave::harvest(const WorldObject::WorldObject type, const uint32_t index, const glm::vec3& position)
+{
+	if (!s_open) return;
+
+	std::vector<uint32_t>& harvested = editChunk(getChunkCoordinate(position)).Harvested;
+	const uint32_t key = getHarvestKey(type, index);
+	auto it = std::lower_bound(harvested.begin(), harvested.end(), key);
+	if (it == harvested.end() || *it != key)
+		harvested.insert(it, key);
+}
+
+//! isHarvested()
+/*!
+\param type a const WorldObject::WorldObject - The kind of object
+\param index a const uint32_t - The index the object was generated at
+\param position a const glm::vec3& - The world position
+\return a const bool - Has the object been removed
+*/
+const bool WorldSave::isHarvested(const WorldObject::WorldObject type, const uint32_t index, const glm::vec3& position)
+{
+	if (!s_open) return false;
+
+	const std::vector<uint32_t>& harvested = getChunk(getChunkCoordinate(position)).Harvested;
+	return std::binary_search(harvested.begin(), harvested.end(), getHarvestKey(type, index));
+}
+
+//! getSeed()
+/*!
+\return a const uint32_t - The seed the environment is generated from
+*/
+const uint32_t WorldSave::getSeed()
+{
+	return s_seed;
+}
+
+//! setInventory()
+/*!
+\param inventory an Inventory* - The inventory, filled with the saved items
+*/
+void WorldSave::setInventory(Inventory* inventory)
+{
+	s_inventory = inventory;
+	if (!s_open || !inventory || s_savedWorld.empty()) return;
+
+	WorldHeader header;
+	memcpy(&header, s_savedWorld.data(), sizeof(WorldHeader));
+
+	const SavedSlot* slots = reinterpret_cast<const SavedSlot*>(s_savedWorld.data() + sizeof(WorldHeader));
+	for (uint32_t i = 0; i < header.slotCount; i++)
+		inventory->giveItem(static_cast<Items::Items>(slots[i].item), slots[i].state, slots[i].amount);
+}
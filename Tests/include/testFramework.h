@@ -0,0 +1,67 @@
+/*! \file testFramework.h
+*
+* \brief A small framework which registers and runs the engine's CPU only tests and benchmarks
+*
+* \author Daniel Bullin
+*
+*/
+#ifndef TESTFRAMEWORK_H
+#define TESTFRAMEWORK_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define TEST_CONCAT_INNER(x, y) x##y //!< Join two tokens
+#define TEST_CONCAT(x, y) TEST_CONCAT_INNER(x, y) //!< Join two tokens after expanding them
+
+#define ENGINE_TEST(name) static void name(); static Tests::Registration TEST_CONCAT(name, Registration)(#name, name, false); static void name() //!< Define a test, run by default
+#define ENGINE_BENCHMARK(name) static void name(); static Tests::Registration TEST_CONCAT(name, Registration)(#name, name, true); static void name() //!< Define a benchmark, run with the bench argument
+
+#define CHECK(x) Tests::check((x), #x, __FILE__, __LINE__) //!< Fail the running test if x is false
+#define CHECK_NEAR(a, b, epsilon) Tests::check(std::abs((a) - (b)) <= (epsilon), #a " near " #b, __FILE__, __LINE__) //!< Fail the running test if a and b are further apart than epsilon
+
+namespace Tests
+{
+	/*! \struct TestCase
+	* \brief A registered test or benchmark
+	*/
+	struct TestCase
+	{
+		const char* name; //!< The name of the test
+		void(*function)(); //!< The test
+		bool benchmark; //!< Is this a benchmark rather than a test
+	};
+
+	/*! \class Registration
+	* \brief Adds a test to the list of tests when it is constructed, one is defined next to every test
+	*/
+	class Registration
+	{
+	public:
+		Registration(const char* name, void(*function)(), const bool benchmark); //!< Constructor
+	};
+
+	/*! \class Timer
+	* \brief Measures the time since it was constructed
+	*/
+	class Timer
+	{
+	private:
+		std::chrono::steady_clock::time_point m_start; //!< The time the timer was constructed
+	public:
+		Timer() : m_start(std::chrono::steady_clock::now()) {} //!< Constructor
+		inline const double getMicroseconds() const { return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count(); } //!< Get the time since construction
+			/*!< \return a const double - The time in microseconds since the timer was constructed */
+	};
+
+	const std::string AssetRoot = "../Lone Wilderness/"; //!< The game's directory relative to the test project, the assets are read from here
+	const std::string OutputRoot = "testOutput/"; //!< The directory tests write their files to
+
+	std::vector<TestCase>& getTestCases(); //!< Get every registered test
+	const bool check(const bool passed, const char* expression, const char* file, const int line); //!< Record the result of a check
+	const uint32_t getFailures(); //!< Get the number of failed checks
+}
+#endif
@@ -0,0 +1,250 @@
+/*! \file batchTransformsTests.cpp
+*
+* \brief Checks the batched transform kernels against glm and measures how many matrices they build per microsecond
+*
+* \author Daniel Bullin
+*
+*/
+#include <cfloat>
+#include <cstdio>
+#include <random>
+#include "testFramework.h"
+#include "independent/utils/batchTransforms.h"
+
+using namespace Engine;
+
+namespace
+{
+	const float Epsilon = 1e-4f; //!< The largest difference allowed between a kernel and glm
+
+	//! getGLMModelMatrix()
+	/*!
+	\param position a const glm::vec3& - The position
+	\param orientation a const glm::vec3& - The rotation around x, y and z in degrees
+	\param scale a const glm::vec3& - The scale
+	\return a glm::mat4 - The model matrix built the way Transform built it before the kernels
+	*/
+	glm::mat4 getGLMModelMatrix(const glm::vec3& position, const glm::vec3& orientation, const glm::vec3& scale)
+	{
+		glm::mat4 model = glm::translate(glm::mat4(1.f), position);
+		model = glm::rotate(model, glm::radians(orientation.x), glm::vec3(1.f, 0.f, 0.f));
+		model = glm::rotate(model, glm::radians(orientation.y), glm::vec3(0.f, 1.f, 0.f));
+		model = glm::rotate(model, glm::radians(orientation.z), glm::vec3(0.f, 0.f, 1.f));
+		return glm::scale(model, scale);
+	}
+
+	//! isNear()
+	/*!
+	\param a a const glm::mat4& - The first matrix
+	\param b a const glm::mat4& - The second matrix
+	\return a const bool - Is every element of the matrices within the epsilon, relative to the size of the element
+	*/
+	const bool isNear(const glm::mat4& a, const glm::mat4& b)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				if (std::abs(a[column][row] - b[column][row]) > Epsilon * std::max(1.f, std::abs(b[column][row]))) return false;
+			}
+		}
+		return true;
+	}
+
+	/*! \struct Transforms
+	* \brief A list of random transforms
+	*/
+	struct Transforms
+	{
+		std::vector<glm::vec3> Positions; //!< The positions
+		std::vector<glm::vec3> Orientations; //!< The rotations in degrees
+		std::vector<glm::vec3> Scales; //!< The scales
+	};
+
+	//! getRandomTransforms()
+	/*!
+	\param count a const uint32_t - The number of transforms
+	\return a Transforms - The transforms, the same every run
+	*/
+	Transforms getRandomTransforms(const uint32_t count)
+	{
+		std::mt19937 generator(1234);
+		std::uniform_real_distribution<float> position(-500.f, 500.f);
+		std::uniform_real_distribution<float> angle(-360.f, 360.f);
+		std::uniform_real_distribution<float> scale(-4.f, 4.f);
+
+		Transforms transforms;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			transforms.Positions.push_back({ position(generator), position(generator), position(generator) });
+			transforms.Orientations.push_back({ angle(generator), angle(generator), angle(generator) });
+			transforms.Scales.push_back({ scale(generator), scale(generator), scale(generator) });
+		}
+		return transforms;
+	}
+}
+
+ENGINE_TEST(composeModelMatrixMatchesGLM)
+{
+	const Transforms transforms = getRandomTransforms(1000);
+	for (uint32_t i = 0; i < transforms.Positions.size(); i++)
+	{
+		const glm::mat4 expected = getGLMModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]);
+		CHECK(isNear(BatchTransforms::composeModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]), expected));
+	}
+}
+
+ENGINE_TEST(composeModelMatricesMatchesGLM)
+{
+	// An odd count so both the four wide loop and the remainder are checked
+	const uint32_t count = 1003;
+	const Transforms transforms = getRandomTransforms(count);
+
+	std::vector<glm::mat4> matrices(count);
+	BatchTransforms::composeModelMatrices(transforms.Positions.data(), transforms.Orientations.data(), transforms.Scales.data(), matrices.data(), count);
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (!isNear(matrices[i], getGLMModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]))) mismatches++;
+	}
+	CHECK(mismatches == 0);
+}
+
+ENGINE_TEST(composeUnrotatedModelMatricesMatchesGLM)
+{
+	const uint32_t count = 37;
+	const Transforms transforms = getRandomTransforms(count);
+	const glm::vec3 scale = { 6.f, 0.25f, -2.f };
+
+	std::vector<glm::mat4> matrices(count);
+	BatchTransforms::composeModelMatrices(transforms.Positions.data(), scale, matrices.data(), count);
+
+	for (uint32_t i = 0; i < count; i++)
+		CHECK(isNear(matrices[i], getGLMModelMatrix(transforms.Positions[i], glm::vec3(0.f), scale)));
+}
+
+ENGINE_TEST(transformBoundsMatchesCorners)
+{
+	const uint32_t count = 200;
+	const Transforms transforms = getRandomTransforms(count);
+
+	std::vector<glm::mat4> matrices(count);
+	std::vector<AABB> localBounds(count);
+	std::vector<AABB> worldBounds(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		matrices[i] = getGLMModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]);
+		localBounds[i] = { glm::vec3(-1.f, 0.f, -2.f) + glm::vec3(i * 0.01f), glm::vec3(3.f, 5.f, 1.f) };
+	}
+
+	BatchTransforms::transformBounds(matrices.data(), localBounds.data(), worldBounds.data(), count);
+
+	// The box of the eight transformed corners is exactly the box the kernel should give
+	for (uint32_t i = 0; i < count; i++)
+	{
+		glm::vec3 minimum(FLT_MAX), maximum(-FLT_MAX);
+		for (uint32_t corner = 0; corner < 8; corner++)
+		{
+			const glm::vec3 local = { corner & 1 ? localBounds[i].Max.x : localBounds[i].Min.x, corner & 2 ? localBounds[i].Max.y : localBounds[i].Min.y,
+				corner & 4 ? localBounds[i].Max.z : localBounds[i].Min.z };
+			const glm::vec3 world = glm::vec3(matrices[i] * glm::vec4(local, 1.f));
+			minimum = glm::min(minimum, world);
+			maximum = glm::max(maximum, world);
+		}
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			CHECK_NEAR(worldBounds[i].Min[axis], minimum[axis], 1e-2f);
+			CHECK_NEAR(worldBounds[i].Max[axis], maximum[axis], 1e-2f);
+		}
+	}
+}
+
+ENGINE_TEST(decomposeQuadMatchesGLM)
+{
+	const glm::vec3 position = { 120.f, 48.f, 0.5f };
+	const float rotation = glm::radians(30.f);
+	const glm::vec2 size = { 64.f, 32.f };
+
+	glm::mat4 model = glm::translate(glm::mat4(1.f), position);
+	model = glm::rotate(model, rotation, glm::vec3(0.f, 0.f, 1.f));
+	model = glm::scale(model, glm::vec3(size, 1.f));
+
+	glm::vec4 transform;
+	glm::vec2 decomposedSize;
+	BatchTransforms::decomposeQuad(model, transform, decomposedSize);
+
+	CHECK_NEAR(transform.x, position.x, Epsilon);
+	CHECK_NEAR(transform.y, position.y, Epsilon);
+	CHECK_NEAR(transform.z, position.z, Epsilon);
+	CHECK_NEAR(transform.w, rotation, Epsilon);
+	CHECK_NEAR(decomposedSize.x, size.x, Epsilon * size.x);
+	CHECK_NEAR(decomposedSize.y, size.y, Epsilon * size.y);
+
+	// A mirrored quad keeps its rotation and flips its height
+	BatchTransforms::decomposeQuad(glm::scale(model, glm::vec3(1.f, -1.f, 1.f)), transform, decomposedSize);
+	CHECK_NEAR(transform.w, rotation, Epsilon);
+	CHECK_NEAR(decomposedSize.y, -size.y, Epsilon * size.y);
+}
+
+ENGINE_BENCHMARK(composeModelMatricesThroughput)
+{
+	const uint32_t count = 100000;
+	const uint32_t repeats = 20;
+	const Transforms transforms = getRandomTransforms(count);
+	std::vector<glm::mat4> matrices(count);
+
+	// The sum stops the compiler throwing the matrices away
+	float sum = 0.f;
+
+	Tests::Timer glmTimer;
+	for (uint32_t repeat = 0; repeat < repeats; repeat++)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			matrices[i] = getGLMModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]);
+		sum += matrices[repeat][3][0];
+	}
+	const double glmTime = glmTimer.getMicroseconds();
+
+	Tests::Timer singleTimer;
+	for (uint32_t repeat = 0; repeat < repeats; repeat++)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			matrices[i] = BatchTransforms::composeModelMatrix(transforms.Positions[i], transforms.Orientations[i], transforms.Scales[i]);
+		sum += matrices[repeat][3][0];
+	}
+	const double singleTime = singleTimer.getMicroseconds();
+
+	Tests::Timer batchTimer;
+	for (uint32_t repeat = 0; repeat < repeats; repeat++)
+	{
+		BatchTransforms::composeModelMatrices(transforms.Positions.data(), transforms.Orientations.data(), transforms.Scales.data(), matrices.data(), count);
+		sum += matrices[repeat][3][0];
+	}
+	const double batchTime = batchTimer.getMicroseconds();
+
+	const double built = static_cast<double>(count) * repeats;
+	printf("    glm::translate/rotate/scale: %.1f matrices/us\n", built / glmTime);
+	printf("    composeModelMatrix: %.1f matrices/us\n", built / singleTime);
+	printf("    composeModelMatrices: %.1f matrices/us (checksum %f)\n", built / batchTime, sum);
+}
+
+ENGINE_BENCHMARK(transformBoundsThroughput)
+{
+	const uint32_t count = 100000;
+	const uint32_t repeats = 20;
+	const Transforms transforms = getRandomTransforms(count);
+
+	std::vector<glm::mat4> matrices(count);
+	BatchTransforms::composeModelMatrices(transforms.Positions.data(), transforms.Orientations.data(), transforms.Scales.data(), matrices.data(), count);
+	std::vector<AABB> localBounds(count, { glm::vec3(-1.f), glm::vec3(1.f) });
+	std::vector<AABB> worldBounds(count);
+
+	Tests::Timer timer;
+	for (uint32_t repeat = 0; repeat < repeats; repeat++)
+		BatchTransforms::transformBounds(matrices.data(), localBounds.data(), worldBounds.data(), count);
+	const double time = timer.getMicroseconds();
+
+	printf("    transformBounds: %.1f boxes/us (checksum %f)\n", static_cast<double>(count) * repeats / time, worldBounds[count / 2].Min.x);
+}
@@ -0,0 +1,154 @@
+/*! \file meshCookerTests.cpp
+*
+* \brief Cooks every model in the game's model list, in the plain and quantised layouts, and checks each cooked file reads back,
+* maps and verifies against its source
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <json.hpp>
+#include "testFramework.h"
+#include "independent/rendering/geometry/meshCooker.h"
+
+using namespace Engine;
+
+namespace
+{
+	//! getModelSources()
+	/*!
+	\return a std::vector<std::string> - Every model file in the game's model list
+	*/
+	std::vector<std::string> getModelSources()
+	{
+		std::vector<std::string> sources;
+		std::ifstream file(Tests::AssetRoot + "assets/models.json");
+		if (!file) return sources;
+
+		const nlohmann::json modelList = nlohmann::json::parse(file);
+		for (auto& model : modelList["models"])
+			sources.push_back(Tests::AssetRoot + model["modelFilePath"].get<std::string>());
+		return sources;
+	}
+
+	//! checkLayout()
+	/*!
+	\param mesh a const CookedMesh& - The cooked mesh as it was read back
+	\return a const bool - Does every submesh lie inside the vertices and indices, and every index inside its submesh
+	*/
+	const bool checkLayout(const CookedMesh& mesh)
+	{
+		uint32_t vertexCount = 0, indexCount = 0;
+		for (auto& submesh : mesh.Submeshes)
+		{
+			if (submesh.FirstVertex != vertexCount || submesh.FirstIndex != indexCount || submesh.MaterialIndex >= mesh.Materials.size()) return false;
+			vertexCount += submesh.VertexCount;
+			indexCount += submesh.IndexCount;
+
+			// Indices are relative to their submesh
+			for (uint32_t i = submesh.FirstIndex; i < submesh.FirstIndex + submesh.IndexCount; i++)
+			{
+				if (mesh.Indices[i] >= submesh.VertexCount) return false;
+			}
+		}
+		return vertexCount == mesh.Vertices.size() && indexCount == mesh.Indices.size();
+	}
+
+	//! checkMapped()
+	/*!
+	\param mesh a const CookedMesh& - The cooked mesh as it was read back
+	\param meshes a const std::vector<Mesh3D>& - The meshes mapped from the same file
+	\return a const bool - Does each mapped mesh point at exactly its submesh's vertices and indices
+	*/
+	const bool checkMapped(const CookedMesh& mesh, const std::vector<Mesh3D>& meshes)
+	{
+		if (meshes.size() != mesh.Submeshes.size()) return false;
+		for (uint32_t i = 0; i < meshes.size(); i++)
+		{
+			const CookedSubmesh& submesh = mesh.Submeshes[i];
+			if (meshes[i].getVertexCount() != submesh.VertexCount || meshes[i].getIndexCount() != submesh.IndexCount) return false;
+			if (memcmp(meshes[i].getVertexData(), mesh.Vertices.data() + submesh.FirstVertex, submesh.VertexCount * sizeof(Vertex3D)) != 0) return false;
+			if (memcmp(meshes[i].getIndexData(), mesh.Indices.data() + submesh.FirstIndex, submesh.IndexCount * sizeof(uint32_t)) != 0) return false;
+		}
+		return true;
+	}
+
+	//! cookAndVerify()
+	/*!
+	\param quantise a const bool - Cook the models with quantised positions and texture coordinates
+	\param suffix a const std::string& - Added to the name of each cooked file
+	*/
+	void cookAndVerify(const bool quantise, const std::string& suffix)
+	{
+		const std::vector<std::string> sources = getModelSources();
+		if (!CHECK(!sources.empty())) return;
+
+		const std::string directory = Tests::OutputRoot + "meshes/";
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		uint64_t sourceBytes = 0;
+		uint64_t cookedBytes = 0;
+		uint32_t vertexCount = 0;
+		Tests::Timer timer;
+		for (auto& source : sources)
+		{
+			const std::string cookedPath = directory + std::filesystem::path(source).stem().string() + "." + suffix + ".cmsh";
+			if (!CHECK(MeshCooker::cook(source, cookedPath, quantise)))
+			{
+				printf("    Cannot cook: %s\n", source.c_str());
+				continue;
+			}
+
+			if (!CHECK(MeshCooker::verify(source, cookedPath)))
+				printf("    Cooked mesh does not match: %s\n", source.c_str());
+
+			CookedMesh mesh;
+			if (CHECK(MeshCooker::read(cookedPath, mesh)))
+			{
+				CHECK(!mesh.Submeshes.empty());
+				if (!CHECK(checkLayout(mesh)))
+					printf("    Cooked mesh has submeshes outside its vertices or indices: %s\n", source.c_str());
+				vertexCount += static_cast<uint32_t>(mesh.Vertices.size());
+
+				// Only the plain layout is mapped, the quantised one has to be expanded by read()
+				std::vector<Mesh3D> meshes;
+				if (!quantise && CHECK(MeshCooker::map(cookedPath, meshes)))
+				{
+					if (!CHECK(checkMapped(mesh, meshes)))
+						printf("    Mapped meshes do not match the cooked mesh: %s\n", source.c_str());
+
+					// Releasing the data leaves nothing to upload
+					meshes[0].releaseData();
+					CHECK(meshes[0].getVertexCount() == 0 && meshes[0].getIndexCount() == 0);
+				}
+				else if (quantise)
+					CHECK(!MeshCooker::map(cookedPath, meshes));
+
+				// A cooked file is not used once its model changes
+				CHECK(!MeshCooker::map(cookedPath, meshes, std::filesystem::file_size(source, error) + 1, 1));
+				CHECK(!MeshCooker::read(cookedPath, mesh, std::filesystem::file_size(source, error) + 1, 1));
+			}
+
+			sourceBytes += std::filesystem::file_size(source, error);
+			cookedBytes += std::filesystem::file_size(cookedPath, error);
+			std::filesystem::remove(cookedPath, error);
+		}
+
+		printf("    Cooked and verified %zu models with %u vertices in %.1fms, %llu source bytes to %llu cooked bytes.\n", sources.size(), vertexCount,
+			timer.getMicroseconds() / 1000.0, static_cast<unsigned long long>(sourceBytes), static_cast<unsigned long long>(cookedBytes));
+	}
+}
+
+ENGINE_TEST(meshCookerCooksGameModelsPlain)
+{
+	cookAndVerify(false, "plain");
+}
+
+ENGINE_TEST(meshCookerCooksGameModelsQuantised)
+{
+	cookAndVerify(true, "quantised");
+}
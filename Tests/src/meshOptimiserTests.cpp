@@ -0,0 +1,229 @@
+/*! \file meshOptimiserTests.cpp
+*
+* \brief Checks the mesh optimiser welds duplicate vertices, keeps every triangle and its winding, and does not make the vertex
+* cache miss ratio worse, on a grid mesh and the same grid with its triangles shuffled
+*
+* \author Daniel Bullin
+*
+*/
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include "testFramework.h"
+#include "independent/rendering/geometry/meshOptimiser.h"
+
+using namespace Engine;
+
+namespace
+{
+	const uint32_t GridSize = 48; //!< The number of quads along each side of the test grid
+
+	using VertexKey = std::tuple<float, float, float, float, float>; //!< The position and texture coordinate of a vertex
+	using TriangleKey = std::tuple<VertexKey, VertexKey, VertexKey>; //!< The vertices of a triangle in drawing order
+
+	//! getVertex()
+	/*!
+	\param x a const uint32_t - The column of the grid point
+	\param z a const uint32_t - The row of the grid point
+	\param negativeZero a const bool - Give the centre column a position of -0 rather than 0
+	\return a Vertex3D - The vertex of the grid point, the grid lies flat and is centred on the origin
+	*/
+	Vertex3D getVertex(const uint32_t x, const uint32_t z, const bool negativeZero)
+	{
+		float positionX = static_cast<float>(x) - static_cast<float>(GridSize / 2);
+		if (positionX == 0.f && negativeZero) positionX = -0.f;
+
+		return Vertex3D({ positionX, 0.f, static_cast<float>(z) - static_cast<float>(GridSize / 2) },
+			{ static_cast<float>(x) / GridSize, static_cast<float>(z) / GridSize }, { 0, 32767, 0 }, { 32767, 0, 0 }, { 0, 0, 32767 });
+	}
+
+	//! getGrid()
+	/*!
+	\param vertices a std::vector<Vertex3D>& - The vertices of the grid
+	\param indices a std::vector<uint32_t>& - The triangles of the grid, row by row, each facing up
+	\param welded a const bool - Share the vertices between triangles, otherwise every triangle has its own copies the way an
+	unwelded model file does, with every other copy on the centre column at -0
+	*/
+	void getGrid(std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices, const bool welded)
+	{
+		vertices.clear();
+		indices.clear();
+		if (welded)
+		{
+			for (uint32_t z = 0; z <= GridSize; z++)
+			{
+				for (uint32_t x = 0; x <= GridSize; x++)
+					vertices.push_back(getVertex(x, z, false));
+			}
+		}
+
+		for (uint32_t z = 0; z < GridSize; z++)
+		{
+			for (uint32_t x = 0; x < GridSize; x++)
+			{
+				// Counter clockwise seen from above
+				const uint32_t corners[6][2] = { { x, z }, { x, z + 1 }, { x + 1, z }, { x + 1, z }, { x, z + 1 }, { x + 1, z + 1 } };
+				for (uint32_t k = 0; k < 6; k++)
+				{
+					if (welded)
+						indices.push_back(corners[k][1] * (GridSize + 1) + corners[k][0]);
+					else
+					{
+						indices.push_back(static_cast<uint32_t>(vertices.size()));
+						vertices.push_back(getVertex(corners[k][0], corners[k][1], vertices.size() % 2 == 1));
+					}
+				}
+			}
+		}
+	}
+
+	//! shuffleTriangles()
+	/*!
+	\param indices a std::vector<uint32_t>& - The triangles, shuffled the same way every run
+	*/
+	void shuffleTriangles(std::vector<uint32_t>& indices)
+	{
+		std::mt19937 generator(1234);
+		for (uint32_t t = static_cast<uint32_t>(indices.size() / 3) - 1; t > 0; t--)
+		{
+			const uint32_t other = std::uniform_int_distribution<uint32_t>(0, t)(generator);
+			for (uint32_t k = 0; k < 3; k++) std::swap(indices[t * 3 + k], indices[other * 3 + k]);
+		}
+	}
+
+	//! getTriangles()
+	/*!
+	\param vertices a const std::vector<Vertex3D>& - The vertices
+	\param indices a const std::vector<uint32_t>& - The triangles
+	\return a std::vector<TriangleKey> - Every triangle by the vertices it draws, rotated to start at its smallest vertex so the
+	winding is kept, and sorted so lists can be compared whatever order the triangles are in
+	*/
+	std::vector<TriangleKey> getTriangles(const std::vector<Vertex3D>& vertices, const std::vector<uint32_t>& indices)
+	{
+		auto getKey = [&vertices](const uint32_t index)
+		{
+			// -0 and 0 draw the same
+			const Vertex3D& vertex = vertices[index];
+			return VertexKey(vertex.Position.x + 0.f, vertex.Position.y + 0.f, vertex.Position.z + 0.f, vertex.TexCoords.x, vertex.TexCoords.y);
+		};
+
+		std::vector<TriangleKey> triangles;
+		for (size_t t = 0; t + 2 < indices.size(); t += 3)
+		{
+			VertexKey keys[3] = { getKey(indices[t]), getKey(indices[t + 1]), getKey(indices[t + 2]) };
+			const uint32_t first = keys[0] < keys[1] ? (keys[0] < keys[2] ? 0 : 2) : (keys[1] < keys[2] ? 1 : 2);
+			triangles.emplace_back(keys[first], keys[(first + 1) % 3], keys[(first + 2) % 3]);
+		}
+
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	//! isFacingUp()
+	/*!
+	\param vertices a const std::vector<Vertex3D>& - The vertices
+	\param indices a const std::vector<uint32_t>& - The triangles
+	\return a const bool - Does every triangle still face up, counter clockwise seen from above
+	*/
+	const bool isFacingUp(const std::vector<Vertex3D>& vertices, const std::vector<uint32_t>& indices)
+	{
+		for (size_t t = 0; t + 2 < indices.size(); t += 3)
+		{
+			const glm::vec3& a = vertices[indices[t]].Position;
+			const glm::vec3 normal = glm::cross(vertices[indices[t + 1]].Position - a, vertices[indices[t + 2]].Position - a);
+			if (normal.y <= 0.f) return false;
+		}
+		return true;
+	}
+
+	//! isInFetchOrder()
+	/*!
+	\param indices a const std::vector<uint32_t>& - The triangles
+	\param vertexCount a const uint32_t - The number of vertices
+	\return a const bool - Is every vertex used, and first used in the order it is stored
+	*/
+	const bool isInFetchOrder(const std::vector<uint32_t>& indices, const uint32_t vertexCount)
+	{
+		uint32_t next = 0;
+		for (auto& index : indices)
+		{
+			if (index > next) return false;
+			if (index == next) next++;
+		}
+		return next == vertexCount;
+	}
+
+	//! checkOptimise()
+	/*!
+	\param name a const char* - The name of the mesh
+	\param vertices a std::vector<Vertex3D>& - The vertices
+	\param indices a std::vector<uint32_t>& - The triangles
+	*/
+	void checkOptimise(const char* name, std::vector<Vertex3D>& vertices, std::vector<uint32_t>& indices)
+	{
+		const std::vector<TriangleKey> triangles = getTriangles(vertices, indices);
+		const float before = MeshOptimiser::getACMR(indices, static_cast<uint32_t>(vertices.size()));
+
+		MeshOptimiser::setEnabled(true, true);
+		MeshOptimiser::optimise(name, vertices, indices);
+		const float after = MeshOptimiser::getACMR(indices, static_cast<uint32_t>(vertices.size()));
+
+		CHECK(indices.size() == GridSize * GridSize * 6);
+		CHECK(vertices.size() == (GridSize + 1) * (GridSize + 1));
+		CHECK(getTriangles(vertices, indices) == triangles);
+		CHECK(isFacingUp(vertices, indices));
+		CHECK(isInFetchOrder(indices, static_cast<uint32_t>(vertices.size())));
+		CHECK(after <= before);
+		printf("    %s: ACMR %.3f before and %.3f after.\n", name, before, after);
+	}
+}
+
+ENGINE_TEST(meshOptimiserWeldMergesDuplicateVertices)
+{
+	std::vector<Vertex3D> vertices;
+	std::vector<uint32_t> indices;
+	getGrid(vertices, indices, false);
+	const std::vector<TriangleKey> triangles = getTriangles(vertices, indices);
+	CHECK(vertices.size() == indices.size());
+
+	// Every grid point is kept once, including the ones at -0 on the centre column
+	MeshOptimiser::weld(vertices, indices);
+	CHECK(vertices.size() == (GridSize + 1) * (GridSize + 1));
+	CHECK(getTriangles(vertices, indices) == triangles);
+	CHECK(isFacingUp(vertices, indices));
+
+	// Vertices which differ in any attribute are not merged
+	std::vector<Vertex3D> different = { getVertex(0, 0, false), getVertex(0, 0, false), getVertex(0, 0, false) };
+	different[1].TexCoords.x += 0.5f;
+	different[2].Normal[0] = 1;
+	std::vector<uint32_t> differentIndices = { 0, 1, 2 };
+	MeshOptimiser::weld(different, differentIndices);
+	CHECK(different.size() == 3);
+}
+
+ENGINE_TEST(meshOptimiserKeepsTrianglesOfGrid)
+{
+	std::vector<Vertex3D> vertices;
+	std::vector<uint32_t> indices;
+	getGrid(vertices, indices, true);
+	checkOptimise("grid", vertices, indices);
+}
+
+ENGINE_TEST(meshOptimiserKeepsTrianglesOfShuffledGrid)
+{
+	std::vector<Vertex3D> vertices;
+	std::vector<uint32_t> indices;
+	getGrid(vertices, indices, true);
+	shuffleTriangles(indices);
+	checkOptimise("shuffled grid", vertices, indices);
+}
+
+ENGINE_TEST(meshOptimiserKeepsTrianglesOfUnweldedGrid)
+{
+	std::vector<Vertex3D> vertices;
+	std::vector<uint32_t> indices;
+	getGrid(vertices, indices, false);
+	shuffleTriangles(indices);
+	checkOptimise("unwelded shuffled grid", vertices, indices);
+}
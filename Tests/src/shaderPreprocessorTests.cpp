@@ -0,0 +1,177 @@
+/*! \file shaderPreprocessorTests.cpp
+*
+* \brief Checks the shader preprocessor's includes, defines and permutation keys with shader files held in memory
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include <unordered_map>
+#include "testFramework.h"
+#include "independent/rendering/shaders/shaderPreprocessor.h"
+
+using namespace Engine;
+
+namespace
+{
+	using ShaderFiles = std::unordered_map<std::string, std::string>; //!< The contents of shader files by path
+
+	//! getReader()
+	/*!
+	\param files a const ShaderFiles& - The files, they must outlive the reader
+	\return a ShaderFileReader - A reader of the files, an empty string for a file that is not in the list
+	*/
+	ShaderFileReader getReader(const ShaderFiles& files)
+	{
+		return [&files](const std::string& filePath)
+		{
+			auto file = files.find(filePath);
+			return file != files.end() ? file->second : std::string();
+		};
+	}
+
+	//! countOf()
+	/*!
+	\param source a const std::string& - The source
+	\param text a const std::string& - The text to look for
+	\return a uint32_t - The number of times the text appears in the source
+	*/
+	uint32_t countOf(const std::string& source, const std::string& text)
+	{
+		uint32_t count = 0;
+		for (size_t i = source.find(text); i != std::string::npos; i = source.find(text, i + text.size()))
+			count++;
+		return count;
+	}
+}
+
+ENGINE_TEST(shaderPreprocessorExpandsNestedIncludes)
+{
+	const ShaderFiles files = {
+		{ "shaders/blinnPhong/vertex.vs", "#version 440 core\n#include \"../include/lights.glsl\"\n#include \"../include/camera.glsl\"\nvoid main() {}\n" },
+		{ "shaders/include/lights.glsl", "#pragma once\n#include \"camera.glsl\"\nstruct Light { vec4 position; };\n" },
+		{ "shaders/include/camera.glsl", "#pragma once\nlayout(std140) uniform Camera { mat4 u_view; };\n" }
+	};
+
+	std::string output;
+	if (!CHECK(ShaderPreprocessor::process("shaders/blinnPhong/vertex.vs", {}, output, getReader(files)))) return;
+
+	// The camera is included by both files but only expanded once, before the lights which need it
+	CHECK(countOf(output, "uniform Camera") == 1);
+	CHECK(countOf(output, "struct Light") == 1);
+	CHECK(output.find("uniform Camera") < output.find("struct Light"));
+	CHECK(output.find("void main()") != std::string::npos);
+	CHECK(output.find("#include") == std::string::npos);
+	CHECK(output.find("#pragma once") == std::string::npos);
+
+	// Each included file starts at line 1 and the including file carries on from the line after the include
+	CHECK(output.find("#line 1\n\n#line 1\n") != std::string::npos);
+	CHECK(output.find("#line 3\nstruct Light") != std::string::npos);
+	CHECK(output.find("#line 3\n\nvoid main()") != std::string::npos);
+}
+
+ENGINE_TEST(shaderPreprocessorResolvesIncludePaths)
+{
+	CHECK(ShaderPreprocessor::resolvePath("assets/shaders/blinnPhong/vertex.vs", "../include/lights.glsl") == "assets/shaders/include/lights.glsl");
+	CHECK(ShaderPreprocessor::resolvePath("assets\\shaders\\sky\\vertex.vs", "./camera.glsl") == "assets/shaders/sky/camera.glsl");
+	CHECK(ShaderPreprocessor::resolvePath("vertex.vs", "../camera.glsl") == "../camera.glsl");
+	CHECK(ShaderPreprocessor::resolvePath("/shaders/a/vertex.vs", "../../camera.glsl") == "/camera.glsl");
+}
+
+ENGINE_TEST(shaderPreprocessorRejectsDeepIncludes)
+{
+	// Each file includes the next, deeper than the preprocessor allows
+	const uint32_t depth = 20;
+	ShaderFiles files;
+	files["shaders/main.fs"] = "#version 440 core\n#include \"file0.glsl\"\n";
+	for (uint32_t i = 0; i < depth; i++)
+		files["shaders/file" + std::to_string(i) + ".glsl"] = i + 1 < depth ? "#include \"file" + std::to_string(i + 1) + ".glsl\"\n" : "float last;\n";
+
+	std::string output;
+	printf("    An error is expected below\n");
+	CHECK(!ShaderPreprocessor::process("shaders/main.fs", {}, output, getReader(files)));
+
+	// A chain well inside the limit is fine
+	files["shaders/file4.glsl"] = "float last;\n";
+	CHECK(ShaderPreprocessor::process("shaders/main.fs", {}, output, getReader(files)));
+	CHECK(output.find("float last;") != std::string::npos);
+}
+
+ENGINE_TEST(shaderPreprocessorRejectsMissingIncludes)
+{
+	const ShaderFiles files = {
+		{ "shaders/main.fs", "#version 440 core\n#include \"present.glsl\"\n" },
+		{ "shaders/present.glsl", "#include \"missing.glsl\"\n" }
+	};
+
+	std::string output;
+	printf("    Two errors are expected below\n");
+	CHECK(!ShaderPreprocessor::process("shaders/main.fs", {}, output, getReader(files)));
+	CHECK(!ShaderPreprocessor::process("shaders/absent.fs", {}, output, getReader(files)));
+}
+
+ENGINE_TEST(shaderPreprocessorRejectsMalformedIncludes)
+{
+	const ShaderFiles files = {
+		{ "shaders/unquoted.fs", "#version 440 core\n#include camera.glsl\n" },
+		{ "shaders/unterminated.fs", "#version 440 core\n#include \"camera.glsl\n" },
+		{ "shaders/camera.glsl", "float camera;\n" }
+	};
+
+	std::string output;
+	printf("    Two errors are expected below\n");
+	CHECK(!ShaderPreprocessor::process("shaders/unquoted.fs", {}, output, getReader(files)));
+	CHECK(!ShaderPreprocessor::process("shaders/unterminated.fs", {}, output, getReader(files)));
+}
+
+ENGINE_TEST(shaderPreprocessorInsertsDefinesAfterVersion)
+{
+	const ShaderDefines defines = { { "MAX_LIGHTS", "10" }, { "USE_BLOOM", "1" } };
+	const ShaderFiles files = {
+		{ "shaders/main.fs", "// A comment first\r\n#version 440 core\r\n#include \"common.glsl\"\r\nvoid main() {}\r\n" },
+		{ "shaders/common.glsl", "#version 440 core\nfloat common;\n" },
+		{ "shaders/noVersion.glsl", "float noVersion;\n" }
+	};
+
+	std::string output;
+	if (CHECK(ShaderPreprocessor::process("shaders/main.fs", defines, output, getReader(files))))
+	{
+		// The defines follow the version, the line numbers carry on as they were in the file and carriage returns are dropped
+		CHECK(output.find("// A comment first\n#version 440 core\n#define MAX_LIGHTS 10\n#define USE_BLOOM 1\n#line 3\n") == 0);
+		CHECK(countOf(output, "#version") == 1);
+		CHECK(countOf(output, "#define") == 2);
+		CHECK(output.find('\r') == std::string::npos);
+	}
+
+	// Without a version line the defines go first
+	if (CHECK(ShaderPreprocessor::process("shaders/noVersion.glsl", defines, output, getReader(files))))
+		CHECK(output == "#define MAX_LIGHTS 10\n#define USE_BLOOM 1\n#line 1\nfloat noVersion;\n");
+}
+
+ENGINE_TEST(shaderPreprocessorPermutationKeysAreStable)
+{
+	const ShaderDefines defines = { { "MAX_LIGHTS", "10" }, { "USE_BLOOM", "1" } };
+	const ShaderDefines reordered = { { "USE_BLOOM", "1" }, { "MAX_LIGHTS", "10" } };
+	const ShaderDefines changed = { { "MAX_LIGHTS", "10" }, { "USE_BLOOM", "0" } };
+
+	CHECK(ShaderPreprocessor::getPermutationKey(defines) == "MAX_LIGHTS=10;USE_BLOOM=1");
+	CHECK(ShaderPreprocessor::getPermutationKey(defines) == ShaderPreprocessor::getPermutationKey(ShaderDefines(defines)));
+	CHECK(ShaderPreprocessor::getPermutationKey(reordered) != ShaderPreprocessor::getPermutationKey(defines));
+	CHECK(ShaderPreprocessor::getPermutationKey(changed) != ShaderPreprocessor::getPermutationKey(defines));
+	CHECK(ShaderPreprocessor::getPermutationKey({}).empty());
+
+	// The binary cache is keyed by the hash, so it must be the published FNV-1a values on every run and platform
+	CHECK(ShaderPreprocessor::hash("") == 14695981039346656037ull);
+	CHECK(ShaderPreprocessor::hash("a") == 0xaf63dc4c8601ec8cull);
+	CHECK(ShaderPreprocessor::hash("foobar") == 0x85944171f73967e8ull);
+	CHECK(ShaderPreprocessor::hash("bar", ShaderPreprocessor::hash("foo")) == ShaderPreprocessor::hash("foobar"));
+
+	// The same source and defines preprocess to the same text, and so the same key
+	const ShaderFiles files = { { "shaders/main.fs", "#version 440 core\nvoid main() {}\n" } };
+	std::string first, second, other;
+	ShaderPreprocessor::process("shaders/main.fs", defines, first, getReader(files));
+	ShaderPreprocessor::process("shaders/main.fs", defines, second, getReader(files));
+	ShaderPreprocessor::process("shaders/main.fs", changed, other, getReader(files));
+	CHECK(ShaderPreprocessor::hash(first) == ShaderPreprocessor::hash(second));
+	CHECK(ShaderPreprocessor::hash(first) != ShaderPreprocessor::hash(other));
+}
@@ -0,0 +1,295 @@
+/*! \file shaderReflectionTests.cpp
+*
+* \brief Checks the shader reflection's JSON format and that the uniforms and uniform blocks listed in the shaders.json files are
+* declared by their programs, without a GL context
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "testFramework.h"
+#include "independent/rendering/shaders/shaderReflection.h"
+#include "independent/rendering/shaders/shaderPreprocessor.h"
+
+using namespace Engine;
+
+namespace
+{
+	const char* Stages[] = { "vertexShader", "fragmentShader", "geometryShader", "tessControlShader", "tessEvaluationShader" }; //!< The keys of a program's stages in shaders.json
+
+	//! readAsset()
+	/*!
+	\param filePath a const std::string& - The path of the file relative to the game's directory
+	\return a std::string - The contents of the file, an empty string if it cannot be read
+	*/
+	std::string readAsset(const std::string& filePath)
+	{
+		std::ifstream file(Tests::AssetRoot + filePath, std::ios::binary);
+		if (!file) return std::string();
+
+		std::stringstream contents;
+		contents << file.rdbuf();
+		return contents.str();
+	}
+
+	//! tokenise()
+	/*!
+	\param source a const std::string& - Preprocessed GLSL
+	\return a std::vector<std::string> - The words and punctuation of the source, without comments or preprocessor lines
+	*/
+	std::vector<std::string> tokenise(const std::string& source)
+	{
+		std::vector<std::string> tokens;
+		size_t i = 0;
+		while (i < source.size())
+		{
+			const char c = source[i];
+			const char next = i + 1 < source.size() ? source[i + 1] : '\0';
+			size_t end = i + 1;
+			if (c == '/' && next == '/' || c == '#')
+				end = source.find('\n', i);
+			else if (c == '/' && next == '*')
+			{
+				end = source.find("*/", i);
+				if (end != std::string::npos) end += 2;
+			}
+			else if (isalnum(static_cast<unsigned char>(c)) || c == '_')
+			{
+				while (end < source.size() && (isalnum(static_cast<unsigned char>(source[end])) || source[end] == '_')) end++;
+				tokens.push_back(source.substr(i, end - i));
+			}
+			else if (!isspace(static_cast<unsigned char>(c)))
+				tokens.push_back(std::string(1, c));
+
+			i = end != std::string::npos ? end : source.size();
+		}
+		return tokens;
+	}
+
+	//! getUniformType()
+	/*!
+	\param type a const std::string& - The GLSL type
+	\param sampler a bool& - Is the type a sampler
+	\return a ShaderDataType - The type the reflection stores, samplers are Int the same as reflect() gives them
+	*/
+	ShaderDataType getUniformType(const std::string& type, bool& sampler)
+	{
+		sampler = type.compare(0, 7, "sampler") == 0;
+		if (sampler) return ShaderDataType::Int;
+		if (type == "float") return ShaderDataType::Float;
+		if (type == "vec2") return ShaderDataType::Float2;
+		if (type == "vec3") return ShaderDataType::Float3;
+		if (type == "vec4") return ShaderDataType::Float4;
+		if (type == "mat3") return ShaderDataType::Mat3;
+		if (type == "mat4") return ShaderDataType::Mat4;
+		if (type == "int") return ShaderDataType::Int;
+		if (type == "ivec2") return ShaderDataType::Int2;
+		if (type == "ivec3") return ShaderDataType::Int3;
+		if (type == "ivec4") return ShaderDataType::Int4;
+		if (type == "bool") return ShaderDataType::Bool;
+		return ShaderDataType::None;
+	}
+
+	//! getCount()
+	/*!
+	\param token a const std::string& - The size between an array's brackets
+	\return a uint32_t - The number of elements, 1 if the size is not a number
+	*/
+	uint32_t getCount(const std::string& token)
+	{
+		return isdigit(static_cast<unsigned char>(token[0])) ? static_cast<uint32_t>(std::stoul(token)) : 1;
+	}
+
+	//! reflectSource()
+	/*!
+	\param source a const std::string& - Preprocessed GLSL of one stage
+	\param reflection a ShaderReflection& - The reflection to add the stage's uniforms and blocks to, ones already added by another stage are skipped
+	*/
+	void reflectSource(const std::string& source, ShaderReflection& reflection)
+	{
+		const std::vector<std::string> tokens = tokenise(source);
+		for (size_t i = 0; i + 2 < tokens.size(); i++)
+		{
+			if (tokens[i] != "uniform") continue;
+
+			// uniform Name { ... };
+			if (tokens[i + 2] == "{")
+			{
+				if (!reflection.getBlock(tokens[i + 1]))
+				{
+					ShaderBlock block;
+					block.Name = tokens[i + 1];
+					block.Index = static_cast<uint32_t>(reflection.getBlocks().size());
+					reflection.addBlock(block);
+				}
+
+				while (i < tokens.size() && tokens[i] != "}") i++;
+				continue;
+			}
+
+			// uniform type[N] name; or uniform type name[N];
+			ShaderUniform uniform;
+			uniform.Type = getUniformType(tokens[i + 1], uniform.Sampler);
+			size_t name = i + 2;
+			if (tokens[name] == "[" && name + 3 < tokens.size())
+			{
+				uniform.Count = getCount(tokens[name + 1]);
+				name += 3;
+			}
+			uniform.Name = tokens[name];
+			if (name + 2 < tokens.size() && tokens[name + 1] == "[") uniform.Count = getCount(tokens[name + 2]);
+
+			if (reflection.getUniform(uniform.Name)) continue;
+
+			// Locations are given in the order the uniforms are declared, each array element taking one
+			uniform.Location = 0;
+			for (auto& existing : reflection.getUniforms())
+				uniform.Location += static_cast<int32_t>(existing.Count);
+			reflection.addUniform(uniform);
+		}
+	}
+
+	//! reflectProgram()
+	/*!
+	\param program a const nlohmann::json& - The program's entry in shaders.json
+	\param reflection a ShaderReflection& - The reflection of every stage of the program
+	\return a const bool - Was every stage read and preprocessed
+	*/
+	const bool reflectProgram(const nlohmann::json& program, ShaderReflection& reflection)
+	{
+		// The values only matter to #if blocks, which do not hide any declarations
+		const ShaderDefines defines = { { "MAX_LIGHTS", "4" }, { "USE_BLOOM", "1" } };
+
+		reflection.clear();
+		for (auto& stage : Stages)
+		{
+			const std::string filePath = program[stage].get<std::string>();
+			if (filePath.empty()) continue;
+
+			std::string source;
+			if (!ShaderPreprocessor::process(filePath, defines, source, &readAsset)) return false;
+			reflectSource(source, reflection);
+		}
+		return true;
+	}
+
+	//! containsName()
+	/*!
+	\param list a const nlohmann::json& - A list of serialised uniforms or blocks
+	\param name a const std::string& - The name
+	\return a const bool - Does an entry in the list have the name
+	*/
+	const bool containsName(const nlohmann::json& list, const std::string& name)
+	{
+		for (auto& entry : list)
+		{
+			if (entry["name"].get<std::string>() == name) return true;
+		}
+		return false;
+	}
+
+	//! checkShaderList()
+	/*!
+	\param filePath a const std::string& - The shaders.json file relative to the game's directory
+	*/
+	void checkShaderList(const std::string& filePath)
+	{
+		const std::string contents = readAsset(filePath);
+		if (!CHECK(!contents.empty())) return;
+
+		const nlohmann::json shaderList = nlohmann::json::parse(contents);
+		for (auto& program : shaderList["programs"])
+		{
+			const std::string name = program["name"].get<std::string>();
+			ShaderReflection reflection;
+			if (!CHECK(reflectProgram(program, reflection)))
+			{
+				printf("    Cannot preprocess program: %s\n", name.c_str());
+				continue;
+			}
+
+			// The lists are compared with the serialised reflection, the same format the reflection is written out in
+			const nlohmann::json serialised = nlohmann::json::parse(reflection.toJSON().dump());
+			for (auto& uniform : program["uniforms"])
+			{
+				if (!CHECK(containsName(serialised["uniforms"], uniform.get<std::string>())))
+					printf("    Program: %s does not declare uniform: %s\n", name.c_str(), uniform.get<std::string>().c_str());
+			}
+
+			// Format is: [UNIFORM BLOCK NAME], [UNIFORM BUFFER NAME], etc
+			auto& buffers = program["uniformBuffers"];
+			for (size_t i = 0; i < buffers.size(); i += 2)
+			{
+				if (!CHECK(containsName(serialised["blocks"], buffers[i].get<std::string>())))
+					printf("    Program: %s does not declare uniform block: %s\n", name.c_str(), buffers[i].get<std::string>().c_str());
+			}
+
+			// Every block the program declares needs a buffer, otherwise it reads zeros
+			for (auto& block : serialised["blocks"])
+			{
+				bool listed = false;
+				for (size_t i = 0; i < buffers.size(); i += 2)
+					listed |= buffers[i].get<std::string>() == block["name"].get<std::string>();
+
+				if (!CHECK(listed))
+					printf("    Program: %s has no uniform buffer for block: %s\n", name.c_str(), block["name"].get<std::string>().c_str());
+			}
+
+			CHECK(ShaderReflection::fromJSON(serialised).validate(program, name));
+		}
+	}
+}
+
+ENGINE_TEST(shaderReflectionRoundTripsThroughJSON)
+{
+	ShaderReflection reflection;
+	reflection.addUniform({ "u_textures", ShaderDataType::Int, 3, 16, true });
+	reflection.addUniform({ "u_tint", ShaderDataType::Float4, 19, 1, false });
+	reflection.addUniform({ "u_model", ShaderDataType::Mat4, 20, 1, false });
+	reflection.addBlock({ "Camera", 0, 2, 144 });
+	reflection.addBlock({ "Settings", 1, -1, 16 });
+
+	const nlohmann::json serialised = reflection.toJSON();
+	const ShaderReflection readBack = ShaderReflection::fromJSON(nlohmann::json::parse(serialised.dump()));
+	CHECK(readBack.toJSON() == serialised);
+
+	if (!CHECK(readBack.getUniforms().size() == 3 && readBack.getBlocks().size() == 2)) return;
+	const ShaderUniform* textures = readBack.getUniform("u_textures");
+	CHECK(textures && textures->Type == ShaderDataType::Int && textures->Location == 3 && textures->Count == 16 && textures->Sampler);
+	CHECK(readBack.getHandle("u_model") == 20);
+	CHECK(readBack.getHandle("u_missing") == -1);
+
+	ShaderReflection blocks = readBack;
+	const ShaderBlock* settings = blocks.getBlock("Settings");
+	CHECK(settings && settings->Index == 1 && settings->Binding == -1 && settings->Size == 16);
+	CHECK(!blocks.getBlock("Missing"));
+}
+
+ENGINE_TEST(shaderReflectionValidateReportsMissingNames)
+{
+	ShaderReflection reflection;
+	reflection.addUniform({ "u_diffuseMap", ShaderDataType::Int, 0, 16, true });
+	reflection.addBlock({ "Camera", 0, -1, 144 });
+
+	nlohmann::json program;
+	program["uniforms"] = { "u_diffuseMap" };
+	program["uniformBuffers"] = { "Camera", "CameraUBO" };
+	CHECK(reflection.validate(program, "valid"));
+
+	printf("    Two errors are expected below\n");
+	program["uniforms"] = { "u_diffuseMap", "u_missing" };
+	program["uniformBuffers"] = { "Camera", "CameraUBO", "Missing", "MissingUBO" };
+	CHECK(!reflection.validate(program, "invalid"));
+}
+
+ENGINE_TEST(shaderReflectionMatchesGameShaderList)
+{
+	checkShaderList("assets/shaders.json");
+}
+
+ENGINE_TEST(shaderReflectionMatchesEngineShaderList)
+{
+	checkShaderList("assets/engine/shaders.json");
+}
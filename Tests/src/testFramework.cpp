@@ -0,0 +1,65 @@
+/*! \file testFramework.cpp
+*
+* \brief A small framework which registers and runs the engine's CPU only tests and benchmarks
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include "testFramework.h"
+
+namespace Tests
+{
+	namespace
+	{
+		uint32_t s_failures = 0; //!< The number of failed checks
+	}
+
+	//! Registration()
+	/*!
+	\param name a const char* - The name of the test
+	\param function a void(*)() - The test
+	\param benchmark a const bool - Is this a benchmark rather than a test
+	*/
+	Registration::Registration(const char* name, void(*function)(), const bool benchmark)
+	{
+		getTestCases().push_back({ name, function, benchmark });
+	}
+
+	//! getTestCases()
+	/*!
+	\return a std::vector<TestCase>& - Every registered test, built on first use so registration order does not matter
+	*/
+	std::vector<TestCase>& getTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	//! check()
+	/*!
+	\param passed a const bool - Did the check pass
+	\param expression a const char* - The expression that was checked
+	\param file a const char* - The file of the check
+	\param line a const int - The line of the check
+	\return a const bool - Did the check pass
+	*/
+	const bool check(const bool passed, const char* expression, const char* file, const int line)
+	{
+		if (!passed)
+		{
+			s_failures++;
+			printf("    FAILED %s (%s:%d)\n", expression, file, line);
+		}
+		return passed;
+	}
+
+	//! getFailures()
+	/*!
+	\return a const uint32_t - The number of failed checks
+	*/
+	const uint32_t getFailures()
+	{
+		return s_failures;
+	}
+}
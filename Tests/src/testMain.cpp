@@ -0,0 +1,58 @@
+/*! \file testMain.cpp
+*
+* \brief Runs the engine's CPU only tests, or its benchmarks when started with the bench argument. None of them need a window
+* or a graphics context
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "testFramework.h"
+#include "independent/systems/systems/log.h"
+
+//! main()
+/*!
+\param argc an int - Number of strings pointed to by argv
+\param argv a char** - The arguments, bench runs the benchmarks and any other argument only runs the tests whose name contains it
+\return an int - 0 if every check passed, otherwise 1
+*/
+int main(int argc, char** argv)
+{
+	bool benchmarks = false;
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "bench") == 0) benchmarks = true;
+		else filter = argv[i];
+	}
+
+	// Engine errors are printed so a failing test shows why
+	Engine::Log log;
+	log.start();
+
+	std::error_code error;
+	std::filesystem::create_directories(Tests::OutputRoot, error);
+
+	uint32_t run = 0;
+	for (auto& testCase : Tests::getTestCases())
+	{
+		if (testCase.benchmark != benchmarks) continue;
+		if (filter && !strstr(testCase.name, filter)) continue;
+
+		const uint32_t failures = Tests::getFailures();
+		printf("[ RUN  ] %s\n", testCase.name);
+		fflush(stdout);
+
+		testCase.function();
+
+		printf("[ %s ] %s\n", Tests::getFailures() == failures ? " OK " : "FAIL", testCase.name);
+		run++;
+	}
+
+	log.stop();
+
+	printf("%u %s run, %u failed checks.\n", run, benchmarks ? "benchmarks" : "tests", Tests::getFailures());
+	return Tests::getFailures() == 0 ? 0 : 1;
+}
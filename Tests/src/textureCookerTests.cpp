@@ -0,0 +1,100 @@
+/*! \file textureCookerTests.cpp
+*
+* \brief Cooks every texture in the game's assets, with and without block compression, and verifies each cooked file against
+* its source
+*
+* \author Daniel Bullin
+*
+*/
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include "testFramework.h"
+#include "independent/rendering/textures/textureCooker.h"
+
+using namespace Engine;
+
+namespace
+{
+	//! getTextureSources()
+	/*!
+	\return a std::vector<std::string> - Every image in the game's texture directory, sorted so they are cooked in the same order every run
+	*/
+	std::vector<std::string> getTextureSources()
+	{
+		std::vector<std::string> sources;
+		std::error_code error;
+		for (auto& entry : std::filesystem::recursive_directory_iterator(Tests::AssetRoot + "assets/textures", error))
+		{
+			std::string extension = entry.path().extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+			if (entry.is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".jpeg"))
+				sources.push_back(entry.path().generic_string());
+		}
+
+		std::sort(sources.begin(), sources.end());
+		return sources;
+	}
+
+	//! cookAndVerify()
+	/*!
+	\param settings a const TextureCookSettings& - How to cook every texture
+	\param suffix a const std::string& - Added to the name of each cooked file
+	*/
+	void cookAndVerify(const TextureCookSettings& settings, const std::string& suffix)
+	{
+		const std::vector<std::string> sources = getTextureSources();
+		if (!CHECK(!sources.empty())) return;
+
+		const std::string directory = Tests::OutputRoot + "textures/";
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		uint64_t sourceBytes = 0;
+		uint64_t cookedBytes = 0;
+		Tests::Timer timer;
+		for (auto& source : sources)
+		{
+			const std::string cookedPath = directory + std::filesystem::path(source).stem().string() + "." + suffix + ".ctex";
+			if (!CHECK(TextureCooker::cook(source, cookedPath, settings)))
+			{
+				printf("    Cannot cook: %s\n", source.c_str());
+				continue;
+			}
+
+			if (!CHECK(TextureCooker::verify(source, cookedPath, settings)))
+				printf("    Cooked texture does not match: %s\n", source.c_str());
+
+			// Compressed textures are in blocks unless the source has a single channel, which is kept as it is
+			TextureImage image;
+			if (CHECK(TextureCooker::read(cookedPath, image)))
+			{
+				// The full chain goes down to a single pixel
+				CHECK(image.Mips.size() == static_cast<size_t>(std::log2(std::max(image.getWidth(), image.getHeight()))) + 1);
+				if (settings.Compress && image.Format != TextureImageFormat::R8) CHECK(image.isCompressed());
+				if (!settings.Compress) CHECK(!image.isCompressed());
+			}
+
+			sourceBytes += std::filesystem::file_size(source, error);
+			cookedBytes += std::filesystem::file_size(cookedPath, error);
+			std::filesystem::remove(cookedPath, error);
+		}
+
+		printf("    Cooked and verified %zu textures in %.1fms, %llu source bytes to %llu cooked bytes.\n", sources.size(), timer.getMicroseconds() / 1000.0,
+			static_cast<unsigned long long>(sourceBytes), static_cast<unsigned long long>(cookedBytes));
+	}
+}
+
+ENGINE_TEST(textureCookerCooksGameTexturesUncompressed)
+{
+	TextureCookSettings settings;
+	settings.Compress = false;
+	cookAndVerify(settings, "plain");
+}
+
+ENGINE_TEST(textureCookerCooksGameTexturesCompressed)
+{
+	TextureCookSettings settings;
+	settings.Compress = true;
+	cookAndVerify(settings, "bc");
+}
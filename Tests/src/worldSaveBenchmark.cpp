@@ -0,0 +1,103 @@
+/*! \file worldSaveBenchmark.cpp
+*
+* \brief Times saving and loading a large number of placed objects in the game's region files
+*
+* \author Daniel Bullin
+*
+*/
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include "testFramework.h"
+#include "loaders/regionFile.h"
+
+using namespace Engine;
+
+namespace
+{
+	const float ChunkSize = 50.f; //!< The width of a chunk in world units, the same as ChunkManager::getChunkWorldSize
+	const uint32_t ItemCount = 6; //!< The number of kinds of item an object can be placed from
+
+	/*! \struct BenchmarkRegion
+	* \brief The chunks of one region of the benchmark world
+	*/
+	struct BenchmarkRegion
+	{
+		glm::ivec2 Coordinate; //!< The region coordinate
+		std::unordered_map<uint32_t, ChunkDelta> Chunks; //!< The chunks by index within the region
+	};
+
+	//! getRegionPath()
+	/*!
+	\param directory a const std::string& - The directory of the world
+	\param region a const glm::ivec2& - The region coordinate
+	\return a std::string - The path of the region's file, named the way WorldSave names them
+	*/
+	std::string getRegionPath(const std::string& directory, const glm::ivec2& region)
+	{
+		return directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".region";
+	}
+
+	//! runWorldSaveBenchmark()
+	/*!
+	\param objectCount a const uint32_t - The number of placed objects to save and load
+	*/
+	void runWorldSaveBenchmark(const uint32_t objectCount)
+	{
+		const std::string directory = Tests::OutputRoot + "worldSave";
+		std::error_code error;
+		std::filesystem::remove_all(directory, error);
+		std::filesystem::create_directories(directory, error);
+		if (!CHECK(!error)) return;
+
+		// Objects are spread over a square a few regions wide, the same as a player building across a large part of the world
+		std::mt19937 generator(objectCount);
+		std::uniform_real_distribution<float> distribution(-2000.f, 2000.f);
+		std::unordered_map<uint64_t, BenchmarkRegion> regions;
+		for (uint32_t i = 0; i < objectCount; i++)
+		{
+			const glm::vec3 position = { distribution(generator), distribution(generator) * 0.05f, distribution(generator) };
+			const glm::ivec2 chunk = { static_cast<int>(floor(position.x / ChunkSize)), static_cast<int>(floor(position.z / ChunkSize)) };
+			const glm::ivec2 region = RegionFile::getRegion(chunk);
+
+			BenchmarkRegion& entry = regions[(static_cast<uint64_t>(static_cast<uint32_t>(region.x)) << 32) | static_cast<uint32_t>(region.y)];
+			entry.Coordinate = region;
+			entry.Chunks[RegionFile::getChunkIndex(chunk)].Placed.push_back({ i % ItemCount, position });
+		}
+
+		Tests::Timer saveTimer;
+		for (auto& region : regions)
+			CHECK(RegionFile::write(getRegionPath(directory, region.second.Coordinate), region.second.Coordinate, ChunkSize, region.second.Chunks));
+		const double saveTime = saveTimer.getMicroseconds() / 1000.0;
+
+		uint64_t bytes = 0;
+		for (auto& region : regions)
+			bytes += std::filesystem::file_size(getRegionPath(directory, region.second.Coordinate), error);
+
+		Tests::Timer loadTimer;
+		uint32_t loaded = 0;
+		ChunkDelta chunk;
+		for (auto& region : regions)
+		{
+			RegionFile file;
+			file.open(getRegionPath(directory, region.second.Coordinate));
+			for (uint32_t i = 0; i < RegionFormat::ChunkCount; i++)
+			{
+				if (file.readChunk(i, chunk))
+					loaded += static_cast<uint32_t>(chunk.Placed.size());
+			}
+		}
+		const double loadTime = loadTimer.getMicroseconds() / 1000.0;
+
+		CHECK(loaded == objectCount);
+		printf("    Saved %u objects in %zu regions in %.2fms, %llu bytes. Loaded %u objects in %.2fms.\n", objectCount, regions.size(), saveTime,
+			static_cast<unsigned long long>(bytes), loaded, loadTime);
+
+		std::filesystem::remove_all(directory, error);
+	}
+}
+
+ENGINE_BENCHMARK(worldSave100kObjects)
+{
+	runWorldSaveBenchmark(100000);
+}